@@ -340,6 +340,51 @@ bool Attribute::isValid(const std::set<std::string>& cats) const
   return !(m_associatedObjects && !m_associatedObjects->isValid(false));
 }
 
+bool Attribute::isValidCached() const
+{
+  auto aResource = this->attributeResource();
+  std::uint64_t generation =
+    aResource ? static_cast<std::uint64_t>(aResource->validityGeneration()) & 0x7fffffff : 0;
+  std::uint64_t state = m_validityState.load();
+  if (generation != 0 && ((state >> 1) & 0x7fffffff) == generation)
+  {
+    return (state & 1) != 0;
+  }
+  bool valid = this->isValid();
+  if (generation != 0)
+  {
+    // Only keep the result if markModified() was not called while computing it.
+    std::uint64_t cached = ((state >> 32) << 32) | (generation << 1) | (valid ? 1 : 0);
+    m_validityState.compare_exchange_strong(state, cached);
+  }
+  return valid;
+}
+
+namespace
+{
+void expireValidity(std::atomic<std::uint64_t>& validityState)
+{
+  std::uint64_t state = validityState.load();
+  while (!validityState.compare_exchange_weak(state, ((state >> 32) + 1) << 32))
+  {
+  }
+}
+} // namespace
+
+void Attribute::markModified()
+{
+  expireValidity(m_validityState);
+  if (auto aResource = this->attributeResource())
+  {
+    std::set<smtk::attribute::AttributePtr> dependents;
+    aResource->findDependentAttributes(this->id(), dependents);
+    for (const auto& dependent : dependents)
+    {
+      expireValidity(dependent->m_validityState);
+    }
+  }
+}
+
 bool Attribute::isRelevant(
   bool requestCategoryCheck,
   bool includeReadAccess,
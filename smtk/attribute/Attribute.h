@@ -27,6 +27,8 @@
 #include "smtk/common/Deprecation.h"
 #include "smtk/common/UUID.h" // for template associatedModelEntities()
 
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <set>
 #include <string>
@@ -348,6 +350,19 @@ public:
   /// are valid
   bool isValid(bool useActiveCategories = true) const;
   bool isValid(const std::set<std::string>& categories) const;
+  ///@}
+
+  ///@{
+  ///\brief Returns isValid() while reusing the result of a prior call when possible.
+  ///
+  /// The cached result is discarded when markModified() is called on this attribute
+  /// or on an attribute it depends upon (via expressions or other references) and
+  /// when the resource's validity generation changes (see Resource::invalidateValidity()).
+  /// It is safe to call from several threads at once.
+  bool isValidCached() const;
+  /// Discard the cached validity of this attribute and of the attributes that
+  /// depend upon it (see Resource::findDependentAttributes()).
+  void markModified();
 
   ///\brief Returns true if the attribute is relevant.
   ///
@@ -500,6 +515,10 @@ protected:
   double m_color[4];
   smtk::common::UUID m_id;
   std::size_t m_includeIndex{ 0 };
+  // The state of isValidCached(): the number of markModified() calls in the high
+  // 32 bits, then the low 31 bits of the resource's validity generation when the
+  // result was cached (0 when nothing is cached) and the cached result in bit 0.
+  mutable std::atomic<std::uint64_t> m_validityState{ 0 };
   bool m_hasLocalAdvanceLevelInfo[2];
   unsigned int m_localAdvanceLevel[2];
   std::string m_localUnits;
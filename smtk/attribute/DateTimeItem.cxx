@@ -77,6 +77,7 @@ bool DateTimeItem::setNumberOfValues(std::size_t newSize)
     m_values.resize(newSize);
     m_isSet.resize(newSize, false);
   }
+  this->markModified();
   return true;
 }
 
@@ -99,6 +100,7 @@ bool DateTimeItem::setValue(std::size_t element, const ::smtk::common::DateTimeZ
     m_values[element] = value;
     assert(m_isSet.size() > element);
     m_isSet[element] = true;
+    this->markModified();
     return true;
   }
   return false;
@@ -121,6 +123,7 @@ void DateTimeItem::reset()
     m_isSet.resize(numValues, false);
     m_values.resize(numValues);
   }
+  this->markModified();
 }
 
 bool DateTimeItem::setToDefault(std::size_t element)
@@ -61,6 +61,7 @@ public:
   {
     assert(m_isSet.size() > element);
     m_isSet[element] = false;
+    this->markModified();
   }
 
   // Assigns this item to be equivalent to another. Options are processed by derived item classes.
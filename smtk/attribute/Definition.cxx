@@ -144,6 +144,27 @@ bool Definition::removeTag(const std::string& name)
 
 bool Definition::isA(smtk::attribute::ConstDefinitionPtr targetDef) const
 {
+  if (!targetDef)
+  {
+    return false;
+  }
+  if (targetDef.get() == this)
+  {
+    return true;
+  }
+
+  // Definitions derived from targetDef are numbered within its range of
+  // the resource's inheritance index.
+  if (auto resource = m_resource.lock())
+  {
+    resource->updateInheritanceIndex();
+    if (m_inheritanceIndex == resource.get() && targetDef->m_inheritanceIndex == resource.get())
+    {
+      return targetDef->m_inheritanceBegin <= m_inheritanceBegin &&
+        m_inheritanceBegin < targetDef->m_inheritanceEnd;
+    }
+  }
+
   // Walk up the inheritance tree until we either hit the root or
   // encounter this definition
   const Definition* def = this;
@@ -443,6 +464,7 @@ AttributePtr Definition::checkForConflicts(smtk::resource::ConstPersistentObject
 {
   if (!m_exclusionDefs.empty())
   {
+    auto resource = this->attributeResource();
     for (const auto& wdef : m_exclusionDefs)
     {
       auto def = wdef.lock(); // Need to get the shared pointer (if there is one)
@@ -450,7 +472,7 @@ AttributePtr Definition::checkForConflicts(smtk::resource::ConstPersistentObject
       {
         continue;
       }
-      auto atts = def->attributes(object);
+      auto atts = resource->associatedAttributes(object, def);
       if (!atts.empty())
       {
         return *(atts.begin());
@@ -471,6 +493,7 @@ DefinitionPtr Definition::checkForPrerequisites(
   // Next let's see if there are any attributes that would exclude this one
   if (!m_prerequisiteDefs.empty())
   {
+    auto resource = this->attributeResource();
     for (const auto& wdef : m_prerequisiteDefs)
     {
       auto def = wdef.lock(); // Need to get the shared pointer (if there is one)
@@ -478,7 +501,7 @@ DefinitionPtr Definition::checkForPrerequisites(
       {
         continue;
       }
-      auto atts = def->attributes(object);
+      auto atts = resource->associatedAttributes(object, def);
       if (atts.empty())
       {
         return def;
@@ -774,24 +797,10 @@ bool Definition::removeItemDefinition(ItemDefinitionPtr itemDef)
 std::set<AttributePtr> Definition::attributes(
   const smtk::resource::ConstPersistentObjectPtr& object) const
 {
-  // Get all attributes that are associated with the object and then remove all attributes whose definitions
-  // are not derived from this one.
-  auto atts = this->attributeResource()->attributes(object);
-  auto sharedDef = this->shared_from_this();
-  for (auto it = atts.begin(); it != atts.end();)
-  {
-    if ((*it)->definition()->isA(sharedDef))
-    {
-      // Keep this in the list
-      ++it;
-    }
-    else
-    {
-      // its not derived from this so remove it from the list
-      it = atts.erase(it);
-    }
-  }
-  return atts;
+  // Get all attributes that are associated with the object whose definitions
+  // are derived from this one (which the resource caches per object).
+  auto atts = this->attributeResource()->associatedAttributes(object, this->shared_from_this());
+  return std::set<AttributePtr>(atts.begin(), atts.end());
 }
 
 void Definition::applyCategories(smtk::common::Categories::Stack inherited)
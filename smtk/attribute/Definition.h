@@ -133,6 +133,10 @@ public:
 
   const smtk::attribute::DefinitionPtr& baseDefinition() const { return m_baseDefinition; }
 
+  ///\brief Return true if this definition is \a def or is derived from it.
+  ///
+  /// For definitions of the same attribute resource, this is a constant-time
+  /// test against the resource's inheritance index (see Resource::findAttributes).
   bool isA(smtk::attribute::ConstDefinitionPtr def) const;
 
   ///\brief Returns true if the definition is relevant.
@@ -558,6 +562,12 @@ protected:
   std::size_t m_includeIndex;
   smtk::common::Categories::CombinationMode m_combinationMode;
   std::string m_localUnits;
+  /// The range [m_inheritanceBegin, m_inheritanceEnd) this definition and the
+  /// definitions derived from it occupy in the inheritance index of
+  /// m_inheritanceIndex (the resource that last numbered it, if any).
+  std::size_t m_inheritanceBegin = 0;
+  std::size_t m_inheritanceEnd = 0;
+  const smtk::attribute::Resource* m_inheritanceIndex = nullptr;
 
 private:
   /// These colors are returned for base definitions w/o set colors
@@ -148,6 +148,7 @@ bool FileSystemItem::setValue(std::size_t element, const std::string& val)
     assert(m_isSet.size() > element);
     m_values[element] = val;
     m_isSet[element] = true;
+    this->markModified();
     return true;
   }
   return false;
@@ -208,6 +209,7 @@ bool FileSystemItem::appendValue(const std::string& val)
   {
     m_values.push_back(val);
     m_isSet.push_back(true);
+    this->markModified();
     return true;
   }
   return false;
@@ -229,6 +231,7 @@ bool FileSystemItem::removeValue(std::size_t i)
   }
   m_values.erase(m_values.begin() + i);
   m_isSet.erase(m_isSet.begin() + i);
+  this->markModified();
   return true;
 }
 
@@ -266,6 +269,7 @@ bool FileSystemItem::setNumberOfValues(std::size_t newSize)
     m_values.resize(newSize);
     m_isSet.resize(newSize, false); //Any added values are not set
   }
+  this->markModified();
   return true;
 }
 
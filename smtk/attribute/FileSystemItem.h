@@ -73,6 +73,7 @@ public:
   {
     assert(m_isSet.size() > element);
     m_isSet[element] = false;
+    this->markModified();
   }
 
   // Iterator-style access to values:
@@ -218,7 +218,12 @@ void GroupItem::reset()
 
 bool GroupItem::rotate(std::size_t fromPosition, std::size_t toPosition)
 {
-  return this->rotateVector(m_items, fromPosition, toPosition);
+  if (!this->rotateVector(m_items, fromPosition, toPosition))
+  {
+    return false;
+  }
+  this->markModified();
+  return true;
 }
 
 /**\brief Return an iterator to the first group in this item.
@@ -308,7 +313,7 @@ bool GroupItem::insertGroups(std::size_t pos, std::size_t num)
   {
     def->buildGroup(this, static_cast<int>(i));
   }
-
+  this->markModified();
   return true;
 }
 
@@ -341,6 +346,7 @@ bool GroupItem::removeGroup(std::size_t element)
     items[j]->detachOwningItem();
   }
   m_items.erase(m_items.begin() + element);
+  this->markModified();
   return true;
 }
 
@@ -396,6 +402,7 @@ bool GroupItem::setNumberOfGroups(std::size_t newSize)
       def->buildGroup(this, static_cast<int>(i));
     }
   }
+  this->markModified();
   return true;
 }
 
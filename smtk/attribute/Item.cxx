@@ -12,6 +12,7 @@
 #include "smtk/attribute/Attribute.h"
 #include "smtk/attribute/GroupItem.h"
 #include "smtk/attribute/ItemDefinition.h"
+#include "smtk/attribute/ReferenceItem.h"
 #include "smtk/attribute/Resource.h"
 #include "smtk/attribute/ValueItem.h"
 
@@ -245,12 +246,37 @@ const smtk::common::Categories& Item::categories() const
   return this->definition()->categories();
 }
 
+void Item::markModified()
+{
+  const Item* item = this;
+  while (item->m_owningItem)
+  {
+    item = item->m_owningItem;
+  }
+  if (item->m_attribute)
+  {
+    // Reference items (and value items, which may hold expressions) determine
+    // which attributes depend upon one another.
+    if (
+      dynamic_cast<const ReferenceItem*>(this) != nullptr ||
+      dynamic_cast<const ValueItem*>(this) != nullptr)
+    {
+      if (auto aResource = item->m_attribute->attributeResource())
+      {
+        aResource->markReferencesModified(item->m_attribute->id());
+      }
+    }
+    item->m_attribute->markModified();
+  }
+}
+
 void Item::reset()
 {
   if (m_definition && m_definition->isOptional())
   {
     m_isEnabled = m_definition->isEnabledByDefault();
   }
+  this->markModified();
 }
 
 bool Item::rotate(std::size_t fromPosition, std::size_t toPosition)
@@ -333,6 +359,7 @@ Item::Status Item::assign(
     m_hasLocalAdvanceLevelInfo[i] = sourceItem->m_hasLocalAdvanceLevelInfo[i];
     m_localAdvanceLevel[i] = sourceItem->m_localAdvanceLevel[i];
   } // for
+  this->markModified();
   return status;
 }
 
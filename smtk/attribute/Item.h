@@ -126,7 +126,11 @@ public:
 
   ///@{
   ///\brief Set and Get Methods for specifying a custom isValid function
-  void setCustomIsValid(const ValidityFunc& func) { m_customIsValid = func; }
+  void setCustomIsValid(const ValidityFunc& func)
+  {
+    m_customIsValid = func;
+    this->markModified();
+  }
   ValidityFunc customIsValid() const { return m_customIsValid; }
   ///@}
 
@@ -226,7 +230,11 @@ public:
   /// Return the state of the instance's isEnabled state
   bool localEnabledState() const { return m_isEnabled; }
   /// Set the instance's local enabled state
-  void setIsEnabled(bool isEnabledValue) { m_isEnabled = isEnabledValue; }
+  void setIsEnabled(bool isEnabledValue)
+  {
+    m_isEnabled = isEnabledValue;
+    this->markModified();
+  }
 
   /// @{
   /// \brief Controls if an item should be forced to be required regardless of
@@ -238,7 +246,11 @@ public:
   /// optional item to be required.  If the Definition states that the item
   /// is required naturally, this will have no effect.
   /// By default forceRequired is false.
-  void setForceRequired(bool val) { m_forceRequired = val; }
+  void setForceRequired(bool val)
+  {
+    m_forceRequired = val;
+    this->markModified();
+  }
   bool forceRequired() const { return m_forceRequired; }
   /// @}
 
@@ -321,11 +333,25 @@ public:
   /// When setIgnored is passed true, the item::isRelevant will return false regardless of category or
   /// advance property checks
   /// By default isIgnored() will return false.
-  void setIsIgnored(bool val) { m_isIgnored = val; }
+  void setIsIgnored(bool val)
+  {
+    m_isIgnored = val;
+    this->markModified();
+  }
 
   bool isIgnored() const { return m_isIgnored; }
   ///@}
 
+  ///\brief Note that the item's value or state has changed.
+  ///
+  /// Item methods call this after they successfully modify the item (so a
+  /// validity computed concurrently from the old state is not kept); it
+  /// discards the cached validity of the owning attribute and of the
+  /// attributes that depend upon it (see Attribute::isValidCached()). Code
+  /// that changes what an item's validity depends upon by other means should
+  /// call it as well, after making the change.
+  void markModified();
+
   static std::string type2String(Item::Type t);
   static Item::Type string2Type(const std::string& s);
 
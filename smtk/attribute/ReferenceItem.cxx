@@ -60,6 +60,49 @@ public:
     return weakPersistentObject.lock();
   }
 };
+
+// Expire the attribute resource's cached associations of \a object (see
+// Resource::associatedAttributes()) if \a role is the association role.
+void expireAssociations(
+  const AttributePtr& att,
+  const smtk::common::UUID& object,
+  smtk::resource::Links::RoleType role)
+{
+  if (role == Resource::AssociationRole && !object.isNull())
+  {
+    if (auto resource = att->attributeResource())
+    {
+      resource->invalidateAssociationCache(object);
+    }
+  }
+}
+
+// Return the object and role of the link identified by \a key (or a null ID
+// if \a key does not identify a link). The caller must hold the links' lock.
+std::pair<smtk::common::UUID, smtk::resource::Links::RoleType> linkedObjectIdAndRole(
+  const AttributePtr& att,
+  const smtk::attribute::Attribute::GuardedLinks& links,
+  const ReferenceItem::Key& key)
+{
+  const auto& linkData = att->resource()->links().data();
+  if (!linkData.contains(key.first) || !linkData.value(key.first).contains(key.second))
+  {
+    return std::make_pair(smtk::common::UUID::null(), smtk::resource::Links::invalidRole());
+  }
+  return links->linkedObjectIdAndRole(key);
+}
+
+// Remove the link identified by \a key from \a att.
+void removeLink(const AttributePtr& att, const ReferenceItem::Key& key)
+{
+  std::pair<smtk::common::UUID, smtk::resource::Links::RoleType> objectAndRole;
+  {
+    auto links = att->guardedLinks();
+    objectAndRole = linkedObjectIdAndRole(att, links, key);
+    links->removeLink(key);
+  }
+  expireAssociations(att, objectAndRole.first, objectAndRole.second);
+}
 } // namespace
 
 struct ReferenceItem::const_iterator::CacheIterator : ReferenceItem::Cache::const_iterator
@@ -346,6 +389,7 @@ bool ReferenceItem::setNumberOfValues(std::size_t newSize)
   }
   m_keys.resize(newSize);
   m_cache->resize(newSize);
+  this->markModified();
   return true;
 }
 
@@ -423,8 +467,14 @@ bool ReferenceItem::setObjectKey(std::size_t i, const smtk::attribute::Reference
     return false;
   }
 
-  myAtt->guardedLinks()->removeLink(m_keys[i]);
+  removeLink(myAtt, m_keys[i]);
   m_keys[i] = key;
+  std::pair<smtk::common::UUID, smtk::resource::Links::RoleType> objectAndRole;
+  {
+    auto links = myAtt->guardedLinks();
+    objectAndRole = linkedObjectIdAndRole(myAtt, links, key);
+  }
+  expireAssociations(myAtt, objectAndRole.first, objectAndRole.second);
 
   // Are we "unsetting" the value?  If so do we need to
   // adjust the the position of the first null value?
@@ -449,7 +499,7 @@ bool ReferenceItem::setObjectKey(std::size_t i, const smtk::attribute::Reference
       }
     }
   }
-
+  this->markModified();
   return true;
 }
 
@@ -470,6 +520,7 @@ bool ReferenceItem::setObjectKey(
     {
       // current object does not have any conditional items
       m_currentConditional = ReferenceItemDefinition::s_invalidIndex;
+      this->markModified();
       return true;
     }
     // Get the children that should be active for the current value
@@ -480,6 +531,7 @@ bool ReferenceItem::setObjectKey(
       m_activeChildrenItems.push_back(m_childrenItems[citems[i]]);
     }
     m_currentConditional = conditional;
+    this->markModified();
     return true;
   }
   return false;
@@ -517,12 +569,16 @@ ReferenceItem::Key ReferenceItem::linkTo(const PersistentObjectPtr& val)
   // If the object is a component...
   if (auto component = std::dynamic_pointer_cast<smtk::resource::Component>(val))
   {
-    return myAtt->guardedLinks()->addLinkTo(component, def->role());
+    auto key = myAtt->guardedLinks()->addLinkTo(component, def->role());
+    expireAssociations(myAtt, component->id(), def->role());
+    return key;
   }
   // If the object is a resource...
   else if (auto resource = std::dynamic_pointer_cast<smtk::resource::Resource>(val))
   {
-    return myAtt->guardedLinks()->addLinkTo(resource, def->role());
+    auto key = myAtt->guardedLinks()->addLinkTo(resource, def->role());
+    expireAssociations(myAtt, resource->id(), def->role());
+    return key;
   }
 
   // If the object cannot be cast to a resource or component, there's not much
@@ -597,7 +653,7 @@ bool ReferenceItem::setValue(std::size_t i, const PersistentObjectPtr& val)
   AttributePtr myAtt = this->m_referencedAttribute.lock();
   if (myAtt != nullptr)
   {
-    myAtt->guardedLinks()->removeLink(m_keys[i]);
+    removeLink(myAtt, m_keys[i]);
     m_keys[i] = this->linkTo(val);
   }
   else
@@ -630,6 +686,7 @@ bool ReferenceItem::setValue(std::size_t i, const PersistentObjectPtr& val)
   {
     this->updateActiveChildrenItems();
   }
+  this->markModified();
   return true;
 }
 
@@ -673,6 +730,7 @@ bool ReferenceItem::appendValue(const PersistentObjectPtr& val, bool allowDuplic
 
   m_keys.push_back(this->linkTo(val));
   appendToCache(val);
+  this->markModified();
   return true;
 }
 
@@ -702,9 +760,10 @@ bool ReferenceItem::removeValue(std::size_t i)
     --m_nextUnsetPos;
   }
 
-  myAtt->guardedLinks()->removeLink(m_keys[i]);
+  removeLink(myAtt, m_keys[i]);
   m_keys.erase(m_keys.begin() + i);
   (*m_cache).erase((*m_cache).begin() + i);
+  this->markModified();
   return true;
 }
 
@@ -719,7 +778,7 @@ void ReferenceItem::detachOwningResource()
     // Remove links to referenced items
     for (auto& key : m_keys)
     {
-      myAtt->guardedLinks()->removeLink(key);
+      removeLink(myAtt, key);
     }
   }
 
@@ -740,7 +799,7 @@ void ReferenceItem::reset()
     // Remove links to referenced items
     for (auto& key : m_keys)
     {
-      myAtt->guardedLinks()->removeLink(key);
+      removeLink(myAtt, key);
     }
   }
 
@@ -758,6 +817,7 @@ void ReferenceItem::reset()
   {
     m_nextUnsetPos = -1;
   }
+  this->markModified();
 }
 
 std::string ReferenceItem::valueAsString() const
@@ -798,6 +858,7 @@ void ReferenceItem::unset(std::size_t i)
   this->setValue(i, PersistentObjectPtr());
   // Clear the current list of active children items
   m_activeChildrenItems.clear();
+  this->markModified();
 }
 
 std::size_t ReferenceItem::numberOfSetValues() const
@@ -15,6 +15,7 @@
 #include "smtk/attribute/Attribute.h"
 #include "smtk/attribute/Definition.h"
 #include "smtk/attribute/GroupItemDefinition.h"
+#include "smtk/attribute/ReferenceItem.h"
 #include "smtk/attribute/ValueItem.h"
 #include "smtk/attribute/ValueItemDefinition.h"
 #include "smtk/attribute/VoidItemDefinition.h"
@@ -139,6 +140,7 @@ smtk::attribute::DefinitionPtr Resource::createDefinition(
     // Need to add this new definition to the list of derived defs
     m_derivedDefInfo[def].insert(newDef);
   }
+  this->invalidateInheritanceIndex();
   this->setClean(false);
   return newDef;
 }
@@ -172,6 +174,7 @@ smtk::attribute::DefinitionPtr Resource::createDefinition(
     // Need to add this new definition to the list of derived defs
     m_derivedDefInfo[baseDef].insert(newDef);
   }
+  this->invalidateInheritanceIndex();
   this->setClean(false);
   return newDef;
 }
@@ -211,6 +214,8 @@ bool Resource::removeDefinition(DefinitionPtr def)
 
   m_definitions.erase(def->type());
   m_definitionIdMap.erase(def->id());
+  def->m_inheritanceIndex = nullptr;
+  this->invalidateInheritanceIndex();
   this->setClean(false);
   return true;
 }
@@ -250,6 +255,7 @@ smtk::attribute::AttributePtr Resource::createAttribute(
   m_attributeClusters[def->type()].insert(a);
   m_attributes[name] = a;
   m_attributeIdMap[newAttId] = a;
+  this->markReferencesModified(newAttId);
   this->setClean(false);
   return a;
 }
@@ -310,6 +316,10 @@ bool Resource::removeAttribute(smtk::attribute::AttributePtr att)
   m_attributes.erase(att->name());
   m_attributeIdMap.erase(att->id());
   m_attributeClusters[att->type()].erase(att);
+  // Attributes referring to this one may no longer be valid.
+  att->markModified();
+  this->markReferencesModified(att->id());
+  this->invalidateAssociationCache();
   this->setClean(false);
   return true;
 }
@@ -400,23 +410,25 @@ void Resource::internalFindAttributes(
   smtk::attribute::DefinitionPtr def,
   std::vector<smtk::attribute::AttributePtr>& result) const
 {
-  if (!def->isAbstract())
+  this->updateInheritanceIndex();
+  if (def->m_inheritanceIndex != this)
   {
-    auto it = m_attributeClusters.find(def->type());
+    return;
+  }
+  // The definition and those derived from it are numbered contiguously.
+  for (std::size_t ii = def->m_inheritanceBegin; ii < def->m_inheritanceEnd; ++ii)
+  {
+    const auto& derived = m_inheritanceOrder[ii];
+    if (derived->isAbstract())
+    {
+      continue;
+    }
+    auto it = m_attributeClusters.find(derived->type());
     if (it != m_attributeClusters.end())
     {
       result.insert(result.end(), it->second.begin(), it->second.end());
     }
   }
-  auto dit = m_derivedDefInfo.find(def);
-  if (dit == m_derivedDefInfo.end())
-  {
-    return;
-  }
-  for (auto defIt = dit->second.begin(); defIt != dit->second.end(); defIt++)
-  {
-    this->internalFindAttributes(defIt->lock(), result);
-  }
 }
 
 void Resource::findAllDerivedDefinitions(
@@ -436,19 +448,71 @@ void Resource::internalFindAllDerivedDefinitions(
   bool onlyConcrete,
   std::vector<smtk::attribute::DefinitionPtr>& result) const
 {
-  if (!(def->isAbstract() && onlyConcrete))
+  this->updateInheritanceIndex();
+  if (def->m_inheritanceIndex != this)
   {
-    result.push_back(def);
+    return;
   }
-  auto dit = m_derivedDefInfo.find(def);
-  if (dit == m_derivedDefInfo.end())
+  for (std::size_t ii = def->m_inheritanceBegin; ii < def->m_inheritanceEnd; ++ii)
+  {
+    const auto& derived = m_inheritanceOrder[ii];
+    if (!(derived->isAbstract() && onlyConcrete))
+    {
+      result.push_back(derived);
+    }
+  }
+}
+
+void Resource::updateInheritanceIndex() const
+{
+  if (m_inheritanceIndexValid.load(std::memory_order_acquire))
   {
     return;
   }
-  for (auto defIt = dit->second.begin(); defIt != dit->second.end(); defIt++)
+  std::lock_guard<std::mutex> lock(m_inheritanceIndexMutex);
+  if (m_inheritanceIndexValid.load(std::memory_order_relaxed))
   {
-    this->internalFindAllDerivedDefinitions(defIt->lock(), onlyConcrete, result);
+    return;
   }
+  m_inheritanceOrder.clear();
+  m_inheritanceOrder.reserve(m_definitions.size());
+  for (const auto& entry : m_definitions)
+  {
+    if (!entry.second->baseDefinition())
+    {
+      this->numberDefinitions(entry.second);
+    }
+  }
+  m_inheritanceIndexValid.store(true, std::memory_order_release);
+}
+
+void Resource::numberDefinitions(const smtk::attribute::DefinitionPtr& def) const
+{
+  def->m_inheritanceBegin = m_inheritanceOrder.size();
+  def->m_inheritanceIndex = this;
+  m_inheritanceOrder.push_back(def);
+  auto dit = m_derivedDefInfo.find(def);
+  if (dit != m_derivedDefInfo.end())
+  {
+    for (const auto& weakDerived : dit->second)
+    {
+      if (auto derived = weakDerived.lock())
+      {
+        this->numberDefinitions(derived);
+      }
+    }
+  }
+  def->m_inheritanceEnd = m_inheritanceOrder.size();
+}
+
+void Resource::invalidateInheritanceIndex()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_inheritanceIndexMutex);
+    m_inheritanceIndexValid.store(false, std::memory_order_release);
+    m_inheritanceOrder.clear();
+  }
+  this->invalidateAssociationCache();
 }
 
 bool Resource::rename(smtk::attribute::AttributePtr att, const std::string& newName)
@@ -490,8 +554,10 @@ bool Resource::resetId(AttributePtr att, const smtk::common::UUID& newId)
   }
   std::cerr << "Changing Att Id from: " << att->id() << " to " << newId << std::endl;
   m_attributeIdMap.erase(att->id());
+  this->markReferencesModified(att->id());
   att->resetId(newId);
   m_attributeIdMap[newId] = att;
+  this->markReferencesModified(newId);
   return true;
 }
 
@@ -1163,6 +1229,78 @@ std::set<AttributePtr> Resource::attributes(
   return result;
 }
 
+std::vector<AttributePtr> Resource::associatedAttributes(
+  const smtk::resource::ConstPersistentObjectPtr& object,
+  const smtk::attribute::ConstDefinitionPtr& def) const
+{
+  std::vector<AttributePtr> result;
+  if (!object || !def)
+  {
+    return result;
+  }
+  std::size_t generation;
+  // Attributes read from a stale entry are released after the lock is.
+  std::vector<AttributePtr> stale;
+  {
+    std::lock_guard<std::mutex> lock(m_associationCacheMutex);
+    auto it = m_associationCache.find(object->id());
+    if (it != m_associationCache.end())
+    {
+      auto dit = it->second.find(def.get());
+      if (dit != it->second.end())
+      {
+        for (const auto& weakAtt : dit->second)
+        {
+          auto att = weakAtt.lock();
+          if (!att)
+          {
+            break;
+          }
+          result.push_back(att);
+        }
+        if (result.size() == dit->second.size())
+        {
+          return result;
+        }
+        // An attribute was destroyed without expiring the cache; query again.
+        stale.swap(result);
+        it->second.erase(dit);
+      }
+    }
+    generation = m_associationCacheGeneration;
+  }
+
+  // Query links without holding the lock, then cache the result unless
+  // associations changed in the meantime.
+  for (const auto& att : this->attributes(object))
+  {
+    if (att->definition()->isA(def))
+    {
+      result.push_back(att);
+    }
+  }
+  std::lock_guard<std::mutex> lock(m_associationCacheMutex);
+  if (generation == m_associationCacheGeneration)
+  {
+    m_associationCache[object->id()][def.get()].assign(result.begin(), result.end());
+  }
+  return result;
+}
+
+void Resource::invalidateAssociationCache(const smtk::common::UUID& id)
+{
+  std::lock_guard<std::mutex> lock(m_associationCacheMutex);
+  ++m_associationCacheGeneration;
+  m_associationCache.erase(id);
+}
+
+void Resource::invalidateAssociationCache()
+{
+  std::lock_guard<std::mutex> lock(m_associationCacheMutex);
+  ++m_associationCacheGeneration;
+  m_associationCache.clear();
+}
+
 bool Resource::hasAttributes(const smtk::resource::ConstPersistentObjectPtr& object) const
 {
   // See if the object has any attributes - Note that the
@@ -1329,6 +1467,7 @@ bool Resource::copyInitialize(
   // copy the active category information
   m_activeCategoriesEnabled = source->m_activeCategoriesEnabled;
   m_activeCategories = source->m_activeCategories;
+  this->invalidateValidity();
 
   std::vector<smtk::attribute::AttributePtr> allAttributes;
   if (options.copyComponents())
@@ -1520,11 +1659,146 @@ void Resource::updateViewComponentIdAttributes(
 
 void Resource::setActiveCategoriesEnabled(bool mode)
 {
-  m_activeCategoriesEnabled = mode;
+  if (m_activeCategoriesEnabled != mode)
+  {
+    m_activeCategoriesEnabled = mode;
+    this->invalidateValidity();
+  }
 }
 void Resource::setActiveCategories(const std::set<std::string>& cats)
 {
-  m_activeCategories = cats;
+  if (m_activeCategories != cats)
+  {
+    m_activeCategories = cats;
+    this->invalidateValidity();
+  }
+}
+
+void Resource::findDependentAttributes(
+  const smtk::common::UUID& id,
+  std::set<smtk::attribute::AttributePtr>& dependents) const
+{
+  std::lock_guard<std::mutex> guard(m_dependentsMutex);
+  // The references held by the object itself do not affect which attributes
+  // refer to it, so they may be read later.
+  this->updateDependentAttributes(id);
+
+  std::set<smtk::common::UUID> visited{ id };
+  std::vector<smtk::common::UUID> pending{ id };
+  while (!pending.empty())
+  {
+    auto it = m_dependentAttributes.find(pending.back());
+    pending.pop_back();
+    if (it == m_dependentAttributes.end())
+    {
+      continue;
+    }
+    for (const auto& dependentId : it->second)
+    {
+      if (!visited.insert(dependentId).second)
+      {
+        continue;
+      }
+      if (auto dependent = this->findAttribute(dependentId))
+      {
+        dependents.insert(dependent);
+        pending.push_back(dependentId);
+      }
+    }
+  }
+}
+
+void Resource::markReferencesModified(const smtk::common::UUID& id)
+{
+  std::lock_guard<std::mutex> guard(m_dependentsMutex);
+  m_staleReferences.insert(id);
+}
+
+void Resource::updateDependentAttributes(const smtk::common::UUID& deferred) const
+{
+  bool isDeferred = false;
+  for (const auto& id : m_staleReferences)
+  {
+    if (id == deferred)
+    {
+      isDeferred = true;
+      continue;
+    }
+
+    // Forget the references previously recorded for the attribute.
+    auto it = m_referencedObjects.find(id);
+    if (it != m_referencedObjects.end())
+    {
+      for (const auto& objectId : it->second)
+      {
+        auto dit = m_dependentAttributes.find(objectId);
+        if (dit != m_dependentAttributes.end())
+        {
+          dit->second.erase(id);
+          if (dit->second.empty())
+          {
+            m_dependentAttributes.erase(dit);
+          }
+        }
+      }
+      m_referencedObjects.erase(it);
+    }
+
+    // Record the objects it refers to now (if it still exists).
+    auto attribute = this->findAttribute(id);
+    if (!attribute)
+    {
+      continue;
+    }
+    std::vector<smtk::common::UUID> referenced;
+    auto addReferences = [&attribute, &referenced](const smtk::attribute::ReferenceItem& item) {
+      for (std::size_t ii = 0; ii < item.numberOfValues(); ++ii)
+      {
+        if (item.isSet(ii))
+        {
+          auto objectId = attribute->guardedLinks()->linkedObjectId(item.objectKey(ii));
+          if (!objectId.isNull())
+          {
+            referenced.push_back(objectId);
+          }
+        }
+      }
+    };
+    if (auto associations = attribute->associations())
+    {
+      addReferences(*associations);
+    }
+    std::vector<smtk::attribute::ItemPtr> items;
+    attribute->filterItems(
+      items, [](const smtk::attribute::ItemPtr&) { return true; }, false);
+    for (const auto& item : items)
+    {
+      if (auto referenceItem = std::dynamic_pointer_cast<smtk::attribute::ReferenceItem>(item))
+      {
+        addReferences(*referenceItem);
+      }
+      else if (auto valueItem = std::dynamic_pointer_cast<smtk::attribute::ValueItem>(item))
+      {
+        if (auto expression = valueItem->expressionReference())
+        {
+          addReferences(*expression);
+        }
+      }
+    }
+    for (const auto& objectId : referenced)
+    {
+      m_dependentAttributes[objectId].insert(id);
+    }
+    if (!referenced.empty())
+    {
+      m_referencedObjects[id] = std::move(referenced);
+    }
+  }
+  m_staleReferences.clear();
+  if (isDeferred)
+  {
+    m_staleReferences.insert(deferred);
+  }
 }
 
 bool Resource::passActiveCategoryCheck(const smtk::common::Categories::Expression& cats) const
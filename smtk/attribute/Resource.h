@@ -42,10 +42,12 @@
 
 #include "smtk/view/Configuration.h"
 
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace smtk
@@ -217,6 +219,15 @@ public:
     bool concreteOnly,
     std::vector<smtk::attribute::DefinitionPtr>& result) const;
 
+  ///\brief Number the resource's definitions for constant-time inheritance tests.
+  ///
+  /// Definitions are numbered depth-first so that every definition derived from
+  /// a given definition falls in a contiguous range following it. This range
+  /// is used by Definition::isA(), findAttributes() and findAllDerivedDefinitions().
+  /// The index is rebuilt on demand after definitions are created or removed,
+  /// so there is normally no need to call this method directly.
+  void updateInheritanceIndex() const;
+
   void findDefinitionAttributes(
     const std::string& type,
     std::vector<smtk::attribute::AttributePtr>& result) const;
@@ -272,6 +283,34 @@ public:
   const std::set<std::string>& activeCategories() const { return m_activeCategories; }
   ///@}
 
+  ///@{
+  ///\brief A counter used to expire the validity cached by Attribute::isValidCached()
+  ///       of every attribute in the resource.
+  ///
+  /// The generation is incremented when active categories change. Modifying an
+  /// item only expires the cached validity of its attribute and of the attributes
+  /// that depend upon it (see Attribute::markModified()). Call invalidateValidity()
+  /// after changing anything else that attribute validity depends upon (such as
+  /// definitions or the properties of referenced components).
+  std::size_t validityGeneration() const { return m_validityGeneration; }
+  void invalidateValidity() { ++m_validityGeneration; }
+  ///@}
+
+  ///\brief Insert into \a dependents the attributes whose validity depends upon
+  ///       the object with the given \a id.
+  ///
+  /// These are the attributes whose reference items (including associations and
+  /// the items holding expressions) refer to the object and, recursively, the
+  /// attributes that depend upon those. The object itself is not inserted.
+  void findDependentAttributes(
+    const smtk::common::UUID& id,
+    std::set<smtk::attribute::AttributePtr>& dependents) const;
+
+  /// Note that the references held by the attribute with the given \a id have
+  /// changed (or are about to change), so that findDependentAttributes() reads
+  /// them again. Reference items call this when they are modified.
+  void markReferencesModified(const smtk::common::UUID& id);
+
   bool passActiveCategoryCheck(const smtk::common::Categories::Expression& cats) const;
   bool passActiveCategoryCheck(const smtk::common::Categories& cats) const;
 
@@ -320,6 +359,26 @@ public:
   // true if the PersistentObject has attributes associated with it
   bool hasAttributes(const smtk::resource::ConstPersistentObjectPtr& object) const;
 
+  ///\brief Return the attributes associated with \a object whose definitions are
+  /// (or are derived from) \a def.
+  ///
+  /// Results are cached per object and definition, which makes repeated exclusion
+  /// and prerequisite checks inexpensive. An object's entry expires when any
+  /// attribute's association to it is added or removed or when the object is
+  /// expunged by an operation; the whole cache expires when definitions or
+  /// attributes are removed.
+  std::vector<AttributePtr> associatedAttributes(
+    const smtk::resource::ConstPersistentObjectPtr& object,
+    const smtk::attribute::ConstDefinitionPtr& def) const;
+
+  ///\brief Expire the cached associations of the object with the given \a id
+  /// (or of every object).
+  ///
+  /// Association items call this as values are added or removed. Call it after
+  /// modifying association links directly through the links API.
+  void invalidateAssociationCache(const smtk::common::UUID& id);
+  void invalidateAssociationCache();
+
   bool hasAttributes() const { return !m_attributes.empty(); }
 
   void disassociateAllAttributes(const smtk::resource::PersistentObjectPtr& object);
@@ -504,6 +563,10 @@ protected:
   void internalFindAttributes(
     attribute::DefinitionPtr def,
     std::vector<smtk::attribute::AttributePtr>& result) const;
+  // Append \a def and its derived definitions (depth-first) to m_inheritanceOrder.
+  void numberDefinitions(const smtk::attribute::DefinitionPtr& def) const;
+  // Discard the inheritance index and cached associations after definitions change.
+  void invalidateInheritanceIndex();
   bool copyDefinitionImpl(
     smtk::attribute::DefinitionPtr sourceDef,
     smtk::attribute::ItemDefinition::CopyInfo& info);
@@ -519,9 +582,33 @@ protected:
     smtk::attribute::DefinitionPtr,
     std::set<smtk::attribute::WeakDefinitionPtr, Definition::WeakDefinitionPtrCompare>>
     m_derivedDefInfo;
+  // Definitions in depth-first order; see updateInheritanceIndex().
+  mutable std::vector<smtk::attribute::DefinitionPtr> m_inheritanceOrder;
+  mutable std::atomic<bool> m_inheritanceIndexValid{ false };
+  mutable std::mutex m_inheritanceIndexMutex;
+  // Attributes associated with an object, indexed by object ID then by the
+  // definition they were filtered against; see associatedAttributes(). The
+  // cache does not keep attributes alive; entries holding an expired
+  // attribute are discarded when they are next queried.
+  mutable std::unordered_map<
+    smtk::common::UUID,
+    std::unordered_map<const smtk::attribute::Definition*, std::vector<WeakAttributePtr>>>
+    m_associationCache;
+  mutable std::size_t m_associationCacheGeneration{ 0 };
+  mutable std::mutex m_associationCacheMutex;
   std::set<std::string> m_categories;
   std::set<std::string> m_activeCategories;
   bool m_activeCategoriesEnabled = false;
+  std::atomic<std::size_t> m_validityGeneration{ 1 };
+  // Attributes whose references must be read again before dependents are
+  // found, the objects referenced by each attribute, and the attributes
+  // referencing each object.
+  mutable std::mutex m_dependentsMutex;
+  mutable std::set<smtk::common::UUID> m_staleReferences;
+  mutable std::unordered_map<smtk::common::UUID, std::vector<smtk::common::UUID>>
+    m_referencedObjects;
+  mutable std::unordered_map<smtk::common::UUID, std::set<smtk::common::UUID>>
+    m_dependentAttributes;
   smtk::attribute::Analyses m_analyses;
   std::map<std::string, smtk::view::ConfigurationPtr> m_views;
   std::map<std::string, std::map<std::string, smtk::view::Configuration::Component>> m_styles;
@@ -547,6 +634,10 @@ protected:
   std::size_t m_templateVersion = 0;
 
 private:
+  // Record the references held by attributes in m_staleReferences (other than
+  // \a deferred, which may be in the midst of modification).
+  void updateDependentAttributes(const smtk::common::UUID& deferred) const;
+
   mutable std::mutex m_mutex;
 };
 
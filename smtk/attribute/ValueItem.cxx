@@ -95,6 +95,7 @@ void ValueItem::unset(std::size_t elementIndex)
   m_isSet[elementIndex] = false;
   // Clear the current list of active children items
   m_activeChildrenItems.clear();
+  this->markModified();
 }
 
 bool ValueItem::isSet(std::size_t elementIndex) const
@@ -383,6 +384,7 @@ bool ValueItem::setExpression(smtk::attribute::AttributePtr exp)
   {
     m_expression->setValue(exp);
   }
+  this->markModified();
   return true;
 }
 
@@ -448,7 +450,7 @@ bool ValueItem::rotate(std::size_t fromPosition, std::size_t toPosition)
   {
     this->rotateVector(m_discreteIndices, fromPosition, toPosition);
   }
-
+  this->markModified();
   return true;
 }
 
@@ -477,6 +479,7 @@ bool ValueItem::setDiscreteIndex(std::size_t element, int index)
     m_isSet[element] = true;
     this->updateDiscreteValue(element);
     this->updateActiveChildrenItems();
+    this->markModified();
     return true;
   }
   return false;
@@ -332,6 +332,7 @@ bool ValueItemTemplate<DataT>::setValue(std::size_t element, const DataT& val)
       {
         this->updateActiveChildrenItems();
       }
+      this->markModified();
       return true;
     }
     return false;
@@ -345,6 +346,7 @@ bool ValueItemTemplate<DataT>::setValue(std::size_t element, const DataT& val)
     {
       m_expression->unset();
     }
+    this->markModified();
     return true;
   }
   return false;
@@ -410,6 +412,7 @@ bool ValueItemTemplate<DataT>::appendValue(const DataT& val)
       m_values.push_back(val);
       m_discreteIndices.push_back(index);
       m_isSet.push_back(true);
+      this->markModified();
       return true;
     }
     return false;
@@ -422,6 +425,7 @@ bool ValueItemTemplate<DataT>::appendValue(const DataT& val)
     }
     m_values.push_back(val);
     m_isSet.push_back(true);
+    this->markModified();
     return true;
   }
   return false;
@@ -465,6 +469,7 @@ bool ValueItemTemplate<DataT>::setNumberOfValues(std::size_t newSize)
     {
       m_discreteIndices.resize(newSize);
     }
+    this->markModified();
     return true;
   }
   if (def->hasDefault())
@@ -488,6 +493,7 @@ bool ValueItemTemplate<DataT>::setNumberOfValues(std::size_t newSize)
   {
     m_discreteIndices.resize(newSize, def->defaultDiscreteIndex());
   }
+  this->markModified();
   return true;
 }
 
@@ -512,6 +518,7 @@ bool ValueItemTemplate<DataT>::removeValue(std::size_t i)
   {
     m_discreteIndices.erase(m_discreteIndices.begin() + i);
   }
+  this->markModified();
   return true;
 }
 
@@ -667,6 +674,7 @@ bool ValueItemTemplate<DataT>::rotate(std::size_t fromPosition, std::size_t toPo
 
   // No need to check to see if the rotation is valid since ValueItem already checked it
   this->rotateVector(m_values, fromPosition, toPosition);
+  this->markModified();
   return true;
 }
 
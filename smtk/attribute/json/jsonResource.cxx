@@ -39,6 +39,21 @@ using json = nlohmann::json;
 /// \brief Provide a way to serialize an attribute::Resource. The current version is 7.0 but
 /// but can also read in a resource from version 3.0 format or later.
 SMTKCORE_EXPORT void to_json(json& j, const smtk::attribute::ResourcePtr& res)
+{
+  std::vector<smtk::attribute::AttributePtr> attributes;
+  smtk::attribute::to_json(j, res, attributes);
+  json attsObj = json::array();
+  for (const auto& att : attributes)
+  {
+    attsObj.push_back(att);
+  }
+  j["Attributes"] = attsObj;
+}
+
+SMTKCORE_EXPORT void to_json(
+  json& j,
+  const smtk::attribute::ResourcePtr& res,
+  std::vector<smtk::attribute::AttributePtr>& attributes)
 {
   smtk::resource::to_json(j, smtk::static_pointer_cast<smtk::resource::Resource>(res));
   j["version"] = "7.0";
@@ -152,7 +167,6 @@ SMTKCORE_EXPORT void to_json(json& j, const smtk::attribute::ResourcePtr& res)
   std::vector<smtk::attribute::DefinitionPtr> baseDefPtrs, derivedDefPtrs;
   res->findBaseDefinitions(baseDefPtrs);
   json defsObj = json::array();
-  json attsObj = json::array();
   json excsObj = json::array();
   json presObj = json::array();
 
@@ -165,10 +179,7 @@ SMTKCORE_EXPORT void to_json(json& j, const smtk::attribute::ResourcePtr& res)
 
     std::vector<smtk::attribute::AttributePtr> atts;
     res->findDefinitionAttributes(currentDef->type(), atts);
-    for (const auto& att : atts)
-    {
-      attsObj.push_back(att);
-    }
+    attributes.insert(attributes.end(), atts.begin(), atts.end());
 
     defsQueue.pop();
 
@@ -227,8 +238,6 @@ SMTKCORE_EXPORT void to_json(json& j, const smtk::attribute::ResourcePtr& res)
     j["Prerequisites"] = presObj;
   }
 
-  j["Attributes"] = attsObj;
-
   // Process Association Rules
   if (!res->associationRules().associationRuleContainer().empty())
   {
@@ -328,6 +337,45 @@ SMTKCORE_EXPORT void to_json(json& j, const smtk::attribute::ResourcePtr& res)
 
 SMTKCORE_EXPORT void from_json(const json& j, smtk::attribute::ResourcePtr& res)
 {
+  smtk::attribute::from_json(
+    j, res, [&j](const std::function<void(const json&)>& addAttribute) {
+      auto attributes = j.find("Attributes");
+      if (attributes != j.end())
+      {
+        for (const auto& jAtt : *attributes)
+        {
+          addAttribute(jAtt);
+        }
+      }
+    });
+}
+
+class AttributeRecordReader::Internal
+{
+public:
+  smtk::attribute::ResourcePtr resource;
+  std::set<const smtk::attribute::ItemDefinition*> convertedAttDefs;
+  std::vector<ItemExpressionInfo> itemExpressionInfo;
+  std::vector<AttRefInfo> attRefInfo;
+};
+
+AttributeRecordReader::AttributeRecordReader(const smtk::attribute::ResourcePtr& resource)
+  : m_internal(new Internal)
+{
+  m_internal->resource = resource;
+}
+
+AttributeRecordReader::~AttributeRecordReader() = default;
+
+const smtk::attribute::ResourcePtr& AttributeRecordReader::resource() const
+{
+  return m_internal->resource;
+}
+
+void AttributeRecordReader::begin(const json& j)
+{
+  auto& res = m_internal->resource;
+
   //TODO: v2Parser has a notion of rootName
   if (!res.get() || j.is_null())
   {
@@ -531,7 +579,7 @@ SMTKCORE_EXPORT void from_json(const json& j, smtk::attribute::ResourcePtr& res)
   }
 
   // Process Definition info
-  std::set<const smtk::attribute::ItemDefinition*> convertedAttDefs;
+  auto& convertedAttDefs = m_internal->convertedAttDefs;
   auto definitions = j.find("Definitions");
   if (definitions != j.end())
   {
@@ -768,75 +816,79 @@ SMTKCORE_EXPORT void from_json(const json& j, smtk::attribute::ResourcePtr& res)
       }
     }
   }
+}
 
-  // Process attributes info
-  std::vector<ItemExpressionInfo> itemExpressionInfo;
-  std::vector<AttRefInfo> attRefInfo;
-  smtk::attribute::AttributePtr att;
-  auto attributes = j.find("Attributes");
-  if (attributes != j.end())
+void AttributeRecordReader::add(const json& jAtt)
+{
+  auto& res = m_internal->resource;
+  auto& itemExpressionInfo = m_internal->itemExpressionInfo;
+  auto& attRefInfo = m_internal->attRefInfo;
+  auto name = jAtt.find("Name");
+  if (name == jAtt.end())
   {
-    for (const auto& jAtt : *attributes)
-    {
-      auto name = jAtt.find("Name");
-      if (name == jAtt.end())
-      {
-        smtkErrorMacro(
-          smtk::io::Logger::instance(), "Invalid Attribute! - Missing json Attribute Name");
-        continue;
-      }
-      // Lets get the defintion for the attribute
-      auto type = jAtt.find("Type");
-      if (type == jAtt.end())
-      {
-        smtkErrorMacro(
-          smtk::io::Logger::instance(),
-          "Invalid Attribute! - Missing Type for attribute:" << *name);
-        continue;
-      }
-      smtk::attribute::DefinitionPtr def = res->findDefinition(type->get<std::string>());
-      if (def == nullptr)
-      {
-        smtkErrorMacro(
-          smtk::io::Logger::instance(),
-          "Invalid Attribute! - Cannot find Definition of Type:" << *type
-                                                                 << " for attribute:" << *name);
-        continue;
-      }
-      // Is the definition abstract?
-      if (def->isAbstract())
-      {
-        smtkErrorMacro(
-          smtk::io::Logger::instance(),
-          "Attribute: " << *name << " of Type: " << *type
-                        << "  - is based on an abstract definition");
-        continue;
-      }
+    smtkErrorMacro(
+      smtk::io::Logger::instance(), "Invalid Attribute! - Missing json Attribute Name");
+    return;
+  }
+  // Lets get the defintion for the attribute
+  auto type = jAtt.find("Type");
+  if (type == jAtt.end())
+  {
+    smtkErrorMacro(
+      smtk::io::Logger::instance(), "Invalid Attribute! - Missing Type for attribute:" << *name);
+    return;
+  }
+  smtk::attribute::DefinitionPtr def = res->findDefinition(type->get<std::string>());
+  if (def == nullptr)
+  {
+    smtkErrorMacro(
+      smtk::io::Logger::instance(),
+      "Invalid Attribute! - Cannot find Definition of Type:" << *type
+                                                             << " for attribute:" << *name);
+    return;
+  }
+  // Is the definition abstract?
+  if (def->isAbstract())
+  {
+    smtkErrorMacro(
+      smtk::io::Logger::instance(),
+      "Attribute: " << *name << " of Type: " << *type
+                    << "  - is based on an abstract definition");
+    return;
+  }
 
-      auto id = jAtt.find("ID");
-      if (id == jAtt.end())
-      {
-        smtkErrorMacro(
-          smtk::io::Logger::instance(),
-          "Invalid Attribute! - Missing ID for attribute:" << *name << " of type:" << *type);
-        continue;
-      }
-      smtk::common::UUID uuid(id->get<std::string>());
+  auto id = jAtt.find("ID");
+  if (id == jAtt.end())
+  {
+    smtkErrorMacro(
+      smtk::io::Logger::instance(),
+      "Invalid Attribute! - Missing ID for attribute:" << *name << " of type:" << *type);
+    return;
+  }
+  smtk::common::UUID uuid(id->get<std::string>());
 
-      // Ok we can now create the attribute
-      att = res->createAttribute(*name, def, uuid);
+  // Ok we can now create the attribute
+  auto att = res->createAttribute(*name, def, uuid);
 
-      if (att == nullptr)
-      {
-        smtkErrorMacro(
-          smtk::io::Logger::instance(),
-          "Attribute: " << *name << " of Type: " << *type
-                        << "  - could not be created - is the name in use?");
-        continue;
-      }
-      smtk::attribute::from_json(jAtt, att, itemExpressionInfo, attRefInfo, convertedAttDefs);
-    }
+  if (att == nullptr)
+  {
+    smtkErrorMacro(
+      smtk::io::Logger::instance(),
+      "Attribute: " << *name << " of Type: " << *type
+                    << "  - could not be created - is the name in use?");
+    return;
   }
+  smtk::attribute::from_json(
+    jAtt, att, itemExpressionInfo, attRefInfo, m_internal->convertedAttDefs);
+}
+
+void AttributeRecordReader::finish(const json& j)
+{
+  auto& res = m_internal->resource;
+  auto& itemExpressionInfo = m_internal->itemExpressionInfo;
+  auto& attRefInfo = m_internal->attRefInfo;
+  smtk::attribute::AttributePtr att;
+
   // At this point we have all the attributes read in so lets
   // fix up all of the attribute references
   for (size_t i = 0; i < itemExpressionInfo.size(); i++)
@@ -920,7 +972,7 @@ SMTKCORE_EXPORT void from_json(const json& j, smtk::attribute::ResourcePtr& res)
 
   // Process Active Category Information
   bool enabled = false;
-  result = j.find("ActiveCategoriesEnabled");
+  auto result = j.find("ActiveCategoriesEnabled");
   if (result != j.end())
   {
     enabled = *result;
@@ -933,5 +985,15 @@ SMTKCORE_EXPORT void from_json(const json& j, smtk::attribute::ResourcePtr& res)
   }
   res->setActiveCategoriesEnabled(enabled);
 }
+
+SMTKCORE_EXPORT void
+from_json(const json& j, smtk::attribute::ResourcePtr& res, const AttributeRecords& attributes)
+{
+  AttributeRecordReader reader(res);
+  reader.begin(j);
+  res = reader.resource();
+  attributes([&reader](const json& jAtt) { reader.add(jAtt); });
+  reader.finish(j);
+}
 } // namespace attribute
 } // namespace smtk
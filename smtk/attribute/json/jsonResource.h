@@ -19,7 +19,10 @@
 
 #include "smtk/CoreExports.h"
 
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace smtk
 {
@@ -33,7 +36,58 @@ using json = nlohmann::json;
 /// Convert a SelectionManager's currentSelection() to JSON.
 SMTKCORE_EXPORT void to_json(json& j, const smtk::attribute::ResourcePtr& col);
 
+/// Serialize everything but the "Attributes" member of a resource.
+///
+/// Instead, the attributes are appended to \a attributes in the order that
+/// they would have been serialized, so that they may be streamed (see
+/// smtk::resource::json::StreamWriter).
+SMTKCORE_EXPORT void to_json(
+  json& j,
+  const smtk::attribute::ResourcePtr& col,
+  std::vector<smtk::attribute::AttributePtr>& attributes);
+
 SMTKCORE_EXPORT void from_json(const json& j, smtk::attribute::ResourcePtr& col);
+
+/// A function that passes each attribute record it reads to the function it is given.
+using AttributeRecords = std::function<void(const std::function<void(const json&)>&)>;
+
+/// Deserialize a resource whose attribute records are provided by \a attributes
+/// rather than by the "Attributes" member of \a j.
+///
+/// The \a attributes function is invoked once definitions have been deserialized.
+SMTKCORE_EXPORT void
+from_json(const json& j, smtk::attribute::ResourcePtr& col, const AttributeRecords& attributes);
+
+/**\brief Deserialize a resource whose attribute records arrive one at a time.
+  *
+  * This allows attributes to be deserialized as they are parsed from a stream
+  * (see smtk::resource::json::StreamReader) rather than after the entire
+  * document has been held in memory.
+  */
+class SMTKCORE_EXPORT AttributeRecordReader
+{
+public:
+  /// Deserialize into \a resource (or into a new resource if it is null).
+  AttributeRecordReader(const smtk::attribute::ResourcePtr& resource);
+  ~AttributeRecordReader();
+
+  /// The resource being deserialized.
+  const smtk::attribute::ResourcePtr& resource() const;
+
+  /// Deserialize the members of \a j that attributes depend upon (definitions,
+  /// analyses, rules, evaluators, etc.). This must be called before add().
+  void begin(const json& j);
+  /// Create the attribute described by \a jAtt.
+  void add(const json& jAtt);
+  /// Resolve references between attributes and deserialize the members of \a j
+  /// that are processed after attributes: "Styles", "Views",
+  /// "ActiveCategoriesEnabled" and "ActiveCategories".
+  void finish(const json& j);
+
+private:
+  class Internal;
+  std::unique_ptr<Internal> m_internal;
+};
 } // namespace attribute
 } // namespace smtk
 
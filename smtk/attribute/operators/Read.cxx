@@ -29,6 +29,7 @@
 
 #include "smtk/resource/Manager.h"
 #include "smtk/resource/json/Helper.h"
+#include "smtk/resource/json/StreamReader.h"
 
 #include "smtk/common/VersionNumber.h"
 #include "smtk/common/json/jsonVersionNumber.h"
@@ -38,6 +39,37 @@ SMTK_THIRDPARTY_PRE_INCLUDE
 SMTK_THIRDPARTY_POST_INCLUDE
 
 #include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Set \a version from \a j and return whether it is supported (3.0 through 7.x).
+bool supportedVersion(const nlohmann::json& j, smtk::common::VersionNumber& version)
+{
+  using smtk::common::VersionNumber;
+  try
+  {
+    version = j.at("version");
+    return version >= VersionNumber(3) && version < VersionNumber(8);
+  }
+  catch (const std::exception&)
+  {
+    return false;
+  }
+}
+
+// Return whether the member \a key is deserialized after attributes and so
+// may follow "Attributes" in a file that is read as it is parsed.
+bool followsAttributes(const std::string& key)
+{
+  return key == "Styles" || key == "Views" || key == "ActiveCategoriesEnabled" ||
+    key == "ActiveCategories";
+}
+
+} // namespace
 
 namespace smtk
 {
@@ -64,49 +96,6 @@ Read::Result Read::operateInternal()
   helper.clear();
   helper.setManagers(this->managers());
 
-  // Read the file into nlohmann json.
-  nlohmann::json j;
-  try
-  {
-    j = nlohmann::json::parse(file);
-  }
-  catch (...)
-  {
-    smtkErrorMacro(log(), "Cannot parse file \"" << filename << "\".");
-    return this->createResult(smtk::operation::Operation::Outcome::FAILED);
-  }
-
-  bool supportedVersion = false;
-  VersionNumber version;
-  try
-  {
-    // Is this a supported version?  Should be 3.0, 4.0, 5.0, 6.0, or 7.0.
-    version = j.at("version");
-    if (version >= VersionNumber(3) && version < VersionNumber(8))
-    {
-      supportedVersion = true;
-    }
-  }
-  catch (const std::exception&)
-  {
-    supportedVersion = false;
-  }
-  if (!supportedVersion)
-  {
-    if (!version.isValid())
-    {
-      smtkErrorMacro(log(), "Cannot read attribute file \"" << filename << "\" - Missing Version.");
-    }
-    else
-    {
-      smtkErrorMacro(
-        log(),
-        "Cannot read attribute file \"" << filename << "\" - Unsupported Version: " << version
-                                        << ".");
-    }
-    return this->createResult(smtk::operation::Operation::Outcome::FAILED);
-  }
-
   // Create an attribute resource. If available, use the item definition
   // manager to populate the resource with custom items.
   smtk::attribute::Resource::Ptr resource = smtk::attribute::Resource::create();
@@ -145,8 +134,99 @@ Read::Result Read::operateInternal()
     }
   }
 
+  // Parse the file in a single pass. Files written since attribute records
+  // were placed after all other members are deserialized as they are parsed
+  // so that each record is released once its attribute exists. Older files
+  // (whose members are in key order, with "Attributes" before "Definitions")
+  // have their records held until the rest of the file has been parsed.
+  smtk::attribute::AttributeRecordReader records(resource);
+  std::vector<nlohmann::json> buffered;
+  std::set<std::string> leading;
+  bool streaming = false;
+  bool supported = true;
+  VersionNumber version;
+  smtk::resource::json::StreamReader reader(file);
+  reader.addArray("Attributes", [&](nlohmann::json& jAtt) {
+    if (!streaming && buffered.empty() && supported)
+    {
+      // "version" sorts after "Attributes", so it precedes the records only
+      // when they were written last.
+      const auto& members = reader.document();
+      if (members.contains("version"))
+      {
+        supported = supportedVersion(members, version);
+        if (supported)
+        {
+          records.begin(members);
+          streaming = true;
+          for (const auto& member : members.items())
+          {
+            leading.insert(member.key());
+          }
+        }
+      }
+    }
+    if (streaming)
+    {
+      records.add(jAtt);
+    }
+    else if (supported)
+    {
+      buffered.push_back(std::move(jAtt));
+    }
+  });
+  nlohmann::json j;
+  if (!reader.read(j))
+  {
+    smtkErrorMacro(log(), "Cannot parse file \"" << filename << "\".");
+    return this->createResult(smtk::operation::Operation::Outcome::FAILED);
+  }
+
+  if (!streaming)
+  {
+    supported = supportedVersion(j, version);
+  }
+  if (!supported)
+  {
+    if (!version.isValid())
+    {
+      smtkErrorMacro(log(), "Cannot read attribute file \"" << filename << "\" - Missing Version.");
+    }
+    else
+    {
+      smtkErrorMacro(
+        log(),
+        "Cannot read attribute file \"" << filename << "\" - Unsupported Version: " << version
+                                        << ".");
+    }
+    return this->createResult(smtk::operation::Operation::Outcome::FAILED);
+  }
+
   // Copy the contents of the json object into the attribute resource.
-  smtk::attribute::from_json(j, resource);
+  if (streaming)
+  {
+    for (const auto& member : j.items())
+    {
+      if (leading.find(member.key()) == leading.end() && !followsAttributes(member.key()))
+      {
+        smtkErrorMacro(
+          log(),
+          "Cannot read attribute file \"" << filename << "\" - \"" << member.key()
+                                          << "\" must precede \"Attributes\".");
+        return this->createResult(smtk::operation::Operation::Outcome::FAILED);
+      }
+    }
+  }
+  else
+  {
+    records.begin(j);
+    for (const auto& jAtt : buffered)
+    {
+      records.add(jAtt);
+    }
+    buffered.clear();
+  }
+  records.finish(j);
   resource->setLocation(filename);
 
   // Create a result object.
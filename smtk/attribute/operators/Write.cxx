@@ -24,11 +24,15 @@
 
 #include "smtk/io/Logger.h"
 
+#include "smtk/resource/json/Helper.h"
+#include "smtk/resource/json/StreamWriter.h"
+
 SMTK_THIRDPARTY_PRE_INCLUDE
 #include "nlohmann/json.hpp"
 SMTK_THIRDPARTY_POST_INCLUDE
 
 #include <fstream>
+#include <vector>
 
 namespace smtk
 {
@@ -42,9 +46,11 @@ Write::Result Write::operateInternal()
   smtk::attribute::Resource::Ptr resource =
     std::dynamic_pointer_cast<smtk::attribute::Resource>(resourceItem->value());
 
-  // Serialize resource into a set of JSON records:
+  // Serialize everything but the resource's attributes into a set of JSON
+  // records. Attributes are serialized in parallel as the file is written.
   nlohmann::json j;
-  smtk::attribute::to_json(j, resource);
+  std::vector<smtk::attribute::AttributePtr> attributes;
+  smtk::attribute::to_json(j, resource, attributes);
 
   if (j.is_null())
   {
@@ -61,7 +67,20 @@ Write::Result Write::operateInternal()
       smtkErrorMacro(log(), "Unable to open \"" << resource->location() << "\" for writing.");
       return this->createResult(smtk::operation::Operation::Outcome::FAILED);
     }
-    file << j.dump(2);
+    smtk::resource::json::StreamWriter writer(
+      file, 2, &smtk::resource::json::Helper::threadPool());
+    // Write attributes after the definitions (and everything else) they
+    // depend upon so that Read can deserialize them as they are parsed.
+    writer.setArraysLast(true);
+    writer.addArray(
+      "Attributes", attributes.size(), [&attributes](std::size_t index, nlohmann::json& jj) {
+        jj = attributes[index];
+      });
+    if (!writer.write(j))
+    {
+      smtkErrorMacro(log(), "Unable to write \"" << resource->location() << "\".");
+      return this->createResult(smtk::operation::Operation::Outcome::FAILED);
+    }
     file.close();
   }
 
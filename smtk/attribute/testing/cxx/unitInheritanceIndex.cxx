@@ -0,0 +1,175 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/Definition.h"
+#include "smtk/attribute/ReferenceItemDefinition.h"
+#include "smtk/attribute/Resource.h"
+
+#include "smtk/model/Resource.h"
+#include "smtk/model/Vertex.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+// This test verifies that inheritance tests, derived-attribute queries and
+// the per-object association cache of an attribute resource stay correct as
+// definitions, attributes and associations are added and removed.
+
+using namespace smtk::attribute;
+
+namespace
+{
+template<typename Container>
+std::vector<std::string> names(const Container& objects)
+{
+  std::vector<std::string> result;
+  for (const auto& object : objects)
+  {
+    result.push_back(object->name());
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+template<typename Container>
+std::vector<std::string> types(const Container& definitions)
+{
+  std::vector<std::string> result;
+  for (const auto& definition : definitions)
+  {
+    result.push_back(definition->type());
+  }
+  return result;
+}
+} // anonymous namespace
+
+int unitInheritanceIndex(int /*unused*/, char* /*unused*/[])
+{
+  auto resource = Resource::create();
+  auto modelResource = smtk::model::Resource::create();
+  resource->associate(modelResource);
+
+  // base (abstract) <- a <- a1 <- a11
+  //                 <- b
+  // other
+  auto base = resource->createDefinition("base");
+  base->setIsAbstract(true);
+  auto rule = base->createLocalAssociationRule();
+  base->setLocalAssociationMask(smtk::model::VERTEX);
+  rule->setIsExtensible(true);
+  auto a = resource->createDefinition("a", base);
+  auto a1 = resource->createDefinition("a1", a);
+  auto a11 = resource->createDefinition("a11", a1);
+  auto b = resource->createDefinition("b", base);
+  auto other = resource->createDefinition("other");
+
+  smtkTest(a11->isA(base) && a11->isA(a) && a11->isA(a1), "a11 should derive from its bases.");
+  smtkTest(a11->isA(a11), "A definition should be its own type.");
+  smtkTest(!a->isA(a1) && !b->isA(a) && !a11->isA(b), "Unrelated definitions should differ.");
+  smtkTest(!other->isA(base) && !base->isA(other), "Separate trees should be unrelated.");
+  smtkTest(!a->isA(nullptr), "No definition is null.");
+
+  std::vector<DefinitionPtr> derived;
+  resource->findAllDerivedDefinitions(base, false, derived);
+  smtkTest(
+    (types(derived) == std::vector<std::string>{ "base", "a", "a1", "a11", "b" }),
+    "Derived definitions should be listed depth-first.");
+  derived.clear();
+  resource->findAllDerivedDefinitions(base, true, derived);
+  smtkTest(derived.size() == 4, "The abstract base should be omitted.");
+
+  auto attA = resource->createAttribute("attA", a);
+  auto attA11 = resource->createAttribute("attA11", a11);
+  auto attB = resource->createAttribute("attB", b);
+  resource->createAttribute("attOther", other);
+  std::vector<AttributePtr> found;
+  resource->findAttributes(a, found);
+  smtkTest(
+    (names(found) == std::vector<std::string>{ "attA", "attA11" }),
+    "Expected the attributes of a and of definitions derived from it.");
+
+  // New definitions are added to the index.
+  auto a2 = resource->createDefinition("a2", a);
+  auto attA2 = resource->createAttribute("attA2", a2);
+  smtkTest(a2->isA(a) && a2->isA(base) && !a2->isA(a1), "a2 was not indexed.");
+  smtkTest(a11->isA(a1), "Existing definitions should be renumbered.");
+  found.clear();
+  resource->findAttributes(base, found);
+  smtkTest(found.size() == 4, "Expected 4 attributes derived from base, not " << found.size());
+
+  // Removed definitions are dropped from the index.
+  smtkTest(resource->removeAttribute(attA11), "Could not remove attA11.");
+  smtkTest(resource->removeDefinition(a11), "Could not remove a11.");
+  derived.clear();
+  resource->findAllDerivedDefinitions(a, false, derived);
+  smtkTest(
+    (types(derived) == std::vector<std::string>{ "a", "a1", "a2" }), "a11 was not removed.");
+
+  // Association queries are cached and expire as associations change.
+  auto v0 = modelResource->addVertex();
+  auto v1 = modelResource->addVertex();
+  auto object = v0.component();
+  smtkTest(attA->associate(object) && attB->associate(object), "Could not associate v0.");
+  smtkTest(
+    (names(resource->associatedAttributes(object, a)) == std::vector<std::string>{ "attA" }),
+    "Expected attA to be associated with v0.");
+  smtkTest(
+    resource->associatedAttributes(object, base).size() == 2,
+    "Expected 2 attributes associated with v0.");
+  smtkTest(
+    resource->associatedAttributes(v1.component(), base).empty(),
+    "Expected nothing associated with v1.");
+  smtkTest(a->attributes(object).size() == 1, "Definition::attributes should use the cache.");
+
+  attA2->associate(object);
+  smtkTest(
+    (names(resource->associatedAttributes(object, a)) ==
+     std::vector<std::string>{ "attA", "attA2" }),
+    "Associating should expire the cache.");
+  attA->disassociate(object);
+  smtkTest(
+    (names(resource->associatedAttributes(object, a)) == std::vector<std::string>{ "attA2" }),
+    "Disassociating should expire the cache.");
+  std::weak_ptr<Attribute> weakA2 = attA2;
+  smtkTest(resource->removeAttribute(attA2), "Could not remove attA2.");
+  attA2.reset();
+  smtkTest(
+    resource->associatedAttributes(object, a).empty(),
+    "Removing an attribute should expire the cache.");
+  smtkTest(weakA2.expired(), "The cache should not keep removed attributes alive.");
+
+  // Removing an associated attribute and its definition expires the cache.
+  auto a3 = resource->createDefinition("a3", a);
+  auto attA3 = resource->createAttribute("attA3", a3);
+  smtkTest(attA3->associate(object), "Could not associate attA3.");
+  smtkTest(
+    (names(resource->associatedAttributes(object, base)) ==
+     std::vector<std::string>{ "attA3", "attB" }),
+    "Expected attA3 and attB to be associated with v0.");
+  smtkTest(resource->removeAttribute(attA3), "Could not remove attA3.");
+  smtkTest(
+    (names(resource->associatedAttributes(object, base)) == std::vector<std::string>{ "attB" }),
+    "Removing an associated attribute should expire the cache.");
+  smtkTest(resource->removeDefinition(a3), "Could not remove a3.");
+  smtkTest(
+    (names(resource->associatedAttributes(object, base)) == std::vector<std::string>{ "attB" }),
+    "Removing a definition should expire the cache.");
+  attB->associations()->setValue(0, v1.component());
+  smtkTest(
+    resource->associatedAttributes(object, base).empty() &&
+      resource->associatedAttributes(v1.component(), base).size() == 1,
+    "Replacing an association should expire the cache of both objects.");
+
+  return 0;
+}
@@ -7,10 +7,13 @@
 //  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
 //  PURPOSE.  See the above copyright notice for more information.
 //=========================================================================
+#include "smtk/attribute/ComponentItem.h"
+#include "smtk/attribute/ComponentItemDefinition.h"
 #include "smtk/attribute/Definition.h"
 #include "smtk/attribute/GroupItem.h"
 #include "smtk/attribute/Resource.h"
 #include "smtk/attribute/StringItem.h"
+#include "smtk/attribute/StringItemDefinition.h"
 #include "smtk/io/AttributeReader.h"
 #include "smtk/io/Logger.h"
 
@@ -40,9 +43,101 @@ const std::string attTemplate =
   "</SMTK_AttributeResource>\n";
 
 /* This test verifies that Attribute::isValid() accounts for categories,
- * enabled state, and ignored state of items.
+ * enabled state, and ignored state of items and that Attribute::isValidCached()
+ * expires the results of an attribute and of the attributes referring to it.
  */
 
+namespace
+{
+
+// Give \a definition an item that refers to an attribute of type \a targetType.
+void addTargetItem(
+  const smtk::attribute::DefinitionPtr& definition,
+  const std::string& targetType)
+{
+  auto itemDef =
+    definition->addItemDefinition<smtk::attribute::ComponentItemDefinition>("target");
+  itemDef->setAcceptsEntries(
+    smtk::common::typeName<smtk::attribute::Resource>(),
+    "attribute[type='" + targetType + "']",
+    true);
+}
+
+void testDependents()
+{
+  auto resource = smtk::attribute::Resource::create();
+  auto targetDef = resource->createDefinition("Target");
+  targetDef->addItemDefinition<smtk::attribute::StringItemDefinition>("value");
+  auto userDef = resource->createDefinition("User");
+  addTargetItem(userDef, "Target");
+  auto chainDef = resource->createDefinition("Chain");
+  addTargetItem(chainDef, "User");
+
+  auto target = resource->createAttribute("target", targetDef);
+  auto other = resource->createAttribute("other", targetDef);
+  auto user = resource->createAttribute("user", userDef);
+  auto chain = resource->createAttribute("chain", chainDef);
+
+  // Count how often the validity of the user and chain attributes is computed.
+  int userChecks = 0;
+  int chainChecks = 0;
+  auto userTarget = user->findComponent("target");
+  userTarget->setCustomIsValid(
+    [&userChecks](const smtk::attribute::Item* item, const std::set<std::string>&) {
+      ++userChecks;
+      auto referenced = std::dynamic_pointer_cast<smtk::attribute::Attribute>(
+        static_cast<const smtk::attribute::ComponentItem*>(item)->value());
+      return referenced && referenced->findString("value")->isSet();
+    });
+  auto chainTarget = chain->findComponent("target");
+  chainTarget->setCustomIsValid(
+    [&chainChecks](const smtk::attribute::Item* item, const std::set<std::string>&) {
+      ++chainChecks;
+      auto referenced = std::dynamic_pointer_cast<smtk::attribute::Attribute>(
+        static_cast<const smtk::attribute::ComponentItem*>(item)->value());
+      return referenced && referenced->isValidCached();
+    });
+  userTarget->setValue(target);
+  chainTarget->setValue(user);
+
+  smtkTest(!user->isValidCached(), "The user should be invalid while its target is unset.");
+  smtkTest(!user->isValidCached() && userChecks == 1, "The user's validity should be reused.");
+  smtkTest(!chain->isValidCached() && chainChecks == 1, "The chain should be invalid.");
+
+  // Editing an unrelated attribute keeps cached results.
+  other->findString("value")->setValue("other");
+  smtkTest(!user->isValidCached() && userChecks == 1, "Unrelated edits should not expire.");
+  smtkTest(!chain->isValidCached() && chainChecks == 1, "Unrelated edits should not expire.");
+
+  // Editing the target expires the user and (transitively) the chain.
+  target->findString("value")->setValue("target");
+  smtkTest(user->isValidCached() && userChecks == 2, "The user should be revalidated.");
+  smtkTest(chain->isValidCached() && chainChecks == 2, "The chain should be revalidated.");
+
+  // Once the user refers to another target, the first no longer matters.
+  target->findString("value")->unset();
+  smtkTest(!user->isValidCached() && userChecks == 3, "The user should be invalid again.");
+  userTarget->setValue(other);
+  smtkTest(user->isValidCached() && userChecks == 4, "The user should refer to other.");
+  target->findString("value")->setValue("target");
+  smtkTest(user->isValidCached() && userChecks == 4, "The user no longer depends on target.");
+
+  // Rejected edits of the referenced attribute keep cached results.
+  auto otherValue = other->findString("value");
+  smtkTest(!otherValue->setValue(1, "out of range"), "Out-of-range values should be rejected.");
+  smtkTest(!otherValue->setNumberOfValues(2), "Fixed-size items should not be resized.");
+  smtkTest(!otherValue->removeValue(1), "Out-of-range values should not be removed.");
+  smtkTest(user->isValidCached() && userChecks == 4, "Rejected edits should not expire.");
+
+  // Removing the referenced attribute expires the user and chain.
+  smtkTest(resource->removeAttribute(other), "Could not remove other.");
+  user->isValidCached();
+  chain->isValidCached();
+  smtkTest(userChecks == 5 && chainChecks == 3, "Removing a target should expire dependents.");
+}
+
+} // anonymous namespace
+
 int unitIsValid(int /*unused*/, char* /*unused*/[])
 {
   auto attResource = smtk::attribute::Resource::create();
@@ -97,5 +192,31 @@ int unitIsValid(int /*unused*/, char* /*unused*/[])
   smtkTest(att->isValid(), "Active-categories Test1 should be valid when string item ignored.");
   sitem->setIsIgnored(false);
 
+  // Cached validity should be reused until the attribute or the resource's
+  // active categories change.
+  auto generation = attResource->validityGeneration();
+  smtkTest(!att->isValidCached(), "Cached Test1 should be invalid when string item enabled.");
+  smtkTest(!att->isValidCached(), "Cached Test1 should remain invalid.");
+  smtkTest(
+    attResource->validityGeneration() == generation,
+    "Querying validity should not modify the validity generation.");
+
+  sitem->setValue("value");
+  smtkTest(
+    attResource->validityGeneration() == generation,
+    "Modifying an item should only expire the validity of its attribute and dependents.");
+  smtkTest(att->isValidCached(), "Cached Test1 should be valid once its string item is set.");
+
+  sitem->unset();
+  smtkTest(!att->isValidCached(), "Cached Test1 should be invalid once its string item is unset.");
+
+  attResource->setActiveCategories({ "Other" });
+  smtkTest(
+    att->isValidCached(), "Cached Test1 should be valid when its categories are not active.");
+  attResource->setActiveCategories(categories);
+  smtkTest(!att->isValidCached(), "Cached Test1 should be invalid when its categories are active.");
+
+  testDependents();
+
   return 0;
 }
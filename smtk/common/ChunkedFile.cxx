@@ -0,0 +1,354 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/common/ChunkedFile.h"
+
+#include "smtk/io/Logger.h"
+
+SMTK_THIRDPARTY_PRE_INCLUDE
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+SMTK_THIRDPARTY_POST_INCLUDE
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <map>
+
+namespace smtk
+{
+namespace common
+{
+namespace
+{
+// The file's preamble is the magic string, the format version, a reserved
+// word, and the length of the JSON header (all little-endian).
+constexpr char magic[8] = { 'S', 'M', 'T', 'K', 'C', 'H', 'N', 'K' };
+constexpr std::uint32_t formatVersion = 1;
+constexpr std::size_t preambleSize = 24;
+
+// Arrays begin on multiples of this many bytes (relative to the file).
+constexpr std::size_t alignment = 64;
+
+// Arrays that must be byte-swapped are written through a buffer of this size.
+constexpr std::size_t swapBufferSize = 1 << 16;
+
+static_assert(sizeof(smtk::common::UUID) == 16, "UUIDs must be stored as 16 raw bytes.");
+
+std::size_t aligned(std::size_t offset)
+{
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+void swapBytes(char* data, std::size_t size, std::size_t swapSize)
+{
+  for (std::size_t ii = 0; ii + swapSize <= size; ii += swapSize)
+  {
+    std::reverse(data + ii, data + ii + swapSize);
+  }
+}
+
+void putLittleEndian(char* destination, std::uint64_t value, std::size_t size)
+{
+  for (std::size_t ii = 0; ii < size; ++ii)
+  {
+    destination[ii] = static_cast<char>((value >> (8 * ii)) & 0xff);
+  }
+}
+
+std::uint64_t getLittleEndian(const char* source, std::size_t size)
+{
+  std::uint64_t value = 0;
+  for (std::size_t ii = 0; ii < size; ++ii)
+  {
+    value |= static_cast<std::uint64_t>(static_cast<unsigned char>(source[ii])) << (8 * ii);
+  }
+  return value;
+}
+
+// Return the size of elements of the named type (or 0 for unknown types).
+std::size_t elementSize(const std::string& type)
+{
+  static const std::map<std::string, std::size_t> sizes = {
+    { ChunkedElement<std::int8_t>::name, sizeof(std::int8_t) },
+    { ChunkedElement<std::uint8_t>::name, sizeof(std::uint8_t) },
+    { ChunkedElement<std::int16_t>::name, sizeof(std::int16_t) },
+    { ChunkedElement<std::uint16_t>::name, sizeof(std::uint16_t) },
+    { ChunkedElement<std::int32_t>::name, sizeof(std::int32_t) },
+    { ChunkedElement<std::uint32_t>::name, sizeof(std::uint32_t) },
+    { ChunkedElement<std::int64_t>::name, sizeof(std::int64_t) },
+    { ChunkedElement<std::uint64_t>::name, sizeof(std::uint64_t) },
+    { ChunkedElement<float>::name, sizeof(float) },
+    { ChunkedElement<double>::name, sizeof(double) },
+    { ChunkedElement<smtk::common::UUID>::name, sizeof(smtk::common::UUID) }
+  };
+  auto it = sizes.find(type);
+  return it == sizes.end() ? 0 : it->second;
+}
+
+bool writePadding(std::ostream& stream, std::size_t from, std::size_t to)
+{
+  static const char zeros[alignment] = {};
+  stream.write(zeros, static_cast<std::streamsize>(to - from));
+  return stream.good();
+}
+} // anonymous namespace
+
+struct ChunkedFileWriter::Chunk
+{
+  std::string name;
+  std::string type;
+  std::size_t elementSize;
+  std::size_t swapSize;
+  const void* data;
+  std::size_t count;
+  std::shared_ptr<void> owned;
+};
+
+ChunkedFileWriter::ChunkedFileWriter()
+  : m_header(json::object())
+{
+}
+
+ChunkedFileWriter::~ChunkedFileWriter() = default;
+
+bool ChunkedFileWriter::addChunk(
+  const std::string& name,
+  const char* type,
+  std::size_t elementSize,
+  std::size_t swapSize,
+  const void* data,
+  std::size_t count,
+  std::shared_ptr<void> owned)
+{
+  if (!m_names.insert(name).second)
+  {
+    return false;
+  }
+  m_chunks.push_back(Chunk{ name, type, elementSize, swapSize, data, count, std::move(owned) });
+  return true;
+}
+
+bool ChunkedFileWriter::write(const std::string& filename) const
+{
+  // Offsets are relative to the start of the first array so that the
+  // header need not know its own length.
+  json arrays = json::object();
+  std::vector<std::size_t> offsets;
+  offsets.reserve(m_chunks.size());
+  std::size_t offset = 0;
+  for (const auto& chunk : m_chunks)
+  {
+    offset = aligned(offset);
+    offsets.push_back(offset);
+    std::size_t size = chunk.elementSize * chunk.count;
+    arrays[chunk.name] = {
+      { "type", chunk.type }, { "count", chunk.count }, { "offset", offset }, { "size", size }
+    };
+    offset += size;
+  }
+  std::string header = json{ { "header", m_header }, { "arrays", arrays } }.dump();
+
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file.good())
+  {
+    smtkErrorMacro(smtk::io::Logger::instance(), "Could not open \"" << filename << "\".");
+    return false;
+  }
+
+  char preamble[preambleSize];
+  std::memcpy(preamble, magic, sizeof(magic));
+  putLittleEndian(preamble + 8, formatVersion, 4);
+  putLittleEndian(preamble + 12, 0, 4);
+  putLittleEndian(preamble + 16, header.size(), 8);
+  file.write(preamble, preambleSize);
+  file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+  const std::size_t dataStart = aligned(preambleSize + header.size());
+  std::size_t position = preambleSize + header.size();
+  const bool swap = !ChunkedFileReader::littleEndian();
+  std::vector<char> buffer;
+  for (std::size_t ii = 0; ii < m_chunks.size() && file.good(); ++ii)
+  {
+    const auto& chunk = m_chunks[ii];
+    writePadding(file, position, dataStart + offsets[ii]);
+    position = dataStart + offsets[ii];
+
+    std::size_t size = chunk.elementSize * chunk.count;
+    const char* bytes = static_cast<const char*>(chunk.data);
+    if (!swap || chunk.swapSize <= 1)
+    {
+      file.write(bytes, static_cast<std::streamsize>(size));
+    }
+    else
+    {
+      // Write whole elements through a buffer in little-endian order.
+      std::size_t block = swapBufferSize / chunk.elementSize * chunk.elementSize;
+      buffer.resize(block);
+      for (std::size_t done = 0; done < size; done += block)
+      {
+        std::size_t length = std::min(block, size - done);
+        std::memcpy(buffer.data(), bytes + done, length);
+        swapBytes(buffer.data(), length, chunk.swapSize);
+        file.write(buffer.data(), static_cast<std::streamsize>(length));
+      }
+    }
+    position += size;
+  }
+
+  file.close();
+  if (file.fail())
+  {
+    smtkErrorMacro(smtk::io::Logger::instance(), "Could not write \"" << filename << "\".");
+    return false;
+  }
+  return true;
+}
+
+struct ChunkedFileReader::Internal
+{
+  boost::interprocess::file_mapping m_file;
+  boost::interprocess::mapped_region m_region;
+  const char* m_data{ nullptr };
+  std::size_t m_size{ 0 };
+  std::size_t m_dataStart{ 0 };
+  std::map<std::string, Entry> m_entries;
+};
+
+ChunkedFileReader::ChunkedFileReader()
+  : m_internal(new Internal)
+{
+}
+
+ChunkedFileReader::~ChunkedFileReader() = default;
+
+bool ChunkedFileReader::littleEndian()
+{
+  const std::uint16_t probe = 1;
+  return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+bool ChunkedFileReader::isChunkedFile(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  char prefix[sizeof(magic)];
+  return file.read(prefix, sizeof(magic)) && std::memcmp(prefix, magic, sizeof(magic)) == 0;
+}
+
+std::shared_ptr<ChunkedFileReader> ChunkedFileReader::open(const std::string& filename)
+{
+  if (!ChunkedFileReader::isChunkedFile(filename))
+  {
+    smtkErrorMacro(
+      smtk::io::Logger::instance(), "\"" << filename << "\" is not a chunked file.");
+    return nullptr;
+  }
+
+  std::shared_ptr<ChunkedFileReader> reader(new ChunkedFileReader);
+  auto& internal = *reader->m_internal;
+  try
+  {
+    internal.m_file =
+      boost::interprocess::file_mapping(filename.c_str(), boost::interprocess::read_only);
+    internal.m_region =
+      boost::interprocess::mapped_region(internal.m_file, boost::interprocess::read_only);
+    internal.m_data = static_cast<const char*>(internal.m_region.get_address());
+    internal.m_size = internal.m_region.get_size();
+
+    if (internal.m_size < preambleSize)
+    {
+      throw std::runtime_error("truncated preamble");
+    }
+    auto version = getLittleEndian(internal.m_data + 8, 4);
+    if (version != formatVersion)
+    {
+      throw std::runtime_error("unsupported version " + std::to_string(version));
+    }
+    auto headerSize = static_cast<std::size_t>(getLittleEndian(internal.m_data + 16, 8));
+    if (headerSize > internal.m_size - preambleSize)
+    {
+      throw std::runtime_error("truncated header");
+    }
+    json document = json::parse(
+      internal.m_data + preambleSize, internal.m_data + preambleSize + headerSize);
+    internal.m_dataStart = aligned(preambleSize + headerSize);
+
+    reader->m_header = document.at("header");
+    for (const auto& entry : document.at("arrays").items())
+    {
+      Entry array{ entry.value().at("type").get<std::string>(),
+                   entry.value().at("count").get<std::size_t>(),
+                   entry.value().at("offset").get<std::size_t>(),
+                   entry.value().at("size").get<std::size_t>() };
+      if (
+        array.offset % alignment != 0 || internal.m_dataStart + array.offset > internal.m_size ||
+        array.size > internal.m_size - internal.m_dataStart - array.offset)
+      {
+        throw std::runtime_error("array \"" + entry.key() + "\" lies outside the file");
+      }
+      std::size_t size = elementSize(array.type);
+      if (size > 0 && array.size / size != array.count)
+      {
+        throw std::runtime_error("array \"" + entry.key() + "\" has an inconsistent size");
+      }
+      internal.m_entries[entry.key()] = array;
+    }
+  }
+  catch (std::exception& e)
+  {
+    smtkErrorMacro(
+      smtk::io::Logger::instance(), "Could not read \"" << filename << "\": " << e.what() << ".");
+    return nullptr;
+  }
+  return reader;
+}
+
+std::set<std::string> ChunkedFileReader::arrays() const
+{
+  std::set<std::string> result;
+  for (const auto& entry : m_internal->m_entries)
+  {
+    result.insert(entry.first);
+  }
+  return result;
+}
+
+std::size_t ChunkedFileReader::size(const std::string& name) const
+{
+  const auto* entry = this->find(name);
+  return entry ? entry->count : 0;
+}
+
+const ChunkedFileReader::Entry* ChunkedFileReader::find(const std::string& name) const
+{
+  auto it = m_internal->m_entries.find(name);
+  return it == m_internal->m_entries.end() ? nullptr : &it->second;
+}
+
+const char* ChunkedFileReader::bytes(const Entry& entry) const
+{
+  return m_internal->m_data + m_internal->m_dataStart + entry.offset;
+}
+
+void ChunkedFileReader::copy(const Entry& entry, void* destination, std::size_t swapSize) const
+{
+  if (entry.size == 0)
+  {
+    return;
+  }
+  std::memcpy(destination, this->bytes(entry), entry.size);
+  if (swapSize > 1 && !littleEndian())
+  {
+    swapBytes(static_cast<char*>(destination), entry.size, swapSize);
+  }
+}
+
+} // namespace common
+} // namespace smtk
@@ -0,0 +1,332 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_common_ChunkedFile_h
+#define smtk_common_ChunkedFile_h
+
+#include "smtk/CoreExports.h"
+
+#include "smtk/common/UUID.h"
+
+#include "nlohmann/json.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace smtk
+{
+namespace common
+{
+
+/**\brief Element types that may be stored in a chunked file.
+  *
+  * Each specialization provides the name recorded in the file's header
+  * and the size of the units whose byte order must be swapped on
+  * big-endian hosts (1 for types with no byte order, such as UUIDs).
+  */
+template<typename T>
+struct ChunkedElement;
+
+#define smtkChunkedElementMacro(Type, Name, Swap)                                                 \
+  template<>                                                                                      \
+  struct ChunkedElement<Type>                                                                     \
+  {                                                                                               \
+    static constexpr const char* name = Name;                                                     \
+    static constexpr std::size_t swapSize = Swap;                                                 \
+  }
+
+smtkChunkedElementMacro(std::int8_t, "int8", 1);
+smtkChunkedElementMacro(std::uint8_t, "uint8", 1);
+smtkChunkedElementMacro(std::int16_t, "int16", 2);
+smtkChunkedElementMacro(std::uint16_t, "uint16", 2);
+smtkChunkedElementMacro(std::int32_t, "int32", 4);
+smtkChunkedElementMacro(std::uint32_t, "uint32", 4);
+smtkChunkedElementMacro(std::int64_t, "int64", 8);
+smtkChunkedElementMacro(std::uint64_t, "uint64", 8);
+smtkChunkedElementMacro(float, "float32", 4);
+smtkChunkedElementMacro(double, "float64", 8);
+smtkChunkedElementMacro(smtk::common::UUID, "uuid", 1);
+
+#undef smtkChunkedElementMacro
+
+/**\brief Write a binary file holding a JSON header and raw numeric arrays.
+  *
+  * A chunked file begins with a short fixed-size preamble and a JSON header.
+  * The header holds arbitrary metadata (see header()) plus an index of the
+  * arrays in the file. Each array follows as raw, little-endian elements
+  * aligned to a 64-byte boundary, so that a ChunkedFileReader may use the
+  * memory-mapped file directly rather than parsing it.
+  *
+  * Arrays added by pointer are not copied; they must remain valid until
+  * write() returns.
+  */
+class SMTKCORE_EXPORT ChunkedFileWriter
+{
+public:
+  using json = nlohmann::json;
+
+  ChunkedFileWriter();
+  ~ChunkedFileWriter();
+
+  /// Metadata stored in the file's header.
+  json& header() { return m_header; }
+  const json& header() const { return m_header; }
+
+  /// Add the \a count elements at \a data as the array \a name.
+  ///
+  /// Returns false if an array named \a name has already been added.
+  template<typename T>
+  bool addArray(const std::string& name, const T* data, std::size_t count)
+  {
+    return this->addChunk(
+      name,
+      ChunkedElement<T>::name,
+      sizeof(T),
+      ChunkedElement<T>::swapSize,
+      data,
+      count,
+      nullptr);
+  }
+
+  template<typename T>
+  bool addArray(const std::string& name, const std::vector<T>& data)
+  {
+    return this->addArray(name, data.data(), data.size());
+  }
+
+  /// Add \a data as the array \a name, taking ownership of it.
+  template<typename T>
+  bool addArray(const std::string& name, std::vector<T>&& data)
+  {
+    auto owned = std::make_shared<std::vector<T>>(std::move(data));
+    return this->addChunk(
+      name,
+      ChunkedElement<T>::name,
+      sizeof(T),
+      ChunkedElement<T>::swapSize,
+      owned->data(),
+      owned->size(),
+      owned);
+  }
+
+  /// Write the header and all arrays to \a filename.
+  ///
+  /// Returns false (after logging an error) if the file could not be written.
+  bool write(const std::string& filename) const;
+
+private:
+  struct Chunk;
+
+  bool addChunk(
+    const std::string& name,
+    const char* type,
+    std::size_t elementSize,
+    std::size_t swapSize,
+    const void* data,
+    std::size_t count,
+    std::shared_ptr<void> owned);
+
+  json m_header;
+  std::vector<Chunk> m_chunks;
+  std::set<std::string> m_names;
+};
+
+/**\brief Read a file written by ChunkedFileWriter.
+  *
+  * The file is memory-mapped when it is opened; only its JSON header is
+  * parsed. Arrays are not read until they are accessed, either in place
+  * (via view()) or as a copy (via materialize() or lazy()). Because pages
+  * of the file are only loaded as they are touched, opening a file takes
+  * time proportional to the size of its header rather than its arrays.
+  *
+  * Readers are always held by shared pointer so that views and lazy arrays
+  * may keep the mapping alive.
+  */
+class SMTKCORE_EXPORT ChunkedFileReader
+  : public std::enable_shared_from_this<ChunkedFileReader>
+{
+public:
+  using json = nlohmann::json;
+
+  /// A read-only range of elements held in the mapped file.
+  template<typename T>
+  class View
+  {
+  public:
+    View() = default;
+    View(std::shared_ptr<const ChunkedFileReader> reader, const T* data, std::size_t size)
+      : m_reader(std::move(reader))
+      , m_data(data)
+      , m_size(size)
+    {
+    }
+
+    const T* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+    const T& operator[](std::size_t ii) const { return m_data[ii]; }
+
+  private:
+    std::shared_ptr<const ChunkedFileReader> m_reader;
+    const T* m_data{ nullptr };
+    std::size_t m_size{ 0 };
+  };
+
+  /// An array that is copied out of the file the first time it is accessed.
+  ///
+  /// Copies of a LazyArray share their storage. Once the array has been
+  /// materialized, it no longer holds a reference to the reader.
+  template<typename T>
+  class LazyArray
+  {
+  public:
+    LazyArray() = default;
+    LazyArray(std::shared_ptr<const ChunkedFileReader> reader, const std::string& name)
+      : m_state(std::make_shared<State>())
+    {
+      m_state->reader = std::move(reader);
+      m_state->name = name;
+    }
+
+    /// Return the array's elements, reading them if they have not been read.
+    const std::vector<T>& get() const
+    {
+      static const std::vector<T> empty;
+      if (!m_state)
+      {
+        return empty;
+      }
+      std::call_once(m_state->once, [this]() {
+        m_state->values = m_state->reader->template materialize<T>(m_state->name);
+        m_state->reader.reset();
+        m_state->materialized = true;
+      });
+      return m_state->values;
+    }
+
+    /// Return true once the array has been read.
+    bool materialized() const { return m_state && m_state->materialized; }
+
+  private:
+    struct State
+    {
+      std::shared_ptr<const ChunkedFileReader> reader;
+      std::string name;
+      std::once_flag once;
+      std::vector<T> values;
+      std::atomic<bool> materialized{ false };
+    };
+    std::shared_ptr<State> m_state;
+  };
+
+  ~ChunkedFileReader();
+
+  /// Map \a filename and parse its header.
+  ///
+  /// Returns null (after logging an error) if the file does not exist or
+  /// is not a valid chunked file.
+  static std::shared_ptr<ChunkedFileReader> open(const std::string& filename);
+
+  /// Return true if \a filename begins with a chunked file's preamble.
+  static bool isChunkedFile(const std::string& filename);
+
+  /// Metadata stored in the file's header.
+  const json& header() const { return m_header; }
+
+  /// Return the names of the file's arrays.
+  std::set<std::string> arrays() const;
+
+  /// Return true if the file holds an array named \a name whose elements are of type \a T.
+  template<typename T>
+  bool contains(const std::string& name) const
+  {
+    const auto* entry = this->find(name);
+    return entry && entry->type == ChunkedElement<T>::name;
+  }
+
+  /// Return the number of elements in the array \a name (or 0 if there is no such array).
+  std::size_t size(const std::string& name) const;
+
+  /// Return the elements of the array \a name in place.
+  ///
+  /// The view is empty if there is no such array of type \a T. Because
+  /// arrays are stored in little-endian byte order, views of multi-byte
+  /// elements are also empty on big-endian hosts; use materialize() there.
+  template<typename T>
+  View<T> view(const std::string& name) const
+  {
+    const auto* entry = this->find(name);
+    if (
+      !entry || entry->type != ChunkedElement<T>::name ||
+      (ChunkedElement<T>::swapSize > 1 && !littleEndian()))
+    {
+      return View<T>();
+    }
+    return View<T>(
+      this->shared_from_this(), reinterpret_cast<const T*>(this->bytes(*entry)), entry->count);
+  }
+
+  /// Return a copy of the elements of the array \a name.
+  ///
+  /// The result is empty if there is no such array of type \a T.
+  template<typename T>
+  std::vector<T> materialize(const std::string& name) const
+  {
+    std::vector<T> result;
+    const auto* entry = this->find(name);
+    if (!entry || entry->type != ChunkedElement<T>::name)
+    {
+      return result;
+    }
+    result.resize(entry->count);
+    this->copy(*entry, result.data(), ChunkedElement<T>::swapSize);
+    return result;
+  }
+
+  /// Return an array that copies the elements of \a name when first accessed.
+  template<typename T>
+  LazyArray<T> lazy(const std::string& name) const
+  {
+    return LazyArray<T>(this->shared_from_this(), name);
+  }
+
+  /// Return true if the host stores multi-byte values in little-endian order.
+  static bool littleEndian();
+
+private:
+  struct Internal;
+  struct Entry
+  {
+    std::string type;
+    std::size_t count;
+    std::size_t offset;
+    std::size_t size;
+  };
+
+  ChunkedFileReader();
+
+  const Entry* find(const std::string& name) const;
+  const char* bytes(const Entry& entry) const;
+  void copy(const Entry& entry, void* destination, std::size_t swapSize) const;
+
+  std::unique_ptr<Internal> m_internal;
+  json m_header;
+};
+
+} // namespace common
+} // namespace smtk
+
+#endif // smtk_common_ChunkedFile_h
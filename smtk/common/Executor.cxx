@@ -0,0 +1,407 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/common/Executor.h"
+
+#include "smtk/common/Environment.h"
+
+#include "smtk/io/Logger.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace smtk
+{
+namespace common
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Task
+{
+  std::function<void()> m_work;
+  Clock::time_point m_submitted;
+};
+
+// A mutex-guarded double-ended queue of tasks.
+struct TaskQueue
+{
+  std::mutex m_mutex;
+  std::deque<Task> m_tasks;
+
+  void push(Task&& task)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_tasks.push_back(std::move(task));
+  }
+
+  bool popBack(Task& task)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_tasks.empty())
+    {
+      return false;
+    }
+    task = std::move(m_tasks.back());
+    m_tasks.pop_back();
+    return true;
+  }
+
+  bool popFront(Task& task)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_tasks.empty())
+    {
+      return false;
+    }
+    task = std::move(m_tasks.front());
+    m_tasks.pop_front();
+    return true;
+  }
+};
+
+using PriorityQueues = std::array<TaskQueue, Executor::NumberOfPriorities>;
+
+// The executor (and worker index) of the current thread, if it is a worker.
+thread_local const void* g_executor = nullptr;
+thread_local std::size_t g_workerIndex = 0;
+} // namespace
+
+class Executor::Internal
+{
+public:
+  Internal(unsigned int maxThreads, std::size_t maxQueuedTasks)
+    : m_numberOfThreads(
+        maxThreads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : maxThreads)
+    , m_maxQueuedTasks(maxQueuedTasks)
+    , m_workerQueues(m_numberOfThreads)
+  {
+  }
+
+  ~Internal() { this->stop(); }
+
+  bool isWorker() const { return g_executor == this; }
+
+  // Start the worker threads. This is done lazily, upon the first submission,
+  // so that executors held in static variables do not spawn threads during
+  // static initialization.
+  void initialize()
+  {
+    std::call_once(m_initialized, [this]() {
+      m_threads.reserve(m_numberOfThreads);
+      for (std::size_t ii = 0; ii < m_numberOfThreads; ++ii)
+      {
+        m_threads.emplace_back(&Internal::exec, this, ii);
+      }
+    });
+  }
+
+  // Count a task about to be pushed, blocking while a bounded queue is full.
+  // Checking for space and claiming it is a single atomic step, so the bound
+  // holds however many threads submit at once. Returns false (without
+  // claiming space) if the queue is full and the caller is a worker, which
+  // must not block.
+  bool reserve(std::size_t& depth)
+  {
+    if (m_maxQueuedTasks == 0)
+    {
+      depth = ++m_pending;
+      return true;
+    }
+    std::size_t pending = m_pending;
+    while (true)
+    {
+      if (pending < m_maxQueuedTasks)
+      {
+        if (m_pending.compare_exchange_weak(pending, pending + 1))
+        {
+          depth = pending + 1;
+          return true;
+        }
+        continue;
+      }
+      if (this->isWorker())
+      {
+        return false;
+      }
+      std::unique_lock<std::mutex> lock(m_spaceMutex);
+      m_spaceCondition.wait(lock, [this]() { return m_pending < m_maxQueuedTasks; });
+      pending = m_pending;
+    }
+  }
+
+  // Publish a task for which reserve() has claimed space. The task is counted
+  // before it is published so that a worker that dequeues it immediately
+  // never observes a negative queue depth.
+  void push(Priority priority, Task&& task, std::size_t depth)
+  {
+    ++m_submitted;
+    auto level = static_cast<std::size_t>(priority);
+    if (this->isWorker())
+    {
+      m_workerQueues[g_workerIndex][level].push(std::move(task));
+    }
+    else
+    {
+      m_sharedQueues[level].push(std::move(task));
+    }
+    std::size_t prior = m_maxQueueDepth;
+    while (depth > prior && !m_maxQueueDepth.compare_exchange_weak(prior, depth))
+    {
+    }
+    {
+      // Acquire the mutex so that a worker cannot miss this notification
+      // between checking for work and waiting.
+      std::lock_guard<std::mutex> guard(m_sleepMutex);
+    }
+    m_sleepCondition.notify_one();
+  }
+
+  // Find the highest-priority task (of at most \a highest priority)
+  // available to the calling thread.
+  bool pop(Task& task, Priority highest = Priority::Interactive)
+  {
+    bool worker = this->isWorker();
+    for (std::size_t level = static_cast<std::size_t>(highest) + 1; level-- > 0;)
+    {
+      // Prefer the calling worker's own (most recently submitted) tasks...
+      if (worker && m_workerQueues[g_workerIndex][level].popBack(task))
+      {
+        return this->popped();
+      }
+      // ...then tasks submitted from outside the executor...
+      if (m_sharedQueues[level].popFront(task))
+      {
+        return this->popped();
+      }
+      // ...then the oldest tasks of other workers.
+      for (std::size_t offset = worker ? 1 : 0; offset < m_numberOfThreads; ++offset)
+      {
+        std::size_t victim = (g_workerIndex + offset) % m_numberOfThreads;
+        if (m_workerQueues[victim][level].popFront(task))
+        {
+          ++m_stolen;
+          return this->popped();
+        }
+      }
+    }
+    return false;
+  }
+
+  bool popped()
+  {
+    --m_pending;
+    if (m_maxQueuedTasks > 0)
+    {
+      {
+        std::lock_guard<std::mutex> guard(m_spaceMutex);
+      }
+      m_spaceCondition.notify_one();
+    }
+    return true;
+  }
+
+  void run(Task& task)
+  {
+    auto latency =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - task.m_submitted)
+        .count();
+    m_totalLatency += static_cast<std::uint64_t>(latency);
+    std::uint64_t prior = m_maxLatency;
+    while (static_cast<std::uint64_t>(latency) > prior &&
+           !m_maxLatency.compare_exchange_weak(prior, static_cast<std::uint64_t>(latency)))
+    {
+    }
+    ++m_executed;
+    try
+    {
+      task.m_work();
+    }
+    catch (...)
+    {
+      // At least let the user know something went wrong.
+      smtkErrorMacro(smtk::io::Logger::instance(), "Uncaught executor task exception.");
+    }
+  }
+
+  // Run by each worker thread.
+  void exec(std::size_t index)
+  {
+    g_executor = this;
+    g_workerIndex = index;
+    while (true)
+    {
+      bool ran;
+      {
+        Task task;
+        ran = this->pop(task);
+        if (ran)
+        {
+          this->run(task);
+        }
+      }
+      // If the task (or the release of its functor) destroyed the executor,
+      // stop() has detached this thread and its members must not be touched.
+      if (g_executor != this)
+      {
+        return;
+      }
+      if (ran)
+      {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(m_sleepMutex);
+      if (m_stopping && m_pending == 0)
+      {
+        break;
+      }
+      m_sleepCondition.wait(lock, [this]() { return m_pending > 0 || m_stopping; });
+    }
+  }
+
+  void stop()
+  {
+    if (m_threads.empty())
+    {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> guard(m_sleepMutex);
+      m_stopping = true;
+    }
+    m_sleepCondition.notify_all();
+    for (auto& thread : m_threads)
+    {
+      // A worker may release the last reference to the executor; it cannot
+      // join itself, so it is detached and exits once its task returns.
+      if (thread.get_id() == std::this_thread::get_id())
+      {
+        g_executor = nullptr;
+        thread.detach();
+      }
+      else
+      {
+        thread.join();
+      }
+    }
+  }
+
+  const std::size_t m_numberOfThreads;
+  const std::size_t m_maxQueuedTasks;
+  std::vector<PriorityQueues> m_workerQueues;
+  PriorityQueues m_sharedQueues;
+  std::vector<std::thread> m_threads;
+  std::once_flag m_initialized;
+
+  std::mutex m_sleepMutex;
+  std::condition_variable m_sleepCondition;
+  bool m_stopping{ false };
+
+  std::mutex m_spaceMutex;
+  std::condition_variable m_spaceCondition;
+
+  std::atomic<std::size_t> m_pending{ 0 };
+  std::atomic<std::size_t> m_maxQueueDepth{ 0 };
+  std::atomic<std::size_t> m_submitted{ 0 };
+  std::atomic<std::size_t> m_executed{ 0 };
+  std::atomic<std::size_t> m_stolen{ 0 };
+  std::atomic<std::size_t> m_executedWhileWaiting{ 0 };
+  std::atomic<std::uint64_t> m_totalLatency{ 0 };
+  std::atomic<std::uint64_t> m_maxLatency{ 0 };
+};
+
+Executor::Executor(unsigned int maxThreads, std::size_t maxQueuedTasks, Priority defaultPriority)
+  : m_internal(std::make_shared<Internal>(maxThreads, maxQueuedTasks))
+  , m_defaultPriority(defaultPriority)
+{
+}
+
+Executor::Executor(const Executor& other, Priority defaultPriority)
+  : m_internal(other.m_internal)
+  , m_defaultPriority(defaultPriority)
+{
+}
+
+Executor::~Executor() = default;
+
+Executor& Executor::instance()
+{
+  // SMTK_EXECUTOR_THREADS may be set to limit the number of workers.
+  static Executor executor(static_cast<unsigned int>(
+    std::strtoul(Environment::getVariable("SMTK_EXECUTOR_THREADS").c_str(), nullptr, 10)));
+  return executor;
+}
+
+void Executor::enqueue(Priority priority, std::function<void()>&& work)
+{
+  m_internal->initialize();
+  Task task{ std::move(work), Clock::now() };
+  std::size_t depth;
+  if (!m_internal->reserve(depth))
+  {
+    // A worker blocking on a full queue could deadlock the executor, so
+    // run the task immediately instead.
+    ++m_internal->m_submitted;
+    m_internal->run(task);
+    return;
+  }
+  m_internal->push(priority, std::move(task), depth);
+}
+
+bool Executor::runPendingTask(Priority highest)
+{
+  Task task;
+  if (!m_internal->pop(task, highest))
+  {
+    return false;
+  }
+  ++m_internal->m_executedWhileWaiting;
+  m_internal->run(task);
+  return true;
+}
+
+unsigned int Executor::numberOfThreads() const
+{
+  return static_cast<unsigned int>(m_internal->m_numberOfThreads);
+}
+
+bool Executor::isWorkerThread() const
+{
+  return m_internal->isWorker();
+}
+
+Executor::Statistics Executor::statistics() const
+{
+  Statistics stats;
+  stats.queueDepth = m_internal->m_pending;
+  stats.maxQueueDepth = m_internal->m_maxQueueDepth;
+  stats.submitted = m_internal->m_submitted;
+  stats.executed = m_internal->m_executed;
+  stats.stolen = m_internal->m_stolen;
+  stats.executedWhileWaiting = m_internal->m_executedWhileWaiting;
+  if (stats.executed > 0)
+  {
+    stats.averageLatency =
+      static_cast<double>(m_internal->m_totalLatency) / static_cast<double>(stats.executed) / 1.e6;
+  }
+  stats.maxLatency = static_cast<double>(m_internal->m_maxLatency) / 1.e6;
+  return stats;
+}
+
+} // namespace common
+} // namespace smtk
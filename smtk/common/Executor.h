@@ -0,0 +1,172 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#ifndef smtk_common_Executor_h
+#define smtk_common_Executor_h
+
+#include "smtk/CoreExports.h"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace smtk
+{
+namespace common
+{
+
+/**\brief A work-stealing, priority-aware task executor.
+  *
+  * Each worker thread owns a double-ended queue of tasks per priority level.
+  * Tasks submitted from outside the executor are placed in shared FIFO queues;
+  * tasks submitted by a running task are pushed onto the submitting worker's
+  * own queue, which it consumes in LIFO order while idle workers steal from
+  * the opposite end. Higher-priority tasks are always dequeued before
+  * lower-priority tasks.
+  *
+  * The call operator has the same signature as ThreadPool's, so users of
+  * ThreadPool<ReturnType> may switch to an Executor without changing call
+  * sites; the return type of the returned future is deduced from the functor.
+  *
+  * A task that must wait on a task it submitted should call wait() rather
+  * than std::future::wait(); wait() executes other pending tasks while the
+  * future is not ready, so nested submission cannot exhaust the workers.
+  *
+  * When constructed with a nonzero \a maxQueuedTasks, submissions from
+  * non-worker threads block while the queue is full. Submissions from worker
+  * threads are executed immediately instead of blocking (to avoid deadlock).
+  *
+  * Priorities only order tasks that share workers, so SMTK submits its own
+  * work to instance() (or to executors constructed from it with a different
+  * default priority) rather than to executors of its own.
+  */
+class SMTKCORE_EXPORT Executor
+{
+public:
+  /// The priority of a task. Interactive tasks run before Normal tasks,
+  /// which run before Background tasks.
+  enum class Priority
+  {
+    Background = 0, //!< Deferrable work such as file I/O.
+    Normal = 1,     //!< The default priority.
+    Interactive = 2 //!< Work a user is actively waiting on.
+  };
+  static constexpr std::size_t NumberOfPriorities = 3;
+
+  /// A snapshot of the executor's activity since construction.
+  struct Statistics
+  {
+    std::size_t queueDepth{ 0 };           //!< Tasks currently waiting to run.
+    std::size_t maxQueueDepth{ 0 };        //!< The largest observed queue depth.
+    std::size_t submitted{ 0 };            //!< Tasks submitted.
+    std::size_t executed{ 0 };             //!< Tasks that have started running.
+    std::size_t stolen{ 0 };               //!< Tasks a worker took from another worker's queue.
+    std::size_t executedWhileWaiting{ 0 }; //!< Tasks run by threads blocked in wait().
+    double averageLatency{ 0. };           //!< Mean time (ms) from submission to start.
+    double maxLatency{ 0. };               //!< Longest time (ms) from submission to start.
+  };
+
+  /// Construct an executor with \a maxThreads workers (or one per hardware
+  /// thread if 0). If \a maxQueuedTasks is nonzero, the queue is bounded.
+  /// Tasks submitted with the call operator are given \a defaultPriority.
+  Executor(
+    unsigned int maxThreads = 0,
+    std::size_t maxQueuedTasks = 0,
+    Priority defaultPriority = Priority::Normal);
+  /// Construct an executor that shares the workers and queues of \a other
+  /// but gives tasks submitted with the call operator \a defaultPriority.
+  Executor(const Executor& other, Priority defaultPriority);
+  /// Once no executor shares its workers, run all queued tasks, then join
+  /// the worker threads. If the last executor is destroyed by one of its own
+  /// tasks, that task's worker is detached rather than joined.
+  virtual ~Executor();
+
+  /// Return the executor shared by SMTK's operation launcher and I/O.
+  ///
+  /// It has one worker per hardware thread unless the SMTK_EXECUTOR_THREADS
+  /// environment variable is set to a positive number of workers.
+  static Executor& instance();
+
+  Executor(const Executor&) = delete;
+  Executor& operator=(const Executor&) = delete;
+
+  /// Submit a task with the executor's default priority. The return value
+  /// can be accessed from the returned future.
+  template<typename Function, typename... Types>
+  auto operator()(Function&& function, Types&&... args)
+    -> std::future<decltype(std::bind(function, std::forward<Types>(args)...)())>
+  {
+    return this->submit(
+      m_defaultPriority, std::forward<Function>(function), std::forward<Types>(args)...);
+  }
+
+  /// Submit a task with the given \a priority.
+  template<typename Function, typename... Types>
+  auto submit(Priority priority, Function&& function, Types&&... args)
+    -> std::future<decltype(std::bind(function, std::forward<Types>(args)...)())>
+  {
+    using ReturnType = decltype(std::bind(function, std::forward<Types>(args)...)());
+    auto task = std::make_shared<std::packaged_task<ReturnType()>>(
+      std::bind(std::forward<Function>(function), std::forward<Types>(args)...));
+    std::future<ReturnType> future = task->get_future();
+    this->enqueue(priority, [task]() { (*task)(); });
+    return future;
+  }
+
+  /// Block until \a future is ready, running pending tasks in the meantime.
+  ///
+  /// Only tasks whose priority does not exceed defaultPriority() are run, so
+  /// that a thread waiting on background work never starts higher-priority
+  /// work (such as an operation) that might block on resources it holds.
+  template<typename ReturnType>
+  void wait(const std::future<ReturnType>& future)
+  {
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+      if (!this->runPendingTask(m_defaultPriority))
+      {
+        future.wait_for(std::chrono::milliseconds(1));
+      }
+    }
+  }
+
+  /// Run one pending task of at most \a highest priority on the calling
+  /// thread, if any is available. Returns true if a task was run.
+  bool runPendingTask(Priority highest = Priority::Interactive);
+
+  /// Return the priority given to tasks submitted with the call operator.
+  Priority defaultPriority() const { return m_defaultPriority; }
+
+  /// Return the number of worker threads.
+  unsigned int numberOfThreads() const;
+
+  /// Return true if the calling thread is one of this executor's workers.
+  bool isWorkerThread() const;
+
+  /// Return statistics describing the executor's activity.
+  Statistics statistics() const;
+
+protected:
+  void enqueue(Priority priority, std::function<void()>&& task);
+
+private:
+  class Internal;
+  std::shared_ptr<Internal> m_internal;
+  Priority m_defaultPriority;
+};
+
+} // namespace common
+} // namespace smtk
+
+#endif // smtk_common_Executor_h
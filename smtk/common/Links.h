@@ -16,19 +16,25 @@
 SMTK_THIRDPARTY_PRE_INCLUDE
 #include <boost/multi_index/composite_key.hpp>
 #include <boost/multi_index/global_fun.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 SMTK_THIRDPARTY_POST_INCLUDE
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
+#include <iterator>
 #include <limits>
+#include <numeric>
 #include <set>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace smtk
 {
@@ -74,7 +80,7 @@ struct Link : base_type
     const left_type& left_,
     const right_type& right_,
     const role_type& role_)
-    : base_type(base_)
+    : base_type(std::move(base_))
     , id(id_)
     , left(left_)
     , right(right_)
@@ -82,7 +88,8 @@ struct Link : base_type
   {
   }
 
-  ~Link() override = default;
+  // No destructor is declared, so a link is only polymorphic if its base_type
+  // is (and is movable whenever its base_type is).
 
   id_type id;
   left_type left;
@@ -116,6 +123,11 @@ using namespace boost::multi_index;
 /// right and role indexing. A link_type is also expected; users are optionally
 /// able to use template classes that inherit from Link and augment its storage
 /// and utility.
+///
+/// The Left and Right indices are hashed on (left, role) and (right, role)
+/// pairs, so queries that provide a role (which are by far the most frequent)
+/// take constant time. Queries by a left (or right) value alone probe these
+/// indices once for each distinct role, which the ordered Role index provides.
 template<
   typename id_type,
   typename left_type,
@@ -137,7 +149,7 @@ using LinkContainer = boost::multi_index_container<
         Link<id_type, left_type, right_type, role_type, base_type>,
         role_type,
         &Link<id_type, left_type, right_type, role_type, base_type>::role>>,
-    ordered_non_unique<
+    hashed_non_unique<
       tag<Left>,
       composite_key<
         Link<id_type, left_type, right_type, role_type, base_type>,
@@ -148,8 +160,10 @@ using LinkContainer = boost::multi_index_container<
         member<
           Link<id_type, left_type, right_type, role_type, base_type>,
           role_type,
-          &Link<id_type, left_type, right_type, role_type, base_type>::role>>>,
-    ordered_non_unique<
+          &Link<id_type, left_type, right_type, role_type, base_type>::role>>,
+      composite_key_hash<std::hash<left_type>, std::hash<role_type>>,
+      composite_key_equal_to<std::equal_to<left_type>, std::equal_to<role_type>>>,
+    hashed_non_unique<
       tag<Right>,
       composite_key<
         Link<id_type, left_type, right_type, role_type, base_type>,
@@ -160,7 +174,9 @@ using LinkContainer = boost::multi_index_container<
         member<
           Link<id_type, left_type, right_type, role_type, base_type>,
           role_type,
-          &Link<id_type, left_type, right_type, role_type, base_type>::role>>>>>;
+          &Link<id_type, left_type, right_type, role_type, base_type>::role>>,
+      composite_key_hash<std::hash<right_type>, std::hash<role_type>>,
+      composite_key_equal_to<std::equal_to<right_type>, std::equal_to<role_type>>>>>;
 
 /// Traits classes for Links. We key off of the tags to return sane responses
 /// in the Links class.
@@ -187,6 +203,16 @@ struct LinkTraits<id_type, left_type, right_type, role_type, base_type, Left>
   typedef right_type other_type;
   static const type& value(const Link_& a) { return a.left; }
   static void setValue(Link_& a, const type& v) { a.left = v; }
+
+  /// Links are indexed by (left, role), so visit the key for each role.
+  template<typename Links, typename Visitor>
+  static void visitKeys(const Links& links, const type& v, Visitor visitor)
+  {
+    for (const auto& role : links.roles())
+    {
+      visitor(std::make_tuple(v, role));
+    }
+  }
 };
 
 template<
@@ -203,6 +229,16 @@ struct LinkTraits<id_type, left_type, right_type, role_type, base_type, Right>
   typedef left_type other_type;
   static const type& value(const Link_& a) { return a.right; }
   static void setValue(Link_& a, const type& v) { a.right = v; }
+
+  /// Links are indexed by (right, role), so visit the key for each role.
+  template<typename Links, typename Visitor>
+  static void visitKeys(const Links& links, const type& v, Visitor visitor)
+  {
+    for (const auto& role : links.roles())
+    {
+      visitor(std::make_tuple(v, role));
+    }
+  }
 };
 
 template<
@@ -217,6 +253,12 @@ struct LinkTraits<id_type, left_type, right_type, role_type, base_type, Role>
   typedef role_type type;
   static const type& value(const Link_& a) { return a.role; }
   static void setValue(Link_& a, const type& v) { a.role = v; }
+
+  template<typename Links, typename Visitor>
+  static void visitKeys(const Links&, const type& v, Visitor visitor)
+  {
+    visitor(v);
+  }
 };
 } // namespace detail
 
@@ -245,8 +287,9 @@ public:
   virtual ~Links() = default;
 
   /// The "Left", "Right" and "Role" tags facilitate access to views into the
-  /// container that are sorted according to the left, right or role values,
-  /// respectively.
+  /// container that are indexed according to the left, right or role values,
+  /// respectively. The Left and Right views are hashed on a value together
+  /// with a role, so they must be searched with a tuple holding both.
   using Left = detail::Left;
   using Right = detail::Right;
   using Role = detail::Role;
@@ -266,6 +309,9 @@ public:
   using RightType = right_type;
   using RoleType = role_type;
 
+  /// The values that describe a link (other than its base_type), for bulk insertion.
+  using LinkValues = std::tuple<id_type, left_type, right_type, role_type>;
+
   /// Insertion into the container is performed by passing values for the
   /// base_type object, link id, left value, right value, and role.
   std::pair<iterator, bool> insert(
@@ -290,6 +336,35 @@ public:
     return insert(std::move(base_type()), id, left, right, role);
   }
 
+  /// Insert many links at once, returning the number inserted. Links whose
+  /// id is already present are not inserted.
+  ///
+  /// This is faster than inserting links one at a time: the hashed indices
+  /// are sized once for the whole batch and links are inserted in id order
+  /// so that, when their ids follow those already present, each is placed
+  /// in the id index in constant time.
+  std::size_t bulk_insert(std::vector<Link>&& links);
+
+  /// If the base_type is default-constructible, this bulk insertion method
+  /// allows you to omit the base_type instances.
+  template<typename return_value = std::size_t>
+  typename std::enable_if<std::is_default_constructible<base_type>::value, return_value>::type
+  bulk_insert(const std::vector<LinkValues>& values)
+  {
+    std::vector<Link> links;
+    links.reserve(values.size());
+    for (const auto& value : values)
+    {
+      links.emplace_back(
+        base_type(),
+        std::get<0>(value),
+        std::get<1>(value),
+        std::get<2>(value),
+        std::get<3>(value));
+    }
+    return this->bulk_insert(std::move(links));
+  }
+
   /// Check if a link with the input id exists.
   bool contains(const id_type& key) const { return this->find(key) != this->end(); }
 
@@ -299,8 +374,11 @@ public:
   bool contains(const typename LinkTraits<tag>::type& value) const
   {
     auto& self = this->Parent::template get<tag>();
-    auto found = self.find(value);
-    return found != self.end();
+    bool found = false;
+    LinkTraits<tag>::visitKeys(*this, value, [&self, &found](const auto& key) {
+      found = found || self.find(key) != self.end();
+    });
+    return found;
   }
 
   /// Return the number of links with the input value matching the tagged search
@@ -309,8 +387,10 @@ public:
   std::size_t size(const typename LinkTraits<tag>::type& value) const
   {
     auto& self = this->Parent::template get<tag>();
-    auto range = self.equal_range(value);
-    return std::distance(range.first, range.second);
+    std::size_t count = 0;
+    LinkTraits<tag>::visitKeys(
+      *this, value, [&self, &count](const auto& key) { count += self.count(key); });
+    return count;
   }
 
   /// Erase all links matching the input value for the tagged search criterion.
@@ -318,16 +398,16 @@ public:
   bool erase_all(const typename LinkTraits<tag>::type& value)
   {
     auto& self = this->Parent::template get<tag>();
-    auto to_erase = self.equal_range(value);
-
-    // No elements match |value|, or |self| is empty.
-    if (to_erase.first == to_erase.second || to_erase.first == self.end())
-    {
-      return false;
-    }
-
-    self.erase(to_erase.first, to_erase.second);
-    return true;
+    bool erased = false;
+    LinkTraits<tag>::visitKeys(*this, value, [&self, &erased](const auto& key) {
+      auto to_erase = self.equal_range(key);
+      if (to_erase.first != to_erase.second)
+      {
+        self.erase(to_erase.first, to_erase.second);
+        erased = true;
+      }
+    });
+    return erased;
   }
 
   /// Erase all links matching the input value and role for the tagged search
@@ -382,21 +462,24 @@ public:
         const typename traits::type& value;
       };
 
-      auto& self = this->Parent::template get<tag>();
-      auto range = self.equal_range(originalValue);
-      for (auto it = range.first; it != range.second; ++it)
-      {
-        if (it->id == id)
-        {
-          modified = self.modify(it, Modify(value), Modify(originalValue));
-          break;
-        }
-      }
+      modified = this->Parent::modify(linkIt, Modify(value), Modify(originalValue));
       assert(modified == true);
     }
     return modified;
   }
 
+  /// Return the distinct roles held by the links in the container, in order.
+  std::vector<role_type> roles() const
+  {
+    std::vector<role_type> roles;
+    const auto& self = this->Parent::template get<Role>();
+    for (auto it = self.begin(); it != self.end(); it = self.upper_bound(it->role))
+    {
+      roles.push_back(it->role);
+    }
+    return roles;
+  }
+
   /// Visit all links by ID
   void visitLinks(std::function<void(const id_type& id)> visitor) const
   {
@@ -416,11 +499,13 @@ public:
     std::set<std::reference_wrapper<const id_type>> ids;
 
     auto& self = this->Parent::template get<tag>();
-    auto range = self.equal_range(value);
-    for (auto it = range.first; it != range.second; ++it)
-    {
-      ids.insert(std::cref(it->id));
-    }
+    LinkTraits<tag>::visitKeys(*this, value, [&self, &ids](const auto& key) {
+      auto range = self.equal_range(key);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        ids.insert(std::cref(it->id));
+      }
+    });
     return ids;
   }
 
@@ -478,11 +563,13 @@ public:
       values;
 
     auto& self = this->Parent::template get<tag>();
-    auto range = self.equal_range(std::make_tuple(value));
-    for (auto it = range.first; it != range.second; ++it)
-    {
-      values.insert(std::cref(LinkTraits<typename traits::OtherTag>::value(*it)));
-    }
+    traits::visitKeys(*this, value, [&self, &values](const auto& key) {
+      auto range = self.equal_range(key);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        values.insert(std::cref(LinkTraits<typename traits::OtherTag>::value(*it)));
+      }
+    });
     return values;
   }
 
@@ -544,6 +631,39 @@ Links<id_type, left_type, right_type, role_type, base_type>::insert(
 {
   return this->insert(Link(std::forward<base_type>(base), id, left, right, role));
 }
+
+template<
+  typename id_type,
+  typename left_type,
+  typename right_type,
+  typename role_type,
+  typename base_type>
+std::size_t Links<id_type, left_type, right_type, role_type, base_type>::bulk_insert(
+  std::vector<Link>&& links)
+{
+  // Sort (indices into) the links by id rather than the links themselves,
+  // which may not be assignable.
+  std::vector<std::size_t> order(links.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&links](std::size_t aa, std::size_t bb) {
+    return links[aa].id < links[bb].id;
+  });
+
+  auto& byLeft = this->Parent::template get<Left>();
+  byLeft.reserve(byLeft.size() + links.size());
+  auto& byRight = this->Parent::template get<Right>();
+  byRight.reserve(byRight.size() + links.size());
+
+  // Each link's successor in id order belongs just after it, so the position
+  // following each inserted link is the hint for the next one.
+  std::size_t before = this->size();
+  auto hint = this->end();
+  for (const auto& index : order)
+  {
+    hint = std::next(this->Parent::insert(hint, std::move(links[index])));
+  }
+  return this->size() - before;
+}
 } // namespace common
 } // namespace smtk
 
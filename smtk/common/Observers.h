@@ -194,6 +194,11 @@ public:
   /// Observers instance.
   typedef std::function<void(Observer&)> Initializer;
 
+  /// A functor that, when set, is called in place of each Observer functor
+  /// with the observer's description and a functor that calls the observer.
+  /// This allows consuming code to instrument (e.g., time) each observer.
+  typedef std::function<void(const std::string&, const std::function<void()>&)> Monitor;
+
   Observers()
     : m_initializer()
   {
@@ -247,7 +252,14 @@ public:
         }
         if (entry.first.assigned())
         {
-          result |= entry.second(args...);
+          if (m_monitor)
+          {
+            m_monitor(this->descriptionOf(entry.first), [&]() { result |= entry.second(args...); });
+          }
+          else
+          {
+            result |= entry.second(args...);
+          }
         }
       }
       else if (DebugObservers)
@@ -299,7 +311,14 @@ public:
         }
         if (entry.first.assigned())
         {
-          entry.second(args...);
+          if (m_monitor)
+          {
+            m_monitor(this->descriptionOf(entry.first), [&]() { entry.second(args...); });
+          }
+          else
+          {
+            entry.second(args...);
+          }
         }
       }
       else if (DebugObservers)
@@ -447,6 +466,10 @@ public:
 
   std::string description(Key handle) const { return m_descriptions[handle]; }
 
+  const Monitor& monitor() const { return m_monitor; }
+
+  void setMonitor(Monitor fn) { m_monitor = fn; }
+
 protected:
   // A map of observers. The observers are held in a map so that they can be
   // referenced (and therefore removed) at a later time using the observer's
@@ -464,7 +487,17 @@ protected:
   // A functor to override the default initialize method.
   Initializer m_initializer;
 
+  // A functor to call each observer through (or null to call them directly).
+  Monitor m_monitor;
+
 private:
+  const std::string& descriptionOf(const InternalKey& key) const
+  {
+    static const std::string none;
+    auto it = m_descriptions.find(key);
+    return it == m_descriptions.end() ? none : it->second;
+  }
+
   std::size_t erase(const InternalKey& key)
   {
     std::unique_lock<std::mutex> lock(m_mutex);
@@ -76,12 +76,17 @@ template<
   typename base_type>
 void from_json(const json& j, Links<id_type, left_type, right_type, role_type, base_type>& links)
 {
+  using Link = typename Links<id_type, left_type, right_type, role_type, base_type>::Link;
+
+  // Links are serialized in id order, so inserting them as one batch is fast.
+  std::vector<Link> batch;
+  batch.reserve(j.size());
   const auto* helper = Helper<left_type, right_type>::instance();
   if (helper)
   {
     for (json::const_iterator it = j.begin(); it != j.end(); ++it)
     {
-      links.insert(
+      batch.emplace_back(
         std::move(it->at("base").get<base_type>()),
         it->at("id").get<id_type>(),
         helper->deserializeLeft(it->at("left")),
@@ -93,7 +98,7 @@ void from_json(const json& j, Links<id_type, left_type, right_type, role_type, b
   {
     for (json::const_iterator it = j.begin(); it != j.end(); ++it)
     {
-      links.insert(
+      batch.emplace_back(
         std::move(it->at("base").get<base_type>()),
         it->at("id").get<id_type>(),
         it->at("left").get<left_type>(),
@@ -101,6 +106,7 @@ void from_json(const json& j, Links<id_type, left_type, right_type, role_type, b
         it->at("role").get<role_type>());
     }
   }
+  links.bulk_insert(std::move(batch));
 }
 
 namespace detail
@@ -0,0 +1,289 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_common_testing_cxx_Benchmark_h
+#define smtk_common_testing_cxx_Benchmark_h
+
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace smtk
+{
+namespace common
+{
+namespace testing
+{
+
+/**\brief A harness for scalability benchmarks.
+  *
+  * A Benchmark parses command-line arguments shared by all benchmarks,
+  * times named cases, and reports the results as a table on standard output
+  * and (optionally) as JSON. When given a baseline (the JSON output of an
+  * earlier run), it reports each case whose cost exceeds the baseline's by
+  * more than a tolerance and finish() returns a nonzero value.
+  *
+  * Absolute timings vary from machine to machine, so each case's cost per
+  * item is also recorded relative to the cost per item of a fixed calibration
+  * workload timed at construction. Baselines are compared using these
+  * relative costs.
+  *
+  * Each case is run several times and the fastest run is reported. A run
+  * that takes less than 25 ms repeats the case until it has, and reports
+  * the mean time per repetition. The random number generator is reseeded
+  * before every repetition so that all runs (and all invocations with the
+  * same seed) see the same sequence. Cases must therefore be idempotent.
+  *
+  * Accepted arguments:
+  * + `-n`, `--scale` \<count\>: the number of items each case processes.
+  * + `-s`, `--seed` \<seed\>: the seed for random()
+  * + `-r`, `--repeat` \<count\>: the number of times each case is run.
+  * + `-o`, `--output` \<file\>: write results to \a file as JSON.
+  * + `-b`, `--baseline` \<file\>: compare results to those in \a file.
+  * + `-t`, `--tolerance` \<fraction\>: the allowed fractional slowdown.
+  */
+class Benchmark
+{
+public:
+  Benchmark(const std::string& name, int argc, char* argv[], std::size_t defaultScale = 1000)
+    : m_name(name)
+    , m_scale(defaultScale)
+  {
+    for (int ii = 1; ii < argc; ++ii)
+    {
+      bool hasValue = ii + 1 < argc;
+      if ((!strcmp(argv[ii], "-n") || !strcmp(argv[ii], "--scale")) && hasValue)
+      {
+        m_scale = std::stoul(argv[++ii]);
+      }
+      else if ((!strcmp(argv[ii], "-s") || !strcmp(argv[ii], "--seed")) && hasValue)
+      {
+        m_seed = static_cast<std::uint32_t>(std::stoul(argv[++ii]));
+      }
+      else if ((!strcmp(argv[ii], "-r") || !strcmp(argv[ii], "--repeat")) && hasValue)
+      {
+        m_repeat = std::max(1, std::stoi(argv[++ii]));
+      }
+      else if ((!strcmp(argv[ii], "-o") || !strcmp(argv[ii], "--output")) && hasValue)
+      {
+        m_output = argv[++ii];
+      }
+      else if ((!strcmp(argv[ii], "-b") || !strcmp(argv[ii], "--baseline")) && hasValue)
+      {
+        m_baseline = argv[++ii];
+      }
+      else if ((!strcmp(argv[ii], "-t") || !strcmp(argv[ii], "--tolerance")) && hasValue)
+      {
+        m_tolerance = std::stod(argv[++ii]);
+      }
+    }
+    m_results["benchmark"] = m_name;
+    m_results["scale"] = m_scale;
+    m_results["seed"] = m_seed;
+    m_results["cases"] = nlohmann::json::object();
+    this->calibrate();
+  }
+
+  /// The number of items each case should process.
+  std::size_t scale() const { return m_scale; }
+
+  /// A random number generator, reseeded before each run of a case.
+  std::mt19937& random() { return m_random; }
+
+  /// Return a random integer in [0, \a bound[.
+  std::size_t random(std::size_t bound)
+  {
+    return std::uniform_int_distribution<std::size_t>(0, bound - 1)(m_random);
+  }
+
+  /**\brief Time \a body, which processes \a count items, and record it as \a caseName.
+    *
+    * Returns the fastest time (in milliseconds) of all runs.
+    */
+  template<typename Body>
+  double measure(const std::string& caseName, std::size_t count, Body body)
+  {
+    double fastest = std::numeric_limits<double>::max();
+    for (int run = 0; run < m_repeat; ++run)
+    {
+      // Cases too short to time reliably are repeated within a run.
+      int iterations = 0;
+      double elapsed = 0.;
+      auto start = std::chrono::steady_clock::now();
+      do
+      {
+        m_random.seed(m_seed);
+        body();
+        ++iterations;
+        elapsed =
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+      } while (elapsed < m_minimumMilliseconds);
+      fastest = std::min(fastest, elapsed / iterations);
+    }
+    double perItem = count > 0 ? fastest * 1.e6 / static_cast<double>(count) : 0.;
+    auto& entry = m_results["cases"][caseName];
+    entry["count"] = count;
+    entry["milliseconds"] = fastest;
+    entry["nanosecondsPerItem"] = perItem;
+    entry["relative"] = perItem / m_calibration;
+    std::cout << "  " << std::left << std::setw(36) << caseName << std::right << std::setw(10)
+              << count << " items " << std::setw(12) << std::fixed << std::setprecision(3)
+              << fastest << " ms " << std::setw(12) << perItem << " ns/item\n";
+    return fastest;
+  }
+
+  /**\brief Write results and compare them against the baseline (if any).
+    *
+    * Returns 0 unless a case is slower than its baseline by more than the
+    * tolerance, the baseline has no cases (or was recorded at another scale),
+    * a baseline case was not run, or an output file could not be written.
+    * Cases absent from the baseline are reported but not compared.
+    */
+  int finish()
+  {
+    int status = 0;
+    if (!m_output.empty())
+    {
+      std::ofstream output(m_output);
+      if (!output.good())
+      {
+        std::cerr << "Could not write benchmark results to \"" << m_output << "\".\n";
+        status = 1;
+      }
+      else
+      {
+        output << m_results.dump(2) << "\n";
+      }
+    }
+    if (!m_baseline.empty())
+    {
+      status |= this->compare();
+    }
+    return status;
+  }
+
+protected:
+  // Time a workload (sorting random integers) whose cost depends only on
+  // the machine, so that case costs may be compared across machines.
+  void calibrate()
+  {
+    const std::size_t count = 1 << 16;
+    std::vector<std::uint32_t> values(count);
+    double fastest = std::numeric_limits<double>::max();
+    for (int run = 0; run < 5; ++run)
+    {
+      std::mt19937 generator(m_seed);
+      std::generate(values.begin(), values.end(), generator);
+      auto start = std::chrono::steady_clock::now();
+      std::sort(values.begin(), values.end());
+      fastest = std::min(
+        fastest,
+        std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+          .count());
+    }
+    m_calibration = std::max(fastest / static_cast<double>(count), 1.e-3);
+    m_results["calibration"] = m_calibration;
+    std::cout << m_name << " (scale " << m_scale << ", seed " << m_seed << ", calibration "
+              << m_calibration << " ns/item)\n";
+  }
+
+  int compare() const
+  {
+    std::ifstream input(m_baseline);
+    nlohmann::json baseline;
+    if (input.good())
+    {
+      baseline = nlohmann::json::parse(input, nullptr, false);
+    }
+    if (!baseline.is_object())
+    {
+      std::cerr << "Could not read benchmark baseline \"" << m_baseline << "\".\n";
+      return 1;
+    }
+    // Costs per item are not comparable across scales (most cases are
+    // superlinear), and a baseline without cases would let every run pass.
+    auto scale = baseline.find("scale");
+    if (scale == baseline.end() || scale->get<std::size_t>() != m_scale)
+    {
+      std::cerr << "Baseline \"" << m_baseline << "\" was not recorded at scale " << m_scale
+                << ".\n";
+      return 1;
+    }
+    auto cases = baseline.find("cases");
+    if (cases == baseline.end() || !cases->is_object() || cases->empty())
+    {
+      std::cerr << "Baseline \"" << m_baseline << "\" has no cases to compare.\n";
+      return 1;
+    }
+    int status = 0;
+    std::size_t compared = 0;
+    std::cout << "Comparison to baseline (tolerance " << m_tolerance << "):\n";
+    for (const auto& entry : m_results.at("cases").items())
+    {
+      auto expected = cases->find(entry.key());
+      if (expected == cases->end())
+      {
+        std::cout << "  " << std::left << std::setw(36) << entry.key() << std::right
+                  << "not in baseline\n";
+        continue;
+      }
+      ++compared;
+      double was = (*expected)["relative"].get<double>();
+      double now = entry.value()["relative"].get<double>();
+      double ratio = was > 0. ? now / was : 1.;
+      bool regressed = ratio > 1. + m_tolerance;
+      std::cout << "  " << std::left << std::setw(36) << entry.key() << std::right
+                << std::setprecision(2) << ratio << "x baseline" << (regressed ? " REGRESSED" : "")
+                << "\n";
+      if (regressed)
+      {
+        status = 1;
+      }
+    }
+    for (const auto& entry : cases->items())
+    {
+      if (m_results.at("cases").find(entry.key()) == m_results.at("cases").end())
+      {
+        std::cerr << "  " << entry.key() << ": in baseline but not run\n";
+        status = 1;
+      }
+    }
+    std::cout << "Compared " << compared << " of " << m_results.at("cases").size() << " cases.\n";
+    return status;
+  }
+
+  std::string m_name;
+  std::size_t m_scale;
+  std::uint32_t m_seed{ 1729 };
+  int m_repeat{ 3 };
+  std::string m_output;
+  std::string m_baseline;
+  double m_tolerance{ 0.5 };
+  double m_minimumMilliseconds{ 25. };
+  double m_calibration{ 1. };
+  std::mt19937 m_random;
+  nlohmann::json m_results;
+};
+
+} // namespace testing
+} // namespace common
+} // namespace smtk
+
+#endif
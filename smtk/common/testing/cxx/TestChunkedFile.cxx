@@ -0,0 +1,116 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/common/ChunkedFile.h"
+
+#include "smtk/common/UUIDGenerator.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using smtk::common::ChunkedFileReader;
+using smtk::common::ChunkedFileWriter;
+
+namespace
+{
+std::string write_root = SMTK_SCRATCH_DIR;
+} // namespace
+
+int TestChunkedFile(int /*unused*/, char** const /*unused*/)
+{
+  const std::string filename = write_root + "/TestChunkedFile.smtkc";
+
+  std::vector<double> coords(3000);
+  std::iota(coords.begin(), coords.end(), 0.5);
+  std::vector<int> conn(1001);
+  std::iota(conn.begin(), conn.end(), -7);
+  std::vector<smtk::common::UUID> ids;
+  for (int ii = 0; ii < 5; ++ii)
+  {
+    ids.push_back(smtk::common::UUIDGenerator::instance().random());
+  }
+
+  // Write a header and several arrays, including one the writer owns and an empty one.
+  {
+    ChunkedFileWriter writer;
+    writer.header()["name"] = "tessellation";
+    writer.header()["version"] = 2;
+    smtkTest(writer.addArray("coords", coords), "Could not add coordinates.");
+    smtkTest(writer.addArray("conn", conn.data(), conn.size()), "Could not add connectivity.");
+    smtkTest(!writer.addArray("conn", conn), "Array names must be unique.");
+    smtkTest(writer.addArray("ids", ids), "Could not add UUIDs.");
+    smtkTest(
+      writer.addArray("bytes", std::vector<std::uint8_t>{ 1, 2, 3 }), "Could not add bytes.");
+    smtkTest(writer.addArray("empty", std::vector<float>()), "Could not add an empty array.");
+    smtkTest(writer.write(filename), "Could not write \"" << filename << "\".");
+  }
+
+  // Opening the file parses only the header.
+  smtkTest(ChunkedFileReader::isChunkedFile(filename), "File is not recognized.");
+  auto reader = ChunkedFileReader::open(filename);
+  smtkTest(!!reader, "Could not open \"" << filename << "\".");
+  smtkTest(reader->header().at("name") == "tessellation", "Header was not preserved.");
+  smtkTest(reader->arrays().size() == 5, "Expected 5 arrays.");
+  smtkTest(reader->size("coords") == coords.size(), "Wrong number of coordinates.");
+  smtkTest(reader->contains<double>("coords"), "Coordinates should be doubles.");
+  smtkTest(!reader->contains<float>("coords"), "Coordinates are not floats.");
+  smtkTest(!reader->contains<int>("missing"), "No array is named \"missing\".");
+
+  // Views refer directly to the mapped file.
+  if (ChunkedFileReader::littleEndian())
+  {
+    auto view = reader->view<double>("coords");
+    smtkTest(view.size() == coords.size(), "Wrong view size.");
+    smtkTest(
+      reinterpret_cast<std::uintptr_t>(view.data()) % alignof(double) == 0,
+      "Arrays should be aligned.");
+    smtkTest(std::equal(view.begin(), view.end(), coords.begin()), "Wrong coordinates.");
+  }
+  smtkTest(reader->view<float>("coords").empty(), "Views must match the array's type.");
+  smtkTest(reader->view<float>("empty").empty(), "Expected an empty view.");
+
+  smtkTest(reader->materialize<int>("conn") == conn, "Wrong connectivity.");
+  smtkTest(reader->materialize<smtk::common::UUID>("ids") == ids, "Wrong UUIDs.");
+  smtkTest(
+    (reader->materialize<std::uint8_t>("bytes") == std::vector<std::uint8_t>{ 1, 2, 3 }),
+    "Wrong bytes.");
+  smtkTest(reader->materialize<float>("empty").empty(), "Expected an empty array.");
+
+  // Lazy arrays are read on first access and outlive the reader.
+  auto lazy = reader->lazy<int>("conn");
+  auto copy = lazy;
+  smtkTest(!lazy.materialized(), "Lazy arrays should not be read until accessed.");
+  reader.reset();
+  smtkTest(copy.get() == conn, "Wrong lazily-read connectivity.");
+  smtkTest(lazy.materialized(), "Copies of a lazy array should share their storage.");
+
+  // Files that are not chunked files (or are truncated) are rejected.
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file << "SMTKCHNK truncated";
+  }
+  smtkTest(!ChunkedFileReader::open(filename), "Truncated files should be rejected.");
+  {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file << "{ \"not\": \"chunked\" }";
+  }
+  smtkTest(!ChunkedFileReader::isChunkedFile(filename), "JSON is not a chunked file.");
+  smtkTest(!ChunkedFileReader::open(filename), "JSON files should be rejected.");
+
+  std::remove(filename.c_str());
+  return 0;
+}
@@ -0,0 +1,215 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/common/Executor.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace
+{
+int square(int i)
+{
+  return i * i;
+}
+
+// Sum the integers in [begin, end) by recursively splitting the range into
+// nested tasks that wait on one another.
+long sum(smtk::common::Executor& executor, int begin, int end)
+{
+  if (end - begin <= 16)
+  {
+    long result = 0;
+    for (int ii = begin; ii < end; ++ii)
+    {
+      result += ii;
+    }
+    return result;
+  }
+  int middle = begin + (end - begin) / 2;
+  auto left = executor([&executor, begin, middle]() { return sum(executor, begin, middle); });
+  long right = sum(executor, middle, end);
+  executor.wait(left);
+  return left.get() + right;
+}
+} // namespace
+
+int UnitTestExecutor(int /*unused*/, char** const /*unused*/)
+{
+  using smtk::common::Executor;
+
+  // The call operator should be a drop-in replacement for ThreadPool's.
+  {
+    Executor executor;
+    std::future<int> result = executor([] { return 1; });
+    smtkTest(result.get() == 1, "Returned result doesn't match input");
+    smtkTest(executor(square, 3).get() == 9, "Bound arguments were not passed.");
+    std::future<void> done = executor([]() { std::cout << "Hello from a worker thread\n"; });
+    done.wait();
+  }
+
+  // Higher-priority tasks should run before lower-priority tasks.
+  {
+    Executor executor(1);
+    std::promise<void> gate;
+    std::shared_future<void> opened(gate.get_future());
+    std::vector<int> order;
+    std::mutex orderMutex;
+    auto record = [&order, &orderMutex](int value) {
+      std::lock_guard<std::mutex> guard(orderMutex);
+      order.push_back(value);
+    };
+
+    // Occupy the only worker until all of the tasks below are queued.
+    auto blocker = executor([opened]() { opened.wait(); });
+    std::vector<std::future<void>> futures;
+    futures.push_back(executor.submit(Executor::Priority::Background, record, 0));
+    futures.push_back(executor.submit(Executor::Priority::Normal, record, 1));
+    futures.push_back(executor.submit(Executor::Priority::Interactive, record, 2));
+    gate.set_value();
+    for (auto& future : futures)
+    {
+      future.wait();
+    }
+    smtkTest(order.size() == 3, "Expected 3 tasks to run.");
+    smtkTest(
+      order[0] == 2 && order[1] == 1 && order[2] == 0,
+      "Tasks ran out of priority order (" << order[0] << order[1] << order[2] << ").");
+  }
+
+  // Nested tasks that wait on one another should not deadlock, even with a
+  // single worker.
+  {
+    Executor executor(1);
+    auto total = executor([&executor]() { return sum(executor, 0, 4096); });
+    smtkTest(total.get() == 4096L * 4095L / 2, "Nested summation produced the wrong value.");
+    auto stats = executor.statistics();
+    smtkTest(
+      stats.executedWhileWaiting > 0, "Waiting tasks should have run other pending tasks.");
+  }
+
+  // Executors that share workers should order each other's tasks by priority.
+  {
+    Executor executor(1);
+    Executor background(executor, Executor::Priority::Background);
+    std::promise<void> gate;
+    std::shared_future<void> opened(gate.get_future());
+    std::vector<int> order;
+    std::mutex orderMutex;
+    auto record = [&order, &orderMutex](int value) {
+      std::lock_guard<std::mutex> guard(orderMutex);
+      order.push_back(value);
+    };
+
+    auto blocker = executor([opened]() { opened.wait(); });
+    auto io = background(record, 0);
+    auto operation = executor(record, 1);
+    gate.set_value();
+    io.wait();
+    operation.wait();
+    smtkTest(order.size() == 2 && order[0] == 1, "Background work should yield to normal work.");
+
+    // Waiting on background work may run other background tasks, but never
+    // higher-priority ones.
+    std::promise<void> gate2;
+    std::shared_future<void> opened2(gate2.get_future());
+    order.clear();
+    blocker = executor([opened2]() { opened2.wait(); });
+    operation = executor(record, 1);
+    io = background(record, 0);
+    background.wait(io);
+    smtkTest(
+      order.size() == 1 && order[0] == 0, "Waiting on background work ran a normal task.");
+    gate2.set_value();
+    operation.wait();
+  }
+
+  // A bounded executor should never queue more than its bound, even when many
+  // threads submit at once.
+  {
+    Executor executor(2, 4);
+    std::atomic<int> count{ 0 };
+    std::vector<std::future<void>> futures;
+    std::mutex futuresMutex;
+    std::vector<std::thread> submitters;
+    for (int tt = 0; tt < 4; ++tt)
+    {
+      submitters.emplace_back([&]() {
+        for (int ii = 0; ii < 25; ++ii)
+        {
+          auto future = executor([&count]() {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            ++count;
+          });
+          std::lock_guard<std::mutex> guard(futuresMutex);
+          futures.push_back(std::move(future));
+        }
+      });
+    }
+    for (auto& submitter : submitters)
+    {
+      submitter.join();
+    }
+    for (auto& future : futures)
+    {
+      future.wait();
+    }
+    auto stats = executor.statistics();
+    smtkTest(count == 100, "Not all tasks ran.");
+    smtkTest(
+      stats.maxQueueDepth <= 4, "Queue depth " << stats.maxQueueDepth << " exceeded the bound.");
+    smtkTest(stats.submitted == 100, "Expected 100 submissions, got " << stats.submitted << ".");
+    smtkTest(stats.executed == 100, "Expected 100 executions, got " << stats.executed << ".");
+    smtkTest(stats.queueDepth == 0, "Queue should be empty.");
+    std::cout << "Average latency " << stats.averageLatency << " ms, max latency "
+              << stats.maxLatency << " ms, " << stats.stolen << " tasks stolen\n";
+  }
+
+  // Tasks submitted to an executor should all run before it is destroyed.
+  {
+    std::atomic<int> count{ 0 };
+    {
+      Executor executor;
+      for (int ii = 0; ii < 50; ++ii)
+      {
+        executor([&count]() { ++count; });
+      }
+    }
+    smtkTest(count == 50, "Executor destroyed before running all tasks.");
+  }
+
+  // An executor may be destroyed by one of its own tasks.
+  {
+    auto executor = std::make_shared<Executor>(2);
+    std::promise<void> start;
+    std::promise<void> released;
+    std::shared_future<void> started = start.get_future().share();
+    (*executor)([executor, started, &released]() mutable {
+      started.wait();
+      executor.reset();
+      released.set_value();
+    });
+    executor.reset();
+    start.set_value();
+    smtkTest(
+      released.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready,
+      "Executor was not destroyed by its own task.");
+  }
+
+  return 0;
+}
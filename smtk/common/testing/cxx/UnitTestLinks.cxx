@@ -65,7 +65,7 @@ void UnitTest()
   smtkTest(inserted.second == true, "Should be able to insert a link.");
   smtkTest(links.size() == 2, "Should have 2 links.");
   smtkTest(
-    links.get<MyLinks::Right>().find(5)->left == 3,
+    links.get<MyLinks::Right>().find(std::make_tuple(5, 101))->left == 3,
     "Should be able to access the left value via the right value.");
   smtkTest(
     links.get<MyLinks::Role>().find(101)->left == 3,
@@ -241,7 +241,7 @@ void MoveOnlyTest()
   smtkTest(inserted.second == true, "Should be able to insert a link.");
   smtkTest(links.size() == 2, "Should have 2 links.");
   smtkTest(
-    links.get<MyLinks::Right>().find(5)->left == 3,
+    links.get<MyLinks::Right>().find(std::make_tuple(5, 101))->left == 3,
     "Should be able to access the left value via the right value.");
   smtkTest(
     links.get<MyLinks::Role>().find(101)->left == 3,
@@ -472,6 +472,52 @@ void MoveOnlyRecursionTest()
   smtkTest(metaLinks.at(0).size() == 2, "first set of links should have 2 links.");
   smtkTest(metaLinks.at(1).size() == 3, "second set of links should have 3 links.");
 }
+void BulkInsertTest()
+{
+  // Links without base data should not carry a vtable pointer.
+  typedef smtk::common::Links<int, std::size_t, short> MyLinks;
+  static_assert(
+    !std::is_polymorphic<MyLinks::Link>::value,
+    "Links with a plain base should not be polymorphic.");
+
+  MyLinks links;
+  links.insert(5, 1, 2, 100);
+
+  // Ids are deliberately out of order; id 5 is already present.
+  std::vector<MyLinks::LinkValues> values{
+    { 9, 1, 3, 100 }, { 7, 1, 4, 101 }, { 5, 8, 8, 100 }, { 6, 2, 3, 100 }, { 8, 1, 2, 100 }
+  };
+  std::size_t inserted = links.bulk_insert(values);
+  smtkTest(inserted == 4, "Expected 4 links to be inserted, not " << inserted << ".");
+  smtkTest(links.size() == 5, "Expected 5 links.");
+  smtkTest(links.at<MyLinks::Left>(5) == 1, "An existing link should not be replaced.");
+
+  // Queries by value and role use the hashed indices.
+  auto linkedTo = links.linked_to<MyLinks::Left>(1, 100);
+  smtkTest(linkedTo.size() == 2, "Left 1 should link to 2 values with role 100.");
+  const short three = 3;
+  smtkTest(linkedTo.find(three) != linkedTo.end(), "Left 1 should link to 3 with role 100.");
+  auto linkedFrom = links.linked_to<MyLinks::Right>(3, 100);
+  smtkTest(linkedFrom.size() == 2, "Right 3 should be linked from 2 values with role 100.");
+  smtkTest(
+    links.get<MyLinks::Left>().count(std::make_tuple(std::size_t(1), 100)) == 3,
+    "Left 1 should have 3 links with role 100.");
+
+  // Queries by value alone probe the hashed indices for each role.
+  smtkTest(links.linked_to<MyLinks::Left>(1).size() == 3, "Left 1 should link to 3 values.");
+
+  // Modifying a link updates the hashed indices.
+  links.set<MyLinks::Role>(7, 100);
+  smtkTest(
+    links.linked_to<MyLinks::Left>(1, 100).size() == 3, "Left 1 should now link to 3 values.");
+  smtkTest(links.linked_to<MyLinks::Left>(1, 101).empty(), "No links should have role 101.");
+
+  bool erased = links.erase_all<MyLinks::Right>(std::make_tuple(short(3), 100));
+  smtkTest(erased && links.size() == 3, "Expected 3 links after erasure.");
+  smtkTest(
+    links.get<MyLinks::Right>().count(std::make_tuple(short(3), 100)) == 0,
+    "Erased links should be removed from the hashed indices.");
+}
 } // namespace
 
 int UnitTestLinks(int /*unused*/, char** const /*unused*/)
@@ -484,6 +530,7 @@ int UnitTestLinks(int /*unused*/, char** const /*unused*/)
   SubsetJsonTest();
   RecursionTest();
   MoveOnlyRecursionTest();
+  BulkInsertTest();
 
   return 0;
 }
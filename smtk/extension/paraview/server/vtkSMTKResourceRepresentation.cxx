@@ -69,6 +69,7 @@
 #include "smtk/view/Selection.h"
 
 #include <type_traits>
+#include <unordered_set>
 
 namespace
 {
@@ -204,6 +205,50 @@ void AddRenderables(
   mbit->Delete();
 }
 
+// Add renderables for the blocks of \a data that are not yet \a known.
+// New entries are also recorded in \a changed and any blocks they replace
+// are appended to \a stale.
+void PatchRenderables(
+  vtkMultiBlockDataSet* data,
+  vtkSMTKResourceRepresentation::RenderableDataMap& renderables,
+  std::unordered_set<vtkDataObject*>& known,
+  vtkSMTKResourceRepresentation::RenderableDataMap& changed,
+  std::vector<vtkDataObject*>& stale)
+{
+  if (!data)
+  {
+    return;
+  }
+  auto* mbit = data->NewTreeIterator();
+  mbit->VisitOnlyLeavesOff();
+  for (mbit->GoToFirstItem(); !mbit->IsDoneWithTraversal(); mbit->GoToNextItem())
+  {
+    auto* obj = mbit->GetCurrentDataObject();
+    if (!obj || known.find(obj) != known.end())
+    {
+      continue;
+    }
+    auto uid = vtkResourceMultiBlockSource::GetDataObjectUUID(mbit->GetCurrentMetaData());
+    if (!uid)
+    {
+      continue;
+    }
+    auto it = renderables.find(uid);
+    if (it != renderables.end())
+    {
+      stale.push_back(it->second);
+      it->second = obj;
+    }
+    else
+    {
+      renderables[uid] = obj;
+    }
+    changed[uid] = obj;
+    known.insert(obj);
+  }
+  mbit->Delete();
+}
+
 // The API of vtkPVRenderView has changed. Report whether the API is
 // new (value == true) or old (value == false) in a struct:
 template<typename RenderView>
@@ -371,6 +416,22 @@ int vtkSMTKResourceRepresentation::RequestData(
     auto* port = this->GetInternalOutputPort();
     auto* untransformed =
       vtkMultiBlockDataSet::SafeDownCast(port->GetProducer()->GetOutputDataObject(0));
+    // Accumulate the components changed by incremental updates of our
+    // input so that only their blocks need to be restyled.
+    int updateNumber = vtkResourceMultiBlockSource::GetUpdateNumber(untransformed);
+    if (updateNumber < 0)
+    {
+      this->RenderableDataInvalid = true;
+    }
+    else if (updateNumber != this->LastUpdateNumber)
+    {
+      if (!vtkResourceMultiBlockSource::GetChangedComponents(
+            untransformed, this->LastUpdateNumber, this->PendingChanges))
+      {
+        this->RenderableDataInvalid = true;
+      }
+    }
+    this->LastUpdateNumber = updateNumber;
     this->ApplyTransforms->SetInputDataObject(untransformed);
     this->ApplyTransforms->Update();
     auto* mbds = vtkMultiBlockDataSet::SafeDownCast(this->ApplyTransforms->GetOutputDataObject(0));
@@ -836,9 +897,42 @@ void vtkSMTKResourceRepresentation::UpdateRenderableData(
     (instanceData && instanceData->GetMTime() > this->RenderableTime) ||
     (this->SelectionTime > this->RenderableTime))
   {
-    this->RenderableData.clear();
-    AddRenderables(instanceData, this->RenderableData);
-    AddRenderables(resourceData, this->RenderableData);
+    if (this->RenderableDataInvalid || this->SelectionTime > this->RenderableTime)
+    {
+      this->RenderableData.clear();
+      AddRenderables(instanceData, this->RenderableData);
+      AddRenderables(resourceData, this->RenderableData);
+      this->RenderableDataPatched = false;
+      this->ChangedRenderables.clear();
+      this->StaleBlocks.clear();
+    }
+    else
+    {
+      // Only blocks of changed components (and blocks not seen before)
+      // need to be examined; all others keep their entries.
+      for (const auto& uid : this->PendingChanges)
+      {
+        auto it = this->RenderableData.find(uid);
+        if (it != this->RenderableData.end())
+        {
+          this->StaleBlocks.push_back(it->second);
+          this->RenderableData.erase(it);
+        }
+      }
+      std::unordered_set<vtkDataObject*> known;
+      known.reserve(this->RenderableData.size());
+      for (const auto& entry : this->RenderableData)
+      {
+        known.insert(entry.second);
+      }
+      PatchRenderables(
+        instanceData, this->RenderableData, known, this->ChangedRenderables, this->StaleBlocks);
+      PatchRenderables(
+        resourceData, this->RenderableData, known, this->ChangedRenderables, this->StaleBlocks);
+      this->RenderableDataPatched = true;
+    }
+    this->RenderableDataInvalid = false;
+    this->PendingChanges.clear();
     this->RenderableTime.Modified();
   }
 }
@@ -876,18 +970,69 @@ void vtkSMTKResourceRepresentation::UpdateDisplayAttributesFromSelection(
     return;
   }
 
+  auto* nrme = this->EntityMapper->GetCompositeDataDisplayAttributes();
+  auto* nrmg = this->GlyphMapper->GetBlockAttributes();
+  auto* seda = this->SelectedEntityMapper->GetCompositeDataDisplayAttributes();
+  auto* sgda = this->SelectedGlyphMapper->GetBlockAttributes();
+  if (this->RenderableDataPatched && this->SelectionTime < this->ApplyStyleTime)
+  {
+    // Only some blocks changed since styles were applied; discard attributes
+    // of blocks that are gone and style new blocks as a full update would.
+    for (auto* block : this->StaleBlocks)
+    {
+      for (auto* attributes : { nrme, nrmg, seda, sgda })
+      {
+        attributes->RemoveBlockVisibility(block);
+        attributes->RemoveBlockColor(block);
+      }
+    }
+    for (const auto& entry : this->ChangedRenderables)
+    {
+      nrme->RemoveBlockVisibility(entry.second);
+      nrmg->RemoveBlockVisibility(entry.second);
+      seda->SetBlockVisibility(entry.second, false);
+      sgda->SetBlockVisibility(entry.second, false);
+      auto sit = this->ComponentState.find(entry.first);
+      if (sit != this->ComponentState.end())
+      {
+        nrme->SetBlockVisibility(entry.second, !!sit->second.m_visibility);
+        nrmg->SetBlockVisibility(entry.second, !!sit->second.m_visibility);
+      }
+    }
+    this->ApplyStyle(sm, this->ChangedRenderables, this);
+  }
+  else
+  {
+    this->ApplyStyleToAllRenderables(sm, nrme, nrmg, seda, sgda);
+  }
+  this->RenderableDataPatched = false;
+  this->ChangedRenderables.clear();
+  this->StaleBlocks.clear();
+
+  // This is necessary to force an update in the mapper
+  this->Entities->GetMapper()->Modified();
+  this->GlyphEntities->GetMapper()->Modified();
+  this->SelectedEntities->GetMapper()->Modified();
+  this->SelectedGlyphEntities->GetMapper()->Modified();
+
+  this->ApplyStyleTime.Modified();
+}
+
+void vtkSMTKResourceRepresentation::ApplyStyleToAllRenderables(
+  smtk::view::SelectionPtr sm,
+  vtkCompositeDataDisplayAttributes* nrme,
+  vtkCompositeDataDisplayAttributes* nrmg,
+  vtkCompositeDataDisplayAttributes* seda,
+  vtkCompositeDataDisplayAttributes* sgda)
+{
   // We are about to manually set block visibilities for the selection,
   // so reset what's there now to reflect nothing being selected (i.e.,
   // only blocks hidden by user should have visibility entries and those
   // should be false).
-  auto* nrme = this->EntityMapper->GetCompositeDataDisplayAttributes();
-  auto* nrmg = this->GlyphMapper->GetBlockAttributes();
   nrme->RemoveBlockVisibilities();
   nrmg->RemoveBlockVisibilities();
   // Similarly, the selected-entity and selected-glyph block visibilities
   // should *all* be present but set to false.
-  auto* seda = this->SelectedEntityMapper->GetCompositeDataDisplayAttributes();
-  auto* sgda = this->SelectedGlyphMapper->GetBlockAttributes();
   for (const auto& entry : this->RenderableData)
   {
     seda->SetBlockVisibility(entry.second, false);
@@ -912,14 +1057,6 @@ void vtkSMTKResourceRepresentation::UpdateDisplayAttributesFromSelection(
   // on the mappers by calling SetSelectedState() on entries in this->RenderableData.
   bool atLeastOneSelected = this->ApplyStyle(sm, this->RenderableData, this);
   (void)atLeastOneSelected;
-
-  // This is necessary to force an update in the mapper
-  this->Entities->GetMapper()->Modified();
-  this->GlyphEntities->GetMapper()->Modified();
-  this->SelectedEntities->GetMapper()->Modified();
-  this->SelectedGlyphEntities->GetMapper()->Modified();
-
-  this->ApplyStyleTime.Modified();
 }
 
 void vtkSMTKResourceRepresentation::UpdateSelection(
@@ -23,8 +23,10 @@
 
 #include <array>
 #include <map>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 class vtkSMTKWrapper;
 
@@ -371,6 +373,13 @@ protected:
   void UpdateDisplayAttributesFromSelection(
     vtkMultiBlockDataSet* modelData,
     vtkMultiBlockDataSet* instanceData);
+  /// Reset the display attributes of all renderables and restyle them from the selection.
+  void ApplyStyleToAllRenderables(
+    smtk::view::SelectionPtr selection,
+    vtkCompositeDataDisplayAttributes* entityAttributes,
+    vtkCompositeDataDisplayAttributes* glyphAttributes,
+    vtkCompositeDataDisplayAttributes* selectedEntityAttributes,
+    vtkCompositeDataDisplayAttributes* selectedGlyphAttributes);
   void UpdateSelection(
     vtkMultiBlockDataSet* data,
     vtkCompositeDataDisplayAttributes* blockAttr,
@@ -515,6 +524,26 @@ protected:
   RenderableDataMap RenderableData;
   /// Timestamp for when RenderableData was last updated
   vtkTimeStamp RenderableTime;
+
+  //@{
+  /**
+   * State used to patch RenderableData and restyle only the blocks that
+   * changed when the input is updated incrementally (see
+   * vtkResourceMultiBlockSource::GetChangedComponents()).
+   */
+  /// The update number of the most recent input.
+  int LastUpdateNumber{ -1 };
+  /// True when RenderableData must be rebuilt rather than patched.
+  bool RenderableDataInvalid{ true };
+  /// Components changed by input updates not yet reflected in RenderableData.
+  std::set<smtk::common::UUID> PendingChanges;
+  /// True when only ChangedRenderables and StaleBlocks need restyling.
+  bool RenderableDataPatched{ false };
+  /// Renderables added or replaced since styles were last applied.
+  RenderableDataMap ChangedRenderables;
+  /// Blocks no longer rendered whose display attributes should be discarded.
+  std::vector<vtkDataObject*> StaleBlocks;
+  //@}
   /// Timestamp for when the SMTK application Selection was last modified.
   vtkTimeStamp SelectionTime;
   /// Timestamp for when highlighting styles related to the selection were last applied.
@@ -140,6 +140,9 @@ void qtDescriptivePhraseModel::setPhraseModel(smtk::view::PhraseModelPtr model)
   m_model = model;
   if (m_model)
   {
+    // Reorder events are mapped to a single layout change, so operation
+    // results may be applied to each parent phrase in one batch.
+    m_model->setBatchedUpdates(true);
     std::ostringstream modelDesc;
     modelDesc << "qtDescriptivePhraseModel: Update phrases for " << m_model->typeName() << " @ "
               << m_model;
@@ -532,6 +535,32 @@ void qtDescriptivePhraseModel::updateObserver(
     case PhraseModelEvent::PHRASE_MODIFIED:
       Q_EMIT this->dataChanged(this->indexFromPath(src), this->indexFromPath(dst));
       break;
+    case PhraseModelEvent::ABOUT_TO_REORDER:
+    {
+      QList<QPersistentModelIndex> parents{ QPersistentModelIndex(this->indexFromPath(src)) };
+      Q_EMIT this->layoutAboutToBeChanged(parents, QAbstractItemModel::VerticalSortHint);
+    }
+    break;
+    case PhraseModelEvent::REORDER_FINISHED:
+    {
+      // The children of the parent have been permuted; range[i] is the new
+      // row of the child that was at row i.
+      QModelIndex parentIndex = this->indexFromPath(src);
+      QModelIndexList from;
+      QModelIndexList to;
+      for (const auto& index : this->persistentIndexList())
+      {
+        if (index.parent() == parentIndex && index.row() < static_cast<int>(range.size()))
+        {
+          from.push_back(index);
+          to.push_back(this->createIndex(range[index.row()], index.column(), index.internalId()));
+        }
+      }
+      this->changePersistentIndexList(from, to);
+      QList<QPersistentModelIndex> parents{ QPersistentModelIndex(parentIndex) };
+      Q_EMIT this->layoutChanged(parents, QAbstractItemModel::VerticalSortHint);
+    }
+    break;
   }
 }
 } // namespace extension
@@ -19,10 +19,12 @@
 #include "vtkInformation.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
 #include "vtkTransform.h"
 #include "vtkTransformFilter.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <array>
 
 vtkStandardNewMacro(vtkApplyTransforms);
@@ -56,6 +58,7 @@ int vtkApplyTransforms::RequestData(
   output->CopyStructure(input);
   auto* iter = input->NewIterator();
   iter->SkipEmptyNodesOn();
+  std::unordered_map<vtkDataObject*, CachedBlock> cache;
   for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
   {
     auto* blockIn = input->GetDataSet(iter);
@@ -64,6 +67,20 @@ int vtkApplyTransforms::RequestData(
       continue;
     }
 
+    // Reuse the output for an unchanged input block so that state held
+    // downstream per output block (e.g., display attributes) is preserved.
+    auto* fieldDataIn = blockIn->GetAttributesAsFieldData(vtkDataObject::FIELD);
+    vtkMTimeType inputTime =
+      std::max(blockIn->GetMTime(), fieldDataIn ? fieldDataIn->GetMTime() : 0);
+    auto cached = this->Cache.find(blockIn);
+    if (cached != this->Cache.end() && cached->second.InputTime >= inputTime)
+    {
+      output->SetDataSet(iter, cached->second.Output);
+      cache[blockIn] = cached->second;
+      continue;
+    }
+    CachedBlock entry{ blockIn, nullptr, inputTime };
+
     auto* grid = dynamic_cast<vtkUnstructuredGrid*>(blockIn);
     // If we are dealing with unstructured data, run it through a
     // surface extraction filter.
@@ -92,17 +109,16 @@ int vtkApplyTransforms::RequestData(
           result->GetPointData()->SetGlobalIds(newGlobalIds);
         }
       }
-      blockIn = result;
-      auto* blockOut = blockIn->NewInstance();
-      blockOut->ShallowCopy(blockIn);
-      output->SetDataSet(iter, blockOut);
+      entry.Output = vtkSmartPointer<vtkDataObject>::Take(result->NewInstance());
+      entry.Output->ShallowCopy(result);
+      output->SetDataSet(iter, entry.Output);
+      cache[blockIn] = entry;
       continue;
     }
 
-    auto* blockOut = blockIn->NewInstance();
+    entry.Output = vtkSmartPointer<vtkDataObject>::Take(blockIn->NewInstance());
     bool haveTransform = false;
 
-    auto* fieldDataIn = blockIn->GetAttributesAsFieldData(vtkDataObject::FIELD);
     int transformIdx = -1;
     auto* transformField =
       vtkDoubleArray::SafeDownCast(fieldDataIn->GetArray("transform", transformIdx));
@@ -116,14 +132,18 @@ int vtkApplyTransforms::RequestData(
       this->Transform->SetMatrix(transformField->GetPointer(0));
       this->TransformFilter->SetInputDataObject(0, blockIn);
       this->TransformFilter->Update();
-      blockOut->ShallowCopy(this->TransformFilter->GetOutputDataObject(0));
+      entry.Output->ShallowCopy(this->TransformFilter->GetOutputDataObject(0));
     }
     else
     {
-      blockOut->ShallowCopy(blockIn);
+      entry.Output->ShallowCopy(blockIn);
     }
-    output->SetDataSet(iter, blockOut);
+    output->SetDataSet(iter, entry.Output);
+    cache[blockIn] = entry;
   }
+  iter->Delete();
+  // Drop outputs for input blocks that are no longer present.
+  this->Cache.swap(cache);
 
   return 1;
 }
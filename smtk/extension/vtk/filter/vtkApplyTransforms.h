@@ -13,6 +13,9 @@
 #include "smtk/extension/vtk/filter/vtkSMTKFilterExtModule.h" // For export macro
 #include "vtkCompositeDataSetAlgorithm.h"
 #include "vtkNew.h"
+#include "vtkSmartPointer.h"
+
+#include <unordered_map>
 
 class vtkDataSetSurfaceFilter;
 class vtkTransform;
@@ -21,6 +24,8 @@ class vtkTransformFilter;
 /**\brief Apply per-dataset transforms held in field data to the input collection as well
  * as extract the boundary of volumetric datasets.
   *
+  * Output blocks are reused for input blocks that have not been modified
+  * since the previous execution, so consumers may key state on them.
   */
 class VTKSMTKFILTEREXT_EXPORT vtkApplyTransforms : public vtkCompositeDataSetAlgorithm
 {
@@ -42,6 +47,16 @@ protected:
   vtkNew<vtkDataSetSurfaceFilter> SurfaceFilter;
   vtkNew<vtkTransformFilter> TransformFilter;
   vtkNew<vtkTransform> Transform;
+
+  /// The output produced for an input block (which is held so its address stays unique).
+  struct CachedBlock
+  {
+    vtkSmartPointer<vtkDataObject> Input;
+    vtkSmartPointer<vtkDataObject> Output;
+    vtkMTimeType InputTime;
+  };
+  /// Outputs from the previous execution, keyed by input block.
+  std::unordered_map<vtkDataObject*, CachedBlock> Cache;
 };
 
 #endif // smtk_vtk_ApplyTransforms_h
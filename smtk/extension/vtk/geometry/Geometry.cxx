@@ -14,9 +14,19 @@
 #include "smtk/resource/Resource.h"
 #include "smtk/resource/properties/CoordinateFrame.h"
 
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataObject.h"
+#include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkFieldData.h"
+#include "vtkGenericCell.h"
+#include "vtkGenericDataObjectReader.h"
+#include "vtkGenericDataObjectWriter.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
 #include "vtkUnsignedCharArray.h"
 
 #include "vtk_eigen.h"
@@ -25,6 +35,10 @@
 
 #include "smtk/io/Logger.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace smtk
 {
 namespace extension
@@ -90,8 +104,174 @@ Eigen::Matrix<double, 4, 4> concatenatedParentTransforms(
   return transform;
 }
 
+// Invoke \a visitor on each data set in \a data (which may be composite)
+// until it returns true. Returns false if \a data holds no data sets.
+template<typename Visitor>
+bool visitDataSets(vtkDataObject* data, Visitor visitor, bool& halted)
+{
+  halted = false;
+  if (auto* dataSet = vtkDataSet::SafeDownCast(data))
+  {
+    halted = visitor(dataSet);
+    return true;
+  }
+  auto* composite = vtkCompositeDataSet::SafeDownCast(data);
+  if (!composite)
+  {
+    return false;
+  }
+  bool visited = false;
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(composite->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (auto* dataSet = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+    {
+      visited = true;
+      if (visitor(dataSet))
+      {
+        halted = true;
+        break;
+      }
+    }
+  }
+  return visited;
+}
+
 } // anonymous namespace
 
+double Geometry::raycast(
+  const smtk::resource::PersistentObjectPtr& obj,
+  const Point& origin,
+  const Point& direction,
+  double entry,
+  double maxParameter) const
+{
+  constexpr double infinity = std::numeric_limits<double>::infinity();
+  double speed = std::sqrt(vtkMath::Dot(direction.data(), direction.data()));
+  if (this->generationNumber(obj) == Invalid || speed == 0.)
+  {
+    return entry;
+  }
+  double hit = infinity;
+  bool halted;
+  bool tested = visitDataSets(
+    this->data(obj),
+    [&](vtkDataSet* dataSet) {
+      if (dataSet->GetNumberOfCells() == 0)
+      {
+        return false;
+      }
+      // Intersect cells with the segment of the ray that spans the data set.
+      double diagonal = dataSet->GetLength();
+      double exit = std::min(maxParameter, entry + (diagonal + 1.) / speed);
+      double tolerance = 1e-6 * (diagonal > 0. ? diagonal : 1.);
+      std::array<double, 3> p0;
+      std::array<double, 3> p1;
+      for (int ii = 0; ii < 3; ++ii)
+      {
+        p0[ii] = origin[ii] + entry * direction[ii];
+        p1[ii] = origin[ii] + exit * direction[ii];
+      }
+      vtkNew<vtkGenericCell> cell;
+      double tt;
+      double xx[3];
+      double pcoords[3];
+      int subId;
+      for (vtkIdType cellId = 0; cellId < dataSet->GetNumberOfCells(); ++cellId)
+      {
+        dataSet->GetCell(cellId, cell);
+        if (cell->IntersectWithLine(p0.data(), p1.data(), tolerance, tt, xx, pcoords, subId))
+        {
+          hit = std::min(hit, entry + tt * (exit - entry));
+        }
+      }
+      return false;
+    },
+    halted);
+  if (!tested)
+  {
+    return entry;
+  }
+  return hit <= maxParameter ? hit : infinity;
+}
+
+bool Geometry::overlaps(const smtk::resource::PersistentObjectPtr& obj, const BoundingBox& box)
+  const
+{
+  if (this->generationNumber(obj) == Invalid)
+  {
+    return true;
+  }
+  bool found;
+  bool tested = visitDataSets(
+    this->data(obj),
+    [&box](vtkDataSet* dataSet) {
+      double bounds[6];
+      for (vtkIdType cellId = 0; cellId < dataSet->GetNumberOfCells(); ++cellId)
+      {
+        dataSet->GetCellBounds(cellId, bounds);
+        bool disjoint = false;
+        for (int axis = 0; axis < 3 && !disjoint; ++axis)
+        {
+          disjoint =
+            bounds[2 * axis] > box[2 * axis + 1] || bounds[2 * axis + 1] < box[2 * axis];
+        }
+        if (!disjoint)
+        {
+          return true;
+        }
+      }
+      return false;
+    },
+    found);
+  return !tested || found;
+}
+
+bool Geometry::inside(
+  const smtk::resource::PersistentObjectPtr& obj,
+  const std::vector<Plane>& planes) const
+{
+  if (this->generationNumber(obj) == Invalid)
+  {
+    return true;
+  }
+  bool found;
+  bool tested = visitDataSets(
+    this->data(obj),
+    [&planes](vtkDataSet* dataSet) {
+      vtkNew<vtkIdList> pointIds;
+      double point[3];
+      for (vtkIdType cellId = 0; cellId < dataSet->GetNumberOfCells(); ++cellId)
+      {
+        // A cell is outside if all of its points are outside one plane.
+        dataSet->GetCellPoints(cellId, pointIds);
+        bool outside = false;
+        for (const auto& plane : planes)
+        {
+          outside = true;
+          for (vtkIdType ii = 0; ii < pointIds->GetNumberOfIds() && outside; ++ii)
+          {
+            dataSet->GetPoint(pointIds->GetId(ii), point);
+            outside =
+              plane[0] * point[0] + plane[1] * point[1] + plane[2] * point[2] + plane[3] < 0.;
+          }
+          if (outside)
+          {
+            break;
+          }
+        }
+        if (!outside)
+        {
+          return true;
+        }
+      }
+      return false;
+    },
+    found);
+  return !tested || found;
+}
+
 void Geometry::addColorArray(
   vtkDataObject* data,
   const std::vector<double>& rgba,
@@ -176,6 +356,47 @@ bool Geometry::addTransformArrayIfPresent(
   return false;
 }
 
+std::size_t Geometry::dataSize(const DataType& data) const
+{
+  // VTK reports memory in kibibytes.
+  return data ? static_cast<std::size_t>(data->GetActualMemorySize()) * 1024 : 0;
+}
+
+bool Geometry::isShared(const DataType& data) const
+{
+  // The cache's smart pointer holds one reference.
+  return data && data->GetReferenceCount() > 1;
+}
+
+bool Geometry::writeSpill(const DataType& data, const std::string& filename) const
+{
+  if (!data)
+  {
+    return false;
+  }
+  vtkNew<vtkGenericDataObjectWriter> writer;
+  writer->SetInputDataObject(data);
+  writer->SetFileName(filename.c_str());
+  writer->SetFileTypeToBinary();
+  return writer->Write() != 0;
+}
+
+bool Geometry::readSpill(const std::string& filename, DataType& data) const
+{
+  vtkNew<vtkGenericDataObjectReader> reader;
+  reader->SetFileName(filename.c_str());
+  reader->Update();
+  vtkDataObject* output = reader->GetOutputDataObject(0);
+  if (!output)
+  {
+    return false;
+  }
+  // Copy the output so the cache does not keep the reader alive.
+  data.TakeReference(output->NewInstance());
+  data->ShallowCopy(output);
+  return true;
+}
+
 } // namespace geometry
 } // namespace vtk
 } // namespace extension
@@ -104,6 +104,31 @@ public:
     const std::shared_ptr<smtk::resource::PersistentObject>& object,
     const std::string& outputArrayName = "transform");
 
+  /// Test spatial-query candidates against the cells of their VTK data.
+  ///
+  /// Composite data is tested one leaf data set at a time. Objects whose data
+  /// holds no data sets are matched by their bounds (as by the base class).
+  double raycast(
+    const smtk::resource::PersistentObjectPtr& obj,
+    const Point& origin,
+    const Point& direction,
+    double entry,
+    double maxParameter) const override;
+  bool overlaps(const smtk::resource::PersistentObjectPtr& obj, const BoundingBox& box)
+    const override;
+  bool inside(const smtk::resource::PersistentObjectPtr& obj, const std::vector<Plane>& planes)
+    const override;
+
+  /// Report the memory held by VTK data so it can be limited by a CacheBudget.
+  std::size_t dataSize(const DataType& data) const override;
+
+  /// Report whether VTK data is referenced by anything other than the cache.
+  bool isShared(const DataType& data) const override;
+
+  /// Spill evicted VTK data to (and restore it from) legacy VTK files.
+  bool writeSpill(const DataType& data, const std::string& filename) const override;
+  bool readSpill(const std::string& filename, DataType& data) const override;
+
 protected:
   Backend m_backend;
 };
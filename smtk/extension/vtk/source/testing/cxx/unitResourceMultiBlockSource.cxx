@@ -8,13 +8,26 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //=========================================================================
 
+#include "smtk/extension/vtk/geometry/Geometry.h"
 #include "smtk/extension/vtk/source/vtkModelMultiBlockSource.h"
 
+#include "smtk/geometry/Cache.h"
+#include "smtk/geometry/Resource.h"
+#include "smtk/resource/Component.h"
+#include "smtk/resource/DerivedFrom.h"
+
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
+#include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 
 #include "smtk/common/testing/cxx/helpers.h"
 
+#include <map>
+
 using UUID = smtk::common::UUID;
 using SequenceType = vtkResourceMultiBlockSource::SequenceType;
 constexpr SequenceType invalid = vtkResourceMultiBlockSource::InvalidSequence;
@@ -22,6 +35,194 @@ constexpr SequenceType invalid = vtkResourceMultiBlockSource::InvalidSequence;
 namespace
 {
 
+class PatchResource;
+
+class Patch : public smtk::resource::Component
+{
+  friend class PatchResource;
+
+public:
+  smtkTypeMacro(Patch);
+  smtkSuperclassMacro(smtk::resource::Component);
+  smtkSharedFromThisMacro(smtk::resource::PersistentObject);
+
+  const smtk::resource::ResourcePtr resource() const override { return m_resource.lock(); }
+  const UUID& id() const override { return m_id; }
+  bool setId(const UUID& id) override
+  {
+    m_id = id;
+    return true;
+  }
+
+private:
+  Patch(const smtk::resource::ResourcePtr& resource)
+    : m_resource(resource)
+    , m_id(UUID::random())
+  {
+  }
+
+  std::weak_ptr<smtk::resource::Resource> m_resource;
+  UUID m_id;
+};
+
+class PatchResource : public smtk::resource::DerivedFrom<PatchResource, smtk::geometry::Resource>
+{
+public:
+  smtkTypeMacro(PatchResource);
+  smtkCreateMacro(PatchResource);
+  smtkSharedFromThisMacro(smtk::resource::PersistentObject);
+
+  Patch::Ptr add()
+  {
+    Patch::Ptr patch(new Patch(shared_from_this()));
+    m_patches[patch->id()] = patch;
+    return patch;
+  }
+
+  smtk::resource::ComponentPtr find(const UUID& id) const override
+  {
+    auto it = m_patches.find(id);
+    return it == m_patches.end() ? nullptr : it->second;
+  }
+
+  std::function<bool(const smtk::resource::Component&)> queryOperation(
+    const std::string& /*unused*/) const override
+  {
+    return [](const smtk::resource::Component& /*unused*/) { return true; };
+  }
+
+  void visit(smtk::resource::Component::Visitor& visitor) const override
+  {
+    for (const auto& entry : m_patches)
+    {
+      visitor(entry.second);
+    }
+  }
+
+protected:
+  PatchResource() = default;
+
+private:
+  std::map<UUID, Patch::Ptr> m_patches;
+};
+
+// Provide a new (empty) surface each time a patch is modified.
+class PatchGeometry
+  : public smtk::geometry::Cache<smtk::extension::vtk::geometry::Geometry>
+{
+public:
+  PatchGeometry(const PatchResource::Ptr& parent)
+    : m_parent(parent)
+  {
+  }
+
+  smtk::geometry::Resource::Ptr resource() const override { return m_parent.lock(); }
+
+  void queryGeometry(const smtk::resource::PersistentObject::Ptr& /*unused*/, CacheEntry& entry)
+    const override
+  {
+    entry.m_geometry = vtkSmartPointer<vtkPolyData>::New();
+    ++entry.m_generation;
+  }
+
+  int dimension(const smtk::resource::PersistentObject::Ptr& /*unused*/) const override
+  {
+    return 2;
+  }
+
+  Purpose purpose(const smtk::resource::PersistentObject::Ptr& /*unused*/) const override
+  {
+    return Surface;
+  }
+
+  void geometricBounds(const DataType& /*unused*/, BoundingBox& bbox) const override
+  {
+    bbox[0] = bbox[2] = bbox[4] = 0.0;
+    bbox[1] = bbox[3] = bbox[5] = 1.0;
+  }
+
+private:
+  std::weak_ptr<PatchResource> m_parent;
+};
+
+// Expose RequestDataFromGeometry() so outputs can be produced without a pipeline.
+class vtkTestResourceSource : public vtkResourceMultiBlockSource
+{
+public:
+  vtkTypeMacro(vtkTestResourceSource, vtkResourceMultiBlockSource);
+  static vtkTestResourceSource* New();
+
+  vtkSmartPointer<vtkMultiBlockDataSet> Generate(
+    const smtk::extension::vtk::geometry::Geometry& provider)
+  {
+    auto output = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+    vtkNew<vtkInformationVector> outInfo;
+    outInfo->SetNumberOfInformationObjects(1);
+    outInfo->GetInformationObject(0)->Set(vtkDataObject::DATA_OBJECT(), output);
+    return this->RequestDataFromGeometry(nullptr, outInfo, provider) ? output : nullptr;
+  }
+};
+vtkStandardNewMacro(vtkTestResourceSource);
+
+vtkDataObject* Leaf(vtkMultiBlockDataSet* output, unsigned int index)
+{
+  auto* components = vtkMultiBlockDataSet::SafeDownCast(
+    output->GetBlock(vtkResourceMultiBlockSource::BlockId::Components));
+  auto* surfaces = components ? vtkMultiBlockDataSet::SafeDownCast(components->GetBlock(2))
+                              : nullptr;
+  return surfaces && index < surfaces->GetNumberOfBlocks() ? surfaces->GetBlock(index) : nullptr;
+}
+
+vtkDataObject* Leaf(vtkMultiBlockDataSet* output, const UUID& uid)
+{
+  vtkDataObject* leaf = nullptr;
+  for (unsigned int ii = 0; (leaf = Leaf(output, ii)); ++ii)
+  {
+    if (vtkResourceMultiBlockSource::GetDataObjectUUID(leaf->GetInformation()) == uid)
+    {
+      break;
+    }
+  }
+  return leaf;
+}
+
+void TestIncrementalOutputs()
+{
+  std::cout << "Verify that incremental updates do not modify earlier outputs.\n";
+  auto resource = PatchResource::create();
+  auto patchA = resource->add();
+  auto patchB = resource->add();
+  PatchGeometry geometry(resource);
+  geometry.markModified(patchA);
+  geometry.markModified(patchB);
+
+  vtkNew<vtkTestResourceSource> src;
+  auto first = src->Generate(geometry);
+  test(first && Leaf(first, patchA->id()) && Leaf(first, patchB->id()), "Expected two leaves.");
+  vtkDataObject* firstA = Leaf(first, patchA->id());
+  vtkDataObject* firstB = Leaf(first, patchB->id());
+
+  geometry.markModified(patchA);
+  auto second = src->Generate(geometry);
+  test(!!second, "Expected a second output.");
+  test(Leaf(first, patchA->id()) == firstA, "Expected the first output to be unchanged.");
+  test(Leaf(second, patchA->id()) != firstA, "Expected the second output to hold new data.");
+  test(Leaf(second, patchB->id()) == firstB, "Expected unchanged leaves to be shared.");
+  test(
+    first->GetBlock(vtkResourceMultiBlockSource::BlockId::Components) !=
+      second->GetBlock(vtkResourceMultiBlockSource::BlockId::Components),
+    "Expected each output to have its own block structure.");
+
+  std::set<UUID> changed;
+  test(
+    vtkResourceMultiBlockSource::GetChangedComponents(
+      second, vtkResourceMultiBlockSource::GetUpdateNumber(first), changed) &&
+      changed.size() == 1 && *changed.begin() == patchA->id(),
+    "Expected only the modified patch to be reported as changed.");
+
+  std::cout << "  ... Done.\n";
+}
+
 void TestCache()
 {
   std::cout << "Verify that dataset caching works.\n";
@@ -144,6 +345,7 @@ void TestCache()
 int unitResourceMultiBlockSource(int /*unused*/, char** const /*unused*/)
 {
   TestCache();
+  TestIncrementalOutputs();
 
   return 0;
 }
@@ -12,14 +12,18 @@
 #include "smtk/extension/vtk/geometry/Backend.h"
 #include "smtk/extension/vtk/geometry/Geometry.h"
 
+#include "smtk/geometry/CacheBudget.h"
 #include "smtk/geometry/Resource.h"
 
 #include "vtkDataObject.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
 #include "vtkInformationStringKey.h"
+#include "vtkInformationStringVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointer.h"
 
@@ -28,6 +32,58 @@ using SequenceType = vtkResourceMultiBlockSource::SequenceType;
 
 vtkStandardNewMacro(vtkResourceMultiBlockSource);
 vtkInformationKeyMacro(vtkResourceMultiBlockSource, COMPONENT_ID, String);
+vtkInformationKeyMacro(vtkResourceMultiBlockSource, UPDATE_NUMBER, Integer);
+vtkInformationKeyMacro(vtkResourceMultiBlockSource, CHANGES_SINCE, Integer);
+vtkInformationKeyMacro(vtkResourceMultiBlockSource, CHANGED_COMPONENTS, StringVector);
+
+namespace
+{
+void SetComponentBlock(
+  vtkMultiBlockDataSet* entries,
+  unsigned int index,
+  const UUID& uid,
+  vtkDataObject* data)
+{
+  entries->SetBlock(index, data);
+  vtkResourceMultiBlockSource::SetDataObjectUUID(entries->GetMetaData(index), uid);
+  if (const auto* dataName = data->GetInformation()->Get(vtkCompositeDataSet::NAME()))
+  {
+    std::string compName(dataName);
+    if (!compName.empty())
+    {
+      entries->GetMetaData(index)->Set(vtkCompositeDataSet::NAME(), compName.c_str());
+    }
+  }
+}
+
+// Return a new multiblock with the structure and block metadata of \a source
+// whose leaves are the data objects held by \a source. Outputs are given such
+// copies so that patching the blocks held between updates does not modify
+// outputs that consumers may still hold.
+vtkSmartPointer<vtkMultiBlockDataSet> CopyBlockStructure(vtkMultiBlockDataSet* source)
+{
+  auto result = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  unsigned int numberOfBlocks = source->GetNumberOfBlocks();
+  result->SetNumberOfBlocks(numberOfBlocks);
+  for (unsigned int ii = 0; ii < numberOfBlocks; ++ii)
+  {
+    auto* block = source->GetBlock(ii);
+    if (auto* children = vtkMultiBlockDataSet::SafeDownCast(block))
+    {
+      result->SetBlock(ii, CopyBlockStructure(children));
+    }
+    else
+    {
+      result->SetBlock(ii, block);
+    }
+    if (source->HasMetaData(ii))
+    {
+      result->GetMetaData(ii)->Copy(source->GetMetaData(ii));
+    }
+  }
+  return result;
+}
+} // anonymous namespace
 
 //----------------------------------------------------------------------------
 vtkResourceMultiBlockSource::vtkResourceMultiBlockSource()
@@ -92,6 +148,48 @@ UUID vtkResourceMultiBlockSource::GetResourceId(vtkMultiBlockDataSet* dataset)
   return vtkResourceMultiBlockSource::GetDataObjectUUID(dataset->GetMetaData(BlockId::Components));
 }
 
+//----------------------------------------------------------------------------
+int vtkResourceMultiBlockSource::GetUpdateNumber(vtkMultiBlockDataSet* dataset)
+{
+  if (
+    !dataset || dataset->GetNumberOfBlocks() <= BlockId::Components ||
+    !dataset->HasMetaData(BlockId::Components))
+  {
+    return -1;
+  }
+  auto* info = dataset->GetMetaData(BlockId::Components);
+  return info->Has(vtkResourceMultiBlockSource::UPDATE_NUMBER())
+    ? info->Get(vtkResourceMultiBlockSource::UPDATE_NUMBER())
+    : -1;
+}
+
+//----------------------------------------------------------------------------
+bool vtkResourceMultiBlockSource::GetChangedComponents(
+  vtkMultiBlockDataSet* dataset,
+  int since,
+  std::set<UUID>& changed)
+{
+  if (
+    !dataset || dataset->GetNumberOfBlocks() <= BlockId::Components ||
+    !dataset->HasMetaData(BlockId::Components))
+  {
+    return false;
+  }
+  auto* info = dataset->GetMetaData(BlockId::Components);
+  if (
+    !info->Has(vtkResourceMultiBlockSource::CHANGES_SINCE()) ||
+    info->Get(vtkResourceMultiBlockSource::CHANGES_SINCE()) != since)
+  {
+    return false;
+  }
+  int numberChanged = info->Length(vtkResourceMultiBlockSource::CHANGED_COMPONENTS());
+  for (int ii = 0; ii < numberChanged; ++ii)
+  {
+    changed.insert(UUID(info->Get(vtkResourceMultiBlockSource::CHANGED_COMPONENTS(), ii)));
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 smtk::resource::ComponentPtr vtkResourceMultiBlockSource::GetComponent(
   const smtk::resource::ResourcePtr& resource,
@@ -120,6 +218,10 @@ smtk::resource::ResourcePtr vtkResourceMultiBlockSource::GetResource()
 //----------------------------------------------------------------------------
 void vtkResourceMultiBlockSource::SetResource(const smtk::resource::ResourcePtr& resource)
 {
+  if (this->Resource.lock() != resource)
+  {
+    this->ResetBlocks();
+  }
   this->Resource = resource;
   this->Modified();
 }
@@ -285,15 +387,72 @@ int vtkResourceMultiBlockSource::RequestDataFromGeometry(
     this->LastModified = lastModified;
   }
 
-  // Images separated into fake dimension
-  const int IMAGE_DIM = 5;
+  // Once evicted geometry is no longer referenced by our blocks, let the
+  // cache budget release it.
+  auto budget = geometry.cacheBudget();
+
+  int previousUpdate = this->UpdateNumber++;
+  if (!this->Incremental)
+  {
+    this->ResetBlocks();
+    this->BuildBlocks(output, geometry);
+    output->GetMetaData(BlockId::Components)
+      ->Set(vtkResourceMultiBlockSource::UPDATE_NUMBER(), this->UpdateNumber);
+    if (budget)
+    {
+      budget->enforce();
+    }
+    return 1;
+  }
+
+  // Without blocks from a previous update, every block is new; consumers
+  // are told so by the absence of a change list.
+  bool rebuilt = !this->ComponentBlocks;
+  this->PatchBlocks(geometry);
+
+  output->SetNumberOfBlocks(BlockId::NumberOfBlocks);
+  vtkNew<vtkMultiBlockDataSet> prototypes;
+  vtkNew<vtkMultiBlockDataSet> instances;
+  output->SetBlock(BlockId::Components, CopyBlockStructure(this->ComponentBlocks));
+  output->SetBlock(BlockId::Prototypes, prototypes);
+  output->SetBlock(BlockId::Instances, instances);
+  if (this->ImageBlocks)
+  {
+    output->SetBlock(BlockId::Images, CopyBlockStructure(this->ImageBlocks));
+  }
+
+  auto* info = output->GetMetaData(BlockId::Components);
+  info->Set(vtkResourceMultiBlockSource::UPDATE_NUMBER(), this->UpdateNumber);
+  if (!rebuilt)
+  {
+    info->Set(vtkResourceMultiBlockSource::CHANGES_SINCE(), previousUpdate);
+    for (const auto& uid : this->ChangedComponents)
+    {
+      info->Append(vtkResourceMultiBlockSource::CHANGED_COMPONENTS(), uid.toString().c_str());
+    }
+  }
+
+  if (budget)
+  {
+    budget->enforce();
+  }
+  return 1;
+}
+
+void vtkResourceMultiBlockSource::BuildBlocks(
+  vtkMultiBlockDataSet* output,
+  const smtk::extension::vtk::geometry::Geometry& geometry)
+{
   std::map<int, std::vector<vtkSmartPointer<vtkDataObject>>> compBlocks;
-  // smtk::extension::vtk::geometry::Backend source(&geometry);
-  smtk::extension::vtk::geometry::Backend backend;
-  geometry.visit([this, &geometry, &compBlocks, IMAGE_DIM](
+  geometry.visit([this, &geometry, &compBlocks](
                    const smtk::resource::PersistentObject::Ptr& obj,
                    smtk::geometry::Geometry::GenerationNumber gen) {
-    if (obj)
+    if (obj && geometry.isEvicted(obj))
+    {
+      // Do not regenerate geometry evicted to meet the cache budget; drop it.
+      this->RemoveCacheEntry(obj->id());
+    }
+    else if (obj)
     {
       int dim = geometry.dimension(obj);
       auto& data = geometry.data(obj);
@@ -305,7 +464,7 @@ int vtkResourceMultiBlockSource::RequestDataFromGeometry(
         // Lets see if this is a component or image object
         if (vtkImageData::SafeDownCast(data))
         {
-          compBlocks[IMAGE_DIM].push_back(data);
+          compBlocks[ImageGroup].push_back(data);
         }
         else
         {
@@ -329,28 +488,21 @@ int vtkResourceMultiBlockSource::RequestDataFromGeometry(
   {
     vtkNew<vtkMultiBlockDataSet> entries;
     entries->SetNumberOfBlocks(static_cast<int>(dit->second.size()));
-    int bb = 0;
+    unsigned int bb = 0;
     for (auto iit = dit->second.begin(); iit != dit->second.end(); ++iit, ++bb)
     {
-      entries->SetBlock(bb, *iit);
-      vtkResourceMultiBlockSource::SetDataObjectUUID(
-        entries->GetMetaData(bb),
-        vtkResourceMultiBlockSource::GetDataObjectUUID((*iit)->GetInformation()));
-      if (const auto* dataName = (*iit)->GetInformation()->Get(vtkCompositeDataSet::NAME()))
-      {
-        std::string compName(dataName);
-        if (!compName.empty())
-        {
-          entries->GetMetaData(bb)->Set(vtkCompositeDataSet::NAME(), compName.c_str());
-        }
-      }
+      SetComponentBlock(
+        entries,
+        bb,
+        vtkResourceMultiBlockSource::GetDataObjectUUID((*iit)->GetInformation()),
+        *iit);
     }
     if (dit->first == -1)
     {
       // put unknown here
       compPerDim->SetBlock(2, entries);
     }
-    else if (dit->first == IMAGE_DIM)
+    else if (dit->first == ImageGroup)
     {
       // Add all of the image blocks
       output->SetBlock(BlockId::Images, entries);
@@ -360,8 +512,138 @@ int vtkResourceMultiBlockSource::RequestDataFromGeometry(
       compPerDim->SetBlock(dit->first, entries);
     }
   }
+}
 
-  return 1;
+void vtkResourceMultiBlockSource::PatchBlocks(
+  const smtk::extension::vtk::geometry::Geometry& geometry)
+{
+  this->ChangedComponents.clear();
+  this->Visited.clear();
+  if (!this->ComponentBlocks)
+  {
+    this->ComponentBlocks = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+    // We need 4 toplevel blocks for component data (dim = to 3)
+    this->ComponentBlocks->SetNumberOfBlocks(4);
+  }
+
+  auto releaseBlock = [this](const BlockLocation& location) {
+    auto* entries = this->GetGroupBlock(location.Group);
+    entries->SetBlock(location.Index, nullptr);
+    if (entries->HasMetaData(location.Index))
+    {
+      entries->GetMetaData(location.Index)->Clear();
+    }
+    this->FreeBlocks[location.Group].push_back(location.Index);
+  };
+
+  geometry.visit([this, &geometry, &releaseBlock](
+                   const smtk::resource::PersistentObject::Ptr& obj,
+                   smtk::geometry::Geometry::GenerationNumber gen) {
+    // Geometry evicted to meet the cache budget is not regenerated; its
+    // block is emptied below like that of a component without geometry.
+    if (!obj || geometry.isEvicted(obj))
+    {
+      return false;
+    }
+    auto& data = geometry.data(obj);
+    if (!data)
+    {
+      return false;
+    }
+    const UUID& uid = obj->id();
+    this->Visited.insert(uid);
+    int group = ImageGroup;
+    if (!vtkImageData::SafeDownCast(data))
+    {
+      // Components of unknown dimension are placed with surfaces.
+      group = geometry.dimension(obj);
+      group = group < 0 ? 2 : group;
+    }
+    bool advanced = this->SetCachedData(uid, data, static_cast<SequenceType>(gen));
+
+    auto it = this->BlockLocations.find(uid);
+    if (it != this->BlockLocations.end() && it->second.Group == group)
+    {
+      auto* entries = this->GetGroupBlock(group);
+      if (!advanced && entries->GetBlock(it->second.Index) == data.GetPointer())
+      {
+        return false;
+      }
+      vtkResourceMultiBlockSource::SetDataObjectUUID(data->GetInformation(), uid);
+      SetComponentBlock(entries, it->second.Index, uid, data);
+      this->ChangedComponents.insert(uid);
+      return false;
+    }
+
+    if (it != this->BlockLocations.end())
+    {
+      releaseBlock(it->second);
+    }
+    auto* entries = this->GetGroupBlock(group);
+    auto& freeBlocks = this->FreeBlocks[group];
+    unsigned int index;
+    if (freeBlocks.empty())
+    {
+      index = entries->GetNumberOfBlocks();
+    }
+    else
+    {
+      index = freeBlocks.back();
+      freeBlocks.pop_back();
+    }
+    vtkResourceMultiBlockSource::SetDataObjectUUID(data->GetInformation(), uid);
+    SetComponentBlock(entries, index, uid, data);
+    this->BlockLocations[uid] = BlockLocation{ group, index };
+    this->ChangedComponents.insert(uid);
+    return false;
+  });
+
+  // Empty the blocks of components that no longer have geometry.
+  for (auto it = this->BlockLocations.begin(); it != this->BlockLocations.end();)
+  {
+    if (this->Visited.find(it->first) == this->Visited.end())
+    {
+      releaseBlock(it->second);
+      this->RemoveCacheEntry(it->first);
+      this->ChangedComponents.insert(it->first);
+      it = this->BlockLocations.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+vtkMultiBlockDataSet* vtkResourceMultiBlockSource::GetGroupBlock(int group)
+{
+  if (group == ImageGroup)
+  {
+    if (!this->ImageBlocks)
+    {
+      this->ImageBlocks = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+    }
+    return this->ImageBlocks;
+  }
+  auto* entries = static_cast<int>(this->ComponentBlocks->GetNumberOfBlocks()) > group
+    ? vtkMultiBlockDataSet::SafeDownCast(this->ComponentBlocks->GetBlock(group))
+    : nullptr;
+  if (!entries)
+  {
+    vtkNew<vtkMultiBlockDataSet> created;
+    this->ComponentBlocks->SetBlock(group, created);
+    entries = created;
+  }
+  return entries;
+}
+
+void vtkResourceMultiBlockSource::ResetBlocks()
+{
+  this->ComponentBlocks = nullptr;
+  this->ImageBlocks = nullptr;
+  this->BlockLocations.clear();
+  this->FreeBlocks.clear();
+  this->ChangedComponents.clear();
 }
 
 int vtkResourceMultiBlockSource::RequestData(
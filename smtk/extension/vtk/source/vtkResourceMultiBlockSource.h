@@ -18,9 +18,15 @@
 #include "smtk/resource/Resource.h"
 
 #include "vtkMultiBlockDataSetAlgorithm.h"
+#include "vtkSmartPointer.h"
 
+#include <map>
 #include <memory>
 #include <set>
+#include <vector>
+
+class vtkInformationIntegerKey;
+class vtkInformationStringVectorKey;
 
 namespace smtk
 {
@@ -51,6 +57,22 @@ class Geometry;
   *
   * This class provides methods to cache blocks so that resource-specific
   * subclasses need only regenerate data for modified components.
+  *
+  * When Incremental is on (the default), RequestDataFromGeometry() keeps the
+  * component blocks from one update to the next and patches only those whose
+  * generation number changed. Unchanged components keep their block indices;
+  * blocks of removed components are emptied (not compacted) and reused by
+  * components added later. Each output records which components changed
+  * since the previous output (see GetChangedComponents()) so consumers can
+  * avoid revisiting unchanged blocks. The blocks held between updates are
+  * never placed in an output; each output receives its own copy of their
+  * structure that shares only the leaf data objects, so patching them does
+  * not modify earlier outputs.
+  *
+  * Components whose geometry has been evicted by the geometry manager's
+  * CacheBudget are left out of the output (and their cached blocks are
+  * released) rather than regenerated, which would immediately exceed the
+  * budget again. Each update then lets the budget free that memory.
   */
 class VTKSMTKSOURCEEXT_EXPORT vtkResourceMultiBlockSource : public vtkMultiBlockDataSetAlgorithm
 {
@@ -98,6 +120,13 @@ public:
   /// Key used to put entity UUID in the meta-data associated with a block.
   static vtkInformationStringKey* COMPONENT_ID();
 
+  /// Key holding the number of the update that produced an output.
+  static vtkInformationIntegerKey* UPDATE_NUMBER();
+  /// Key holding the number of the update an incremental output is relative to.
+  static vtkInformationIntegerKey* CHANGES_SINCE();
+  /// Key holding the UUIDs of components whose blocks an incremental update changed.
+  static vtkInformationStringVectorKey* CHANGED_COMPONENTS();
+
   /// Set the COMPONENT_ID key on the given information object to a given UUID.
   static void SetDataObjectUUID(vtkInformation*, const UUID&);
 
@@ -110,6 +139,18 @@ public:
   /// Fetch the resource UUID from a dataset's top-level block metadata.
   static UUID GetResourceId(vtkMultiBlockDataSet* dataset);
 
+  /// Fetch the number of the update that produced \a dataset (or -1 if unknown).
+  static int GetUpdateNumber(vtkMultiBlockDataSet* dataset);
+
+  /// Insert the UUIDs of components whose blocks were added, replaced, or
+  /// emptied between update number \a since and the update that produced
+  /// \a dataset into \a changed.
+  ///
+  /// Returns false (leaving \a changed untouched) when \a dataset was rebuilt
+  /// or is not relative to \a since; consumers must then revisit every block.
+  static bool
+  GetChangedComponents(vtkMultiBlockDataSet* dataset, int since, std::set<UUID>& changed);
+
   /// Return the component corresponding to the data object.
   static smtk::resource::ComponentPtr GetComponent(
     const smtk::resource::ResourcePtr&,
@@ -122,6 +163,11 @@ public:
   /// We are modified by updated parameters and by updated resource geometry.
   vtkMTimeType GetMTime() override;
 
+  /// Set/get whether component blocks are patched in place rather than rebuilt on each update.
+  vtkSetMacro(Incremental, bool);
+  vtkGetMacro(Incremental, bool);
+  vtkBooleanMacro(Incremental, bool);
+
   /// A debug utility to print out the block structure of a multiblock dataset
   /// annotated with UUIDs (where present) and data type.
   static void DumpBlockStructureWithUUIDs(vtkMultiBlockDataSet* dataset, int indent = 0)
@@ -169,10 +215,44 @@ protected:
     vtkInformationVector* outputData,
     const smtk::extension::vtk::geometry::Geometry& provider);
 
+  /// Rebuild the output's block structure from scratch.
+  void BuildBlocks(
+    vtkMultiBlockDataSet* output,
+    const smtk::extension::vtk::geometry::Geometry& provider);
+  /// Patch the blocks held from the previous update, recording changes in ChangedComponents.
+  void PatchBlocks(const smtk::extension::vtk::geometry::Geometry& provider);
+  /// Return the block holding components of the given group, creating it as needed.
+  vtkMultiBlockDataSet* GetGroupBlock(int group);
+  /// Discard blocks held for incremental updates.
+  void ResetBlocks();
+
+  /// Where a component's data lives among the output's blocks.
+  struct BlockLocation
+  {
+    /// A dimension (0 to 3) or ImageGroup.
+    int Group;
+    unsigned int Index;
+  };
+
+  /// The group used for image data (a fake dimension).
+  constexpr static int ImageGroup = 5;
+
   std::weak_ptr<smtk::resource::Resource> Resource;
   std::map<UUID, CacheEntry> Cache;
   std::set<UUID> Visited; // Populated with extant entities during RequestData.
   smtk::geometry::Geometry::GenerationNumber LastModified{ 0 };
+
+  bool Incremental{ true };
+  /// Blocks held between incremental updates (outputs get copies of their structure).
+  vtkSmartPointer<vtkMultiBlockDataSet> ComponentBlocks;
+  vtkSmartPointer<vtkMultiBlockDataSet> ImageBlocks;
+  std::map<UUID, BlockLocation> BlockLocations;
+  /// Emptied block indices (per group) available for reuse.
+  std::map<int, std::vector<unsigned int>> FreeBlocks;
+  /// Components changed by the most recent update.
+  std::set<UUID> ChangedComponents;
+  /// The number of updates performed (the most recent output's UPDATE_NUMBER).
+  int UpdateNumber{ 0 };
 };
 
 #endif
@@ -0,0 +1,642 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/geometry/BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+namespace smtk
+{
+namespace geometry
+{
+namespace
+{
+using BoundingBox = BoundingVolumeHierarchy::BoundingBox;
+
+BoundingBox emptyBox()
+{
+  return { { 1., 0., 1., 0., 1., 0. } };
+}
+
+BoundingBox unite(const BoundingBox& aa, const BoundingBox& bb)
+{
+  return { { std::min(aa[0], bb[0]),
+             std::max(aa[1], bb[1]),
+             std::min(aa[2], bb[2]),
+             std::max(aa[3], bb[3]),
+             std::min(aa[4], bb[4]),
+             std::max(aa[5], bb[5]) } };
+}
+
+double surfaceArea(const BoundingBox& box)
+{
+  double dx = box[1] - box[0];
+  double dy = box[3] - box[2];
+  double dz = box[5] - box[4];
+  return 2. * (dx * dy + dy * dz + dz * dx);
+}
+
+bool overlaps(const BoundingBox& aa, const BoundingBox& bb)
+{
+  return aa[0] <= bb[1] && bb[0] <= aa[1] && aa[2] <= bb[3] && bb[2] <= aa[3] &&
+    aa[4] <= bb[5] && bb[4] <= aa[5];
+}
+
+// Return -1 if \a box is entirely outside some plane, 1 if it is entirely
+// inside all planes, and 0 otherwise.
+int classify(const BoundingBox& box, const std::vector<BoundingVolumeHierarchy::Plane>& planes)
+{
+  int result = 1;
+  for (const auto& plane : planes)
+  {
+    // The corners of the box farthest along and against the plane's normal.
+    double farthest = plane[3];
+    double nearest = plane[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      double lo = plane[axis] * box[2 * axis];
+      double hi = plane[axis] * box[2 * axis + 1];
+      farthest += std::max(lo, hi);
+      nearest += std::min(lo, hi);
+    }
+    if (farthest < 0.)
+    {
+      return -1;
+    }
+    if (nearest < 0.)
+    {
+      result = 0;
+    }
+  }
+  return result;
+}
+
+// A node awaiting examination by a best-first search.
+struct Candidate
+{
+  double m_key;
+  int m_node;
+  bool operator<(const Candidate& other) const { return m_key > other.m_key; }
+};
+} // anonymous namespace
+
+bool BoundingVolumeHierarchy::isEmpty(const BoundingBox& box)
+{
+  return !(box[0] <= box[1] && box[2] <= box[3] && box[4] <= box[5]);
+}
+
+void BoundingVolumeHierarchy::build(
+  const std::vector<std::pair<smtk::common::UUID, BoundingBox>>& entries)
+{
+  this->clear();
+  std::vector<std::pair<smtk::common::UUID, BoundingBox>> valid;
+  valid.reserve(entries.size());
+  for (const auto& entry : entries)
+  {
+    if (
+      !BoundingVolumeHierarchy::isEmpty(entry.second) &&
+      m_leaves.emplace(entry.first, Null).second)
+    {
+      valid.push_back(entry);
+    }
+  }
+  m_nodes.reserve(valid.empty() ? 0 : 2 * valid.size() - 1);
+  m_root = valid.empty() ? Null : this->buildRange(valid, 0, valid.size());
+}
+
+int BoundingVolumeHierarchy::buildRange(
+  std::vector<std::pair<smtk::common::UUID, BoundingBox>>& entries,
+  std::size_t begin,
+  std::size_t end)
+{
+  int index = this->allocate();
+  if (end - begin == 1)
+  {
+    m_nodes[index].m_box = entries[begin].second;
+    m_nodes[index].m_id = entries[begin].first;
+    m_leaves[entries[begin].first] = index;
+    return index;
+  }
+
+  // Split about the median center along the longest axis of the centers' bounds.
+  BoundingBox centers = emptyBox();
+  for (std::size_t ii = begin; ii < end; ++ii)
+  {
+    const auto& box = entries[ii].second;
+    BoundingBox center{ { 0.5 * (box[0] + box[1]),
+                          0.5 * (box[0] + box[1]),
+                          0.5 * (box[2] + box[3]),
+                          0.5 * (box[2] + box[3]),
+                          0.5 * (box[4] + box[5]),
+                          0.5 * (box[4] + box[5]) } };
+    centers = ii == begin ? center : unite(centers, center);
+  }
+  int axis = 0;
+  for (int ii = 1; ii < 3; ++ii)
+  {
+    if (centers[2 * ii + 1] - centers[2 * ii] > centers[2 * axis + 1] - centers[2 * axis])
+    {
+      axis = ii;
+    }
+  }
+  std::size_t middle = begin + (end - begin) / 2;
+  std::nth_element(
+    entries.begin() + begin,
+    entries.begin() + middle,
+    entries.begin() + end,
+    [axis](
+      const std::pair<smtk::common::UUID, BoundingBox>& aa,
+      const std::pair<smtk::common::UUID, BoundingBox>& bb) {
+      return aa.second[2 * axis] + aa.second[2 * axis + 1] <
+        bb.second[2 * axis] + bb.second[2 * axis + 1];
+    });
+  int child1 = this->buildRange(entries, begin, middle);
+  int child2 = this->buildRange(entries, middle, end);
+  // Note that m_nodes may have been reallocated by the recursive calls.
+  Node& node = m_nodes[index];
+  node.m_child1 = child1;
+  node.m_child2 = child2;
+  node.m_box = unite(m_nodes[child1].m_box, m_nodes[child2].m_box);
+  node.m_height = 1 + std::max(m_nodes[child1].m_height, m_nodes[child2].m_height);
+  m_nodes[child1].m_parent = index;
+  m_nodes[child2].m_parent = index;
+  return index;
+}
+
+bool BoundingVolumeHierarchy::update(const smtk::common::UUID& uid, const BoundingBox& box)
+{
+  if (BoundingVolumeHierarchy::isEmpty(box))
+  {
+    return this->erase(uid);
+  }
+  auto it = m_leaves.find(uid);
+  if (it != m_leaves.end())
+  {
+    if (m_nodes[it->second].m_box == box)
+    {
+      return false;
+    }
+    this->removeLeaf(it->second);
+    m_nodes[it->second].m_box = box;
+    this->insertLeaf(it->second);
+    return true;
+  }
+  int leaf = this->allocate();
+  m_nodes[leaf].m_box = box;
+  m_nodes[leaf].m_id = uid;
+  m_leaves[uid] = leaf;
+  this->insertLeaf(leaf);
+  return true;
+}
+
+bool BoundingVolumeHierarchy::erase(const smtk::common::UUID& uid)
+{
+  auto it = m_leaves.find(uid);
+  if (it == m_leaves.end())
+  {
+    return false;
+  }
+  this->removeLeaf(it->second);
+  this->release(it->second);
+  m_leaves.erase(it);
+  return true;
+}
+
+void BoundingVolumeHierarchy::clear()
+{
+  m_nodes.clear();
+  m_leaves.clear();
+  m_root = Null;
+  m_free = Null;
+}
+
+bool BoundingVolumeHierarchy::find(const smtk::common::UUID& uid, BoundingBox& box) const
+{
+  auto it = m_leaves.find(uid);
+  if (it == m_leaves.end())
+  {
+    return false;
+  }
+  box = m_nodes[it->second].m_box;
+  return true;
+}
+
+BoundingVolumeHierarchy::BoundingBox BoundingVolumeHierarchy::bounds() const
+{
+  return m_root == Null ? emptyBox() : m_nodes[m_root].m_box;
+}
+
+std::size_t BoundingVolumeHierarchy::height() const
+{
+  return m_root == Null ? 0 : static_cast<std::size_t>(m_nodes[m_root].m_height) + 1;
+}
+
+smtk::common::Visited BoundingVolumeHierarchy::visitOverlapping(
+  const BoundingBox& box,
+  const Visitor& visitor) const
+{
+  if (m_root == Null || BoundingVolumeHierarchy::isEmpty(box))
+  {
+    return smtk::common::Visited::Empty;
+  }
+  std::vector<int> stack{ m_root };
+  while (!stack.empty())
+  {
+    const Node& node = m_nodes[stack.back()];
+    stack.pop_back();
+    if (!overlaps(node.m_box, box))
+    {
+      continue;
+    }
+    if (node.isLeaf())
+    {
+      if (visitor(node.m_id, node.m_box) == smtk::common::Visit::Halt)
+      {
+        return smtk::common::Visited::Some;
+      }
+    }
+    else
+    {
+      stack.push_back(node.m_child2);
+      stack.push_back(node.m_child1);
+    }
+  }
+  return smtk::common::Visited::All;
+}
+
+smtk::common::Visited BoundingVolumeHierarchy::visitInside(
+  const std::vector<Plane>& planes,
+  const Visitor& visitor) const
+{
+  if (m_root == Null)
+  {
+    return smtk::common::Visited::Empty;
+  }
+  // Each stacked node is paired with whether it is known to be entirely inside.
+  std::vector<std::pair<int, bool>> stack{ { m_root, false } };
+  while (!stack.empty())
+  {
+    const Node& node = m_nodes[stack.back().first];
+    bool inside = stack.back().second;
+    stack.pop_back();
+    if (!inside)
+    {
+      int where = classify(node.m_box, planes);
+      if (where < 0)
+      {
+        continue;
+      }
+      inside = where > 0;
+    }
+    if (node.isLeaf())
+    {
+      if (visitor(node.m_id, node.m_box) == smtk::common::Visit::Halt)
+      {
+        return smtk::common::Visited::Some;
+      }
+    }
+    else
+    {
+      stack.emplace_back(node.m_child2, inside);
+      stack.emplace_back(node.m_child1, inside);
+    }
+  }
+  return smtk::common::Visited::All;
+}
+
+std::pair<smtk::common::UUID, double> BoundingVolumeHierarchy::nearest(
+  const Point& point,
+  const DistanceFunction& distance,
+  double maxDistance) const
+{
+  std::pair<smtk::common::UUID, double> best(smtk::common::UUID::null(), Infinity);
+  if (m_root == Null)
+  {
+    return best;
+  }
+  double limit = maxDistance;
+  std::priority_queue<Candidate> queue;
+  queue.push({ BoundingVolumeHierarchy::distance2(m_nodes[m_root].m_box, point), m_root });
+  while (!queue.empty())
+  {
+    Candidate candidate = queue.top();
+    queue.pop();
+    double bound = std::sqrt(candidate.m_key);
+    if (bound > limit || (best.first && bound >= best.second))
+    {
+      break;
+    }
+    const Node& node = m_nodes[candidate.m_node];
+    if (node.isLeaf())
+    {
+      double dist = distance ? distance(node.m_id, node.m_box) : bound;
+      if (dist <= limit && dist < best.second)
+      {
+        best = std::make_pair(node.m_id, dist);
+        limit = dist;
+      }
+      continue;
+    }
+    for (int child : { node.m_child1, node.m_child2 })
+    {
+      queue.push({ BoundingVolumeHierarchy::distance2(m_nodes[child].m_box, point), child });
+    }
+  }
+  return best;
+}
+
+std::pair<smtk::common::UUID, double> BoundingVolumeHierarchy::raycast(
+  const Point& origin,
+  const Point& direction,
+  const HitFunction& hit,
+  double maxParameter) const
+{
+  std::pair<smtk::common::UUID, double> best(smtk::common::UUID::null(), Infinity);
+  if (m_root == Null)
+  {
+    return best;
+  }
+  double limit = maxParameter;
+  std::priority_queue<Candidate> queue;
+  double rootEntry =
+    BoundingVolumeHierarchy::entry(m_nodes[m_root].m_box, origin, direction, limit);
+  if (rootEntry < Infinity)
+  {
+    queue.push({ rootEntry, m_root });
+  }
+  while (!queue.empty())
+  {
+    Candidate candidate = queue.top();
+    queue.pop();
+    if (candidate.m_key > limit || (best.first && candidate.m_key >= best.second))
+    {
+      break;
+    }
+    const Node& node = m_nodes[candidate.m_node];
+    if (node.isLeaf())
+    {
+      double parameter = hit ? hit(node.m_id, node.m_box, candidate.m_key) : candidate.m_key;
+      if (parameter <= limit && parameter < best.second)
+      {
+        best = std::make_pair(node.m_id, parameter);
+        limit = parameter;
+      }
+      continue;
+    }
+    for (int child : { node.m_child1, node.m_child2 })
+    {
+      double childEntry =
+        BoundingVolumeHierarchy::entry(m_nodes[child].m_box, origin, direction, limit);
+      if (childEntry < Infinity)
+      {
+        queue.push({ childEntry, child });
+      }
+    }
+  }
+  return best;
+}
+
+double BoundingVolumeHierarchy::distance2(const BoundingBox& box, const Point& point)
+{
+  double result = 0.;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    double delta = std::max({ box[2 * axis] - point[axis], point[axis] - box[2 * axis + 1], 0. });
+    result += delta * delta;
+  }
+  return result;
+}
+
+double BoundingVolumeHierarchy::entry(
+  const BoundingBox& box,
+  const Point& origin,
+  const Point& direction,
+  double maxParameter)
+{
+  double near = 0.;
+  double far = maxParameter;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    double lo = box[2 * axis];
+    double hi = box[2 * axis + 1];
+    if (direction[axis] == 0.)
+    {
+      if (origin[axis] < lo || origin[axis] > hi)
+      {
+        return Infinity;
+      }
+      continue;
+    }
+    double t1 = (lo - origin[axis]) / direction[axis];
+    double t2 = (hi - origin[axis]) / direction[axis];
+    if (t1 > t2)
+    {
+      std::swap(t1, t2);
+    }
+    near = std::max(near, t1);
+    far = std::min(far, t2);
+    if (near > far)
+    {
+      return Infinity;
+    }
+  }
+  return near;
+}
+
+int BoundingVolumeHierarchy::allocate()
+{
+  int index;
+  if (m_free != Null)
+  {
+    index = m_free;
+    m_free = m_nodes[index].m_parent;
+    m_nodes[index] = Node();
+  }
+  else
+  {
+    index = static_cast<int>(m_nodes.size());
+    m_nodes.emplace_back();
+  }
+  return index;
+}
+
+void BoundingVolumeHierarchy::release(int index)
+{
+  m_nodes[index].m_parent = m_free;
+  m_nodes[index].m_height = -1;
+  m_free = index;
+}
+
+void BoundingVolumeHierarchy::insertLeaf(int leaf)
+{
+  m_nodes[leaf].m_child1 = Null;
+  m_nodes[leaf].m_child2 = Null;
+  m_nodes[leaf].m_height = 0;
+  if (m_root == Null)
+  {
+    m_root = leaf;
+    m_nodes[leaf].m_parent = Null;
+    return;
+  }
+
+  // Descend to the sibling whose pairing with the leaf least increases the
+  // total surface area of the hierarchy.
+  const BoundingBox box = m_nodes[leaf].m_box;
+  int sibling = m_root;
+  while (!m_nodes[sibling].isLeaf())
+  {
+    const Node& node = m_nodes[sibling];
+    double area = surfaceArea(node.m_box);
+    double combinedArea = surfaceArea(unite(node.m_box, box));
+    // The cost of pairing the leaf with this node...
+    double cost = 2. * combinedArea;
+    // ...and the cost of enlarging this node when descending further.
+    double inheritance = 2. * (combinedArea - area);
+    double childCost[2];
+    int children[2] = { node.m_child1, node.m_child2 };
+    for (int ii = 0; ii < 2; ++ii)
+    {
+      const Node& child = m_nodes[children[ii]];
+      double enlarged = surfaceArea(unite(child.m_box, box));
+      childCost[ii] =
+        inheritance + (child.isLeaf() ? enlarged : enlarged - surfaceArea(child.m_box));
+    }
+    if (cost < childCost[0] && cost < childCost[1])
+    {
+      break;
+    }
+    sibling = childCost[0] < childCost[1] ? children[0] : children[1];
+  }
+
+  int oldParent = m_nodes[sibling].m_parent;
+  int newParent = this->allocate();
+  Node& parent = m_nodes[newParent];
+  parent.m_parent = oldParent;
+  parent.m_box = unite(box, m_nodes[sibling].m_box);
+  parent.m_height = m_nodes[sibling].m_height + 1;
+  parent.m_child1 = sibling;
+  parent.m_child2 = leaf;
+  m_nodes[sibling].m_parent = newParent;
+  m_nodes[leaf].m_parent = newParent;
+  if (oldParent == Null)
+  {
+    m_root = newParent;
+  }
+  else
+  {
+    this->replaceChild(oldParent, sibling, newParent);
+  }
+  this->refit(oldParent == Null ? newParent : oldParent);
+}
+
+void BoundingVolumeHierarchy::removeLeaf(int leaf)
+{
+  if (leaf == m_root)
+  {
+    m_root = Null;
+    return;
+  }
+  int parent = m_nodes[leaf].m_parent;
+  int grandParent = m_nodes[parent].m_parent;
+  int sibling =
+    m_nodes[parent].m_child1 == leaf ? m_nodes[parent].m_child2 : m_nodes[parent].m_child1;
+  m_nodes[sibling].m_parent = grandParent;
+  this->release(parent);
+  if (grandParent == Null)
+  {
+    m_root = sibling;
+    return;
+  }
+  this->replaceChild(grandParent, parent, sibling);
+  this->refit(grandParent);
+}
+
+void BoundingVolumeHierarchy::refit(int index)
+{
+  while (index != Null)
+  {
+    index = this->balance(index);
+    Node& node = m_nodes[index];
+    node.m_box = unite(m_nodes[node.m_child1].m_box, m_nodes[node.m_child2].m_box);
+    node.m_height = 1 + std::max(m_nodes[node.m_child1].m_height, m_nodes[node.m_child2].m_height);
+    index = node.m_parent;
+  }
+}
+
+int BoundingVolumeHierarchy::balance(int index)
+{
+  Node& aa = m_nodes[index];
+  if (aa.isLeaf() || aa.m_height < 2)
+  {
+    return index;
+  }
+  int ib = aa.m_child1;
+  int ic = aa.m_child2;
+  int difference = m_nodes[ic].m_height - m_nodes[ib].m_height;
+  if (difference >= -1 && difference <= 1)
+  {
+    return index;
+  }
+
+  // Rotate the taller child (up) into this node's place; this node adopts
+  // the shorter of the taller child's children.
+  bool rightTaller = difference > 1;
+  int up = rightTaller ? ic : ib;
+  int other = rightTaller ? ib : ic;
+  Node& upper = m_nodes[up];
+  int ff = upper.m_child1;
+  int gg = upper.m_child2;
+  int keep = m_nodes[ff].m_height > m_nodes[gg].m_height ? ff : gg;
+  int give = keep == ff ? gg : ff;
+
+  upper.m_child1 = index;
+  upper.m_parent = aa.m_parent;
+  aa.m_parent = up;
+  if (upper.m_parent == Null)
+  {
+    m_root = up;
+  }
+  else
+  {
+    this->replaceChild(upper.m_parent, index, up);
+  }
+
+  upper.m_child2 = keep;
+  if (rightTaller)
+  {
+    aa.m_child2 = give;
+  }
+  else
+  {
+    aa.m_child1 = give;
+  }
+  m_nodes[give].m_parent = index;
+  aa.m_box = unite(m_nodes[other].m_box, m_nodes[give].m_box);
+  aa.m_height = 1 + std::max(m_nodes[other].m_height, m_nodes[give].m_height);
+  upper.m_box = unite(aa.m_box, m_nodes[keep].m_box);
+  upper.m_height = 1 + std::max(aa.m_height, m_nodes[keep].m_height);
+  return up;
+}
+
+void BoundingVolumeHierarchy::replaceChild(int parent, int oldChild, int newChild)
+{
+  if (m_nodes[parent].m_child1 == oldChild)
+  {
+    m_nodes[parent].m_child1 = newChild;
+  }
+  else
+  {
+    m_nodes[parent].m_child2 = newChild;
+  }
+}
+
+} // namespace geometry
+} // namespace smtk
@@ -0,0 +1,181 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_geometry_BoundingVolumeHierarchy_h
+#define smtk_geometry_BoundingVolumeHierarchy_h
+
+#include "smtk/CoreExports.h"
+
+#include "smtk/common/UUID.h"
+#include "smtk/common/Visit.h"
+
+#include <array>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace smtk
+{
+namespace geometry
+{
+
+/**\brief A dynamic bounding-volume hierarchy of axis-aligned boxes keyed by UUID.
+  *
+  * Boxes are ordered (xmin, xmax, ymin, ymax, zmin, zmax) as in
+  * Geometry::BoundingBox. Boxes whose minimum exceeds their maximum along
+  * any axis are empty and are never inserted.
+  *
+  * The hierarchy may be built in bulk with build(), which partitions boxes
+  * about the median of their centers along the longest axis; it is then
+  * kept balanced as entries are inserted, moved, and erased. Leaves are
+  * inserted next to the sibling that least increases the surface area of
+  * the tree and subtrees are rotated when their heights differ by more
+  * than one, so the tree's height remains logarithmic in its size.
+  *
+  * Queries visit only the subtrees whose bounds may hold a match, so their
+  * cost grows with the logarithm of the number of entries (plus the number
+  * of matches) rather than linearly.
+  */
+class SMTKCORE_EXPORT BoundingVolumeHierarchy
+{
+public:
+  using BoundingBox = std::array<double, 6>;
+  using Point = std::array<double, 3>;
+  /// A plane (a, b, c, d); points with a*x + b*y + c*z + d >= 0 are inside it.
+  using Plane = std::array<double, 4>;
+  /// Called with each matching entry; return Visit::Halt to stop.
+  using Visitor = std::function<smtk::common::Visit(const smtk::common::UUID&, const BoundingBox&)>;
+  /// Compute the exact distance from a query point to an entry (which must be
+  /// no less than the distance to its box), or infinity to ignore it.
+  using DistanceFunction = std::function<double(const smtk::common::UUID&, const BoundingBox&)>;
+  /// Compute the exact ray parameter at which a ray hits an entry (which must
+  /// be no less than \a entry, where the ray enters its box), or infinity for a miss.
+  using HitFunction =
+    std::function<double(const smtk::common::UUID&, const BoundingBox&, double entry)>;
+
+  static constexpr double Infinity = std::numeric_limits<double>::infinity();
+
+  /// Return true if \a box is empty.
+  static bool isEmpty(const BoundingBox& box);
+
+  /// Remove all entries and rebuild the hierarchy from \a entries.
+  void build(const std::vector<std::pair<smtk::common::UUID, BoundingBox>>& entries);
+
+  /// Insert (or move) the entry \a uid so that it has the given \a box.
+  ///
+  /// If \a box is empty, any existing entry is erased. Returns true if the
+  /// hierarchy was modified.
+  bool update(const smtk::common::UUID& uid, const BoundingBox& box);
+
+  /// Erase the entry \a uid. Returns true if it was present.
+  bool erase(const smtk::common::UUID& uid);
+
+  /// Remove all entries.
+  void clear();
+
+  /// Return the number of entries.
+  std::size_t size() const { return m_leaves.size(); }
+  bool empty() const { return m_leaves.empty(); }
+
+  /// Return true if \a uid is present (and if so, set \a box to its bounds).
+  bool find(const smtk::common::UUID& uid, BoundingBox& box) const;
+
+  /// Return the bounds of all entries (which are empty if there are none).
+  BoundingBox bounds() const;
+
+  /// Return the number of nodes on the longest path from the root to a leaf.
+  std::size_t height() const;
+
+  /// Visit entries whose boxes intersect \a box.
+  smtk::common::Visited visitOverlapping(const BoundingBox& box, const Visitor& visitor) const;
+
+  /// Visit entries whose boxes may intersect the convex region inside all \a planes.
+  ///
+  /// A box is reported unless it lies entirely outside one of the planes, so
+  /// boxes near the edges of the region (but outside it) may be reported.
+  /// Use the six planes of a view frustum to select entries a camera may see.
+  smtk::common::Visited visitInside(const std::vector<Plane>& planes, const Visitor& visitor) const;
+
+  /**\brief Return the entry nearest \a point and its distance.
+    *
+    * Entries are examined in order of increasing distance to their boxes
+    * and the search ends once no box is nearer than the best entry found.
+    * Distances are measured to entries' boxes unless a \a distance function
+    * is provided. Entries farther than \a maxDistance are ignored. If no
+    * entry is found, the returned UUID is null and the distance is infinite.
+    */
+  std::pair<smtk::common::UUID, double> nearest(
+    const Point& point,
+    const DistanceFunction& distance = nullptr,
+    double maxDistance = Infinity) const;
+
+  /**\brief Return the first entry hit by a ray and the ray parameter of the hit.
+    *
+    * The ray is \a origin + t * \a direction for t in [0, \a maxParameter].
+    * Entries are examined in the order the ray enters their boxes and the
+    * search ends once no box is entered before the best hit found. Hits are
+    * reported where the ray enters an entry's box unless a \a hit function
+    * is provided. If nothing is hit, the returned UUID is null and the
+    * parameter is infinite.
+    */
+  std::pair<smtk::common::UUID, double> raycast(
+    const Point& origin,
+    const Point& direction,
+    const HitFunction& hit = nullptr,
+    double maxParameter = Infinity) const;
+
+  /// Return the squared distance from \a point to \a box.
+  static double distance2(const BoundingBox& box, const Point& point);
+
+  /// Return the ray parameter at which the ray enters \a box (or infinity
+  /// if it misses the box or only reaches it beyond \a maxParameter).
+  static double
+  entry(const BoundingBox& box, const Point& origin, const Point& direction, double maxParameter);
+
+private:
+  static constexpr int Null = -1;
+
+  struct Node
+  {
+    BoundingBox m_box;
+    int m_parent{ Null };
+    int m_child1{ Null };
+    int m_child2{ Null };
+    // Leaves have height 0; free nodes have height -1.
+    int m_height{ 0 };
+    smtk::common::UUID m_id;
+
+    bool isLeaf() const { return m_child1 == Null; }
+  };
+
+  int allocate();
+  void release(int index);
+  int buildRange(
+    std::vector<std::pair<smtk::common::UUID, BoundingBox>>& entries,
+    std::size_t begin,
+    std::size_t end);
+  void insertLeaf(int leaf);
+  void removeLeaf(int leaf);
+  // Refit the bounds and heights of \a index and its ancestors, rebalancing each.
+  void refit(int index);
+  int balance(int index);
+  void replaceChild(int parent, int oldChild, int newChild);
+
+  std::vector<Node> m_nodes;
+  int m_root{ Null };
+  int m_free{ Null };
+  std::unordered_map<smtk::common::UUID, int> m_leaves;
+};
+
+} // namespace geometry
+} // namespace smtk
+
+#endif // smtk_geometry_BoundingVolumeHierarchy_h
@@ -10,12 +10,16 @@
 #ifndef smtk_geometry_Cache_h
 #define smtk_geometry_Cache_h
 
+#include "smtk/geometry/CacheBudget.h"
 #include "smtk/geometry/GeometryForBackend.h"
 #include "smtk/geometry/Resource.h"
 
 #include "smtk/resource/CopyOptions.h"
 
+#include <chrono>
+#include <cstdio>
 #include <map>
+#include <string>
 
 namespace smtk
 {
@@ -35,6 +39,16 @@ namespace geometry
   *     + geometricBounds(const DataType&, BoundingBox&) — obtain bounds
   *       from cached geometry
   *
+  * When the provider has been assigned a CacheBudget, each entry
+  * generated is reported to the budget along with its dataSize() and
+  * the time queryGeometry() took to produce it. The budget may later
+  * evict() the entry. Its geometry is released only if the cache holds
+  * the last reference to it (see isShared()); expensive geometry is
+  * spilled to disk with writeSpill() first. Either way, the entry is
+  * marked so that isEvicted() returns true and consumers can drop it.
+  * The next request for the geometry regenerates it with queryGeometry()
+  * (which increments its generation number) or restores it with
+  * readSpill() (which does not).
   */
 template<typename BaseClass>
 class Cache : public BaseClass
@@ -52,11 +66,25 @@ public:
   static constexpr GenerationNumber Invalid = Geometry::Invalid;
   static constexpr GenerationNumber Initial = Geometry::Initial;
 
+  ~Cache() override
+  {
+    if (auto budget = this->m_cacheBudget.lock())
+    {
+      budget->remove(*this);
+    }
+    for (const auto& spill : m_spilled)
+    {
+      std::remove(spill.second.c_str());
+    }
+  }
+
   /// The values held by the geometry cache.
   struct CacheEntry
   {
     GenerationNumber m_generation; //!< A generation number or Invalid.
     DataType m_geometry;           //!< Geometry held by the cache.
+    double m_cost{ 0. };           //!< Seconds taken to generate m_geometry.
+    bool m_evicted{ false };       //!< True once the budget has asked to evict m_geometry.
 
     CacheEntry()
       : m_generation(Invalid)
@@ -115,11 +143,12 @@ public:
       bool found = it != m_cache.end();
       if (found && it->second.m_geometry)
       { // Cache is clean.
+        this->accessed(obj, it->second);
         return it->second.m_generation;
       }
       else if (found)
       { // Cache was marked dirty.
-        this->queryGeometry(obj, it->second);
+        this->refresh(obj, it->second);
         if (!it->second.isValid())
         {
           m_cache.erase(it);
@@ -132,7 +161,7 @@ public:
       else
       { // No cache entry yet; try to add one.
         CacheEntry entry;
-        this->queryGeometry(obj, entry);
+        this->refresh(obj, entry);
         if (entry.isValid())
         {
           m_cache[obj->id()] = entry;
@@ -152,12 +181,13 @@ public:
       bool found = it != m_cache.end();
       if (found && it->second.m_geometry)
       { // Cache is clean:
+        this->accessed(obj, it->second);
         this->geometricBounds(it->second.m_geometry, bds);
         return;
       }
       else if (found)
       { // Cache was marked dirty. Update it:
-        this->queryGeometry(obj, it->second);
+        this->refresh(obj, it->second);
         if (it->second.isValid())
         {
           this->geometricBounds(it->second.m_geometry, bds);
@@ -171,7 +201,7 @@ public:
       else
       {
         CacheEntry entry;
-        this->queryGeometry(obj, entry);
+        this->refresh(obj, entry);
         if (entry.isValid())
         {
           m_cache[obj->id()] = entry;
@@ -194,11 +224,12 @@ public:
       bool found = it != m_cache.end();
       if (found && it->second.m_geometry)
       { // Cache is clean.
+        this->accessed(obj, it->second);
         return it->second.m_geometry;
       }
       else if (found)
       { // Cache was marked dirty. Update it:
-        this->queryGeometry(obj, it->second);
+        this->refresh(obj, it->second);
         if (it->second.isValid())
         {
           return it->second.m_geometry;
@@ -211,7 +242,7 @@ public:
       else
       { // No cache existed. See if we can create an entry:
         CacheEntry entry;
-        this->queryGeometry(obj, entry);
+        this->refresh(obj, entry);
         if (entry.isValid())
         {
           m_cache[obj->id()] = entry;
@@ -313,6 +344,8 @@ public:
       {
         DataType blank; // Assume default constructor creates "null" data.
         it->second.m_geometry = blank;
+        it->second.m_evicted = false;
+        this->discard(obj->id());
       }
       else
       {
@@ -329,10 +362,144 @@ public:
   /// In this case, not only is the geometry freed, but the cache entry
   /// is also removed so that visitation will no longer query the resource
   /// for geometry with the given UUID.
-  bool erase(const smtk::common::UUID& uid) override { return m_cache.erase(uid) > 0; }
+  bool erase(const smtk::common::UUID& uid) override
+  {
+    this->discard(uid);
+    return m_cache.erase(uid) > 0;
+  }
+
+  /// Release an entry's geometry so that the next request regenerates (or restores) it.
+  ///
+  /// This is called by the CacheBudget when cached geometry exceeds its budget.
+  /// The entry is marked as evicted (see isEvicted()) whether or not its geometry
+  /// is released. If the geometry isShared(), releasing it would free no memory,
+  /// so it is kept (and false is returned) until consumers drop their references.
+  /// Otherwise, the geometry is written to \a spillFilename first (if it is
+  /// non-empty and writeSpill() succeeds) and read back instead of being regenerated.
+  bool evict(const smtk::common::UUID& uid, std::string& spillFilename) const override
+  {
+    auto it = m_cache.find(uid);
+    if (it == m_cache.end() || !it->second.m_geometry)
+    {
+      spillFilename.clear();
+      return false;
+    }
+    it->second.m_evicted = true;
+    if (this->isShared(it->second.m_geometry))
+    {
+      spillFilename.clear();
+      return false;
+    }
+    if (!spillFilename.empty())
+    {
+      if (this->writeSpill(it->second.m_geometry, spillFilename))
+      {
+        m_spilled[uid] = spillFilename;
+      }
+      else
+      {
+        spillFilename.clear();
+      }
+    }
+    DataType blank; // Assume default constructor creates "null" data.
+    it->second.m_geometry = blank;
+    return true;
+  }
+
+  /// Return true if the budget has evicted (or asked to evict) the geometry of \a obj.
+  ///
+  /// This does not generate geometry; requesting the geometry (or marking it
+  /// modified) clears the flag.
+  bool isEvicted(const smtk::resource::PersistentObject::Ptr& obj) const override
+  {
+    if (!obj)
+    {
+      return false;
+    }
+    auto it = m_cache.find(obj->id());
+    return it != m_cache.end() && it->second.m_evicted;
+  }
 
 protected:
+  /// Update a dirty or missing cache \a entry for \a obj.
+  ///
+  /// Geometry previously spilled to disk is read back (keeping the entry's
+  /// generation number); otherwise queryGeometry() is invoked and timed.
+  /// Valid entries are then reported to the cache budget (if any).
+  /// Subclasses that update entries outside of the methods above should
+  /// call this rather than queryGeometry().
+  void refresh(const smtk::resource::PersistentObject::Ptr& obj, CacheEntry& entry) const
+  {
+    bool restored = false;
+    auto spill = m_spilled.find(obj->id());
+    if (spill != m_spilled.end())
+    {
+      restored = entry.isValid() && this->readSpill(spill->second, entry.m_geometry);
+      std::remove(spill->second.c_str());
+      m_spilled.erase(spill);
+    }
+    if (!restored)
+    {
+      auto start = std::chrono::steady_clock::now();
+      this->queryGeometry(obj, entry);
+      entry.m_cost =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    entry.m_evicted = false;
+    auto budget = this->m_cacheBudget.lock();
+    if (budget && entry.isValid() && entry.m_geometry)
+    {
+      budget->insert(
+        *this,
+        this->budgetResourceId(),
+        obj->id(),
+        this->dataSize(entry.m_geometry),
+        entry.m_cost,
+        restored);
+    }
+  }
+
   mutable std::map<smtk::common::UUID, CacheEntry> m_cache;
+  /// Files holding geometry evicted from m_cache (indexed by object ID).
+  mutable std::map<smtk::common::UUID, std::string> m_spilled;
+
+private:
+  // Report a request answered by an existing (clean) cache entry to the budget.
+  // Geometry that was still shared when the budget tried to evict it is in use again.
+  void accessed(const smtk::resource::PersistentObject::Ptr& obj, CacheEntry& entry) const
+  {
+    entry.m_evicted = false;
+    if (auto budget = this->m_cacheBudget.lock())
+    {
+      auto resourceId = this->budgetResourceId();
+      if (!budget->hit(*this, resourceId, obj->id()))
+      {
+        budget->insert(
+          *this, resourceId, obj->id(), this->dataSize(entry.m_geometry), entry.m_cost);
+      }
+    }
+  }
+
+  // Stop accounting for (and discard any spilled copy of) the geometry for \a uid.
+  void discard(const smtk::common::UUID& uid) const
+  {
+    if (auto budget = this->m_cacheBudget.lock())
+    {
+      budget->remove(*this, uid);
+    }
+    auto spill = m_spilled.find(uid);
+    if (spill != m_spilled.end())
+    {
+      std::remove(spill->second.c_str());
+      m_spilled.erase(spill);
+    }
+  }
+
+  smtk::common::UUID budgetResourceId() const
+  {
+    auto rsrc = this->resource();
+    return rsrc ? rsrc->id() : smtk::common::UUID::null();
+  }
 };
 
 } // namespace geometry
@@ -0,0 +1,234 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/geometry/CacheBudget.h"
+
+#include "smtk/geometry/Geometry.h"
+
+#include "smtk/common/Paths.h"
+
+namespace smtk
+{
+namespace geometry
+{
+
+CacheBudget::~CacheBudget() = default;
+
+void CacheBudget::setMemoryBudget(std::size_t bytes)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_memoryBudget = bytes;
+  this->enforceBudget(nullptr);
+}
+
+std::size_t CacheBudget::memoryBudget() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memoryBudget;
+}
+
+void CacheBudget::enforce()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  this->enforceBudget(nullptr);
+}
+
+std::size_t CacheBudget::memoryInUse() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memoryInUse;
+}
+
+void CacheBudget::setSpillDirectory(const std::string& directory)
+{
+  if (!directory.empty())
+  {
+    smtk::common::Paths::createDirectory(directory);
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_spillDirectory = directory;
+}
+
+std::string CacheBudget::spillDirectory() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_spillDirectory;
+}
+
+void CacheBudget::setSpillThreshold(double seconds)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_spillThreshold = seconds;
+}
+
+double CacheBudget::spillThreshold() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_spillThreshold;
+}
+
+CacheBudget::Statistics CacheBudget::statistics(const smtk::common::UUID& resourceId) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_statistics.find(resourceId);
+  return it == m_statistics.end() ? Statistics() : it->second;
+}
+
+CacheBudget::Statistics CacheBudget::statistics() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Statistics total;
+  for (const auto& entry : m_statistics)
+  {
+    total.hits += entry.second.hits;
+    total.misses += entry.second.misses;
+    total.evictions += entry.second.evictions;
+    total.spills += entry.second.spills;
+    total.restores += entry.second.restores;
+    total.entries += entry.second.entries;
+    total.bytes += entry.second.bytes;
+  }
+  return total;
+}
+
+void CacheBudget::resetStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& entry : m_statistics)
+  {
+    Statistics reset;
+    reset.entries = entry.second.entries;
+    reset.bytes = entry.second.bytes;
+    entry.second = reset;
+  }
+}
+
+void CacheBudget::insert(
+  const Geometry& cache,
+  const smtk::common::UUID& resourceId,
+  const smtk::common::UUID& uid,
+  std::size_t bytes,
+  double seconds,
+  bool restored)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Key key(&cache, uid);
+  auto it = m_index.find(key);
+  if (it != m_index.end())
+  {
+    this->erase(it->second);
+  }
+  m_entries.push_front(Entry{ key, resourceId, bytes, seconds });
+  m_index[key] = m_entries.begin();
+  m_memoryInUse += bytes;
+
+  auto& stats = m_statistics[resourceId];
+  ++stats.misses;
+  ++stats.entries;
+  stats.bytes += bytes;
+  if (restored)
+  {
+    ++stats.restores;
+  }
+
+  this->enforceBudget(&key);
+}
+
+bool CacheBudget::hit(
+  const Geometry& cache,
+  const smtk::common::UUID& resourceId,
+  const smtk::common::UUID& uid)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_index.find(Key(&cache, uid));
+  if (it == m_index.end())
+  {
+    return false;
+  }
+  ++m_statistics[resourceId].hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return true;
+}
+
+void CacheBudget::remove(const Geometry& cache, const smtk::common::UUID& uid)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_index.find(Key(&cache, uid));
+  if (it != m_index.end())
+  {
+    this->erase(it->second);
+  }
+}
+
+void CacheBudget::remove(const Geometry& cache)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto begin = m_index.lower_bound(Key(&cache, smtk::common::UUID::null()));
+  auto it = begin;
+  while (it != m_index.end() && it->first.first == &cache)
+  {
+    auto entry = it->second;
+    ++it;
+    this->erase(entry);
+  }
+}
+
+void CacheBudget::enforceBudget(const Key* keep)
+{
+  if (m_memoryBudget == 0)
+  {
+    return;
+  }
+  // Bytes held by entries whose geometry is still referenced outside their
+  // cache. Such entries are marked for eviction (so consumers drop them) but
+  // remain counted; they are released by a later pass once they are unused.
+  std::size_t pending = 0;
+  auto it = m_entries.end();
+  while (m_memoryInUse > m_memoryBudget + pending && it != m_entries.begin())
+  {
+    --it;
+    if (keep && it->key == *keep)
+    {
+      continue;
+    }
+    const Geometry* cache = it->key.first;
+    std::string spillFilename;
+    if (!m_spillDirectory.empty() && it->seconds >= m_spillThreshold)
+    {
+      spillFilename = m_spillDirectory + "/" + it->resourceId.toString() + "-" +
+        it->key.second.toString() + "-" + cache->backend().name();
+    }
+    if (!cache->evict(it->key.second, spillFilename))
+    {
+      pending += it->bytes;
+      continue;
+    }
+    auto& stats = m_statistics[it->resourceId];
+    ++stats.evictions;
+    if (!spillFilename.empty())
+    {
+      ++stats.spills;
+    }
+    auto victim = it++;
+    this->erase(victim);
+  }
+}
+
+void CacheBudget::erase(EntryList::iterator it)
+{
+  auto& stats = m_statistics[it->resourceId];
+  --stats.entries;
+  stats.bytes -= it->bytes;
+  m_memoryInUse -= it->bytes;
+  m_index.erase(it->key);
+  m_entries.erase(it);
+}
+
+} // namespace geometry
+} // namespace smtk
@@ -0,0 +1,186 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_geometry_CacheBudget_h
+#define smtk_geometry_CacheBudget_h
+
+#include "smtk/CoreExports.h"
+#include "smtk/PublicPointerDefs.h"
+#include "smtk/SharedFromThis.h"
+
+#include "smtk/common/UUID.h"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace smtk
+{
+namespace geometry
+{
+
+class Geometry;
+
+/**\brief Limit the memory held by geometry caches across resources and backends.
+  *
+  * Geometry providers that inherit smtk::geometry::Cache report each
+  * entry they generate (along with its size in bytes and the time taken
+  * to generate it) and each access to an existing entry. When the bytes
+  * reported exceed the budget, the least-recently-used entries are
+  * evicted. Eviction marks the entry so that consumers stop using it
+  * (see Geometry::isEvicted()), but its memory is only counted as freed
+  * once the cache holds the last reference to it; until then, the entry
+  * remains counted (and only as many entries as needed to cover the
+  * excess are marked) and it is evicted again by a later enforce(). The next
+  * request for evicted geometry regenerates it via queryGeometry(),
+  * which assigns it a new generation number.
+  *
+  * If a spill directory is set, evicted entries that took at least
+  * spillThreshold() seconds to generate are first written to that
+  * directory (when the provider supports it) and are read back instead
+  * of being regenerated.
+  *
+  * The budget also records per-resource statistics on cache hits,
+  * misses, evictions and the bytes held.
+  *
+  * The geometry manager owns a budget and assigns it to the geometry
+  * providers of every resource it observes. Methods of this class are
+  * thread-safe, but eviction modifies the caches of other providers, so
+  * (as with rendering in general) providers sharing a budget should be
+  * queried from a single thread.
+  */
+class SMTKCORE_EXPORT CacheBudget : smtkEnableSharedPtr(CacheBudget)
+{
+public:
+  smtkTypedefs(smtk::geometry::CacheBudget);
+  smtkCreateMacro(CacheBudget);
+
+  virtual ~CacheBudget();
+
+  /// Counters describing the cache activity of a resource (or of all resources).
+  struct Statistics
+  {
+    /// The number of requests answered with geometry already in a cache.
+    std::size_t hits{ 0 };
+    /// The number of requests that generated (or restored) geometry.
+    std::size_t misses{ 0 };
+    /// The number of entries evicted to stay within the budget.
+    std::size_t evictions{ 0 };
+    /// The number of evicted entries written to the spill directory.
+    std::size_t spills{ 0 };
+    /// The number of entries read back from the spill directory.
+    std::size_t restores{ 0 };
+    /// The number of entries currently counted against the budget.
+    std::size_t entries{ 0 };
+    /// The number of bytes currently counted against the budget.
+    std::size_t bytes{ 0 };
+  };
+
+  /// Set/get the number of bytes that cached geometry may occupy.
+  ///
+  /// A budget of 0 (the default) imposes no limit.
+  /// Reducing the budget evicts entries immediately.
+  void setMemoryBudget(std::size_t bytes);
+  std::size_t memoryBudget() const;
+
+  /// Return the number of bytes of cached geometry currently counted against the budget.
+  std::size_t memoryInUse() const;
+
+  /// Evict least-recently-used entries until the memory in use is within budget.
+  ///
+  /// This happens automatically as geometry is generated. Consumers that
+  /// release references to evicted geometry should call this afterward so
+  /// that the memory they freed is accounted for.
+  void enforce();
+
+  /// Set/get a directory where expensive-to-regenerate entries are written when evicted.
+  ///
+  /// An empty directory (the default) disables spilling.
+  /// The directory is created if it does not exist.
+  void setSpillDirectory(const std::string& directory);
+  std::string spillDirectory() const;
+
+  /// Set/get the minimum time (in seconds) an entry must have taken to
+  /// generate for it to be spilled rather than discarded when evicted.
+  void setSpillThreshold(double seconds);
+  double spillThreshold() const;
+
+  /// Return the statistics of caches providing geometry for \a resourceId.
+  Statistics statistics(const smtk::common::UUID& resourceId) const;
+  /// Return the statistics of all caches using this budget.
+  Statistics statistics() const;
+  /// Reset the hit, miss, eviction, spill and restore counters (but not the bytes held).
+  void resetStatistics();
+
+  ///@name Methods called by geometry caches
+  ///@{
+  /// Record that \a cache generated (or restored) geometry for \a uid.
+  ///
+  /// The entry occupies \a bytes and took \a seconds to generate.
+  /// This may evict other entries (but never this one).
+  void insert(
+    const Geometry& cache,
+    const smtk::common::UUID& resourceId,
+    const smtk::common::UUID& uid,
+    std::size_t bytes,
+    double seconds,
+    bool restored = false);
+
+  /// Record that \a cache answered a request for \a uid with existing geometry.
+  ///
+  /// Returns false (without counting a hit) if the entry is not known to the
+  /// budget, in which case the cache should insert() it. This happens when a
+  /// cache generates geometry before being assigned a budget.
+  bool hit(
+    const Geometry& cache,
+    const smtk::common::UUID& resourceId,
+    const smtk::common::UUID& uid);
+
+  /// Stop counting the entry \a uid of \a cache (because it was modified or erased).
+  void remove(const Geometry& cache, const smtk::common::UUID& uid);
+  /// Stop counting every entry of \a cache (because it is being destroyed).
+  void remove(const Geometry& cache);
+  ///@}
+
+protected:
+  CacheBudget() = default;
+
+private:
+  using Key = std::pair<const Geometry*, smtk::common::UUID>;
+  struct Entry
+  {
+    Key key;
+    smtk::common::UUID resourceId;
+    std::size_t bytes;
+    double seconds;
+  };
+  using EntryList = std::list<Entry>;
+
+  // Evict least-recently-used entries (other than \a keep) until within budget,
+  // skipping entries whose geometry is still in use. The caller must hold m_mutex.
+  void enforceBudget(const Key* keep);
+  void erase(EntryList::iterator it);
+
+  mutable std::mutex m_mutex;
+  EntryList m_entries; // Most-recently used at the front.
+  std::map<Key, EntryList::iterator> m_index;
+  std::map<smtk::common::UUID, Statistics> m_statistics;
+  std::size_t m_memoryBudget{ 0 };
+  std::size_t m_memoryInUse{ 0 };
+  std::string m_spillDirectory;
+  double m_spillThreshold{ 0.1 };
+};
+
+} // namespace geometry
+} // namespace smtk
+
+#endif // smtk_geometry_CacheBudget_h
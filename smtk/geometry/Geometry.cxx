@@ -8,6 +8,7 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //=========================================================================
 #include "smtk/geometry/Geometry.h"
+#include "smtk/geometry/CacheBudget.h"
 
 #include "smtk/resource/CopyOptions.h"
 
@@ -22,5 +23,19 @@ bool Geometry::copyGeometry(const UniquePtr& sourceGeometry, smtk::resource::Cop
   return !options.copyGeometry();
 }
 
+void Geometry::setCacheBudget(const std::shared_ptr<CacheBudget>& budget)
+{
+  auto previous = m_cacheBudget.lock();
+  if (previous == budget)
+  {
+    return;
+  }
+  if (previous)
+  {
+    previous->remove(*this);
+  }
+  m_cacheBudget = budget;
+}
+
 } // namespace geometry
 } // namespace smtk
@@ -16,6 +16,9 @@
 #include <array>
 #include <atomic>
 #include <limits>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace smtk
 {
@@ -26,6 +29,8 @@ class CopyOptions;
 namespace geometry
 {
 
+class CacheBudget;
+
 /**\brief A base class for objects which can provide renderable geometry.
   *
   * Resources which have renderable data should provide access
@@ -80,6 +85,10 @@ public:
   /// A bounding box is represented as an array of 6 numbers,
   /// ordered xmin, xmax, ymin, ymax, zmin, zmax.
   using BoundingBox = std::array<double, 6>;
+  /// A point or direction in space.
+  using Point = std::array<double, 3>;
+  /// A plane (a, b, c, d); points with a*x + b*y + c*z + d >= 0 are inside it.
+  using Plane = std::array<double, 4>;
 
   /// The signature of functions used to visit all objects with tessellation data.
   using Visitor = std::function<bool(const resource::PersistentObject::Ptr&, GenerationNumber)>;
@@ -138,6 +147,46 @@ public:
   virtual void visit(Visitor fn) const = 0;
   ///@}
 
+  ///@name Spatial refinement
+  ///@{
+  /// These methods are used by spatial queries (see SpatialIndex) to test
+  /// candidates whose bounds match against their actual geometry. The default
+  /// implementations accept every candidate as its bounds are matched.
+
+  /// Return the ray parameter t at which origin + t * direction first hits
+  /// the object's geometry, or infinity if it is not hit in [entry, maxParameter].
+  ///
+  /// The ray enters the object's bounds at \a entry, so a hit is never earlier.
+  virtual double raycast(
+    const resource::PersistentObject::Ptr& obj,
+    const Point& origin,
+    const Point& direction,
+    double entry,
+    double maxParameter) const
+  {
+    (void)obj;
+    (void)origin;
+    (void)direction;
+    (void)maxParameter;
+    return entry;
+  }
+  /// Return true if the object's geometry intersects \a box (which overlaps its bounds).
+  virtual bool overlaps(const resource::PersistentObject::Ptr& obj, const BoundingBox& box) const
+  {
+    (void)obj;
+    (void)box;
+    return true;
+  }
+  /// Return true unless the object's geometry lies entirely outside one of \a planes.
+  virtual bool inside(const resource::PersistentObject::Ptr& obj, const std::vector<Plane>& planes)
+    const
+  {
+    (void)obj;
+    (void)planes;
+    return true;
+  }
+  ///@}
+
   ///@name Modfication methods
   ///@{
   /// These methods are typically invoked by operations
@@ -177,8 +226,50 @@ public:
   virtual bool copyGeometry(const UniquePtr& sourceGeometry, smtk::resource::CopyOptions& options);
   ///@}
 
+  ///@name Memory management
+  ///@{
+  /// Methods that limit the memory held by cached geometry.
+
+  /// Set/get the budget this provider reports its cached geometry to.
+  ///
+  /// The geometry manager assigns its budget to every provider it creates.
+  /// Providers that do not cache geometry may ignore the budget.
+  void setCacheBudget(const std::shared_ptr<CacheBudget>& budget);
+  std::shared_ptr<CacheBudget> cacheBudget() const { return m_cacheBudget.lock(); }
+
+  /// Release the cached geometry for \a uid so the budget can be met.
+  ///
+  /// If \a spillFilename is non-empty, the provider should first write the
+  /// geometry to that file so it can be restored rather than regenerated;
+  /// providers that do not (or cannot) must clear \a spillFilename.
+  /// Return true only if releasing the geometry freed its memory; geometry
+  /// still referenced elsewhere should be kept (and false returned) so
+  /// that the budget continues to count it.
+  ///
+  /// The default implementation releases nothing.
+  virtual bool evict(const smtk::common::UUID& uid, std::string& spillFilename) const
+  {
+    (void)uid;
+    spillFilename.clear();
+    return false;
+  }
+
+  /// Return true if the geometry for \a obj has been evicted to meet the budget.
+  ///
+  /// Consumers that hold on to geometry (such as rendering pipelines) should
+  /// skip evicted objects and release their own references to them rather
+  /// than ask for their data, which would regenerate the geometry and undo
+  /// the eviction. The default implementation never evicts geometry.
+  virtual bool isEvicted(const smtk::resource::PersistentObject::Ptr& obj) const
+  {
+    (void)obj;
+    return false;
+  }
+  ///@}
+
 protected:
   std::atomic<GenerationNumber> m_lastModified;
+  std::weak_ptr<CacheBudget> m_cacheBudget;
 };
 
 } // namespace geometry
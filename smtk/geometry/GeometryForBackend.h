@@ -52,6 +52,47 @@ public:
   ///
   /// Only call this method after ensuring that generationNumber(obj) != Invalid.
   virtual Format& data(const resource::PersistentObject::Ptr&) const = 0;
+
+  /// Return the number of bytes of memory held by \a data.
+  ///
+  /// This is used to account for cached geometry against a CacheBudget.
+  /// The default implementation returns 0, so geometry is never evicted.
+  virtual std::size_t dataSize(const Format& data) const
+  {
+    (void)data;
+    return 0;
+  }
+
+  /// Return true if \a data is referenced outside of the cache.
+  ///
+  /// Evicting shared data would not free its memory, so a CacheBudget
+  /// continues to count it until this returns false.
+  /// The default implementation assumes data is never shared.
+  virtual bool isShared(const Format& data) const
+  {
+    (void)data;
+    return false;
+  }
+
+  /// Write \a data to \a filename so it can be restored after being evicted.
+  ///
+  /// Return true on success. The default implementation does not support spilling.
+  virtual bool writeSpill(const Format& data, const std::string& filename) const
+  {
+    (void)data;
+    (void)filename;
+    return false;
+  }
+
+  /// Read \a data previously written to \a filename by writeSpill().
+  ///
+  /// Return true on success.
+  virtual bool readSpill(const std::string& filename, Format& data) const
+  {
+    (void)filename;
+    (void)data;
+    return false;
+  }
 };
 
 } // namespace geometry
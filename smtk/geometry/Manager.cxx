@@ -56,9 +56,12 @@ void Manager::registerResourceManager(const smtk::resource::Manager::Ptr& manage
           // each backend that is possible.
           // Whether this is possible depends on which plugins
           // have been loaded at the time the resource is added.
-          this->visitBackends([&geomResource](const Backend& backend) {
+          this->visitBackends([this, &geomResource](const Backend& backend) {
             const auto& geom = geomResource->geometry(backend);
-            (void)geom;
+            if (geom)
+            {
+              geom->setCacheBudget(m_cacheBudget);
+            }
           });
         }
       },
@@ -77,10 +80,14 @@ void Manager::constructGeometry(
     return;
   }
 
-  resourceManager->visit([&backend](smtk::resource::Resource& resource) {
+  resourceManager->visit([this, &backend](smtk::resource::Resource& resource) {
     if (auto* geomResource = dynamic_cast<smtk::geometry::Resource*>(&resource))
     {
-      geomResource->geometry(backend);
+      const auto& geom = geomResource->geometry(backend);
+      if (geom)
+      {
+        geom->setCacheBudget(m_cacheBudget);
+      }
     }
     return common::Processing::CONTINUE;
   });
@@ -11,6 +11,7 @@
 #define smtk_geometry_Manager_h
 
 #include "smtk/geometry/Backend.h"
+#include "smtk/geometry/CacheBudget.h"
 #include "smtk/geometry/Resource.h"
 
 #include "smtk/resource/Manager.h"
@@ -43,7 +44,9 @@ namespace geometry
   *
   * Unlike other SMTK managers, this manager does not own or track instances
   * of Geometry objects; those objects have their lifetime tied to the life of
-  * the resource which owns them.
+  * the resource which owns them. However, the manager does own a CacheBudget
+  * that it assigns to each Geometry object it creates so that the memory held
+  * by cached geometry across all resources and backends may be limited.
   */
 class SMTKCORE_EXPORT Manager : smtkEnableSharedPtr(Manager)
 {
@@ -90,6 +93,9 @@ public:
   /// Watch the given resource manager and add geometry objects to its resources as possible.
   void registerResourceManager(const smtk::resource::Manager::Ptr& manager);
 
+  /// Return the budget shared by geometry providers of all resources and backends.
+  const CacheBudget::Ptr& cacheBudget() const { return m_cacheBudget; }
+
 protected:
   /// For any resources in \a resourceManager, attempt to construct geometry for \a backend.
   void constructGeometry(
@@ -105,6 +111,8 @@ private:
   smtk::resource::Observers::Key m_resourceObserverKey;
   /// A collection of backend flavors that geometry providers may come in.
   std::map<Backend::index_t, std::shared_ptr<Backend>> m_backends;
+  /// The memory budget assigned to geometry providers.
+  CacheBudget::Ptr m_cacheBudget = CacheBudget::create();
 };
 
 } // namespace geometry
@@ -20,6 +20,9 @@
 #include "smtk/geometry/Generator.h"
 #include "smtk/geometry/Geometry.h"
 #include "smtk/geometry/Manager.h"
+#include "smtk/geometry/queries/NearestComponent.h"
+#include "smtk/geometry/queries/OverlappingComponents.h"
+#include "smtk/geometry/queries/RayHit.h"
 
 #include "smtk/resource/CopyOptions.h"
 
@@ -28,19 +31,27 @@ namespace smtk
 namespace geometry
 {
 
+namespace
+{
+using QueryList = std::tuple<NearestComponent, OverlappingComponents, RayHit>;
+}
+
 Resource::Resource(const smtk::common::UUID& myID, resource::ManagerPtr manager)
   : DirectSuperclass(myID, manager)
 {
+  this->queries().registerQueries<QueryList>();
 }
 
 Resource::Resource(const smtk::common::UUID& myID)
   : DirectSuperclass(myID)
 {
+  this->queries().registerQueries<QueryList>();
 }
 
 Resource::Resource(resource::ManagerPtr manager)
   : DirectSuperclass(manager)
 {
+  this->queries().registerQueries<QueryList>();
 }
 
 Resource::~Resource() = default;
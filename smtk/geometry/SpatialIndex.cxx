@@ -0,0 +1,250 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/geometry/SpatialIndex.h"
+
+#include "smtk/geometry/Resource.h"
+
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/ComponentItem.h"
+
+#include "smtk/resource/Component.h"
+
+namespace smtk
+{
+namespace geometry
+{
+
+void SpatialIndex::visit(const Geometry& geometry, const Visitor& visitor)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  this->update(geometry);
+  visitor(m_hierarchy, geometry);
+}
+
+bool SpatialIndex::visit(const smtk::resource::ResourcePtr& resource, const Visitor& visitor)
+{
+  auto geometryResource = std::dynamic_pointer_cast<smtk::geometry::Resource>(resource);
+  if (!geometryResource)
+  {
+    return false;
+  }
+  const auto& geometry = geometryResource->geometry();
+  if (!geometry)
+  {
+    return false;
+  }
+  resource->queries().cache<SpatialIndex>().visit(*geometry, visitor);
+  return true;
+}
+
+smtk::resource::PersistentObjectPtr SpatialIndex::object(
+  const smtk::resource::ResourcePtr& resource,
+  const smtk::common::UUID& uid)
+{
+  if (!resource || !uid)
+  {
+    return nullptr;
+  }
+  if (uid == resource->id())
+  {
+    return resource;
+  }
+  return resource->find(uid);
+}
+
+void SpatialIndex::markDirty(const smtk::common::UUID& uid)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_dirty.insert(uid);
+}
+
+void SpatialIndex::synchronize(
+  const smtk::operation::Operation& /*unused*/,
+  const smtk::operation::Operation::Result& result)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (const auto& name : { "created", "modified", "expunged" })
+  {
+    auto item = result->findComponent(name);
+    for (std::size_t ii = 0; item && ii < item->numberOfValues(); ++ii)
+    {
+      if (auto component = item->value(ii))
+      {
+        m_dirty.insert(component->id());
+      }
+    }
+  }
+}
+
+void SpatialIndex::reset()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_hierarchy.clear();
+  m_entries.clear();
+  m_dirty.clear();
+  m_geometry = nullptr;
+  m_lastModified = Geometry::Invalid;
+}
+
+void SpatialIndex::update(const Geometry& geometry)
+{
+  // Fetch the counter before updating so that changes made during the
+  // update are picked up by the next one.
+  auto lastModified = geometry.lastModified();
+  bool rebuild = m_geometry != &geometry;
+  if (!rebuild && m_dirty.empty() && lastModified == m_lastModified)
+  {
+    return;
+  }
+
+  Changes changed;
+  std::vector<smtk::common::UUID> removed;
+  if (rebuild || m_dirty.empty())
+  {
+    // Either the index has never been built or the geometry was modified
+    // without any object being reported; check every object.
+    if (rebuild)
+    {
+      m_entries.clear();
+    }
+    this->updateAll(geometry, changed, removed);
+  }
+  else
+  {
+    this->updateDirty(geometry, changed, removed);
+  }
+  m_dirty.clear();
+  this->apply(changed, removed, rebuild);
+  m_geometry = &geometry;
+  m_lastModified = lastModified;
+}
+
+void SpatialIndex::updateAll(
+  const Geometry& geometry,
+  Changes& changed,
+  std::vector<smtk::common::UUID>& removed)
+{
+  ++m_pass;
+  geometry.visit([&](const smtk::resource::PersistentObject::Ptr& object,
+                     Geometry::GenerationNumber /*unused*/) {
+    // The visited generation may be stale for objects marked modified;
+    // asking for it again regenerates their geometry.
+    auto generation = geometry.generationNumber(object);
+    if (generation == Geometry::Invalid)
+    {
+      return false;
+    }
+    auto inserted = m_entries.emplace(object->id(), Entry{ generation, m_pass });
+    Entry& entry = inserted.first->second;
+    if (inserted.second || entry.m_generation != generation)
+    {
+      BoundingVolumeHierarchy::BoundingBox box;
+      geometry.bounds(object, box);
+      changed.emplace_back(object->id(), box);
+      entry.m_generation = generation;
+    }
+    entry.m_pass = m_pass;
+    return false;
+  });
+
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (it->second.m_pass != m_pass)
+    {
+      removed.push_back(it->first);
+      it = m_entries.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void SpatialIndex::updateDirty(
+  const Geometry& geometry,
+  Changes& changed,
+  std::vector<smtk::common::UUID>& removed)
+{
+  auto resource = geometry.resource();
+  for (const auto& uid : m_dirty)
+  {
+    auto object = SpatialIndex::object(resource, uid);
+    auto generation = object ? geometry.generationNumber(object) : Geometry::Invalid;
+    if (generation == Geometry::Invalid)
+    {
+      // The object was expunged or no longer has geometry.
+      if (m_entries.erase(uid) > 0)
+      {
+        removed.push_back(uid);
+      }
+      continue;
+    }
+    auto inserted = m_entries.emplace(uid, Entry{ generation, m_pass });
+    Entry& entry = inserted.first->second;
+    if (inserted.second || entry.m_generation != generation)
+    {
+      BoundingVolumeHierarchy::BoundingBox box;
+      geometry.bounds(object, box);
+      changed.emplace_back(uid, box);
+      entry.m_generation = generation;
+    }
+  }
+}
+
+void SpatialIndex::apply(
+  const Changes& changed,
+  const std::vector<smtk::common::UUID>& removed,
+  bool rebuild)
+{
+  // Moving a leaf costs a logarithmic removal and insertion while a bulk
+  // build costs n log n, so rebuild once a sizable fraction has changed.
+  if (rebuild || 4 * (changed.size() + removed.size()) > m_entries.size())
+  {
+    Changes all;
+    all.reserve(m_entries.size());
+    std::unordered_map<smtk::common::UUID, std::size_t> changedIndex;
+    for (std::size_t ii = 0; ii < changed.size(); ++ii)
+    {
+      changedIndex[changed[ii].first] = ii;
+    }
+    for (const auto& entry : m_entries)
+    {
+      auto it = changedIndex.find(entry.first);
+      if (it != changedIndex.end())
+      {
+        all.push_back(changed[it->second]);
+      }
+      else
+      {
+        BoundingVolumeHierarchy::BoundingBox box;
+        if (m_hierarchy.find(entry.first, box))
+        {
+          all.emplace_back(entry.first, box);
+        }
+      }
+    }
+    m_hierarchy.build(all);
+  }
+  else
+  {
+    for (const auto& uid : removed)
+    {
+      m_hierarchy.erase(uid);
+    }
+    for (const auto& entry : changed)
+    {
+      m_hierarchy.update(entry.first, entry.second);
+    }
+  }
+}
+
+} // namespace geometry
+} // namespace smtk
@@ -0,0 +1,115 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_geometry_SpatialIndex_h
+#define smtk_geometry_SpatialIndex_h
+
+#include "smtk/CoreExports.h"
+
+#include "smtk/geometry/BoundingVolumeHierarchy.h"
+#include "smtk/geometry/Geometry.h"
+
+#include "smtk/operation/queries/SynchronizedCache.h"
+
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace smtk
+{
+namespace geometry
+{
+
+/**\brief A query cache holding a bounding volume hierarchy of a resource's geometry.
+  *
+  * The index is built from every object of a geometry provider the first
+  * time it is accessed. Afterward, it is synchronized with the results of
+  * operations: objects that operations report as created, modified, or
+  * expunged are marked dirty, and only dirty objects have their generation
+  * numbers checked (and, if changed, their bounds fetched and moved within
+  * the hierarchy) when the index is next accessed. Objects whose geometry
+  * is changed outside of an operation may be marked with markDirty().
+  *
+  * If the provider's lastModified() counter changes while no objects are
+  * dirty, the geometry was modified without saying which objects changed
+  * and every object is visited as when the index was first built. When a
+  * large fraction of objects change at once, the hierarchy is rebuilt in
+  * bulk rather than updated one object at a time.
+  *
+  * Access is serialized so that queries run under a shared (read) lock on
+  * the resource may use the index concurrently.
+  */
+struct SMTKCORE_EXPORT SpatialIndex : public smtk::operation::SynchronizedCache
+{
+  /// Visitors are passed the hierarchy and the geometry provider it indexes
+  /// (so that candidates may be refined using their actual geometry).
+  using Visitor = std::function<void(const BoundingVolumeHierarchy&, const Geometry&)>;
+
+  /// Update the index to match \a geometry, then pass the hierarchy to \a visitor.
+  void visit(const Geometry& geometry, const Visitor& visitor);
+
+  /// Update the index held by \a resource's queries for its first geometry
+  /// provider, then pass the hierarchy to \a visitor.
+  ///
+  /// Returns false (without calling \a visitor) if \a resource is not a
+  /// geometry resource or has no geometry provider.
+  static bool visit(const smtk::resource::ResourcePtr& resource, const Visitor& visitor);
+
+  /// Return the object of \a resource with the given \a uid (which may be
+  /// the resource itself), or null.
+  static smtk::resource::PersistentObjectPtr
+  object(const smtk::resource::ResourcePtr& resource, const smtk::common::UUID& uid);
+
+  /// Mark the object \a uid dirty so its bounds are checked on next access.
+  void markDirty(const smtk::common::UUID& uid);
+
+  /// Mark the objects an operation created, modified, or expunged as dirty.
+  void synchronize(const smtk::operation::Operation&, const smtk::operation::Operation::Result&)
+    override;
+
+  /// Discard the index so that it is rebuilt on next access.
+  void reset();
+
+private:
+  using Changes = std::vector<std::pair<smtk::common::UUID, BoundingVolumeHierarchy::BoundingBox>>;
+
+  void update(const Geometry& geometry);
+  // Visit every object of \a geometry, fetching bounds of those whose generation changed.
+  void
+  updateAll(const Geometry& geometry, Changes& changed, std::vector<smtk::common::UUID>& removed);
+  // Check only dirty objects, fetching bounds of those whose generation changed.
+  void updateDirty(
+    const Geometry& geometry,
+    Changes& changed,
+    std::vector<smtk::common::UUID>& removed);
+  // Apply changes to the hierarchy (rebuilding it when many entries changed).
+  void apply(const Changes& changed, const std::vector<smtk::common::UUID>& removed, bool rebuild);
+
+  struct Entry
+  {
+    Geometry::GenerationNumber m_generation;
+    std::size_t m_pass;
+  };
+
+  std::mutex m_mutex;
+  BoundingVolumeHierarchy m_hierarchy;
+  std::unordered_map<smtk::common::UUID, Entry> m_entries;
+  std::unordered_set<smtk::common::UUID> m_dirty;
+  const Geometry* m_geometry{ nullptr };
+  Geometry::GenerationNumber m_lastModified{ Geometry::Invalid };
+  std::size_t m_pass{ 0 };
+};
+
+} // namespace geometry
+} // namespace smtk
+
+#endif // smtk_geometry_SpatialIndex_h
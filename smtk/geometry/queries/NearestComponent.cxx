@@ -0,0 +1,66 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/geometry/queries/NearestComponent.h"
+
+#include "smtk/geometry/SpatialIndex.h"
+#include "smtk/geometry/queries/DistanceTo.h"
+
+#include "smtk/resource/Component.h"
+#include "smtk/resource/Resource.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace smtk
+{
+namespace geometry
+{
+
+std::pair<smtk::resource::PersistentObject::Ptr, double> NearestComponent::operator()(
+  const smtk::resource::ResourcePtr& resource,
+  const std::array<double, 3>& point,
+  double maxDistance) const
+{
+  std::pair<smtk::resource::PersistentObject::Ptr, double> result(
+    nullptr, BoundingVolumeHierarchy::Infinity);
+  if (!resource)
+  {
+    return result;
+  }
+
+  BoundingVolumeHierarchy::DistanceFunction distance;
+  if (resource->queries().contains<DistanceTo>())
+  {
+    const auto& distanceTo = resource->queries().get<DistanceTo>();
+    distance = [&](const smtk::common::UUID& uid, const BoundingVolumeHierarchy::BoundingBox& box) {
+      double boxDistance = std::sqrt(BoundingVolumeHierarchy::distance2(box, point));
+      if (auto component = resource->find(uid))
+      {
+        double exact = distanceTo(component, point).first;
+        // Fall back to the box when no exact distance is available.
+        return std::isnan(exact) ? boxDistance : std::max(exact, boxDistance);
+      }
+      return boxDistance;
+    };
+  }
+
+  SpatialIndex::visit(resource, [&](const BoundingVolumeHierarchy& hierarchy, const Geometry&) {
+    auto nearest = hierarchy.nearest(point, distance, maxDistance);
+    result = std::make_pair(SpatialIndex::object(resource, nearest.first), nearest.second);
+  });
+  if (!result.first)
+  {
+    result.second = BoundingVolumeHierarchy::Infinity;
+  }
+  return result;
+}
+
+} // namespace geometry
+} // namespace smtk
@@ -0,0 +1,48 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_geometry_NearestComponent_h
+#define smtk_geometry_NearestComponent_h
+
+#include "smtk/CoreExports.h"
+
+#include "smtk/resource/PersistentObject.h"
+#include "smtk/resource/query/DerivedFrom.h"
+#include "smtk/resource/query/Query.h"
+
+#include <array>
+#include <limits>
+#include <utility>
+
+namespace smtk
+{
+namespace geometry
+{
+
+/**\brief An API for finding the object of a geometric resource nearest a point.
+  *
+  * Candidates are drawn from the resource's SpatialIndex in order of the
+  * distance from the point to their bounds. If the resource provides a
+  * DistanceTo query, it is used to compute exact distances to components;
+  * otherwise distances are measured to bounding boxes. The object and its
+  * distance are returned; if no object lies within \a maxDistance, the
+  * object is null and the distance is infinite.
+  */
+struct SMTKCORE_EXPORT NearestComponent
+  : public smtk::resource::query::DerivedFrom<NearestComponent, smtk::resource::query::Query>
+{
+  virtual std::pair<smtk::resource::PersistentObject::Ptr, double> operator()(
+    const smtk::resource::ResourcePtr& resource,
+    const std::array<double, 3>& point,
+    double maxDistance = std::numeric_limits<double>::infinity()) const;
+};
+} // namespace geometry
+} // namespace smtk
+
+#endif
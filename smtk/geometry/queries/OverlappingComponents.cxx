@@ -0,0 +1,62 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/geometry/queries/OverlappingComponents.h"
+
+#include "smtk/geometry/SpatialIndex.h"
+
+#include "smtk/resource/Resource.h"
+
+namespace smtk
+{
+namespace geometry
+{
+
+std::set<smtk::resource::PersistentObject::Ptr> OverlappingComponents::operator()(
+  const smtk::resource::ResourcePtr& resource,
+  const std::array<double, 6>& box) const
+{
+  std::set<smtk::resource::PersistentObject::Ptr> result;
+  SpatialIndex::visit(
+    resource, [&](const BoundingVolumeHierarchy& hierarchy, const Geometry& geometry) {
+      hierarchy.visitOverlapping(
+        box, [&](const smtk::common::UUID& uid, const BoundingVolumeHierarchy::BoundingBox&) {
+          auto object = SpatialIndex::object(resource, uid);
+          if (object && geometry.overlaps(object, box))
+          {
+            result.insert(object);
+          }
+          return smtk::common::Visit::Continue;
+        });
+    });
+  return result;
+}
+
+std::set<smtk::resource::PersistentObject::Ptr> OverlappingComponents::operator()(
+  const smtk::resource::ResourcePtr& resource,
+  const std::vector<std::array<double, 4>>& planes) const
+{
+  std::set<smtk::resource::PersistentObject::Ptr> result;
+  SpatialIndex::visit(
+    resource, [&](const BoundingVolumeHierarchy& hierarchy, const Geometry& geometry) {
+      hierarchy.visitInside(
+        planes, [&](const smtk::common::UUID& uid, const BoundingVolumeHierarchy::BoundingBox&) {
+          auto object = SpatialIndex::object(resource, uid);
+          if (object && geometry.inside(object, planes))
+          {
+            result.insert(object);
+          }
+          return smtk::common::Visit::Continue;
+        });
+    });
+  return result;
+}
+
+} // namespace geometry
+} // namespace smtk
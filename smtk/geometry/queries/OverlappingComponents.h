@@ -0,0 +1,57 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_geometry_OverlappingComponents_h
+#define smtk_geometry_OverlappingComponents_h
+
+#include "smtk/CoreExports.h"
+
+#include "smtk/resource/PersistentObject.h"
+#include "smtk/resource/query/DerivedFrom.h"
+#include "smtk/resource/query/Query.h"
+
+#include <array>
+#include <set>
+#include <vector>
+
+namespace smtk
+{
+namespace geometry
+{
+
+/**\brief An API for finding the objects of a geometric resource that
+  * overlap a box or lie (at least partially) within a convex region.
+  *
+  * Candidates are drawn from the resource's SpatialIndex, so only objects
+  * whose bounds may overlap the region are examined. Each candidate is then
+  * tested with its geometry provider's Geometry::overlaps() or
+  * Geometry::inside() method. (Providers that do not override these
+  * methods match objects by their bounds.)
+  */
+struct SMTKCORE_EXPORT OverlappingComponents
+  : public smtk::resource::query::DerivedFrom<OverlappingComponents, smtk::resource::query::Query>
+{
+  /// Return the objects that intersect \a box, ordered
+  /// (xmin, xmax, ymin, ymax, zmin, zmax).
+  virtual std::set<smtk::resource::PersistentObject::Ptr> operator()(
+    const smtk::resource::ResourcePtr& resource,
+    const std::array<double, 6>& box) const;
+
+  /// Return the objects that are not entirely outside any of \a planes.
+  ///
+  /// Each plane (a, b, c, d) keeps points where a*x + b*y + c*z + d >= 0.
+  /// Pass the six planes of a view frustum to select what a camera may see.
+  virtual std::set<smtk::resource::PersistentObject::Ptr> operator()(
+    const smtk::resource::ResourcePtr& resource,
+    const std::vector<std::array<double, 4>>& planes) const;
+};
+} // namespace geometry
+} // namespace smtk
+
+#endif
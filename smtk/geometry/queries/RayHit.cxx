@@ -0,0 +1,51 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/geometry/queries/RayHit.h"
+
+#include "smtk/geometry/SpatialIndex.h"
+
+#include "smtk/resource/Resource.h"
+
+namespace smtk
+{
+namespace geometry
+{
+
+std::pair<smtk::resource::PersistentObject::Ptr, double> RayHit::operator()(
+  const smtk::resource::ResourcePtr& resource,
+  const std::array<double, 3>& origin,
+  const std::array<double, 3>& direction,
+  double maxParameter) const
+{
+  std::pair<smtk::resource::PersistentObject::Ptr, double> result(
+    nullptr, BoundingVolumeHierarchy::Infinity);
+  SpatialIndex::visit(
+    resource, [&](const BoundingVolumeHierarchy& hierarchy, const Geometry& geometry) {
+      // Test each candidate whose bounds the ray enters against its geometry.
+      auto hitGeometry = [&](
+                           const smtk::common::UUID& uid,
+                           const BoundingVolumeHierarchy::BoundingBox& /*unused*/,
+                           double entry) {
+        auto object = SpatialIndex::object(resource, uid);
+        return object ? geometry.raycast(object, origin, direction, entry, maxParameter)
+                      : BoundingVolumeHierarchy::Infinity;
+      };
+      auto hit = hierarchy.raycast(origin, direction, hitGeometry, maxParameter);
+      result = std::make_pair(SpatialIndex::object(resource, hit.first), hit.second);
+    });
+  if (!result.first)
+  {
+    result.second = BoundingVolumeHierarchy::Infinity;
+  }
+  return result;
+}
+
+} // namespace geometry
+} // namespace smtk
@@ -0,0 +1,50 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_geometry_RayHit_h
+#define smtk_geometry_RayHit_h
+
+#include "smtk/CoreExports.h"
+
+#include "smtk/resource/PersistentObject.h"
+#include "smtk/resource/query/DerivedFrom.h"
+#include "smtk/resource/query/Query.h"
+
+#include <array>
+#include <limits>
+#include <utility>
+
+namespace smtk
+{
+namespace geometry
+{
+
+/**\brief An API for finding the first object of a geometric resource hit by a ray.
+  *
+  * The ray is \a origin + t * \a direction for t in [0, \a maxParameter].
+  * Candidates are drawn from the resource's SpatialIndex in the order the ray
+  * enters their bounds. Each is tested with its geometry provider's
+  * Geometry::raycast() method, and the object hit first is returned along
+  * with the ray parameter of the hit. (Providers that do not override
+  * Geometry::raycast() report hits where the ray enters an object's bounds.)
+  * If nothing is hit, the object is null and the parameter is infinite.
+  */
+struct SMTKCORE_EXPORT RayHit
+  : public smtk::resource::query::DerivedFrom<RayHit, smtk::resource::query::Query>
+{
+  virtual std::pair<smtk::resource::PersistentObject::Ptr, double> operator()(
+    const smtk::resource::ResourcePtr& resource,
+    const std::array<double, 3>& origin,
+    const std::array<double, 3>& direction,
+    double maxParameter = std::numeric_limits<double>::infinity()) const;
+};
+} // namespace geometry
+} // namespace smtk
+
+#endif
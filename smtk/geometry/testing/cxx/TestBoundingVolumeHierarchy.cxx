@@ -0,0 +1,174 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/geometry/BoundingVolumeHierarchy.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+
+namespace
+{
+using BVH = smtk::geometry::BoundingVolumeHierarchy;
+using Boxes = std::map<smtk::common::UUID, BVH::BoundingBox>;
+
+BVH::BoundingBox randomBox(std::mt19937& generator)
+{
+  std::uniform_real_distribution<double> corner(0., 100.);
+  std::uniform_real_distribution<double> size(0., 2.);
+  BVH::BoundingBox box;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    box[2 * axis] = corner(generator);
+    box[2 * axis + 1] = box[2 * axis] + size(generator);
+  }
+  return box;
+}
+
+bool overlaps(const BVH::BoundingBox& aa, const BVH::BoundingBox& bb)
+{
+  return aa[0] <= bb[1] && bb[0] <= aa[1] && aa[2] <= bb[3] && bb[2] <= aa[3] &&
+    aa[4] <= bb[5] && bb[4] <= aa[5];
+}
+
+// Compare the hierarchy's queries against a linear scan of \a boxes.
+void checkQueries(const BVH& bvh, const Boxes& boxes, std::mt19937& generator)
+{
+  smtkTest(bvh.size() == boxes.size(), "Expected " << boxes.size() << " entries, got " << bvh.size());
+  // A balanced tree of n leaves has a height near log2(n); allow some slack.
+  double limit = 2. * std::log2(static_cast<double>(boxes.size()) + 1.) + 2.;
+  smtkTest(bvh.height() <= limit, "Hierarchy is unbalanced (height " << bvh.height() << ").");
+
+  for (int trial = 0; trial < 20; ++trial)
+  {
+    BVH::BoundingBox query = randomBox(generator);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      query[2 * axis + 1] += 10.;
+    }
+    std::set<smtk::common::UUID> expected;
+    for (const auto& entry : boxes)
+    {
+      if (overlaps(entry.second, query))
+      {
+        expected.insert(entry.first);
+      }
+    }
+    std::set<smtk::common::UUID> found;
+    bvh.visitOverlapping(query, [&found](const smtk::common::UUID& uid, const BVH::BoundingBox&) {
+      found.insert(uid);
+      return smtk::common::Visit::Continue;
+    });
+    smtkTest(found == expected, "Box overlap mismatch.");
+
+    // The same box expressed as six planes.
+    std::vector<BVH::Plane> planes{ { { 1., 0., 0., -query[0] } }, { { -1., 0., 0., query[1] } },
+                                    { { 0., 1., 0., -query[2] } }, { { 0., -1., 0., query[3] } },
+                                    { { 0., 0., 1., -query[4] } }, { { 0., 0., -1., query[5] } } };
+    found.clear();
+    bvh.visitInside(planes, [&found](const smtk::common::UUID& uid, const BVH::BoundingBox&) {
+      found.insert(uid);
+      return smtk::common::Visit::Continue;
+    });
+    smtkTest(found == expected, "Plane overlap mismatch.");
+
+    BVH::Point point{ { query[0], query[2], query[4] } };
+    double nearestDistance = BVH::Infinity;
+    for (const auto& entry : boxes)
+    {
+      nearestDistance = std::min(nearestDistance, std::sqrt(BVH::distance2(entry.second, point)));
+    }
+    auto nearest = bvh.nearest(point);
+    smtkTest(
+      std::abs(nearest.second - nearestDistance) < 1e-12,
+      "Nearest distance " << nearest.second << " should be " << nearestDistance << ".");
+
+    BVH::Point direction{ { 1., 0.5, 0.25 } };
+    BVH::Point origin{ { -10., query[2] - 5., query[4] - 2.5 } };
+    double firstHit = BVH::Infinity;
+    for (const auto& entry : boxes)
+    {
+      firstHit = std::min(firstHit, BVH::entry(entry.second, origin, direction, BVH::Infinity));
+    }
+    auto hit = bvh.raycast(origin, direction);
+    smtkTest(
+      hit.second == firstHit, "Ray hit at " << hit.second << " should be at " << firstHit << ".");
+  }
+}
+} // namespace
+
+int TestBoundingVolumeHierarchy(int /*unused*/, char** const /*unused*/)
+{
+  std::mt19937 generator(1729);
+  Boxes boxes;
+  std::vector<std::pair<smtk::common::UUID, BVH::BoundingBox>> entries;
+  for (int ii = 0; ii < 2000; ++ii)
+  {
+    auto uid = smtk::common::UUID::random();
+    boxes[uid] = randomBox(generator);
+    entries.emplace_back(uid, boxes[uid]);
+  }
+
+  BVH bvh;
+  std::cout << "Bulk build\n";
+  bvh.build(entries);
+  checkQueries(bvh, boxes, generator);
+
+  std::cout << "Incremental moves, erasures, and insertions\n";
+  std::uniform_int_distribution<std::size_t> pick(0, entries.size() - 1);
+  for (int ii = 0; ii < 500; ++ii)
+  {
+    const auto& uid = entries[pick(generator)].first;
+    if (ii % 5 == 0)
+    {
+      bvh.erase(uid);
+      boxes.erase(uid);
+    }
+    else
+    {
+      boxes[uid] = randomBox(generator);
+      bvh.update(uid, boxes[uid]);
+    }
+  }
+  for (int ii = 0; ii < 500; ++ii)
+  {
+    auto uid = smtk::common::UUID::random();
+    boxes[uid] = randomBox(generator);
+    bvh.update(uid, boxes[uid]);
+  }
+  checkQueries(bvh, boxes, generator);
+
+  std::cout << "Empty boxes are erased\n";
+  auto uid = boxes.begin()->first;
+  smtkTest(bvh.update(uid, { { 1., 0., 1., 0., 1., 0. } }), "Expected empty box to erase entry.");
+  boxes.erase(uid);
+  BVH::BoundingBox box;
+  smtkTest(!bvh.find(uid, box), "Erased entry should not be found.");
+  checkQueries(bvh, boxes, generator);
+
+  // Build an empty hierarchy incrementally from scratch.
+  std::cout << "Incremental build\n";
+  BVH incremental;
+  for (const auto& entry : boxes)
+  {
+    incremental.update(entry.first, entry.second);
+  }
+  checkQueries(incremental, boxes, generator);
+
+  incremental.clear();
+  smtkTest(incremental.empty() && incremental.height() == 0, "Expected an empty hierarchy.");
+  smtkTest(!incremental.nearest({ { 0., 0., 0. } }).first, "Expected no nearest entry.");
+
+  return 0;
+}
@@ -0,0 +1,321 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/geometry/Backend.h"
+#include "smtk/geometry/Cache.h"
+#include "smtk/geometry/CacheBudget.h"
+#include "smtk/geometry/Generator.h"
+#include "smtk/geometry/Manager.h"
+#include "smtk/geometry/Resource.h"
+
+#include "smtk/resource/DerivedFrom.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// This test verifies that the geometry manager's cache budget evicts the
+// least-recently-used geometry across resources, keeps counting geometry
+// that consumers still reference, regenerates evicted geometry on demand,
+// spills expensive geometry to disk, and reports per-resource statistics.
+
+namespace
+{
+std::string write_root = SMTK_SCRATCH_DIR;
+
+// Each "tessellation" is a vector of numbers; its size is its memory footprint.
+using Format = std::shared_ptr<std::vector<double>>;
+constexpr std::size_t numberOfValues = 128;
+constexpr std::size_t entryBytes = numberOfValues * sizeof(double);
+
+class BudgetBackend : public smtk::geometry::Backend
+{
+public:
+  [[nodiscard]] std::string name() const override { return "BudgetBackend"; }
+};
+
+class TestResource;
+
+class TestComponent : public smtk::resource::Component
+{
+  friend class TestResource;
+
+public:
+  smtkTypeMacro(TestComponent);
+  smtkSuperclassMacro(smtk::resource::Component);
+  smtkSharedFromThisMacro(smtk::resource::PersistentObject);
+
+  const smtk::resource::ResourcePtr resource() const override { return m_resource.lock(); }
+  const smtk::common::UUID& id() const override { return m_id; }
+  bool setId(const smtk::common::UUID& id) override
+  {
+    m_id = id;
+    return true;
+  }
+
+private:
+  TestComponent(const smtk::resource::ResourcePtr& resource)
+    : m_resource(resource)
+    , m_id(smtk::common::UUID::random())
+  {
+  }
+
+  std::weak_ptr<smtk::resource::Resource> m_resource;
+  smtk::common::UUID m_id;
+};
+
+class TestResource : public smtk::resource::DerivedFrom<TestResource, smtk::geometry::Resource>
+{
+public:
+  smtkTypeMacro(TestResource);
+  smtkCreateMacro(TestResource);
+  smtkSharedFromThisMacro(smtk::resource::PersistentObject);
+
+  TestComponent::Ptr newComponent()
+  {
+    TestComponent::Ptr comp(new TestComponent(shared_from_this()));
+    m_components.insert(comp);
+    return comp;
+  }
+
+  smtk::resource::ComponentPtr find(const smtk::common::UUID& id) const override
+  {
+    auto it = std::find_if(
+      m_components.begin(), m_components.end(), [&](const TestComponent::Ptr& c) {
+        return c->id() == id;
+      });
+    return it != m_components.end() ? *it : smtk::resource::ComponentPtr();
+  }
+
+  std::function<bool(const smtk::resource::Component&)> queryOperation(
+    const std::string& /*unused*/) const override
+  {
+    return [](const smtk::resource::Component& /*unused*/) { return true; };
+  }
+
+  void visit(smtk::resource::Component::Visitor& visitor) const override
+  {
+    std::for_each(m_components.begin(), m_components.end(), visitor);
+  }
+
+protected:
+  TestResource() = default;
+
+private:
+  std::unordered_set<TestComponent::Ptr> m_components;
+};
+
+class TestGeometry : public smtk::geometry::Cache<smtk::geometry::GeometryForBackend<Format>>
+{
+public:
+  TestGeometry(const TestResource::Ptr& parent)
+    : m_parent(parent)
+  {
+  }
+
+  const smtk::geometry::Backend& backend() const override
+  {
+    static BudgetBackend data;
+    return data;
+  }
+
+  smtk::geometry::Resource::Ptr resource() const override { return m_parent.lock(); }
+
+  void queryGeometry(const smtk::resource::PersistentObject::Ptr& obj, CacheEntry& entry)
+    const override
+  {
+    if (!std::dynamic_pointer_cast<TestComponent>(obj))
+    {
+      entry.m_generation = Invalid;
+      return;
+    }
+    ++m_queries;
+    entry.m_geometry = std::make_shared<std::vector<double>>(numberOfValues, 1.0);
+    entry.m_generation = entry.isValid() ? entry.m_generation + 1 : Initial;
+  }
+
+  void geometricBounds(const Format& data, BoundingBox& bds) const override
+  {
+    bds[0] = bds[2] = bds[4] = 0.0;
+    bds[1] = bds[3] = bds[5] = static_cast<double>(data->size());
+  }
+
+  std::size_t dataSize(const Format& data) const override
+  {
+    return data ? data->size() * sizeof(double) : 0;
+  }
+
+  bool isShared(const Format& data) const override { return data && data.use_count() > 1; }
+
+  bool writeSpill(const Format& data, const std::string& filename) const override
+  {
+    std::ofstream file(filename, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data->data()), dataSize(data));
+    return file.good();
+  }
+
+  bool readSpill(const std::string& filename, Format& data) const override
+  {
+    std::ifstream file(filename, std::ios::binary);
+    data = std::make_shared<std::vector<double>>(numberOfValues);
+    file.read(reinterpret_cast<char*>(data->data()), dataSize(data));
+    return file.good();
+  }
+
+  using CacheMap = std::map<smtk::common::UUID, CacheEntry>;
+  std::size_t numberOfCachedEntries() const
+  {
+    return std::count_if(m_cache.begin(), m_cache.end(), [](const CacheMap::value_type& e) {
+      return !!e.second.m_geometry;
+    });
+  }
+
+  mutable int m_queries{ 0 };
+  TestResource::WeakPtr m_parent;
+};
+
+class RegisterBudgetBackend : public smtk::geometry::Supplier<RegisterBudgetBackend>
+{
+public:
+  [[nodiscard]] bool valid(const smtk::geometry::Specification& in) const override
+  {
+    BudgetBackend backend;
+    return std::get<1>(in).index() == backend.index();
+  }
+
+  smtk::geometry::GeometryPtr operator()(const smtk::geometry::Specification& in) override
+  {
+    auto rsrc = std::dynamic_pointer_cast<TestResource>(std::get<0>(in));
+    if (rsrc)
+    {
+      return smtk::geometry::GeometryPtr(new TestGeometry(rsrc));
+    }
+    throw std::invalid_argument("Not a test resource.");
+    return nullptr;
+  }
+};
+
+bool registered = RegisterBudgetBackend::registerClass();
+
+TestGeometry& provider(const TestResource::Ptr& resource)
+{
+  return dynamic_cast<TestGeometry&>(*resource->geometry(BudgetBackend{}));
+}
+} // anonymous namespace
+
+int TestCacheBudget(int /*unused*/, char** const /*unused*/)
+{
+  auto resourceManager = smtk::resource::Manager::create();
+  auto geometryManager = smtk::geometry::Manager::create();
+  geometryManager->registerResourceManager(resourceManager);
+  geometryManager->registerBackend<BudgetBackend>();
+  resourceManager->registerResource<TestResource>();
+
+  auto budget = geometryManager->cacheBudget();
+  smtkTest(!!budget, "The geometry manager should own a cache budget.");
+
+  auto resourceA = resourceManager->create<TestResource>();
+  auto resourceB = resourceManager->create<TestResource>();
+  auto& geomA = provider(resourceA);
+  auto& geomB = provider(resourceB);
+  smtkTest(geomA.cacheBudget() == budget, "Providers should share the manager's budget.");
+  smtkTest(geomB.cacheBudget() == budget, "Providers should share the manager's budget.");
+
+  auto a0 = resourceA->newComponent();
+  auto a1 = resourceA->newComponent();
+  auto b0 = resourceB->newComponent();
+
+  // With no budget, geometry is only counted.
+  geomA.data(a0);
+  geomA.data(a1);
+  geomA.data(a0);
+  smtkTest(budget->memoryInUse() == 2 * entryBytes, "Expected 2 entries counted.");
+  auto statsA = budget->statistics(resourceA->id());
+  smtkTest(
+    statsA.hits == 1 && statsA.misses == 2 && statsA.entries == 2,
+    "Unexpected statistics: " << statsA.hits << " hits, " << statsA.misses << " misses.");
+
+  // Geometry for another resource evicts the least-recently-used entry (a0).
+  budget->setMemoryBudget(2 * entryBytes);
+  auto generation = geomA.generationNumber(a0);
+  geomA.data(a1);
+  geomB.data(b0);
+  smtkTest(budget->memoryInUse() == 2 * entryBytes, "Budget exceeded.");
+  smtkTest(geomA.numberOfCachedEntries() == 1, "Expected a0 to be evicted.");
+  smtkTest(geomA.isEvicted(a0) && !geomA.isEvicted(a1), "Expected only a0 to be marked.");
+  smtkTest(budget->statistics(resourceA->id()).evictions == 1, "Expected 1 eviction.");
+  smtkTest(budget->statistics(resourceB->id()).bytes == entryBytes, "Bad byte count for B.");
+
+  // Evicted geometry is regenerated on demand (with a new generation number).
+  int queries = geomA.m_queries;
+  smtkTest(geomA.data(a0) && geomA.m_queries == queries + 1, "Expected a0 to be regenerated.");
+  smtkTest(geomA.generationNumber(a0) > generation, "Expected a new generation number.");
+  smtkTest(!geomA.isEvicted(a0), "Regenerated geometry should not be marked as evicted.");
+
+  // Expensive geometry is spilled and restored (with the same generation number).
+  std::string spillDirectory = write_root + "/TestCacheBudget";
+  budget->setSpillDirectory(spillDirectory);
+  budget->setSpillThreshold(0.);
+  generation = geomA.generationNumber(a0);
+  budget->setMemoryBudget(entryBytes);
+  smtkTest(budget->statistics().spills == 1, "Expected b0 to be spilled.");
+  queries = geomB.m_queries;
+  smtkTest(geomB.data(b0)->size() == numberOfValues, "Spilled geometry was not restored.");
+  smtkTest(geomB.m_queries == queries, "Spilled geometry should not be regenerated.");
+  smtkTest(budget->statistics().spills == 2, "Expected a0 to be spilled.");
+  smtkTest(geomA.generationNumber(a0) == generation, "Restoring should keep the generation.");
+  smtkTest(budget->statistics().restores == 2, "Expected 2 entries to be restored.");
+
+  // Modified geometry is no longer counted (and never restored from a spill).
+  geomA.markModified(a0);
+  smtkTest(budget->memoryInUse() == 0, "Modified geometry should not be counted.");
+  budget->resetStatistics();
+  smtkTest(budget->statistics().hits == 0, "Statistics were not reset.");
+
+  // Geometry referenced by a consumer is marked for eviction, but is still
+  // counted (since releasing it would free nothing) until the consumer drops it.
+  budget->setSpillDirectory(std::string());
+  budget->setMemoryBudget(2 * entryBytes);
+  {
+    Format held = geomA.data(a0);
+    geomA.data(a1);
+    geomB.data(b0);
+    smtkTest(geomA.isEvicted(a0) && !geomA.isEvicted(a1), "Expected only a0 to be marked.");
+    smtkTest(
+      geomA.numberOfCachedEntries() == 2 && budget->memoryInUse() == 3 * entryBytes,
+      "Shared geometry should remain cached and counted.");
+  }
+  queries = geomA.m_queries;
+  budget->enforce();
+  smtkTest(
+    geomA.numberOfCachedEntries() == 1 && geomA.isEvicted(a0),
+    "Geometry should be evicted once it is no longer shared.");
+  smtkTest(geomA.m_queries == queries, "Eviction should not regenerate geometry.");
+  smtkTest(budget->memoryInUse() == 2 * entryBytes, "Budget exceeded.");
+
+  // Destroying a provider removes its entries from the budget.
+  budget->setMemoryBudget(0);
+  geomB.data(b0);
+  smtkTest(budget->memoryInUse() == 2 * entryBytes, "Expected a1 and b0 to be counted.");
+  resourceManager->remove(resourceB);
+  resourceB = nullptr;
+  smtkTest(
+    budget->memoryInUse() == entryBytes, "Entries of destroyed providers should not be counted.");
+
+  boost::filesystem::remove_all(spillDirectory);
+  return 0;
+}
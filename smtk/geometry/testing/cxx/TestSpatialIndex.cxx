@@ -0,0 +1,311 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/geometry/Backend.h"
+#include "smtk/geometry/Generator.h"
+#include "smtk/geometry/Geometry.h"
+#include "smtk/geometry/Resource.h"
+#include "smtk/geometry/SpatialIndex.h"
+#include "smtk/geometry/queries/OverlappingComponents.h"
+#include "smtk/geometry/queries/RayHit.h"
+
+#include "smtk/resource/Component.h"
+#include "smtk/resource/DerivedFrom.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+namespace
+{
+
+using smtk::geometry::Geometry;
+
+class SphereBackend : public smtk::geometry::Backend
+{
+public:
+  [[nodiscard]] std::string name() const override { return "SphereBackend"; }
+};
+
+class SphereResource;
+
+class Sphere : public smtk::resource::Component
+{
+  friend class SphereResource;
+
+public:
+  smtkTypeMacro(Sphere);
+  smtkSuperclassMacro(smtk::resource::Component);
+  smtkSharedFromThisMacro(smtk::resource::PersistentObject);
+
+  const smtk::resource::ResourcePtr resource() const override { return m_resource.lock(); }
+  const smtk::common::UUID& id() const override { return m_id; }
+  bool setId(const smtk::common::UUID& id) override
+  {
+    m_id = id;
+    return true;
+  }
+
+  Geometry::Point m_center{ { 0., 0., 0. } };
+  double m_radius{ 1. };
+
+private:
+  Sphere(const smtk::resource::ResourcePtr& resource)
+    : m_resource(resource)
+    , m_id(smtk::common::UUID::random())
+  {
+  }
+
+  std::weak_ptr<smtk::resource::Resource> m_resource;
+  smtk::common::UUID m_id;
+};
+
+class SphereResource
+  : public smtk::resource::DerivedFrom<SphereResource, smtk::geometry::Resource>
+{
+public:
+  smtkTypeMacro(SphereResource);
+  smtkCreateMacro(SphereResource);
+  smtkSharedFromThisMacro(smtk::resource::PersistentObject);
+
+  Sphere::Ptr add(const Geometry::Point& center)
+  {
+    Sphere::Ptr sphere(new Sphere(shared_from_this()));
+    sphere->m_center = center;
+    m_spheres[sphere->id()] = sphere;
+    return sphere;
+  }
+
+  bool remove(const Sphere::Ptr& sphere) { return m_spheres.erase(sphere->id()) > 0; }
+
+  smtk::resource::ComponentPtr find(const smtk::common::UUID& id) const override
+  {
+    auto it = m_spheres.find(id);
+    return it == m_spheres.end() ? nullptr : it->second;
+  }
+
+  std::function<bool(const smtk::resource::Component&)> queryOperation(
+    const std::string& /*unused*/) const override
+  {
+    return [](const smtk::resource::Component& /*unused*/) { return true; };
+  }
+
+  void visit(smtk::resource::Component::Visitor& visitor) const override
+  {
+    for (const auto& entry : m_spheres)
+    {
+      visitor(entry.second);
+    }
+  }
+
+protected:
+  SphereResource() = default;
+
+private:
+  std::map<smtk::common::UUID, Sphere::Ptr> m_spheres;
+};
+
+// Provide spheres whose exact geometry is used to refine spatial queries.
+class SphereGeometry : public Geometry
+{
+public:
+  SphereGeometry(const SphereResource::Ptr& parent)
+    : m_parent(parent)
+  {
+  }
+
+  const smtk::geometry::Backend& backend() const override
+  {
+    static SphereBackend data;
+    return data;
+  }
+
+  smtk::geometry::Resource::Ptr resource() const override { return m_parent.lock(); }
+
+  GenerationNumber generationNumber(const smtk::resource::PersistentObject::Ptr& obj) const override
+  {
+    auto it = obj ? m_generations.find(obj->id()) : m_generations.end();
+    return it == m_generations.end() || !this->sphere(obj) ? Invalid : it->second;
+  }
+
+  void bounds(const smtk::resource::PersistentObject::Ptr& obj, BoundingBox& bds) const override
+  {
+    ++m_boundsCalls;
+    auto sphere = this->sphere(obj);
+    for (int ii = 0; ii < 3; ++ii)
+    {
+      bds[2 * ii] = sphere->m_center[ii] - sphere->m_radius;
+      bds[2 * ii + 1] = sphere->m_center[ii] + sphere->m_radius;
+    }
+  }
+
+  void visit(Visitor fn) const override
+  {
+    ++m_visits;
+    auto rsrc = m_parent.lock();
+    for (const auto& entry : m_generations)
+    {
+      if (auto object = rsrc->find(entry.first))
+      {
+        fn(object, entry.second);
+      }
+    }
+  }
+
+  void markModified(const smtk::resource::PersistentObject::Ptr& obj) override
+  {
+    if (this->sphere(obj))
+    {
+      auto it = m_generations.find(obj->id());
+      m_generations[obj->id()] = it == m_generations.end() ? Initial : it->second + 1;
+      ++m_lastModified;
+    }
+  }
+
+  bool erase(const smtk::common::UUID& uid) override { return m_generations.erase(uid) > 0; }
+
+  double raycast(
+    const smtk::resource::PersistentObject::Ptr& obj,
+    const Point& origin,
+    const Point& direction,
+    double entry,
+    double maxParameter) const override
+  {
+    // Solve |origin + t * direction - center|^2 = radius^2 for the smaller root.
+    auto sphere = this->sphere(obj);
+    double aa = 0.;
+    double bb = 0.;
+    double cc = -sphere->m_radius * sphere->m_radius;
+    for (int ii = 0; ii < 3; ++ii)
+    {
+      double delta = origin[ii] - sphere->m_center[ii];
+      aa += direction[ii] * direction[ii];
+      bb += 2. * direction[ii] * delta;
+      cc += delta * delta;
+    }
+    double discriminant = bb * bb - 4. * aa * cc;
+    if (discriminant < 0.)
+    {
+      return smtk::geometry::BoundingVolumeHierarchy::Infinity;
+    }
+    double tt = std::max(entry, (-bb - std::sqrt(discriminant)) / (2. * aa));
+    return tt <= maxParameter ? tt : smtk::geometry::BoundingVolumeHierarchy::Infinity;
+  }
+
+  bool overlaps(const smtk::resource::PersistentObject::Ptr& obj, const BoundingBox& box)
+    const override
+  {
+    auto sphere = this->sphere(obj);
+    Point nearest;
+    for (int ii = 0; ii < 3; ++ii)
+    {
+      nearest[ii] = std::min(std::max(sphere->m_center[ii], box[2 * ii]), box[2 * ii + 1]);
+    }
+    double distance2 = 0.;
+    for (int ii = 0; ii < 3; ++ii)
+    {
+      distance2 += (nearest[ii] - sphere->m_center[ii]) * (nearest[ii] - sphere->m_center[ii]);
+    }
+    return distance2 <= sphere->m_radius * sphere->m_radius;
+  }
+
+  mutable int m_visits{ 0 };
+  mutable int m_boundsCalls{ 0 };
+
+private:
+  Sphere::Ptr sphere(const smtk::resource::PersistentObject::Ptr& obj) const
+  {
+    return std::dynamic_pointer_cast<Sphere>(obj);
+  }
+
+  std::weak_ptr<SphereResource> m_parent;
+  std::map<smtk::common::UUID, GenerationNumber> m_generations;
+};
+
+class RegisterSphereGeometry : public smtk::geometry::Supplier<RegisterSphereGeometry>
+{
+public:
+  [[nodiscard]] bool valid(const smtk::geometry::Specification& in) const override
+  {
+    SphereBackend backend;
+    return std::get<1>(in).index() == backend.index();
+  }
+
+  smtk::geometry::GeometryPtr operator()(const smtk::geometry::Specification& in) override
+  {
+    auto rsrc = std::dynamic_pointer_cast<SphereResource>(std::get<0>(in));
+    if (rsrc)
+    {
+      return smtk::geometry::GeometryPtr(new SphereGeometry(rsrc));
+    }
+    throw std::invalid_argument("Not a sphere resource.");
+  }
+};
+
+bool registered = RegisterSphereGeometry::registerClass();
+
+} // anonymous namespace
+
+int TestSpatialIndex(int /*unused*/, char** const /*unused*/)
+{
+  smtkTest(registered, "Could not register sphere geometry.");
+  auto resource = SphereResource::create();
+  auto sphereA = resource->add({ { 0., 0., 0. } });
+  auto sphereB = resource->add({ { 5., 0., 0. } });
+  auto sphereC = resource->add({ { 10., 0., 0. } });
+  auto& provider = resource->geometry(SphereBackend());
+  smtkTest(!!provider, "Expected a sphere geometry provider.");
+  auto& geometry = static_cast<SphereGeometry&>(*provider);
+
+  const auto& rayHit = resource->queries().get<smtk::geometry::RayHit>();
+  const auto& overlapping = resource->queries().get<smtk::geometry::OverlappingComponents>();
+  auto& index = resource->queries().cache<smtk::geometry::SpatialIndex>();
+
+  // Candidates are refined by their exact geometry.
+  auto hit = rayHit(resource, { { -5., 0., 0. } }, { { 1., 0., 0. } });
+  smtkTest(hit.first == sphereA && std::abs(hit.second - 4.) < 1e-12, "Expected to hit A at 4.");
+  hit = rayHit(resource, { { -5., 0.9, 0.9 } }, { { 1., 0., 0. } });
+  smtkTest(!hit.first, "Expected a ray through the corners of all bounds to miss.");
+  auto overlaps = overlapping(resource, { { 0.8, 1.2, 0.8, 1.2, -0.1, 0.1 } });
+  smtkTest(overlaps.empty(), "Expected a box overlapping only A's bounds to miss.");
+  overlaps = overlapping(resource, { { 0.5, 5., -0.1, 0.1, -0.1, 0.1 } });
+  smtkTest(overlaps.size() == 2, "Expected a box to overlap A and B.");
+  smtkTest(geometry.m_visits == 1, "Expected the index to be built once.");
+
+  // Only dirty objects are checked once the index has been built.
+  sphereB->m_center = { { 5., 3., 0. } };
+  geometry.markModified(sphereB);
+  index.markDirty(sphereB->id());
+  int boundsCalls = geometry.m_boundsCalls;
+  hit = rayHit(resource, { { 5., -5., 0. } }, { { 0., 1., 0. } });
+  smtkTest(hit.first == sphereB && std::abs(hit.second - 7.) < 1e-12, "Expected to hit moved B.");
+  smtkTest(geometry.m_visits == 1, "Expected only dirty objects to be checked.");
+  smtkTest(geometry.m_boundsCalls == boundsCalls + 1, "Expected only B to be re-bounded.");
+
+  // Removed objects are dropped.
+  resource->remove(sphereC);
+  geometry.erase(sphereC->id());
+  index.markDirty(sphereC->id());
+  hit = rayHit(resource, { { 10., -5., 0. } }, { { 0., 1., 0. } });
+  smtkTest(!hit.first, "Expected removed C to be dropped.");
+  smtkTest(geometry.m_visits == 1, "Expected only dirty objects to be checked.");
+
+  // Changes that are not reported cause every object to be checked.
+  sphereA->m_center = { { 0., -3., 0. } };
+  geometry.markModified(sphereA);
+  hit = rayHit(resource, { { 0., -10., 0. } }, { { 0., 1., 0. } });
+  smtkTest(hit.first == sphereA && std::abs(hit.second - 6.) < 1e-12, "Expected to hit moved A.");
+  smtkTest(geometry.m_visits == 2, "Expected unreported changes to check every object.");
+
+  return 0;
+}
@@ -716,6 +716,39 @@
     }
     ///@}
 
+    /// A batch of arcs, each given by its (from, to) endpoints.
+    using ArcList = std::vector<std::pair<const FromType*, const ToType*>>;
+
+    /**\brief Insert a batch of \a arcs, returning the number inserted.
+    *
+    * If the arc storage provides a bulk insertion method, it is used
+    * (and may use \a executor to build indices concurrently); otherwise
+    * arcs are connected one at a time. Arcs with null endpoints are skipped.
+    */
+    ///@{
+    template<typename U = Mutable>
+    typename std::enable_if<!U::value, std::size_t>::type connectBatch(
+      ArcList arcs,
+      smtk::common::Executor* executor = nullptr)
+    {
+      (void)arcs;
+      (void)executor;
+      return 0;
+    }
+
+    template<typename U = Mutable>
+    typename std::enable_if<U::value, std::size_t>::type connectBatch(
+      ArcList arcs,
+      smtk::common::Executor* executor = nullptr)
+    {
+      return this->connectBatchInternal(
+        std::move(arcs),
+        executor,
+        typename ArcProperties<Traits>::template hasConnectBatch<
+          detail::SelectArcContainer<Traits, Traits>>());
+    }
+    ///@}
+
     /**\brief Remove an arc from \a from to \a to.
     *
     */
@@ -906,6 +939,31 @@
     }
 
   protected:
+    std::size_t connectBatchInternal(
+      ArcList arcs,
+      smtk::common::Executor* executor,
+      std::true_type)
+    {
+      return m_data.connectBatch(std::move(arcs), executor);
+    }
+
+    std::size_t connectBatchInternal(
+      ArcList arcs,
+      smtk::common::Executor* executor,
+      std::false_type)
+    {
+      (void)executor;
+      std::size_t count = 0;
+      for (const auto& arc : arcs)
+      {
+        if (arc.first && arc.second && this->connect(arc.first, arc.second))
+        {
+          ++count;
+        }
+      }
+      return count;
+    }
+
     /**\brief Store arc endpoint data.
     *
     * This will be either ArcTraits or ExplicitArcs<ArcTraits>, depending
@@ -20,9 +20,16 @@
 #include <iterator>
 #include <set>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace smtk
 {
+namespace common
+{
+class Executor;
+}
+
 namespace graph
 {
 
@@ -177,6 +184,22 @@ public:
   {
   };
 
+  /// Check that a method exists to insert a batch of arcs.
+  template<class T, class = void>
+  struct hasConnectBatch : std::false_type
+  {
+  };
+  template<class T>
+  struct hasConnectBatch<
+    T,
+    type_sink_t<decltype(std::declval<T>().connectBatch(
+      std::declval<std::vector<std::pair<
+        const typename ArcTraits::FromType*,
+        const typename ArcTraits::ToType*>>>(),
+      static_cast<smtk::common::Executor*>(nullptr)))>> : std::true_type
+  {
+  };
+
   /**\brief Check whether the arc has bidirectional indexing (the default)
     *       or has been marked as having only a forward index.
     */
@@ -190,6 +213,32 @@ public:
   {
   };
 
+  /**\brief Check whether the arc has requested compressed (CSR) storage
+    *       by providing a truthy CompressedStorage type-alias.
+    */
+  template<class T, class = void>
+  struct hasCompressedStorage : std::false_type
+  {
+  };
+  template<class T>
+  struct hasCompressedStorage<T, type_sink_t<typename T::CompressedStorage>>
+    : std::conditional<T::CompressedStorage::value, std::true_type, std::false_type>::type
+  {
+  };
+
+  /**\brief Check whether the arc has requested ordered storage
+    *       by providing a truthy Ordered type-alias.
+    */
+  template<class T, class = void>
+  struct hasOrderedMark : std::false_type
+  {
+  };
+  template<class T>
+  struct hasOrderedMark<T, type_sink_t<typename T::Ordered>>
+    : std::conditional<T::Ordered::value, std::true_type, std::false_type>::type
+  {
+  };
+
   /**\brief Check whether the traits object has been marked immutable.
     */
   template<class T, class = void>
@@ -247,6 +296,14 @@ public:
     static constexpr bool value = type::value;
   };
 
+  /// True when an explicit arc should be stored in compressed sparse row form.
+  class isCompressed
+  {
+  public:
+    using type = typename conjunction<isExplicit, hasCompressedStorage<ArcTraits>>::type;
+    static constexpr bool value = type::value;
+  };
+
   /**\brief Check whether the arc traits object
     *       (1) is implicit and has methods to insert and remove arcs; or
     *       (2) is explicit and has not been marked immutable.
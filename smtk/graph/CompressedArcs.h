@@ -0,0 +1,560 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#ifndef smtk_graph_CompressedArcs_h
+#define smtk_graph_CompressedArcs_h
+
+#include "smtk/common/UUID.h"
+#include "smtk/common/Visit.h"
+#include "smtk/graph/ArcProperties.h"
+#include "smtk/graph/detail/BulkArcs.h"
+#include "smtk/graph/detail/CompressedAdjacency.h"
+#include "smtk/resource/Component.h"
+
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace smtk
+{
+namespace graph
+{
+
+/**\brief A wrapper around arc type-traits classes that stores arcs compactly.
+  *
+  * This class provides the same API as ExplicitArcs but holds each direction
+  * of the arcs in compressed sparse row form (see detail::CompressedAdjacency),
+  * which costs a pointer per arc per direction rather than a hash-set node.
+  * Neighbors of a node are visited by scanning contiguous memory.
+  *
+  * Explicit arc traits select this storage by providing a truthy
+  * `CompressedStorage` type-alias.
+  * Edits are staged and periodically folded into the compressed arrays;
+  * call compact() after bulk insertion or removal to do so immediately.
+  */
+template<typename ArcTraits>
+class CompressedArcs
+{
+public:
+  using Traits = ArcTraits; // Allow classes to inspect our input parameter.
+
+  using FromType = typename ArcTraits::FromType;
+  using ToType = typename ArcTraits::ToType;
+  using Directed = typename ArcTraits::Directed;
+  using Ordered = std::false_type; // This class cannot represent ordered arcs.
+  using Mutable = typename ArcProperties<ArcTraits>::isMutable;
+  using BidirIndex =
+    negation<typename ArcProperties<ArcTraits>::template hasOnlyForwardIndex<ArcTraits>>;
+
+  using UUID = smtk::common::UUID;
+  using ArcList = std::vector<std::pair<const FromType*, const ToType*>>;
+
+  CompressedArcs() = default;
+  CompressedArcs(Traits&& traits)
+    : m_traits(std::move(traits))
+  {
+  }
+  CompressedArcs(const Traits& traits)
+    : m_traits(traits)
+  {
+  }
+
+  static constexpr std::size_t MaxOutDegree = maxOutDegree<ArcTraits>(unconstrained());
+  static constexpr std::size_t MaxInDegree = maxInDegree<ArcTraits>(unconstrained());
+
+  using NoBadIndexing = disjunction<Directed, conjunction<negation<Directed>, BidirIndex>>;
+  static_assert(
+    NoBadIndexing::value,
+    "Undirected arcs must be bidirectionally indexed (otherwise outVisitor cannot work).");
+
+  /// True when arcs are undirected and connect nodes of the same type.
+  using AutoUndirected = typename ArcProperties<ArcTraits>::isAutoUndirected;
+
+  /**\brief Visit every node which has outgoing arcs of this type.
+    */
+  template<typename Resource, typename Functor>
+  smtk::common::Visited visitAllOutgoingNodes(Resource rr, Functor ff) const
+  {
+    (void)rr;
+    smtk::common::VisitorFunctor<Functor> visitor(ff);
+    std::set<const FromType*> visitedNodes; // Only used for auto-undirected visits
+    auto result = m_forward.visitKeys([&](const FromType* node) {
+      if (AutoUndirected::value)
+      {
+        visitedNodes.insert(node);
+      }
+      return visitor(node);
+    });
+    // Auto-undirected arcs may be stored in either direction, so nodes
+    // that only appear in the reverse index must also be visited.
+    if (AutoUndirected::value && result != smtk::common::Visited::Some)
+    {
+      auto reverseResult = m_reverse.visitKeys([&](const ToType* other) {
+        const auto* node = reinterpret_cast<const FromType*>(other);
+        if (visitedNodes.find(node) != visitedNodes.end())
+        {
+          return smtk::common::Visit::Continue;
+        }
+        return visitor(node);
+      });
+      if (reverseResult != smtk::common::Visited::Empty)
+      {
+        result = reverseResult;
+      }
+    }
+    return result;
+  }
+
+  /**\brief Visit every node which has incoming arcs of this type.
+    */
+  template<typename Resource, typename Functor>
+  smtk::common::Visited visitAllIncomingNodes(Resource rr, Functor ff) const
+  {
+    (void)rr;
+    smtk::common::VisitorFunctor<Functor> visitor(ff);
+    std::set<const ToType*> visitedNodes; // Only used for auto-undirected visits
+    auto result = m_reverse.visitKeys([&](const ToType* node) {
+      if (AutoUndirected::value)
+      {
+        visitedNodes.insert(node);
+      }
+      return visitor(node);
+    });
+    if (AutoUndirected::value && result != smtk::common::Visited::Some)
+    {
+      auto forwardResult = m_forward.visitKeys([&](const FromType* other) {
+        const auto* node = reinterpret_cast<const ToType*>(other);
+        if (visitedNodes.find(node) != visitedNodes.end())
+        {
+          return smtk::common::Visit::Continue;
+        }
+        return visitor(node);
+      });
+      if (forwardResult != smtk::common::Visited::Empty)
+      {
+        result = forwardResult;
+      }
+    }
+    return result;
+  }
+
+  /**\brief Visit outgoing arcs from a \a node.
+    */
+  template<typename Functor>
+  smtk::common::Visited outVisitor(const FromType* node, Functor ff) const
+  {
+    if (!node)
+    {
+      throw std::invalid_argument("Null from node.");
+    }
+    auto resource = node->resource();
+    if (!resource)
+    {
+      throw std::invalid_argument("Input node has no parent resource.");
+    }
+
+    smtk::common::VisitorFunctor<Functor> visitor(ff);
+    auto result = m_forward.visit(node, [&](const ToType* other) { return visitor(other); });
+
+    // If the graph is bidirectional and types match, visit matching reverse arcs.
+    if (AutoUndirected::value && BidirIndex::value && result != smtk::common::Visited::Some)
+    {
+      auto reverseResult =
+        m_reverse.visit(reinterpret_cast<const ToType*>(node), [&](const FromType* other) {
+          return visitor(reinterpret_cast<const ToType*>(other));
+        });
+      if (reverseResult != smtk::common::Visited::Empty)
+      {
+        result = reverseResult;
+      }
+    }
+    return result;
+  }
+
+  /**\brief Visit incoming arcs to a \a node.
+    */
+  template<typename Functor>
+  smtk::common::Visited inVisitor(const ToType* node, Functor ff) const
+  {
+    if (!node)
+    {
+      throw std::invalid_argument("Null to node.");
+    }
+    auto resource = node->resource();
+    if (!resource)
+    {
+      throw std::invalid_argument("Input node has no parent resource.");
+    }
+
+    smtk::common::VisitorFunctor<Functor> visitor(ff);
+    auto result = m_reverse.visit(node, [&](const FromType* other) { return visitor(other); });
+
+    // If the graph is bidirectional and types match, visit matching forward arcs.
+    if (AutoUndirected::value && BidirIndex::value && result != smtk::common::Visited::Some)
+    {
+      auto forwardResult =
+        m_forward.visit(reinterpret_cast<const FromType*>(node), [&](const ToType* other) {
+          return visitor(reinterpret_cast<const FromType*>(other));
+        });
+      if (forwardResult != smtk::common::Visited::Empty)
+      {
+        result = forwardResult;
+      }
+    }
+    return result;
+  }
+
+  /// Return true if an arc exists between \a from and \a to.
+  bool contains(const FromType* from, const ToType* to) const
+  {
+    if (!from || !to)
+    {
+      return false;
+    }
+    if (m_forward.contains(from, to))
+    {
+      return true;
+    }
+    // Undirected arcs between nodes of the same type may be stored as to → from.
+    return AutoUndirected::value &&
+      m_forward.contains(
+        reinterpret_cast<const FromType*>(to), reinterpret_cast<const ToType*>(from));
+  }
+
+  /// Return the number of outgoing arcs from the \a node.
+  std::size_t outDegree(const FromType* node) const
+  {
+    if (!node)
+    {
+      return 0;
+    }
+    std::size_t result = m_forward.degree(node);
+    if (AutoUndirected::value)
+    {
+      // Add any arcs "incoming" to the node.
+      result += m_reverse.degree(reinterpret_cast<const ToType*>(node));
+    }
+    return result;
+  }
+
+  /// Return the number of incoming arcs to the \a node.
+  std::size_t inDegree(const ToType* node) const
+  {
+    if (!node)
+    {
+      return 0;
+    }
+    std::size_t result = m_reverse.degree(node);
+    if (AutoUndirected::value)
+    {
+      // Add any arcs "outgoing" from the node.
+      result += m_forward.degree(reinterpret_cast<const FromType*>(node));
+    }
+    return result;
+  }
+
+protected:
+  template<typename U = typename ArcProperties<Traits>::template hasConnect<Traits>>
+  typename std::enable_if<!U::value, bool>::type runtimeConnectionCheck(
+    const FromType* from,
+    const ToType* to,
+    const FromType* beforeFrom,
+    const ToType* beforeTo) const
+  {
+    (void)from;
+    (void)to;
+    (void)beforeFrom;
+    (void)beforeTo;
+    return true;
+  }
+
+  template<typename U = typename ArcProperties<Traits>::template hasConnect<Traits>>
+  typename std::enable_if<U::value, bool>::type runtimeConnectionCheck(
+    const FromType* from,
+    const ToType* to,
+    const FromType* beforeFrom,
+    const ToType* beforeTo) const
+  {
+    // See ExplicitArcs::runtimeConnectionCheck(); the traits object's
+    // connect() method must not have side effects.
+    auto* traits = const_cast<Traits*>(&m_traits);
+    return traits->connect(from, to, beforeFrom, beforeTo);
+  }
+
+public:
+  /**\brief Check whether an arc from \a from to \a to is acceptable.
+    *
+    * This will not make any modifications; it simply checks whether
+    * the arc is allowed.
+    */
+  //@{
+  template<bool MM = Mutable::value>
+  typename std::enable_if<!MM, bool>::type accepts(
+    const FromType* from,
+    const ToType* to,
+    const FromType* beforeFrom = nullptr,
+    const ToType* beforeTo = nullptr) const
+  {
+    (void)from;
+    (void)to;
+    (void)beforeFrom;
+    (void)beforeTo;
+    return false;
+  }
+
+  template<bool MM = Mutable::value>
+  typename std::enable_if<MM, bool>::type accepts(
+    const FromType* from,
+    const ToType* to,
+    const FromType* beforeFrom = nullptr,
+    const ToType* beforeTo = nullptr) const
+  {
+    if (!from || !to)
+    {
+      return false;
+    }
+    // For auto-undirected arcs, to → from must not already exist.
+    bool inserting = !(
+      AutoUndirected::value &&
+      m_forward.contains(
+        reinterpret_cast<const FromType*>(to), reinterpret_cast<const ToType*>(from)));
+
+    // Verify that the in/out-degree constraints will be honored:
+    if (inserting && MaxOutDegree != unconstrained())
+    {
+      inserting &= (MaxOutDegree > this->outDegree(from));
+    }
+    if (inserting && MaxInDegree != unconstrained())
+    {
+      inserting &= (MaxInDegree > this->inDegree(to));
+    }
+    // Perform any additional run-time checks provided by the traits object.
+    inserting &= this->runtimeConnectionCheck(from, to, beforeFrom, beforeTo);
+    return inserting;
+  }
+  //@}
+
+  /**\brief Insert an arc from \a from to \a to.
+    *
+    * Since compressed arcs are unordered, \a beforeFrom and \a beforeTo
+    * are ignored except when passed to the traits object's runtime checks.
+    */
+  bool connect(
+    const FromType* from,
+    const ToType* to,
+    const FromType* beforeFrom = nullptr,
+    const ToType* beforeTo = nullptr)
+  {
+    if (!from || !to)
+    {
+      throw std::domain_error("Cannot connect null nodes.");
+    }
+    bool inserting = this->accepts(from, to, beforeFrom, beforeTo);
+    if (inserting)
+    {
+      inserting = m_forward.insert(from, to);
+      if (BidirIndex::value)
+      {
+        inserting |= m_reverse.insert(to, from);
+      }
+    }
+    return inserting;
+  }
+
+  /**\brief Insert a batch of \a arcs, returning the number inserted.
+    *
+    * When no arcs are stored and the traits impose no degree limits or
+    * run-time checks, both compressed arrays are written directly from the
+    * sorted batch (the reverse array on \a executor, if one is provided)
+    * and then moved into place. Otherwise, arcs are connected one at a time.
+    */
+  //@{
+  template<bool MM = Mutable::value>
+  typename std::enable_if<!MM, std::size_t>::type connectBatch(
+    ArcList arcs,
+    smtk::common::Executor* executor = nullptr)
+  {
+    (void)arcs;
+    (void)executor;
+    return 0;
+  }
+
+  template<bool MM = Mutable::value>
+  typename std::enable_if<MM, std::size_t>::type connectBatch(
+    ArcList arcs,
+    smtk::common::Executor* executor = nullptr)
+  {
+    if (
+      !m_forward.empty() || !m_reverse.empty() || MaxOutDegree != unconstrained() ||
+      MaxInDegree != unconstrained() ||
+      ArcProperties<Traits>::template hasConnect<Traits>::value)
+    {
+      std::size_t count = 0;
+      for (const auto& arc : arcs)
+      {
+        if (arc.first && arc.second && this->connect(arc.first, arc.second))
+        {
+          ++count;
+        }
+      }
+      return count;
+    }
+
+    detail::canonicalizeArcs(arcs, AutoUndirected::value);
+    decltype(m_forward) forward;
+    decltype(m_reverse) reverse;
+    detail::buildConcurrently(
+      arcs.size() < detail::MinimumConcurrentArcs ? nullptr : executor,
+      [&]() {
+        if (BidirIndex::value)
+        {
+          reverse.assign(detail::reverseArcs(arcs));
+        }
+      },
+      [&]() { forward.assign(arcs); });
+    m_forward = std::move(forward);
+    m_reverse = std::move(reverse);
+    return arcs.size();
+  }
+  //@}
+
+  /**\brief Remove an arc from \a from to \a to.
+    *
+    * If \a from is null, all arcs to \a to are removed;
+    * if \a to is null, all arcs from \a from are removed.
+    */
+  //@{
+  template<bool MM = Mutable::value>
+  typename std::enable_if<!MM, bool>::type disconnect(const FromType* from, const ToType* to)
+  {
+    (void)from;
+    (void)to;
+    return false;
+  }
+
+  template<bool MM = Mutable::value>
+  typename std::enable_if<MM, bool>::type disconnect(const FromType* from, const ToType* to)
+  {
+    if (!from && !to)
+    {
+      throw std::domain_error("Cannot disconnect null nodes.");
+    }
+    bool didDisconnect = false;
+    if (!from)
+    {
+      // Remove all arcs to "to".
+      if (BidirIndex::value)
+      {
+        for (const auto* other : m_reverse.eraseKey(to))
+        {
+          m_forward.erase(other, to);
+          didDisconnect = true;
+        }
+        if (std::is_base_of<FromType, ToType>::value)
+        {
+          const auto* node = reinterpret_cast<const FromType*>(to);
+          for (const auto* other : m_forward.eraseKey(node))
+          {
+            m_reverse.erase(other, node);
+            didDisconnect = true;
+          }
+        }
+      }
+      else
+      {
+        // We do not have a reverse index; examine every arc.
+        didDisconnect = m_forward.eraseValue(to) > 0;
+      }
+      return didDisconnect;
+    }
+    if (!to)
+    {
+      // Remove all arcs from "from".
+      for (const auto* other : m_forward.eraseKey(from))
+      {
+        if (BidirIndex::value)
+        {
+          m_reverse.erase(other, from);
+        }
+        didDisconnect = true;
+      }
+      if (std::is_base_of<ToType, FromType>::value)
+      {
+        const auto* node = reinterpret_cast<const ToType*>(from);
+        if (BidirIndex::value)
+        {
+          for (const auto* other : m_reverse.eraseKey(node))
+          {
+            m_forward.erase(other, node);
+            didDisconnect = true;
+          }
+        }
+        else
+        {
+          didDisconnect |= m_forward.eraseValue(node) > 0;
+        }
+      }
+      return didDisconnect;
+    }
+    // Remove the single arc from → to.
+    if (m_forward.erase(from, to))
+    {
+      if (BidirIndex::value)
+      {
+        m_reverse.erase(to, from);
+      }
+      return true;
+    }
+    if (AutoUndirected::value)
+    {
+      // We may have stored this arc as to → from.
+      const auto* reverseFrom = reinterpret_cast<const FromType*>(to);
+      const auto* reverseTo = reinterpret_cast<const ToType*>(from);
+      if (m_forward.erase(reverseFrom, reverseTo))
+      {
+        if (BidirIndex::value)
+        {
+          m_reverse.erase(reverseTo, reverseFrom);
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+  //@}
+
+  /// Fold all staged edits into the compressed arrays.
+  void compact()
+  {
+    m_forward.compact();
+    m_reverse.compact();
+  }
+
+  /// Return true if there are no arcs stored.
+  bool empty() const { return m_forward.empty(); }
+
+  /// Return the number of arcs stored.
+  std::size_t size() const { return m_forward.size(); }
+
+  /// Return the traits object that CompressedArcs is storing arcs for.
+  const Traits& traits() const { return m_traits; }
+  Traits& traits() { return m_traits; }
+
+protected:
+  detail::CompressedAdjacency<FromType, ToType> m_forward;
+  detail::CompressedAdjacency<ToType, FromType> m_reverse;
+  Traits m_traits;
+};
+
+} // namespace graph
+} // namespace smtk
+
+#endif // smtk_graph_CompressedArcs_h
@@ -14,11 +14,14 @@
 #include "smtk/common/UUID.h"
 #include "smtk/common/Visit.h"
 #include "smtk/graph/ArcProperties.h"
+#include "smtk/graph/detail/BulkArcs.h"
 #include "smtk/resource/Component.h"
 #include "smtk/string/Token.h"
 
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace smtk
 {
@@ -43,6 +46,7 @@ public:
     negation<typename ArcProperties<ArcTraits>::template hasOnlyForwardIndex<ArcTraits>>;
 
   using UUID = smtk::common::UUID;
+  using ArcList = std::vector<std::pair<const FromType*, const ToType*>>;
 
   ExplicitArcs() = default;
   ExplicitArcs(Traits&& traits)
@@ -286,10 +290,9 @@ public:
       return false;
     }
     auto it = m_forward.find(from);
-    if (it != m_forward.end())
+    if (it != m_forward.end() && it->second.find(to) != it->second.end())
     {
-      auto it2 = it->second.find(to);
-      return it2 != it->second.end();
+      return true;
     }
 
     // Handle undirected arcs where std::is_same<FromType, ToType>:
@@ -500,6 +503,64 @@ public:
   }
   //@}
 
+  /**\brief Insert a batch of \a arcs, returning the number inserted.
+    *
+    * When no arcs are stored and the traits impose no degree limits or
+    * run-time checks, the forward and reverse tables are built from the
+    * sorted batch (the reverse table on \a executor, if one is provided)
+    * and then swapped into place; until then, no arcs are visible.
+    * Otherwise, arcs are connected one at a time.
+    */
+  //@{
+  template<bool MM = Mutable::value>
+  typename std::enable_if<!MM, std::size_t>::type connectBatch(
+    ArcList arcs,
+    smtk::common::Executor* executor = nullptr)
+  {
+    (void)arcs;
+    (void)executor;
+    return 0;
+  }
+
+  template<bool MM = Mutable::value>
+  typename std::enable_if<MM, std::size_t>::type connectBatch(
+    ArcList arcs,
+    smtk::common::Executor* executor = nullptr)
+  {
+    if (
+      !m_forward.empty() || !m_reverse.empty() || MaxOutDegree != unconstrained() ||
+      MaxInDegree != unconstrained() ||
+      ArcProperties<Traits>::template hasConnect<Traits>::value)
+    {
+      std::size_t count = 0;
+      for (const auto& arc : arcs)
+      {
+        if (arc.first && arc.second && this->connect(arc.first, arc.second))
+        {
+          ++count;
+        }
+      }
+      return count;
+    }
+
+    detail::canonicalizeArcs(arcs, ArcProperties<ArcTraits>::isAutoUndirected::value);
+    decltype(m_forward) forward;
+    decltype(m_reverse) reverse;
+    detail::buildConcurrently(
+      arcs.size() < detail::MinimumConcurrentArcs ? nullptr : executor,
+      [&]() {
+        if (BidirIndex::value)
+        {
+          reverse = detail::buildAdjacency(detail::reverseArcs(arcs));
+        }
+      },
+      [&]() { forward = detail::buildAdjacency(arcs); });
+    m_forward.swap(forward);
+    m_reverse.swap(reverse);
+    return arcs.size();
+  }
+  //@}
+
   /**\brief Remove an arc from \a from to \a to,
     *       optionally ordered by \a beforeFrom and \a beforeTo.
     *
@@ -651,6 +712,10 @@ public:
     if (it != m_forward.end())
     {
       didDisconnect = it->second.erase(to) > 0;
+      if (didDisconnect && it->second.empty())
+      {
+        m_forward.erase(it);
+      }
       if (didDisconnect && BidirIndex::value)
       {
         // TODO: Check that this returns > 0:
@@ -661,7 +726,7 @@ public:
         }
       }
     }
-    else if (std::is_same<FromType, ToType>::value && !Directed::value)
+    if (!didDisconnect && std::is_same<FromType, ToType>::value && !Directed::value)
     {
       // We may have stored this arc as to → from.
       if (BidirIndex::value)
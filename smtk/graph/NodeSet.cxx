@@ -24,9 +24,14 @@ bool NodeSet::Compare::operator()(
   return (!lhs ? true : (!rhs ? false : lhs->id() < rhs->id()));
 }
 
-const NodeSet::Container& NodeSet::nodes() const
+NodeSet::Container NodeSet::nodes() const
 {
-  return m_nodes;
+  return Container(m_nodes.begin(), m_nodes.end());
+}
+
+std::size_t NodeSet::numberOfNodes() const
+{
+  return m_nodes.size();
 }
 
 void NodeSet::visit(std::function<void(const smtk::resource::ComponentPtr&)>& v) const
@@ -39,64 +44,36 @@ void NodeSet::visit(std::function<void(const smtk::resource::ComponentPtr&)>& v)
 
 NodeSet::NodeType NodeSet::find(const smtk::common::UUID& uuid) const
 {
-  struct QueryKey : resource::Component
-  {
-    QueryKey(const smtk::common::UUID& id)
-      : m_id(id)
-    {
-    }
-    const smtk::common::UUID& id() const final { return m_id; }
-    bool setId(const smtk::common::UUID&) final { return false; }
-    const smtk::resource::ResourcePtr resource() const final
-    {
-      return smtk::resource::ResourcePtr();
-    }
-
-    const smtk::common::UUID& m_id;
-  };
-
-  auto it = m_nodes.find(std::make_shared<QueryKey>(uuid));
-  if (it != m_nodes.end())
-  {
-    return *it;
-  }
-  return std::shared_ptr<smtk::resource::Component>();
+  const auto* node = m_nodes.find(uuid);
+  return node ? *node : NodeType();
 }
 
 smtk::resource::Component* NodeSet::component(const smtk::common::UUID& uuid) const
 {
-  struct QueryKey : resource::Component
-  {
-    QueryKey(const smtk::common::UUID& id)
-      : m_id(id)
-    {
-    }
-    const smtk::common::UUID& id() const final { return m_id; }
-    bool setId(const smtk::common::UUID&) final { return false; }
-    const smtk::resource::ResourcePtr resource() const final
-    {
-      return smtk::resource::ResourcePtr();
-    }
-
-    const smtk::common::UUID& m_id;
-  };
-
-  auto it = m_nodes.find(std::make_shared<QueryKey>(uuid));
-  if (it != m_nodes.end())
-  {
-    return it->get();
-  }
-  return nullptr;
+  const auto* node = m_nodes.find(uuid);
+  return node ? node->get() : nullptr;
 }
 
 std::size_t NodeSet::eraseNodes(const smtk::graph::ComponentPtr& node)
 {
-  return m_nodes.erase(node);
+  return node && m_nodes.erase(node->id()) ? 1 : 0;
 }
 
 bool NodeSet::insertNode(const smtk::graph::ComponentPtr& node)
 {
-  return m_nodes.insert(node).second;
+  return m_nodes.insert(node);
+}
+
+std::size_t NodeSet::insertNodes(const std::vector<smtk::graph::ComponentPtr>& nodes)
+{
+  // Size the index once rather than rehashing as the batch is inserted.
+  m_nodes.reserve(m_nodes.size() + nodes.size());
+  std::size_t count = 0;
+  for (const auto& node : nodes)
+  {
+    count += m_nodes.insert(node) ? 1 : 0;
+  }
+  return count;
 }
 
 } // namespace graph
@@ -12,17 +12,27 @@
 #define smtk_graph_NodeSet_h
 
 #include "smtk/PublicPointerDefs.h"
+#include "smtk/common/Deprecation.h"
 #include "smtk/common/UUID.h"
+#include "smtk/graph/detail/NodeIndex.h"
 
 #include <functional>
 #include <memory>
 #include <set>
+#include <vector>
 
 namespace smtk
 {
 namespace graph
 {
 
+/**\brief The default node storage for graph resources.
+  *
+  * Nodes are held in a dense vector (so visitation is a linear scan) and
+  * indexed by UUID in a hash table (so lookups take constant time).
+  * See detail::NodeIndex. Nodes are visited in no particular order;
+  * the deprecated nodes() method returns them ordered by UUID as before.
+  */
 class SMTKCORE_EXPORT NodeSet
 {
   struct SMTKCORE_EXPORT Compare
@@ -34,9 +44,17 @@ class SMTKCORE_EXPORT NodeSet
 
   using NodeType = smtk::resource::ComponentPtr;
   using Container = std::set<NodeType, Compare>;
+  using Index = detail::NodeIndex<NodeType>;
 
 public:
-  const Container& nodes() const;
+  /// Return a copy of all nodes ordered by UUID.
+  ///
+  /// Nodes are no longer stored in this order, so each call copies and
+  /// sorts every node. Use visit() and numberOfNodes() instead.
+  SMTK_DEPRECATED_IN_NEXT("Use visit() or numberOfNodes() instead.")
+  Container nodes() const;
+  /// Return the number of nodes held.
+  std::size_t numberOfNodes() const;
 
   void visit(std::function<void(const smtk::resource::ComponentPtr&)>& v) const;
   NodeType find(const smtk::common::UUID& /* uuid */) const;
@@ -45,9 +63,11 @@ public:
 protected:
   std::size_t eraseNodes(const smtk::graph::ComponentPtr& node);
   bool insertNode(const smtk::graph::ComponentPtr& node);
+  /// Insert a batch of nodes, returning the number inserted.
+  std::size_t insertNodes(const std::vector<smtk::graph::ComponentPtr>& nodes);
 
 private:
-  Container m_nodes;
+  Index m_nodes;
 };
 
 } // namespace graph
@@ -30,12 +30,16 @@
 #include "smtk/resource/filter/Filter.h"
 #include "smtk/resource/filter/ResourceActions.h"
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <typeindex>
+#include <utility>
+#include <vector>
 
 namespace smtk
 {
@@ -149,6 +153,56 @@ public:
     return NodeContainer::insertNode(node);
   }
 
+  /**\brief Add a batch of nodes to the resource, returning the number inserted.
+    *
+    * This is used by JSON deserialization and is faster than adding nodes
+    * one at a time since node storage is sized once for the whole batch.
+    * Nodes whose type is not accepted by the resource and nodes that are
+    * already present are skipped.
+    */
+  std::size_t addNodes(const std::vector<smtk::graph::ComponentPtr>& nodes)
+  {
+    std::size_t rejected = 0;
+    for (const auto& node : nodes)
+    {
+      if (!node || node->resource().get() != this)
+      {
+        throw std::invalid_argument(
+          "Cannot add nodes that reference a different (or null) resource.");
+      }
+      rejected += this->isNodeTypeAcceptable(node) ? 0 : 1;
+    }
+    if (rejected == 0)
+    {
+      return this->insertNodeBatch(nodes, 0);
+    }
+    std::vector<smtk::graph::ComponentPtr> accepted;
+    accepted.reserve(nodes.size() - rejected);
+    std::copy_if(
+      nodes.begin(),
+      nodes.end(),
+      std::back_inserter(accepted),
+      [this](const smtk::graph::ComponentPtr& node) { return this->isNodeTypeAcceptable(node); });
+    return this->insertNodeBatch(accepted, 0);
+  }
+
+  /**\brief Connect a batch of \a arcs of the given \a ArcTraits type,
+    *       returning the number of arcs inserted.
+    *
+    * When the resource has no arcs of this type yet, forward and reverse
+    * indices are built from the sorted batch rather than by inserting
+    * arcs one at a time; if an \a executor is provided, the indices are
+    * built concurrently.
+    */
+  template<typename ArcTraits>
+  typename std::enable_if<is_arc<ArcTraits>::value, std::size_t>::type connectArcs(
+    typename ArcImplementation<ArcTraits>::ArcList arcs,
+    smtk::common::Executor* executor = nullptr)
+  {
+    auto* arcsOfType = m_arcs.at<ArcTraits>();
+    return arcsOfType ? arcsOfType->connectBatch(std::move(arcs), executor) : 0;
+  }
+
   /// Remove a node from the resource. Return true if the removal took place.
   template<typename NodeType>
   typename std::enable_if<is_node<NodeType>::value, bool>::type remove(
@@ -168,6 +222,13 @@ public:
     return smtk::resource::filter::Filter<smtk::graph::filter::Grammar>(filterString);
   }
 
+  /// Return the parsed rules of a string query (for use by filter()).
+  std::shared_ptr<const smtk::resource::filter::Rules> queryRules(
+    const std::string& filterString) const override
+  {
+    return smtk::resource::filter::Filter<smtk::graph::filter::Grammar>(filterString).rules();
+  }
+
   /// Copy construction of resources is disallowed.
   Resource(const Resource&) noexcept = delete;
 
@@ -387,6 +448,25 @@ protected:
     return NodeContainer::insertNode(node);
   }
 
+  /// Insert nodes in bulk when the node container supports it.
+  template<typename Self = Resource>
+  auto insertNodeBatch(const std::vector<smtk::graph::ComponentPtr>& nodes, int)
+    -> decltype(std::declval<Self&>().insertNodes(nodes))
+  {
+    return NodeContainer::insertNodes(nodes);
+  }
+
+  /// Insert nodes one at a time for node containers without bulk insertion.
+  std::size_t insertNodeBatch(const std::vector<smtk::graph::ComponentPtr>& nodes, long)
+  {
+    std::size_t count = 0;
+    for (const auto& node : nodes)
+    {
+      count += NodeContainer::insertNode(node) ? 1 : 0;
+    }
+    return count;
+  }
+
   /// Perform a run-time check to validate that a node is acceptable to this resource.
   bool isNodeTypeAcceptable(const smtk::graph::ComponentPtr& node) override
   {
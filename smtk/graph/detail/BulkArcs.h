@@ -0,0 +1,169 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#ifndef smtk_graph_detail_BulkArcs_h
+#define smtk_graph_detail_BulkArcs_h
+
+#include "smtk/common/Executor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace smtk
+{
+namespace graph
+{
+namespace detail
+{
+
+/// Batches of arcs smaller than this are not worth splitting across threads.
+constexpr std::size_t MinimumConcurrentArcs = 4096;
+
+/// Order arcs by their first endpoint and then by their second endpoint.
+struct ArcOrder
+{
+  template<typename First, typename Second>
+  bool operator()(const std::pair<First, Second>& aa, const std::pair<First, Second>& bb) const
+  {
+    if (std::less<First>()(aa.first, bb.first))
+    {
+      return true;
+    }
+    return !std::less<First>()(bb.first, aa.first) && std::less<Second>()(aa.second, bb.second);
+  }
+};
+
+/**\brief Prepare a batch of arcs for bulk insertion.
+  *
+  * Arcs with a null endpoint and duplicate arcs are removed and the
+  * remainder are sorted with ArcOrder.
+  * When \a autoUndirected is true, "a→b" and "b→a" are the same arc;
+  * only the orientation listed first in \a arcs is kept, which matches
+  * what connecting the arcs one at a time would produce.
+  */
+template<typename From, typename To>
+void canonicalizeArcs(std::vector<std::pair<const From*, const To*>>& arcs, bool autoUndirected)
+{
+  using Arc = std::pair<const From*, const To*>;
+  arcs.erase(
+    std::remove_if(
+      arcs.begin(), arcs.end(), [](const Arc& arc) { return !arc.first || !arc.second; }),
+    arcs.end());
+  if (autoUndirected)
+  {
+    auto unordered = [](const Arc& arc) {
+      const void* aa = arc.first;
+      const void* bb = arc.second;
+      return std::less<const void*>()(bb, aa) ? std::make_pair(bb, aa) : std::make_pair(aa, bb);
+    };
+    std::stable_sort(arcs.begin(), arcs.end(), [&unordered](const Arc& aa, const Arc& bb) {
+      return ArcOrder()(unordered(aa), unordered(bb));
+    });
+    arcs.erase(
+      std::unique(
+        arcs.begin(),
+        arcs.end(),
+        [&unordered](const Arc& aa, const Arc& bb) { return unordered(aa) == unordered(bb); }),
+      arcs.end());
+  }
+  std::sort(arcs.begin(), arcs.end(), ArcOrder());
+  arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+}
+
+/// Return \a arcs with their endpoints swapped, sorted with ArcOrder.
+template<typename From, typename To>
+std::vector<std::pair<const To*, const From*>> reverseArcs(
+  const std::vector<std::pair<const From*, const To*>>& arcs)
+{
+  std::vector<std::pair<const To*, const From*>> result;
+  result.reserve(arcs.size());
+  for (const auto& arc : arcs)
+  {
+    result.emplace_back(arc.second, arc.first);
+  }
+  std::sort(result.begin(), result.end(), ArcOrder());
+  return result;
+}
+
+/**\brief Build a hashed adjacency table from \a arcs, which must be sorted by
+  *       their first endpoint.
+  *
+  * Since each node's neighbors are contiguous, every table entry is sized
+  * once rather than growing as neighbors are inserted.
+  */
+template<typename Key, typename Value>
+std::unordered_map<const Key*, std::unordered_set<const Value*>> buildAdjacency(
+  const std::vector<std::pair<const Key*, const Value*>>& arcs)
+{
+  std::unordered_map<const Key*, std::unordered_set<const Value*>> result;
+  std::size_t keys = 0;
+  for (auto it = arcs.begin(); it != arcs.end(); ++it)
+  {
+    keys += (it == arcs.begin() || std::prev(it)->first != it->first) ? 1 : 0;
+  }
+  result.reserve(keys);
+  for (auto it = arcs.begin(); it != arcs.end();)
+  {
+    auto last = it;
+    while (last != arcs.end() && last->first == it->first)
+    {
+      ++last;
+    }
+    auto& neighbors = result[it->first];
+    neighbors.reserve(static_cast<std::size_t>(last - it));
+    for (; it != last; ++it)
+    {
+      neighbors.insert(it->second);
+    }
+  }
+  return result;
+}
+
+/**\brief Invoke \a aside on \a executor while \a inlineWork runs on the calling thread.
+  *
+  * This returns once both functors have completed, rethrowing any exception
+  * either of them threw. If \a executor is null, both run on the calling
+  * thread.
+  */
+template<typename Aside, typename Inline>
+void buildConcurrently(smtk::common::Executor* executor, Aside&& aside, Inline&& inlineWork)
+{
+  if (!executor)
+  {
+    aside();
+    inlineWork();
+    return;
+  }
+  auto done = (*executor)([&aside]() { aside(); });
+  try
+  {
+    inlineWork();
+  }
+  catch (...)
+  {
+    // The task refers to this stack frame; it must finish before we unwind.
+    executor->wait(done);
+    throw;
+  }
+  executor->wait(done);
+  done.get();
+}
+
+} // namespace detail
+} // namespace graph
+} // namespace smtk
+
+#endif // smtk_graph_detail_BulkArcs_h
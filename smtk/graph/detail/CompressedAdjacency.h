@@ -0,0 +1,479 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#ifndef smtk_graph_detail_CompressedAdjacency_h
+#define smtk_graph_detail_CompressedAdjacency_h
+
+#include "smtk/common/Visit.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace smtk
+{
+namespace graph
+{
+namespace detail
+{
+
+/**\brief One direction of an adjacency relation held in compressed sparse row form.
+  *
+  * Each node with arcs (a "row") owns a contiguous, sorted range of
+  * neighbors in a single shared array. Since rewriting that array on every
+  * edit would be expensive, edits are staged:
+  *
+  * + removing a neighbor from the compressed range marks it as removed;
+  * + adding a neighbor that is not in the compressed range appends it to a
+  *   small per-row delta buffer. When a row's buffer grows past
+  *   MaximumRowDelta, the row is moved to the end of the array.
+  *
+  * Once the number of staged edits grows to half the size of the
+  * compressed array, the array is rebuilt (compacted) so that visiting neighbors is a
+  * contiguous scan and testing for a neighbor is a binary search.
+  * Call compact() after bulk edits to force this.
+  *
+  * Neighbors must not be added or removed while visiting them.
+  */
+template<typename Key, typename Value>
+class CompressedAdjacency
+{
+public:
+  /// The minimum number of staged edits that triggers compaction.
+  static constexpr std::size_t MinimumStagedEdits = 1024;
+  /// The maximum number of staged additions held for a single row.
+  static constexpr std::size_t MaximumRowDelta = 64;
+
+  /// Return the number of neighbors of \a key.
+  std::size_t degree(const Key* key) const
+  {
+    const Row* row = this->row(key);
+    return row ? row->m_degree : 0;
+  }
+
+  /// Return the total number of (key, neighbor) pairs.
+  std::size_t size() const { return m_size; }
+
+  /// Return true if no key has any neighbors.
+  bool empty() const { return m_size == 0; }
+
+  /// Return true if \a value is a neighbor of \a key.
+  bool contains(const Key* key, const Value* value) const
+  {
+    const Row* row = this->row(key);
+    if (!row || row->m_degree == 0)
+    {
+      return false;
+    }
+    std::size_t position = this->search(*row, value);
+    if (position != Absent)
+    {
+      return !m_removed[position];
+    }
+    return row->m_delta &&
+      std::find(row->m_delta->begin(), row->m_delta->end(), value) != row->m_delta->end();
+  }
+
+  /**\brief Invoke \a visitor on each neighbor of \a key.
+    *
+    * The \a visitor must return smtk::common::Visit; neighbors in the
+    * compressed range are visited in address order and followed by any
+    * staged neighbors.
+    */
+  template<typename Functor>
+  smtk::common::Visited visit(const Key* key, Functor visitor) const
+  {
+    const Row* row = this->row(key);
+    if (!row || row->m_degree == 0)
+    {
+      return smtk::common::Visited::Empty;
+    }
+    for (std::size_t ii = row->m_begin; ii < row->m_begin + row->m_count; ++ii)
+    {
+      if (!m_removed[ii] && visitor(m_neighbors[ii]) == smtk::common::Visit::Halt)
+      {
+        return smtk::common::Visited::Some;
+      }
+    }
+    if (row->m_delta)
+    {
+      for (const auto* value : *row->m_delta)
+      {
+        if (visitor(value) == smtk::common::Visit::Halt)
+        {
+          return smtk::common::Visited::Some;
+        }
+      }
+    }
+    return smtk::common::Visited::All;
+  }
+
+  /**\brief Invoke \a visitor on each key with at least one neighbor.
+    *
+    * The \a visitor must return smtk::common::Visit.
+    */
+  template<typename Functor>
+  smtk::common::Visited visitKeys(Functor visitor) const
+  {
+    bool didVisit = false;
+    for (const auto& row : m_rows)
+    {
+      if (row.m_degree > 0)
+      {
+        didVisit = true;
+        if (visitor(row.m_key) == smtk::common::Visit::Halt)
+        {
+          return smtk::common::Visited::Some;
+        }
+      }
+    }
+    return didVisit ? smtk::common::Visited::All : smtk::common::Visited::Empty;
+  }
+
+  /// Add \a value as a neighbor of \a key, returning false if it already was one.
+  bool insert(const Key* key, const Value* value)
+  {
+    auto it = m_rowIndex.find(key);
+    if (it == m_rowIndex.end())
+    {
+      it = m_rowIndex.emplace(key, m_rows.size()).first;
+      m_rows.emplace_back(key, m_neighbors.size());
+    }
+    Row& row = m_rows[it->second];
+    std::size_t position = this->search(row, value);
+    if (position != Absent)
+    {
+      if (!m_removed[position])
+      {
+        return false;
+      }
+      m_removed[position] = false;
+      --m_staged;
+    }
+    else
+    {
+      if (!row.m_delta)
+      {
+        row.m_delta.reset(new std::vector<const Value*>);
+      }
+      else if (std::find(row.m_delta->begin(), row.m_delta->end(), value) != row.m_delta->end())
+      {
+        return false;
+      }
+      row.m_delta->push_back(value);
+      ++m_staged;
+    }
+    ++row.m_degree;
+    ++m_size;
+    if (row.m_delta && row.m_delta->size() > MaximumRowDelta)
+    {
+      this->compactRow(row);
+    }
+    this->compactIfNeeded();
+    return true;
+  }
+
+  /// Remove \a value as a neighbor of \a key, returning false if it was not one.
+  bool erase(const Key* key, const Value* value)
+  {
+    Row* row = this->row(key);
+    if (!row || row->m_degree == 0 || !this->eraseFromRow(*row, value))
+    {
+      return false;
+    }
+    this->compactIfNeeded();
+    return true;
+  }
+
+  /**\brief Remove every neighbor of \a key, returning the removed neighbors.
+    *
+    * This is used to disconnect a node completely; callers holding the
+    * opposite direction of the relation should erase \a key from each of
+    * the returned neighbors.
+    */
+  std::vector<const Value*> eraseKey(const Key* key)
+  {
+    std::vector<const Value*> result;
+    Row* row = this->row(key);
+    if (!row || row->m_degree == 0)
+    {
+      return result;
+    }
+    result.reserve(row->m_degree);
+    for (std::size_t ii = row->m_begin; ii < row->m_begin + row->m_count; ++ii)
+    {
+      if (!m_removed[ii])
+      {
+        result.push_back(m_neighbors[ii]);
+        m_removed[ii] = true;
+        ++m_staged;
+      }
+    }
+    if (row->m_delta)
+    {
+      result.insert(result.end(), row->m_delta->begin(), row->m_delta->end());
+      m_staged -= row->m_delta->size();
+      row->m_delta.reset();
+    }
+    m_size -= row->m_degree;
+    row->m_degree = 0;
+    this->compactIfNeeded();
+    return result;
+  }
+
+  /**\brief Remove \a value from the neighbors of every key, returning the number removed.
+    *
+    * This must examine every row and should only be used when no index of
+    * the opposite direction is available.
+    */
+  std::size_t eraseValue(const Value* value)
+  {
+    std::size_t count = 0;
+    for (auto& row : m_rows)
+    {
+      if (row.m_degree > 0 && this->eraseFromRow(row, value))
+      {
+        ++count;
+      }
+    }
+    this->compactIfNeeded();
+    return count;
+  }
+
+  /**\brief Fold all staged edits into the compressed array.
+    *
+    * Each row's neighbors are sorted so they may be binary-searched.
+    * Rows without neighbors are discarded once they make up half of
+    * all rows.
+    */
+  void compact()
+  {
+    std::size_t emptyRows = static_cast<std::size_t>(std::count_if(
+      m_rows.begin(), m_rows.end(), [](const Row& row) { return row.m_degree == 0; }));
+    bool dropEmptyRows = 2 * emptyRows > m_rows.size();
+
+    std::vector<const Value*> neighbors;
+    neighbors.reserve(m_size);
+    std::size_t kept = 0;
+    for (std::size_t rr = 0; rr < m_rows.size(); ++rr)
+    {
+      Row& row = m_rows[rr];
+      if (dropEmptyRows && row.m_degree == 0)
+      {
+        continue;
+      }
+      std::size_t begin = neighbors.size();
+      for (std::size_t ii = row.m_begin; ii < row.m_begin + row.m_count; ++ii)
+      {
+        if (!m_removed[ii])
+        {
+          neighbors.push_back(m_neighbors[ii]);
+        }
+      }
+      if (row.m_delta)
+      {
+        neighbors.insert(neighbors.end(), row.m_delta->begin(), row.m_delta->end());
+        row.m_delta.reset();
+      }
+      std::sort(neighbors.begin() + begin, neighbors.end(), std::less<const Value*>());
+      row.m_begin = begin;
+      row.m_count = static_cast<std::uint32_t>(neighbors.size() - begin);
+      if (kept != rr)
+      {
+        m_rows[kept] = std::move(row);
+      }
+      ++kept;
+    }
+    m_rows.erase(m_rows.begin() + kept, m_rows.end());
+    if (dropEmptyRows)
+    {
+      m_rowIndex.clear();
+      for (std::size_t rr = 0; rr < m_rows.size(); ++rr)
+      {
+        m_rowIndex.emplace(m_rows[rr].m_key, rr);
+      }
+    }
+    m_neighbors.swap(neighbors);
+    m_removed.assign(m_neighbors.size(), false);
+    m_staged = 0;
+  }
+
+  /**\brief Replace all neighbors of all keys with \a pairs.
+    *
+    * The \a pairs must be sorted by key and then by neighbor (see
+    * detail::ArcOrder) and must not contain duplicates. Rows are written
+    * directly into the compressed array, so no compaction is required.
+    */
+  void assign(const std::vector<std::pair<const Key*, const Value*>>& pairs)
+  {
+    this->clear();
+    std::size_t keys = 0;
+    for (std::size_t ii = 0; ii < pairs.size(); ++ii)
+    {
+      keys += (ii == 0 || pairs[ii - 1].first != pairs[ii].first) ? 1 : 0;
+    }
+    m_rowIndex.reserve(keys);
+    m_rows.reserve(keys);
+    m_neighbors.reserve(pairs.size());
+    for (std::size_t ii = 0; ii < pairs.size();)
+    {
+      const Key* key = pairs[ii].first;
+      m_rowIndex.emplace(key, m_rows.size());
+      m_rows.emplace_back(key, m_neighbors.size());
+      Row& row = m_rows.back();
+      for (; ii < pairs.size() && pairs[ii].first == key; ++ii)
+      {
+        m_neighbors.push_back(pairs[ii].second);
+      }
+      row.m_count = static_cast<std::uint32_t>(m_neighbors.size() - row.m_begin);
+      row.m_degree = row.m_count;
+    }
+    m_removed.assign(m_neighbors.size(), false);
+    m_size = m_neighbors.size();
+  }
+
+  /// Remove all neighbors of all keys.
+  void clear()
+  {
+    m_rowIndex.clear();
+    m_rows.clear();
+    m_neighbors.clear();
+    m_removed.clear();
+    m_size = 0;
+    m_staged = 0;
+  }
+
+private:
+  static constexpr std::size_t Absent = static_cast<std::size_t>(-1);
+
+  struct Row
+  {
+    Row(const Key* key, std::size_t begin)
+      : m_key(key)
+      , m_begin(begin)
+    {
+    }
+
+    const Key* m_key;
+    // The range of m_neighbors holding this row's compressed neighbors.
+    std::size_t m_begin;
+    std::uint32_t m_count{ 0 };
+    // The number of neighbors (not marked as removed) including staged ones.
+    std::uint32_t m_degree{ 0 };
+    // Neighbors added since the last compaction (allocated only when needed).
+    std::unique_ptr<std::vector<const Value*>> m_delta;
+  };
+
+  const Row* row(const Key* key) const
+  {
+    auto it = m_rowIndex.find(key);
+    return it == m_rowIndex.end() ? nullptr : &m_rows[it->second];
+  }
+
+  Row* row(const Key* key)
+  {
+    auto it = m_rowIndex.find(key);
+    return it == m_rowIndex.end() ? nullptr : &m_rows[it->second];
+  }
+
+  // Return the position of \a value in the compressed range of \a row (or Absent).
+  std::size_t search(const Row& row, const Value* value) const
+  {
+    auto begin = m_neighbors.begin() + row.m_begin;
+    auto end = begin + row.m_count;
+    auto it = std::lower_bound(begin, end, value, std::less<const Value*>());
+    return (it != end && *it == value) ? static_cast<std::size_t>(it - m_neighbors.begin())
+                                       : Absent;
+  }
+
+  // Remove \a value from \a row without compacting.
+  bool eraseFromRow(Row& row, const Value* value)
+  {
+    std::size_t position = this->search(row, value);
+    if (position != Absent)
+    {
+      if (m_removed[position])
+      {
+        return false;
+      }
+      m_removed[position] = true;
+      ++m_staged;
+    }
+    else
+    {
+      if (!row.m_delta)
+      {
+        return false;
+      }
+      auto dit = std::find(row.m_delta->begin(), row.m_delta->end(), value);
+      if (dit == row.m_delta->end())
+      {
+        return false;
+      }
+      *dit = row.m_delta->back();
+      row.m_delta->pop_back();
+      --m_staged;
+    }
+    --row.m_degree;
+    --m_size;
+    return true;
+  }
+
+  // Move \a row's neighbors (including staged ones) to a sorted range at the
+  // end of m_neighbors. The old range is left behind as removed entries.
+  void compactRow(Row& row)
+  {
+    std::size_t begin = m_neighbors.size();
+    for (std::size_t ii = row.m_begin; ii < row.m_begin + row.m_count; ++ii)
+    {
+      if (!m_removed[ii])
+      {
+        const Value* value = m_neighbors[ii];
+        m_neighbors.push_back(value);
+        m_removed[ii] = true;
+        ++m_staged;
+      }
+    }
+    m_neighbors.insert(m_neighbors.end(), row.m_delta->begin(), row.m_delta->end());
+    m_staged -= row.m_delta->size();
+    row.m_delta.reset();
+    std::sort(m_neighbors.begin() + begin, m_neighbors.end(), std::less<const Value*>());
+    m_removed.resize(m_neighbors.size(), false);
+    row.m_begin = begin;
+    row.m_count = static_cast<std::uint32_t>(m_neighbors.size() - begin);
+  }
+
+  void compactIfNeeded()
+  {
+    if (m_staged > MinimumStagedEdits && 2 * m_staged > m_neighbors.size())
+    {
+      this->compact();
+    }
+  }
+
+  std::unordered_map<const Key*, std::size_t> m_rowIndex;
+  std::vector<Row> m_rows;
+  std::vector<const Value*> m_neighbors;
+  std::vector<bool> m_removed;
+  // The number of (key, neighbor) pairs.
+  std::size_t m_size{ 0 };
+  // The number of staged edits (removal marks plus delta entries).
+  std::size_t m_staged{ 0 };
+};
+
+} // namespace detail
+} // namespace graph
+} // namespace smtk
+
+#endif // smtk_graph_detail_CompressedAdjacency_h
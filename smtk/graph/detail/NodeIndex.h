@@ -0,0 +1,233 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#ifndef smtk_graph_detail_NodeIndex_h
+#define smtk_graph_detail_NodeIndex_h
+
+#include "smtk/common/UUID.h"
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace smtk
+{
+namespace graph
+{
+namespace detail
+{
+
+/**\brief Dense storage of graph nodes with a hashed index by UUID.
+  *
+  * Nodes are held contiguously in a vector so that visiting them is a
+  * linear scan. Erasing a node moves the last node into its place, so the
+  * order of nodes is arbitrary and changes as nodes are erased.
+  *
+  * Nodes are located by UUID through an open-addressed hash table (linear
+  * probing with backward-shift deletion) that maps UUIDs to positions in the
+  * vector. Each table slot caches its node's hash so that probing rarely
+  * dereferences a node. Insertion, erasure, and lookup take constant time
+  * on average.
+  *
+  * \a NodePtr must be a (smart) pointer to a type with an `id()` method
+  * returning a UUID. A node's UUID must not change while it is indexed;
+  * erase it, change its UUID, and then insert it again.
+  */
+template<typename NodePtr>
+class NodeIndex
+{
+public:
+  using Container = std::vector<NodePtr>;
+  using const_iterator = typename Container::const_iterator;
+
+  /// Return the nodes in storage order.
+  const Container& nodes() const { return m_nodes; }
+  const_iterator begin() const { return m_nodes.begin(); }
+  const_iterator end() const { return m_nodes.end(); }
+  std::size_t size() const { return m_nodes.size(); }
+  bool empty() const { return m_nodes.empty(); }
+
+  /// Return the stored pointer to the node with the given \a uid (or null if absent).
+  const NodePtr* find(const smtk::common::UUID& uid) const
+  {
+    std::size_t slot = this->locate(uid, NodeIndex::hashOf(uid));
+    return slot == Empty ? nullptr : &m_nodes[m_slots[slot].m_index];
+  }
+
+  /// Insert \a node, returning false if a node with the same UUID is present.
+  bool insert(const NodePtr& node)
+  {
+    if (!node)
+    {
+      return false;
+    }
+    std::size_t hash = NodeIndex::hashOf(node->id());
+    if (this->locate(node->id(), hash) != Empty)
+    {
+      return false;
+    }
+    if (2 * (m_nodes.size() + 1) > m_slots.size())
+    {
+      this->rehash(m_slots.empty() ? MinimumSlots : 2 * m_slots.size());
+    }
+    this->place(hash, m_nodes.size());
+    m_nodes.push_back(node);
+    m_hashes.push_back(hash);
+    return true;
+  }
+
+  /// Erase the node with the given \a uid, returning false if it was absent.
+  bool erase(const smtk::common::UUID& uid)
+  {
+    std::size_t slot = this->locate(uid, NodeIndex::hashOf(uid));
+    if (slot == Empty)
+    {
+      return false;
+    }
+
+    // Move the last node into the vacated position.
+    std::size_t index = m_slots[slot].m_index;
+    std::size_t last = m_nodes.size() - 1;
+    if (index != last)
+    {
+      std::size_t lastSlot = this->home(m_hashes[last]);
+      while (m_slots[lastSlot].m_index != last)
+      {
+        lastSlot = (lastSlot + 1) & m_mask;
+      }
+      m_slots[lastSlot].m_index = index;
+      m_nodes[index] = std::move(m_nodes[last]);
+      m_hashes[index] = m_hashes[last];
+    }
+    m_nodes.pop_back();
+    m_hashes.pop_back();
+
+    // Shift following entries back so that no probe sequence is broken.
+    std::size_t hole = slot;
+    for (std::size_t next = (hole + 1) & m_mask; m_slots[next].m_index != Empty;
+         next = (next + 1) & m_mask)
+    {
+      std::size_t home = this->home(m_slots[next].m_hash);
+      if (((next - home) & m_mask) >= ((next - hole) & m_mask))
+      {
+        m_slots[hole] = m_slots[next];
+        hole = next;
+      }
+    }
+    m_slots[hole].m_index = Empty;
+    return true;
+  }
+
+  /// Prepare to hold at least \a count nodes without rehashing.
+  void reserve(std::size_t count)
+  {
+    m_nodes.reserve(count);
+    m_hashes.reserve(count);
+    std::size_t slots = MinimumSlots;
+    while (slots < 2 * count)
+    {
+      slots *= 2;
+    }
+    if (slots > m_slots.size())
+    {
+      this->rehash(slots);
+    }
+  }
+
+  /// Remove all nodes.
+  void clear()
+  {
+    m_nodes.clear();
+    m_hashes.clear();
+    m_slots.clear();
+    m_mask = 0;
+    m_shift = 0;
+  }
+
+private:
+  static constexpr std::size_t Empty = std::numeric_limits<std::size_t>::max();
+  static constexpr std::size_t MinimumSlots = 16;
+
+  struct Slot
+  {
+    std::size_t m_hash{ 0 };
+    std::size_t m_index{ Empty };
+  };
+
+  static std::size_t hashOf(const smtk::common::UUID& uid)
+  {
+    return std::hash<smtk::common::UUID>()(uid);
+  }
+
+  // Fibonacci hashing spreads UUIDs whose trailing bytes are not random
+  // (e.g., time-based UUIDs) across the table.
+  std::size_t home(std::size_t hash) const
+  {
+    return static_cast<std::size_t>(
+      (static_cast<std::uint64_t>(hash) * UINT64_C(0x9E3779B97F4A7C15)) >> m_shift);
+  }
+
+  std::size_t locate(const smtk::common::UUID& uid, std::size_t hash) const
+  {
+    if (m_slots.empty())
+    {
+      return Empty;
+    }
+    for (std::size_t slot = this->home(hash); m_slots[slot].m_index != Empty;
+         slot = (slot + 1) & m_mask)
+    {
+      if (m_slots[slot].m_hash == hash && m_nodes[m_slots[slot].m_index]->id() == uid)
+      {
+        return slot;
+      }
+    }
+    return Empty;
+  }
+
+  void place(std::size_t hash, std::size_t index)
+  {
+    std::size_t slot = this->home(hash);
+    while (m_slots[slot].m_index != Empty)
+    {
+      slot = (slot + 1) & m_mask;
+    }
+    m_slots[slot].m_hash = hash;
+    m_slots[slot].m_index = index;
+  }
+
+  // Resize the table to \a slots entries (a power of two) and re-place every node.
+  void rehash(std::size_t slots)
+  {
+    m_slots.assign(slots, Slot());
+    m_mask = slots - 1;
+    m_shift = 64;
+    for (std::size_t size = slots; size > 1; size >>= 1)
+    {
+      --m_shift;
+    }
+    for (std::size_t ii = 0; ii < m_nodes.size(); ++ii)
+    {
+      this->place(m_hashes[ii], ii);
+    }
+  }
+
+  Container m_nodes;
+  std::vector<std::size_t> m_hashes;
+  std::vector<Slot> m_slots;
+  std::size_t m_mask{ 0 };
+  unsigned int m_shift{ 0 };
+};
+
+} // namespace detail
+} // namespace graph
+} // namespace smtk
+
+#endif // smtk_graph_detail_NodeIndex_h
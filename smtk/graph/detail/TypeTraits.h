@@ -15,6 +15,7 @@
 #include "smtk/common/Visit.h"
 
 #include "smtk/graph/ArcProperties.h"
+#include "smtk/graph/CompressedArcs.h"
 #include "smtk/graph/ExplicitArcs.h"
 
 #include <functional>
@@ -48,7 +49,8 @@ struct SelectArcContainer<
   typename std::enable_if<
     conjunction<
       typename ArcProperties<ArcTraits>::isExplicit,
-      negation<typename ArcProperties<ArcTraits>::isOrdered>>::value,
+      negation<typename ArcProperties<ArcTraits>::isOrdered>,
+      negation<typename ArcProperties<ArcTraits>::isCompressed>>::value,
     ArcTraits>::type> : public ExplicitArcs<ArcTraits>
 {
   static_assert(ArcProperties<ArcTraits>::isExplicit::value, R"(
@@ -65,6 +67,34 @@ struct SelectArcContainer<
   }
 };
 
+/**\brief Specialize explicit arc storage when compressed.
+  *
+  * Arc traits that provide a truthy `CompressedStorage` type-alias
+  * are stored in compressed sparse row form, which uses much less
+  * memory per arc than ExplicitArcs. Like ExplicitArcs, this storage
+  * does not preserve arc order, so traits may not also request
+  * ordered storage.
+  */
+template<typename ArcTraits>
+struct SelectArcContainer<
+  ArcTraits,
+  typename std::enable_if<ArcProperties<ArcTraits>::isCompressed::value, ArcTraits>::type>
+  : public CompressedArcs<ArcTraits>
+{
+  static_assert(ArcProperties<ArcTraits>::isExplicit::value, R"(
+  Cannot use compressed arc storage for arcs that do not satisfy the explicit property.)");
+  static_assert(
+    !ArcProperties<ArcTraits>::template hasOrderedMark<ArcTraits>::value,
+    "Compressed arc storage cannot preserve arc order; remove Ordered or CompressedStorage.");
+  using type = CompressedArcs<ArcTraits>;
+
+  SelectArcContainer() = default;
+  SelectArcContainer(const ArcTraits& traits)
+    : CompressedArcs<ArcTraits>(traits)
+  {
+  }
+};
+
 /**\brief Store arcs explicitly with a random-access ordering.
   *
   * If an arc's traits object provides accessors/manipulators
@@ -78,7 +108,8 @@ struct SelectArcContainer<
   typename std::enable_if<
     conjunction<
       typename ArcProperties<ArcTraits>::isExplicit,
-      typename ArcProperties<ArcTraits>::isOrdered>::value,
+      typename ArcProperties<ArcTraits>::isOrdered,
+      negation<typename ArcProperties<ArcTraits>::isCompressed>>::value,
     ArcTraits>::type> : public ExplicitArcs<ArcTraits> // ExplicitOrderedArcs
 {
   static_assert(ArcProperties<ArcTraits>::isExplicit::value, R"(
@@ -0,0 +1,329 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/graph/filter/ArcPath.h"
+
+#include "smtk/graph/ArcImplementationBase.h"
+#include "smtk/graph/Component.h"
+#include "smtk/graph/RuntimeArcEndpoint.h"
+
+#include <unordered_set>
+
+namespace smtk
+{
+namespace graph
+{
+namespace filter
+{
+namespace
+{
+
+/// Return true if \a typeName (an entry of ArcMap::types()) is selected by \a query.
+///
+/// Arc types registered at compile time may be named by their traits type
+/// or by their implementation; either may be abbreviated by omitting its
+/// namespace.
+bool arcTypeMatches(const std::string& typeName, const std::string& query)
+{
+  static const std::string implementation = "smtk::graph::ArcImplementation<";
+  std::string name = typeName;
+  if (
+    name.size() > implementation.size() && name.compare(0, implementation.size(), implementation) == 0 &&
+    name.back() == '>')
+  {
+    name = name.substr(implementation.size(), name.size() - implementation.size() - 1);
+  }
+  if (name == query)
+  {
+    return true;
+  }
+  return name.size() > query.size() + 2 &&
+    name.compare(name.size() - query.size(), query.size(), query) == 0 &&
+    name.compare(name.size() - query.size() - 2, 2, "::") == 0;
+}
+
+/// A node reached after some number of hops along one step of a path.
+struct State
+{
+  const smtk::graph::Component* node;
+  std::size_t step;
+  std::size_t hops;
+
+  bool operator==(const State& other) const
+  {
+    return node == other.node && step == other.step && hops == other.hops;
+  }
+};
+
+struct StateHash
+{
+  std::size_t operator()(const State& state) const
+  {
+    std::size_t result = std::hash<const void*>()(state.node);
+    result ^= state.step + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2);
+    result ^= state.hops + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2);
+    return result;
+  }
+};
+
+/// A depth-first search along a path that visits each state at most once.
+class Search
+{
+public:
+  void push(const smtk::graph::Component* node, std::size_t step, std::size_t hops)
+  {
+    State state{ node, step, hops };
+    if (m_visited.insert(state).second)
+    {
+      m_pending.push_back(state);
+    }
+  }
+
+  bool empty() const { return m_pending.empty(); }
+
+  State pop()
+  {
+    State state = m_pending.back();
+    m_pending.pop_back();
+    return state;
+  }
+
+private:
+  std::vector<State> m_pending;
+  std::unordered_set<State, StateHash> m_visited;
+};
+
+/// Return the number of hops to record for a state.
+///
+/// When a step has no maximum, every hop beyond the minimum is equivalent;
+/// folding them together keeps searches from following cycles forever.
+std::size_t hopsKey(const ArcPath::PathStep& step, std::size_t hops)
+{
+  return step.maximumHops == std::numeric_limits<std::size_t>::max()
+    ? std::min(hops, step.minimumHops)
+    : hops;
+}
+} // anonymous namespace
+
+struct ArcPath::PathRule::Resolution
+{
+  smtk::common::UUID resource;
+  const smtk::graph::ArcMap* arcs{ nullptr };
+  std::size_t arcTypeCount{ 0 };
+  /// The arc implementations traversed by each step.
+  std::vector<std::vector<const ArcImplementationBase*>> steps;
+
+  /// Invoke \a visitor on each node one arc away from \a node along \a step.
+  ///
+  /// When \a reverse is true, the step's direction is inverted (i.e., the
+  /// path is being walked from its end toward its start).
+  template<typename Visitor>
+  void visitNeighbors(
+    const ArcPath::PathStep& step,
+    std::size_t stepIndex,
+    const smtk::graph::Component* node,
+    bool reverse,
+    Visitor visitor) const
+  {
+    bool outgoing =
+      step.direction == Direction::Either || ((step.direction == Direction::Forward) != reverse);
+    bool incoming =
+      step.direction == Direction::Either || ((step.direction == Direction::Backward) != reverse);
+    for (const auto* arcType : this->steps[stepIndex])
+    {
+      if (outgoing)
+      {
+        arcType->outgoingRuntime(node).visit(visitor);
+      }
+      if (incoming)
+      {
+        arcType->incomingRuntime(node).visit(visitor);
+      }
+    }
+  }
+};
+
+std::shared_ptr<const ArcPath::PathRule::Resolution> ArcPath::PathRule::resolve(
+  const smtk::graph::ResourceBase& resource) const
+{
+  const auto& arcs = resource.arcs();
+  {
+    std::lock_guard<std::mutex> guard(m_resolutionMutex);
+    if (
+      m_resolution && m_resolution->resource == resource.id() && m_resolution->arcs == &arcs &&
+      m_resolution->arcTypeCount == arcs.types().size())
+    {
+      return m_resolution;
+    }
+  }
+
+  auto resolution = std::make_shared<Resolution>();
+  resolution->resource = resource.id();
+  resolution->arcs = &arcs;
+  resolution->arcTypeCount = arcs.types().size();
+  resolution->steps.resize(this->steps.size());
+  for (std::size_t ii = 0; ii < this->steps.size(); ++ii)
+  {
+    for (const auto& arcTypeName : arcs.types())
+    {
+      if (
+        !this->steps[ii].arcType.empty() &&
+        !arcTypeMatches(arcTypeName.data(), this->steps[ii].arcType))
+      {
+        continue;
+      }
+      if (const auto* arcType = arcs.at<ArcImplementationBase>(arcTypeName))
+      {
+        resolution->steps[ii].push_back(arcType);
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(m_resolutionMutex);
+  m_resolution = resolution;
+  return resolution;
+}
+
+bool ArcPath::PathRule::operator()(const smtk::resource::PersistentObject& object) const
+{
+  const auto* node = dynamic_cast<const smtk::graph::Component*>(&object);
+  if (!node || this->steps.empty())
+  {
+    return false;
+  }
+  const auto* resource = dynamic_cast<const smtk::graph::ResourceBase*>(node->parentResource());
+  if (!resource)
+  {
+    return false;
+  }
+  auto resolution = this->resolve(*resource);
+
+  // Walk the path backward from the node, looking for a node that matches
+  // the start of the path.
+  Search search;
+  search.push(node, this->steps.size() - 1, 0);
+  while (!search.empty())
+  {
+    State state = search.pop();
+    const auto& step = this->steps[state.step];
+    if (state.hops >= step.minimumHops)
+    {
+      const auto& pattern = state.step == 0 ? this->start : this->steps[state.step - 1].target;
+      if (pattern(*state.node))
+      {
+        if (state.step == 0)
+        {
+          return true;
+        }
+        search.push(state.node, state.step - 1, 0);
+      }
+    }
+    if (state.hops < step.maximumHops)
+    {
+      std::size_t hops = hopsKey(step, state.hops + 1);
+      resolution->visitNeighbors(
+        step, state.step, state.node, true, [&](const smtk::graph::Component* next) {
+          search.push(next, state.step, hops);
+        });
+    }
+  }
+  return false;
+}
+
+bool ArcPath::PathRule::generate(
+  const smtk::resource::Resource& resource,
+  const std::function<smtk::common::Visit(const smtk::resource::Component*)>& visitor) const
+{
+  const auto* graphResource = dynamic_cast<const smtk::graph::ResourceBase*>(&resource);
+  if (!graphResource || this->steps.empty())
+  {
+    return false;
+  }
+  auto resolution = this->resolve(*graphResource);
+
+  // States are shared by searches from every starting node since the nodes
+  // reachable from a state do not depend on how it was reached.
+  Search search;
+  std::unordered_set<const smtk::graph::Component*> reported;
+  bool halted = false;
+  const std::size_t last = this->steps.size() - 1;
+  auto traverse = [&](const smtk::graph::Component* origin) {
+    search.push(origin, 0, 0);
+    while (!halted && !search.empty())
+    {
+      State state = search.pop();
+      const auto& step = this->steps[state.step];
+      if (state.hops >= step.minimumHops)
+      {
+        if (state.step == last)
+        {
+          if (
+            reported.insert(state.node).second &&
+            visitor(state.node) == smtk::common::Visit::Halt)
+          {
+            halted = true;
+          }
+        }
+        else if (step.target(*state.node))
+        {
+          search.push(state.node, state.step + 1, 0);
+        }
+      }
+      if (state.hops < step.maximumHops)
+      {
+        std::size_t hops = hopsKey(step, state.hops + 1);
+        resolution->visitNeighbors(
+          step, state.step, state.node, false, [&](const smtk::graph::Component* next) {
+            search.push(next, state.step, hops);
+          });
+      }
+    }
+  };
+
+  // Start from nodes matching the start of the path, using the resource's
+  // indexes to find them when possible.
+  std::unordered_set<smtk::common::UUID> ids;
+  bool planned = std::any_of(
+    this->start.data().begin(),
+    this->start.data().end(),
+    [&resource, &ids](const std::unique_ptr<smtk::resource::filter::Rule>& rule) {
+      return rule->candidates(resource, ids);
+    });
+  if (planned)
+  {
+    for (const auto& id : ids)
+    {
+      const auto* origin = dynamic_cast<const smtk::graph::Component*>(resource.component(id));
+      if (origin && this->start(*origin))
+      {
+        traverse(origin);
+        if (halted)
+        {
+          break;
+        }
+      }
+    }
+    return true;
+  }
+
+  std::function<void(const smtk::resource::ComponentPtr&)> scan =
+    [&](const smtk::resource::ComponentPtr& component) {
+      const auto* origin = dynamic_cast<const smtk::graph::Component*>(component.get());
+      if (!halted && origin && this->start(*origin))
+      {
+        traverse(origin);
+      }
+    };
+  resource.visit(scan);
+  return true;
+}
+
+} // namespace filter
+} // namespace graph
+} // namespace smtk
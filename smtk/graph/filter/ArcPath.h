@@ -0,0 +1,353 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_graph_filter_ArcPath_h
+#define smtk_graph_filter_ArcPath_h
+
+#include "smtk/CoreExports.h"
+
+#include "smtk/graph/ResourceBase.h"
+#include "smtk/graph/filter/TypeName.h"
+
+#include "smtk/resource/filter/Action.h"
+#include "smtk/resource/filter/Grammar.h"
+#include "smtk/resource/filter/Rule.h"
+#include "smtk/resource/filter/Rules.h"
+
+#include "smtk/common/Visit.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace smtk
+{
+namespace graph
+{
+
+class Component;
+
+namespace filter
+{
+
+using namespace tao::pegtl;
+
+// clang-format off
+
+/**\brief Path expressions that follow arcs between nodes.
+  *
+  * A path expression starts with a node pattern (a type-name optionally
+  * followed by a property clause) and is followed by one or more steps.
+  * Each step names an arc type, the direction in which to traverse it, an
+  * optional range of hops, and the pattern that nodes at the end of the
+  * step must match:
+  *
+  * + `-[Arc]->` traverses arcs from their "from" node to their "to" node;
+  * + `<-[Arc]-` traverses arcs from their "to" node to their "from" node;
+  * + `-[Arc]-` traverses arcs in either direction;
+  * + `-[Arc{2}]->`, `-[Arc{1,3}]->`, and `-[Arc{1,}]->` traverse exactly 2,
+  *   between 1 and 3, or at least 1 arc(s) of the given type (a maximum
+  *   below the minimum is a parse error);
+  * + `*` or `any` may be used in place of an arc type-name to traverse arcs
+  *   of every type.
+  *
+  * Arc type-names may be quoted or bare; bare names may omit the namespace
+  * of the arc's type. The query matches the nodes at the end of the path.
+  * For example,
+  * `'smtk::markup::Group' [string{'material' = 'steel'}] -[GroupsToMembers]-> *`
+  * matches every member of groups whose "material" property is "steel".
+  */
+struct ArcPath
+{
+  /// Open a step that traverses arcs in their forward (or either) direction.
+  struct ForwardOpen : string<'-', '['> {};
+  /// Open a step that traverses arcs in their reverse direction.
+  struct BackwardOpen : string<'<', '-', '['> {};
+  /// Close a step that traverses arcs in their forward direction.
+  struct ForwardClose : string<']', '-', '>'> {};
+  /// Close a step that traverses arcs in either direction (or in reverse).
+  struct EitherClose : seq<string<']', '-'>, not_at<one<'>'> > > {};
+
+  /// Syntax for an arc type-name.
+  struct ArcName : plus<not_one<'\''>> {};
+  struct BareArcName : plus<sor<identifier_other, one<':'> > > {};
+  struct AnyArc : sor<one<'*'>, seq<TAO_PEGTL_ISTRING("any"), not_at<identifier_other> > > {};
+
+  /// Syntax for the number of arcs a step may traverse.
+  struct MinimumHops : plus<tao::pegtl::digit> {};
+  struct Unbounded : one<','> {};
+  struct MaximumHops : plus<tao::pegtl::digit> {};
+  struct Hops
+    : if_must<one<'{'>,
+              pad<MinimumHops, space>,
+              opt<pad<Unbounded, space>, opt<pad<MaximumHops, space> > >,
+              one<'}'> > {};
+
+  struct ArcSpecification
+    : seq<pad<sor<AnyArc, smtk::resource::filter::quoted<ArcName>, BareArcName>, space>,
+          opt<pad<Hops, space> > > {};
+
+  /// Syntax for the nodes at the end of a step. Unlike the first node of
+  /// a path, a type-name is required (use "*" to accept any node).
+  struct NodePattern
+    : seq<sor<pad<TypeName::AnyOrStar, space>,
+              pad<smtk::resource::filter::quoted<TypeName::Name>, space>,
+              pad<smtk::resource::filter::slashed<TypeName::Regex>, space>,
+              pad<TypeName::BareTypeName, space> >,
+          opt<pad<smtk::resource::filter::Grammar, space> > > {};
+
+  struct Step
+    : seq<sor<if_must<BackwardOpen, ArcSpecification, EitherClose>,
+              if_must<ForwardOpen, ArcSpecification, sor<ForwardClose, EitherClose> > >,
+          star<space>,
+          must<NodePattern> > {};
+
+  /// The grammar for this type is a sequence of one or more steps.
+  struct Grammar : plus<Step> {};
+
+  /// The direction in which a step traverses arcs.
+  enum class Direction
+  {
+    Forward,  //!< From each arc's "from" node to its "to" node.
+    Backward, //!< From each arc's "to" node to its "from" node.
+    Either    //!< In both directions.
+  };
+
+  /// One step of a path expression.
+  struct PathStep
+  {
+    /// The arc type-name to traverse (or empty to traverse every arc type).
+    std::string arcType;
+    Direction direction{ Direction::Either };
+    std::size_t minimumHops{ 1 };
+    std::size_t maximumHops{ 1 };
+    /// Rules that nodes at the end of this step must satisfy. The rules for
+    /// the final step are held by the enclosing filter, not the path.
+    smtk::resource::filter::Rules target;
+  };
+
+  /**\brief A rule that accepts nodes at the end of a path.
+    *
+    * Paths are evaluated lazily: arc endpoints are visited one node at a
+    * time without collecting the nodes reached by each step. A node is
+    * accepted by searching backward along the path for a node that matches
+    * the start of the path; generate() searches forward from each node that
+    * matches the start of the path instead, which is preferred when the
+    * final node of the path cannot be planned.
+    */
+  class SMTKCORE_EXPORT PathRule : public smtk::resource::filter::Rule
+  {
+  public:
+    ~PathRule() override = default;
+
+    bool operator()(const smtk::resource::PersistentObject& object) const override;
+
+    bool generate(
+      const smtk::resource::Resource& resource,
+      const std::function<smtk::common::Visit(const smtk::resource::Component*)>& visitor)
+      const override;
+
+    /// Rules that the first node of the path must satisfy.
+    smtk::resource::filter::Rules start;
+    /// The steps of the path, in order.
+    std::vector<PathStep> steps;
+
+  protected:
+    struct Resolution;
+
+    /// Return the arc implementations traversed by each step for \a resource.
+    std::shared_ptr<const Resolution> resolve(const smtk::graph::ResourceBase& resource) const;
+
+    mutable std::mutex m_resolutionMutex;
+    mutable std::shared_ptr<const Resolution> m_resolution;
+  };
+
+  /// Begin a new step of the path held by \a rules, taking ownership of any
+  /// rules parsed since the previous step began.
+  static void beginStep(smtk::resource::filter::Rules& rules, Direction direction)
+  {
+    auto& data = rules.data();
+    auto* path = data.empty() ? nullptr : dynamic_cast<PathRule*>(data.front().get());
+    if (!path)
+    {
+      auto created = std::unique_ptr<PathRule>(new PathRule);
+      for (auto& rule : data)
+      {
+        created->start.emplace_back(std::move(rule));
+      }
+      data.clear();
+      path = created.get();
+      data.emplace_back(std::move(created));
+    }
+    else
+    {
+      for (auto it = data.begin() + 1; it != data.end(); ++it)
+      {
+        path->steps.back().target.emplace_back(std::move(*it));
+      }
+      data.erase(data.begin() + 1, data.end());
+    }
+    path->steps.emplace_back();
+    path->steps.back().direction = direction;
+  }
+
+  /// Return the step currently being parsed into \a rules.
+  static PathStep& currentStep(smtk::resource::filter::Rules& rules)
+  {
+    return static_cast<PathRule*>(rules.data().front().get())->steps.back();
+  }
+
+  /// Return the hop count spelled by \a input, raising a parse error if it is too large.
+  template<typename Input>
+  static std::size_t hopCount(const Input& input)
+  {
+    try
+    {
+      unsigned long long count = std::stoull(input.string());
+      if (count <= std::numeric_limits<std::size_t>::max())
+      {
+        return static_cast<std::size_t>(count);
+      }
+    }
+    catch (std::out_of_range&)
+    {
+    }
+    throw parse_error("Hop count \"" + input.string() + "\" is too large.", input);
+  }
+};
+} // namespace filter
+} // namespace graph
+} // namespace smtk
+// clang-format on
+
+namespace smtk
+{
+namespace resource
+{
+namespace filter
+{
+/// Actions related to parsing rules for this type.
+template<>
+struct Action<smtk::graph::filter::ArcPath::ForwardOpen>
+{
+  template<typename Input>
+  static void apply(const Input& input, Rules& rules)
+  {
+    (void)input;
+    smtk::graph::filter::ArcPath::beginStep(
+      rules, smtk::graph::filter::ArcPath::Direction::Either);
+  }
+};
+
+template<>
+struct Action<smtk::graph::filter::ArcPath::BackwardOpen>
+{
+  template<typename Input>
+  static void apply(const Input& input, Rules& rules)
+  {
+    (void)input;
+    smtk::graph::filter::ArcPath::beginStep(
+      rules, smtk::graph::filter::ArcPath::Direction::Backward);
+  }
+};
+
+template<>
+struct Action<smtk::graph::filter::ArcPath::ForwardClose>
+{
+  template<typename Input>
+  static void apply(const Input& input, Rules& rules)
+  {
+    (void)input;
+    smtk::graph::filter::ArcPath::currentStep(rules).direction =
+      smtk::graph::filter::ArcPath::Direction::Forward;
+  }
+};
+
+template<>
+struct Action<smtk::graph::filter::ArcPath::ArcName>
+{
+  template<typename Input>
+  static void apply(const Input& input, Rules& rules)
+  {
+    smtk::graph::filter::ArcPath::currentStep(rules).arcType = input.string();
+  }
+};
+
+template<>
+struct Action<smtk::graph::filter::ArcPath::BareArcName>
+{
+  template<typename Input>
+  static void apply(const Input& input, Rules& rules)
+  {
+    smtk::graph::filter::ArcPath::currentStep(rules).arcType = input.string();
+  }
+};
+
+template<>
+struct Action<smtk::graph::filter::ArcPath::MinimumHops>
+{
+  template<typename Input>
+  static void apply(const Input& input, Rules& rules)
+  {
+    auto& step = smtk::graph::filter::ArcPath::currentStep(rules);
+    step.minimumHops = smtk::graph::filter::ArcPath::hopCount(input);
+    step.maximumHops = step.minimumHops;
+  }
+};
+
+template<>
+struct Action<smtk::graph::filter::ArcPath::Unbounded>
+{
+  template<typename Input>
+  static void apply(const Input& input, Rules& rules)
+  {
+    (void)input;
+    smtk::graph::filter::ArcPath::currentStep(rules).maximumHops =
+      std::numeric_limits<std::size_t>::max();
+  }
+};
+
+template<>
+struct Action<smtk::graph::filter::ArcPath::MaximumHops>
+{
+  template<typename Input>
+  static void apply(const Input& input, Rules& rules)
+  {
+    auto& step = smtk::graph::filter::ArcPath::currentStep(rules);
+    step.maximumHops = smtk::graph::filter::ArcPath::hopCount(input);
+    if (step.maximumHops < step.minimumHops)
+    {
+      throw tao::pegtl::parse_error("Maximum hop count is less than the minimum.", input);
+    }
+  }
+};
+
+template<>
+struct Action<smtk::graph::filter::ArcPath::Grammar>
+{
+  template<typename Input>
+  static void apply(const Input& input, Rules& rules)
+  {
+    (void)input;
+    // Rules for the final node of the path remain with the filter so that
+    // they may be used to plan the query; test them before the path itself.
+    auto& data = rules.data();
+    std::rotate(data.begin(), data.begin() + 1, data.end());
+  }
+};
+} // namespace filter
+} // namespace resource
+} // namespace smtk
+
+#endif
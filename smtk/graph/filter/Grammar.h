@@ -12,6 +12,7 @@
 
 #include "smtk/CoreExports.h"
 
+#include "smtk/graph/filter/ArcPath.h"
 #include "smtk/graph/filter/TypeName.h"
 
 #include "smtk/resource/filter/Grammar.h"
@@ -23,12 +24,13 @@ namespace graph
 namespace filter
 {
 /// The Grammar for smtk::graph builds upon the default Grammar for
-/// smtk::resource with the addition of filtering by component type name.
+/// smtk::resource with the addition of filtering by component type name
+/// and by paths along arcs from other components (see ArcPath).
 struct SMTKCORE_EXPORT Grammar
   : must<
-      sor<
-        seq<smtk::graph::filter::TypeName::Grammar, smtk::resource::filter::Grammar>,
-        smtk::graph::filter::TypeName::Grammar>,
+      smtk::graph::filter::TypeName::Grammar,
+      opt<pad<smtk::resource::filter::Grammar, space>>,
+      opt<smtk::graph::filter::ArcPath::Grammar>,
       tao::pegtl::eof>
 {
 };
@@ -10,6 +10,7 @@
 #ifndef smtk_graph_filter_TypeName_h
 #define smtk_graph_filter_TypeName_h
 
+#include "smtk/resource/Resource.h"
 #include "smtk/resource/filter/Action.h"
 #include "smtk/resource/filter/Name.h"
 #include "smtk/resource/filter/Rule.h"
@@ -72,6 +73,14 @@ struct TypeName
       return !!dynamic_cast<const smtk::graph::ResourceBase*>(&object);
     }
 
+    /// No component can satisfy this rule.
+    bool candidates(
+      const smtk::resource::Resource&,
+      std::unordered_set<smtk::common::UUID>&) const override
+    {
+      return true;
+    }
+
   };
 
   /// A rule that only accepts exact type-name matches.
@@ -85,6 +94,14 @@ struct TypeName
       return (object.typeName() == value);
     }
 
+    /// Use the resource's type-name index (if it has one) to find candidates.
+    bool candidates(
+      const smtk::resource::Resource& resource,
+      std::unordered_set<smtk::common::UUID>& ids) const override
+    {
+      return resource.componentIdsOfType(value, ids);
+    }
+
     std::string value;
   };
 
@@ -15,8 +15,12 @@
 
 #include "smtk/io/Logger.h"
 
+#include "smtk/resource/json/Helper.h"
+
 #include "nlohmann/json.hpp"
 
+#include <utility>
+
 namespace smtk
 {
 namespace graph
@@ -59,7 +63,8 @@ struct ArcDeserializer
         return;
       }
 
-      // Iterate over all the objects
+      // Collect arc endpoints so that arc indices can be built in bulk.
+      typename Impl::ArcList arcList;
       for (const auto& entry : it->items())
       {
         smtk::common::UUID fromId(entry.key());
@@ -87,9 +92,10 @@ struct ArcDeserializer
           // TODO: For ordered arcs, we can easily handle the "beforeTo"
           //       argument, but "beforeFrom" is impossible to determine
           //       from what is currently stored.
-          arcs->connect(fromNode, toNode);
+          arcList.emplace_back(fromNode, toNode);
         }
       }
+      arcs->connectBatch(std::move(arcList), &smtk::resource::json::Helper::threadPool());
     }
   };
 
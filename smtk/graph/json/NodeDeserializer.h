@@ -18,6 +18,11 @@
 
 #include "nlohmann/json.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace smtk
 {
 namespace graph
@@ -56,15 +61,34 @@ struct NodeDeserializer
     }
     // auto helper = smtk::resource::json::Helper::instance();
     const json& jNodesOfType(*it);
+    // Nodes are constructed one at a time (since their from_json methods
+    // may consult the thread-local JSON helper) but inserted in bulk.
+    std::vector<smtk::graph::ComponentPtr> nodes;
+    nodes.reserve(jNodesOfType.size());
     for (const auto& jNode : jNodesOfType)
     {
       auto node = jNode.get<std::shared_ptr<NodeType>>();
       if (node)
       {
-        m_resource->add(node);
+        nodes.emplace_back(std::move(node));
       }
       // or alternately, m_resource->template create<NodeType>(jNode, helper);
     }
+    if (m_resource->addNodes(nodes) < nodes.size())
+    {
+      // Some nodes may have been inserted by their from_json method;
+      // only report those that are not present.
+      auto missing = std::count_if(
+        nodes.begin(), nodes.end(), [this](const smtk::graph::ComponentPtr& node) {
+          return m_resource->component(node->id()) != node.get();
+        });
+      if (missing > 0)
+      {
+        smtkErrorMacro(
+          smtk::io::Logger::instance(),
+          "Could not add " << missing << " nodes of type " << nodeType << ".");
+      }
+    }
   }
 
   Resource* m_resource = nullptr;
@@ -81,6 +81,10 @@ public:
     smtk::string::Token& arcTypeName,
     smtk::attribute::GroupItem::Ptr& endpoints);
 
+  /// The specification depends upon the arc types registered at run time,
+  /// so it is always constructed anew rather than copied from the metadata.
+  bool cacheableSpecification() const override { return false; }
+
 protected:
   DeleteArc();
   Result operateInternal() override;
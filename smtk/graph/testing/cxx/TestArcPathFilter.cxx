@@ -0,0 +1,166 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/graph/Component.h"
+#include "smtk/graph/Resource.h"
+
+#include "smtk/io/Logger.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace test_arc_path
+{
+class NodeA : public smtk::graph::Component
+{
+public:
+  smtkTypenameMacro(NodeA);
+  template<typename... Args>
+  NodeA(Args&&... args)
+    : smtk::graph::Component::Component(std::forward<Args>(args)...)
+  {
+  }
+};
+
+class NodeB : public smtk::graph::Component
+{
+public:
+  smtkTypenameMacro(NodeB);
+  template<typename... Args>
+  NodeB(Args&&... args)
+    : smtk::graph::Component::Component(std::forward<Args>(args)...)
+  {
+  }
+};
+
+struct Chain
+{
+  using FromType = NodeA;
+  using ToType = NodeA;
+  using Directed = std::true_type;
+};
+
+struct Owns
+{
+  using FromType = NodeA;
+  using ToType = NodeB;
+  using Directed = std::true_type;
+};
+
+struct Touches
+{
+  using FromType = NodeB;
+  using ToType = NodeB;
+  using Directed = std::false_type;
+};
+
+struct PathTraits
+{
+  using NodeTypes = std::tuple<NodeA, NodeB>;
+  using ArcTypes = std::tuple<Chain, Owns, Touches>;
+};
+} // namespace test_arc_path
+
+int TestArcPathFilter(int, char*[])
+{
+  using namespace test_arc_path;
+  smtk::io::Logger::instance().setFlushToStdout(true);
+  auto resource = smtk::graph::Resource<PathTraits>::create();
+
+  // Build a chain of NodeA instances, each owning one NodeB; pairs of
+  // NodeB instances touch one another.
+  constexpr int numNodes = 20;
+  std::vector<std::shared_ptr<NodeA>> aa;
+  std::vector<std::shared_ptr<NodeB>> bb;
+  for (int ii = 0; ii < numNodes; ++ii)
+  {
+    aa.push_back(resource->create<NodeA>());
+    aa.back()->properties().emplace<long>("index", ii);
+    bb.push_back(resource->create<NodeB>());
+    aa.back()->outgoing<Owns>().connect(bb.back());
+    if (ii > 0)
+    {
+      aa[ii - 1]->outgoing<Chain>().connect(aa[ii]);
+    }
+    if (ii % 2 == 1)
+    {
+      bb[ii - 1]->outgoing<Touches>().connect(bb[ii]);
+    }
+  }
+
+  auto components = [](std::initializer_list<smtk::resource::ComponentPtr> entries) {
+    return smtk::resource::ComponentSet(entries.begin(), entries.end());
+  };
+  smtk::resource::ComponentSet allB(bb.begin(), bb.end());
+
+  std::vector<std::pair<std::string, smtk::resource::ComponentSet>> queries = {
+    { "NodeA [ integer { 'index' = 3 } ] -[Owns]-> NodeB", components({ bb[3] }) },
+    { "NodeA [ integer { 'index' = 3 } ] -['test_arc_path::Owns']-> *", components({ bb[3] }) },
+    { "NodeA [ integer { 'index' = 3 } ] -[Chain{2}]-> NodeA", components({ aa[5] }) },
+    { "NodeA [ integer { 'index' = 3 } ] -[Chain{1,3}]-> 'NodeA'",
+      components({ aa[4], aa[5], aa[6] }) },
+    { "NodeA [ integer { 'index' = 3 } ] -[Chain{1,}]-> NodeA [ integer { 'index' = 7 } ]",
+      components({ aa[7] }) },
+    { "NodeA [ integer { 'index' = 3 } ] -[Chain{0,1}]-> *", components({ aa[3], aa[4] }) },
+    { "NodeA [ integer { 'index' = 19 } ] -[Chain]-> *", components({}) },
+    { "NodeB <-[Owns]- NodeA [ integer { 'index' = 10 } ]", components({ aa[10] }) },
+    { "NodeA [ integer { 'index' = 4 } ] -[Owns]-> * -[Touches]- *", components({ bb[5] }) },
+    { "NodeA [ integer { 'index' = 5 } ] -[Owns]-> * -[Touches]-> 'NodeB'",
+      components({ bb[4] }) },
+    { "NodeA -[Chain]-> NodeA [ integer { 'index' = 8 } ] -[Owns]-> NodeB",
+      components({ bb[8] }) },
+    { "NodeA [ integer { 'index' = 0 } ] -[*]-> NodeB", components({ bb[0] }) },
+    { "* -[any]-> NodeB", allB },
+    { "'NodeB' -[Touches]- 'NodeB'", allB },
+  };
+
+  for (const auto& entry : queries)
+  {
+    const auto& query = entry.first;
+    std::cout << "Query \"" << query << "\"\n";
+    auto matches = resource->filter(query);
+    smtkTest(
+      matches == entry.second,
+      "Path query \"" << query << "\" matched " << matches.size() << " components, expected "
+                      << entry.second.size() << ".");
+
+    // Testing components one at a time searches the path backward; it must
+    // agree with the planned or forward search done by filter().
+    auto queryOp = resource->queryOperation(query);
+    smtk::resource::ComponentSet scanned;
+    smtk::resource::Component::Visitor scan = [&](const smtk::resource::ComponentPtr& component) {
+      if (queryOp(*component))
+      {
+        scanned.insert(component);
+      }
+    };
+    resource->visit(scan);
+    smtkTest(scanned == entry.second, "Scanning for \"" << query << "\" gave different results.");
+  }
+
+  // Hop ranges that are reversed or too large to represent are parse errors.
+  for (const std::string query :
+       { "NodeA -[Chain{3,1}]-> *", "NodeA -[Chain{99999999999999999999999}]-> *" })
+  {
+    auto& logger = smtk::io::Logger::instance();
+    logger.clearErrors();
+    resource->queryOperation(query);
+    smtkTest(logger.hasErrors(), "Expected \"" << query << "\" to be rejected.");
+    logger.clearErrors();
+  }
+
+  // Queries that do not follow arcs must be unaffected.
+  smtkTest(resource->filter("NodeA").size() == numNodes, "Expected every NodeA to match.");
+  smtkTest(resource->filter("").empty(), "Expected an empty query to match no components.");
+
+  return 0;
+}
@@ -0,0 +1,225 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/graph/Component.h"
+#include "smtk/graph/Resource.h"
+
+#include "smtk/common/Executor.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+
+class Node : public smtk::graph::Component
+{
+public:
+  smtkTypeMacro(Node);
+  smtkSuperclassMacro(smtk::graph::Component);
+
+  Node(const std::shared_ptr<smtk::graph::ResourceBase>& resource)
+    : smtk::graph::Component(resource)
+  {
+  }
+};
+
+struct DirectedArc
+{
+  using FromType = Node;
+  using ToType = Node;
+  using Directed = std::true_type;
+};
+
+struct UndirectedArc
+{
+  using FromType = Node;
+  using ToType = Node;
+  using Directed = std::false_type;
+};
+
+struct ForwardArc
+{
+  using FromType = Node;
+  using ToType = Node;
+  using Directed = std::true_type;
+  using ForwardIndexOnly = std::true_type;
+};
+
+struct CompressedDirectedArc : DirectedArc
+{
+  using CompressedStorage = std::true_type;
+};
+
+struct CompressedUndirectedArc : UndirectedArc
+{
+  using CompressedStorage = std::true_type;
+};
+
+// Degree limits force bulk insertion to connect arcs one at a time.
+struct LimitedArc
+{
+  using FromType = Node;
+  using ToType = Node;
+  using Directed = std::true_type;
+  static constexpr std::size_t MaxOutDegree = 2;
+  static constexpr std::size_t MaxInDegree = smtk::graph::unconstrained();
+};
+
+struct BulkTraits
+{
+  using NodeTypes = std::tuple<Node>;
+  using ArcTypes = std::tuple<
+    DirectedArc,
+    UndirectedArc,
+    ForwardArc,
+    CompressedDirectedArc,
+    CompressedUndirectedArc,
+    LimitedArc>;
+};
+
+using Resource = smtk::graph::Resource<BulkTraits>;
+using Arcs = std::vector<std::pair<std::size_t, std::size_t>>;
+
+// Return the arcs of type ArcType as pairs of node indices.
+template<typename ArcType, typename Incoming>
+std::set<std::pair<std::size_t, std::size_t>> arcsOf(
+  const std::vector<std::shared_ptr<Node>>& nodes,
+  Incoming incoming)
+{
+  std::map<const Node*, std::size_t> index;
+  for (std::size_t ii = 0; ii < nodes.size(); ++ii)
+  {
+    index[nodes[ii].get()] = ii;
+  }
+  std::set<std::pair<std::size_t, std::size_t>> result;
+  for (std::size_t ii = 0; ii < nodes.size(); ++ii)
+  {
+    auto record = [&](const Node* other) {
+      result.insert(std::make_pair(ii, index[other]));
+      return smtk::common::Visit::Continue;
+    };
+    if (incoming)
+    {
+      nodes[ii]->template incoming<ArcType>().visit(record);
+    }
+    else
+    {
+      nodes[ii]->template outgoing<ArcType>().visit(record);
+    }
+  }
+  return result;
+}
+
+// Connect \a arcs one at a time in one resource and in bulk in another,
+// then verify both resources hold the same arcs.
+template<typename ArcType, bool Bidirectional>
+void testBulkArcs(const Arcs& arcs, smtk::common::Executor* executor, const std::string& label)
+{
+  std::cout << "Test bulk " << label << " arcs\n";
+  constexpr std::size_t numNodes = 256;
+  auto incremental = Resource::create();
+  auto bulk = Resource::create();
+  std::vector<std::shared_ptr<Node>> incrementalNodes;
+  std::vector<std::shared_ptr<Node>> bulkNodes;
+  std::vector<smtk::graph::ComponentPtr> batch;
+  for (std::size_t ii = 0; ii < numNodes; ++ii)
+  {
+    incrementalNodes.push_back(incremental->create<Node>());
+    bulkNodes.push_back(std::make_shared<Node>(bulk));
+    batch.push_back(bulkNodes.back());
+  }
+  smtkTest(bulk->addNodes(batch) == numNodes, label << ": expected every node to be added.");
+  smtkTest(bulk->addNodes(batch) == 0, label << ": expected nodes to be added only once.");
+  for (const auto& node : bulkNodes)
+  {
+    smtkTest(bulk->component(node->id()) == node.get(), label << ": node not indexed.");
+  }
+
+  std::size_t expectedCount = 0;
+  typename smtk::graph::ArcImplementation<ArcType>::ArcList arcList;
+  for (const auto& arc : arcs)
+  {
+    expectedCount += incrementalNodes[arc.first]->template outgoing<ArcType>().connect(
+                       incrementalNodes[arc.second])
+      ? 1
+      : 0;
+    arcList.emplace_back(bulkNodes[arc.first].get(), bulkNodes[arc.second].get());
+  }
+  arcList.emplace_back(nullptr, bulkNodes[0].get());
+  std::size_t count = bulk->template connectArcs<ArcType>(std::move(arcList), executor);
+  smtkTest(
+    count == expectedCount,
+    label << ": inserted " << count << " arcs, expected " << expectedCount << ".");
+  smtkTest(
+    arcsOf<ArcType>(incrementalNodes, false) == arcsOf<ArcType>(bulkNodes, false),
+    label << ": outgoing arcs differ.");
+  if (Bidirectional)
+  {
+    smtkTest(
+      arcsOf<ArcType>(incrementalNodes, true) == arcsOf<ArcType>(bulkNodes, true),
+      label << ": incoming arcs differ.");
+  }
+
+  // A second batch cannot be built directly and must match incremental edits too.
+  Arcs more = { { 1, 2 }, { 2, 1 }, { 3, 3 }, { 1, 2 } };
+  arcList.clear();
+  expectedCount = 0;
+  for (const auto& arc : more)
+  {
+    expectedCount += incrementalNodes[arc.first]->template outgoing<ArcType>().connect(
+                       incrementalNodes[arc.second])
+      ? 1
+      : 0;
+    arcList.emplace_back(bulkNodes[arc.first].get(), bulkNodes[arc.second].get());
+  }
+  count = bulk->template connectArcs<ArcType>(std::move(arcList), executor);
+  smtkTest(count == expectedCount, label << ": second batch inserted " << count << " arcs.");
+  smtkTest(
+    arcsOf<ArcType>(incrementalNodes, false) == arcsOf<ArcType>(bulkNodes, false),
+    label << ": outgoing arcs differ after a second batch.");
+}
+
+} // anonymous namespace
+
+int TestBulkLoad(int, char*[])
+{
+  // Random arcs with duplicates, reversed duplicates, and self-loops.
+  std::mt19937 generator(54321);
+  std::uniform_int_distribution<std::size_t> pick(0, 255);
+  Arcs arcs;
+  for (int ii = 0; ii < 20000; ++ii)
+  {
+    arcs.emplace_back(pick(generator), pick(generator));
+    if (ii % 7 == 0)
+    {
+      arcs.emplace_back(arcs.back().second, arcs.back().first);
+    }
+  }
+  arcs.emplace_back(5, 5);
+  arcs.emplace_back(5, 5);
+
+  smtk::common::Executor executor(2);
+  for (auto* pool : { static_cast<smtk::common::Executor*>(nullptr), &executor })
+  {
+    testBulkArcs<DirectedArc, true>(arcs, pool, "directed");
+    testBulkArcs<UndirectedArc, true>(arcs, pool, "undirected");
+    testBulkArcs<ForwardArc, false>(arcs, pool, "forward-only");
+    testBulkArcs<CompressedDirectedArc, true>(arcs, pool, "compressed directed");
+    testBulkArcs<CompressedUndirectedArc, true>(arcs, pool, "compressed undirected");
+    testBulkArcs<LimitedArc, true>(arcs, pool, "degree-limited");
+  }
+  return 0;
+}
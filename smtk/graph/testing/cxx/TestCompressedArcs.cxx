@@ -0,0 +1,221 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/graph/Component.h"
+#include "smtk/graph/Resource.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <iostream>
+#include <random>
+#include <set>
+
+namespace
+{
+
+class Node : public smtk::graph::Component
+{
+public:
+  smtkTypeMacro(Node);
+  smtkSuperclassMacro(smtk::graph::Component);
+
+  Node(const std::shared_ptr<smtk::graph::ResourceBase>& resource)
+    : smtk::graph::Component(resource)
+  {
+  }
+};
+
+// Each pair of arc types below differs only in how arcs are stored.
+struct DirectedArc
+{
+  using FromType = Node;
+  using ToType = Node;
+  using Directed = std::true_type;
+};
+
+struct CompressedDirectedArc : DirectedArc
+{
+  using CompressedStorage = std::true_type;
+};
+
+struct UndirectedArc
+{
+  using FromType = Node;
+  using ToType = Node;
+  using Directed = std::false_type;
+};
+
+struct CompressedUndirectedArc : UndirectedArc
+{
+  using CompressedStorage = std::true_type;
+};
+
+struct ForwardArc
+{
+  using FromType = Node;
+  using ToType = Node;
+  using Directed = std::true_type;
+  using ForwardIndexOnly = std::true_type;
+};
+
+struct CompressedForwardArc : ForwardArc
+{
+  using CompressedStorage = std::true_type;
+};
+
+struct CompressedTraits
+{
+  using NodeTypes = std::tuple<Node>;
+  using ArcTypes = std::tuple<
+    DirectedArc,
+    CompressedDirectedArc,
+    UndirectedArc,
+    CompressedUndirectedArc,
+    ForwardArc,
+    CompressedForwardArc>;
+};
+
+using Resource = smtk::graph::Resource<CompressedTraits>;
+
+template<typename Endpoint>
+std::set<const Node*> neighbors(const Endpoint& endpoint)
+{
+  std::set<const Node*> result;
+  endpoint.visit([&result](const Node* node) {
+    result.insert(node);
+    return smtk::common::Visit::Continue;
+  });
+  return result;
+}
+
+// Verify that every node sees the same arcs through both storage types.
+template<typename Reference, typename Compressed>
+void compareOutgoing(const std::vector<std::shared_ptr<Node>>& nodes, const std::string& label)
+{
+  for (const auto& node : nodes)
+  {
+    auto expected = neighbors(node->template outgoing<Reference>());
+    auto actual = neighbors(node->template outgoing<Compressed>());
+    smtkTest(expected == actual, label << ": outgoing arcs differ.");
+    smtkTest(
+      node->template outgoing<Compressed>().degree() ==
+        node->template outgoing<Reference>().degree(),
+      label << ": outgoing degree differs.");
+    for (const auto& other : nodes)
+    {
+      smtkTest(
+        node->template outgoing<Compressed>().contains(other.get()) ==
+          (expected.find(other.get()) != expected.end()),
+        label << ": contains() differs.");
+    }
+  }
+}
+
+template<typename Reference, typename Compressed>
+void compareIncoming(const std::vector<std::shared_ptr<Node>>& nodes, const std::string& label)
+{
+  for (const auto& node : nodes)
+  {
+    auto expected = neighbors(node->template incoming<Reference>());
+    auto actual = neighbors(node->template incoming<Compressed>());
+    smtkTest(expected == actual, label << ": incoming arcs differ.");
+    smtkTest(
+      node->template incoming<Compressed>().degree() ==
+        node->template incoming<Reference>().degree(),
+      label << ": incoming degree differs.");
+  }
+}
+
+// Apply the same random edits to both storage types, comparing as we go.
+template<typename Reference, typename Compressed, bool Bidirectional>
+void testRandomEdits(const std::string& label)
+{
+  std::cout << "Test " << label << " arcs\n";
+  auto resource = Resource::create();
+  std::vector<std::shared_ptr<Node>> nodes;
+  for (int ii = 0; ii < 128; ++ii)
+  {
+    nodes.push_back(resource->create<Node>());
+  }
+
+  // Connect one node to all others so that its staged arcs overflow.
+  for (std::size_t ii = 1; ii < nodes.size(); ++ii)
+  {
+    nodes[0]->template outgoing<Reference>().connect(nodes[ii]);
+    nodes[0]->template outgoing<Compressed>().connect(nodes[ii]);
+  }
+  compareOutgoing<Reference, Compressed>(nodes, label);
+
+  std::mt19937 generator(12345);
+  std::uniform_int_distribution<std::size_t> pick(0, nodes.size() - 1);
+  std::uniform_int_distribution<int> action(0, 99);
+  // Enough edits to force several compactions.
+  for (int ii = 0; ii < 20000; ++ii)
+  {
+    const auto& from = nodes[pick(generator)];
+    const auto& to = nodes[pick(generator)];
+    int what = action(generator);
+    if (what < 60)
+    {
+      bool expected = from->template outgoing<Reference>().connect(to);
+      bool actual = from->template outgoing<Compressed>().connect(to);
+      smtkTest(expected == actual, label << ": connect() differs.");
+    }
+    else if (what < 97)
+    {
+      bool expected = from->template outgoing<Reference>().disconnect(to);
+      bool actual = from->template outgoing<Compressed>().disconnect(to);
+      smtkTest(expected == actual, label << ": disconnect() differs.");
+    }
+    else if (what < 99)
+    {
+      from->template outgoing<Reference>().disconnect(nullptr);
+      from->template outgoing<Compressed>().disconnect(nullptr);
+    }
+    else
+    {
+      resource->arcs().template at<Compressed>()->disconnect(nullptr, to.get());
+      resource->arcs().template at<Reference>()->disconnect(nullptr, to.get());
+    }
+    if (ii % 2500 == 0)
+    {
+      compareOutgoing<Reference, Compressed>(nodes, label);
+    }
+  }
+  compareOutgoing<Reference, Compressed>(nodes, label);
+  if (Bidirectional)
+  {
+    compareIncoming<Reference, Compressed>(nodes, label);
+  }
+}
+
+} // anonymous namespace
+
+int TestCompressedArcs(int, char*[])
+{
+  using smtk::graph::ArcProperties;
+  using smtk::graph::detail::SelectArcContainer;
+  smtkTest(
+    ArcProperties<CompressedDirectedArc>::isCompressed::value,
+    "Expected CompressedDirectedArc to request compressed storage.");
+  smtkTest(
+    !ArcProperties<DirectedArc>::isCompressed::value,
+    "Expected DirectedArc to use the default storage.");
+  smtkTest(
+    (std::is_same<
+      SelectArcContainer<CompressedUndirectedArc, CompressedUndirectedArc>::type,
+      smtk::graph::CompressedArcs<CompressedUndirectedArc>>::value),
+    "Expected compressed storage to be selected.");
+
+  testRandomEdits<DirectedArc, CompressedDirectedArc, true>("directed");
+  testRandomEdits<UndirectedArc, CompressedUndirectedArc, true>("undirected");
+  testRandomEdits<ForwardArc, CompressedForwardArc, false>("forward-only");
+  return 0;
+}
@@ -9,56 +9,27 @@
 //=========================================================================
 #include "smtk/graph/Component.h"
 #include "smtk/graph/Resource.h"
+#include "smtk/graph/testing/cxx/TestNodes.h"
 
 #include "smtk/common/testing/cxx/helpers.h"
 
 #include <iostream>
-
-namespace test_nodal_resource_filter
-{
-class NodeA : public smtk::graph::Component
-{
-public:
-  smtkTypenameMacro(NodeA);
-  template<typename... Args>
-  NodeA(Args&&... args)
-    : smtk::graph::Component::Component(std::forward<Args>(args)...)
-  {
-  }
-};
-
-class NodeB : public smtk::graph::Component
-{
-public:
-  smtkTypenameMacro(NodeB);
-  template<typename... Args>
-  NodeB(Args&&... args)
-    : smtk::graph::Component::Component(std::forward<Args>(args)...)
-  {
-  }
-};
-
-struct BasicTraits
-{
-  typedef std::tuple<test_nodal_resource_filter::NodeA, test_nodal_resource_filter::NodeB>
-    NodeTypes;
-  typedef std::tuple<> ArcTypes;
-};
-} // namespace test_nodal_resource_filter
+#include <string>
+#include <vector>
 
 int TestNodalResourceFilter(int, char*[])
 {
   smtk::io::Logger::instance().setFlushToStdout(true);
-  auto resource = smtk::graph::Resource<test_nodal_resource_filter::BasicTraits>::create();
+  auto resource = smtk::graph::Resource<smtk::test::BasicTraits>::create();
 
   std::cout << resource->typeName() << std::endl;
 
-  auto nodeA = resource->create<test_nodal_resource_filter::NodeA>();
+  auto nodeA = resource->create<smtk::test::NodeA>();
   nodeA->properties().emplace<long>("foo", 2);
   nodeA->properties().emplace<std::string>("foo", "bar");
   nodeA->properties().emplace<double>("foo", 3.14159);
 
-  auto nodeB = resource->create<test_nodal_resource_filter::NodeB>();
+  auto nodeB = resource->create<smtk::test::NodeB>();
   nodeB->properties().emplace<long>("foo", 2);
   nodeB->properties().emplace<std::string>("foo", "bar");
   nodeB->properties().emplace<double>("foo", 3.14159);
@@ -126,5 +97,64 @@ int TestNodalResourceFilter(int, char*[])
   test(resource->filter("*").size() == 2, "Some components did not match '*' filter.");
   test(resource->filter("").empty(), "Some components matched an empty filter.");
 
+  // Filtering planned against the resource's property storage should produce
+  // exactly the components a full scan with the query operation produces.
+  for (int ii = 0; ii < 100; ++ii)
+  {
+    auto node = (ii % 2) ? std::static_pointer_cast<smtk::graph::Component>(
+                             resource->create<smtk::test::NodeA>())
+                         : std::static_pointer_cast<smtk::graph::Component>(
+                             resource->create<smtk::test::NodeB>());
+    node->properties().emplace<long>("foo", ii % 3);
+    if (ii % 5 == 0)
+    {
+      node->properties().emplace<std::string>("label", "node " + std::to_string(ii));
+    }
+  }
+  // Properties of the resource itself and of removed nodes must not be reported.
+  resource->properties().emplace<long>("foo", 2);
+  auto removed = resource->create<smtk::test::NodeA>();
+  removed->properties().emplace<long>("foo", 2);
+  resource->remove(removed);
+
+  std::vector<std::string> queries = { "'NodeA' [ integer { 'foo' = 2 }]",
+                                       "NodeB [ integer { 'foo' = 1 }]",
+                                       "* [ integer { /f.o/ = 0 }]",
+                                       "/N.deA/ [ string { 'label' = /node [0-9]*5/ } ]",
+                                       "'NodeB' [ string { 'label' } ]",
+                                       "any [ string { 'missing' } ]",
+                                       "'NodeA'" };
+  for (const auto& query : queries)
+  {
+    auto queryOp = resource->queryOperation(query);
+    smtk::resource::ComponentSet expected;
+    std::vector<smtk::resource::ComponentPtr> expectedInOrder;
+    smtk::resource::Component::Visitor scan = [&](const smtk::resource::ComponentPtr& component) {
+      if (queryOp(*component))
+      {
+        expected.insert(component);
+        expectedInOrder.push_back(component);
+      }
+    };
+    resource->visit(scan);
+    test(resource->filter(query) == expected, "Planned filter differs from scan for " + query);
+    // Repeat to exercise the cache of compiled queries.
+    test(resource->filter(query) == expected, "Cached filter differs from scan for " + query);
+    // Sequences should hold components in the order they are visited.
+    test(
+      resource->filterAs<std::vector<smtk::resource::ComponentPtr>>(query) == expectedInOrder,
+      "Planned filter reordered components for " + query);
+  }
+
+  // Queries evicted from the cache are parsed again when next used.
+  auto before = resource->filter(queries.front());
+  for (int ii = 3; ii < 300; ++ii)
+  {
+    test(
+      resource->filter("* [ integer { 'foo' = " + std::to_string(ii) + " }]").empty(),
+      "Unexpected result while evicting cached queries.");
+  }
+  test(resource->filter(queries.front()) == before, "Re-parsed query differs from cached query.");
+
   return 0;
 }
@@ -0,0 +1,57 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_graph_testing_cxx_TestNodes_h
+#define smtk_graph_testing_cxx_TestNodes_h
+
+#include "smtk/graph/Component.h"
+#include "smtk/graph/Resource.h"
+
+#include <tuple>
+#include <utility>
+
+namespace smtk
+{
+namespace test
+{
+
+// Two unrelated node types with no arcs between them, shared by tests
+// and benchmarks that only need a graph resource to hold components.
+class NodeA : public smtk::graph::Component
+{
+public:
+  smtkTypenameMacro(NodeA);
+  template<typename... Args>
+  NodeA(Args&&... args)
+    : smtk::graph::Component::Component(std::forward<Args>(args)...)
+  {
+  }
+};
+
+class NodeB : public smtk::graph::Component
+{
+public:
+  smtkTypenameMacro(NodeB);
+  template<typename... Args>
+  NodeB(Args&&... args)
+    : smtk::graph::Component::Component(std::forward<Args>(args)...)
+  {
+  }
+};
+
+struct BasicTraits
+{
+  typedef std::tuple<NodeA, NodeB> NodeTypes;
+  typedef std::tuple<> ArcTypes;
+};
+
+} // namespace test
+} // namespace smtk
+
+#endif // smtk_graph_testing_cxx_TestNodes_h
@@ -12,6 +12,7 @@
 #include "smtk/graph/Resource.h"
 
 #include <chrono>
+#include <functional>
 #include <iostream>
 
 template<class Duration>
@@ -163,14 +164,42 @@ int TestScalability(int argc, char* argv[])
 
   timer.tic();
   volatile smtk::common::Visit nooptimize = smtk::common::Visit::Continue;
-  for (const auto& node : resource->nodes())
+  std::function<void(const smtk::resource::ComponentPtr&)> visitArcs =
+    [&](const smtk::resource::ComponentPtr& node) {
+      std::dynamic_pointer_cast<Node>(node)->outgoing<Adjacent>().visit(
+        [&](const Node* /* to */) -> smtk::common::Visit { return nooptimize; });
+    };
+  resource->visit(visitArcs);
+  timer.toc();
+  std::cout << "Visited " << num_node * degree_node << " arc(s) in " << timer.elapsed() << "("
+            << timer.units() << ")\n";
+
+  timer.tic();
+  int nfound = 0;
+  for (const auto& node : nodes)
   {
-    std::dynamic_pointer_cast<Node>(node)->outgoing<Adjacent>().visit(
-      [&](const Node* /* to */) -> smtk::common::Visit { return nooptimize; });
+    if (resource->component(node->id()) == node.get())
+    {
+      ++nfound;
+    }
   }
   timer.toc();
-  std::cout << "Visited " << num_node * degree_node << " arc(s) in " << timer.elapsed() << "("
+  std::cout << "Found " << nfound << " node(s) by UUID in " << timer.elapsed() << "("
             << timer.units() << ")\n";
+  if (nfound != num_node)
+  {
+    std::cerr << "Expected to find " << num_node << " node(s) by UUID.\n";
+    return 1;
+  }
+
+  timer.tic();
+  int nvisited = 0;
+  std::function<void(const smtk::resource::ComponentPtr&)> countNodes =
+    [&](const smtk::resource::ComponentPtr& /* node */) { ++nvisited; };
+  resource->visit(countNodes);
+  timer.toc();
+  std::cout << "Visited " << nvisited << " node(s) in " << timer.elapsed() << "(" << timer.units()
+            << ")\n";
 
   std::cout << std::endl;
   // Remove half of the nodes
@@ -190,28 +219,22 @@ int TestScalability(int argc, char* argv[])
 
   timer.tic();
   int narc = 0;
-  for (const auto& node : resource->nodes())
-  {
-    std::dynamic_pointer_cast<Node>(node)->outgoing<Adjacent>().visit(
-      [&](const Node* /* to */) -> smtk::common::Visit {
-        narc++;
-        return nooptimize;
-      });
-  }
+  std::function<void(const smtk::resource::ComponentPtr&)> countArcs =
+    [&](const smtk::resource::ComponentPtr& node) {
+      std::dynamic_pointer_cast<Node>(node)->outgoing<Adjacent>().visit(
+        [&](const Node* /* to */) -> smtk::common::Visit {
+          narc++;
+          return nooptimize;
+        });
+    };
+  resource->visit(countArcs);
   timer.toc();
   std::cout << "Visited " << narc << " arc(s) in " << timer.elapsed() << "(" << timer.units()
             << ")\n";
 
   timer.tic();
   narc = 0;
-  for (const auto& node : resource->nodes())
-  {
-    std::dynamic_pointer_cast<Node>(node)->outgoing<Adjacent>().visit(
-      [&](const Node* /* to */) -> smtk::common::Visit {
-        narc++;
-        return nooptimize;
-      });
-  }
+  resource->visit(countArcs);
   timer.toc();
   std::cout << "Visited " << narc << " arc(s) in " << timer.elapsed() << "(ms)\n";
 
@@ -902,6 +902,10 @@ void XmlDocV3Parser::processReferenceDef(
     {
       idef->setLockType(smtk::resource::LockType::DoNotLock);
     }
+    else if (strcmp(xatt.as_string(), "Snapshot") == 0)
+    {
+      idef->setLockType(smtk::resource::LockType::Snapshot);
+    }
     else if (strcmp(xatt.as_string(), "Read") == 0)
     {
       idef->setLockType(smtk::resource::LockType::Read);
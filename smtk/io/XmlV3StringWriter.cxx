@@ -609,10 +609,19 @@ void XmlV3StringWriter::processReferenceDefCommon(
     node.append_attribute("OnlyResources") = true;
   }
 
-  if (idef->lockType() != smtk::resource::LockType::Write)
+  switch (idef->lockType())
   {
-    node.append_attribute("LockType")
-      .set_value((idef->lockType() == smtk::resource::LockType::DoNotLock ? "DoNotLock" : "Read"));
+    case smtk::resource::LockType::DoNotLock:
+      node.append_attribute("LockType").set_value("DoNotLock");
+      break;
+    case smtk::resource::LockType::Snapshot:
+      node.append_attribute("LockType").set_value("Snapshot");
+      break;
+    case smtk::resource::LockType::Read:
+      node.append_attribute("LockType").set_value("Read");
+      break;
+    case smtk::resource::LockType::Write:
+      break;
   }
 
   if (idef->holdReference())
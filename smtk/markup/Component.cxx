@@ -64,16 +64,16 @@ bool Component::setName(const std::string& name)
     return false;
   }
 
+  this->properties().get<std::string>()["name"] = name;
   auto owner = std::dynamic_pointer_cast<smtk::markup::Resource>(this->resource());
-  if (owner)
+  // We are not allowed to set our name directly once our owning
+  // resource has indexed us by name. Components that have not been
+  // inserted yet (e.g., during deserialization) may be renamed directly.
+  if (owner && owner->modifyComponent(*this, ModifyName(name)))
   {
-    // We are not allowed to set our name directly since
-    // our owning resource has indexed us by name.
-    this->properties().get<std::string>()["name"] = name;
-    return owner->modifyComponent(*this, ModifyName(name));
+    return true;
   }
   m_name = name;
-  this->properties().get<std::string>()["name"] = name;
   return true;
 }
 
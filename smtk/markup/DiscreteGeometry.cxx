@@ -12,11 +12,18 @@
 #include "smtk/attribute/Attribute.h"
 #include "smtk/attribute/ComponentItem.h"
 #include "smtk/markup/Resource.h"
+#include "smtk/markup/ShapeCache.h"
+
+#include "smtk/common/Paths.h"
+#include "smtk/resource/json/Helper.h"
 
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkDataSetReader.h"
+#include "vtkNew.h"
 #include "vtkPointData.h"
+#include "vtkXMLImageDataReader.h"
 
 namespace smtk
 {
@@ -104,6 +111,174 @@ vtkSmartPointer<vtkDataObject> DiscreteGeometry::shape() const
   return empty;
 }
 
+std::shared_ptr<const DiscreteGeometry::ShapeHandle> DiscreteGeometry::shapeHandle() const
+{
+  std::lock_guard<std::mutex> lock(m_shapeMutex);
+  return m_shapeHandle;
+}
+
+bool DiscreteGeometry::isShapeLoaded() const
+{
+  std::lock_guard<std::mutex> lock(m_shapeMutex);
+  return this->loadedShape() != nullptr;
+}
+
+bool DiscreteGeometry::hasShape() const
+{
+  std::lock_guard<std::mutex> lock(m_shapeMutex);
+  return this->loadedShape() || m_shapeHandle;
+}
+
+bool DiscreteGeometry::shapeBounds(std::array<double, 6>& bounds) const
+{
+  std::lock_guard<std::mutex> lock(m_shapeMutex);
+  if (auto* dset = vtkDataSet::SafeDownCast(this->loadedShape()))
+  {
+    dset->GetBounds(bounds.data());
+    return true;
+  }
+  if (m_shapeHandle && m_shapeHandle->bounds[0] <= m_shapeHandle->bounds[1])
+  {
+    bounds = m_shapeHandle->bounds;
+    return true;
+  }
+  return false;
+}
+
+void DiscreteGeometry::setShapeStored(const std::string& location, smtk::string::Token mimeType)
+{
+  vtkSmartPointer<vtkDataObject> data;
+  {
+    std::lock_guard<std::mutex> lock(m_shapeMutex);
+    data = this->loadedShape();
+    if (!data)
+    {
+      return;
+    }
+    auto handle = std::make_shared<ShapeHandle>();
+    handle->location = location;
+    handle->mimeType = mimeType;
+    if (auto* dset = vtkDataSet::SafeDownCast(data))
+    {
+      dset->GetBounds(handle->bounds.data());
+    }
+    m_shapeHandle = handle;
+    m_loadedShapeTime = data->GetMTime();
+  }
+  this->shapeAccessed(data, true);
+}
+
+bool DiscreteGeometry::releaseShape()
+{
+  std::lock_guard<std::mutex> lock(m_shapeMutex);
+  auto* data = this->loadedShape();
+  if (!data || !m_shapeHandle)
+  {
+    return false;
+  }
+  if (data->GetMTime() != m_loadedShapeTime)
+  {
+    // The shape has been edited in place; the file no longer matches it.
+    m_shapeHandle.reset();
+    return false;
+  }
+  this->unloadShape();
+  return true;
+}
+
+void DiscreteGeometry::initializeShape(
+  const nlohmann::json& data,
+  smtk::resource::json::Helper& helper)
+{
+  std::shared_ptr<ShapeHandle> handle;
+  this->incoming<arcs::URLsToData>().visit([&handle](const URL* url) {
+    handle = std::make_shared<ShapeHandle>();
+    handle->location = url->location().data();
+    if (smtk::common::Paths::isRelative(handle->location))
+    {
+      // Relative paths must be relative to the resource's directory.
+      handle->location = smtk::common::Paths::canonical(
+        handle->location, smtk::common::Paths::directory(url->parentResource()->location()));
+    }
+    handle->mimeType = url->type();
+  });
+  if (!handle)
+  {
+    return;
+  }
+  auto jBounds = data.find("bounds");
+  if (jBounds != data.end())
+  {
+    handle->bounds = jBounds->get<std::array<double, 6>>();
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_shapeMutex);
+    m_shapeHandle = handle;
+  }
+
+  auto* cache = this->shapeCache();
+  if (cache && !cache->loadOnDemand())
+  {
+    helper.futures().emplace_back(
+      smtk::resource::json::Helper::threadPool()([this]() { this->shape(); }));
+  }
+}
+
+vtkSmartPointer<vtkDataObject> DiscreteGeometry::loadShape(const ShapeHandle& handle)
+{
+  vtkSmartPointer<vtkDataObject> result;
+  switch (handle.mimeType.id())
+  {
+    case "vtk/polydata"_hash:
+    case "vtk/unstructured-grid"_hash:
+    {
+      vtkNew<vtkDataSetReader> reader;
+      reader->SetFileName(handle.location.c_str());
+      reader->Update();
+      result = reader->GetOutputDataObject(0);
+    }
+    break;
+    case "vtk/image"_hash:
+    {
+      vtkNew<vtkXMLImageDataReader> reader;
+      reader->SetFileName(handle.location.c_str());
+      reader->Update();
+      result = reader->GetOutputDataObject(0);
+    }
+    break;
+    default:
+      smtkErrorMacro(
+        smtk::io::Logger::instance(),
+        "Unsupported shape format \"" << handle.mimeType.data() << "\"");
+      break;
+  }
+  return result;
+}
+
+void DiscreteGeometry::shapeAccessed(vtkDataObject* data, bool loaded) const
+{
+  if (auto* cache = this->shapeCache())
+  {
+    // GetActualMemorySize() reports kibibytes.
+    std::size_t bytes = loaded ? static_cast<std::size_t>(data->GetActualMemorySize()) * 1024 : 0;
+    cache->touch(std::const_pointer_cast<DiscreteGeometry>(this->as<DiscreteGeometry>()), bytes);
+  }
+}
+
+void DiscreteGeometry::shapeForgotten() const
+{
+  if (auto* cache = this->shapeCache())
+  {
+    cache->forget(this);
+  }
+}
+
+ShapeCache* DiscreteGeometry::shapeCache() const
+{
+  auto* resource = dynamic_cast<Resource*>(this->parentResource());
+  return resource ? &resource->shapeCache() : nullptr;
+}
+
 bool DiscreteGeometry::updateChildren(
   vtkSmartPointer<vtkDataObject> newShape,
   ShapeOptions& options)
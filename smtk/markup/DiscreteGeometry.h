@@ -14,9 +14,15 @@
 
 #include "smtk/operation/Operation.h"
 
+#include "smtk/string/Token.h"
+
 #include "vtkDataObject.h"
 #include "vtkSmartPointer.h"
 
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace smtk
@@ -25,10 +31,15 @@ namespace markup
 {
 
 class AssignedIds;
+class ShapeCache;
 
 /** Represent a discrete geometric shape as a modeling entity.
   *
   * This class and its subclasses are implemented using VTK data.
+  *
+  * Shape data read from a file is not loaded until it is first requested
+  * (see ShapeHandle and ShapeCache); until then the node holds only a
+  * handle describing where the data lives.
   */
 class SMTKMARKUP_EXPORT DiscreteGeometry : public smtk::markup::SpatialData
 {
@@ -62,6 +73,53 @@ public:
   /// Return the VTK data defining the shape of this component.
   virtual vtkSmartPointer<vtkDataObject> shape() const;
 
+  /// A reference to shape data held in a file, used to load it on demand.
+  struct ShapeHandle
+  {
+    /// The absolute path of the file holding the shape data.
+    std::string location;
+    /// The MIME type of the file (e.g., "vtk/image").
+    smtk::string::Token mimeType;
+    /// The shape's bounds if they are known (xmin, xmax, ymin, ymax, zmin, zmax).
+    ///
+    /// Bounds whose minima exceed their maxima are unknown.
+    std::array<double, 6> bounds{ { 1., -1., 1., -1., 1., -1. } };
+  };
+
+  /// Return the handle from which this node's shape is (re)loaded.
+  ///
+  /// This is null when the shape exists only in memory (i.e., it was
+  /// created or modified by an operation and has not been written).
+  std::shared_ptr<const ShapeHandle> shapeHandle() const;
+
+  /// Return true if this node's shape data is currently held in memory.
+  bool isShapeLoaded() const;
+
+  /// Return true if this node has shape data, whether or not it is loaded.
+  bool hasShape() const;
+
+  /// Fetch the bounds of this node's shape without loading it when possible.
+  ///
+  /// Returns false if the shape is not loaded and its handle does not record
+  /// its bounds (or if there is no shape).
+  bool shapeBounds(std::array<double, 6>& bounds) const;
+
+  /// Record that this node's shape data (which must be loaded) is stored in \a location.
+  ///
+  /// This is called after a shape is written so that it may be released
+  /// from memory (and reloaded from \a location on demand).
+  void setShapeStored(const std::string& location, smtk::string::Token mimeType);
+
+  /// Release this node's shape data from memory if it can be reloaded.
+  ///
+  /// Shapes are only released when they have a handle and have not been
+  /// modified since they were loaded (as judged by their modification time).
+  /// If the shape was modified, its handle is discarded so that the edits
+  /// are kept. Returns true if the shape was released.
+  ///
+  /// This is usually called by the resource's ShapeCache.
+  bool releaseShape();
+
   /**\brief A base class for subclasses of DiscreteGeometry to use
     *       when passing options to updateChildren() and setShapeData().
     *
@@ -99,6 +157,81 @@ protected:
     * newly-assigned IDs (which this method does **not** update for you).
     */
   bool updateChildren(vtkSmartPointer<vtkDataObject> newShape, ShapeOptions& options);
+
+  /// Return the shape data held in \a member, loading it from the shape handle if needed.
+  ///
+  /// Subclasses call this from their shapeData() methods.
+  template<typename DataType>
+  vtkSmartPointer<DataType> fetchShape(vtkSmartPointer<DataType>& member) const
+  {
+    vtkSmartPointer<DataType> result;
+    bool loaded = false;
+    bool releasable = false;
+    {
+      std::lock_guard<std::mutex> lock(m_shapeMutex);
+      if (!member && m_shapeHandle)
+      {
+        member = DataType::SafeDownCast(this->loadShape(*m_shapeHandle));
+        m_loadedShapeTime = member ? member->GetMTime() : 0;
+        loaded = !!member;
+      }
+      result = member;
+      releasable = !!m_shapeHandle;
+    }
+    if (result && releasable)
+    {
+      this->shapeAccessed(result, loaded);
+    }
+    return result;
+  }
+
+  /// Assign \a data to \a member as this node's new shape.
+  ///
+  /// Subclasses must use this to replace their shape data so that any
+  /// handle to the (now outdated) on-disk data is discarded.
+  template<typename DataType>
+  void replaceShape(vtkSmartPointer<DataType>& member, const vtkSmartPointer<DataType>& data)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_shapeMutex);
+      member = data;
+      m_shapeHandle.reset();
+    }
+    this->shapeForgotten();
+  }
+
+  /// Record a handle to the shape data referenced by this node's URL (called while reading).
+  ///
+  /// Bounds are taken from \a data when present. If the resource is not
+  /// configured to load shapes on demand, the shape is loaded on a worker
+  /// thread whose future is added to \a helper.
+  void initializeShape(const nlohmann::json& data, smtk::resource::json::Helper& helper);
+
+  /// Read shape data from the file described by \a handle.
+  static vtkSmartPointer<vtkDataObject> loadShape(const ShapeHandle& handle);
+
+  /// Subclasses must override this to return their shape data without loading it.
+  ///
+  /// This is called with m_shapeMutex held.
+  virtual vtkDataObject* loadedShape() const { return nullptr; }
+  /// Subclasses must override this to drop their shape data (which can be reloaded).
+  ///
+  /// This is called with m_shapeMutex held.
+  virtual void unloadShape() {}
+
+  /// Serializes access to shape data and the shape handle.
+  mutable std::mutex m_shapeMutex;
+  std::shared_ptr<const ShapeHandle> m_shapeHandle;
+
+private:
+  // Report an access to the shape to the resource's cache.
+  void shapeAccessed(vtkDataObject* data, bool loaded) const;
+  // Tell the resource's cache the shape may no longer be released.
+  void shapeForgotten() const;
+  ShapeCache* shapeCache() const;
+
+  // The modification time of the shape when it was loaded or stored.
+  mutable vtkMTimeType m_loadedShapeTime{ 0 };
 };
 
 } // namespace markup
@@ -14,10 +14,7 @@
 
 #include "smtk/resource/json/Helper.h"
 
-#include "smtk/common/Paths.h"
-
 #include "vtkImageData.h"
-#include "vtkXMLImageDataReader.h"
 
 using namespace smtk::string::literals; // for ""_token
 
@@ -46,36 +43,8 @@ void ImageData::initialize(const nlohmann::json& data, smtk::resource::json::Hel
     std::make_shared<smtk::markup::AssignedIds>(pointSpace, pnat, jprr[0], jprr[1], this);
   m_cellIds = std::make_shared<smtk::markup::AssignedIds>(cellSpace, cnat, jcrr[0], jcrr[1], this);
 
-  // Fetch data from shape URL.
-  this->incoming<arcs::URLsToData>().visit([this, &helper](const URL* url) {
-    std::string location = url->location().data();
-    if (smtk::common::Paths::isRelative(location))
-    {
-      // Relative paths must be relative to the resource's directory.
-      location = smtk::common::Paths::canonical(
-        location, smtk::common::Paths::directory(url->parentResource()->location()));
-    }
-    smtk::string::Token mimeType = url->type();
-    helper.futures().emplace_back(
-      smtk::resource::json::Helper::threadPool()([this, &helper, location, mimeType]() {
-        switch (mimeType.id())
-        {
-          case "vtk/image"_hash:
-          {
-            vtkNew<vtkXMLImageDataReader> reader;
-            reader->SetFileName(location.c_str());
-            reader->Update();
-            m_image = reader->GetOutput();
-          }
-          break;
-          default:
-            smtkErrorMacro(
-              smtk::io::Logger::instance(),
-              "Unsupported image format \"" << mimeType.data() << "\"");
-            break;
-        }
-      }));
-  });
+  // Record where shape data lives so it can be loaded on demand.
+  this->initializeShape(data, helper);
 }
 
 std::unordered_set<Domain*> ImageData::domains() const
@@ -115,7 +84,7 @@ void ImageData::assignedIds(std::vector<AssignedIds*>& assignments) const
 bool ImageData::setShapeData(vtkSmartPointer<vtkImageData> image, Superclass::ShapeOptions& options)
 {
   bool didChange = false;
-  if (image == m_image)
+  if (image == this->shapeData())
   {
     return didChange;
   }
@@ -127,13 +96,13 @@ bool ImageData::setShapeData(vtkSmartPointer<vtkImageData> image, Superclass::Sh
   auto numberOfPointsPrior = m_pointIds ? m_pointIds->size() : 0;
   auto numberOfCellsPrior = m_cellIds ? m_cellIds->size() : 0;
 
-  m_image = image;
+  this->replaceShape(m_image, image);
   didChange = true;
 
   // TODO: Find child Subset/Sideset nodes and adjust? We don't have enough
   //       context here to translate IDs in point/cell space because we don't
   //       know why the shapeData is being replaced.
-  if (m_image)
+  if (image)
   {
     auto* resource = dynamic_cast<Resource*>(this->parentResource());
     auto numberOfPoints = static_cast<std::size_t>(image->GetNumberOfPoints());
@@ -169,6 +138,26 @@ bool ImageData::setShapeData(vtkSmartPointer<vtkImageData> image, Superclass::Sh
   return didChange;
 }
 
+vtkSmartPointer<vtkImageData> ImageData::shapeData() const
+{
+  return this->fetchShape(m_image);
+}
+
+vtkSmartPointer<vtkDataObject> ImageData::shape() const
+{
+  return this->fetchShape(m_image);
+}
+
+vtkDataObject* ImageData::loadedShape() const
+{
+  return m_image;
+}
+
+void ImageData::unloadShape()
+{
+  m_image = nullptr;
+}
+
 bool ImageData::assign(
   const smtk::graph::Component::ConstPtr& source,
   smtk::resource::CopyOptions& options)
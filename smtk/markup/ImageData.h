@@ -82,21 +82,26 @@ public:
   /// Return the geometric content for this node as a vtkImageData.
   ///
   /// This method is not inherited and provides output in the node's native format.
-  vtkSmartPointer<vtkImageData> shapeData() const { return m_image; }
+  /// If the image has not been loaded from its file yet, it is loaded now.
+  vtkSmartPointer<vtkImageData> shapeData() const;
   /// Return the geometric content for this node.
   ///
   /// This method is inherited from DiscreteGeometry and does not make any assumptions
   /// about the type of data returned.
-  vtkSmartPointer<vtkDataObject> shape() const override { return m_image; }
+  vtkSmartPointer<vtkDataObject> shape() const override;
 
   /// Assign this node's state from \a source.
   bool assign(const smtk::graph::Component::ConstPtr& source, smtk::resource::CopyOptions& options)
     override;
 
 protected:
+  vtkDataObject* loadedShape() const override;
+  void unloadShape() override;
+
   std::shared_ptr<AssignedIds> m_pointIds;
   std::shared_ptr<AssignedIds> m_cellIds;
-  vtkSmartPointer<vtkImageData> m_image;
+  // Loaded on demand by shapeData(), so it may be modified by const methods.
+  mutable vtkSmartPointer<vtkImageData> m_image;
 };
 
 } // namespace markup
@@ -139,6 +139,25 @@ std::function<bool(const smtk::resource::Component&)> Resource::queryOperation(
   return smtk::resource::filter::Filter<smtk::graph::filter::Grammar>(query);
 }
 
+std::shared_ptr<const smtk::resource::filter::Rules> Resource::queryRules(
+  const std::string& query) const
+{
+  return smtk::resource::filter::Filter<smtk::graph::filter::Grammar>(query).rules();
+}
+
+bool Resource::componentIdsOfType(
+  const std::string& typeName,
+  std::unordered_set<smtk::common::UUID>& ids) const
+{
+  const auto& nodesByTypeName = NodeContainer::m_nodes.get<detail::TypeNameTag>();
+  auto range = nodesByTypeName.equal_range(typeName);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    ids.insert((*it)->id());
+  }
+  return true;
+}
+
 bool Resource::setLengthUnit(const std::string& unit)
 {
   auto unitSys = this->unitSystem();
@@ -15,6 +15,7 @@
 #include "smtk/markup/Domain.h"
 #include "smtk/markup/DomainFactory.h"
 #include "smtk/markup/DomainMap.h"
+#include "smtk/markup/ShapeCache.h"
 #include "smtk/markup/Traits.h"
 #include "smtk/resource/DerivedFrom.h"
 #include "smtk/resource/Manager.h"
@@ -86,6 +87,15 @@ public:
   std::function<bool(const smtk::resource::Component&)> queryOperation(
     const std::string& query) const override;
 
+  /// Return the parsed rules of a string \a query (used to plan filter() calls).
+  std::shared_ptr<const smtk::resource::filter::Rules> queryRules(
+    const std::string& query) const override;
+
+  /// Report the UUIDs of nodes with the exact \a typeName using the type-name index.
+  bool componentIdsOfType(
+    const std::string& typeName,
+    std::unordered_set<smtk::common::UUID>& ids) const override;
+
   /**\brief Return the resource's catalog of domains.
     *
     */
@@ -113,6 +123,15 @@ public:
   std::string lengthUnit() const { return m_lengthUnit; }
   bool setLengthUnit(const std::string& unit);
 
+  /**\brief Return the cache of shape data this resource's nodes hold in memory.
+    *
+    * Use this to configure whether shape data is loaded on demand and how
+    * much memory loaded shapes may occupy before the least-recently-used
+    * ones are released.
+    */
+  ShapeCache& shapeCache() { return m_shapeCache; }
+  const ShapeCache& shapeCache() const { return m_shapeCache; }
+
 protected:
   friend class Component;
 
@@ -128,6 +147,7 @@ protected:
   static DomainFactory s_domainFactory;
 
   std::string m_lengthUnit;
+  ShapeCache m_shapeCache;
 };
 
 template<typename Modifier>
@@ -0,0 +1,145 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/markup/ShapeCache.h"
+
+#include "smtk/markup/DiscreteGeometry.h"
+
+namespace smtk
+{
+namespace markup
+{
+
+void ShapeCache::setMemoryBudget(std::size_t bytes)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_memoryBudget = bytes;
+  this->enforceBudget(nullptr);
+}
+
+std::size_t ShapeCache::memoryBudget() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memoryBudget;
+}
+
+std::size_t ShapeCache::memoryInUse() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memoryInUse;
+}
+
+std::size_t ShapeCache::numberOfShapes() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+void ShapeCache::setLoadOnDemand(bool onDemand)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_loadOnDemand = onDemand;
+}
+
+bool ShapeCache::loadOnDemand() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_loadOnDemand;
+}
+
+void ShapeCache::touch(const std::shared_ptr<DiscreteGeometry>& node, std::size_t bytes)
+{
+  if (!node)
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_index.find(node.get());
+  if (it == m_index.end())
+  {
+    if (bytes == 0)
+    {
+      // The shape was never reported as loaded (or has been forgotten).
+      return;
+    }
+    m_entries.push_front(Entry{ node.get(), node, bytes });
+    m_index[node.get()] = m_entries.begin();
+    m_memoryInUse += bytes;
+  }
+  else
+  {
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    if (bytes > 0)
+    {
+      m_memoryInUse = m_memoryInUse - it->second->bytes + bytes;
+      it->second->bytes = bytes;
+    }
+  }
+  this->enforceBudget(node.get());
+}
+
+void ShapeCache::forget(const DiscreteGeometry* node)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_index.find(node);
+  if (it != m_index.end())
+  {
+    this->erase(it->second);
+  }
+}
+
+void ShapeCache::releaseAll()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  while (!m_entries.empty())
+  {
+    auto it = std::prev(m_entries.end());
+    if (auto node = it->node.lock())
+    {
+      node->releaseShape();
+    }
+    this->erase(it);
+  }
+}
+
+void ShapeCache::enforceBudget(const DiscreteGeometry* keep)
+{
+  if (m_memoryBudget == 0)
+  {
+    return;
+  }
+  auto it = m_entries.end();
+  while (m_memoryInUse > m_memoryBudget && it != m_entries.begin())
+  {
+    --it;
+    if (it->key == keep)
+    {
+      continue;
+    }
+    // Nodes that have been deleted no longer hold any data; nodes whose
+    // shapes have been modified since loading refuse to release them and
+    // are not tracked further. Either way, the entry is removed.
+    if (auto node = it->node.lock())
+    {
+      node->releaseShape();
+    }
+    auto victim = it++;
+    this->erase(victim);
+  }
+}
+
+void ShapeCache::erase(EntryList::iterator it)
+{
+  m_memoryInUse -= it->bytes;
+  m_index.erase(it->key);
+  m_entries.erase(it);
+}
+
+} // namespace markup
+} // namespace smtk
@@ -0,0 +1,107 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_markup_ShapeCache_h
+#define smtk_markup_ShapeCache_h
+
+#include "smtk/markup/Exports.h"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace smtk
+{
+namespace markup
+{
+
+class DiscreteGeometry;
+
+/**\brief Track the shape data a markup resource holds in memory.
+  *
+  * Shape data for DiscreteGeometry nodes that was read from a file is
+  * (by default) not loaded until it is first requested. Once loaded, a
+  * node reports each access to its resource's cache, which keeps nodes
+  * in least-recently-used order along with the size of their data.
+  *
+  * When a memory budget is set and the data held by the cache exceeds it,
+  * the least-recently-used shapes are released. Released shapes are loaded
+  * again (from the same file) the next time they are requested. Only shapes
+  * that have not been modified since they were loaded (or written) are ever
+  * released; shapes created or edited by operations stay in memory until
+  * the resource is written.
+  *
+  * All methods are thread-safe.
+  */
+class SMTKMARKUP_EXPORT ShapeCache
+{
+public:
+  ShapeCache() = default;
+  ShapeCache(const ShapeCache&) = delete;
+  ShapeCache& operator=(const ShapeCache&) = delete;
+
+  /// Set/get the number of bytes of releasable shape data to hold in memory.
+  ///
+  /// A budget of 0 (the default) imposes no limit. Reducing the budget
+  /// releases shapes immediately.
+  void setMemoryBudget(std::size_t bytes);
+  std::size_t memoryBudget() const;
+
+  /// Return the number of bytes of releasable shape data currently held.
+  std::size_t memoryInUse() const;
+
+  /// Return the number of releasable shapes currently held.
+  std::size_t numberOfShapes() const;
+
+  /// Set/get whether shape data is loaded when first requested (the default)
+  /// or while the resource is being read.
+  void setLoadOnDemand(bool onDemand);
+  bool loadOnDemand() const;
+
+  /// Record an access to \a node's shape.
+  ///
+  /// Pass the size of the shape in \a bytes when it has just been loaded
+  /// (or has just become releasable); pass 0 to mark a shape already in the
+  /// cache as most-recently used. This may release other shapes.
+  void touch(const std::shared_ptr<DiscreteGeometry>& node, std::size_t bytes = 0);
+
+  /// Stop tracking \a node (because its shape may no longer be released).
+  void forget(const DiscreteGeometry* node);
+
+  /// Release every shape the cache holds that can be reloaded.
+  void releaseAll();
+
+private:
+  struct Entry
+  {
+    const DiscreteGeometry* key;
+    std::weak_ptr<DiscreteGeometry> node;
+    std::size_t bytes;
+  };
+  using EntryList = std::list<Entry>;
+
+  // Release least-recently-used shapes (other than \a keep) until within budget.
+  // The caller must hold m_mutex.
+  void enforceBudget(const DiscreteGeometry* keep);
+  void erase(EntryList::iterator it);
+
+  mutable std::mutex m_mutex;
+  EntryList m_entries; // Most-recently used at the front.
+  std::unordered_map<const DiscreteGeometry*, EntryList::iterator> m_index;
+  std::size_t m_memoryBudget{ 0 };
+  std::size_t m_memoryInUse{ 0 };
+  bool m_loadOnDemand{ true };
+};
+
+} // namespace markup
+} // namespace smtk
+
+#endif // smtk_markup_ShapeCache_h
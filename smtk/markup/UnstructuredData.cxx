@@ -13,18 +13,14 @@
 #include "smtk/markup/Resource.h"
 #include "smtk/markup/SequentialAssignedIds.h"
 
-#include "smtk/common/Paths.h"
 #include "smtk/resource/json/Helper.h"
 
+#include "vtkCellTypes.h"
 #include "vtkDataObject.h"
 #include "vtkDataSetAttributes.h"
-#include "vtkDataSetReader.h"
 #include "vtkImageData.h"
 #include "vtkNew.h"
-#include "vtkPolyDataReader.h"
 #include "vtkUnstructuredGrid.h"
-#include "vtkUnstructuredGridReader.h"
-#include "vtkXMLImageDataReader.h"
 
 using namespace smtk::string::literals; // for ""_token
 
@@ -119,62 +115,8 @@ void UnstructuredData::initialize(const nlohmann::json& data, smtk::resource::js
     std::make_shared<smtk::markup::AssignedIds>(pointSpace, pnat, jprr[0], jprr[1], this);
   m_cellIds = std::make_shared<smtk::markup::AssignedIds>(cellSpace, cnat, jcrr[0], jcrr[1], this);
 
-  // Fetch data from shape URL.
-  this->incoming<arcs::URLsToData>().visit([this, &helper](const URL* url) {
-    std::string location = url->location().data();
-    if (smtk::common::Paths::isRelative(location))
-    {
-      // Relative paths must be relative to the resource's directory.
-      location = smtk::common::Paths::canonical(
-        location, smtk::common::Paths::directory(url->parentResource()->location()));
-    }
-    smtk::string::Token mimeType = url->type();
-    helper.futures().emplace_back(
-      smtk::resource::json::Helper::threadPool()([this, &helper, location, mimeType]() {
-        switch (mimeType.id())
-        {
-          case "vtk/polydata"_hash:
-          {
-            // vtkNew<vtkPolyDataReader> reader;
-            vtkNew<vtkDataSetReader> reader;
-            reader->SetFileName(location.c_str());
-            reader->Update();
-            // Do not call this->setShapeData(...) here since that could create nodes
-            // that have already been read from the file. This could happen because
-            // the order in which nodes are initialized is unspecified; field metadata
-            // may not have been initialized.
-            m_mesh = reader->GetOutputDataObject(0);
-          }
-          break;
-          case "vtk/unstructured-grid"_hash:
-          {
-            // vtkNew<vtkUnstructuredGridReader> reader;
-            vtkNew<vtkDataSetReader> reader;
-            reader->SetFileName(location.c_str());
-            reader->Update();
-            // Do not call this->setShapeData(...) here since that could create nodes
-            // that have already been read from the file. This could happen because
-            // the order in which nodes are initialized is unspecified; Field metadata
-            // may not have been initialized.
-            m_mesh = reader->GetOutputDataObject(0);
-          }
-          break;
-          case "vtk/image"_hash:
-          {
-            vtkNew<vtkXMLImageDataReader> reader;
-            reader->SetFileName(location.c_str());
-            reader->Update();
-            m_mesh = reader->GetOutputDataObject(0);
-          }
-          break;
-          default:
-            smtkErrorMacro(
-              smtk::io::Logger::instance(),
-              "Unsupported shape format \"" << mimeType.data() << "\"");
-            break;
-        }
-      }));
-  });
+  // Record where shape data lives so it can be loaded on demand.
+  this->initializeShape(data, helper);
 }
 
 std::unordered_set<Domain*> UnstructuredData::domains() const
@@ -216,7 +158,7 @@ bool UnstructuredData::setShapeData(vtkSmartPointer<vtkDataObject> mesh, ShapeOp
   auto& sharedPointIds = options.sharedPointIds;
 
   bool didChange = false;
-  if (mesh == m_mesh)
+  if (mesh == this->shapeData())
   {
     return didChange;
   }
@@ -294,18 +236,33 @@ bool UnstructuredData::setShapeData(vtkSmartPointer<vtkDataObject> mesh, ShapeOp
     //       In some cases, operations might be able to preserve them.
   }
 
-  m_mesh = mesh;
-  this->properties().get<long>()["dimension"] = maxDimension(m_mesh);
+  this->replaceShape(m_mesh, mesh);
+  this->properties().get<long>()["dimension"] = maxDimension(mesh);
   didChange = true;
 
   return didChange;
 }
 
 vtkSmartPointer<vtkDataObject> UnstructuredData::shapeData() const
+{
+  return this->fetchShape(m_mesh);
+}
+
+vtkSmartPointer<vtkDataObject> UnstructuredData::shape() const
+{
+  return this->fetchShape(m_mesh);
+}
+
+vtkDataObject* UnstructuredData::loadedShape() const
 {
   return m_mesh;
 }
 
+void UnstructuredData::unloadShape()
+{
+  m_mesh = nullptr;
+}
+
 ArcEndpointInterface<arcs::BoundariesToShapes, ConstArc, OutgoingArc> UnstructuredData::parents()
   const
 {
@@ -79,12 +79,14 @@ public:
   ///
   /// Because unstructured data may be modeled with vtkPolyData, vtkUnstructuredGrid,
   /// or vtkCellGrid data, there is no better type to return.
+  ///
+  /// If the data has not been loaded from its file yet, it is loaded now.
   vtkSmartPointer<vtkDataObject> shapeData() const;
   /// Return the geometric content for this node.
   ///
   /// This method is inherited from DiscreteGeometry and does not make any assumptions
   /// about the type of data returned.
-  vtkSmartPointer<vtkDataObject> shape() const override { return m_mesh; }
+  vtkSmartPointer<vtkDataObject> shape() const override;
 
   const AssignedIds& pointIds() const { return *m_pointIds; }
   const AssignedIds& cellIds() const { return *m_cellIds; }
@@ -102,9 +104,13 @@ public:
     override;
 
 protected:
+  vtkDataObject* loadedShape() const override;
+  void unloadShape() override;
+
   std::shared_ptr<AssignedIds> m_pointIds;
   std::shared_ptr<AssignedIds> m_cellIds;
-  vtkSmartPointer<vtkDataObject> m_mesh;
+  // Loaded on demand by shapeData(), so it may be modified by const methods.
+  mutable vtkSmartPointer<vtkDataObject> m_mesh;
 };
 
 } // namespace markup
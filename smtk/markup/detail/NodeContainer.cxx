@@ -21,7 +21,7 @@ void NodeContainer::visit(Visitor visitor) const
   const auto& nodesById = m_nodes.get<IdTag>();
   for (const auto& node : nodesById)
   {
-    auto component = std::dynamic_pointer_cast<smtk::resource::Component>(node);
+    smtk::resource::ComponentPtr component = node;
     visitor(component);
   }
 }
@@ -52,33 +52,34 @@ smtk::resource::Component* NodeContainer::component(const smtk::common::UUID& uu
 
 std::size_t NodeContainer::eraseNodes(const smtk::resource::ComponentPtr& node)
 {
-  std::size_t didErase = 0;
-  auto graphNode = std::dynamic_pointer_cast<Component>(node);
-  if (!graphNode)
-  {
-    return didErase;
-  }
-  auto& nodesById = m_nodes.get<IdTag>();
-  auto it = nodesById.find(graphNode->id());
-  if (it != nodesById.end())
+  if (!node)
   {
-    nodesById.erase(node->id());
-    didErase = 1;
+    return 0;
   }
-  return didErase;
+  return m_nodes.get<IdTag>().erase(node->id());
 }
 
 bool NodeContainer::insertNode(const smtk::resource::ComponentPtr& node)
 {
-  bool didInsert = false;
   auto graphNode = std::dynamic_pointer_cast<Component>(node);
   if (!graphNode)
   {
-    return didInsert;
+    return false;
   }
+  return m_nodes.get<IdTag>().insert(graphNode).second;
+}
+
+std::size_t NodeContainer::insertNodes(const std::vector<smtk::graph::ComponentPtr>& nodes)
+{
+  // Size the hash table once rather than rehashing as the batch is inserted.
   auto& nodesById = m_nodes.get<IdTag>();
-  auto result = nodesById.insert(graphNode);
-  return result.second;
+  nodesById.reserve(nodesById.size() + nodes.size());
+  std::size_t count = 0;
+  for (const auto& node : nodes)
+  {
+    count += this->insertNode(node) ? 1 : 0;
+  }
+  return count;
 }
 
 } // namespace detail
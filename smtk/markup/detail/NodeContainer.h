@@ -14,12 +14,14 @@
 #include "smtk/markup/Component.h"
 
 #include "boost/multi_index/global_fun.hpp"
+#include "boost/multi_index/hashed_index.hpp"
 #include "boost/multi_index/mem_fun.hpp"
 #include "boost/multi_index/ordered_index.hpp"
 #include "boost/multi_index_container.hpp"
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace smtk
 {
@@ -77,6 +79,10 @@ inline std::string name(const smtk::markup::Component::Ptr& c)
 }
 
 /**\brief Storage for markup graph nodes.
+  *
+  * Nodes are indexed by UUID in a hash table so that lookups take constant
+  * time; they are also indexed by name and type. Nodes are visited in no
+  * particular order.
   */
 class SMTKMARKUP_EXPORT NodeContainer
 {
@@ -135,14 +141,21 @@ protected:
     */
   bool insertNode(const smtk::resource::ComponentPtr& node);
 
+  /**\brief Unconditionally insert a batch of \a nodes, returning the number inserted.
+    *
+    * The hashed indices are sized once for the whole batch.
+    */
+  std::size_t insertNodes(const std::vector<smtk::graph::ComponentPtr>& nodes);
+
   /// The node-container typename, which specifies how to index nodes.
   using Container = boost::multi_index_container<
     std::shared_ptr<smtk::markup::Component>,
     boost::multi_index::indexed_by<
-      boost::multi_index::ordered_unique< // Should be hashed
+      boost::multi_index::hashed_unique<
         boost::multi_index::tag<IdTag>,
         boost::multi_index::
-          global_fun<const Component::Ptr&, const smtk::common::UUID&, &detail::id>>,
+          global_fun<const Component::Ptr&, const smtk::common::UUID&, &detail::id>,
+        std::hash<smtk::common::UUID>>,
       boost::multi_index::ordered_non_unique<
         boost::multi_index::tag<NameTag>,
         boost::multi_index::global_fun<const Component::Ptr&, std::string, &detail::name>>,
@@ -107,20 +107,32 @@ void to_json(json& jj, const smtk::markup::Field* field)
 void to_json(json& jj, const smtk::markup::ImageData* image)
 {
   to_json(jj, static_cast<const smtk::markup::Component*>(image));
-  if (image->shapeData())
+  // Do not load shape data just to serialize its IDs.
+  if (image->hasShape())
   {
     jj["point_ids"] = image->pointIds();
     jj["cell_ids"] = image->cellIds();
+    std::array<double, 6> bounds;
+    if (image->shapeBounds(bounds))
+    {
+      jj["bounds"] = bounds;
+    }
   }
 }
 
 void to_json(json& jj, const smtk::markup::UnstructuredData* unstructuredData)
 {
   to_json(jj, static_cast<const smtk::markup::Component*>(unstructuredData));
-  if (unstructuredData->shapeData())
+  // Do not load shape data just to serialize its IDs.
+  if (unstructuredData->hasShape())
   {
     jj["point_ids"] = unstructuredData->pointIds();
     jj["cell_ids"] = unstructuredData->cellIds();
+    std::array<double, 6> bounds;
+    if (unstructuredData->shapeBounds(bounds))
+    {
+      jj["bounds"] = bounds;
+    }
   }
 }
 
@@ -161,15 +173,8 @@ void from_json(const json& jj, std::shared_ptr<NodeType>& node)
     // Note that you must provide a constructor that passes these arguments
     // to the base graph-resource component class or you will have build errors.
     node = std::make_shared<NodeType>(resource, jj["id"].get<smtk::common::UUID>());
-    // Adding the node can fail if the node's type is disallowed by the resource.
-    if (!resource->addNode(node))
-    {
-      smtkErrorMacro(smtk::io::Logger::instance(), "Could not add node.");
-    }
-    // TODO: Setting the name after insertion works but could be slow, since
-    // for multi-index containers the node must effectively be removed and
-    // then re-inserted to change the name. However, setting the name before
-    // adding the component fails because the container hasn't indexed it yet.
+    // Name the node before it is indexed; the caller (smtk::graph::NodeDeserializer)
+    // inserts nodes into the resource in bulk.
     auto it = jj.find("name");
     if (it != jj.end())
     {
@@ -313,9 +318,13 @@ void from_json(const nlohmann::json& jj, smtk::markup::Resource::Ptr& resource)
   }
 
   // Finally, wait for threads loading VTK data for node geometry to complete.
+  // (There are none unless the resource's shape cache is configured to load
+  // shapes eagerly.) Reads often run on one of the executor's own workers, so
+  // pending tasks are run while waiting rather than blocking the worker.
+  auto& executor = smtk::resource::json::Helper::threadPool();
   for (auto& work : helper.futures())
   {
-    work.wait();
+    executor.wait(work);
   }
 }
 
@@ -25,6 +25,7 @@
 #include "smtk/attribute/IntItem.h"
 #include "smtk/attribute/ResourceItem.h"
 #include "smtk/attribute/StringItem.h"
+#include "smtk/attribute/VoidItem.h"
 
 #include "smtk/resource/json/Helper.h"
 
@@ -77,6 +78,8 @@ Read::Result Read::operateInternal()
 
   auto resource = smtk::markup::Resource::create();
   resource->setLocation(filename);
+  resource->shapeCache().setLoadOnDemand(
+    this->parameters()->findVoid("load shapes on demand")->isEnabled());
 
   // Deserialize resource from a set of JSON records:
   auto& helper = smtk::resource::json::Helper::pushInstance(resource);
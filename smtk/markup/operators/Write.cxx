@@ -25,6 +25,7 @@
 #include "smtk/markup/json/jsonResource.h"
 
 #include "smtk/resource/json/Helper.h"
+#include "smtk/resource/json/jsonResource.h"
 
 #include "smtk/common/Paths.h"
 
@@ -148,6 +149,17 @@ Write::Result Write::operateInternal()
   // Serialize resource into a set of JSON records:
   nlohmann::json j = rsrc;
 
+  // Store numeric property tables beside the data written above rather than as JSON.
+  if (
+    !j.is_null() &&
+    !smtk::resource::writePropertiesFile(
+      j, rsrc, smtk::common::Paths::stem(rsrc->location()) + "/properties.smtkc"))
+  {
+    smtkErrorMacro(this->log(), "Could not write properties to \"" << smtkDirectory << "\".");
+    smtk::resource::json::Helper::popInstance();
+    return this->createResult(smtk::operation::Operation::Outcome::FAILED);
+  }
+
   // Save the JSON configurations of all the UI Elements in the
   // View Manager.
   auto managers = this->managers();
@@ -219,7 +231,6 @@ bool Write::writeData(
   const std::string& filename,
   smtk::string::Token mimeType)
 {
-  (void)mimeType;
   if (!dataNode)
   {
     return false;
@@ -228,6 +239,18 @@ bool Write::writeData(
   // Ensure directory holding filename exists:
   smtk::common::Paths::createDirectory(smtk::common::Paths::directory(filename));
 
+  // Shapes that have not been loaded are unmodified; if they already live
+  // at filename, there is no need to load them only to write them back.
+  auto* geometry = const_cast<DiscreteGeometry*>(dynamic_cast<const DiscreteGeometry*>(dataNode));
+  if (geometry && !geometry->isShapeLoaded())
+  {
+    auto handle = geometry->shapeHandle();
+    if (handle && handle->location == smtk::common::Paths::canonical(filename))
+    {
+      return true;
+    }
+  }
+
   if (const auto* udata = dynamic_cast<const UnstructuredData*>(dataNode))
   {
     // Could use mimeType to determine file format (e.g., XML or Legacy)
@@ -235,6 +258,8 @@ bool Write::writeData(
     wri->SetFileName(filename.c_str());
     wri->SetInputDataObject(udata->shapeData());
     wri->Write();
+    // The shape may now be released from memory and reloaded from filename.
+    geometry->setShapeStored(smtk::common::Paths::canonical(filename), mimeType);
     return true;
   }
   else if (const auto* idata = dynamic_cast<const ImageData*>(dataNode))
@@ -244,6 +269,7 @@ bool Write::writeData(
     wri->SetFileName(filename.c_str());
     wri->SetInputDataObject(idata->shapeData());
     wri->Write();
+    geometry->setShapeStored(smtk::common::Paths::canonical(filename), mimeType);
     return true;
   }
   smtkWarningMacro(
@@ -0,0 +1,93 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/markup/AssignedIds.h"
+#include "smtk/markup/IdSpace.h"
+
+#include "smtk/string/Token.h"
+
+#include "smtk/common/testing/cxx/Benchmark.h"
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace smtk::markup;
+using smtk::common::testing::Benchmark;
+
+// Time requests for (and queries of) ranges of IDs in a markup IdSpace
+// as the number of assignments grows.
+// Pass "-n <count>" to change the number of primary assignments (e.g., -n 200000),
+// "-o <file>" to record results, and "-b <file>" to compare against
+// recorded results (see smtk::common::testing::Benchmark for more).
+int BenchmarkIdSpace(int argc, char* argv[])
+{
+  using namespace smtk::string::literals;
+
+  // Queries copy every assignment that overlaps them, so costs grow quickly
+  // with the number of assignments; keep the default small enough for CI.
+  Benchmark benchmark("BenchmarkIdSpace", argc, argv, 1000);
+  std::size_t count = benchmark.scale();
+  const std::size_t maxRangeSize = 64;
+  smtkTest(count >= maxRangeSize, "The scale must be at least " << maxRangeSize << ".");
+
+  // Assignments must be released before the space that holds them.
+  std::vector<std::shared_ptr<AssignedIds>> primary;
+  std::shared_ptr<IdSpace> space;
+  benchmark.measure("idspace/requestPrimary", count, [&]() {
+    primary.clear();
+    space = std::make_shared<IdSpace>("points"_token);
+    for (std::size_t ii = 0; ii < count; ++ii)
+    {
+      primary.push_back(
+        space->requestRange(IdNature::Primary, 1 + benchmark.random(maxRangeSize)));
+    }
+  });
+  smtkTest(primary.back() != nullptr, "Could not request a primary range.");
+  IdType upper = space->range()[1];
+
+  std::vector<std::shared_ptr<AssignedIds>> referential;
+  benchmark.measure("idspace/requestReferential", count, [&]() {
+    referential.clear();
+    for (std::size_t ii = 0; ii < count; ++ii)
+    {
+      IdType size = 1 + benchmark.random(4 * maxRangeSize);
+      IdType begin = 1 + benchmark.random(upper - size - 1);
+      referential.push_back(space->requestRange(IdNature::Referential, size, begin));
+    }
+  });
+  smtkTest(referential.back() != nullptr, "Could not request a referential range.");
+
+  std::size_t overlapping = 0;
+  benchmark.measure("idspace/assignedIds", count, [&]() {
+    overlapping = 0;
+    for (std::size_t ii = 0; ii < count; ++ii)
+    {
+      IdType begin = 1 + benchmark.random(upper - 1);
+      overlapping += space->assignedIds(begin, begin + maxRangeSize, IdNature::Primary).size();
+    }
+  });
+  smtkTest(overlapping >= count, "Every query should overlap a primary assignment.");
+
+  std::size_t empty = 0;
+  benchmark.measure("idspace/isRangeEmpty", count, [&]() {
+    empty = 0;
+    for (std::size_t ii = 0; ii < count; ++ii)
+    {
+      IdType begin = 1 + benchmark.random(upper - 1);
+      empty += space->isRangeEmpty(begin, begin + maxRangeSize, IdNature::Primary) ? 1 : 0;
+    }
+  });
+  smtkTest(empty == 0, "No range below the upper bound should be empty.");
+
+  referential.clear();
+  primary.clear();
+  return benchmark.finish();
+}
@@ -0,0 +1,121 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/markup/ImageData.h"
+#include "smtk/markup/Registrar.h"
+#include "smtk/markup/Resource.h"
+#include "smtk/markup/URL.h"
+#include "smtk/markup/operators/Read.h"
+#include "smtk/markup/operators/Write.h"
+#include "smtk/markup/testing/cxx/helpers.h"
+
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/FileItem.h"
+#include "smtk/attribute/ReferenceItem.h"
+#include "smtk/attribute/ResourceItem.h"
+#include "smtk/attribute/VoidItem.h"
+
+#include "smtk/common/Executor.h"
+#include "smtk/operation/Manager.h"
+#include "smtk/plugin/Registry.h"
+#include "smtk/resource/Manager.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include "vtkImageData.h"
+#include "vtkSmartPointer.h"
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <set>
+#include <string>
+
+using namespace smtk::markup;
+
+// This test verifies that a markup resource whose shapes are loaded eagerly
+// can be read by an operation launched on the shared executor, even when the
+// executor has a single worker (so the read must run the loading tasks it
+// queues rather than wait for another worker to run them). CTest runs it with
+// SMTK_EXECUTOR_THREADS=1.
+
+namespace
+{
+std::string write_root = SMTK_SCRATCH_DIR;
+constexpr int numberOfImages = 3;
+} // anonymous namespace
+
+int TestLaunchedRead(int /*unused*/, char** const /*unused*/)
+{
+  auto managers = createTestManagers();
+  auto resourceManager = managers->get<smtk::resource::Manager::Ptr>();
+  auto operationManager = managers->get<smtk::operation::Manager::Ptr>();
+  auto markupRegistry =
+    smtk::plugin::addToManagers<smtk::markup::Registrar>(resourceManager, operationManager);
+
+  std::cout << "Executor has " << smtk::common::Executor::instance().numberOfThreads()
+            << " worker(s).\n";
+
+  std::string filename = write_root + "/TestLaunchedRead.smtk";
+
+  // Create and write a resource holding several images.
+  {
+    auto resource = Resource::create();
+    resource->setLocation(filename);
+    auto write = operationManager->create<smtk::markup::Write>();
+    for (int ii = 0; ii < numberOfImages; ++ii)
+    {
+      auto image = vtkSmartPointer<vtkImageData>::New();
+      image->SetDimensions(16, 16, 16);
+      image->AllocateScalars(VTK_FLOAT, 1);
+
+      auto node = resource->createNode<ImageData>();
+      node->setName("image " + std::to_string(ii));
+      ImageData::ShapeOptions options;
+      options.trackedChanges = write->createResult(smtk::operation::Operation::Outcome::SUCCEEDED);
+      node->setShapeData(image, options);
+
+      auto url = resource->createNode<URL>();
+      url->setType("vtk/image");
+      url->data().connect(node);
+    }
+    write->parameters()->associations()->appendValue(resource);
+    auto result = write->operate();
+    smtkTest(
+      smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::SUCCEEDED,
+      "Could not write \"" << filename << "\".");
+  }
+
+  // Launch a read that loads every shape before it completes.
+  auto read = operationManager->create<smtk::markup::Read>();
+  read->parameters()->findFile("filename")->setValue(filename);
+  read->parameters()->findVoid("load shapes on demand")->setIsEnabled(false);
+  auto future = operationManager->launchers()(read);
+  smtkTest(
+    future.wait_for(std::chrono::seconds(60)) == std::future_status::ready,
+    "Launched read did not complete (deadlock?).");
+  auto result = future.get();
+  smtkTest(
+    smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::SUCCEEDED,
+    "Could not read \"" << filename << "\".");
+
+  auto resource = result->findResource("resourcesCreated")->valueAs<Resource>();
+  auto images = resource->filterAs<std::set<ImageData::Ptr>>("'smtk::markup::ImageData'");
+  smtkTest(images.size() == numberOfImages, "Expected " << numberOfImages << " images.");
+  for (const auto& image : images)
+  {
+    smtkTest(image->isShapeLoaded(), "Image \"" << image->name() << "\" was not loaded.");
+  }
+
+  boost::filesystem::remove_all(write_root + "/TestLaunchedRead");
+  std::remove(filename.c_str());
+  return 0;
+}
@@ -0,0 +1,188 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/markup/ImageData.h"
+#include "smtk/markup/Registrar.h"
+#include "smtk/markup/Resource.h"
+#include "smtk/markup/URL.h"
+#include "smtk/markup/operators/Read.h"
+#include "smtk/markup/operators/Write.h"
+#include "smtk/markup/testing/cxx/helpers.h"
+
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/FileItem.h"
+#include "smtk/attribute/ReferenceItem.h"
+#include "smtk/attribute/ResourceItem.h"
+#include "smtk/attribute/VoidItem.h"
+
+#include "smtk/operation/Manager.h"
+#include "smtk/plugin/Registry.h"
+#include "smtk/resource/Manager.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include "vtkImageData.h"
+#include "vtkSmartPointer.h"
+
+#include <boost/filesystem.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace smtk::markup;
+
+// This test verifies that image data read from a markup resource is loaded
+// on demand and released (then reloaded) when the resource's shape cache
+// exceeds its memory budget, and that it is loaded before the read completes
+// when on-demand loading is disabled. See also TestLaunchedRead.
+
+namespace
+{
+std::string write_root = SMTK_SCRATCH_DIR;
+constexpr int numberOfImages = 3;
+
+std::vector<ImageData::Ptr> sortedImages(const Resource::Ptr& resource)
+{
+  std::vector<ImageData::Ptr> images(numberOfImages);
+  auto nodes = resource->filterAs<std::set<ImageData::Ptr>>("'smtk::markup::ImageData'");
+  for (const auto& image : nodes)
+  {
+    images[std::stoi(image->name().substr(6))] = image;
+  }
+  return images;
+}
+
+// Read a resource with an operation launched on the shared executor (as an
+// application would), so that eager shape loads run alongside the read.
+Resource::Ptr readResource(
+  const smtk::operation::Manager::Ptr& operationManager,
+  const std::string& filename,
+  bool onDemand)
+{
+  auto read = operationManager->create<smtk::markup::Read>();
+  smtkTest(
+    read->parameters()->findVoid("load shapes on demand")->isEnabled(),
+    "Shapes should be loaded on demand by default.");
+  read->parameters()->findFile("filename")->setValue(filename);
+  read->parameters()->findVoid("load shapes on demand")->setIsEnabled(onDemand);
+  auto future = operationManager->launchers()(read);
+  smtkTest(
+    future.wait_for(std::chrono::seconds(60)) == std::future_status::ready,
+    "Read of \"" << filename << "\" did not complete.");
+  auto result = future.get();
+  smtkTest(
+    smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::SUCCEEDED,
+    "Could not read \"" << filename << "\".");
+  return result->findResource("resourcesCreated")->valueAs<Resource>();
+}
+} // anonymous namespace
+
+int TestShapeCache(int /*unused*/, char** const /*unused*/)
+{
+  auto managers = createTestManagers();
+  auto resourceManager = managers->get<smtk::resource::Manager::Ptr>();
+  auto operationManager = managers->get<smtk::operation::Manager::Ptr>();
+  auto markupRegistry =
+    smtk::plugin::addToManagers<smtk::markup::Registrar>(resourceManager, operationManager);
+
+  std::string filename = write_root + "/TestShapeCache.smtk";
+
+  // Create and write a resource holding several images.
+  {
+    auto resource = Resource::create();
+    resource->setLocation(filename);
+    auto write = operationManager->create<smtk::markup::Write>();
+    for (int ii = 0; ii < numberOfImages; ++ii)
+    {
+      auto image = vtkSmartPointer<vtkImageData>::New();
+      image->SetDimensions(32, 32, 32);
+      image->SetOrigin(ii, 0., 0.);
+      image->AllocateScalars(VTK_FLOAT, 1);
+
+      auto node = resource->createNode<ImageData>();
+      node->setName("image " + std::to_string(ii));
+      ImageData::ShapeOptions options;
+      options.trackedChanges = write->createResult(smtk::operation::Operation::Outcome::SUCCEEDED);
+      node->setShapeData(image, options);
+      smtkTest(!node->shapeHandle(), "New shapes have no file to reload them from.");
+
+      auto url = resource->createNode<URL>();
+      url->setType("vtk/image");
+      url->data().connect(node);
+    }
+    write->parameters()->associations()->appendValue(resource);
+    auto result = write->operate();
+    smtkTest(
+      smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::SUCCEEDED,
+      "Could not write \"" << filename << "\".");
+    for (const auto& image : sortedImages(resource))
+    {
+      smtkTest(!!image->shapeHandle(), "Written shapes should be releasable.");
+    }
+  }
+
+  // Read the resource back; no images should be loaded.
+  auto resource = readResource(operationManager, filename, true);
+  auto images = sortedImages(resource);
+  for (int ii = 0; ii < numberOfImages; ++ii)
+  {
+    const auto& image = images[ii];
+    smtkTest(!!image, "Missing image " << ii << ".");
+    smtkTest(!image->isShapeLoaded(), "Image " << ii << " should not be loaded.");
+    smtkTest(image->hasShape(), "Image " << ii << " should have a shape.");
+    std::array<double, 6> bounds;
+    smtkTest(image->shapeBounds(bounds), "Bounds should be available without loading.");
+    smtkTest(bounds[0] == ii && bounds[1] == ii + 31., "Bad bounds for image " << ii << ".");
+    smtkTest(!image->isShapeLoaded(), "Fetching bounds should not load image " << ii << ".");
+  }
+  auto& cache = resource->shapeCache();
+  smtkTest(cache.numberOfShapes() == 0 && cache.memoryInUse() == 0, "Cache should be empty.");
+
+  // Accessing an image loads it.
+  auto data = images[0]->shapeData();
+  smtkTest(data && data->GetNumberOfPoints() == 32 * 32 * 32, "Image 0 was not loaded.");
+  smtkTest(images[0]->isShapeLoaded(), "Image 0 should be loaded.");
+  std::size_t imageBytes = cache.memoryInUse();
+  smtkTest(imageBytes > 0, "Cache did not account for image 0.");
+  data = nullptr;
+
+  // With room for only one image, loading another releases the least-recently used.
+  cache.setMemoryBudget(imageBytes + imageBytes / 2);
+  images[1]->shapeData();
+  smtkTest(!images[0]->isShapeLoaded(), "Image 0 should have been released.");
+  smtkTest(images[1]->isShapeLoaded(), "Image 1 should be loaded.");
+  smtkTest(cache.numberOfShapes() == 1, "Expected 1 image in the cache.");
+
+  // Released images are reloaded transparently.
+  data = images[0]->shapeData();
+  smtkTest(data && data->GetNumberOfPoints() == 32 * 32 * 32, "Image 0 was not reloaded.");
+  smtkTest(!images[1]->isShapeLoaded(), "Image 1 should have been released.");
+
+  // Images modified in place are never released.
+  images[2]->shapeData()->Modified();
+  images[0]->shapeData();
+  smtkTest(images[2]->isShapeLoaded(), "A modified image must not be released.");
+  smtkTest(!images[2]->shapeHandle(), "A modified image should no longer have a handle.");
+  smtkTest(cache.numberOfShapes() == 1, "Modified images should not be tracked.");
+
+  // Reading eagerly loads every image before the read completes.
+  resource = readResource(operationManager, filename, false);
+  for (const auto& image : sortedImages(resource))
+  {
+    smtkTest(image->isShapeLoaded(), "Images should be loaded eagerly.");
+  }
+
+  boost::filesystem::remove_all(write_root + "/TestShapeCache");
+  std::remove(filename.c_str());
+  return 0;
+}
@@ -67,6 +67,12 @@ didConnect = resource.connect(
 if not didConnect:
     raise 'Should have connected group to its member.'
 
+# Test filtering by following arcs from the group to its member
+members = resource.filter("'smtk::markup::Group' -[GroupsToMembers]-> *")
+print('Group members', [member.name() for member in members])
+if [member.name() for member in members] != ['bar_UnstructuredData']:
+    raise RuntimeError('Expected a path query to find the group member.')
+
 
 resource.dump('')
 # print(resource.domains())
@@ -1124,6 +1124,7 @@ void Resource::setFloatProperty(
   typedef resource::Properties::Indexed<std::vector<double>> FloatProperty;
   if (!entity.isNull())
   {
+    this->properties().touchIndex<std::vector<double>>(propName, entity);
     this->properties().data().get<FloatProperty>()[propName][entity] = { propValue };
   }
 }
@@ -1136,6 +1137,7 @@ void Resource::setFloatProperty(
   typedef resource::Properties::Indexed<std::vector<double>> FloatProperty;
   if (!entity.isNull())
   {
+    this->properties().touchIndex<std::vector<double>>(propName, entity);
     this->properties().data().get<FloatProperty>()[propName][entity] = propValue;
   }
 }
@@ -1158,6 +1160,8 @@ smtk::model::FloatList& Resource::floatProperty(const UUID& entity, const std::s
   typedef resource::Properties::Indexed<std::vector<double>> FloatProperty;
   if (!entity.isNull() && this->hasFloatProperty(entity, propName))
   {
+    // The caller may modify the returned value.
+    this->properties().touchIndex<std::vector<double>>(propName, entity);
     return this->properties().data().at<FloatProperty>(propName).at(entity);
   }
   static FloatList dummy;
@@ -1185,6 +1189,7 @@ bool Resource::removeFloatProperty(const UUID& entity, const std::string& propNa
     auto it = map.find(entity);
     if (it != map.end())
     {
+      this->properties().touchIndex<std::vector<double>>(propName, entity);
       map.erase(it);
       return true;
     }
@@ -1200,6 +1205,7 @@ void Resource::setStringProperty(
   typedef resource::Properties::Indexed<std::vector<std::string>> StringProperty;
   if (!entity.isNull())
   {
+    this->properties().touchIndex<std::vector<std::string>>(propName, entity);
     this->properties().data().get<StringProperty>()[propName][entity] = { propValue };
   }
 }
@@ -1212,6 +1218,7 @@ void Resource::setStringProperty(
   typedef resource::Properties::Indexed<std::vector<std::string>> StringProperty;
   if (!entity.isNull())
   {
+    this->properties().touchIndex<std::vector<std::string>>(propName, entity);
     this->properties().data().get<StringProperty>()[propName][entity] = propValue;
   }
 }
@@ -1234,6 +1241,8 @@ smtk::model::StringList& Resource::stringProperty(const UUID& entity, const std:
   typedef resource::Properties::Indexed<std::vector<std::string>> StringProperty;
   if (!entity.isNull() && this->hasStringProperty(entity, propName))
   {
+    // The caller may modify the returned value.
+    this->properties().touchIndex<std::vector<std::string>>(propName, entity);
     return this->properties().data().at<StringProperty>(propName).at(entity);
   }
   static StringList dummy;
@@ -1261,6 +1270,7 @@ bool Resource::removeStringProperty(const UUID& entity, const std::string& propN
     auto it = map.find(entity);
     if (it != map.end())
     {
+      this->properties().touchIndex<std::vector<std::string>>(propName, entity);
       map.erase(it);
       return true;
     }
@@ -1278,6 +1288,7 @@ void Resource::setIntegerProperty(
   {
     // this->properties().data().get<IntProperty>()[propName]
     //   .emplace(std::make_pair(entity, propValue));
+    this->properties().touchIndex<std::vector<long>>(propName, entity);
     this->properties().data().get<IntProperty>()[propName].emplace(
       smtk::common::UUID(entity), std::vector<long>(1, propValue));
     // this->properties().data().get<IntProperty>()[propName][entity] = { propValue };
@@ -1292,6 +1303,7 @@ void Resource::setIntegerProperty(
   typedef resource::Properties::Indexed<std::vector<long>> IntProperty;
   if (!entity.isNull())
   {
+    this->properties().touchIndex<std::vector<long>>(propName, entity);
     this->properties().data().get<IntProperty>()[propName][entity] = propValue;
   }
 }
@@ -1314,6 +1326,8 @@ smtk::model::IntegerList& Resource::integerProperty(const UUID& entity, const st
   typedef resource::Properties::Indexed<std::vector<long>> IntProperty;
   if (!entity.isNull() && this->hasIntegerProperty(entity, propName))
   {
+    // The caller may modify the returned value.
+    this->properties().touchIndex<std::vector<long>>(propName, entity);
     return this->properties().data().at<IntProperty>(propName).at(entity);
   }
   static IntegerList dummy;
@@ -1340,6 +1354,7 @@ bool Resource::removeIntegerProperty(const UUID& entity, const std::string& prop
     auto it = map.find(entity);
     if (it != map.end())
     {
+      this->properties().touchIndex<std::vector<long>>(propName, entity);
       map.erase(it);
       return true;
     }
@@ -593,16 +593,33 @@ Collection Resource::findEntitiesByTypeAndPropertyAs(const std::string& pname, c
   Collection collection;
   auto& uuidsToValues =
     this->properties().data().at<std::unordered_map<smtk::common::UUID, std::vector<Type>>>(pname);
-  for (auto it = uuidsToValues.begin(); it != uuidsToValues.end(); ++it)
-  {
-    if (it->second.size() == 1 && it->second.at(0) == pval)
+  auto visit = [&](const smtk::common::UUID& uid, const std::vector<Type>& value) {
+    if (value.size() == 1 && value.at(0) == pval)
     {
-      typename Collection::value_type entry(shared_from_this(), it->first);
+      typename Collection::value_type entry(shared_from_this(), uid);
       if (entry.isValid())
       {
         collection.insert(collection.end(), entry);
       }
     }
+  };
+  // Use a value index on the property if one has been declared.
+  std::unordered_set<smtk::common::UUID> candidates;
+  if (this->properties().findIds<std::vector<Type>>(pname, pval, candidates))
+  {
+    for (const auto& candidate : candidates)
+    {
+      auto it = uuidsToValues.find(candidate);
+      if (it != uuidsToValues.end())
+      {
+        visit(it->first, it->second);
+      }
+    }
+    return collection;
+  }
+  for (auto it = uuidsToValues.begin(); it != uuidsToValues.end(); ++it)
+  {
+    visit(it->first, it->second);
   }
   return collection;
 }
@@ -615,16 +632,36 @@ Collection Resource::findEntitiesByTypeAndPropertyAs(
   Collection collection;
   auto& uuidsToValues =
     this->properties().data().at<std::unordered_map<smtk::common::UUID, std::vector<Type>>>(pname);
-  for (auto it = uuidsToValues.begin(); it != uuidsToValues.end(); ++it)
-  {
-    if (it->second == pval)
+  auto visit = [&](const smtk::common::UUID& uid, const std::vector<Type>& value) {
+    if (value == pval)
     {
-      typename Collection::value_type entry(shared_from_this(), it->first);
+      typename Collection::value_type entry(shared_from_this(), uid);
       if (entry.isValid())
       {
         collection.insert(collection.end(), entry);
       }
     }
+  };
+  // Use a value index on the property if one has been declared; any entity
+  // whose value matches must contain the first value sought.
+  std::unordered_set<smtk::common::UUID> candidates;
+  if (
+    !pval.empty() &&
+    this->properties().findIds<std::vector<Type>>(pname, pval.front(), candidates))
+  {
+    for (const auto& candidate : candidates)
+    {
+      auto it = uuidsToValues.find(candidate);
+      if (it != uuidsToValues.end())
+      {
+        visit(it->first, it->second);
+      }
+    }
+    return collection;
+  }
+  for (auto it = uuidsToValues.begin(); it != uuidsToValues.end(); ++it)
+  {
+    visit(it->first, it->second);
   }
   return collection;
 }
@@ -0,0 +1,377 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/operation/AsyncObservers.h"
+
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/IntItem.h"
+#include "smtk/attribute/ReferenceItem.h"
+
+#include "smtk/resource/PersistentObject.h"
+
+#include "smtk/io/Logger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace smtk
+{
+namespace operation
+{
+namespace
+{
+void appendIds(
+  const Operation::Result& result,
+  const std::string& itemName,
+  std::vector<smtk::common::UUID>& ids)
+{
+  auto item = result->findReference(itemName);
+  if (!item)
+  {
+    return;
+  }
+  ids.reserve(item->numberOfValues());
+  for (std::size_t ii = 0; ii < item->numberOfValues(); ++ii)
+  {
+    if (item->isSet(ii))
+    {
+      if (auto object = item->value(ii))
+      {
+        ids.push_back(object->id());
+      }
+    }
+  }
+}
+} // anonymous namespace
+
+std::shared_ptr<const ResultDigest> ResultDigest::create(
+  const Operation& operation,
+  const Operation::Result& result)
+{
+  auto digest = std::make_shared<ResultDigest>();
+  digest->operationType = operation.typeToken();
+  digest->completed = std::chrono::steady_clock::now();
+  if (!result)
+  {
+    return digest;
+  }
+  digest->outcome = smtk::operation::outcome(result);
+  appendIds(result, "created", digest->created);
+  appendIds(result, "modified", digest->modified);
+  appendIds(result, "expunged", digest->expunged);
+  appendIds(result, "resourcesCreated", digest->resourcesCreated);
+  appendIds(result, "resourcesModified", digest->resourcesModified);
+  appendIds(result, "resourcesToExpunge", digest->resourcesExpunged);
+  return digest;
+}
+
+struct AsyncObservers::Internal
+{
+  struct Entry
+  {
+    Observer observer;
+    Statistics statistics;
+    bool erased{ false };
+  };
+
+  ~Internal() { this->stop(); }
+
+  void dispatch();
+  void deliver(const Batch& batch);
+  void erase(std::size_t id);
+  void stop();
+
+  bool onDispatchThread() const { return std::this_thread::get_id() == m_thread.get_id(); }
+
+  // Guards the queue of digests and the dispatch thread's state.
+  std::mutex m_queueMutex;
+  std::condition_variable m_queueCondition;
+  std::condition_variable m_deliveredCondition;
+  Batch m_queue;
+  std::size_t m_posted{ 0 };
+  std::size_t m_delivered{ 0 };
+  std::size_t m_flushRequests{ 0 };
+  std::chrono::milliseconds m_coalescingInterval;
+  bool m_stop{ false };
+  std::thread m_thread;
+
+  // Guards the registered observers and their statistics.
+  mutable std::mutex m_observersMutex;
+  std::map<std::size_t, std::shared_ptr<Entry>> m_observers;
+  std::size_t m_nextId{ 1 };
+  std::atomic<std::size_t> m_count{ 0 };
+
+  // Held while a batch is delivered so that observers are not removed while they run.
+  std::mutex m_deliveryMutex;
+};
+
+void AsyncObservers::Internal::dispatch()
+{
+  std::unique_lock<std::mutex> lock(m_queueMutex);
+  while (true)
+  {
+    m_queueCondition.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty())
+    {
+      break;
+    }
+    // Give the rest of a burst the chance to arrive so it is delivered as one batch.
+    if (m_coalescingInterval.count() > 0)
+    {
+      m_queueCondition.wait_for(
+        lock, m_coalescingInterval, [this]() { return m_stop || m_flushRequests > 0; });
+    }
+    Batch batch;
+    batch.swap(m_queue);
+    std::size_t posted = m_posted;
+    lock.unlock();
+    this->deliver(batch);
+    lock.lock();
+    m_delivered = posted;
+    m_deliveredCondition.notify_all();
+  }
+}
+
+void AsyncObservers::Internal::deliver(const Batch& batch)
+{
+  std::lock_guard<std::mutex> delivery(m_deliveryMutex);
+  std::vector<std::shared_ptr<Entry>> entries;
+  {
+    std::lock_guard<std::mutex> guard(m_observersMutex);
+    entries.reserve(m_observers.size());
+    for (const auto& entry : m_observers)
+    {
+      entries.push_back(entry.second);
+    }
+  }
+  for (const auto& entry : entries)
+  {
+    {
+      // An observer may have been removed by one called before it.
+      std::lock_guard<std::mutex> guard(m_observersMutex);
+      if (entry->erased)
+      {
+        continue;
+      }
+    }
+    auto start = std::chrono::steady_clock::now();
+    try
+    {
+      entry->observer(batch);
+    }
+    catch (std::exception& e)
+    {
+      smtkErrorMacro(
+        smtk::io::Logger::instance(),
+        "Caught exception \"" << e.what() << "\" in asynchronous operation observer \""
+                              << entry->statistics.description << "\".");
+    }
+    double elapsed =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::lock_guard<std::mutex> guard(m_observersMutex);
+    ++entry->statistics.batches;
+    entry->statistics.digests += batch.size();
+    entry->statistics.totalTime += elapsed;
+    entry->statistics.maxTime = std::max(entry->statistics.maxTime, elapsed);
+  }
+}
+
+void AsyncObservers::Internal::erase(std::size_t id)
+{
+  // Unless an observer is removing itself (or another observer), wait for
+  // any batch being delivered so the observer is not running once we return.
+  std::unique_lock<std::mutex> delivery(m_deliveryMutex, std::defer_lock);
+  if (!this->onDispatchThread())
+  {
+    delivery.lock();
+  }
+  std::lock_guard<std::mutex> guard(m_observersMutex);
+  auto it = m_observers.find(id);
+  if (it != m_observers.end())
+  {
+    it->second->erased = true;
+    m_observers.erase(it);
+    --m_count;
+  }
+}
+
+void AsyncObservers::Internal::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_stop = true;
+  }
+  m_queueCondition.notify_all();
+  if (m_thread.joinable())
+  {
+    if (this->onDispatchThread())
+    {
+      // An observer destroyed the AsyncObservers instance; we cannot join
+      // ourselves, but the thread holds a reference that keeps us alive.
+      m_thread.detach();
+    }
+    else
+    {
+      m_thread.join();
+    }
+  }
+}
+
+AsyncObservers::Key::Key(const std::shared_ptr<Internal>& internal, std::size_t id)
+  : m_internal(internal)
+  , m_id(id)
+{
+}
+
+AsyncObservers::Key::Key(Key&& other) noexcept
+  : m_internal(std::move(other.m_internal))
+  , m_id(other.m_id)
+{
+  other.m_id = 0;
+}
+
+AsyncObservers::Key& AsyncObservers::Key::operator=(Key&& other) noexcept
+{
+  if (this != &other)
+  {
+    this->reset();
+    m_internal = std::move(other.m_internal);
+    m_id = other.m_id;
+    other.m_id = 0;
+  }
+  return *this;
+}
+
+AsyncObservers::Key::~Key()
+{
+  this->reset();
+}
+
+void AsyncObservers::Key::reset()
+{
+  if (auto internal = m_internal.lock())
+  {
+    internal->erase(m_id);
+  }
+  this->release();
+}
+
+void AsyncObservers::Key::release()
+{
+  m_internal.reset();
+  m_id = 0;
+}
+
+AsyncObservers::AsyncObservers(std::chrono::milliseconds coalescingInterval)
+  : m_internal(std::make_shared<Internal>())
+{
+  m_internal->m_coalescingInterval = coalescingInterval;
+}
+
+AsyncObservers::~AsyncObservers()
+{
+  m_internal->stop();
+}
+
+AsyncObservers::Key AsyncObservers::insert(Observer observer, const std::string& description)
+{
+  if (!observer)
+  {
+    return Key();
+  }
+  {
+    // Start the dispatch thread the first time an observer is inserted.
+    std::lock_guard<std::mutex> lock(m_internal->m_queueMutex);
+    if (!m_internal->m_thread.joinable() && !m_internal->m_stop)
+    {
+      // The thread shares ownership so that it may safely outlive us
+      // if an observer destroys this object.
+      auto internal = m_internal;
+      m_internal->m_thread = std::thread([internal]() { internal->dispatch(); });
+    }
+  }
+  auto entry = std::make_shared<Internal::Entry>();
+  entry->observer = std::move(observer);
+  entry->statistics.description = description;
+  std::lock_guard<std::mutex> guard(m_internal->m_observersMutex);
+  std::size_t id = m_internal->m_nextId++;
+  m_internal->m_observers[id] = entry;
+  ++m_internal->m_count;
+  return Key(m_internal, id);
+}
+
+bool AsyncObservers::empty() const
+{
+  return m_internal->m_count == 0;
+}
+
+void AsyncObservers::post(const std::shared_ptr<const ResultDigest>& digest)
+{
+  if (!digest)
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_internal->m_queueMutex);
+    if (!m_internal->m_thread.joinable())
+    {
+      // No observer has ever been inserted.
+      return;
+    }
+    m_internal->m_queue.push_back(digest);
+    ++m_internal->m_posted;
+  }
+  m_internal->m_queueCondition.notify_all();
+}
+
+void AsyncObservers::flush()
+{
+  if (m_internal->onDispatchThread())
+  {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(m_internal->m_queueMutex);
+  std::size_t target = m_internal->m_posted;
+  ++m_internal->m_flushRequests;
+  m_internal->m_queueCondition.notify_all();
+  m_internal->m_deliveredCondition.wait(
+    lock, [this, target]() { return m_internal->m_delivered >= target; });
+  --m_internal->m_flushRequests;
+}
+
+void AsyncObservers::setCoalescingInterval(std::chrono::milliseconds interval)
+{
+  std::lock_guard<std::mutex> lock(m_internal->m_queueMutex);
+  m_internal->m_coalescingInterval = interval;
+}
+
+std::chrono::milliseconds AsyncObservers::coalescingInterval() const
+{
+  std::lock_guard<std::mutex> lock(m_internal->m_queueMutex);
+  return m_internal->m_coalescingInterval;
+}
+
+std::vector<AsyncObservers::Statistics> AsyncObservers::statistics() const
+{
+  std::vector<Statistics> result;
+  std::lock_guard<std::mutex> guard(m_internal->m_observersMutex);
+  result.reserve(m_internal->m_observers.size());
+  for (const auto& entry : m_internal->m_observers)
+  {
+    result.push_back(entry.second->statistics);
+  }
+  return result;
+}
+
+} // namespace operation
+} // namespace smtk
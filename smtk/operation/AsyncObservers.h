@@ -0,0 +1,172 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_operation_AsyncObservers_h
+#define smtk_operation_AsyncObservers_h
+
+#include "smtk/CoreExports.h"
+#include "smtk/common/UUID.h"
+#include "smtk/operation/Operation.h"
+#include "smtk/string/Token.h"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace smtk
+{
+namespace operation
+{
+
+/**\brief An immutable summary of an operation's result.
+  *
+  * Digests hold only the identifiers of the objects an operation reported as
+  * created, modified, or expunged, so they may be inspected from any thread
+  * without holding resource locks.
+  */
+struct SMTKCORE_EXPORT ResultDigest
+{
+  /// Summarize \a result, which was produced by \a operation.
+  static std::shared_ptr<const ResultDigest> create(
+    const Operation& operation,
+    const Operation::Result& result);
+
+  smtk::string::Token operationType;
+  Operation::Outcome outcome{ Operation::Outcome::UNKNOWN };
+
+  ///@name Components named in the result
+  ///@{
+  std::vector<smtk::common::UUID> created;
+  std::vector<smtk::common::UUID> modified;
+  std::vector<smtk::common::UUID> expunged;
+  ///@}
+
+  ///@name Resources named in the result
+  ///@{
+  std::vector<smtk::common::UUID> resourcesCreated;
+  std::vector<smtk::common::UUID> resourcesModified;
+  std::vector<smtk::common::UUID> resourcesExpunged;
+  ///@}
+
+  /// When the operation completed.
+  std::chrono::steady_clock::time_point completed;
+};
+
+/**\brief Observers notified of completed operations on a dedicated thread.
+  *
+  * Unlike Observers, which an operation invokes synchronously while it still
+  * holds its resource locks, asynchronous observers are handed a ResultDigest
+  * after the operation has released its locks. Slow observers therefore do
+  * not extend the time resources spend locked.
+  *
+  * Digests are delivered in the order operations completed, on a thread owned
+  * by this object (started when the first observer is inserted). Digests that
+  * arrive within the coalescing interval of one another are delivered
+  * together, so a burst of operations results in a single call to each
+  * observer. The time each observer spends handling batches is recorded and
+  * reported by statistics().
+  *
+  * Only operations that invoke observers (i.e., those not run as nested
+  * operations with ObserverOption::SkipObservers) are reported.
+  */
+class SMTKCORE_EXPORT AsyncObservers
+{
+public:
+  /// A batch of digests, in the order their operations completed.
+  using Batch = std::vector<std::shared_ptr<const ResultDigest>>;
+  /// Signature for asynchronous observers.
+  using Observer = std::function<void(const Batch&)>;
+
+  /// The activity of one observer since it was inserted.
+  struct Statistics
+  {
+    std::string description;  //!< The description provided at insertion.
+    std::size_t batches{ 0 }; //!< Batches the observer has handled.
+    std::size_t digests{ 0 }; //!< Digests in all of those batches.
+    double totalTime{ 0. };   //!< Total time (ms) spent in the observer.
+    double maxTime{ 0. };     //!< Longest time (ms) spent handling one batch.
+  };
+
+  struct Internal;
+
+  /**\brief A handle that removes its observer when destroyed.
+    *
+    * Removing an observer from any thread but the dispatch thread waits for
+    * a batch being delivered to finish, so once the key is reset the
+    * observer is guaranteed not to be running.
+    */
+  class SMTKCORE_EXPORT Key
+  {
+  public:
+    Key() = default;
+    Key(const Key&) = delete;
+    Key& operator=(const Key&) = delete;
+    Key(Key&& other) noexcept;
+    Key& operator=(Key&& other) noexcept;
+    ~Key();
+
+    /// Return true if this key refers to an observer.
+    bool assigned() const { return m_id != 0; }
+
+    /// Remove the observer now.
+    void reset();
+
+    /// Keep the observer after this key is destroyed.
+    void release();
+
+  private:
+    friend class AsyncObservers;
+    Key(const std::shared_ptr<Internal>& internal, std::size_t id);
+
+    std::weak_ptr<Internal> m_internal;
+    std::size_t m_id{ 0 };
+  };
+
+  AsyncObservers(std::chrono::milliseconds coalescingInterval = std::chrono::milliseconds(10));
+  AsyncObservers(const AsyncObservers&) = delete;
+  AsyncObservers& operator=(const AsyncObservers&) = delete;
+  /// Deliver any pending digests, then stop the dispatch thread.
+  ~AsyncObservers();
+
+  /// Insert an \a observer. The returned key removes it when destroyed.
+  Key insert(Observer observer, const std::string& description = std::string());
+
+  /// Return true if no observers are registered. This does not block.
+  bool empty() const;
+
+  /// Queue a \a digest for delivery to every observer. This does not block.
+  void post(const std::shared_ptr<const ResultDigest>& digest);
+
+  /// Block until every digest posted before this call has been delivered.
+  ///
+  /// Calling this from an observer (on the dispatch thread) returns immediately.
+  void flush();
+
+  ///@name Coalescing
+  ///@{
+  /// After the first digest of a batch arrives, the dispatch thread waits
+  /// this long for more digests before delivering the batch.
+  void setCoalescingInterval(std::chrono::milliseconds interval);
+  std::chrono::milliseconds coalescingInterval() const;
+  ///@}
+
+  /// Return the activity of each registered observer.
+  std::vector<Statistics> statistics() const;
+
+private:
+  std::shared_ptr<Internal> m_internal;
+};
+
+} // namespace operation
+} // namespace smtk
+
+#endif // smtk_operation_AsyncObservers_h
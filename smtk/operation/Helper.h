@@ -61,9 +61,25 @@ public:
   /// Return the key currently being used.
   const Operation::BaseKey* key() const { return m_key; }
 
+  /// Set/get the number of independent child operations (such as reads of
+  /// a project's member resources) that deserializers may run concurrently
+  /// on the shared smtk::common::Executor.
+  ///
+  /// The default (1) runs child operations one at a time on the calling
+  /// thread. A value of 0 allows one per executor worker.
+  void setNumberOfThreads(unsigned int numberOfThreads) { m_numberOfThreads = numberOfThreads; }
+  unsigned int numberOfThreads() const { return m_numberOfThreads; }
+
+  /// Deserializers add the results of the child operations they run here so
+  /// that the operation which pushed this helper can merge them into its own
+  /// result (see smtk::operation::mergeResult()).
+  std::vector<Operation::Result>& childResults() { return m_childResults; }
+
 protected:
   Helper();
   Operation::BaseKey* m_key{ nullptr };
+  unsigned int m_numberOfThreads{ 1 };
+  std::vector<Operation::Result> m_childResults;
 
   /// m_topLevel indicates whether pushInstance() (false) or instance() (true)
   /// was used to create this helper.
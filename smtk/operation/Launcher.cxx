@@ -9,7 +9,7 @@
 //=========================================================================
 #include "smtk/operation/Launcher.h"
 
-#include "smtk/common/ThreadPool.h"
+#include "smtk/common/Executor.h"
 
 #include "smtk/io/Logger.h"
 
@@ -21,41 +21,17 @@ namespace
 // Key corresponding to the default operation launch method
 smtk::operation::Launchers::LauncherMap::key_type default_key = "default";
 
-// The default launcher uses a thread pool and is copy-constructible (so it can
-// be placed in a map).
+// The default launcher runs operations on the executor shared with SMTK's
+// background I/O, so that I/O yields to operations.
 class DefaultLauncher
 {
 public:
-  DefaultLauncher()
-    : m_pool(new smtk::common::ThreadPool<smtk::operation::Operation::Result>)
-  {
-  }
-
-  DefaultLauncher(const DefaultLauncher& /*unused*/)
-    : m_pool(new smtk::common::ThreadPool<smtk::operation::Operation::Result>)
-  {
-  }
-
-  DefaultLauncher(DefaultLauncher&& other) noexcept { m_pool.swap(other.m_pool); }
-
-  DefaultLauncher& operator=(DefaultLauncher&& other) noexcept
-  {
-    if (&other != this)
-    {
-      m_pool.swap(other.m_pool);
-    }
-    return *this;
-  }
-
   std::shared_future<smtk::operation::Operation::Result> operator()(
     const smtk::operation::Operation::Ptr& operation)
   {
-    return m_pool->operator()(
+    return smtk::common::Executor::instance()(
       [](const smtk::operation::Operation::Ptr& op) { return op->operate(); }, operation);
   }
-
-private:
-  std::unique_ptr<smtk::common::ThreadPool<smtk::operation::Operation::Result>> m_pool;
 };
 } // namespace
 
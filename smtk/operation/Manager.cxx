@@ -35,6 +35,21 @@ Manager::Manager()
     }
   })
 {
+  // Time each observer, but only while tracing is enabled; otherwise,
+  // observers are called directly.
+  m_tracer.setEnabledCallback([this](bool enabled) {
+    if (enabled)
+    {
+      m_observers.setMonitor(
+        [this](const std::string& description, const std::function<void()>& invoke) {
+          m_tracer.traceObserver(description, invoke);
+        });
+    }
+    else
+    {
+      m_observers.setMonitor(nullptr);
+    }
+  });
 }
 
 Manager::~Manager() = default;
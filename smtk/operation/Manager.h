@@ -18,14 +18,17 @@
 #include "smtk/common/Managers.h"
 #include "smtk/common/TypeName.h"
 
+#include "smtk/operation/AsyncObservers.h"
 #include "smtk/operation/Group.h"
 #include "smtk/operation/Launcher.h"
 #include "smtk/operation/Metadata.h"
 #include "smtk/operation/MetadataContainer.h"
 #include "smtk/operation/Observer.h"
 #include "smtk/operation/Operation.h"
+#include "smtk/operation/Tracer.h"
 
 #include <array>
+#include <atomic>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -105,6 +108,15 @@ public:
   template<typename OperationType>
   smtk::shared_ptr<OperationType> create();
 
+  /// Set/get whether operations created by this manager start from a copy of
+  /// the specification held by their Metadata (the default).
+  ///
+  /// When disabled, each operation constructs (and, for XML operations,
+  /// parses) its own specification. Operations whose
+  /// Operation::cacheableSpecification() returns false always do.
+  void setSpecificationCacheEnabled(bool enabled) { m_specificationCacheEnabled = enabled; }
+  bool specificationCacheEnabled() const { return m_specificationCacheEnabled; }
+
   /// Return an operation's type index given its type name.
   ///
   /// If the \a typeName is not registered, this will return 0.
@@ -124,6 +136,16 @@ public:
   Observers& observers() { return m_observers; }
   const Observers& observers() const { return m_observers; }
 
+  /// Return the observers this manager notifies asynchronously, after an
+  /// operation has released its resource locks.
+  AsyncObservers& asyncObservers() { return m_asyncObservers; }
+  const AsyncObservers& asyncObservers() const { return m_asyncObservers; }
+
+  /// Return the tracer that records the time spent in each phase of this
+  /// manager's operations (and those of their nested operations).
+  Tracer& tracer() { return m_tracer; }
+  const Tracer& tracer() const { return m_tracer; }
+
   /// Return the group observers associated with this manager.
   Group::Observers& groupObservers() { return m_groupObservers; }
   const Group::Observers& groupObservers() const { return m_groupObservers; }
@@ -205,6 +227,12 @@ private:
   /// A container for all operation observers.
   Observers m_observers;
 
+  /// A container for all asynchronous operation observers.
+  AsyncObservers m_asyncObservers;
+
+  /// Records spans for operations when tracing is enabled.
+  Tracer m_tracer;
+
   /// A container for all operation group observers.
   Group::Observers m_groupObservers;
 
@@ -217,6 +245,9 @@ private:
   /// A container for all registered operation metadata.
   MetadataContainer m_metadata;
 
+  /// Whether created operations copy their Metadata's specification.
+  std::atomic<bool> m_specificationCacheEnabled{ true };
+
   /// A weak pointer to the managers instance that contains this manager, if it
   /// exists.
   std::weak_ptr<smtk::common::Managers> m_managers;
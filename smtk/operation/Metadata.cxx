@@ -12,9 +12,12 @@
 #include "smtk/operation/SpecificationOps.h"
 
 #include "smtk/resource/Component.h"
+#include "smtk/resource/CopyOptions.h"
+#include "smtk/resource/Lock.h"
 
 #include "smtk/attribute/Attribute.h"
 #include "smtk/attribute/Definition.h"
+#include "smtk/attribute/Resource.h"
 
 #include <algorithm>
 
@@ -57,6 +60,25 @@ Metadata::Metadata(
   }
 }
 
+Operation::Specification Metadata::copySpecification() const
+{
+  if (!m_specification)
+  {
+    return nullptr;
+  }
+  smtk::resource::ScopedLockGuard guard(
+    m_specification->lock({}), smtk::resource::LockType::Read);
+  smtk::resource::CopyOptions options;
+  options.setCopyComponents(false);
+  auto specification =
+    std::static_pointer_cast<smtk::attribute::Resource>(m_specification->clone(options));
+  if (specification)
+  {
+    specification->copyViews(m_specification, options);
+  }
+  return specification;
+}
+
 std::string Metadata::label() const
 {
   std::string label = this->typeName();
@@ -48,6 +48,13 @@ public:
   const std::string& typeName() const { return m_typeName; }
   const Operation::Index& index() const { return m_index; }
   Operation::Specification specification() const { return m_specification; }
+  /// Return a new specification holding copies of the definitions (and views)
+  /// of specification().
+  ///
+  /// Operations created by a manager start from such a copy, which is much
+  /// cheaper than parsing the operation's XML again. The template is
+  /// discarded along with this metadata when the operation is unregistered.
+  Operation::Specification copySpecification() const;
   bool acceptsComponent(const smtk::resource::ComponentPtr& c) const
   {
     return m_acceptsComponent(c);
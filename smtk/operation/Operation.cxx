@@ -11,11 +11,14 @@
 #include "smtk/operation/Manager.h"
 #include "smtk/operation/Observer.h"
 #include "smtk/operation/SpecificationOps.h"
+#include "smtk/operation/Tracer.h"
 
 #include "smtk/operation/queries/SynchronizedCache.h"
 
 #include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/ComponentItem.h"
 #include "smtk/attribute/Definition.h"
+#include "smtk/attribute/DoubleItem.h"
 #include "smtk/attribute/IntItem.h"
 #include "smtk/attribute/Resource.h"
 #include "smtk/attribute/ResourceItem.h"
@@ -31,11 +34,15 @@
 
 #include "nlohmann/json.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <sstream>
-#include <thread>
+#include <unordered_set>
+#include <vector>
 
 namespace
 {
@@ -44,6 +51,21 @@ namespace
 // used to create that name. Its value is irrelevant so we don't need to reset
 // it; its uniqueness is what we are after.
 std::atomic<std::size_t> g_uniqueCounter{ 0 };
+
+// Record the time (in milliseconds) an operation spent waiting on resource
+// locks. Operations whose specifications do not derive their result from
+// the base result definition may not have this item, so it is optional.
+void setLockWaitTime(const smtk::operation::Operation::Result& result, double milliseconds)
+{
+  if (!result)
+  {
+    return;
+  }
+  if (auto item = result->findDouble("lockWaitTime"))
+  {
+    item->setValue(milliseconds);
+  }
+}
 } // namespace
 
 namespace smtk
@@ -93,7 +115,8 @@ Operation::Specification Operation::specification()
   // Lazily create the specification.
   if (m_specification == nullptr)
   {
-    if (auto manager = m_manager.lock())
+    auto manager = m_manager.lock();
+    if (manager && manager->specificationCacheEnabled() && this->cacheableSpecification())
     {
       auto metadata = manager->metadata().get<IndexTag>().find(this->index());
 
@@ -102,9 +125,11 @@ Operation::Specification Operation::specification()
       // has a metadata instance for its type. Let's check anyway.
       assert(metadata != manager->metadata().get<IndexTag>().end());
 
-      m_specification = metadata->specification();
+      // Copy the definitions parsed when the operation was registered rather
+      // than parsing them again.
+      m_specification = metadata->copySpecification();
     }
-    else
+    if (m_specification == nullptr)
     {
       m_specification = createSpecification();
     }
@@ -139,6 +164,32 @@ Operation::Result Operation::operate()
 
 Operation::Result Operation::operate(const BaseKey& key)
 {
+  // If tracing is enabled for our manager (or for the operation that launched
+  // us), record a span for the operation as a whole and for each of its phases.
+  auto manager = m_manager.lock();
+  m_tracer = nullptr;
+  m_traceId = 0;
+  std::uint64_t parentTraceId = 0;
+  if (manager && manager->tracer().enabled())
+  {
+    m_tracer = &manager->tracer();
+  }
+  else if (key.m_parent && key.m_parent->m_tracer)
+  {
+    m_tracer = key.m_parent->m_tracer;
+  }
+  if (m_tracer)
+  {
+    m_traceId = m_tracer->nextOperationId();
+    parentTraceId = key.m_parent ? key.m_parent->m_traceId : Tracer::currentOperation();
+  }
+  const smtk::string::Token operationType = m_tracer ? this->typeToken() : smtk::string::Token();
+  Tracer::Span operateSpan(
+    m_tracer, Tracer::Phase::Operate, operationType, m_traceId, parentTraceId);
+  auto trace = [this, &operationType](Tracer::Phase phase) {
+    return Tracer::Span(m_tracer, phase, operationType, m_traceId);
+  };
+
   std::multimap<Priority, Handler> instanceHandlers;
   {
     std::lock_guard<std::mutex> guard(m_handlerLock);
@@ -149,144 +200,158 @@ Operation::Result Operation::operate(const BaseKey& key)
   // Gather all requested resources and their lock types.
   const auto resourcesAndLockTypes = this->identifyLocksRequired();
 
-  // Mutex to prevent multiple Operations from locking resources at the same
-  // time (which could result in deadlock).
-  static std::mutex mutex;
-
   // Track resources that were actually locked by this operation instance.
   ResourceAccessMap lockedByThis;
 
-  size_t numRetries = 0;
+  // Time spent waiting on resource locks (in milliseconds).
+  double lockWaitTime = 0.;
 
   if (key.m_lockOption != LockOption::SkipLocks)
   {
-    // Lock the resources.
-    while (true)
+    auto lockSpan = trace(Tracer::Phase::Lock);
+    if (key.m_parent)
     {
-      // TODO: A maximum retry limit may be a good thing add here to prevent some operation from
-      // occupying a thread in the operation thread pool indefinitely in the event that it cannot
-      // acquire all of its resources' locks within a reasonable amount of time.
-      if (numRetries++ > 0)
-      {
-        // Allow other threads to have CPU time.
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-      }
-
-      // Only allow one operation at a time to attempt to acquire all necessary resource locks.
-      std::lock_guard<std::mutex> guard(mutex);
+      // Inherit resource locks from the parent operation.
+      this->m_lockedResources = key.m_parent->lockedResources();
+    }
 
-      if (key.m_parent)
+    // Lock the resources in a canonical order (by UUID). Because every
+    // operation acquires its locks in the same order, blocking on each lock
+    // in turn cannot deadlock and no global mutex or retry loop is required.
+    // Fairness among waiting operations is provided by the locks themselves.
+    std::vector<std::pair<smtk::resource::ResourcePtr, smtk::resource::LockType>> pending;
+    pending.reserve(resourcesAndLockTypes.size());
+    for (const auto& resourceAndLockType : resourcesAndLockTypes)
+    {
+      if (auto resource = resourceAndLockType.first.lock())
       {
-        // Inherit resource locks from the parent operation.
-        this->m_lockedResources = key.m_parent->lockedResources();
+        pending.emplace_back(resource, resourceAndLockType.second);
       }
+    }
+    std::sort(pending.begin(), pending.end(), [](const auto& aa, const auto& bb) {
+      return aa.first->id() < bb.first->id() ||
+        (aa.first->id() == bb.first->id() && aa.first.get() < bb.first.get());
+    });
 
-      // Populate queue for pending resource locks.
-      std::queue<ResourceAccessMap::value_type> pending;
-      for (const auto& resourceAndLockType : resourcesAndLockTypes)
-      {
-        pending.push(resourceAndLockType);
-      }
+    const bool waitIndefinitely = m_lockTimeout == std::chrono::milliseconds::max();
+    const auto lockStart = std::chrono::steady_clock::now();
+    const auto deadline = waitIndefinitely ? lockStart : lockStart + m_lockTimeout;
 
-      while (!pending.empty())
+    for (const auto& resourceAndLockType : pending)
+    {
+      const auto& resource = resourceAndLockType.first;
+      const auto& lockType = resourceAndLockType.second;
+
+      // Snapshot access never acquires the resource's lock. However, when a
+      // parent operation holds the lock, the snapshot must be taken directly
+      // so it includes the parent's modifications (and does not wait on the
+      // parent's own write lock).
+      if (lockType == smtk::resource::LockType::Snapshot)
       {
-        const auto resourceAndLockType = pending.front();
-        auto resource = resourceAndLockType.first.lock();
-        const auto& lockType = resourceAndLockType.second;
+        const auto it = this->m_lockedResources.find(resource);
+        m_snapshots[resource->id()] = it != this->m_lockedResources.end()
+          ? smtk::resource::Snapshot::create(*resource)
+          : resource->snapshot();
+        continue;
+      }
 
-        // Leave this for debugging, but do not include it in every debug build
-        // as it can be quite noisy.
+      // Leave this for debugging, but do not include it in every debug build
+      // as it can be quite noisy.
 #if 0
-    // Given the puzzling result of deadlock that can arise if one Operation
-    // calls another Operation using its public API and passes it a Resource
-    // with a Write LockType, we print to the terminal which resources we are
-    // locking. If you are working on an Operation and are trying to debug a
-    // deadlock, consider calling operations using the following syntax:
-    // $
-    // $ op->operate(Key());
-    // $
-    // This will avoid the inner Operation's resource locking and execute it
-    // directly. Be sure to verify the operation's validity prior to execution
-    // (via the ableToOperate() method).
-        std::cout << "Operation \"" << this->typeName() << "\" is locking resource " << resource->name()
-          << " (" << resource->typeName() << ") with lock type \""
-          << (lockType == smtk::resource::LockType::Read
-            ? "Read"
-            : (lockType == smtk::resource::LockType::Write ? "Write" : "DoNotLock"))
-          << "\"\n";
+      // Given the puzzling result of deadlock that can arise if one Operation
+      // calls another Operation using its public API and passes it a Resource
+      // with a Write LockType, we print to the terminal which resources we are
+      // locking. If you are working on an Operation and are trying to debug a
+      // deadlock, consider calling operations using the following syntax:
+      // $
+      // $ op->operate(Key());
+      // $
+      // This will avoid the inner Operation's resource locking and execute it
+      // directly. Be sure to verify the operation's validity prior to execution
+      // (via the ableToOperate() method).
+      std::cout << "Operation \"" << this->typeName() << "\" is locking resource "
+        << resource->name() << " (" << resource->typeName() << ") with lock type \""
+        << (lockType == smtk::resource::LockType::Read
+          ? "Read"
+          : (lockType == smtk::resource::LockType::Write ? "Write" : "DoNotLock"))
+        << "\"\n";
 #endif
 
-        // Is this resource already locked (by a parent perhaps).
-        const auto it = this->m_lockedResources.find(resource);
-        if (it != this->m_lockedResources.end())
-        {
-          // Verify that no writer is allowed while the (parent) operation
-          // already has a read lock on the resource.
-          if (it->second == resource::LockType::Read && lockType == resource::LockType::Write)
-          {
-            // This operation should not be able to operate. Undo the current
-            // resource locking and fail early.
-            this->unlockResources(lockedByThis);
-            smtkErrorMacro(
-              this->log(),
-              "Attempted to acquire a write lock on a resource that a parent operation currently "
-              "holds a read lock on.");
-            return this->createResult(Outcome::UNABLE_TO_OPERATE);
-          }
-          else
-          {
-            // This lock is already acquired by the parent, so pop this
-            // resource from the queue and continue at the next
-            // resource.
-            pending.pop();
-            continue;
-          }
-        }
-        else if (key.m_lockOption == LockOption::ParentLocksOnly)
-        {
-          // The parent does not already hold the lock for this resource, so
-          // fail early.
-          return this->createResult(Outcome::UNABLE_TO_OPERATE);
-        }
-
-        // Attempt to acquire this resource's lock.
-        if (
-          lockType != smtk::resource::LockType::DoNotLock && !resource->lock({}).tryLock(lockType))
+      // Is this resource already locked (by a parent perhaps).
+      const auto it = this->m_lockedResources.find(resource);
+      if (it != this->m_lockedResources.end())
+      {
+        // Verify that no writer is allowed while the (parent) operation
+        // already has a read lock on the resource.
+        if (it->second == resource::LockType::Read && lockType == resource::LockType::Write)
         {
-          // This resource's lock could not be acquired. Release the locks on any
-          // resource whose lock was successfully acquired so that other threads
-          // have a chance to attempt the locks if they are waiting.
+          // This operation should not be able to operate. Undo the current
+          // resource locking and fail early.
           this->unlockResources(lockedByThis);
-          lockedByThis.clear();
           this->m_lockedResources.clear();
-
-          // Stop processing the queue. The locks will be attempted again later.
-          break;
+          m_snapshots.clear();
+          smtkErrorMacro(
+            this->log(),
+            "Attempted to acquire a write lock on a resource that a parent operation currently "
+            "holds a read lock on.");
+          return this->createResult(Outcome::UNABLE_TO_OPERATE);
         }
+        // Otherwise, this lock is already acquired by the parent.
+        continue;
+      }
+      else if (key.m_lockOption == LockOption::ParentLocksOnly)
+      {
+        // The parent does not already hold the lock for this resource, so
+        // fail early.
+        this->unlockResources(lockedByThis);
+        this->m_lockedResources.clear();
+        m_snapshots.clear();
+        return this->createResult(Outcome::UNABLE_TO_OPERATE);
+      }
 
-        this->m_lockedResources.insert(resourceAndLockType);
-        lockedByThis.insert(resourceAndLockType);
-
-        // Pop this resource from the queue.
-        pending.pop();
-      } // while (!pending.empty())
-
-      if (pending.empty())
+      // Wait for this resource's lock.
+      bool acquired = true;
+      if (lockType != smtk::resource::LockType::DoNotLock)
       {
-        // All of the locks were acquired successfully. Continue with the
-        // operation logic.
-        break;
+        if (waitIndefinitely)
+        {
+          resource->lock({}).lock(lockType);
+        }
+        else
+        {
+          auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+          acquired = resource->lock({}).tryLockFor(
+            lockType, std::max(remaining, std::chrono::milliseconds::zero()));
+        }
       }
-      else
+
+      if (!acquired)
       {
-        // All of the resource locks could not be acquired. Release the locks on any
-        // resource whose lock was successfully acquired so that other threads
-        // have a chance to attempt the locks if they are waiting.
+        // Release the locks on any resource whose lock was successfully
+        // acquired so that other operations may proceed.
         this->unlockResources(lockedByThis);
-        lockedByThis.clear();
         this->m_lockedResources.clear();
+        m_snapshots.clear();
+        smtkErrorMacro(
+          this->log(),
+          "Timed out after " << m_lockTimeout.count() << " ms waiting to lock resource \""
+                             << resource->name() << "\".");
+        auto result = this->createResult(Outcome::UNABLE_TO_OPERATE);
+        setLockWaitTime(
+          result,
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lockStart)
+            .count());
+        return result;
       }
-    } // while (true)
+
+      this->m_lockedResources.insert(resourceAndLockType);
+      lockedByThis.insert(resourceAndLockType);
+    }
+
+    lockWaitTime =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lockStart)
+        .count();
   }
 
   // Remember where the log was so we only serialize messages for this
@@ -300,12 +365,17 @@ Operation::Result Operation::operate(const BaseKey& key)
   // one requests the operation be canceled. This is useful since all
   // DID_OPERATE observers are called whether the operation was canceled or not
   // -- and observers of both will expect them to be called in pairs.
-  auto manager = m_manager.lock();
   bool observePostOperation = manager != nullptr;
   Outcome outcome = Outcome::UNKNOWN;
 
   // First, we check that the operation is able to operate.
-  if (key.m_paramsOption == ParametersOption::Validate && !this->ableToOperate())
+  bool ableToOperate = true;
+  if (key.m_paramsOption == ParametersOption::Validate)
+  {
+    auto span = trace(Tracer::Phase::AbleToOperate);
+    ableToOperate = this->ableToOperate();
+  }
+  if (!ableToOperate)
   {
     outcome = Outcome::UNABLE_TO_OPERATE;
     result = this->createResult(outcome);
@@ -315,11 +385,16 @@ Operation::Result Operation::operate(const BaseKey& key)
   // Then, we check if any observers wish to cancel this operation.
   else
   {
-    if (
-      key.m_observerOption == ObserverOption::InvokeObservers && manager &&
-      manager->observers()(*this, EventType::WILL_OPERATE, nullptr))
+    if (key.m_observerOption == ObserverOption::InvokeObservers && manager)
+    {
+      auto span = trace(Tracer::Phase::WillOperateObservers);
+      if (manager->observers()(*this, EventType::WILL_OPERATE, nullptr))
+      {
+        outcome = Outcome::CANCELED;
+      }
+    }
+    if (outcome == Outcome::CANCELED)
     {
-      outcome = Outcome::CANCELED;
       result = this->createResult(outcome);
     }
 
@@ -338,6 +413,7 @@ Operation::Result Operation::operate(const BaseKey& key)
       try
       {
         // Perform the derived operation.
+        auto span = trace(Tracer::Phase::OperateInternal);
         result = this->operateInternal();
       }
       catch (const std::exception& e)
@@ -356,6 +432,7 @@ Operation::Result Operation::operate(const BaseKey& key)
       outcome = static_cast<Outcome>(result->findInt("outcome")->value());
       if (outcome == Outcome::SUCCEEDED)
       {
+        auto span = trace(Tracer::Phase::PostProcessResult);
         this->postProcessResult(result);
       }
 
@@ -364,16 +441,24 @@ Operation::Result Operation::operate(const BaseKey& key)
       // the result.
       if (outcome == Outcome::SUCCEEDED || outcome == Outcome::FAILED)
       {
+        auto span = trace(Tracer::Phase::MarkModifiedResources);
         this->markModifiedResources(result);
       }
     }
   }
 
+  // Report how long the operation waited for its resource locks.
+  setLockWaitTime(result, lockWaitTime);
+
   // Add a summary of the operation to the result.
-  this->generateSummary(result);
+  {
+    auto span = trace(Tracer::Phase::GenerateSummary);
+    this->generateSummary(result);
+  }
 
   // Now grab all log messages and serialize them into the result attribute.
   {
+    auto span = trace(Tracer::Phase::SerializeLog);
     std::size_t logEnd = this->log().numberOfRecords();
     if (logEnd > logStart)
     {
@@ -392,13 +477,18 @@ Operation::Result Operation::operate(const BaseKey& key)
     // Always call handlers, but based on the \a key, observers may be skipped.
     // Handlers will always be invoked before other observers, but in priority order.
     // In the future, we may attempt to interleave the handler and observer calls.
-    for (const auto& entry : instanceHandlers)
+    if (!instanceHandlers.empty())
     {
-      entry.second(*this, result);
+      auto span = trace(Tracer::Phase::Handlers);
+      for (const auto& entry : instanceHandlers)
+      {
+        entry.second(*this, result);
+      }
+      instanceHandlers.clear();
     }
-    instanceHandlers.clear();
     if (key.m_observerOption == ObserverOption::InvokeObservers && observePostOperation && manager)
     {
+      auto span = trace(Tracer::Phase::DidOperateObservers);
       manager->observers()(*this, EventType::DID_OPERATE, result);
     }
   }
@@ -410,7 +500,11 @@ Operation::Result Operation::operate(const BaseKey& key)
   }
 
   // Un-manage any resources marked for removal before releasing locks.
-  bool removed = this->unmanageResources(result);
+  bool removed;
+  {
+    auto span = trace(Tracer::Phase::UnmanageResources);
+    removed = this->unmanageResources(result);
+  }
   if (!removed)
   {
     smtkErrorMacro(this->log(), "Failed to remove resources marked for removal.");
@@ -418,19 +512,46 @@ Operation::Result Operation::operate(const BaseKey& key)
       static_cast<int>(smtk::operation::Operation::Outcome::FAILED));
   }
 
+  // Summarize the result for asynchronous observers while the objects it
+  // references are still locked; the summary is posted once they are not.
+  std::shared_ptr<const ResultDigest> digest;
+  if (
+    key.m_observerOption == ObserverOption::InvokeObservers && observePostOperation && manager &&
+    !manager->asyncObservers().empty())
+  {
+    digest = ResultDigest::create(*this, result);
+  }
+
   // Unlock the resources locked by this operation instance.
   this->unlockResources(lockedByThis);
   this->m_lockedResources.clear();
+  m_snapshots.clear();
+
+  if (digest)
+  {
+    manager->asyncObservers().post(digest);
+  }
 
   return result;
 }
 
+std::shared_ptr<const smtk::resource::Snapshot> Operation::snapshot(
+  const smtk::common::UUID& resourceId) const
+{
+  auto it = m_snapshots.find(resourceId);
+  return it == m_snapshots.end() ? nullptr : it->second;
+}
+
 void Operation::unlockResources(const ResourceAccessMap& resources)
 {
   for (const auto& resourceAndLockType : resources)
   {
     auto resource = resourceAndLockType.first.lock();
     const auto& lockType = resourceAndLockType.second;
+    if (lockType == smtk::resource::LockType::Write)
+    {
+      resource->publishSnapshot({});
+    }
     resource->lock({}).unlock(lockType);
   }
 }
@@ -626,6 +747,48 @@ void Operation::markModifiedResources(Operation::Result& result)
       }
     }
   }
+
+  // Tell resources which components changed so their next snapshots can be
+  // updated rather than retaken.
+  std::map<smtk::resource::Resource*, std::unordered_set<smtk::common::UUID>> changes;
+  for (const auto* itemName : { "created", "modified", "expunged" })
+  {
+    auto item = result->findComponent(itemName);
+    for (std::size_t ii = 0; item && ii < item->numberOfValues(); ++ii)
+    {
+      auto component = item->value(ii);
+      auto resource = component ? component->resource() : nullptr;
+      if (resource)
+      {
+        changes[resource.get()].insert(component->id());
+      }
+    }
+  }
+  for (const auto& entry : changes)
+  {
+    entry.first->recordSnapshotChanges(entry.second, {});
+  }
+
+  // Attribute resources cache the attributes associated with each object;
+  // forget those of expunged components.
+  auto expunged = result->findComponent("expunged");
+  auto resourceManager = this->resourceManager();
+  if (expunged && expunged->numberOfValues() > 0 && resourceManager)
+  {
+    resourceManager->visit([&expunged](smtk::resource::Resource& rsrc) {
+      if (auto* attResource = dynamic_cast<smtk::attribute::Resource*>(&rsrc))
+      {
+        for (std::size_t ii = 0; ii < expunged->numberOfValues(); ++ii)
+        {
+          if (auto component = expunged->value(ii))
+          {
+            attResource->invalidateAssociationCache(component->id());
+          }
+        }
+      }
+      return smtk::common::Processing::CONTINUE;
+    });
+  }
 }
 
 namespace
@@ -641,6 +804,10 @@ bool removeResource(
   {
     resourceManager->visit([&resource](smtk::resource::Resource& rsrc) {
       rsrc.links().removeAllLinksTo(resource);
+      if (auto* attResource = dynamic_cast<smtk::attribute::Resource*>(&rsrc))
+      {
+        attResource->invalidateAssociationCache();
+      }
       return smtk::common::Processing::CONTINUE;
     });
   }
@@ -824,5 +991,35 @@ bool setOutcome(const Operation::Result& result, Operation::Outcome outcome)
   return item->setValue(value);
 }
 
+bool mergeResult(const Operation::Result& result, const Operation::Result& childResult)
+{
+  if (childResult)
+  {
+    for (const auto* itemName :
+         { "created", "modified", "expunged", "resourcesCreated", "resourcesModified", "hints" })
+    {
+      auto source = childResult->findReference(itemName);
+      auto target = result->findReference(itemName);
+      if (!source || !target)
+      {
+        continue;
+      }
+      for (std::size_t ii = 0; ii < source->numberOfValues(); ++ii)
+      {
+        if (source->isSet(ii))
+        {
+          target->appendValue(source->value(ii), /* allowDuplicates */ false);
+        }
+      }
+    }
+    if (outcome(childResult) == Operation::Outcome::SUCCEEDED)
+    {
+      return true;
+    }
+  }
+  setOutcome(result, Operation::Outcome::FAILED);
+  return false;
+}
+
 } // namespace operation
 } // namespace smtk
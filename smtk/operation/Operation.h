@@ -11,11 +11,14 @@
 #define smtk_operation_Operation_h
 
 #include "smtk/resource/Lock.h"
+#include "smtk/resource/Snapshot.h"
 
 #include "smtk/PublicPointerDefs.h"
 #include "smtk/SharedFromThis.h"
 #include "smtk/common/Deprecation.h"
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <mutex>
@@ -42,6 +45,7 @@ class ImportPythonOperation;
 class Manager;
 class Operation;
 class PythonRunChild;
+class Tracer;
 
 using Handler = std::function<void(Operation&, const std::shared_ptr<smtk::attribute::Attribute>&)>;
 
@@ -230,6 +234,26 @@ public:
   /// Is this type of operation safe to launch in a thread?
   virtual bool threadSafe() const { return true; }
 
+  /// May instances of this type of operation start from a copy of the
+  /// specification held by their Metadata?
+  ///
+  /// Operations created by a manager copy the definitions parsed when their
+  /// type was registered rather than parsing their XML again (see
+  /// Manager::setSpecificationCacheEnabled()). Operations whose specification
+  /// depends on run-time state should return false so that each instance
+  /// constructs its own with createSpecification().
+  virtual bool cacheableSpecification() const { return true; }
+
+  /// Set the maximum time operate() may spend waiting for resource locks.
+  ///
+  /// Locks are acquired in a canonical order (by resource UUID) using
+  /// blocking waits. If all of the locks cannot be acquired before the
+  /// timeout expires, any locks already acquired are released and the
+  /// operation returns a result whose outcome is UNABLE_TO_OPERATE.
+  /// By default, operations wait indefinitely.
+  void setLockTimeout(const std::chrono::milliseconds& timeout) { m_lockTimeout = timeout; }
+  const std::chrono::milliseconds& lockTimeout() const { return m_lockTimeout; }
+
   /// retrieve the resource manager, if available.
   smtk::resource::ManagerPtr resourceManager();
 
@@ -272,6 +296,14 @@ protected:
   /// Returns the set of resources that are currently locked by this operation.
   const ResourceAccessMap& lockedResources() const { return this->m_lockedResources; }
 
+  /// Return the snapshot of the resource with the given \a resourceId that
+  /// was taken because identifyLocksRequired() requested LockType::Snapshot
+  /// access to it. Null is returned for resources not accessed this way and
+  /// when no snapshot of the resource was available without waiting (see
+  /// smtk::resource::Resource::snapshot()).
+  std::shared_ptr<const smtk::resource::Snapshot> snapshot(
+    const smtk::common::UUID& resourceId) const;
+
   /// Perform the actual operation and construct the result.
   virtual Result operateInternal() = 0;
 
@@ -362,6 +394,12 @@ private:
   Definition m_resultDefinition;
   std::vector<std::weak_ptr<smtk::attribute::Attribute>> m_results;
   ResourceAccessMap m_lockedResources;
+  std::map<smtk::common::UUID, std::shared_ptr<const smtk::resource::Snapshot>> m_snapshots;
+  std::chrono::milliseconds m_lockTimeout{ std::chrono::milliseconds::max() };
+  // The tracer (if any) recording the current call to operate() and the id
+  // of its span, so that nested operations may refer to it.
+  Tracer* m_tracer{ nullptr };
+  std::uint64_t m_traceId{ 0 };
   std::mutex m_handlerLock;
   std::multimap<Priority, Handler> m_handlers;
 };
@@ -374,6 +412,18 @@ private:
 SMTKCORE_EXPORT Operation::Outcome outcome(const Operation::Result& result);
 SMTKCORE_EXPORT bool setOutcome(const Operation::Result& result, Operation::Outcome outcome);
 
+/**\brief Merge the result of a nested operation into its parent's \a result.
+  *
+  * The created, modified and expunged components, the created and modified
+  * resources and the hints held by \a childResult are appended to those of
+  * \a result (skipping any already present). If the nested operation did not
+  * succeed (or \a childResult is null), \a result is marked as failed.
+  * Returns true if the nested operation succeeded.
+  */
+SMTKCORE_EXPORT bool mergeResult(
+  const Operation::Result& result,
+  const Operation::Result& childResult);
+
 } // namespace operation
 } // namespace smtk
 
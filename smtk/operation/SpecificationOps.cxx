@@ -352,6 +352,9 @@ std::unique_ptr<smtk::resource::ScopedLockSetGuard> lockResources(
           readWriteResources.insert(resource);
           resources.insert(resource);
           break;
+        case smtk::resource::LockType::Snapshot:
+          // Snapshot access does not lock the resource.
+          break;
         default:
         {
           smtkErrorMacro(
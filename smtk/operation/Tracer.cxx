@@ -0,0 +1,350 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/operation/Tracer.h"
+
+#include "smtk/io/Logger.h"
+
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace smtk
+{
+namespace operation
+{
+namespace
+{
+// The innermost Phase::Operate span alive on each thread.
+thread_local const Tracer::Span* g_currentSpan = nullptr;
+
+constexpr std::size_t numberOfPhases = static_cast<std::size_t>(Tracer::Phase::NumberOfPhases);
+} // anonymous namespace
+
+struct Tracer::Internal
+{
+  Clock::time_point m_epoch{ Clock::now() };
+
+  mutable std::mutex m_mutex;
+  std::vector<Event> m_events;
+  std::size_t m_maximumNumberOfEvents{ 1 << 20 };
+  std::size_t m_dropped{ 0 };
+  std::unordered_map<std::thread::id, std::uint32_t> m_threads;
+  std::unordered_map<smtk::string::Token, std::array<Histogram, numberOfPhases>> m_histograms;
+  std::mutex m_enabledMutex;
+  std::function<void(bool)> m_enabledCallback;
+};
+
+const char* Tracer::phaseName(Phase phase)
+{
+  static const char* names[] = { "operate",
+                                 "lock",
+                                 "ableToOperate",
+                                 "willOperateObservers",
+                                 "operateInternal",
+                                 "postProcessResult",
+                                 "markModifiedResources",
+                                 "generateSummary",
+                                 "serializeLog",
+                                 "handlers",
+                                 "didOperateObservers",
+                                 "observer",
+                                 "unmanageResources" };
+  static_assert(sizeof(names) / sizeof(names[0]) == numberOfPhases, "Missing phase names.");
+  auto index = static_cast<std::size_t>(phase);
+  return index < numberOfPhases ? names[index] : "unknown";
+}
+
+void Tracer::Histogram::insert(double duration)
+{
+  double microseconds = duration * 1000.;
+  std::size_t bin = 0;
+  if (microseconds >= 1.)
+  {
+    bin = std::min(
+      static_cast<std::size_t>(std::floor(std::log2(microseconds))) + 1, NumberOfBins - 1);
+  }
+  ++bins[bin];
+  minTime = count == 0 ? duration : std::min(minTime, duration);
+  maxTime = std::max(maxTime, duration);
+  totalTime += duration;
+  ++count;
+}
+
+double Tracer::Histogram::percentile(double fraction) const
+{
+  if (count == 0)
+  {
+    return 0.;
+  }
+  auto target =
+    static_cast<std::size_t>(std::ceil(std::max(0., std::min(1., fraction)) * count));
+  std::size_t seen = 0;
+  for (std::size_t bin = 0; bin < NumberOfBins; ++bin)
+  {
+    seen += bins[bin];
+    if (seen >= target && seen > 0)
+    {
+      // The upper edge of the bin (in ms), clamped to the observed range.
+      double upper = std::ldexp(1., static_cast<int>(bin)) / 1000.;
+      return std::max(minTime, std::min(upper, maxTime));
+    }
+  }
+  return maxTime;
+}
+
+Tracer::Span::Span(
+  Tracer* tracer,
+  Phase phase,
+  smtk::string::Token operationType,
+  std::uint64_t operation,
+  std::uint64_t parent)
+  : m_tracer(tracer)
+  , m_phase(phase)
+  , m_operationType(operationType)
+  , m_operation(operation)
+  , m_parent(parent)
+{
+  if (m_tracer)
+  {
+    m_start = Clock::now();
+    if (m_phase == Phase::Operate)
+    {
+      m_previous = g_currentSpan;
+      g_currentSpan = this;
+    }
+  }
+}
+
+void Tracer::Span::finish()
+{
+  if (!m_tracer)
+  {
+    return;
+  }
+  m_tracer->record(m_phase, m_operationType, m_operation, m_parent, m_start, Clock::now());
+  if (m_phase == Phase::Operate && g_currentSpan == this)
+  {
+    g_currentSpan = m_previous;
+  }
+  m_tracer = nullptr;
+}
+
+Tracer::Tracer()
+  : m_internal(new Internal)
+{
+}
+
+Tracer::~Tracer() = default;
+
+void Tracer::setEnabled(bool enabled)
+{
+  std::lock_guard<std::mutex> guard(m_internal->m_enabledMutex);
+  if (m_enabled.exchange(enabled, std::memory_order_relaxed) != enabled)
+  {
+    if (m_internal->m_enabledCallback)
+    {
+      m_internal->m_enabledCallback(enabled);
+    }
+  }
+}
+
+void Tracer::setEnabledCallback(std::function<void(bool)> callback)
+{
+  std::lock_guard<std::mutex> guard(m_internal->m_enabledMutex);
+  m_internal->m_enabledCallback = std::move(callback);
+}
+
+std::uint64_t Tracer::currentOperation()
+{
+  return g_currentSpan ? g_currentSpan->operation() : 0;
+}
+
+void Tracer::record(
+  Phase phase,
+  smtk::string::Token operationType,
+  std::uint64_t operation,
+  std::uint64_t parent,
+  Clock::time_point start,
+  Clock::time_point finish,
+  const std::string& detail)
+{
+  double duration = std::chrono::duration<double, std::micro>(finish - start).count();
+  double offset = std::chrono::duration<double, std::micro>(start - m_internal->m_epoch).count();
+
+  std::unique_lock<std::mutex> guard(m_internal->m_mutex);
+  m_internal->m_histograms[operationType][static_cast<std::size_t>(phase)].insert(
+    duration / 1000.);
+  if (m_internal->m_events.size() >= m_internal->m_maximumNumberOfEvents)
+  {
+    if (m_internal->m_dropped++ == 0)
+    {
+      std::size_t maximum = m_internal->m_maximumNumberOfEvents;
+      guard.unlock();
+      smtkWarningMacro(
+        smtk::io::Logger::instance(),
+        "The operation tracer has recorded its maximum of "
+          << maximum
+          << " events; further events will be dropped from exported traces "
+             "(but included in histograms).");
+    }
+    return;
+  }
+  auto threadIt = m_internal->m_threads
+                    .emplace(
+                      std::this_thread::get_id(),
+                      static_cast<std::uint32_t>(m_internal->m_threads.size() + 1))
+                    .first;
+  m_internal->m_events.push_back(
+    Event{ phase, operationType, operation, parent, threadIt->second, offset, duration, detail });
+}
+
+void Tracer::traceObserver(const std::string& description, const std::function<void()>& invoke)
+{
+  if (!this->enabled())
+  {
+    invoke();
+    return;
+  }
+  smtk::string::Token operationType;
+  std::uint64_t operation = 0;
+  if (g_currentSpan)
+  {
+    operationType = g_currentSpan->operationType();
+    operation = g_currentSpan->operation();
+  }
+  auto start = Clock::now();
+  try
+  {
+    invoke();
+  }
+  catch (...)
+  {
+    this->record(Phase::Observer, operationType, operation, 0, start, Clock::now(), description);
+    throw;
+  }
+  this->record(Phase::Observer, operationType, operation, 0, start, Clock::now(), description);
+}
+
+std::vector<Tracer::Event> Tracer::events() const
+{
+  std::lock_guard<std::mutex> guard(m_internal->m_mutex);
+  return m_internal->m_events;
+}
+
+void Tracer::setMaximumNumberOfEvents(std::size_t maximum)
+{
+  std::lock_guard<std::mutex> guard(m_internal->m_mutex);
+  m_internal->m_maximumNumberOfEvents = maximum;
+}
+
+std::size_t Tracer::maximumNumberOfEvents() const
+{
+  std::lock_guard<std::mutex> guard(m_internal->m_mutex);
+  return m_internal->m_maximumNumberOfEvents;
+}
+
+std::size_t Tracer::numberOfDroppedEvents() const
+{
+  std::lock_guard<std::mutex> guard(m_internal->m_mutex);
+  return m_internal->m_dropped;
+}
+
+void Tracer::writeTrace(std::ostream& stream) const
+{
+  nlohmann::json traceEvents = nlohmann::json::array();
+  for (const auto& event : this->events())
+  {
+    std::string name;
+    if (event.phase == Phase::Operate)
+    {
+      name = event.operationType.data();
+    }
+    else if (event.phase == Phase::Observer && !event.detail.empty())
+    {
+      name = event.detail;
+    }
+    else
+    {
+      name = Tracer::phaseName(event.phase);
+    }
+    nlohmann::json args = { { "operation", event.operationType.data() },
+                            { "id", event.operation } };
+    if (event.parent != 0)
+    {
+      args["parent"] = event.parent;
+    }
+    traceEvents.push_back({ { "name", name },
+                            { "cat", Tracer::phaseName(event.phase) },
+                            { "ph", "X" },
+                            { "ts", event.start },
+                            { "dur", event.duration },
+                            { "pid", 1 },
+                            { "tid", event.thread },
+                            { "args", args } });
+  }
+  nlohmann::json trace = { { "traceEvents", traceEvents },
+                           { "displayTimeUnit", "ms" },
+                           { "otherData",
+                             { { "droppedEvents", this->numberOfDroppedEvents() },
+                               { "maximumNumberOfEvents", this->maximumNumberOfEvents() } } } };
+  stream << trace.dump();
+}
+
+bool Tracer::exportTrace(const std::string& filename) const
+{
+  std::ofstream file(filename);
+  if (!file.good())
+  {
+    return false;
+  }
+  this->writeTrace(file);
+  file.close();
+  return !file.fail();
+}
+
+std::vector<smtk::string::Token> Tracer::operationTypes() const
+{
+  std::vector<smtk::string::Token> result;
+  std::lock_guard<std::mutex> guard(m_internal->m_mutex);
+  result.reserve(m_internal->m_histograms.size());
+  for (const auto& entry : m_internal->m_histograms)
+  {
+    result.push_back(entry.first);
+  }
+  return result;
+}
+
+Tracer::Histogram Tracer::histogram(smtk::string::Token operationType, Phase phase) const
+{
+  auto index = static_cast<std::size_t>(phase);
+  std::lock_guard<std::mutex> guard(m_internal->m_mutex);
+  auto it = m_internal->m_histograms.find(operationType);
+  if (it == m_internal->m_histograms.end() || index >= numberOfPhases)
+  {
+    return Histogram();
+  }
+  return it->second[index];
+}
+
+void Tracer::clear()
+{
+  std::lock_guard<std::mutex> guard(m_internal->m_mutex);
+  m_internal->m_events.clear();
+  m_internal->m_dropped = 0;
+  m_internal->m_histograms.clear();
+}
+
+} // namespace operation
+} // namespace smtk
@@ -0,0 +1,226 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_operation_Tracer_h
+#define smtk_operation_Tracer_h
+
+#include "smtk/CoreExports.h"
+#include "smtk/string/Token.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace smtk
+{
+namespace operation
+{
+
+/**\brief Record where time is spent while operations run.
+  *
+  * When enabled, Operation::operate() records a span for each phase of its
+  * execution (waiting on resource locks, validation, operateInternal(),
+  * post-processing, observers, and so on) along with a span covering the
+  * entire operation. Spans of nested operations refer to the span of the
+  * operation that launched them.
+  *
+  * Spans may be exported as a Chrome trace-event JSON file (which can be
+  * opened by Perfetto or chrome://tracing) and are also aggregated into a
+  * histogram of durations per operation type and phase.
+  *
+  * Tracing is disabled by default. While disabled, operations only test
+  * enabled() and record nothing.
+  */
+class SMTKCORE_EXPORT Tracer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// The portions of Operation::operate() that are traced.
+  enum class Phase
+  {
+    Operate,               //!< The entire call to Operation::operate().
+    Lock,                  //!< Waiting on resource locks (and taking snapshots).
+    AbleToOperate,         //!< Validating the operation's parameters.
+    WillOperateObservers,  //!< Observers invoked before the operation runs.
+    OperateInternal,       //!< The operation's own implementation.
+    PostProcessResult,     //!< Operation::postProcessResult().
+    MarkModifiedResources, //!< Operation::markModifiedResources().
+    GenerateSummary,       //!< Operation::generateSummary().
+    SerializeLog,          //!< Copying log records into the result.
+    Handlers,              //!< Handlers invoked after the operation ran.
+    DidOperateObservers,   //!< Observers invoked after the operation ran.
+    Observer,              //!< A single observer (nested inside the above).
+    UnmanageResources,     //!< Removing expunged resources from their manager.
+    NumberOfPhases
+  };
+
+  /// Return a human-readable name for \a phase.
+  static const char* phaseName(Phase phase);
+
+  /// Durations of one phase of one type of operation.
+  ///
+  /// Durations are binned by powers of two: bin 0 holds durations shorter
+  /// than 1 microsecond and bin \a i holds those in [2^(i-1), 2^i) microseconds.
+  struct SMTKCORE_EXPORT Histogram
+  {
+    static constexpr std::size_t NumberOfBins = 40;
+
+    std::array<std::size_t, NumberOfBins> bins{}; //!< The number of spans in each bin.
+    std::size_t count{ 0 };                       //!< The number of spans.
+    double totalTime{ 0. };                       //!< The sum of all durations (ms).
+    double minTime{ 0. };                         //!< The shortest duration (ms).
+    double maxTime{ 0. };                         //!< The longest duration (ms).
+
+    /// Add a duration (in ms) to the histogram.
+    void insert(double duration);
+    /// Return the mean duration (in ms).
+    double mean() const { return count > 0 ? totalTime / count : 0.; }
+    /// Return an upper bound (in ms) on the given \a fraction (in [0, 1]) of durations.
+    double percentile(double fraction) const;
+  };
+
+  /// A span recorded for one phase of an operation.
+  struct Event
+  {
+    Phase phase;
+    smtk::string::Token operationType;
+    std::uint64_t operation;   //!< The id of the operation's Phase::Operate span.
+    std::uint64_t parent;      //!< The id of the parent operation's span (or 0).
+    std::uint32_t thread;      //!< A small integer identifying the thread.
+    double start;              //!< Microseconds since the tracer was constructed.
+    double duration;           //!< Microseconds.
+    std::string detail;        //!< The observer description for Phase::Observer.
+  };
+
+  /**\brief Record a span from construction until finish() or destruction.
+    *
+    * Spans constructed with a null tracer record nothing and never read the clock.
+    * While a Phase::Operate span is alive, its operation is the "current"
+    * operation on its thread; observers invoked on that thread are attributed
+    * to it.
+    */
+  class SMTKCORE_EXPORT Span
+  {
+  public:
+    Span(
+      Tracer* tracer,
+      Phase phase,
+      smtk::string::Token operationType,
+      std::uint64_t operation,
+      std::uint64_t parent = 0);
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+    ~Span() { this->finish(); }
+
+    /// Record the span now rather than upon destruction.
+    void finish();
+
+    smtk::string::Token operationType() const { return m_operationType; }
+    std::uint64_t operation() const { return m_operation; }
+
+  private:
+    Tracer* m_tracer;
+    Phase m_phase;
+    smtk::string::Token m_operationType;
+    std::uint64_t m_operation;
+    std::uint64_t m_parent;
+    Clock::time_point m_start;
+    const Span* m_previous{ nullptr };
+  };
+
+  Tracer();
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+  ~Tracer();
+
+  ///@name Enabling tracing
+  ///@{
+  bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+  void setEnabled(bool enabled);
+
+  /// Set a functor called with the new state each time tracing is enabled or disabled.
+  ///
+  /// Operation managers use this to route their observers through
+  /// traceObserver() only while tracing is enabled.
+  void setEnabledCallback(std::function<void(bool)> callback);
+  ///@}
+
+  /// Return a new identifier for an operation's Phase::Operate span.
+  std::uint64_t nextOperationId() { return ++m_lastOperationId; }
+
+  /// Return the operation span that is current on the calling thread (or 0).
+  static std::uint64_t currentOperation();
+
+  /// Record a span. This is usually done by a Span instance.
+  void record(
+    Phase phase,
+    smtk::string::Token operationType,
+    std::uint64_t operation,
+    std::uint64_t parent,
+    Clock::time_point start,
+    Clock::time_point finish,
+    const std::string& detail = std::string());
+
+  /// Call \a invoke, recording a Phase::Observer span if tracing is enabled.
+  ///
+  /// This is suitable for use as an smtk::common::Observers monitor.
+  void traceObserver(const std::string& description, const std::function<void()>& invoke);
+
+  ///@name Trace events
+  ///@{
+  /// Return a copy of the events recorded so far.
+  std::vector<Event> events() const;
+
+  /// The number of events retained for export. Once this many events have
+  /// been recorded, further events are dropped (but still included in
+  /// histograms). A warning is logged when the first event is dropped.
+  void setMaximumNumberOfEvents(std::size_t maximum);
+  std::size_t maximumNumberOfEvents() const;
+  /// The number of events dropped since the last call to clear().
+  std::size_t numberOfDroppedEvents() const;
+
+  /// Write recorded events to \a stream in Chrome trace-event JSON format.
+  ///
+  /// The number of dropped events is reported in the trace's "otherData".
+  void writeTrace(std::ostream& stream) const;
+  /// Write recorded events to the file \a filename in Chrome trace-event JSON format.
+  bool exportTrace(const std::string& filename) const;
+  ///@}
+
+  ///@name Aggregate statistics
+  ///@{
+  /// Return the types of operations for which spans have been recorded.
+  std::vector<smtk::string::Token> operationTypes() const;
+  /// Return the histogram of durations of \a phase for operations of \a operationType.
+  Histogram histogram(smtk::string::Token operationType, Phase phase) const;
+  ///@}
+
+  /// Discard all events and histograms.
+  void clear();
+
+private:
+  struct Internal;
+
+  std::atomic<bool> m_enabled{ false };
+  std::atomic<std::uint64_t> m_lastOperationId{ 0 };
+  std::unique_ptr<Internal> m_internal;
+};
+
+} // namespace operation
+} // namespace smtk
+
+#endif // smtk_operation_Tracer_h
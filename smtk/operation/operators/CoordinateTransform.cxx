@@ -201,7 +201,7 @@ CoordinateTransform::Result CoordinateTransform::operateInternal()
     if (objItem->numberOfValues() > 0 && objItem->isSet())
     {
       obj = objItem->value();
-      if (obj)
+      if (obj && this->landmarkHoldsFrame(obj, fromLandmarkName))
       {
         fromLandmarkId = obj->id().toString();
       }
@@ -223,7 +223,7 @@ CoordinateTransform::Result CoordinateTransform::operateInternal()
     if (objItem->numberOfValues() > 0 && objItem->isSet())
     {
       obj = objItem->value();
-      if (obj)
+      if (obj && this->landmarkHoldsFrame(obj, toLandmarkName))
       {
         toLandmarkId = obj->id().toString();
       }
@@ -272,6 +272,36 @@ CoordinateTransform::Result CoordinateTransform::operateInternal()
   return result;
 }
 
+bool CoordinateTransform::landmarkHoldsFrame(
+  const smtk::resource::PersistentObject::Ptr& landmark,
+  const std::string& propertyName)
+{
+  auto resource = std::dynamic_pointer_cast<smtk::resource::Resource>(landmark);
+  if (!resource)
+  {
+    resource = std::dynamic_pointer_cast<Component>(landmark)->resource();
+  }
+  bool holdsFrame = true;
+  if (auto snapshot = this->snapshot(resource->id()))
+  {
+    holdsFrame = snapshot->contains<CoordinateFrame>(landmark->id(), propertyName);
+  }
+  else if (this->lockedResources().find(resource) != this->lockedResources().end())
+  {
+    // The landmark belongs to a resource this operation locked (because it
+    // also holds associated components), so its properties may be read directly.
+    holdsFrame = landmark->properties().contains<CoordinateFrame>(propertyName);
+  }
+  if (!holdsFrame)
+  {
+    smtkWarningMacro(
+      this->log(),
+      "Landmark \"" << landmark->name() << "\" has no coordinate frame named \"" << propertyName
+                     << "\"; recording the frame as user-edited.");
+  }
+  return holdsFrame;
+}
+
 const char* CoordinateTransform::xmlDescription() const
 {
   return CoordinateTransform_xml;
@@ -51,6 +51,12 @@ namespace operation
   *   a coordinate-frame property on the "from.id" (or "to.id",
   *   respectively) above or user-provided text describing the
   *   coordinate frame used to generate the transform.
+  *
+  * Landmark objects are read through a snapshot of their resource (see
+  * smtk::resource::Snapshot) rather than a lock, so transforms may be set
+  * while the landmark's resource is being modified. If the snapshot shows
+  * that the landmark does not hold the named coordinate frame, no id is
+  * recorded and the name is kept as a user-provided note.
   */
 class SMTKCORE_EXPORT CoordinateTransform : public XMLOperation
 {
@@ -64,6 +70,11 @@ protected:
     const std::shared_ptr<smtk::attribute::ReferenceItem>& associations,
     Result& result);
 
+  /// Return false if \a landmark is known not to hold a coordinate frame named \a propertyName.
+  bool landmarkHoldsFrame(
+    const smtk::resource::PersistentObject::Ptr& landmark,
+    const std::string& propertyName);
+
   Result operateInternal() override;
   const char* xmlDescription() const override;
 };
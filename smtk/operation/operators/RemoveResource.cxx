@@ -83,6 +83,10 @@ RemoveResource::Result RemoveResource::operateInternal()
       {
         this->resourceManager()->visit([&resource](smtk::resource::Resource& rsrc) {
           rsrc.links().removeAllLinksTo(resource);
+          if (auto* attResource = dynamic_cast<smtk::attribute::Resource*>(&rsrc))
+          {
+            attResource->invalidateAssociationCache();
+          }
           return smtk::common::Processing::CONTINUE;
         });
       }
@@ -236,7 +236,7 @@ private:
 
   Result operateInternalPy() { PYBIND11_OVERLOAD_PURE(Result, Operation, operateInternal, ); }
 
-  Index m_index;
+  Index m_index{ 0 };
   std::string m_typeName;
 };
 }
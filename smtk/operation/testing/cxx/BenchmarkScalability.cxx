@@ -0,0 +1,439 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/operation/Operation.h"
+#include "smtk/operation/XMLOperation.h"
+#include "smtk/operation/testing/cxx/TrivialOperation.h"
+
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/Definition.h"
+#include "smtk/attribute/IntItem.h"
+#include "smtk/attribute/IntItemDefinition.h"
+#include "smtk/attribute/Resource.h"
+#include "smtk/attribute/json/jsonResource.h"
+
+#include "smtk/graph/Component.h"
+#include "smtk/graph/Resource.h"
+#include "smtk/graph/testing/cxx/TestNodes.h"
+
+#include "smtk/resource/Properties.h"
+#include "smtk/resource/json/Helper.h"
+#include "smtk/resource/json/StreamWriter.h"
+#include "smtk/resource/json/jsonResource.h"
+
+#include "smtk/common/ChunkedFile.h"
+#include "smtk/common/Links.h"
+#include "smtk/common/UUID.h"
+#include "smtk/common/UUIDGenerator.h"
+
+#include "smtk/common/testing/cxx/Benchmark.h"
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include "nlohmann/json.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using smtk::common::testing::Benchmark;
+
+namespace benchmark_scalability
+{
+std::string write_root = SMTK_SCRATCH_DIR;
+
+std::size_t numberOfAttributes(const smtk::attribute::ResourcePtr& resource)
+{
+  std::vector<smtk::attribute::AttributePtr> attributes;
+  resource->attributes(attributes);
+  return attributes.size();
+}
+
+std::string attributeName(std::size_t index)
+{
+  return "node " + std::to_string(index);
+}
+
+// Create an attribute resource holding \a count attributes of one definition.
+smtk::attribute::ResourcePtr createAttributes(std::size_t count)
+{
+  auto resource = smtk::attribute::Resource::create();
+  auto definition = resource->createDefinition("node");
+  definition->addItemDefinition<smtk::attribute::IntItemDefinition>("value");
+  resource->finalizeDefinitions();
+  for (std::size_t ii = 0; ii < count; ++ii)
+  {
+    auto attribute = resource->createAttribute(attributeName(ii), definition);
+    attribute->findInt("value")->setValue(static_cast<int>(ii));
+  }
+  return resource;
+}
+
+void benchmarkAttributes(Benchmark& benchmark)
+{
+  std::size_t count = benchmark.scale();
+  smtk::attribute::ResourcePtr resource;
+  benchmark.measure(
+    "attribute/create", count, [&resource, count]() { resource = createAttributes(count); });
+  smtkTest(
+    numberOfAttributes(resource) == count, "Expected " << count << " attributes to be created.");
+
+  std::vector<smtk::common::UUID> ids;
+  ids.reserve(count);
+  for (std::size_t ii = 0; ii < count; ++ii)
+  {
+    ids.push_back(resource->findAttribute(attributeName(ii))->id());
+  }
+
+  std::size_t found = 0;
+  benchmark.measure("attribute/findByName", count, [&]() {
+    found = 0;
+    for (std::size_t ii = 0; ii < count; ++ii)
+    {
+      found += resource->findAttribute(attributeName(benchmark.random(count))) ? 1 : 0;
+    }
+  });
+  smtkTest(found == count, "Found " << found << " of " << count << " attributes by name.");
+
+  benchmark.measure("attribute/findById", count, [&]() {
+    found = 0;
+    for (std::size_t ii = 0; ii < count; ++ii)
+    {
+      found += resource->findAttribute(ids[benchmark.random(count)]) ? 1 : 0;
+    }
+  });
+  smtkTest(found == count, "Found " << found << " of " << count << " attributes by UUID.");
+}
+
+void benchmarkLinks(Benchmark& benchmark)
+{
+  using Links = smtk::common::Links<smtk::common::UUID, smtk::common::UUID, smtk::common::UUID>;
+
+  // Link each of count objects to a few others (as a model's uses and
+  // relationships would).
+  std::size_t count = benchmark.scale();
+  std::size_t linksPerObject = 4;
+  std::vector<smtk::common::UUID> objects;
+  objects.reserve(count);
+  auto& generator = smtk::common::UUIDGenerator::instance();
+  for (std::size_t ii = 0; ii < count; ++ii)
+  {
+    objects.push_back(generator.random());
+  }
+
+  Links links;
+  benchmark.measure("links/insert", count * linksPerObject, [&]() {
+    links.clear();
+    for (std::size_t ii = 0; ii < count * linksPerObject; ++ii)
+    {
+      links.insert(
+        generator.random(),
+        objects[ii / linksPerObject],
+        objects[benchmark.random(count)],
+        static_cast<int>(ii % linksPerObject));
+    }
+  });
+  smtkTest(
+    links.size() == count * linksPerObject, "Expected " << count * linksPerObject << " links.");
+
+  std::size_t linked = 0;
+  benchmark.measure("links/queryLeft", count, [&]() {
+    linked = 0;
+    for (std::size_t ii = 0; ii < count; ++ii)
+    {
+      linked += links.linked_to<Links::Left>(objects[benchmark.random(count)]).size();
+    }
+  });
+  smtkTest(linked > 0, "Expected links from the left.");
+
+  benchmark.measure("links/queryRight", count, [&]() {
+    linked = 0;
+    for (std::size_t ii = 0; ii < count; ++ii)
+    {
+      linked += links.linked_to<Links::Right>(objects[benchmark.random(count)]).size();
+    }
+  });
+  smtkTest(linked > 0, "Expected links from the right.");
+
+  benchmark.measure("links/queryLeftRole", count, [&]() {
+    linked = 0;
+    for (std::size_t ii = 0; ii < count; ++ii)
+    {
+      linked += links
+                  .linked_to<Links::Left>(
+                    objects[benchmark.random(count)], static_cast<int>(ii % linksPerObject))
+                  .size();
+    }
+  });
+  smtkTest(linked > 0, "Expected links from the left with a role.");
+
+  std::vector<Links::LinkValues> values;
+  values.reserve(count * linksPerObject);
+  for (std::size_t ii = 0; ii < count * linksPerObject; ++ii)
+  {
+    values.emplace_back(
+      generator.random(),
+      objects[ii / linksPerObject],
+      objects[benchmark.random(count)],
+      static_cast<int>(ii % linksPerObject));
+  }
+  benchmark.measure("links/bulkInsert", count * linksPerObject, [&]() {
+    links.clear();
+    links.bulk_insert(values);
+  });
+  smtkTest(
+    links.size() == count * linksPerObject, "Expected " << count * linksPerObject << " links.");
+}
+
+void benchmarkFilter(Benchmark& benchmark)
+{
+  // Half of the nodes are NodeA; every node is in one of 100 groups.
+  std::size_t count = benchmark.scale();
+  auto resource = smtk::graph::Resource<smtk::test::BasicTraits>::create();
+  benchmark.measure("filter/createNodes", count, [&]() {
+    resource = smtk::graph::Resource<smtk::test::BasicTraits>::create();
+    for (std::size_t ii = 0; ii < count; ++ii)
+    {
+      auto node = (ii % 2 == 0)
+        ? std::static_pointer_cast<smtk::graph::Component>(resource->create<smtk::test::NodeA>())
+        : std::static_pointer_cast<smtk::graph::Component>(resource->create<smtk::test::NodeB>());
+      node->properties().emplace<long>("group", static_cast<long>(benchmark.random(100)));
+    }
+  });
+
+  const std::size_t queries = 20;
+  std::size_t matched = 0;
+  benchmark.measure("filter/byType", queries, [&]() {
+    matched = 0;
+    for (std::size_t ii = 0; ii < queries; ++ii)
+    {
+      matched += resource->filter("'NodeA'").size();
+    }
+  });
+  smtkTest(matched == queries * ((count + 1) / 2), "Unexpected number of NodeA matches.");
+
+  auto filterByGroup = [&]() {
+    matched = 0;
+    for (std::size_t ii = 0; ii < queries; ++ii)
+    {
+      matched += resource
+                   ->filter(
+                     "'NodeA' [ integer { 'group' = " + std::to_string(benchmark.random(100)) +
+                     " } ]")
+                   .size();
+    }
+  };
+  benchmark.measure("filter/byProperty", queries, filterByGroup);
+  std::size_t unindexed = matched;
+
+  resource->properties().addIndex<long>("group");
+  benchmark.measure("filter/byIndexedProperty", queries, filterByGroup);
+  smtkTest(
+    matched == unindexed,
+    "Indexed filter matched " << matched << " components, unindexed matched " << unindexed << ".");
+}
+
+void benchmarkJSON(Benchmark& benchmark)
+{
+  std::size_t count = benchmark.scale();
+  auto resource = createAttributes(count);
+
+  nlohmann::json data;
+  benchmark.measure("json/serialize", count, [&]() { data = resource; });
+
+  std::string text;
+  benchmark.measure("json/streamSerialize", count, [&]() {
+    nlohmann::json skeleton;
+    std::vector<smtk::attribute::AttributePtr> attributes;
+    smtk::attribute::to_json(skeleton, resource, attributes);
+    std::ostringstream stream;
+    smtk::resource::json::StreamWriter writer(
+      stream, 2, &smtk::resource::json::Helper::threadPool());
+    writer.addArray(
+      "Attributes", attributes.size(), [&attributes](std::size_t index, nlohmann::json& jj) {
+        jj = attributes[index];
+      });
+    writer.write(skeleton);
+    text = stream.str();
+  });
+  smtkTest(text == data.dump(2), "Streamed serialization does not match nlohmann::json::dump().");
+
+  smtk::attribute::ResourcePtr copy;
+  benchmark.measure("json/deserialize", count, [&]() {
+    copy = smtk::attribute::Resource::create();
+    smtk::attribute::from_json(data, copy);
+  });
+  std::size_t copied = numberOfAttributes(copy);
+  smtkTest(copied == count, "Round trip produced " << copied << " of " << count << " attributes.");
+}
+
+void benchmarkChunkedFile(Benchmark& benchmark)
+{
+  // Each item is a point (3 coordinates) and a quadrilateral (4 point ids),
+  // as a tessellation would hold them.
+  std::size_t count = 100 * benchmark.scale();
+  std::vector<double> coords(3 * count);
+  std::vector<std::int64_t> conn(4 * count);
+  for (auto& coord : coords)
+  {
+    coord = static_cast<double>(benchmark.random(1000000)) / 1024.;
+  }
+  for (auto& id : conn)
+  {
+    id = static_cast<std::int64_t>(benchmark.random(count));
+  }
+  const std::string jsonName = write_root + "/BenchmarkScalabilityArrays.json";
+  const std::string chunkedName = write_root + "/BenchmarkScalabilityArrays.smtkc";
+
+  benchmark.measure("chunked/writeJSON", count, [&]() {
+    nlohmann::json j = { { "coords", coords }, { "conn", conn } };
+    std::ofstream file(jsonName, std::ios::out | std::ios::trunc);
+    file << j;
+  });
+  bool written = false;
+  benchmark.measure("chunked/write", count, [&]() {
+    smtk::common::ChunkedFileWriter writer;
+    writer.addArray("coords", coords);
+    writer.addArray("conn", conn);
+    written = writer.write(chunkedName);
+  });
+  smtkTest(written, "Could not write \"" << chunkedName << "\".");
+
+  std::vector<double> readCoords;
+  benchmark.measure("chunked/readJSON", count, [&]() {
+    std::ifstream file(jsonName);
+    auto j = nlohmann::json::parse(file);
+    readCoords = j.at("coords").get<std::vector<double>>();
+  });
+  smtkTest(readCoords == coords, "JSON coordinates do not match.");
+
+  // Opening a chunked file parses only its header; arrays are paged in as they are used.
+  std::shared_ptr<smtk::common::ChunkedFileReader> reader;
+  benchmark.measure("chunked/open", count, [&]() {
+    reader = smtk::common::ChunkedFileReader::open(chunkedName);
+  });
+  smtkTest(!!reader, "Could not open \"" << chunkedName << "\".");
+  double sum = 0.;
+  benchmark.measure("chunked/view", count, [&]() {
+    sum = 0.;
+    auto view = smtk::common::ChunkedFileReader::open(chunkedName)->view<double>("coords");
+    for (const auto& coord : view)
+    {
+      sum += coord;
+    }
+  });
+  smtkTest(sum > 0. || !smtk::common::ChunkedFileReader::littleEndian(), "Empty view.");
+  readCoords.clear();
+  benchmark.measure("chunked/materialize", count, [&]() {
+    reader = smtk::common::ChunkedFileReader::open(chunkedName);
+    readCoords = reader->materialize<double>("coords");
+  });
+  smtkTest(readCoords == coords, "Chunked coordinates do not match.");
+  std::remove(jsonName.c_str());
+  std::remove(chunkedName.c_str());
+
+  // Compare resources whose numeric property tables are stored as JSON with
+  // those that store them in a chunked file beside the JSON.
+  count = benchmark.scale();
+  auto resource = smtk::graph::Resource<smtk::test::BasicTraits>::create();
+  resource->setLocation(write_root + "/BenchmarkScalabilityProperties.smtk");
+  for (std::size_t ii = 0; ii < count; ++ii)
+  {
+    auto node = resource->create<smtk::test::NodeA>();
+    node->properties().emplace<long>("group", static_cast<long>(benchmark.random(100)));
+    node->properties().emplace<double>("weight", static_cast<double>(ii) / 7.);
+    node->properties().emplace<std::vector<double>>(
+      "point", std::vector<double>{ coords[3 * ii], coords[3 * ii + 1], coords[3 * ii + 2] });
+  }
+  smtk::resource::ResourcePtr base = resource;
+  std::string text;
+  std::string chunkedText;
+  benchmark.measure("properties/writeJSON", count, [&]() {
+    nlohmann::json j;
+    smtk::resource::to_json(j, base);
+    text = j.dump();
+  });
+  benchmark.measure("properties/writeChunked", count, [&]() {
+    nlohmann::json j;
+    smtk::resource::to_json(j, base);
+    written =
+      smtk::resource::writePropertiesFile(j, base, "BenchmarkScalabilityProperties.smtkc");
+    chunkedText = j.dump();
+  });
+  smtkTest(written, "Could not write properties file.");
+
+  auto readProperties = [&](const std::string& serialized) {
+    auto copy = smtk::graph::Resource<smtk::test::BasicTraits>::create();
+    copy->setLocation(resource->location());
+    smtk::resource::ResourcePtr copyBase = copy;
+    smtk::resource::from_json(nlohmann::json::parse(serialized), copyBase);
+    return copy;
+  };
+  auto copy = resource;
+  benchmark.measure("properties/readJSON", count, [&]() { copy = readProperties(text); });
+  using Weights = std::unordered_map<smtk::common::UUID, double>;
+  smtkTest(
+    copy->properties().data().at<Weights>("weight").size() == count,
+    "Expected " << count << " weights read from JSON.");
+  benchmark.measure("properties/readChunked", count, [&]() { copy = readProperties(chunkedText); });
+  smtkTest(
+    copy->properties().data().at<Weights>("weight").size() == count,
+    "Expected " << count << " weights read from a chunked file.");
+  std::remove((write_root + "/BenchmarkScalabilityProperties.smtkc").c_str());
+}
+
+void benchmarkOperations(Benchmark& benchmark)
+{
+  std::size_t count = benchmark.scale();
+  benchmark.measure("operation/createAndOperate", count, [&]() {
+    for (std::size_t ii = 0; ii < count; ++ii)
+    {
+      auto op = smtk::test::TrivialOp::create();
+      op->parameters()->findInt("value")->setValue(static_cast<int>(ii));
+      op->operate();
+    }
+  });
+
+  auto op = smtk::test::TrivialOp::create();
+  bool succeeded = true;
+  benchmark.measure("operation/operate", count, [&]() {
+    for (std::size_t ii = 0; ii < count; ++ii)
+    {
+      op->parameters()->findInt("value")->setValue(static_cast<int>(ii));
+      auto result = op->operate();
+      succeeded &= smtk::operation::outcome(result) ==
+        smtk::operation::Operation::Outcome::SUCCEEDED;
+    }
+  });
+  smtkTest(succeeded, "An operation failed.");
+}
+} // namespace benchmark_scalability
+
+// Time the creation and lookup of attributes, link insertion and queries,
+// resource filtering, JSON round trips (including streamed serialization),
+// chunked files compared with JSON, and operation overhead.
+// Pass "-n <count>" to change the number of objects (e.g., -n 200000),
+// "-o <file>" to record results, and "-b <file>" to compare against
+// recorded results (see smtk::common::testing::Benchmark for more).
+int BenchmarkScalability(int argc, char* argv[])
+{
+  using namespace benchmark_scalability;
+
+  Benchmark benchmark("BenchmarkScalability", argc, argv, 5000);
+  benchmarkAttributes(benchmark);
+  benchmarkLinks(benchmark);
+  benchmarkFilter(benchmark);
+  benchmarkJSON(benchmark);
+  benchmarkChunkedFile(benchmark);
+  benchmarkOperations(benchmark);
+  return benchmark.finish();
+}
@@ -0,0 +1,204 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/common/UUID.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/ComponentItem.h"
+#include "smtk/attribute/ComponentItemDefinition.h"
+#include "smtk/attribute/Definition.h"
+#include "smtk/attribute/Resource.h"
+
+#include "smtk/operation/AsyncObservers.h"
+#include "smtk/operation/Manager.h"
+#include "smtk/operation/Operation.h"
+
+#include "smtk/resource/Component.h"
+#include "smtk/resource/DerivedFrom.h"
+#include "smtk/resource/Resource.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+class MyResource : public smtk::resource::DerivedFrom<MyResource, smtk::resource::Resource>
+{
+public:
+  smtkTypeMacro(MyResource);
+  smtkCreateMacro(MyResource);
+  smtkSharedFromThisMacro(smtk::resource::PersistentObject);
+
+  smtk::resource::ComponentPtr find(const smtk::common::UUID& /*compId*/) const override
+  {
+    return smtk::resource::ComponentPtr();
+  }
+
+  std::function<bool(const smtk::resource::Component&)> queryOperation(
+    const std::string& /*unused*/) const override
+  {
+    return [](const smtk::resource::Component& /*unused*/) { return true; };
+  }
+
+  void visit(smtk::resource::Component::Visitor& /*v*/) const override {}
+
+protected:
+  MyResource() = default;
+};
+
+class MyComponent : public smtk::resource::Component
+{
+public:
+  smtkTypeMacro(MyComponent);
+  smtkCreateMacro(MyComponent);
+  smtkSharedFromThisMacro(smtk::resource::Component);
+
+  MyComponent() { m_id = smtk::common::UUID::random(); }
+
+  const smtk::common::UUID& id() const override { return m_id; }
+  bool setId(const smtk::common::UUID& anId) override
+  {
+    m_id = anId;
+    return true;
+  }
+
+  const smtk::resource::ResourcePtr resource() const override { return m_resource; }
+  void setResource(const MyResource::Ptr& resource) { m_resource = resource; }
+
+private:
+  MyResource::Ptr m_resource;
+  smtk::common::UUID m_id;
+};
+
+// Report the input component as modified and a new component as created.
+class CreateOperation : public smtk::operation::Operation
+{
+public:
+  smtkTypeMacro(CreateOperation);
+  smtkCreateMacro(CreateOperation);
+  smtkSharedFromThisMacro(smtk::operation::Operation);
+
+  CreateOperation() = default;
+  ~CreateOperation() override = default;
+
+protected:
+  Result operateInternal() override
+  {
+    auto input = this->parameters()->findComponent("component")->value();
+    auto created = MyComponent::create();
+    created->setResource(std::static_pointer_cast<MyResource>(input->resource()));
+    auto result = this->createResult(Outcome::SUCCEEDED);
+    result->findComponent("created")->appendValue(created);
+    result->findComponent("modified")->appendValue(input);
+    return result;
+  }
+
+  Specification createSpecification() override
+  {
+    Specification spec = this->createBaseSpecification();
+    auto opDef = spec->createDefinition("CreateOperation", "operation");
+    auto compDef = smtk::attribute::ComponentItemDefinition::New("component");
+    compDef->setLockType(smtk::resource::LockType::Write);
+    opDef->addItemDefinition(compDef);
+    spec->createDefinition("result(CreateOperation)", "result");
+    return spec;
+  }
+};
+} // namespace
+
+int TestAsyncObservers(int /*unused*/, char** const /*unused*/)
+{
+  auto manager = smtk::operation::Manager::create();
+  manager->registerOperation<CreateOperation>();
+  auto& observers = manager->asyncObservers();
+  smtkTest(observers.empty(), "Expected no asynchronous observers.");
+
+  auto resource = MyResource::create();
+  auto component = MyComponent::create();
+  component->setResource(resource);
+
+  // Digests are only built once someone is observing.
+  auto op = manager->create<CreateOperation>();
+  op->parameters()->findComponent("component")->setValue(component);
+  smtkTest(
+    smtk::operation::outcome(op->operate()) == smtk::operation::Operation::Outcome::SUCCEEDED,
+    "Operation failed.");
+
+  std::mutex mutex;
+  std::vector<smtk::operation::AsyncObservers::Batch> batches;
+  bool ranUnlocked = true;
+  std::thread::id dispatchThread;
+  auto key = observers.insert(
+    [&](const smtk::operation::AsyncObservers::Batch& batch) {
+      std::lock_guard<std::mutex> guard(mutex);
+      batches.push_back(batch);
+      ranUnlocked &= resource->locked() == smtk::resource::LockType::Unlocked;
+      dispatchThread = std::this_thread::get_id();
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    },
+    "test observer");
+  smtkTest(!observers.empty(), "Expected an asynchronous observer.");
+
+  // A burst of operations should be delivered as a single batch.
+  observers.setCoalescingInterval(std::chrono::milliseconds(500));
+  constexpr std::size_t numberOfOperations = 8;
+  for (std::size_t ii = 0; ii < numberOfOperations; ++ii)
+  {
+    smtkTest(
+      smtk::operation::outcome(op->operate()) == smtk::operation::Operation::Outcome::SUCCEEDED,
+      "Operation failed.");
+  }
+  observers.flush();
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    smtkTest(batches.size() == 1, "Expected 1 batch, got " << batches.size() << ".");
+    smtkTest(
+      batches[0].size() == numberOfOperations,
+      "Expected " << numberOfOperations << " digests, got " << batches[0].size() << ".");
+    for (const auto& digest : batches[0])
+    {
+      smtkTest(digest->operationType == op->typeToken(), "Digest has the wrong operation type.");
+      smtkTest(
+        digest->outcome == smtk::operation::Operation::Outcome::SUCCEEDED,
+        "Digest has the wrong outcome.");
+      smtkTest(digest->created.size() == 1, "Digest should name 1 created component.");
+      smtkTest(
+        digest->modified.size() == 1 && digest->modified[0] == component->id(),
+        "Digest should name the modified component.");
+    }
+    smtkTest(ranUnlocked, "Observers should run after locks are released.");
+    smtkTest(
+      dispatchThread != std::this_thread::get_id(), "Observers should run on another thread.");
+  }
+
+  auto statistics = observers.statistics();
+  smtkTest(statistics.size() == 1, "Expected statistics for 1 observer.");
+  smtkTest(statistics[0].description == "test observer", "Wrong observer description.");
+  smtkTest(statistics[0].batches == 1, "Expected 1 batch, got " << statistics[0].batches << ".");
+  smtkTest(statistics[0].digests == numberOfOperations, "Wrong number of digests observed.");
+  smtkTest(statistics[0].totalTime >= 5., "Observer time was not recorded.");
+  smtkTest(statistics[0].maxTime <= statistics[0].totalTime, "Inconsistent observer times.");
+
+  // Once its key is reset, an observer is no longer called.
+  key.reset();
+  smtkTest(observers.empty(), "Resetting the key should remove the observer.");
+  op->operate();
+  observers.flush();
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    smtkTest(batches.size() == 1, "A removed observer was called.");
+  }
+
+  return 0;
+}
@@ -187,6 +187,47 @@ ReadOperation::Specification ReadOperation::createSpecification()
   return spec;
 }
 
+// Read the resource through a snapshot rather than a read lock.
+class SnapshotOperation : public ReadOperation
+{
+public:
+  smtkTypeMacro(SnapshotOperation);
+  smtkCreateMacro(SnapshotOperation);
+  smtkSharedFromThisMacro(smtk::operation::Operation);
+
+  SnapshotOperation() = default;
+  ~SnapshotOperation() override = default;
+
+protected:
+  smtk::operation::ResourceAccessMap identifyLocksRequired() override
+  {
+    auto locks = this->ReadOperation::identifyLocksRequired();
+    for (auto& entry : locks)
+    {
+      entry.second = smtk::resource::LockType::Snapshot;
+    }
+    return locks;
+  }
+
+  Result operateInternal() override
+  {
+    auto component =
+      this->parameters()->findAs<smtk::attribute::ComponentItem>("component")->value();
+    auto resource = component->resource();
+    auto snapshot = this->snapshot(resource->id());
+    bool ok = snapshot && snapshot->id() == resource->id() &&
+      resource->locked() != smtk::resource::LockType::Read;
+    return this->createResult(ok ? Outcome::SUCCEEDED : Outcome::FAILED);
+  }
+
+  Specification createSpecification() override
+  {
+    Specification spec = this->ReadOperation::createSpecification();
+    spec->createDefinition("SnapshotOperation", "ReadOperation");
+    return spec;
+  }
+};
+
 class WriteOperation : public smtk::operation::Operation
 {
 public:
@@ -387,6 +428,98 @@ int writeTest(int sleepValue)
   return 0;
 }
 
+int timeoutTest()
+{
+  auto resource = MyResource::create();
+  auto component = MyComponent::create();
+  component->setResource(resource);
+
+  std::cout << "Timeout test" << std::endl;
+
+  smtk::operation::Operation::Ptr writeOperation = WriteOperation::create();
+  writeOperation->parameters()
+    ->findAs<smtk::attribute::ComponentItem>("component")
+    ->setValue(component);
+  writeOperation->setLockTimeout(std::chrono::milliseconds(50));
+
+  // While another party holds the resource's lock, the operation should give
+  // up once its timeout expires rather than wait indefinitely.
+  {
+    smtk::resource::ScopedLockGuard guard(resource->lock({}), smtk::resource::LockType::Read);
+    auto result = writeOperation->operate();
+    smtkTest(
+      smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::UNABLE_TO_OPERATE,
+      "Operation should be unable to operate when its locks time out.");
+  }
+  smtkTest(
+    resource->locked() == smtk::resource::LockType::Unlocked,
+    "Timed-out operation should not hold any locks.");
+
+  // Once the lock is released, the operation should run.
+  auto result = writeOperation->operate();
+  smtkTest(
+    smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::SUCCEEDED,
+    "Operation should succeed once its locks are available.");
+
+  return 0;
+}
+
+int snapshotTest()
+{
+  auto resource = MyResource::create();
+  auto component = MyComponent::create();
+  component->setResource(resource);
+
+  std::cout << "Snapshot test" << std::endl;
+
+  smtk::operation::Operation::Ptr snapshotOperation = SnapshotOperation::create();
+  snapshotOperation->parameters()
+    ->findAs<smtk::attribute::ComponentItem>("component")
+    ->setValue(component);
+  snapshotOperation->setLockTimeout(std::chrono::milliseconds(50));
+
+  auto result = snapshotOperation->operate();
+  smtkTest(
+    smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::SUCCEEDED,
+    "Snapshot operation should succeed.");
+
+  // Operations that read a snapshot do not wait for writers to finish.
+  {
+    smtk::resource::ScopedLockGuard guard(resource->lock({}), smtk::resource::LockType::Write);
+    result = snapshotOperation->operate();
+    smtkTest(
+      smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::SUCCEEDED,
+      "Snapshot operation should run while a writer holds the resource.");
+  }
+  smtkTest(
+    resource->locked() == smtk::resource::LockType::Unlocked,
+    "Snapshot operation should not hold any locks.");
+
+  // Operations that write a resource publish its next snapshot before
+  // releasing their lock, so readers see it even while another writer holds
+  // the lock (when a snapshot cannot be taken).
+  auto before = resource->snapshot();
+  semaphore = false;
+  smtk::operation::Operation::Ptr writeOperation = WriteOperation::create();
+  writeOperation->parameters()
+    ->findAs<smtk::attribute::ComponentItem>("component")
+    ->setValue(component);
+  result = writeOperation->operate();
+  smtkTest(
+    smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::SUCCEEDED,
+    "Write operation should succeed.");
+  {
+    smtk::resource::ScopedLockGuard guard(resource->lock({}), smtk::resource::LockType::Write);
+    auto published = resource->snapshot();
+    smtkTest(published && published != before, "Write operation did not publish a snapshot.");
+    smtkTest(
+      published->version() == resource->version(),
+      "Published snapshot has the wrong version.");
+  }
+
+  return 0;
+}
+
 // Test mutexed operations by executing two parallel read operations and two
 // parallel write operations. Each read operation waits for a global semaphore
 // to hold its value, failing after a timeout period, and then switches the
@@ -411,5 +544,9 @@ int TestMutexedOperation(int /*unused*/, char** const /*unused*/)
 
   smtkTest(returnValue == 0, "Mutexed read test failed.");
 
+  smtkTest(timeoutTest() == 0, "Lock timeout test failed.");
+
+  smtkTest(snapshotTest() == 0, "Snapshot test failed.");
+
   return writeTest(sleepValue);
 }
@@ -0,0 +1,219 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/Definition.h"
+#include "smtk/attribute/Resource.h"
+
+#include "smtk/io/Logger.h"
+
+#include "smtk/operation/Manager.h"
+#include "smtk/operation/Observer.h"
+#include "smtk/operation/Operation.h"
+#include "smtk/operation/Tracer.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+class ChildOperation : public smtk::operation::Operation
+{
+public:
+  smtkTypeMacro(ChildOperation);
+  smtkCreateMacro(ChildOperation);
+  smtkSharedFromThisMacro(smtk::operation::Operation);
+
+  ChildOperation() = default;
+  ~ChildOperation() override = default;
+
+protected:
+  Result operateInternal() override { return this->createResult(Outcome::SUCCEEDED); }
+
+  Specification createSpecification() override
+  {
+    Specification spec = this->createBaseSpecification();
+    spec->createDefinition("ChildOperation", "operation");
+    spec->createDefinition("result(ChildOperation)", "result");
+    return spec;
+  }
+};
+
+// Sleep briefly, then run a nested ChildOperation that has no manager.
+class ParentOperation : public smtk::operation::Operation
+{
+public:
+  smtkTypeMacro(ParentOperation);
+  smtkCreateMacro(ParentOperation);
+  smtkSharedFromThisMacro(smtk::operation::Operation);
+
+  ParentOperation() = default;
+  ~ParentOperation() override = default;
+
+protected:
+  Result operateInternal() override
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    auto child = ChildOperation::create();
+    auto childResult = child->operate(this->childKey());
+    return this->createResult(smtk::operation::outcome(childResult));
+  }
+
+  Specification createSpecification() override
+  {
+    Specification spec = this->createBaseSpecification();
+    spec->createDefinition("ParentOperation", "operation");
+    spec->createDefinition("result(ParentOperation)", "result");
+    return spec;
+  }
+};
+} // namespace
+
+int TestOperationTracing(int /*unused*/, char** const /*unused*/)
+{
+  using smtk::operation::Tracer;
+
+  auto manager = smtk::operation::Manager::create();
+  manager->registerOperation<ParentOperation>();
+  auto& tracer = manager->tracer();
+
+  auto observerKey = manager->observers().insert(
+    [](
+      const smtk::operation::Operation& /*unused*/,
+      smtk::operation::EventType /*unused*/,
+      smtk::operation::Operation::Result /*unused*/) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return 0;
+    },
+    "slow observer");
+
+  auto op = manager->create<ParentOperation>();
+  smtkTest(
+    smtk::operation::outcome(op->operate()) == smtk::operation::Operation::Outcome::SUCCEEDED,
+    "Operation failed.");
+  smtkTest(tracer.events().empty(), "Nothing should be recorded while tracing is disabled.");
+  smtkTest(
+    !manager->observers().monitor(), "Observers should be called directly while not tracing.");
+
+  tracer.setEnabled(true);
+  smtkTest(!!manager->observers().monitor(), "Observers should be monitored while tracing.");
+  constexpr std::size_t numberOfRuns = 3;
+  for (std::size_t ii = 0; ii < numberOfRuns; ++ii)
+  {
+    smtkTest(
+      smtk::operation::outcome(op->operate()) == smtk::operation::Operation::Outcome::SUCCEEDED,
+      "Operation failed.");
+  }
+  tracer.setEnabled(false);
+  smtkTest(
+    !manager->observers().monitor(), "Disabling tracing should stop monitoring observers.");
+
+  // Every phase of the parent operation should have been aggregated.
+  auto parentType = op->typeToken();
+  auto childType = smtk::string::Token(ChildOperation::type_name);
+  for (auto phase : { Tracer::Phase::Operate,
+                      Tracer::Phase::Lock,
+                      Tracer::Phase::AbleToOperate,
+                      Tracer::Phase::WillOperateObservers,
+                      Tracer::Phase::OperateInternal,
+                      Tracer::Phase::MarkModifiedResources,
+                      Tracer::Phase::GenerateSummary,
+                      Tracer::Phase::SerializeLog,
+                      Tracer::Phase::DidOperateObservers,
+                      Tracer::Phase::UnmanageResources })
+  {
+    auto histogram = tracer.histogram(parentType, phase);
+    smtkTest(
+      histogram.count == numberOfRuns,
+      "Expected " << numberOfRuns << " \"" << Tracer::phaseName(phase) << "\" spans, got "
+                  << histogram.count << ".");
+  }
+  auto internal = tracer.histogram(parentType, Tracer::Phase::OperateInternal);
+  smtkTest(internal.minTime >= 2., "operateInternal() should take at least 2 ms.");
+  smtkTest(
+    internal.percentile(0.5) >= internal.minTime && internal.percentile(0.5) <= internal.maxTime,
+    "Percentiles should lie within the observed range.");
+  auto observers = tracer.histogram(parentType, Tracer::Phase::Observer);
+  smtkTest(observers.count == 2 * numberOfRuns, "Expected 2 observer spans per run.");
+  smtkTest(observers.minTime >= 1., "Observer spans should include the observer's time.");
+
+  // The nested operation is traced even though it has no manager, and its
+  // span refers to the parent's span.
+  smtkTest(
+    tracer.histogram(childType, Tracer::Phase::Operate).count == numberOfRuns,
+    "Nested operations should be traced.");
+  std::size_t nested = 0;
+  auto events = tracer.events();
+  for (const auto& child : events)
+  {
+    if (child.phase != Tracer::Phase::Operate || child.operationType != childType)
+    {
+      continue;
+    }
+    for (const auto& parent : events)
+    {
+      if (
+        parent.phase == Tracer::Phase::Operate && parent.operation == child.parent &&
+        parent.operationType == parentType)
+      {
+        smtkTest(
+          parent.start <= child.start &&
+            child.start + child.duration <= parent.start + parent.duration,
+          "A nested operation's span should lie within its parent's.");
+        ++nested;
+      }
+    }
+  }
+  smtkTest(nested == numberOfRuns, "Nested spans should refer to their parent.");
+
+  std::ostringstream trace;
+  tracer.writeTrace(trace);
+  smtkTest(
+    trace.str().find("\"traceEvents\"") != std::string::npos &&
+      trace.str().find("\"slow observer\"") != std::string::npos,
+    "Exported trace is missing events.");
+
+  tracer.clear();
+  smtkTest(tracer.events().empty(), "Clearing the tracer should discard events.");
+  smtkTest(tracer.operationTypes().empty(), "Clearing the tracer should discard histograms.");
+
+  // Events beyond the maximum are counted and reported rather than silently dropped.
+  constexpr std::size_t maximumNumberOfEvents = 4;
+  auto& logger = smtk::io::Logger::instance();
+  std::size_t logStart = logger.numberOfRecords();
+  tracer.setMaximumNumberOfEvents(maximumNumberOfEvents);
+  tracer.setEnabled(true);
+  op->operate();
+  tracer.setEnabled(false);
+  smtkTest(
+    tracer.events().size() == maximumNumberOfEvents, "Expected the number of events to be capped.");
+  smtkTest(tracer.numberOfDroppedEvents() > 0, "Dropped events should be counted.");
+  smtkTest(
+    tracer.histogram(parentType, Tracer::Phase::Operate).count == 1,
+    "Dropped events should still be aggregated.");
+  std::size_t warnings = 0;
+  for (std::size_t ii = logStart; ii < logger.numberOfRecords(); ++ii)
+  {
+    warnings += logger.record(ii).severity == smtk::io::Logger::Warning ? 1 : 0;
+  }
+  smtkTest(warnings == 1, "Expected one warning when events are first dropped, got " << warnings);
+  trace.str("");
+  tracer.writeTrace(trace);
+  smtkTest(
+    trace.str().find("\"droppedEvents\":" + std::to_string(tracer.numberOfDroppedEvents())) !=
+      std::string::npos,
+    "Exported trace should report dropped events.");
+
+  return 0;
+}
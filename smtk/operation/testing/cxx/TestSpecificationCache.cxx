@@ -0,0 +1,154 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/operation/Manager.h"
+#include "smtk/operation/Operation.h"
+#include "smtk/operation/XMLOperation.h"
+#include "smtk/operation/testing/cxx/TrivialOperation.h"
+
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/IntItem.h"
+#include "smtk/attribute/Resource.h"
+
+#include "smtk/io/AttributeWriter.h"
+#include "smtk/io/Logger.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace
+{
+using smtk::test::TrivialOp;
+
+// An operation whose specification may not be copied from its metadata.
+class DynamicOp : public TrivialOp
+{
+public:
+  smtkTypeMacro(DynamicOp);
+  smtkCreateMacro(DynamicOp);
+  smtkSharedFromThisMacro(smtk::operation::Operation);
+
+  bool cacheableSpecification() const override { return false; }
+};
+
+// Create and run \a count managed operations, returning the elapsed time in ms.
+double createAndRun(const smtk::operation::Manager::Ptr& manager, int count)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int ii = 0; ii < count; ++ii)
+  {
+    auto op = manager->create<TrivialOp>();
+    op->parameters()->findInt("value")->setValue(ii);
+    auto result = op->operate();
+    smtkTest(
+      smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::SUCCEEDED,
+      "Operation " << ii << " failed.");
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+    .count();
+}
+} // namespace
+
+// Verify that managed operations start from copies of the specification held
+// by their metadata, then benchmark the creation and execution of many
+// operations with and without copying.
+// Pass "-n <count>" to change the number of operations (e.g., -n 100000).
+int TestSpecificationCache(int argc, char* argv[])
+{
+  int count = 1000;
+  for (int ii = 1; ii < argc; ++ii)
+  {
+    if ((!strcmp(argv[ii], "-n") || !strcmp(argv[ii], "--num-operations")) && ii + 1 < argc)
+    {
+      count = std::stoi(argv[++ii]);
+    }
+  }
+
+  auto manager = smtk::operation::Manager::create();
+  smtkTest(manager->specificationCacheEnabled(), "Copying specifications should be the default.");
+  manager->registerOperation<TrivialOp>();
+  manager->registerOperation<DynamicOp>();
+
+  // Each instance should own a copy of the definitions and its own parameters.
+  {
+    auto metadata = manager->metadata().get<smtk::operation::IndexTag>().find(
+      std::type_index(typeid(TrivialOp)).hash_code());
+    auto op1 = manager->create<TrivialOp>();
+    auto op2 = manager->create<TrivialOp>();
+    smtkTest(
+      op1->specification() != op2->specification() &&
+        op1->specification() != metadata->specification(),
+      "Managed operations should not share a specification.");
+    smtkTest(
+      op1->specification()->findDefinition("trivial op") != nullptr &&
+        op2->specification()->findDefinition("trivial op") != nullptr,
+      "Copied specifications should hold the operation's definitions.");
+    smtkTest(
+      op1->parameters() != op2->parameters(),
+      "Operations should have distinct parameters.");
+    op1->parameters()->findInt("value")->setValue(5);
+    smtkTest(
+      op2->parameters()->findInt("value")->value() == 1,
+      "Parameters of one operation should not affect another.");
+
+    // Restoring a trace replaces the parameters in the operation's own
+    // specification without touching those of other instances.
+    std::string trace;
+    smtk::io::AttributeWriter writer;
+    writer.includeDefinitions(false);
+    writer.writeContents(op1->specification(), trace, smtk::io::Logger::instance());
+    auto op3 = manager->create<TrivialOp>();
+    smtkTest(op3->restoreTrace(trace), "Could not restore a trace.");
+    smtkTest(
+      op3->parameters()->findInt("value")->value() == 5,
+      "The trace should provide the operation's parameters.");
+    std::vector<smtk::attribute::AttributePtr> attributes;
+    op1->specification()->findAttributes("trivial op", attributes);
+    smtkTest(attributes.size() == 1, "Restoring a trace should not affect other operations.");
+    attributes.clear();
+    metadata->specification()->findAttributes("trivial op", attributes);
+    smtkTest(attributes.empty(), "Operations should not create attributes in the template.");
+  }
+
+  // Operations with a run-time specification construct their own.
+  {
+    auto op = manager->create<DynamicOp>();
+    smtkTest(
+      op->specification() != nullptr && op->parameters() != nullptr,
+      "Could not construct a dynamic specification.");
+  }
+
+  // Unregistering an operation discards its template.
+  smtkTest(manager->unregisterOperation<DynamicOp>(), "Could not unregister DynamicOp.");
+  smtkTest(manager->create<DynamicOp>() == nullptr, "DynamicOp should be unregistered.");
+
+  double cached = createAndRun(manager, count);
+  std::cout << "Created and ran " << count << " operations copying specifications in " << cached
+            << " ms\n";
+
+  manager->setSpecificationCacheEnabled(false);
+  {
+    auto op = manager->create<TrivialOp>();
+    smtkTest(
+      op->specification()->findDefinition("trivial op") != nullptr,
+      "Operations should construct their specification when copying is disabled.");
+  }
+
+  double uncached = createAndRun(manager, count);
+  std::cout << "Created and ran " << count << " operations parsing specifications in "
+            << uncached << " ms\n";
+
+  return 0;
+}
@@ -0,0 +1,81 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_operation_testing_cxx_TrivialOperation_h
+#define smtk_operation_testing_cxx_TrivialOperation_h
+
+#include "smtk/operation/Operation.h"
+#include "smtk/operation/XMLOperation.h"
+
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/IntItem.h"
+
+namespace smtk
+{
+namespace test
+{
+
+// An operation that does nothing but succeed when its "value" is non-negative.
+// Tests and benchmarks use it to measure the cost of the operation framework.
+class TrivialOp : public smtk::operation::XMLOperation
+{
+public:
+  smtkTypeMacro(smtk::test::TrivialOp);
+  smtkCreateMacro(TrivialOp);
+  smtkSharedFromThisMacro(smtk::operation::Operation);
+
+  TrivialOp() = default;
+  ~TrivialOp() override = default;
+
+  Result operateInternal() override
+  {
+    auto value = this->parameters()->findInt("value")->value();
+    return this->createResult(value >= 0 ? Outcome::SUCCEEDED : Outcome::FAILED);
+  }
+
+  const char* xmlDescription() const override
+  {
+    return "<?xml version=\"1.0\" encoding=\"utf-8\" ?>"
+           "<SMTK_AttributeSystem Version=\"2\">"
+           "  <Definitions>"
+           "    <AttDef Type=\"operation\" Label=\"operation\" Abstract=\"True\">"
+           "      <ItemDefinitions>"
+           "        <Int Name=\"debug level\" Optional=\"True\">"
+           "          <DefaultValue>0</DefaultValue>"
+           "        </Int>"
+           "      </ItemDefinitions>"
+           "    </AttDef>"
+           "    <AttDef Type=\"result\" Abstract=\"True\">"
+           "      <ItemDefinitions>"
+           "        <Int Name=\"outcome\" Label=\"outcome\" Optional=\"False\""
+           "             NumberOfRequiredValues=\"1\">"
+           "        </Int>"
+           "        <String Name=\"log\" Optional=\"True\" NumberOfRequiredValues=\"0\""
+           "                Extensible=\"True\">"
+           "        </String>"
+           "      </ItemDefinitions>"
+           "    </AttDef>"
+           "    <AttDef Type=\"trivial op\" Label=\"A Trivial Operation\" BaseType=\"operation\">"
+           "      <ItemDefinitions>"
+           "        <Int Name=\"value\" Optional=\"False\">"
+           "          <DefaultValue>1</DefaultValue>"
+           "        </Int>"
+           "      </ItemDefinitions>"
+           "    </AttDef>"
+           "    <AttDef Type=\"result(trivial op)\" BaseType=\"result\">"
+           "    </AttDef>"
+           "  </Definitions>"
+           "</SMTK_AttributeSystem>";
+  }
+};
+
+} // namespace test
+} // namespace smtk
+
+#endif // smtk_operation_testing_cxx_TrivialOperation_h
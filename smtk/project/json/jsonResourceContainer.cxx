@@ -13,7 +13,10 @@
 #include "smtk/attribute/FileItem.h"
 #include "smtk/attribute/ResourceItem.h"
 
+#include "smtk/common/Executor.h"
+
 #include "smtk/resource/Manager.h"
+#include "smtk/resource/json/Helper.h"
 #include "smtk/resource/json/jsonResource.h"
 
 #include "smtk/operation/Helper.h"
@@ -24,6 +27,10 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <future>
+#include <vector>
+
 namespace
 {
 void replaceWindowsSeparators(boost::filesystem::path& path)
@@ -31,6 +38,81 @@ void replaceWindowsSeparators(boost::filesystem::path& path)
   std::string pathString = boost::algorithm::replace_all_copy(path.string(), "\\", "/");
   path = boost::filesystem::path(pathString);
 }
+
+// Read the resources at \a locations with at most \a maximumConcurrentReads
+// in flight at once (or one per executor worker if 0), returning each read's
+// result in the order of \a locations.
+std::vector<smtk::operation::Operation::Result> readConcurrently(
+  const std::vector<std::string>& locations,
+  unsigned int maximumConcurrentReads,
+  const smtk::project::ProjectPtr& project)
+{
+  std::vector<smtk::operation::Operation::Result> results(locations.size());
+
+  // Operations are constructed and configured on this thread; only
+  // operate() is run by the executor.
+  std::vector<smtk::operation::ReadResource::Ptr> readers;
+  readers.reserve(locations.size());
+  for (const auto& location : locations)
+  {
+    auto reader = project->operations().manager()->create<smtk::operation::ReadResource>();
+    if (!reader)
+    {
+      std::cerr << "Could not find ReadResource Operation\n";
+      return results;
+    }
+    reader->parameters()->findAs<smtk::attribute::FileItem>("filename")->setValue(location);
+    readers.push_back(reader);
+  }
+
+  // Helpers are per-thread, so give each worker the same context that
+  // the calling thread provides to serial reads.
+  const auto key = *smtk::operation::Helper::instance().key();
+  auto managers = smtk::resource::json::Helper::instance().managers();
+  auto read = [key, managers, project](const smtk::operation::ReadResource::Ptr& reader) {
+    auto workerKey = key;
+    smtk::operation::Helper::pushInstance(&workerKey);
+    smtk::resource::json::Helper::pushInstance(project).setManagers(managers);
+    smtk::operation::Operation::Result result;
+    try
+    {
+      result = reader->operate(workerKey);
+    }
+    catch (std::exception& e)
+    {
+      std::cerr << "Reading \"" << reader->parameters()->findFile("filename")->value()
+                << "\" threw \"" << e.what() << "\"\n";
+    }
+    smtk::resource::json::Helper::popInstance();
+    smtk::operation::Helper::popInstance();
+    return result;
+  };
+
+  // The reads are file I/O, so they run as background tasks on the workers
+  // SMTK shares for all of its work. Waiting on them through the executor
+  // lets this thread run queued reads rather than block.
+  smtk::common::Executor executor(
+    smtk::common::Executor::instance(), smtk::common::Executor::Priority::Background);
+  if (maximumConcurrentReads == 0)
+  {
+    maximumConcurrentReads = executor.numberOfThreads();
+  }
+  std::vector<std::future<smtk::operation::Operation::Result>> futures(readers.size());
+  for (std::size_t ii = 0; ii < readers.size(); ++ii)
+  {
+    if (ii >= maximumConcurrentReads)
+    {
+      executor.wait(futures[ii - maximumConcurrentReads]);
+    }
+    futures[ii] = executor(read, readers[ii]);
+  }
+  for (std::size_t ii = 0; ii < futures.size(); ++ii)
+  {
+    executor.wait(futures[ii]);
+    results[ii] = futures[ii].get();
+  }
+  return results;
+}
 } // namespace
 
 namespace smtk
@@ -68,18 +150,11 @@ void from_json(const json& j, ResourceContainer& resourceContainer, const Projec
     return;
   }
 
-  auto reader = project->operations().manager()->create<smtk::operation::ReadResource>();
-
-  if (!reader)
-  {
-    std::cerr << "Could not find ReadResource Operation\n";
-    return;
-  }
   // get the base path of the project
   std::string projectPath = project->location();
   boost::filesystem::path parentPath = boost::filesystem::path(projectPath).parent_path();
-  smtk::resource::ResourcePtr resource;
 
+  std::vector<std::string> locations;
   for (json::const_iterator it = j["resources"].begin(); it != j["resources"].end(); ++it)
   {
     std::string location = it->at("location").get<std::string>();
@@ -89,19 +164,48 @@ void from_json(const json& j, ResourceContainer& resourceContainer, const Projec
       locationPath = boost::filesystem::absolute(locationPath, parentPath);
     }
     replaceWindowsSeparators(locationPath);
+    locations.push_back(locationPath.string());
+  }
 
-    reader->parameters()
-      ->findAs<smtk::attribute::FileItem>("filename")
-      ->setValue(locationPath.string());
-    auto result = reader->operate(*smtk::operation::Helper::instance().key());
-    if (smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::SUCCEEDED)
+  auto& operationHelper = smtk::operation::Helper::instance();
+  std::vector<smtk::operation::Operation::Result> results;
+  if (operationHelper.numberOfThreads() != 1 && locations.size() > 1)
+  {
+    results = readConcurrently(locations, operationHelper.numberOfThreads(), project);
+  }
+  else
+  {
+    auto reader = project->operations().manager()->create<smtk::operation::ReadResource>();
+    if (!reader)
+    {
+      std::cerr << "Could not find ReadResource Operation\n";
+      return;
+    }
+    for (const auto& location : locations)
+    {
+      reader->parameters()->findAs<smtk::attribute::FileItem>("filename")->setValue(location);
+      results.push_back(reader->operate(*operationHelper.key()));
+    }
+  }
+
+  // Add resources to the project in the order they were serialized,
+  // regardless of the order in which they finished reading. The operation
+  // reading the project merges each read's result into its own.
+  for (const auto& result : results)
+  {
+    operationHelper.childResults().push_back(result);
+    smtk::resource::ResourcePtr resource;
+    if (
+      result &&
+      smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::SUCCEEDED)
     {
       resource = result->findAs<smtk::attribute::ResourceItem>("resourcesCreated")->value();
     }
     else
     {
       std::cerr << "ReadResource Operation did not succeed - outcome was: "
-                << static_cast<int>(smtk::operation::outcome(result)) << std::endl;
+                << (result ? static_cast<int>(smtk::operation::outcome(result)) : -1)
+                << std::endl;
     }
     if (!resource)
     {
@@ -49,6 +49,7 @@ SMTK_THIRDPARTY_POST_INCLUDE
 
 #include <fstream>
 #include <string>
+#include <vector>
 
 namespace smtk
 {
@@ -121,7 +122,13 @@ Read::Result Read::operateInternal()
   // Add a key to the operation helper so that the ResourceContainer de-serialization code can
   // internally call Resource Read Operations.
   auto key = this->childKey(ObserverOption::SkipObservers, LockOption::SkipLocks);
-  smtk::operation::Helper::pushInstance(&key);
+  auto& operationHelper = smtk::operation::Helper::pushInstance(&key);
+  auto threadsItem = this->parameters()->findInt("threads");
+  if (threadsItem && threadsItem->isEnabled())
+  {
+    // Read the project's resources concurrently.
+    operationHelper.setNumberOfThreads(static_cast<unsigned int>(threadsItem->value()));
+  }
   resourceHelper.setManagers(this->managers());
   auto& taskHelper =
     smtk::task::json::Helper::pushInstance(project->taskManager(), this->managers());
@@ -130,6 +137,7 @@ Read::Result Read::operateInternal()
   //project = j;
   smtk::project::from_json(j, project);
   smtk::task::Task* taskToActivate = taskHelper.activeSerializedTask();
+  std::vector<Result> readResults = std::move(operationHelper.childResults());
 
   smtk::task::json::Helper::popInstance();
   smtk::resource::json::Helper::popInstance();
@@ -147,6 +155,13 @@ Read::Result Read::operateInternal()
       createdProject->setValue(rr++, rsrc);
     }
 
+    // Fold in the results of reading each resource; the read fails if any of
+    // the project's resources could not be read.
+    for (const auto& readResult : readResults)
+    {
+      smtk::operation::mergeResult(result, readResult);
+    }
+
     // Indicate what worklets were read.
     auto createdComponents = result->findComponent("created");
     project->taskManager().taskInstances().visit(
@@ -21,6 +21,8 @@
 #include "smtk/attribute/StringItem.h"
 #include "smtk/attribute/StringItemDefinition.h"
 
+#include "smtk/common/Executor.h"
+
 #include "smtk/io/Logger.h"
 
 #include "smtk/operation/operators/WriteResource.h"
@@ -36,8 +38,11 @@
 
 #include "smtk/project/operators/Write_xml.h"
 
+#include <algorithm>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <vector>
 
 SMTK_THIRDPARTY_PRE_INCLUDE
 #include "boost/filesystem.hpp"
@@ -66,15 +71,6 @@ Write::Result Write::operateInternal()
   boost::filesystem::path projectFolderPath = outputFilePath.parent_path();
   boost::filesystem::path resourcesFolderPath = projectFolderPath / "resources";
 
-  // Construct a WriteResource operation to write all of the project's resources.
-  smtk::operation::WriteResource::Ptr write =
-    project->operations().manager()->create<smtk::operation::WriteResource>();
-  if (!write)
-  {
-    smtkErrorMacro(this->log(), "Cannot create WriteResource operation.");
-    return this->createResult(smtk::operation::Operation::Outcome::FAILED);
-  }
-
   // Create project and project/resources folders if needed
   if (!boost::filesystem::exists(resourcesFolderPath))
   {
@@ -93,32 +89,58 @@ Write::Result Write::operateInternal()
     return this->createResult(smtk::operation::Operation::Outcome::FAILED);
   }
 
-  // Write the modified resources.
+  // Assign locations to (and gather) the modified resources.
+  std::vector<smtk::resource::ResourcePtr> modified;
   for (const auto& resource : project->resources())
   {
-    const std::string& role = detail::role(resource);
+    if (resource->clean())
+    {
+      continue;
+    }
+    if (resource->location().empty())
+    {
+      const std::string& role = detail::role(resource);
+      std::string filename = role + "-" + resource->id().toString() + ".smtk";
+      boost::filesystem::path location = resourcesFolderPath / filename;
+      resource->setLocation(location.string());
+    }
+    modified.push_back(resource);
+  }
 
-    if (!resource->clean())
+  // Write the modified resources, gathering the results of each write into
+  // our own.
+  auto result = this->createResult(smtk::operation::Operation::Outcome::SUCCEEDED);
+  auto threadsItem = this->parameters()->findInt("threads");
+  if (threadsItem && threadsItem->isEnabled() && threadsItem->value() != 1 && modified.size() > 1)
+  {
+    if (!this->writeConcurrently(
+          modified, static_cast<unsigned int>(std::max(threadsItem->value(), 0)), result))
+    {
+      return result;
+    }
+  }
+  else
+  {
+    // Construct a WriteResource operation to write all of the project's resources.
+    smtk::operation::WriteResource::Ptr write =
+      project->operations().manager()->create<smtk::operation::WriteResource>();
+    if (!write)
+    {
+      smtkErrorMacro(this->log(), "Cannot create WriteResource operation.");
+      return this->createResult(smtk::operation::Operation::Outcome::FAILED);
+    }
+
+    for (const auto& resource : modified)
     {
       // Reset the write operation's associations.
       write->parameters()->associations()->reset();
-
-      if (resource->location().empty())
-      {
-        std::string filename = role + "-" + resource->id().toString() + ".smtk";
-        boost::filesystem::path location = resourcesFolderPath / filename;
-        resource->setLocation(location.string());
-      }
-
       write->parameters()->associate(resource);
       smtk::operation::Operation::Result writeResult =
         write->operate(this->childKey(ObserverOption::InvokeObservers));
-      if (
-        writeResult->findInt("outcome")->value() !=
-        static_cast<int>(smtk::operation::Operation::Outcome::SUCCEEDED))
+      if (!smtk::operation::mergeResult(result, writeResult))
       {
         // An error message should already enter the logger from the local operation.
-        return this->createResult(smtk::operation::Operation::Outcome::FAILED);
+        return result;
       }
     }
   }
@@ -135,7 +157,8 @@ Write::Result Write::operateInternal()
     if (j.is_null())
     {
       smtkErrorMacro(log(), "Unable to serialize project to json object.");
-      return this->createResult(smtk::operation::Operation::Outcome::FAILED);
+      smtk::operation::setOutcome(result, smtk::operation::Operation::Outcome::FAILED);
+      return result;
     }
 
     // Save the JSON configurations of all the UI Elements in the
@@ -168,11 +191,98 @@ Write::Result Write::operateInternal()
   // Reset the project's clean flag
   project->setClean(true);
 
-  // Construct a result object.
-  auto result = this->createResult(smtk::operation::Operation::Outcome::SUCCEEDED);
   return result;
 }
 
+bool Write::writeConcurrently(
+  const std::vector<smtk::resource::ResourcePtr>& resources,
+  unsigned int maximumConcurrentWrites,
+  Result& result)
+{
+  auto project = this->parameters()->associations()->valueAs<smtk::project::Project>();
+  auto operationManager = project->operations().manager();
+
+  // Operations are constructed and configured on this thread; only
+  // operate() is run by the executor. Each resource is locked by its own
+  // WriteResource operation, so the writes do not contend with one another.
+  // Observers are not thread-safe, so the nested writes skip them.
+  std::vector<smtk::operation::WriteResource::Ptr> writers;
+  writers.reserve(resources.size());
+  for (const auto& resource : resources)
+  {
+    auto write = operationManager->create<smtk::operation::WriteResource>();
+    if (!write)
+    {
+      smtkErrorMacro(this->log(), "Cannot create WriteResource operation.");
+      smtk::operation::setOutcome(result, smtk::operation::Operation::Outcome::FAILED);
+      return false;
+    }
+    write->parameters()->associate(resource);
+    writers.push_back(write);
+  }
+
+  // The writes are file I/O, so they run as background tasks on the workers
+  // SMTK shares for all of its work. Waiting on them through the executor
+  // lets this thread run queued writes rather than block (even when it is
+  // itself a worker).
+  smtk::common::Executor executor(
+    smtk::common::Executor::instance(), smtk::common::Executor::Priority::Background);
+  if (maximumConcurrentWrites == 0)
+  {
+    maximumConcurrentWrites = executor.numberOfThreads();
+  }
+  const auto key = this->childKey(ObserverOption::SkipObservers);
+  std::vector<std::future<smtk::operation::Operation::Result>> futures(writers.size());
+  for (std::size_t ii = 0; ii < writers.size(); ++ii)
+  {
+    if (ii >= maximumConcurrentWrites)
+    {
+      executor.wait(futures[ii - maximumConcurrentWrites]);
+    }
+    const auto& write = writers[ii];
+    futures[ii] = executor([write, &key]() { return write->operate(key); });
+  }
+
+  // Wait for every write to finish (even after a failure) so that no
+  // resource is left half-written when the project file is written.
+  for (auto& future : futures)
+  {
+    executor.wait(future);
+  }
+
+  // Log messages from the nested writes are already in the shared logger
+  // (and thus will be serialized into our result); merge each write's result
+  // into ours and report each failure by name, in the project's order.
+  bool ok = true;
+  for (std::size_t ii = 0; ii < futures.size(); ++ii)
+  {
+    smtk::operation::Operation::Result writeResult;
+    try
+    {
+      writeResult = futures[ii].get();
+    }
+    catch (std::exception& e)
+    {
+      smtkErrorMacro(this->log(), "Caught exception \"" << e.what() << "\".");
+    }
+    if (!smtk::operation::mergeResult(result, writeResult))
+    {
+      smtkErrorMacro(
+        this->log(),
+        "Failed to write resource \"" << resources[ii]->name() << "\" to \""
+                                       << resources[ii]->location() << "\".");
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+void Write::markModifiedResources(Result& /*unused*/)
+{
+  // Writing does not modify resources. The resources our nested writes report
+  // have been written, so they must not be marked modified.
+}
+
 void Write::generateSummary(Operation::Result& res)
 {
   if (smtk::operation::outcome(res) != Outcome::SUCCEEDED)
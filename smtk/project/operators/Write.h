@@ -13,6 +13,8 @@
 
 #include "smtk/project/Operation.h"
 
+#include <vector>
+
 namespace smtk
 {
 namespace project
@@ -24,6 +26,12 @@ namespace project
   with its resources. Because the project itself is an SMTK resource,
   it uses the standard .smtk extension. Resources contained by the
   project are written to a "resources" subdirectory.
+
+  When the optional "threads" item is enabled, modified resources are
+  written concurrently by the shared smtk::common::Executor. In either
+  case, the results of the nested writes are merged into this operation's
+  result, and the project's .smtk file is written only after every
+  resource has been written successfully.
   */
 class SMTKCORE_EXPORT Write : public smtk::project::Operation
 {
@@ -34,8 +42,19 @@ public:
 
 protected:
   Result operateInternal() override;
+  void markModifiedResources(Result& result) override;
   void generateSummary(Operation::Result& res) override;
   const char* xmlDescription() const override;
+
+  /// Write \a resources concurrently, with at most \a maximumConcurrentWrites
+  /// in flight at once (or one per executor worker if 0), merging the result
+  /// of each write into \a result.
+  ///
+  /// Returns true when every resource was written.
+  bool writeConcurrently(
+    const std::vector<smtk::resource::ResourcePtr>& resources,
+    unsigned int maximumConcurrentWrites,
+    Result& result);
 };
 
 SMTKCORE_EXPORT bool write(
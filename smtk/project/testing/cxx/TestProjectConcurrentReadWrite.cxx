@@ -0,0 +1,184 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/Definition.h"
+#include "smtk/attribute/FileItem.h"
+#include "smtk/attribute/IntItem.h"
+#include "smtk/attribute/Registrar.h"
+#include "smtk/attribute/Resource.h"
+#include "smtk/attribute/ResourceItem.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include "smtk/io/Logger.h"
+
+#include "smtk/operation/Manager.h"
+#include "smtk/operation/Registrar.h"
+
+#include "smtk/plugin/Registry.h"
+
+#include "smtk/project/Manager.h"
+#include "smtk/project/Project.h"
+#include "smtk/project/Registrar.h"
+#include "smtk/project/operators/Read.h"
+#include "smtk/project/operators/Write.h"
+
+#include "smtk/resource/Manager.h"
+
+#include <boost/filesystem.hpp>
+
+#include <map>
+#include <string>
+
+// This test verifies that a project's resources can be written and read
+// concurrently, and that the project file is written after its resources.
+
+namespace
+{
+std::string write_root = SMTK_SCRATCH_DIR;
+
+void cleanup(const std::string& location)
+{
+  ::boost::filesystem::path path(location);
+  if (::boost::filesystem::exists(path))
+  {
+    ::boost::filesystem::remove_all(path);
+  }
+}
+} // namespace
+
+int TestProjectConcurrentReadWrite(int /*unused*/, char** const /*unused*/)
+{
+  std::string projectDirectory = write_root + "/TestProjectConcurrentReadWrite";
+  cleanup(projectDirectory);
+  std::string projectLocation = projectDirectory + "/concurrent.smtk";
+
+  smtk::resource::Manager::Ptr resourceManager = smtk::resource::Manager::create();
+  smtk::operation::Manager::Ptr operationManager = smtk::operation::Manager::create();
+
+  auto managers = smtk::common::Managers::create();
+  managers->insertOrAssign(resourceManager);
+  managers->insertOrAssign(operationManager);
+  operationManager->registerResourceManager(resourceManager);
+  operationManager->setManagers(managers);
+
+  smtk::project::ManagerPtr projectManager =
+    smtk::project::Manager::create(resourceManager, operationManager);
+
+  auto attributeRegistry =
+    smtk::plugin::addToManagers<smtk::attribute::Registrar>(resourceManager, operationManager);
+  auto operationRegistry =
+    smtk::plugin::addToManagers<smtk::operation::Registrar>(operationManager);
+  auto projectRegistry =
+    smtk::plugin::addToManagers<smtk::project::Registrar>(resourceManager, projectManager);
+  projectManager->registerProject("foo");
+
+  // Create a project holding several attribute resources and write it
+  // using a pool of threads.
+  constexpr int numberOfResources = 8;
+  std::map<smtk::common::UUID, std::string> expected;
+  std::string missing;
+  {
+    auto project = projectManager->create("foo");
+    smtkTest(!!project, "Failed to create a project.");
+    projectManager->add(project);
+    project->setLocation(projectLocation);
+
+    for (int ii = 0; ii < numberOfResources; ++ii)
+    {
+      auto attResource = smtk::attribute::Resource::create();
+      std::string name = "attributes " + std::to_string(ii);
+      attResource->setName(name);
+      auto definition = attResource->createDefinition("Def" + std::to_string(ii));
+      attResource->createAttribute(definition);
+      smtkTest(
+        project->resources().add(attResource, "role " + std::to_string(ii)),
+        "Failed to add resource " << ii << " to the project.");
+      expected[attResource->id()] = name;
+    }
+
+    auto writeOp = operationManager->create<smtk::project::Write>();
+    smtkTest(!!writeOp, "No project write operation.");
+    writeOp->parameters()->associate(project);
+    writeOp->parameters()->findInt("threads")->setIsEnabled(true);
+    writeOp->parameters()->findInt("threads")->setValue(4);
+    auto writeResult = writeOp->operate();
+    smtkTest(
+      smtk::operation::outcome(writeResult) == smtk::operation::Operation::Outcome::SUCCEEDED,
+      "Concurrent write failed:\n"
+        << smtk::io::Logger::instance().convertToString());
+
+    // Every resource is written (and marked clean) before the project file.
+    auto projectTime = boost::filesystem::last_write_time(projectLocation);
+    for (const auto& resource : project->resources())
+    {
+      smtkTest(resource->clean(), "Resource \"" << resource->name() << "\" was not written.");
+      smtkTest(
+        boost::filesystem::exists(resource->location()) &&
+          boost::filesystem::last_write_time(resource->location()) <= projectTime,
+        "Resource \"" << resource->name() << "\" was written after the project.");
+    }
+    projectManager->remove(project);
+  }
+
+  // Read the project back, again using a pool of threads.
+  {
+    auto readOp = operationManager->create<smtk::project::Read>();
+    smtkTest(!!readOp, "No project read operation.");
+    readOp->parameters()->findFile("filename")->setValue(projectLocation);
+    readOp->parameters()->findInt("threads")->setIsEnabled(true);
+    readOp->parameters()->findInt("threads")->setValue(3);
+    auto readResult = readOp->operate();
+    smtkTest(
+      smtk::operation::outcome(readResult) == smtk::operation::Operation::Outcome::SUCCEEDED,
+      "Concurrent read failed:\n"
+        << smtk::io::Logger::instance().convertToString());
+
+    auto project = readResult->findResource("resourcesCreated")->valueAs<smtk::project::Project>();
+    smtkTest(!!project, "Read did not produce a project.");
+    smtkTest(
+      project->resources().size() == expected.size(),
+      "Expected " << expected.size() << " resources, found " << project->resources().size()
+                  << ".");
+    for (const auto& entry : expected)
+    {
+      auto attResource = project->resources().get<smtk::attribute::Resource>(entry.first);
+      smtkTest(!!attResource, "Resource \"" << entry.second << "\" was not read.");
+      smtkTest(attResource->name() == entry.second, "Resource was read with the wrong name.");
+      smtkTest(attResource->clean(), "Resource \"" << entry.second << "\" is marked modified.");
+      std::vector<smtk::attribute::AttributePtr> attributes;
+      attResource->attributes(attributes);
+      smtkTest(attributes.size() == 1, "Resource \"" << entry.second << "\" lost its attribute.");
+    }
+
+    // Remove one resource's file so that it cannot be read next time.
+    missing =
+      project->resources().get<smtk::attribute::Resource>(expected.begin()->first)->location();
+    projectManager->remove(project);
+  }
+
+  // A resource that fails to be read causes the project read to fail.
+  {
+    boost::filesystem::remove(missing);
+    auto readOp = operationManager->create<smtk::project::Read>();
+    readOp->parameters()->findFile("filename")->setValue(projectLocation);
+    readOp->parameters()->findInt("threads")->setIsEnabled(true);
+    readOp->parameters()->findInt("threads")->setValue(0);
+    auto readResult = readOp->operate();
+    smtkTest(
+      smtk::operation::outcome(readResult) == smtk::operation::Operation::Outcome::FAILED,
+      "Reading a project with a missing resource should fail.");
+  }
+
+  cleanup(projectDirectory);
+
+  return 0;
+}
@@ -28,9 +28,11 @@ class Resource;
 
 namespace detail
 {
+/// Component links hold no data beyond their ids and role. This base is
+/// deliberately not polymorphic so that each link does not carry a vtable
+/// pointer.
 struct SMTKCORE_EXPORT ComponentLinkBase
 {
-  virtual ~ComponentLinkBase() = default;
 };
 
 /// The ComponentLinks class is a component-specific API for manipulating
@@ -140,7 +140,7 @@ bool Links::isLinkedTo(
   // All resource links held by a resource have a lhs = the containing resource.
   // We therefore only need to find the resource link with a rhs = the input
   // parameter resource.
-  auto resourceRange = resourceLinks.equal_range(rhs1);
+  auto resourceRange = resourceLinks.equal_range(std::make_tuple(rhs1, topLevelRole()));
 
   // If the range of resources is empty, then there is no link.
   if (resourceRange.first == resourceRange.second)
@@ -176,7 +176,7 @@ Links::Key Links::addLinkTo(
   // All resource links held by a resource have a lhs = the containing resource.
   // We therefore only need to find the resource link with a rhs = the input
   // parameter resource.
-  auto resourceRange = resourceLinks.equal_range(rhs1->id());
+  auto resourceRange = resourceLinks.equal_range(std::make_tuple(rhs1->id(), topLevelRole()));
 
   Component::Links::Data* componentLinkData;
 
@@ -201,7 +201,7 @@ Links::Key Links::addLinkTo(
     resourceLinkData.insert(
       ResourceLinkData::LinkBase(rhs1), resourceLinkId, lhs1->id(), rhs1->id(), topLevelRole());
     componentLinkData = &resourceLinkData.value(resourceLinkId);
-    resourceRange = resourceLinks.equal_range(rhs1->id());
+    resourceRange = resourceLinks.equal_range(std::make_tuple(rhs1->id(), topLevelRole()));
   }
   else
   {
@@ -286,7 +286,7 @@ PersistentObjectSet Links::linkedFrom(
   // All resource links held by a resource have a lhs = the containing resource.
   // We therefore only need to find the resource link with a rhs = the input
   // parameter resource.
-  auto resourceRange = resourceLinks.equal_range(rhs1->id());
+  auto resourceRange = resourceLinks.equal_range(std::make_tuple(rhs1->id(), topLevelRole()));
 
   // If the range of resources is empty, then there is no link.
   if (resourceRange.first == resourceRange.second)
@@ -380,7 +380,7 @@ bool Links::removeLinksTo(
   // All resource links held by a resource have a lhs = the containing resource.
   // We therefore only need to find the resource link with a rhs = the input
   // parameter resource.
-  auto resourceRange = resourceLinks.equal_range(rhs1);
+  auto resourceRange = resourceLinks.equal_range(std::make_tuple(rhs1, topLevelRole()));
 
   // If the range of resources is empty, then there is no link.
   if (resourceRange.first == resourceRange.second)
@@ -42,16 +42,19 @@ void Lock::lock(LockType lockType)
     // Lock the resource.
     std::unique_lock<std::mutex> lk(m_mutex);
 
-    // Declare yourself as a waiting writier.
+    // Declare yourself as a waiting writer and take a place in line.
     ++m_waitingWriters;
+    const std::size_t ticket = m_nextWriterTicket++;
+    m_writerQueue.push_back(ticket);
 
-    // Wait for active readers and active writers to finish.
-    while (m_activeReaders != 0 || m_activeWriters != 0)
+    // Wait for your turn and for active readers and active writers to finish.
+    while (m_writerQueue.front() != ticket || m_activeReaders != 0 || m_activeWriters != 0)
     {
       m_writerCondition.wait(lk);
     }
 
     // Declare yourself as an active writer.
+    m_writerQueue.pop_front();
     ++m_activeWriters;
 
     // Unlock the resource.
@@ -77,7 +80,8 @@ bool Lock::tryLock(LockType lockType)
   }
   else if (lockType == LockType::Write)
   {
-    if (m_activeReaders != 0 || m_activeWriters != 0)
+    // Do not jump ahead of writers who are already waiting.
+    if (m_activeReaders != 0 || m_activeWriters != 0 || !m_writerQueue.empty())
     {
       lk.unlock();
       return false;
@@ -94,6 +98,59 @@ bool Lock::tryLock(LockType lockType)
   return false;
 }
 
+bool Lock::tryLockFor(LockType lockType, const std::chrono::milliseconds& timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  if (lockType == LockType::Read)
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    if (!m_readerCondition.wait_until(lk, deadline, [this]() { return m_waitingWriters == 0; }))
+    {
+      return false;
+    }
+    ++m_activeReaders;
+    return true;
+  }
+  else if (lockType == LockType::Write)
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    ++m_waitingWriters;
+    const std::size_t ticket = m_nextWriterTicket++;
+    m_writerQueue.push_back(ticket);
+
+    bool acquired = m_writerCondition.wait_until(lk, deadline, [this, ticket]() {
+      return m_writerQueue.front() == ticket && m_activeReaders == 0 && m_activeWriters == 0;
+    });
+    if (acquired)
+    {
+      m_writerQueue.pop_front();
+      ++m_activeWriters;
+      return true;
+    }
+
+    // Give up our place in line. The writer behind us (or any blocked
+    // readers, if we were the last waiting writer) may now proceed.
+    for (auto it = m_writerQueue.begin(); it != m_writerQueue.end(); ++it)
+    {
+      if (*it == ticket)
+      {
+        m_writerQueue.erase(it);
+        break;
+      }
+    }
+    --m_waitingWriters;
+    bool noWriters = m_waitingWriters == 0;
+    lk.unlock();
+    if (noWriters)
+    {
+      m_readerCondition.notify_all();
+    }
+    m_writerCondition.notify_all();
+    return false;
+  }
+  return false;
+}
+
 void Lock::unlock(LockType lockType)
 {
   if (lockType == LockType::Read)
@@ -103,12 +160,16 @@ void Lock::unlock(LockType lockType)
 
     // Remove yourself as an active reader.
     --m_activeReaders;
+    bool lastReader = m_activeReaders == 0;
 
     // Unlock the resource.
     lk.unlock();
 
-    // Tell one of the waiting writers to check if it can write.
-    m_writerCondition.notify_one();
+    // Tell the waiting writers to check if it is their turn to write.
+    if (lastReader)
+    {
+      m_writerCondition.notify_all();
+    }
   }
   else if (lockType == LockType::Write)
   {
@@ -121,11 +182,15 @@ void Lock::unlock(LockType lockType)
     // Remove yourself as an active writer.
     --m_activeWriters;
 
+    // Publish a new version of the resource.
+    ++m_generation;
+
     if (m_waitingWriters > 0)
     {
-      // If there are writers waiting to write, tell one of them to check if it
-      // can write.
-      m_writerCondition.notify_one();
+      // If there are writers waiting to write, tell them to check whether
+      // it is their turn to write. Only the writer at the head of the
+      // queue will proceed.
+      m_writerCondition.notify_all();
     }
     else
     {
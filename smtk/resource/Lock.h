@@ -13,7 +13,12 @@
 
 #include "smtk/CoreExports.h"
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -31,6 +36,7 @@ enum class LockType
 {
   DoNotLock = 0,
   Unlocked = 0,
+  Snapshot, //!< Read an immutable snapshot of the resource without locking it.
   Read,
   Write,
 };
@@ -39,6 +45,9 @@ enum class LockType
 /// readers in favor of writers. This is not necessarily bad; it means that
 /// writers are given priority over readers when there are multiple readers and
 /// writers simultaneously attempting to access the resource.
+///
+/// Writers are served in the order they began waiting (first-in, first-out)
+/// so that a steady stream of writers cannot starve any one of them.
 class Lock
 {
 public:
@@ -46,12 +55,25 @@ public:
   Lock(const Lock&) = delete;
   Lock& operator=(const Lock&) = delete;
 
+  /// Block until the lock is acquired.
   SMTKCORE_EXPORT void lock(LockType);
+  /// Acquire the lock only if it is immediately available.
   SMTKCORE_EXPORT bool tryLock(LockType);
+  /// Block until the lock is acquired or the \a timeout expires.
+  ///
+  /// Returns true if the lock was acquired and false otherwise.
+  /// A writer that times out gives up its place in the queue of waiting writers.
+  SMTKCORE_EXPORT bool tryLockFor(LockType, const std::chrono::milliseconds& timeout);
   SMTKCORE_EXPORT void unlock(LockType);
 
   SMTKCORE_EXPORT LockType state() const;
 
+  /// Return the number of times a write lock has been released.
+  ///
+  /// Each release may publish modifications, so this serves as the version
+  /// number of the data the lock guards.
+  std::uint64_t generation() const { return m_generation.load(); }
+
 private:
   std::mutex m_mutex;
   std::condition_variable m_readerCondition;
@@ -59,6 +81,10 @@ private:
   std::size_t m_activeReaders{ 0 };
   std::size_t m_waitingWriters{ 0 };
   std::size_t m_activeWriters{ 0 };
+  // Tickets of writers waiting to acquire the lock, in arrival order.
+  std::deque<std::size_t> m_writerQueue;
+  std::size_t m_nextWriterTicket{ 0 };
+  std::atomic<std::uint64_t> m_generation{ 0 };
 };
 
 /// A scope-guarded utility for handling locks.
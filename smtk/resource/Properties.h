@@ -21,8 +21,13 @@
 
 #include "smtk/resource/json/jsonPropertyCoordinateFrame.h"
 #include "smtk/resource/properties/CoordinateFrame.h"
+#include "smtk/resource/properties/ValueIndex.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 
 namespace smtk
 {
@@ -74,6 +79,32 @@ public:
   /// Insert (into \a ids) all of the UUIDs for which \a propName is defined.
   virtual void idsWithProperty(smtk::string::Token& propName, std::set<smtk::common::UUID>& ids)
     const = 0;
+
+  /// Return a counter that changes whenever properties of this type may have been modified.
+  virtual std::uint64_t revision() const = 0;
+  /// Return an immutable copy of all the properties held by this object.
+  ///
+  /// The copy is a FrozenProperties of this object's value type; a null
+  /// pointer is returned when properties of this type are not copyable.
+  /// The values of each property name that has not been modified since
+  /// \a previous (an earlier copy of this object) was made are shared with
+  /// it rather than copied again.
+  virtual std::shared_ptr<const void> freeze(const std::shared_ptr<const void>& previous) const = 0;
+};
+
+/// An immutable copy of the properties of a single \a Type, as produced by
+/// PropertiesBase::freeze(). Values are held one property name at a time so
+/// that successive copies may share the names that were not modified.
+template<typename Type>
+struct FrozenProperties
+{
+  struct Values
+  {
+    std::uint64_t revision;
+    std::shared_ptr<const std::unordered_map<smtk::common::UUID, Type>> values;
+  };
+
+  std::unordered_map<std::string, Values> names;
 };
 
 template<typename Type>
@@ -182,14 +213,65 @@ class PropertiesOfType<std::unordered_map<smtk::common::UUID, Type>>
     }
   };
 
+  struct Freezer
+  {
+    template<typename PropType = Type>
+    typename std::enable_if<
+      !std::is_copy_constructible<PropType>::value,
+      std::shared_ptr<const void>>::type
+    operator()(const SelfType* self, const std::shared_ptr<const void>& previous) const
+    {
+      (void)self;
+      (void)previous;
+      return nullptr;
+    }
+
+    template<typename PropType = Type>
+    typename std::enable_if<
+      std::is_copy_constructible<PropType>::value,
+      std::shared_ptr<const void>>::type
+    operator()(const SelfType* self, const std::shared_ptr<const void>& previous) const
+    {
+      using Frozen = FrozenProperties<PropType>;
+      auto prior = std::static_pointer_cast<const Frozen>(previous);
+      auto result = std::make_shared<Frozen>();
+      result->names.reserve(self->data().size());
+      for (const auto& entry : self->data())
+      {
+        std::uint64_t revision = self->revisionOf(entry.first);
+        if (prior)
+        {
+          auto it = prior->names.find(entry.first);
+          if (it != prior->names.end() && it->second.revision == revision)
+          {
+            result->names.emplace(entry.first, it->second);
+            continue;
+          }
+        }
+        result->names.emplace(
+          entry.first,
+          typename Frozen::Values{
+            revision,
+            std::make_shared<const std::unordered_map<smtk::common::UUID, PropType>>(
+              entry.second) });
+      }
+      return result;
+    }
+  };
+
 public:
+  using ValueIndex = smtk::resource::properties::ValueIndex<Type>;
+
   std::size_t eraseId(const smtk::common::UUID& id) override
   {
+    // Remove the values from indexes while they can still be looked up.
+    this->eraseFromIndexes(id);
     std::size_t count = 0;
     for (auto& pair : this->data())
     {
       count += pair.second.erase(id);
     }
+    this->modifiedAll();
     return count;
   }
 
@@ -201,7 +283,157 @@ public:
     const smtk::common::UUID& otherId,
     const smtk::common::UUID& uid) override
   {
-    return Copier()(this, otherBase, propertyName, otherId, uid);
+    // Values copied to uid may replace indexed values.
+    if (m_indexCount > 0)
+    {
+      std::lock_guard<std::mutex> guard(m_indexMutex);
+      for (auto& entry : m_indexes)
+      {
+        entry.second.touch(uid, this->valueOf(entry.first, uid));
+      }
+    }
+    std::size_t count = Copier()(this, otherBase, propertyName, otherId, uid);
+    if (count > 0)
+    {
+      if (propertyName.valid())
+      {
+        this->modified(propertyName.data());
+      }
+      else
+      {
+        this->modifiedAll();
+      }
+    }
+    return count;
+  }
+
+  void clear() override
+  {
+    this->smtk::common::TypeMapEntry<std::string, std::unordered_map<smtk::common::UUID, Type>>::
+      clear();
+    this->invalidateIndexes();
+  }
+
+  void from_json(const nlohmann::json& j) override
+  {
+    this->smtk::common::TypeMapEntry<std::string, std::unordered_map<smtk::common::UUID, Type>>::
+      from_json(j);
+    this->invalidateIndexes();
+  }
+
+  /**\brief Declare a secondary index on the values of the property \a name.
+    *
+    * Returns true if an index was added; false if one already exists or
+    * values of this type cannot be indexed. The index is populated the
+    * first time it is queried and kept up to date as properties are
+    * inserted, erased, or accessed for modification.
+    */
+  bool addIndex(const std::string& name, smtk::resource::properties::IndexKind kind)
+  {
+    if (!smtk::resource::properties::IndexKeys<Type>::indexable)
+    {
+      return false;
+    }
+    std::lock_guard<std::mutex> guard(m_indexMutex);
+    bool added = m_indexes.emplace(name, ValueIndex(kind)).second;
+    m_indexCount = m_indexes.size();
+    return added;
+  }
+
+  /// Remove the secondary index on the property \a name (if one exists).
+  bool removeIndex(const std::string& name)
+  {
+    std::lock_guard<std::mutex> guard(m_indexMutex);
+    bool removed = m_indexes.erase(name) > 0;
+    m_indexCount = m_indexes.size();
+    return removed;
+  }
+
+  /// Return true if values of the property \a name are indexed.
+  bool hasIndex(const std::string& name) const
+  {
+    std::lock_guard<std::mutex> guard(m_indexMutex);
+    return m_indexes.find(name) != m_indexes.end();
+  }
+
+  /// Invoke \a functor on the up-to-date index of the property \a name.
+  /// Returns false (without invoking \a functor) if \a name is not indexed.
+  template<typename Functor>
+  bool queryIndex(const std::string& name, Functor functor) const
+  {
+    std::lock_guard<std::mutex> guard(m_indexMutex);
+    auto it = m_indexes.find(name);
+    if (it == m_indexes.end())
+    {
+      return false;
+    }
+    if (it->second.outOfDate())
+    {
+      auto valuesIt = this->data().find(name);
+      it->second.synchronize(valuesIt == this->data().end() ? nullptr : &valuesIt->second);
+    }
+    return functor(static_cast<const ValueIndex&>(it->second));
+  }
+
+  /// Mark every index as requiring a rebuild. Call this after modifying
+  /// property values directly through data().
+  void invalidateIndexes()
+  {
+    this->modifiedAll();
+    std::lock_guard<std::mutex> guard(m_indexMutex);
+    for (auto& entry : m_indexes)
+    {
+      entry.second.invalidate();
+    }
+  }
+
+  /// Record that \a uid now holds \a value (and held no value before) for
+  /// the property \a name.
+  void indexValue(const std::string& name, const smtk::common::UUID& uid, const Type& value)
+  {
+    this->modified(name);
+    if (m_indexCount > 0)
+    {
+      std::lock_guard<std::mutex> guard(m_indexMutex);
+      auto it = m_indexes.find(name);
+      if (it != m_indexes.end())
+      {
+        it->second.insert(uid, value);
+      }
+    }
+  }
+
+  /// Record that \a uid's value for the property \a name is about to be
+  /// removed. Call this before removing the value.
+  void unindexValue(const std::string& name, const smtk::common::UUID& uid)
+  {
+    this->modified(name);
+    if (m_indexCount > 0)
+    {
+      std::lock_guard<std::mutex> guard(m_indexMutex);
+      auto it = m_indexes.find(name);
+      const Type* value;
+      if (it != m_indexes.end() && (value = this->valueOf(name, uid)))
+      {
+        it->second.erase(uid, *value);
+      }
+    }
+  }
+
+  /// Record that \a uid's value for the property \a name may be modified
+  /// (or created). Call this before modifying the value.
+  void touchValue(const std::string& name, const smtk::common::UUID& uid)
+  {
+    this->modified(name);
+    if (m_indexCount > 0)
+    {
+      std::lock_guard<std::mutex> guard(m_indexMutex);
+      auto it = m_indexes.find(name);
+      if (it != m_indexes.end())
+      {
+        it->second.touch(uid, this->valueOf(name, uid));
+      }
+    }
   }
 
   void allNames(std::unordered_set<smtk::string::Token>& names) const override
@@ -236,6 +468,92 @@ public:
       ids.insert(compToValue.first);
     }
   }
+
+  std::uint64_t revision() const override { return m_revision.load(); }
+
+  std::shared_ptr<const void> freeze(const std::shared_ptr<const void>& previous) const override
+  {
+    // Property names are not tracked until the first copy is made; treat them
+    // all as modified now. Tracking starts before the epoch is read so that no
+    // modification is missed, and only one of several concurrent callers
+    // (whose \a previous copies are necessarily null) records the epoch.
+    if (!m_trackNames.exchange(true))
+    {
+      m_epoch = m_revision.load();
+    }
+    return Freezer()(this, previous);
+  }
+
+private:
+  // Record a modification of the property \a name.
+  void modified(const std::string& name)
+  {
+    std::uint64_t revision = ++m_revision;
+    if (m_trackNames)
+    {
+      m_nameRevisions[name] = revision;
+    }
+  }
+
+  // Record a modification that may affect any property name.
+  void modifiedAll()
+  {
+    m_epoch = ++m_revision;
+    m_nameRevisions.clear();
+  }
+
+  // Return the revision at which the property \a name was last modified.
+  std::uint64_t revisionOf(const std::string& name) const
+  {
+    auto it = m_nameRevisions.find(name);
+    std::uint64_t epoch = m_epoch.load();
+    return it == m_nameRevisions.end() ? epoch : std::max(it->second, epoch);
+  }
+
+  // Return the value of property \a name held by \a uid (or null if none).
+  // Indexes look values up here rather than keeping copies of them.
+  const Type* valueOf(const std::string& name, const smtk::common::UUID& uid) const
+  {
+    auto nameIt = this->data().find(name);
+    if (nameIt == this->data().end())
+    {
+      return nullptr;
+    }
+    auto valueIt = nameIt->second.find(uid);
+    return valueIt == nameIt->second.end() ? nullptr : &valueIt->second;
+  }
+
+  void eraseFromIndexes(const smtk::common::UUID& uid)
+  {
+    if (m_indexCount > 0)
+    {
+      std::lock_guard<std::mutex> guard(m_indexMutex);
+      for (auto& entry : m_indexes)
+      {
+        if (const Type* value = this->valueOf(entry.first, uid))
+        {
+          entry.second.erase(uid, *value);
+        }
+      }
+    }
+  }
+
+  // Indexes are synchronized lazily by const queries, so they are mutable
+  // and guarded by a mutex. The number of indexes is also kept outside the
+  // mutex so that updating unindexed properties need not lock it.
+  mutable std::mutex m_indexMutex;
+  mutable std::unordered_map<std::string, ValueIndex> m_indexes;
+  std::atomic<std::size_t> m_indexCount{ 0 };
+  // Incremented by every path that may modify values so that snapshots
+  // can reuse frozen copies of unmodified property types. Once a copy has
+  // been made, the revision of each modified property name is recorded as
+  // well so that unmodified names can be shared; m_epoch is the revision of
+  // the last modification that affected every name. Copies may be made
+  // concurrently by readers, so the tracking state is atomic.
+  std::atomic<std::uint64_t> m_revision{ 0 };
+  mutable std::atomic<std::uint64_t> m_epoch{ 0 };
+  mutable std::atomic<bool> m_trackNames{ false };
+  std::unordered_map<std::string, std::uint64_t> m_nameRevisions;
 };
 
 /// Properties is a generalized container for storing and accessing data using a
@@ -414,18 +732,29 @@ public:
   /// Insert (\a key, \a value ) into the container.
   bool insert(const std::string& key, const Type& value)
   {
-    return get(key).insert(std::make_pair(m_id, value)).second;
+    bool inserted = get(key).insert(std::make_pair(m_id, value)).second;
+    if (inserted)
+    {
+      m_properties.indexValue(key, m_id, value);
+    }
+    return inserted;
   }
 
   /// Emplace (\a key, \a value ) into the container.
   bool emplace(const std::string& key, Type&& value)
   {
-    return get(key).emplace(std::make_pair(m_id, std::move(value))).second;
+    auto result = get(key).emplace(std::make_pair(m_id, std::move(value)));
+    if (result.second)
+    {
+      m_properties.indexValue(key, m_id, result.first->second);
+    }
+    return result.second;
   }
 
   /// Erase property indexed by \a key from the container.
   void erase(const std::string& key)
   {
+    m_properties.unindexValue(key, m_id);
     get(key).erase(m_id);
     if (get(key).empty())
     {
@@ -434,10 +763,21 @@ public:
   }
 
   /// Access property indexed by \a key.
-  Type& operator[](const std::string& key) { return get(key)[m_id]; }
+  ///
+  /// Since the returned reference may be used to modify the value, any
+  /// index of \a key is updated before it is next queried.
+  Type& operator[](const std::string& key)
+  {
+    m_properties.touchValue(key, m_id);
+    return get(key)[m_id];
+  }
 
   /// Access property indexed by \a key.
-  Type& at(const std::string& key) { return get(key).at(m_id); }
+  Type& at(const std::string& key)
+  {
+    m_properties.touchValue(key, m_id);
+    return get(key).at(m_id);
+  }
 
   /// Access property indexed by \a key.
   const Type& at(const std::string& key) const { return get(key).at(m_id); }
@@ -744,6 +1084,111 @@ public:
     m_data.insertPropertyType<Indexed<Type>>();
   }
 
+  ///@name Secondary value indexes
+  ///@{
+  /// Properties are stored as maps from UUID to value, so finding the objects
+  /// that hold a given value requires visiting every object. These methods
+  /// declare and query opt-in indexes on the values of individual properties
+  /// (of all components in the resource plus the resource itself).
+  ///
+  /// Query methods return false when the property is not indexed (or the
+  /// index cannot answer the query); callers should then fall back to
+  /// iterating over the property's values. For vector-valued properties,
+  /// each element of a value is indexed and query results are candidates
+  /// whose values contain a matching element.
+
+  /// Notify any index of property \a name whose type is \a Type that the
+  /// value held by \a uid is about to be modified (or created or removed)
+  /// directly through data(). Call this before making the change.
+  template<typename Type>
+  void touchIndex(const std::string& name, const smtk::common::UUID& uid)
+  {
+    auto* storage = this->storage<Type>();
+    if (storage)
+    {
+      storage->touchValue(name, uid);
+    }
+  }
+
+  /// Declare an index of the values of property \a name whose type is \a Type.
+  template<typename Type>
+  bool addIndex(
+    const std::string& name,
+    smtk::resource::properties::IndexKind kind = smtk::resource::properties::IndexKind::Hashed)
+  {
+    auto* storage = this->storage<Type>();
+    return storage ? storage->addIndex(name, kind) : false;
+  }
+
+  /// Remove the index on property \a name whose type is \a Type.
+  template<typename Type>
+  bool removeIndex(const std::string& name)
+  {
+    auto* storage = this->storage<Type>();
+    return storage ? storage->removeIndex(name) : false;
+  }
+
+  /// Return true if property \a name whose type is \a Type is indexed.
+  template<typename Type>
+  bool hasIndex(const std::string& name) const
+  {
+    const auto* storage = this->storage<Type>();
+    return storage ? storage->hasIndex(name) : false;
+  }
+
+  /// Insert into \a ids the UUIDs of objects whose property \a name has
+  /// (or, for vectors, contains) the value \a key.
+  template<typename Type>
+  bool findIds(
+    const std::string& name,
+    const typename smtk::resource::properties::ValueIndex<Type>::KeyType& key,
+    std::unordered_set<smtk::common::UUID>& ids) const
+  {
+    const auto* storage = this->storage<Type>();
+    return storage &&
+      storage->queryIndex(
+        name, [&key, &ids](const smtk::resource::properties::ValueIndex<Type>& index) {
+          index.find(key, ids);
+          return true;
+        });
+  }
+
+  /// Insert into \a ids the UUIDs of objects whose property \a name has
+  /// (or, for vectors, contains) a value in the closed range [\a lower, \a upper].
+  /// The property must have an ordered index.
+  template<typename Type>
+  bool findIdsInRange(
+    const std::string& name,
+    const typename smtk::resource::properties::ValueIndex<Type>::KeyType& lower,
+    const typename smtk::resource::properties::ValueIndex<Type>::KeyType& upper,
+    std::unordered_set<smtk::common::UUID>& ids) const
+  {
+    const auto* storage = this->storage<Type>();
+    return storage &&
+      storage->queryIndex(
+        name, [&lower, &upper, &ids](const smtk::resource::properties::ValueIndex<Type>& index) {
+          return index.findInRange(lower, upper, ids);
+        });
+  }
+
+  /// Insert into \a ids the UUIDs of objects whose string property \a name
+  /// has (or, for vectors, contains) a value beginning with \a prefix.
+  /// The property must have an ordered index.
+  template<typename Type>
+  bool findIdsWithPrefix(
+    const std::string& name,
+    const std::string& prefix,
+    std::unordered_set<smtk::common::UUID>& ids) const
+  {
+    const auto* storage = this->storage<Type>();
+    return storage &&
+      storage->queryIndex(
+        name, [&prefix, &ids](const smtk::resource::properties::ValueIndex<Type>& index) {
+          return index.findWithPrefix(prefix, ids);
+        });
+  }
+  ///@}
+
   // Remove all properties on the resource
   std::size_t clear() override
   {
@@ -754,6 +1199,22 @@ public:
 private:
   ResourceProperties(Resource* resource);
 
+  template<typename Type>
+  detail::PropertiesOfType<Indexed<Type>>* storage()
+  {
+    return m_data.containsType<Indexed<Type>>()
+      ? static_cast<detail::PropertiesOfType<Indexed<Type>>*>(&m_data.get<Indexed<Type>>())
+      : nullptr;
+  }
+
+  template<typename Type>
+  const detail::PropertiesOfType<Indexed<Type>>* storage() const
+  {
+    return m_data.containsType<Indexed<Type>>()
+      ? static_cast<const detail::PropertiesOfType<Indexed<Type>>*>(&m_data.get<Indexed<Type>>())
+      : nullptr;
+  }
+
   const smtk::common::UUID& id() const override;
   smtk::common::TypeMapBase<std::string>& properties() override { return m_data; }
   const smtk::common::TypeMapBase<std::string>& properties() const override { return m_data; }
@@ -99,6 +99,56 @@ Component* Resource::component(const smtk::common::UUID& compId) const
   return this->find(compId).get();
 }
 
+std::shared_ptr<const Snapshot> Resource::snapshot() const
+{
+  auto current = std::atomic_load(&m_snapshot);
+  if (current && current->version() == this->version())
+  {
+    return current;
+  }
+  // Another reader is taking a snapshot or a writer is active or waiting;
+  // rather than wait for either, return the most recent snapshot we have.
+  std::unique_lock<std::mutex> guard(m_snapshotMutex, std::try_to_lock);
+  if (!guard.owns_lock() || !m_lock.tryLock(LockType::Read))
+  {
+    return current;
+  }
+  ScopedLockGuard readLock(m_lock, LockType::Read, true);
+  current = std::atomic_load(&m_snapshot);
+  if (!current || current->version() != this->version())
+  {
+    // The resource was modified without publishing a snapshot (or none has
+    // been taken yet), so we cannot tell which components changed.
+    current = Snapshot::create(*this, current);
+    std::atomic_store(&m_snapshot, current);
+  }
+  return current;
+}
+
+void Resource::recordSnapshotChanges(const std::unordered_set<smtk::common::UUID>& ids, Key())
+{
+  if (std::atomic_load(&m_snapshot))
+  {
+    m_snapshotChanges.insert(ids.begin(), ids.end());
+  }
+}
+
+void Resource::publishSnapshot(Key())
+{
+  auto current = std::atomic_load(&m_snapshot);
+  if (current)
+  {
+    // Releasing the write lock will increment the version.
+    std::uint64_t next = this->version() + 1;
+    std::atomic_store(
+      &m_snapshot,
+      current->version() == this->version()
+        ? Snapshot::update(*this, current, m_snapshotChanges, next)
+        : Snapshot::create(*this, current, next));
+  }
+  m_snapshotChanges.clear();
+}
+
 std::function<bool(const Component&)> Resource::queryOperation(
   const std::string& filterString) const
 {
@@ -107,23 +157,216 @@ std::function<bool(const Component&)> Resource::queryOperation(
   return smtk::resource::filter::Filter<>(filterString);
 }
 
-ComponentSet Resource::filter(const std::string& queryString) const
+std::shared_ptr<const filter::Rules> Resource::queryRules(const std::string& queryString) const
 {
-  // Construct a query operation from the query string
-  auto queryOp = this->queryOperation(queryString);
+  (void)queryString;
+  return nullptr;
+}
 
-  // Construct a component set to fill
-  ComponentSet componentSet;
+bool Resource::componentIdsOfType(
+  const std::string& typeName,
+  std::unordered_set<smtk::common::UUID>& ids) const
+{
+  (void)typeName;
+  (void)ids;
+  return false;
+}
+
+struct Resource::CompiledQuery
+{
+  // The parsed query (if the resource provides one) used for planning.
+  std::shared_ptr<const filter::Rules> m_rules;
+  // The functor used to test each component.
+  std::function<bool(const Component&)> m_evaluate;
+};
+
+std::shared_ptr<const Resource::CompiledQuery> Resource::compiledQuery(
+  const std::string& queryString) const
+{
+  // Bound the number of cached queries; query strings are usually drawn
+  // from a small set, but may be generated programmatically.
+  constexpr std::size_t maximumCachedQueries = 256;
+
+  {
+    std::lock_guard<std::mutex> guard(m_compiledQueriesMutex);
+    auto it = m_compiledQueryIndex.find(queryString);
+    if (it != m_compiledQueryIndex.end())
+    {
+      // Mark the query as the most recently used.
+      m_compiledQueries.splice(m_compiledQueries.begin(), m_compiledQueries, it->second);
+      return it->second->second;
+    }
+  }
+
+  // Parse outside of the lock; if another thread compiles the same query
+  // concurrently, the first one to be inserted is kept.
+  auto query = std::make_shared<CompiledQuery>();
+  query->m_rules = this->queryRules(queryString);
+  if (query->m_rules)
+  {
+    auto rules = query->m_rules;
+    query->m_evaluate = [rules](const Component& component) { return (*rules)(component); };
+  }
+  else
+  {
+    query->m_evaluate = this->queryOperation(queryString);
+  }
+
+  std::lock_guard<std::mutex> guard(m_compiledQueriesMutex);
+  auto it = m_compiledQueryIndex.find(queryString);
+  if (it != m_compiledQueryIndex.end())
+  {
+    return it->second->second;
+  }
+  // Evict the least recently used query to make room.
+  if (m_compiledQueries.size() >= maximumCachedQueries)
+  {
+    m_compiledQueryIndex.erase(m_compiledQueries.back().first);
+    m_compiledQueries.pop_back();
+  }
+  m_compiledQueries.emplace_front(queryString, query);
+  m_compiledQueryIndex[queryString] = m_compiledQueries.begin();
+  return query;
+}
+
+void Resource::visitMatches(
+  const std::string& queryString,
+  const std::function<void(const ComponentPtr&)>& visitor,
+  bool inVisitOrder) const
+{
+  auto query = this->compiledQuery(queryString);
+
+  // Since rules are conjunctive, a component must be a candidate of every
+  // rule that can be planned; intersect the candidates of each such rule.
+  std::unordered_set<smtk::common::UUID> candidates;
+  bool planned = false;
+  if (query->m_rules)
+  {
+    for (const auto& rule : query->m_rules->data())
+    {
+      std::unordered_set<smtk::common::UUID> ruleCandidates;
+      if (!rule->candidates(*this, ruleCandidates))
+      {
+        continue;
+      }
+      if (!planned)
+      {
+        candidates = std::move(ruleCandidates);
+        planned = true;
+      }
+      else
+      {
+        for (auto it = candidates.begin(); it != candidates.end();)
+        {
+          if (ruleCandidates.find(*it) == ruleCandidates.end())
+          {
+            it = candidates.erase(it);
+          }
+          else
+          {
+            ++it;
+          }
+        }
+      }
+      if (candidates.empty())
+      {
+        break;
+      }
+    }
+  }
+
+  if (planned)
+  {
+    // Candidates may include the resource itself, stale property entries,
+    // and objects failing other rules, so each must still be tested.
+    if (inVisitOrder)
+    {
+      // Candidates are unordered; report them as visit() orders components,
+      // testing only membership for components that are not candidates.
+      if (candidates.empty())
+      {
+        return;
+      }
+      smtk::resource::Component::Visitor ordered = [&](const ComponentPtr& component) {
+        if (candidates.find(component->id()) != candidates.end() && query->m_evaluate(*component))
+        {
+          visitor(component);
+        }
+      };
+      this->visit(ordered);
+      return;
+    }
+    for (const auto& candidate : candidates)
+    {
+      auto component = this->find(candidate);
+      if (component && query->m_evaluate(*component))
+      {
+        visitor(component);
+      }
+    }
+    return;
+  }
+
+  // If a rule can enumerate its own matches (e.g., by traversing arcs from
+  // other components), test only those against the remaining rules.
+  if (query->m_rules)
+  {
+    const auto& rules = query->m_rules->data();
+    std::unordered_set<const Component*> matches;
+    for (const auto& generator : rules)
+    {
+      bool generated = generator->generate(*this, [&](const Component* match) {
+        bool accepted = std::all_of(
+          rules.begin(), rules.end(), [&generator, &match](const std::unique_ptr<filter::Rule>& rule) {
+            return rule == generator || (*rule)(*match);
+          });
+        if (accepted && inVisitOrder)
+        {
+          matches.insert(match);
+        }
+        else if (accepted)
+        {
+          visitor(std::static_pointer_cast<Component>(
+            const_cast<Component*>(match)->shared_from_this()));
+        }
+        return smtk::common::Visit::Continue;
+      });
+      if (generated)
+      {
+        if (inVisitOrder && !matches.empty())
+        {
+          smtk::resource::Component::Visitor ordered = [&](const ComponentPtr& component) {
+            if (matches.find(component.get()) != matches.end())
+            {
+              visitor(component);
+            }
+          };
+          this->visit(ordered);
+        }
+        return;
+      }
+    }
+  }
 
-  // Visit each component and add it to the set if it satisfies the query
-  smtk::resource::Component::Visitor visitor = [&](const ComponentPtr& component) {
-    if (queryOp(*component))
+  // Visit each component and report it if it satisfies the query
+  smtk::resource::Component::Visitor scan = [&](const ComponentPtr& component) {
+    if (query->m_evaluate(*component))
     {
-      componentSet.insert(component);
+      visitor(component);
     }
   };
+  this->visit(scan);
+}
+
+ComponentSet Resource::filter(const std::string& queryString) const
+{
+  // Construct a component set to fill
+  ComponentSet componentSet;
 
-  this->visit(visitor);
+  this->visitMatches(
+    queryString,
+    [&componentSet](const ComponentPtr& component) { componentSet.insert(component); },
+    false);
 
   return componentSet;
 }
@@ -14,12 +14,14 @@
 #include "smtk/CoreExports.h"
 
 #include "smtk/common/Deprecation.h"
+#include "smtk/common/TypeTraits.h"
 #include "smtk/common/UUID.h"
 
 #include "smtk/resource/Component.h"
 #include "smtk/resource/Lock.h"
 #include "smtk/resource/PersistentObject.h"
 #include "smtk/resource/ResourceLinks.h"
+#include "smtk/resource/Snapshot.h"
 
 #include "smtk/resource/query/BadTypeError.h"
 #include "smtk/resource/query/Queries.h"
@@ -29,9 +31,13 @@ namespace units
 struct System;
 }
 
+#include <cstdint>
+#include <list>
+#include <mutex>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace smtk
 {
@@ -42,6 +48,10 @@ class Operation;
 namespace resource
 {
 class CopyOptions;
+namespace filter
+{
+class Rules;
+}
 
 /// Operations need the ability to lock and unlock resources, but no additional
 /// access privilege is required. We therefore use the PassKey pattern to grant
@@ -280,14 +290,46 @@ public:
   /// satisfies the query parameters).
   virtual std::function<bool(const Component&)> queryOperation(const std::string&) const;
 
+  /**\brief Given a std::string describing a query, return the parsed rules
+    *        that queryOperation() evaluates.
+    *
+    * When a resource provides its query as filter::Rules, filter() and
+    * filterAs() ask each rule for candidate components using indexes the
+    * resource maintains (its property storage and componentIdsOfType())
+    * rather than visiting every component. The default returns nullptr;
+    * resources that override queryOperation() with a filter::Filter should
+    * override this method with the same grammar.
+    */
+  virtual std::shared_ptr<const filter::Rules> queryRules(const std::string& queryString) const;
+
+  /// Insert the UUIDs of all components whose typeName() is exactly
+  /// \a typeName into \a ids. Resources that index their components by type
+  /// name may override this to accelerate queries. The default returns
+  /// false (and leaves \a ids untouched) to indicate no index is available.
+  ///
+  /// Only markup resources maintain such an index. Other graph resources
+  /// (whose default node storage is not indexed by type) and model resources
+  /// (which do not provide queryRules()) use the default, so exact type-name
+  /// rules in their queries are tested against each component instead.
+  virtual bool componentIdsOfType(
+    const std::string& typeName,
+    std::unordered_set<smtk::common::UUID>& ids) const;
+
   /// visit all components in a resource.
   virtual void visit(std::function<void(const ComponentPtr&)>& v) const = 0;
 
+  /// Return the set of components that satisfy \a queryString.
+  ///
+  /// Parsed queries are cached by the resource, so repeated calls with the
+  /// same query string do not reparse it.
   ComponentSet filter(const std::string& queryString) const;
 
   /// given a a std::string describing a query and a type of container, return a
   /// set of components that satisfy both.  Note that since this uses a dynamic
   /// pointer cast this can be slower than other find methods.
+  ///
+  /// Sequence containers (those without a key_type, such as std::vector)
+  /// hold matching components in the order visit() reports them.
   template<typename Collection>
   Collection filterAs(const std::string& queryString) const;
   ///@}
@@ -340,6 +382,46 @@ public:
   LockType locked() const { return m_lock.state(); }
   ///@}
 
+  ///@{
+  /// Readers that cannot afford to wait for (or block) writers may read a
+  /// Snapshot of the resource instead of locking it.
+
+  /// Return the resource's version: the number of times a writer has released its lock.
+  std::uint64_t version() const { return m_lock.generation(); }
+
+  /// Return an immutable snapshot of the resource's components and properties.
+  ///
+  /// The snapshot reflects the resource as of the most recent release of a
+  /// write lock. This method never waits: when the current snapshot is out of
+  /// date, a new one is taken only if a read lock can be acquired immediately
+  /// (and no other thread is already taking one). Otherwise, the most recent
+  /// snapshot is returned, which is null if no snapshot has been taken yet.
+  ///
+  /// Only the first snapshot (and any snapshot following modifications made
+  /// outside of operations) visits every component. Afterward, each operation
+  /// that write-locks the resource publishes the next snapshot just before it
+  /// releases the lock; the snapshot is updated from the previous one using
+  /// the components that operations report as created, modified, or expunged.
+  ///
+  /// Do not call this method while holding a lock on the resource; use
+  /// Snapshot::create() instead.
+  std::shared_ptr<const Snapshot> snapshot() const;
+
+  /// Record that the components with the given \a ids were created, modified,
+  /// or removed so that the next published snapshot reflects them.
+  ///
+  /// Operations call this with the components reported in their results.
+  /// Changes are only recorded once a snapshot of the resource has been taken.
+  void recordSnapshotChanges(const std::unordered_set<smtk::common::UUID>& ids, Key());
+
+  /// Publish a snapshot that includes all recorded changes.
+  ///
+  /// Operations call this immediately before releasing a write lock on the
+  /// resource; the snapshot is labeled with the version the resource will
+  /// have once the lock is released.
+  void publishSnapshot(Key());
+  ///@}
+
   Resource(Resource&&) noexcept;
 
   ///@name Units and Dimensional Analysis.
@@ -572,31 +654,69 @@ private:
   Resource* m_parentResource = nullptr;
 
   mutable Lock m_lock;
+
+  // The current snapshot is read and written with std::atomic_load/store so
+  // that readers never wait on the thread producing the next snapshot. The
+  // mutex only prevents several readers from producing snapshots at once.
+  mutable std::mutex m_snapshotMutex;
+  mutable std::shared_ptr<const Snapshot> m_snapshot;
+  // Components changed by operations since the last snapshot was published.
+  // Only writers (which hold the resource's lock) access this.
+  std::unordered_set<smtk::common::UUID> m_snapshotChanges;
+
+  /// Invoke \a visitor on each component that satisfies \a queryString.
+  ///
+  /// If \a inVisitOrder is true, components are reported in the order visit()
+  /// reports them even when the query is answered from an index.
+  void visitMatches(
+    const std::string& queryString,
+    const std::function<void(const ComponentPtr&)>& visitor,
+    bool inVisitOrder) const;
+
+  struct CompiledQuery;
+  std::shared_ptr<const CompiledQuery> compiledQuery(const std::string& queryString) const;
+
+  // Parsed queries, most recently used first, and an index into them by query string.
+  using CompiledQueries = std::list<std::pair<std::string, std::shared_ptr<const CompiledQuery>>>;
+  mutable std::mutex m_compiledQueriesMutex;
+  mutable CompiledQueries m_compiledQueries;
+  mutable std::unordered_map<std::string, CompiledQueries::iterator> m_compiledQueryIndex;
+};
+
+namespace detail
+{
+/// Does inserting into \a Collection determine the order of its entries?
+/// True for sequence containers; false for sets and maps, which have a key_type.
+template<typename Collection, typename = void>
+struct OrderedByInsertion : std::true_type
+{
 };
 
 template<typename Collection>
-Collection Resource::filterAs(const std::string& queryString) const
+struct OrderedByInsertion<Collection, smtk::common::void_t<typename Collection::key_type>>
+  : std::false_type
 {
-  // Construct a query operation from the query string
-  auto queryOp = this->queryOperation(queryString);
+};
+} // namespace detail
 
+template<typename Collection>
+Collection Resource::filterAs(const std::string& queryString) const
+{
   // Construct a component set to fill
   Collection col;
 
-  // Visit each component and add it to the set if it satisfies the query
-  smtk::resource::Component::Visitor visitor = [&](const ComponentPtr& component) {
-    if (queryOp(*component))
-    {
+  // Add each component that satisfies the query and is of the requested type
+  this->visitMatches(
+    queryString,
+    [&col](const ComponentPtr& component) {
       auto entry =
         std::dynamic_pointer_cast<typename Collection::value_type::element_type>(component);
       if (entry)
       {
         col.insert(col.end(), entry);
       }
-    }
-  };
-
-  this->visit(visitor);
+    },
+    detail::OrderedByInsertion<Collection>::value);
 
   return col;
 }
@@ -0,0 +1,209 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/resource/Snapshot.h"
+
+#include "smtk/resource/Component.h"
+#include "smtk/resource/Resource.h"
+
+namespace smtk
+{
+namespace resource
+{
+
+namespace
+{
+// Buckets are sized so that each holds this many components on average
+// when created, and are split once they hold 4 times as many.
+constexpr std::size_t bucketLoad = 16;
+constexpr std::size_t maximumBucketLoad = 4 * bucketLoad;
+
+std::size_t numberOfBuckets(std::size_t numberOfComponents)
+{
+  std::size_t count = 1;
+  while (count * bucketLoad < numberOfComponents)
+  {
+    count *= 2;
+  }
+  return count;
+}
+} // anonymous namespace
+
+std::shared_ptr<const Snapshot> Snapshot::create(
+  const Resource& resource,
+  const std::shared_ptr<const Snapshot>& previous,
+  std::uint64_t version)
+{
+  std::shared_ptr<Snapshot> result(new Snapshot);
+  result->snapshotResource(
+    resource, version == std::numeric_limits<std::uint64_t>::max() ? resource.version() : version);
+
+  std::vector<Component> records;
+  std::function<void(const ComponentPtr&)> record = [&records](const ComponentPtr& component) {
+    if (component)
+    {
+      records.push_back(Component{ component->id(), component->typeToken(), component->name() });
+    }
+  };
+  resource.visit(record);
+
+  std::vector<std::shared_ptr<Bucket>> buckets(numberOfBuckets(records.size()));
+  for (auto& bucket : buckets)
+  {
+    bucket = std::make_shared<Bucket>();
+  }
+  result->m_buckets.assign(buckets.begin(), buckets.end());
+  for (auto& entry : records)
+  {
+    auto uid = entry.id;
+    buckets[result->bucketIndex(uid)]->emplace(uid, std::move(entry));
+  }
+  result->m_numberOfComponents = records.size();
+
+  result->snapshotProperties(resource, previous.get());
+  return result;
+}
+
+std::shared_ptr<const Snapshot> Snapshot::update(
+  const Resource& resource,
+  const std::shared_ptr<const Snapshot>& previous,
+  const std::unordered_set<smtk::common::UUID>& changed,
+  std::uint64_t version)
+{
+  if (!previous || previous->m_id != resource.id())
+  {
+    return Snapshot::create(resource, previous, version);
+  }
+
+  std::shared_ptr<Snapshot> result(new Snapshot);
+  result->snapshotResource(resource, version);
+  result->m_buckets = previous->m_buckets;
+  result->m_numberOfComponents = previous->m_numberOfComponents;
+
+  // Copy each bucket holding a changed id once, then apply every change to the copies.
+  std::unordered_map<std::size_t, std::shared_ptr<Bucket>> copies;
+  for (const auto& uid : changed)
+  {
+    std::size_t index = result->bucketIndex(uid);
+    auto& bucket = copies[index];
+    if (!bucket)
+    {
+      bucket = std::make_shared<Bucket>(*result->m_buckets[index]);
+    }
+    if (auto component = resource.find(uid))
+    {
+      Component entry{ uid, component->typeToken(), component->name() };
+      auto it = bucket->find(uid);
+      if (it == bucket->end())
+      {
+        bucket->emplace(uid, std::move(entry));
+        ++result->m_numberOfComponents;
+      }
+      else
+      {
+        it->second = std::move(entry);
+      }
+    }
+    else
+    {
+      result->m_numberOfComponents -= bucket->erase(uid);
+    }
+  }
+  for (auto& entry : copies)
+  {
+    result->m_buckets[entry.first] = std::move(entry.second);
+  }
+
+  // When buckets grow too large, redistribute the components among more of them.
+  if (result->m_numberOfComponents > maximumBucketLoad * result->m_buckets.size())
+  {
+    std::vector<std::shared_ptr<Bucket>> buckets(numberOfBuckets(result->m_numberOfComponents));
+    for (auto& bucket : buckets)
+    {
+      bucket = std::make_shared<Bucket>();
+    }
+    auto previousBuckets = std::move(result->m_buckets);
+    result->m_buckets.assign(buckets.begin(), buckets.end());
+    for (const auto& bucket : previousBuckets)
+    {
+      for (const auto& entry : *bucket)
+      {
+        buckets[result->bucketIndex(entry.first)]->insert(entry);
+      }
+    }
+  }
+
+  result->snapshotProperties(resource, previous.get());
+  return result;
+}
+
+void Snapshot::snapshotResource(const Resource& resource, std::uint64_t version)
+{
+  m_version = version;
+  m_id = resource.id();
+  m_typeName = resource.typeToken();
+  m_name = resource.name();
+}
+
+void Snapshot::snapshotProperties(const Resource& resource, const Snapshot* previous)
+{
+  // Reuse frozen property types from the previous snapshot of this resource
+  // when they have not been modified since; otherwise, freeze them again
+  // (which shares the values of each unmodified property name).
+  const bool canShare = previous && previous->m_id == m_id;
+  for (const auto& entry : resource.properties().data().data())
+  {
+    const auto* storage = dynamic_cast<const detail::PropertiesBase*>(entry.second);
+    if (!storage)
+    {
+      continue;
+    }
+    std::uint64_t revision = storage->revision();
+    const FrozenProperties* prior = nullptr;
+    if (canShare)
+    {
+      auto it = previous->m_properties.find(entry.first);
+      if (it != previous->m_properties.end() && it->second.source == storage)
+      {
+        prior = &it->second;
+      }
+    }
+    if (prior && prior->revision == revision)
+    {
+      m_properties.emplace(entry.first, *prior);
+      continue;
+    }
+    auto values = storage->freeze(prior ? prior->values : nullptr);
+    if (values)
+    {
+      m_properties.emplace(entry.first, FrozenProperties{ storage, revision, std::move(values) });
+    }
+  }
+}
+
+const Snapshot::Component* Snapshot::component(const smtk::common::UUID& uid) const
+{
+  const auto& bucket = *m_buckets[this->bucketIndex(uid)];
+  auto it = bucket.find(uid);
+  return it == bucket.end() ? nullptr : &it->second;
+}
+
+void Snapshot::visit(const std::function<void(const Component&)>& visitor) const
+{
+  for (const auto& bucket : m_buckets)
+  {
+    for (const auto& entry : *bucket)
+    {
+      visitor(entry.second);
+    }
+  }
+}
+
+} // namespace resource
+} // namespace smtk
@@ -0,0 +1,193 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#ifndef smtk_resource_Snapshot_h
+#define smtk_resource_Snapshot_h
+
+#include "smtk/CoreExports.h"
+#include "smtk/common/TypeName.h"
+#include "smtk/common/UUID.h"
+#include "smtk/resource/Properties.h"
+#include "smtk/string/Token.h"
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace smtk
+{
+namespace resource
+{
+
+class Resource;
+
+/**\brief An immutable, versioned view of a resource's components and properties.
+  *
+  * A snapshot records the identity, type, and name of each component in a
+  * resource along with a copy of every copyable property held by the resource
+  * and its components. Once created, a snapshot never changes, so any number
+  * of threads may read it without holding the resource's lock while writers
+  * continue to modify the resource itself.
+  *
+  * Snapshots are obtained from Resource::snapshot() or by operations that
+  * request LockType::Snapshot access to a resource. A snapshot's version()
+  * is the resource's Resource::version() at the time it was taken.
+  *
+  * Successive snapshots of a resource share everything that did not change
+  * between them. Components are held in buckets (by id); an update copies
+  * only the buckets holding components that were created, modified, or
+  * removed. Properties are held one type and one property name at a time;
+  * an update copies only the values of property names that were modified.
+  */
+class SMTKCORE_EXPORT Snapshot
+{
+public:
+  /// The information a snapshot holds about each component.
+  struct Component
+  {
+    smtk::common::UUID id;
+    smtk::string::Token typeName;
+    std::string name;
+  };
+
+  /// The frozen values of one property name: a map from object id to value.
+  template<typename Type>
+  using PropertyValues = std::unordered_map<smtk::common::UUID, Type>;
+
+  /// Create a snapshot of \a resource by visiting all of its components.
+  ///
+  /// The caller must hold a lock on \a resource (or otherwise ensure it is
+  /// not modified) for the duration of this call. Property values that have
+  /// not been modified since \a previous was taken are shared with it.
+  /// The snapshot is labeled with \a version (or the resource's current
+  /// version if none is provided).
+  static std::shared_ptr<const Snapshot> create(
+    const Resource& resource,
+    const std::shared_ptr<const Snapshot>& previous = nullptr,
+    std::uint64_t version = std::numeric_limits<std::uint64_t>::max());
+
+  /// Create a snapshot of \a resource that differs from \a previous only in
+  /// the components whose ids are listed in \a changed (and in properties).
+  ///
+  /// Each changed id is looked up in \a resource: components that no longer
+  /// exist are removed from the snapshot and all others are (re)recorded.
+  /// Buckets of \a previous that hold no changed ids are shared with the
+  /// result. The caller must hold a lock on \a resource.
+  static std::shared_ptr<const Snapshot> update(
+    const Resource& resource,
+    const std::shared_ptr<const Snapshot>& previous,
+    const std::unordered_set<smtk::common::UUID>& changed,
+    std::uint64_t version);
+
+  Snapshot(const Snapshot&) = delete;
+  Snapshot& operator=(const Snapshot&) = delete;
+
+  /// The resource's version when this snapshot was taken.
+  std::uint64_t version() const { return m_version; }
+
+  ///@name Resource information
+  ///@{
+  const smtk::common::UUID& id() const { return m_id; }
+  smtk::string::Token typeName() const { return m_typeName; }
+  const std::string& name() const { return m_name; }
+  ///@}
+
+  ///@name Component tables
+  ///@{
+  /// Return the record for the component with the given \a uid (or null).
+  const Component* component(const smtk::common::UUID& uid) const;
+  /// Return the number of components in the snapshot.
+  std::size_t numberOfComponents() const { return m_numberOfComponents; }
+  /// Invoke \a visitor on every component in the snapshot.
+  void visit(const std::function<void(const Component&)>& visitor) const;
+  ///@}
+
+  ///@name Properties
+  ///@{
+  /// Return the values of the property named \a key of the given \a Type
+  /// held by the resource and its components.
+  ///
+  /// A null pointer is returned if no object has the property or values of
+  /// \a Type are not copyable. Successive snapshots return the same pointer
+  /// for property names that were not modified between them.
+  template<typename Type>
+  std::shared_ptr<const PropertyValues<Type>> properties(const std::string& key) const
+  {
+    auto it = m_properties.find(smtk::common::typeName<PropertyValues<Type>>());
+    if (it == m_properties.end())
+    {
+      return nullptr;
+    }
+    const auto& names =
+      std::static_pointer_cast<const detail::FrozenProperties<Type>>(it->second.values)->names;
+    auto keyIt = names.find(key);
+    return keyIt == names.end() ? nullptr : keyIt->second.values;
+  }
+
+  /// Return true if the object with the given \a uid has a property named \a key of \a Type.
+  template<typename Type>
+  bool contains(const smtk::common::UUID& uid, const std::string& key) const
+  {
+    return this->property<Type>(uid, key) != nullptr;
+  }
+
+  /// Return the property named \a key of \a Type held by the object with the
+  /// given \a uid (or null if there is none).
+  template<typename Type>
+  const Type* property(const smtk::common::UUID& uid, const std::string& key) const
+  {
+    auto values = this->properties<Type>(key);
+    if (!values)
+    {
+      return nullptr;
+    }
+    auto valueIt = values->find(uid);
+    return valueIt == values->end() ? nullptr : &valueIt->second;
+  }
+  ///@}
+
+private:
+  Snapshot() = default;
+
+  using Bucket = std::unordered_map<smtk::common::UUID, Component>;
+
+  struct FrozenProperties
+  {
+    const void* source;
+    std::uint64_t revision;
+    std::shared_ptr<const void> values;
+  };
+
+  void snapshotResource(const Resource& resource, std::uint64_t version);
+  void snapshotProperties(const Resource& resource, const Snapshot* previous);
+  std::size_t bucketIndex(const smtk::common::UUID& uid) const
+  {
+    return std::hash<smtk::common::UUID>()(uid) & (m_buckets.size() - 1);
+  }
+
+  std::uint64_t m_version{ 0 };
+  smtk::common::UUID m_id;
+  smtk::string::Token m_typeName;
+  std::string m_name;
+  // The number of buckets is always a power of two.
+  std::vector<std::shared_ptr<const Bucket>> m_buckets;
+  std::size_t m_numberOfComponents{ 0 };
+  std::unordered_map<std::string, FrozenProperties> m_properties;
+};
+
+} // namespace resource
+} // namespace smtk
+
+#endif // smtk_resource_Snapshot_h
@@ -10,6 +10,7 @@
 #ifndef smtk_resource_filter_Action_h
 #define smtk_resource_filter_Action_h
 
+#include "smtk/resource/Resource.h"
 #include "smtk/resource/filter/Property.h"
 #include "smtk/resource/filter/Rules.h"
 
@@ -20,6 +21,8 @@ SMTK_THIRDPARTY_PRE_INCLUDE
 SMTK_THIRDPARTY_POST_INCLUDE
 
 #include <memory>
+#include <string>
+#include <unordered_set>
 
 namespace smtk
 {
@@ -30,6 +33,34 @@ namespace filter
 
 using namespace tao::pegtl;
 
+/// Return the literal text that every string fully matching the regular
+/// expression \a pattern must begin with (or an empty string if there is
+/// no such prefix or the pattern is too complex to tell).
+inline std::string regexLiteralPrefix(const std::string& pattern)
+{
+  std::string prefix;
+  if (pattern.find('|') != std::string::npos)
+  {
+    return prefix;
+  }
+  for (std::size_t ii = (!pattern.empty() && pattern[0] == '^') ? 1 : 0; ii < pattern.size(); ++ii)
+  {
+    char cc = pattern[ii];
+    if (std::string(".[]{}()*+?\\^$").find(cc) != std::string::npos)
+    {
+      // Quantifiers that permit zero repetitions make the preceding
+      // character optional.
+      if ((cc == '*' || cc == '?' || cc == '{') && !prefix.empty())
+      {
+        prefix.pop_back();
+      }
+      break;
+    }
+    prefix.push_back(cc);
+  }
+  return prefix;
+}
+
 /// A base class template for processing PEGTL rules. A specialization of this
 /// class template must exist for each PEGTL rule to be processed.
 template<typename Rule>
@@ -73,6 +104,10 @@ struct NameAction
       }
       return returnValue;
     };
+    static_cast<RuleClass<Type>*>(rule.get())->acceptableKey = [name](const std::string& key) {
+      return key == name;
+    };
+    static_cast<RuleClass<Type>*>(rule.get())->keyName = name;
   }
 };
 
@@ -98,6 +133,9 @@ struct RegexAction
       }
       return returnValue;
     };
+    static_cast<RuleClass<Type>*>(rule.get())->acceptableKey = [regex](const std::string& key) {
+      return smtk::regex_match(key, regex);
+    };
   }
 };
 
@@ -114,6 +152,13 @@ struct ValueAction
     static_cast<RuleClass<Type>*>(rule.get())->acceptableValue = [value](const Type& val) -> bool {
       return val == value;
     };
+    static_cast<RuleClass<Type>*>(rule.get())->indexedValue =
+      [value](
+        const Resource::Properties& properties,
+        const std::string& name,
+        std::unordered_set<smtk::common::UUID>& ids) {
+        return properties.findIds<Type>(name, value, ids);
+      };
   }
 };
 
@@ -130,6 +175,17 @@ struct ValueRegexAction
     static_cast<RuleClass<Type>*>(rule.get())->acceptableValue = [regex](const Type& val) -> bool {
       return smtk::regex_match(val, regex);
     };
+    std::string prefix = regexLiteralPrefix(input.string());
+    if (!prefix.empty())
+    {
+      static_cast<RuleClass<Type>*>(rule.get())->indexedValue =
+        [prefix](
+          const Resource::Properties& properties,
+          const std::string& name,
+          std::unordered_set<smtk::common::UUID>& ids) {
+          return properties.findIdsWithPrefix<Type>(name, prefix, ids);
+        };
+    }
   }
 };
 } // namespace filter
@@ -20,6 +20,7 @@
 #include "smtk/resource/filter/Grammar.h"
 #include "smtk/resource/filter/Rules.h"
 
+#include <memory>
 #include <string>
 
 namespace smtk
@@ -39,47 +40,30 @@ class Filter
 public:
   Filter(const std::string& str)
     : m_filterString(str)
-    , m_rules(std::move(constructRules(str)))
+    , m_rules(std::make_shared<const Rules>(constructRules(str)))
   {
   }
   virtual ~Filter() = default;
 
   // Specific filter rules are composed by parsing string inputs, and are
   // therefore inherently runtime-constructed objects (and, thus, are allocated
-  // on the heap). To accommodate their memory management, these objects are
-  // stored using a std::unique_ptr, which has move-only semantics.
-  // smtk:::resource::filter::Filter must satisfy the API for
+  // on the heap). smtk:::resource::filter::Filter must satisfy the API for
   // smtk::resource::Resource::queryOperation, which returns a std::function by
-  // value. As a result, this class Defines copy construction and assignment by
-  // reconstructing the internal rule when necessary.
+  // value. Since rules are not modified once parsed, copies of a filter share
+  // its rules rather than reparsing the filter string.
+  Filter(const Filter& other) = default;
+  Filter(Filter&& other) noexcept = default;
+  Filter& operator=(const Filter& other) = default;
+  Filter& operator=(Filter&& other) noexcept = default;
 
-  Filter(const Filter& other)
-    : m_filterString(other.m_filterString)
-    , m_rules(std::move(constructRules(other.m_filterString)))
-  {
-  }
-
-  Filter(Filter&& other) noexcept
-    : m_filterString(std::move(other.m_filterString))
-    , m_rules(std::move(other.m_rules))
-  {
-  }
+  bool operator()(const Component& component) const { return (*m_rules)(component); }
 
-  Filter& operator=(const Filter& other)
-  {
-    m_filterString = other.m_filterString;
-    m_rules = constructRules(other.m_filterString);
-    return *this;
-  }
-
-  Filter& operator=(Filter&& other) noexcept
-  {
-    m_filterString = other.m_filterString;
-    m_rules = std::move(other.m_rules);
-    return *this;
-  }
+  /// Return the filter string this filter was constructed from.
+  const std::string& filterString() const { return m_filterString; }
 
-  bool operator()(const Component& component) const { return m_rules(component); }
+  /// Return the parsed rules, which may be shared with other filters or
+  /// cached (see smtk::resource::Resource::queryRules()).
+  const std::shared_ptr<const Rules>& rules() const { return m_rules; }
 
 private:
   smtk::resource::filter::Rules constructRules(const std::string& filterString)
@@ -113,7 +97,7 @@ private:
   }
 
   std::string m_filterString;
-  smtk::resource::filter::Rules m_rules;
+  std::shared_ptr<const smtk::resource::filter::Rules> m_rules;
 };
 } // namespace filter
 } // namespace resource
@@ -31,12 +31,13 @@ struct Name : plus<not_one<'\''>>
 
 /// Match a persistent-object type-name that is not quoted.
 ///
-/// We continue until a square-bracket opening a property-clause appears.
-/// This assumes that bare names are always followed by either EOF or a
-/// property clause. If we ever want to match a succession of components
-/// (say, by following arcs), this will need to change.
+/// We continue until a square-bracket opening a property-clause appears
+/// or an arc-path step (see smtk::graph::filter::ArcPath) begins with
+/// "-[" or "<-[". This assumes that bare names are always followed by EOF,
+/// a property clause, or a path step.
 template<typename Type>
-struct BareName : plus<not_one<'['>>
+struct BareName
+  : plus<not_at<sor<string<'-', '['>, string<'<', '-', '['>>>, not_one<'['>>
 {
 };
 
@@ -10,14 +10,22 @@
 #ifndef smtk_resource_filter_Rule_h
 #define smtk_resource_filter_Rule_h
 
+#include "smtk/common/UUID.h"
+#include "smtk/common/Visit.h"
 #include "smtk/resource/PersistentObject.h"
 
 #include <algorithm>
+#include <functional>
+#include <unordered_set>
 
 namespace smtk
 {
 namespace resource
 {
+
+class Component;
+class Resource;
+
 namespace filter
 {
 
@@ -28,6 +36,39 @@ public:
   virtual ~Rule() = default;
 
   virtual bool operator()(const PersistentObject&) const = 0;
+
+  /// Insert into \a ids the UUIDs of every component of \a resource that
+  /// might satisfy this rule, using indexes held by the resource rather than
+  /// visiting each component. Return false if the rule cannot be planned
+  /// this way (the default), in which case \a ids is left unmodified.
+  ///
+  /// The set of candidates may include objects that do not satisfy the rule;
+  /// callers must still evaluate the rule on each candidate.
+  virtual bool candidates(const Resource& resource, std::unordered_set<smtk::common::UUID>& ids)
+    const
+  {
+    (void)resource;
+    (void)ids;
+    return false;
+  }
+
+  /// Invoke \a visitor on components of \a resource that satisfy this rule
+  /// by enumerating them directly (for example, by traversing arcs from
+  /// other components) rather than testing each component in turn. Return
+  /// false if the rule cannot enumerate its matches (the default), in which
+  /// case \a visitor is never invoked.
+  ///
+  /// Each component is passed to \a visitor at most once; iteration stops
+  /// if \a visitor returns smtk::common::Visit::Halt. Components are not
+  /// tested against other rules, so callers must still do so.
+  virtual bool generate(
+    const Resource& resource,
+    const std::function<smtk::common::Visit(const Component*)>& visitor) const
+  {
+    (void)resource;
+    (void)visitor;
+    return false;
+  }
 };
 
 } // namespace filter
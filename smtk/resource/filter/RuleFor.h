@@ -11,9 +11,12 @@
 #define smtk_resource_filter_RuleFor_h
 
 #include "smtk/resource/PersistentObject.h"
+#include "smtk/resource/Resource.h"
 #include "smtk/resource/filter/Rule.h"
 
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace smtk
 {
@@ -44,10 +47,62 @@ public:
       });
   }
 
+  // Collect the components whose properties satisfy this rule directly from
+  // the resource's property storage (which holds the properties of all of its
+  // components) rather than by visiting each component.
+  bool candidates(const Resource& resource, std::unordered_set<smtk::common::UUID>& ids)
+    const override
+  {
+    // Prefer a value index on the named property when one has been declared.
+    if (!keyName.empty() && indexedValue && indexedValue(resource.properties(), keyName, ids))
+    {
+      return true;
+    }
+
+    using IndexedType = std::unordered_map<smtk::common::UUID, Type>;
+    const auto& data = resource.properties().data();
+    if (!acceptableKey || !data.template containsType<IndexedType>())
+    {
+      return false;
+    }
+    for (const auto& entry : data.template get<IndexedType>().data())
+    {
+      if (!acceptableKey(entry.first))
+      {
+        continue;
+      }
+      for (const auto& idAndValue : entry.second)
+      {
+        if (acceptableValue(idAndValue.second))
+        {
+          ids.insert(idAndValue.first);
+        }
+      }
+    }
+    return true;
+  }
+
   // Given a persistent object, return a vector of keys that match the
   // name filter.
   std::function<std::vector<std::string>(const PersistentObject&)> acceptableKeys;
 
+  // Given a property key, determine whether it matches the name filter.
+  // This is used for query planning and is unset unless the rule's keys
+  // are discriminated by name or regex.
+  std::function<bool(const std::string&)> acceptableKey;
+
+  // The property name, when the rule names a single property.
+  std::string keyName;
+
+  // Given a resource's properties and a property name, insert into the set
+  // the UUIDs of objects whose values might pass the filter using a value
+  // index on the property. Returns false if the property is not indexed.
+  std::function<bool(
+    const Resource::Properties&,
+    const std::string&,
+    std::unordered_set<smtk::common::UUID>&)>
+    indexedValue;
+
   // Given a value, determine whether this passes the filter.
   std::function<bool(const Type&)> acceptableValue;
 };
@@ -58,6 +58,19 @@ struct ValueAction<std::vector<Type>, RuleClass>
       }
       return true;
     };
+    if (!value.empty())
+    {
+      // Value indexes of vector properties index each element; any object
+      // with a matching first element is a candidate.
+      Type first = value.front();
+      static_cast<RuleClass<std::vector<Type>>*>(rule.get())->indexedValue =
+        [first](
+          const Resource::Properties& properties,
+          const std::string& name,
+          std::unordered_set<smtk::common::UUID>& ids) {
+          return properties.findIds<std::vector<Type>>(name, first, ids);
+        };
+    }
   }
 };
 
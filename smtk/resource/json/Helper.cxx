@@ -27,7 +27,9 @@ namespace resource
 namespace json
 {
 
-smtk::common::ThreadPool<> Helper::m_threadPool;
+smtk::common::Executor Helper::m_threadPool(
+  smtk::common::Executor::instance(),
+  smtk::common::Executor::Priority::Background);
 
 Helper::Helper() = default;
 Helper::~Helper() = default;
@@ -13,7 +13,7 @@
 #include "smtk/resource/Resource.h"
 
 #include "smtk/common/Managers.h"
-#include "smtk/common/ThreadPool.h"
+#include "smtk/common/Executor.h"
 #include "smtk/common/TypeName.h"
 
 #include <exception>
@@ -103,8 +103,11 @@ public:
   ///
   /// This is intended to offload I/O for external data to
   /// background threads that can be joined before the read
-  /// operation completes.
-  static smtk::common::ThreadPool<>& threadPool() { return m_threadPool; }
+  /// operation completes. The executor shares its workers with
+  /// Executor::instance() (and thus the default operation launcher);
+  /// tasks submitted with its call operator run at
+  /// Executor::Priority::Background so that they yield to operations.
+  static smtk::common::Executor& threadPool() { return m_threadPool; }
 
   std::vector<std::future<void>>& futures() { return m_futures; }
 
@@ -116,7 +119,7 @@ protected:
   bool m_topLevel = true;
   smtk::resource::Resource::Ptr m_parent;
   std::vector<std::future<void>> m_futures;
-  static smtk::common::ThreadPool<> m_threadPool;
+  static smtk::common::Executor m_threadPool;
 };
 
 } // namespace json
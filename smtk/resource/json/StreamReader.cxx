@@ -0,0 +1,132 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/resource/json/StreamReader.h"
+
+#include "smtk/io/Logger.h"
+
+#include <exception>
+
+namespace smtk
+{
+namespace resource
+{
+namespace json
+{
+
+StreamReader::StreamReader(std::istream& stream)
+  : m_stream(stream)
+{
+}
+
+void StreamReader::addArray(const std::string& key, ElementFunction consumer)
+{
+  m_arrays[key] = std::move(consumer);
+}
+
+void StreamReader::skip(const std::string& key)
+{
+  m_skipped.insert(key);
+}
+
+bool StreamReader::read(json& document)
+{
+  m_consumer = nullptr;
+  m_inArray = false;
+  m_inObject = false;
+  m_document = json::object();
+  json result;
+  try
+  {
+    result = json::parse(m_stream, [this](int depth, json::parse_event_t event, json& value) {
+      return this->parsed(depth, event, value);
+    });
+  }
+  catch (std::exception& e)
+  {
+    smtkErrorMacro(smtk::io::Logger::instance(), "Could not read JSON: " << e.what());
+    return false;
+  }
+  // Members of a top-level object have been moved into m_document as they
+  // were parsed; any other value is returned as parsed.
+  document = result.is_object() ? std::move(m_document) : std::move(result);
+  m_document = json::object();
+  return true;
+}
+
+bool StreamReader::parsed(int depth, json::parse_event_t event, json& value)
+{
+  // Top-level members are at depth 1 and the elements of arrays they hold
+  // are at depth 2. Deeper events belong to an element and are kept.
+  if (depth == 0)
+  {
+    if (event == json::parse_event_t::object_start)
+    {
+      m_inObject = true;
+    }
+    return true;
+  }
+  if (depth == 1)
+  {
+    switch (event)
+    {
+      case json::parse_event_t::key:
+      {
+        m_inArray = false;
+        m_key = value.get_ref<const std::string&>();
+        auto it = m_arrays.find(m_key);
+        m_consumer = it == m_arrays.end() ? nullptr : &it->second;
+        m_keep = m_consumer ||
+          (!m_skipUnregistered && m_skipped.find(m_key) == m_skipped.end());
+        return m_keep;
+      }
+      case json::parse_event_t::array_start:
+        m_inArray = m_consumer != nullptr;
+        break;
+      case json::parse_event_t::array_end:
+      case json::parse_event_t::object_end:
+      case json::parse_event_t::value:
+        if (!m_inObject)
+        {
+          break;
+        }
+        m_inArray = false;
+        if (m_consumer)
+        {
+          // The consumed array is now empty; discard it.
+          m_consumer = nullptr;
+          return false;
+        }
+        // Move the completed member into the document so that consumers of
+        // later members may inspect it. (Skipped members still report their
+        // scalar values.)
+        if (m_keep)
+        {
+          m_document[m_key] = std::move(value);
+        }
+        return false;
+      default:
+        break;
+    }
+    return true;
+  }
+  if (depth == 2 && m_inArray &&
+      (event == json::parse_event_t::value || event == json::parse_event_t::object_end ||
+       event == json::parse_event_t::array_end))
+  {
+    (*m_consumer)(value);
+    // Discard the element now that it has been consumed.
+    return false;
+  }
+  return true;
+}
+
+} // namespace json
+} // namespace resource
+} // namespace smtk
@@ -0,0 +1,98 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_resource_json_StreamReader_h
+#define smtk_resource_json_StreamReader_h
+
+#include "smtk/CoreExports.h"
+
+#include "nlohmann/json.hpp"
+
+#include <functional>
+#include <istream>
+#include <map>
+#include <set>
+#include <string>
+
+namespace smtk
+{
+namespace resource
+{
+namespace json
+{
+
+/**\brief Read a JSON document from a stream without holding all of it in memory.
+  *
+  * Members of the top-level object that hold large arrays may be registered
+  * with addArray(). Each element of such an array is passed to its consumer
+  * as soon as it has been parsed and is then discarded, so that only one
+  * element is held in memory at a time. Members registered with skip() are
+  * scanned but never constructed.
+  *
+  * The document returned by read() holds all other members of the top-level
+  * object. Consumers are invoked while the document is being parsed; one
+  * that depends on other members (for example, attributes that depend on
+  * their definitions) may inspect the members that precede its array in
+  * the stream with document().
+  */
+class SMTKCORE_EXPORT StreamReader
+{
+public:
+  using json = nlohmann::json;
+
+  /// Consume one (parsed) element of an array. The consumer may move
+  /// from \a element.
+  using ElementFunction = std::function<void(json& element)>;
+
+  StreamReader(std::istream& stream);
+
+  /// Pass each element of the top-level member \a key to \a consumer.
+  void addArray(const std::string& key, ElementFunction consumer);
+
+  /// Do not construct the top-level member \a key.
+  void skip(const std::string& key);
+
+  /// When true, top-level members that have not been registered with
+  /// addArray() are skipped. This is false by default.
+  void setSkipUnregistered(bool skip) { m_skipUnregistered = skip; }
+  bool skipUnregistered() const { return m_skipUnregistered; }
+
+  /// Parse the stream into \a document, passing array elements to consumers.
+  ///
+  /// Returns false (after logging an error) if the stream could not be
+  /// parsed or a consumer threw an exception.
+  bool read(json& document);
+
+  /// The top-level members (other than those consumed or skipped) that have
+  /// been parsed so far. This may be called by consumers during read().
+  const json& document() const { return m_document; }
+
+private:
+  bool parsed(int depth, json::parse_event_t event, json& value);
+
+  std::istream& m_stream;
+  std::map<std::string, ElementFunction> m_arrays;
+  std::set<std::string> m_skipped;
+  bool m_skipUnregistered{ false };
+  // The consumer of the top-level member being parsed (if any) and whether
+  // its array has begun.
+  ElementFunction* m_consumer{ nullptr };
+  bool m_inArray{ false };
+  // Completed top-level members are moved here as they are parsed.
+  json m_document;
+  std::string m_key;
+  bool m_keep{ false };
+  bool m_inObject{ false };
+};
+
+} // namespace json
+} // namespace resource
+} // namespace smtk
+
+#endif // smtk_resource_json_StreamReader_h
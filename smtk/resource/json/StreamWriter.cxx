@@ -0,0 +1,224 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/resource/json/StreamWriter.h"
+
+#include "smtk/common/Executor.h"
+
+#include "smtk/io/Logger.h"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <future>
+
+namespace smtk
+{
+namespace resource
+{
+namespace json
+{
+
+StreamWriter::StreamWriter(std::ostream& stream, int indent, smtk::common::Executor* executor)
+  : m_stream(stream)
+  , m_indent(indent)
+  , m_executor(executor)
+{
+}
+
+void StreamWriter::addArray(const std::string& key, std::size_t size, ElementFunction element)
+{
+  m_arrays[key] = ArraySource{ size, std::move(element) };
+}
+
+bool StreamWriter::write(const json& document)
+{
+  if (!m_arrays.empty() && !document.is_object())
+  {
+    smtkErrorMacro(
+      smtk::io::Logger::instance(), "Only an object may have arrays written to its members.");
+    return false;
+  }
+  try
+  {
+    if (m_arrays.empty())
+    {
+      m_stream << this->dump(document, 0);
+      return m_stream.good();
+    }
+
+    // Interleave the document's members with the added arrays in key order
+    // (or write the arrays after all of the members).
+    const auto& members = document.get_ref<const json::object_t&>();
+    auto member = members.begin();
+    auto array = m_arrays.begin();
+    bool first = true;
+    m_stream << '{';
+    while (member != members.end() || array != m_arrays.end())
+    {
+      bool isArray = array != m_arrays.end() &&
+        (member == members.end() || (!m_arraysLast && !(member->first < array->first)));
+      if (!isArray && m_arraysLast && m_arrays.find(member->first) != m_arrays.end())
+      {
+        // This member is replaced by an added array.
+        ++member;
+        continue;
+      }
+      const std::string& key = isArray ? array->first : member->first;
+      if (!first)
+      {
+        m_stream << ',';
+      }
+      first = false;
+      this->newline(1);
+      m_stream << json(key).dump() << (m_indent >= 0 ? ": " : ":");
+      if (isArray)
+      {
+        if (!m_arraysLast && member != members.end() && member->first == array->first)
+        {
+          ++member;
+        }
+        this->writeArray(array->second);
+        ++array;
+      }
+      else
+      {
+        m_stream << this->dump(member->second, 1);
+        ++member;
+      }
+    }
+    this->newline(0);
+    m_stream << '}';
+  }
+  catch (std::exception& e)
+  {
+    smtkErrorMacro(smtk::io::Logger::instance(), "Could not serialize JSON: " << e.what());
+    return false;
+  }
+  return m_stream.good();
+}
+
+std::string StreamWriter::dump(const json& value, std::size_t depth) const
+{
+  if (m_indent < 0)
+  {
+    return value.dump();
+  }
+  std::string text = value.dump(m_indent);
+  if (depth == 0)
+  {
+    return text;
+  }
+  // Every newline in the output is structural (newlines in strings are
+  // escaped), so indent the value by following each with the margin.
+  std::string margin = "\n" + std::string(depth * static_cast<std::size_t>(m_indent), ' ');
+  std::string result;
+  result.reserve(text.size());
+  std::size_t start = 0;
+  for (std::size_t pos = text.find('\n'); pos != std::string::npos; pos = text.find('\n', start))
+  {
+    result.append(text, start, pos - start);
+    result.append(margin);
+    start = pos + 1;
+  }
+  result.append(text, start, std::string::npos);
+  return result;
+}
+
+std::string
+StreamWriter::dumpChunk(const ArraySource& source, std::size_t begin, std::size_t end) const
+{
+  std::string separator =
+    m_indent >= 0 ? ",\n" + std::string(2 * static_cast<std::size_t>(m_indent), ' ') : ",";
+  std::string text;
+  for (std::size_t ii = begin; ii < end; ++ii)
+  {
+    json element;
+    source.m_element(ii, element);
+    if (ii > begin)
+    {
+      text += separator;
+    }
+    text += this->dump(element, 2);
+  }
+  return text;
+}
+
+void StreamWriter::writeArray(const ArraySource& source)
+{
+  if (source.m_size == 0)
+  {
+    m_stream << "[]";
+    return;
+  }
+  m_stream << '[';
+  std::size_t numberOfChunks = (source.m_size + m_chunkSize - 1) / m_chunkSize;
+  auto chunkEnd = [this, &source](std::size_t chunk) {
+    return std::min(source.m_size, (chunk + 1) * m_chunkSize);
+  };
+  if (!m_executor || numberOfChunks == 1)
+  {
+    for (std::size_t chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      m_stream << (chunk > 0 ? "," : "");
+      this->newline(2);
+      m_stream << this->dumpChunk(source, chunk * m_chunkSize, chunkEnd(chunk));
+    }
+  }
+  else
+  {
+    // Keep up to m_maxChunksInFlight chunks queued or completed but not
+    // yet written; write them in order as they become available.
+    std::deque<std::future<std::string>> pending;
+    std::size_t submitted = 0;
+    try
+    {
+      for (std::size_t chunk = 0; chunk < numberOfChunks; ++chunk)
+      {
+        for (; submitted < numberOfChunks && pending.size() < m_maxChunksInFlight; ++submitted)
+        {
+          std::size_t begin = submitted * m_chunkSize;
+          std::size_t end = chunkEnd(submitted);
+          pending.push_back((*m_executor)(
+            [this, &source, begin, end]() { return this->dumpChunk(source, begin, end); }));
+        }
+        auto next = std::move(pending.front());
+        pending.pop_front();
+        m_executor->wait(next);
+        std::string text = next.get();
+        m_stream << (chunk > 0 ? "," : "");
+        this->newline(2);
+        m_stream << text;
+      }
+    }
+    catch (...)
+    {
+      // Queued chunks refer to the source, so let them finish before unwinding.
+      for (const auto& future : pending)
+      {
+        m_executor->wait(future);
+      }
+      throw;
+    }
+  }
+  this->newline(1);
+  m_stream << ']';
+}
+
+void StreamWriter::newline(std::size_t depth)
+{
+  if (m_indent >= 0)
+  {
+    m_stream << '\n' << std::string(depth * static_cast<std::size_t>(m_indent), ' ');
+  }
+}
+
+} // namespace json
+} // namespace resource
+} // namespace smtk
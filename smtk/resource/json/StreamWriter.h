@@ -0,0 +1,114 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_resource_json_StreamWriter_h
+#define smtk_resource_json_StreamWriter_h
+
+#include "smtk/CoreExports.h"
+
+#include "nlohmann/json.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace smtk
+{
+namespace common
+{
+class Executor;
+}
+namespace resource
+{
+namespace json
+{
+
+/**\brief Write a JSON document to a stream without holding all of it in memory.
+  *
+  * The bytes written are identical to those of `document.dump(indent)` (or,
+  * when \a indent is negative, of `stream << document`). However, members of
+  * the top-level object that hold large arrays may be registered with
+  * addArray() instead of being placed in the document. Elements of these
+  * arrays are converted to JSON in chunks of chunkSize() elements – in
+  * parallel when an executor is provided – and each chunk is written as soon
+  * as it and all the chunks before it are complete. No more than
+  * maxChunksInFlight() chunks are held in memory at once.
+  *
+  * Because nlohmann::json orders object keys lexically, registered arrays
+  * are written in key order among the document's members unless
+  * setArraysLast() is enabled. Writing them last lets a StreamReader
+  * present all of the other members to the arrays' consumers.
+  */
+class SMTKCORE_EXPORT StreamWriter
+{
+public:
+  using json = nlohmann::json;
+
+  /// Populate \a element with the JSON for the array entry at \a index.
+  ///
+  /// When the writer has an executor, this is called concurrently (for
+  /// distinct indices) from the executor's worker threads.
+  using ElementFunction = std::function<void(std::size_t index, json& element)>;
+
+  StreamWriter(std::ostream& stream, int indent = -1, smtk::common::Executor* executor = nullptr);
+
+  /// Set/get the number of array elements serialized by each task.
+  void setChunkSize(std::size_t chunkSize) { m_chunkSize = chunkSize > 0 ? chunkSize : 1; }
+  std::size_t chunkSize() const { return m_chunkSize; }
+
+  /// Set/get the number of chunks that may be pending or awaiting output at once.
+  void setMaxChunksInFlight(std::size_t count) { m_maxChunksInFlight = count > 0 ? count : 1; }
+  std::size_t maxChunksInFlight() const { return m_maxChunksInFlight; }
+
+  /// Set/get whether added arrays are written after all of the document's
+  /// members (in key order among themselves). This is false by default.
+  void setArraysLast(bool last) { m_arraysLast = last; }
+  bool arraysLast() const { return m_arraysLast; }
+
+  /// Write an array of \a size elements produced by \a element as the
+  /// top-level member named \a key (replacing any member of the same name
+  /// in the document passed to write()).
+  void addArray(const std::string& key, std::size_t size, ElementFunction element);
+
+  /// Write \a document (which must be an object if arrays have been added).
+  ///
+  /// Returns false if the document could not be serialized or the stream
+  /// could not be written.
+  bool write(const json& document);
+
+private:
+  struct ArraySource
+  {
+    std::size_t m_size;
+    ElementFunction m_element;
+  };
+
+  // Return the text of \a value as it appears at the given nesting depth.
+  std::string dump(const json& value, std::size_t depth) const;
+  // Return the elements [begin, end[ of \a source, separated as in an array.
+  std::string dumpChunk(const ArraySource& source, std::size_t begin, std::size_t end) const;
+  void writeArray(const ArraySource& source);
+  void newline(std::size_t depth);
+
+  std::ostream& m_stream;
+  int m_indent;
+  smtk::common::Executor* m_executor;
+  std::size_t m_chunkSize{ 256 };
+  std::size_t m_maxChunksInFlight{ 16 };
+  bool m_arraysLast{ false };
+  std::map<std::string, ArraySource> m_arrays;
+};
+
+} // namespace json
+} // namespace resource
+} // namespace smtk
+
+#endif // smtk_resource_json_StreamWriter_h
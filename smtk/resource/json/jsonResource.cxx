@@ -11,16 +11,233 @@
 
 #include "smtk/resource/json/jsonResourceLinkBase.h"
 
+#include "smtk/common/ChunkedFile.h"
+#include "smtk/common/Paths.h"
 #include "smtk/common/json/jsonLinks.h"
 #include "smtk/common/json/jsonTypeMap.h"
 #include "smtk/common/json/jsonUUID.h"
 
+#include "smtk/io/Logger.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 // Ignore warning about non-inlined template specializations of smtk::common::Helper<>
 #if defined(_WIN32) || defined(WIN32) || defined(__CYGWIN__)
 #pragma warning(disable : 4506) /* no definition for inline function */
 #endif
 
 using nlohmann::json;
+
+namespace
+{
+template<typename Type>
+using Indexed = std::unordered_map<smtk::common::UUID, Type>;
+
+// Resolve a properties file named relative to the directory holding the resource.
+std::string propertiesPath(const smtk::resource::ResourcePtr& resource, const std::string& filename)
+{
+  if (!smtk::common::Paths::isRelative(filename) || resource->location().empty())
+  {
+    return filename;
+  }
+  std::string directory = smtk::common::Paths::directory(resource->location());
+  return directory.empty() ? filename : directory + "/" + filename;
+}
+
+// Property tables of scalar values are stored as parallel arrays of ids and
+// values. Values are converted to a fixed-size \a Stored type so that files
+// are portable between platforms whose integers differ in size.
+template<typename Type, typename Stored>
+struct ScalarTable
+{
+  static void write(
+    const smtk::resource::detail::Properties& data,
+    smtk::common::ChunkedFileWriter& writer,
+    json& tables)
+  {
+    const std::string typeName = smtk::common::typeName<Indexed<Type>>();
+    for (const auto& property : data.get<Indexed<Type>>().data())
+    {
+      const std::string prefix = std::to_string(tables.size());
+      std::vector<smtk::common::UUID> ids;
+      std::vector<Stored> values;
+      ids.reserve(property.second.size());
+      values.reserve(property.second.size());
+      for (const auto& entry : property.second)
+      {
+        ids.push_back(entry.first);
+        values.push_back(static_cast<Stored>(entry.second));
+      }
+      writer.addArray(prefix + "/ids", std::move(ids));
+      writer.addArray(prefix + "/values", std::move(values));
+      tables.push_back({ { "type", typeName }, { "name", property.first }, { "arrays", prefix } });
+    }
+  }
+
+  static bool read(
+    const smtk::common::ChunkedFileReader& reader,
+    const json& table,
+    smtk::resource::detail::Properties& data)
+  {
+    const std::string prefix = table.at("arrays").get<std::string>();
+    auto ids = reader.materialize<smtk::common::UUID>(prefix + "/ids");
+    auto values = reader.materialize<Stored>(prefix + "/values");
+    if (ids.size() != values.size() || ids.size() != reader.size(prefix + "/ids"))
+    {
+      return false;
+    }
+    auto& entry = data.get<Indexed<Type>>();
+    auto& property = entry.data()[table.at("name").get<std::string>()];
+    property.reserve(property.size() + ids.size());
+    for (std::size_t ii = 0; ii < ids.size(); ++ii)
+    {
+      property[ids[ii]] = static_cast<Type>(values[ii]);
+    }
+    static_cast<smtk::resource::detail::PropertiesOfType<Indexed<Type>>&>(entry)
+      .invalidateIndexes();
+    return true;
+  }
+};
+
+// Property tables of vector values add an array of offsets (one more than the
+// number of ids) into a single array holding every vector's elements.
+template<typename Type, typename Stored>
+struct VectorTable
+{
+  static void write(
+    const smtk::resource::detail::Properties& data,
+    smtk::common::ChunkedFileWriter& writer,
+    json& tables)
+  {
+    const std::string typeName = smtk::common::typeName<Indexed<std::vector<Type>>>();
+    for (const auto& property : data.get<Indexed<std::vector<Type>>>().data())
+    {
+      const std::string prefix = std::to_string(tables.size());
+      std::vector<smtk::common::UUID> ids;
+      std::vector<std::uint64_t> offsets;
+      std::vector<Stored> values;
+      ids.reserve(property.second.size());
+      offsets.reserve(property.second.size() + 1);
+      offsets.push_back(0);
+      for (const auto& entry : property.second)
+      {
+        ids.push_back(entry.first);
+        values.insert(values.end(), entry.second.begin(), entry.second.end());
+        offsets.push_back(values.size());
+      }
+      writer.addArray(prefix + "/ids", std::move(ids));
+      writer.addArray(prefix + "/offsets", std::move(offsets));
+      writer.addArray(prefix + "/values", std::move(values));
+      tables.push_back({ { "type", typeName }, { "name", property.first }, { "arrays", prefix } });
+    }
+  }
+
+  static bool read(
+    const smtk::common::ChunkedFileReader& reader,
+    const json& table,
+    smtk::resource::detail::Properties& data)
+  {
+    const std::string prefix = table.at("arrays").get<std::string>();
+    auto ids = reader.materialize<smtk::common::UUID>(prefix + "/ids");
+    auto offsets = reader.materialize<std::uint64_t>(prefix + "/offsets");
+    auto values = reader.view<Stored>(prefix + "/values");
+    std::vector<Stored> copied;
+    if (values.size() != reader.size(prefix + "/values"))
+    {
+      // Views are unavailable on big-endian hosts; copy the values instead.
+      copied = reader.materialize<Stored>(prefix + "/values");
+    }
+    const Stored* begin = copied.empty() ? values.data() : copied.data();
+    const std::size_t count = copied.empty() ? values.size() : copied.size();
+    if (
+      ids.size() != reader.size(prefix + "/ids") || offsets.size() != ids.size() + 1 ||
+      offsets.front() != 0 || offsets.back() != count)
+    {
+      return false;
+    }
+    auto& entry = data.get<Indexed<std::vector<Type>>>();
+    auto& property = entry.data()[table.at("name").get<std::string>()];
+    property.reserve(property.size() + ids.size());
+    for (std::size_t ii = 0; ii < ids.size(); ++ii)
+    {
+      if (offsets[ii] > offsets[ii + 1] || offsets[ii + 1] > count)
+      {
+        return false;
+      }
+      property[ids[ii]] = std::vector<Type>(begin + offsets[ii], begin + offsets[ii + 1]);
+    }
+    static_cast<smtk::resource::detail::PropertiesOfType<Indexed<std::vector<Type>>>&>(entry)
+      .invalidateIndexes();
+    return true;
+  }
+};
+
+// The property types stored in chunked files, keyed by the names that
+// smtk::resource::detail::Properties gives them.
+struct PropertyTable
+{
+  using WriteFunction =
+    void (*)(const smtk::resource::detail::Properties&, smtk::common::ChunkedFileWriter&, json&);
+  using ReadFunction = bool (*)(
+    const smtk::common::ChunkedFileReader&, const json&, smtk::resource::detail::Properties&);
+
+  std::string typeName;
+  WriteFunction write;
+  ReadFunction read;
+};
+
+template<typename Table, typename Type>
+PropertyTable propertyTable()
+{
+  return { smtk::common::typeName<Indexed<Type>>(), &Table::write, &Table::read };
+}
+
+const std::vector<PropertyTable>& propertyTables()
+{
+  static const std::vector<PropertyTable> tables = {
+    propertyTable<ScalarTable<int, std::int32_t>, int>(),
+    propertyTable<ScalarTable<long, std::int64_t>, long>(),
+    propertyTable<ScalarTable<double, double>, double>(),
+    propertyTable<VectorTable<int, std::int32_t>, std::vector<int>>(),
+    propertyTable<VectorTable<long, std::int64_t>, std::vector<long>>(),
+    propertyTable<VectorTable<double, double>, std::vector<double>>(),
+  };
+  return tables;
+}
+
+bool readPropertiesFile(const smtk::resource::ResourcePtr& resource, const std::string& filename)
+{
+  auto reader = smtk::common::ChunkedFileReader::open(propertiesPath(resource, filename));
+  if (!reader)
+  {
+    return false;
+  }
+  auto jTables = reader->header().find("tables");
+  if (jTables == reader->header().end())
+  {
+    return false;
+  }
+  auto& data = resource->properties().data();
+  for (const auto& table : *jTables)
+  {
+    const auto& typeName = table.at("type").get_ref<const std::string&>();
+    const auto& tables = propertyTables();
+    auto it = std::find_if(tables.begin(), tables.end(), [&typeName](const PropertyTable& entry) {
+      return entry.typeName == typeName;
+    });
+    if (it == tables.end() || !(*it->read)(*reader, table, data))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // anonymous namespace
+
 // Define how resources are serialized.
 namespace smtk
 {
@@ -71,10 +288,47 @@ void from_json(const json& j, ResourcePtr& resource)
     smtk::common::from_json(j.at("properties"), resource->properties().data());
   }
 
+  // Numeric property tables may be held in a chunked file (see writePropertiesFile()).
+  auto jPropertiesFile = j.find("properties-file");
+  if (
+    jPropertiesFile != j.end() &&
+    !readPropertiesFile(resource, jPropertiesFile->get<std::string>()))
+  {
+    smtkErrorMacro(
+      smtk::io::Logger::instance(),
+      "Could not read properties from \"" << jPropertiesFile->get<std::string>() << "\".");
+  }
+
   if (j.find("name") != j.end())
   {
     resource->setName(j.at("name"));
   }
 }
+
+bool writePropertiesFile(json& j, const ResourcePtr& resource, const std::string& filename)
+{
+  smtk::common::ChunkedFileWriter writer;
+  json& tables = writer.header()["tables"] = json::array();
+  const auto& data = resource->properties().data();
+  for (const auto& table : propertyTables())
+  {
+    (*table.write)(data, writer, tables);
+  }
+  if (!writer.write(propertiesPath(resource, filename)))
+  {
+    return false;
+  }
+
+  auto jProperties = j.find("properties");
+  if (jProperties != j.end())
+  {
+    for (const auto& table : propertyTables())
+    {
+      jProperties->erase(table.typeName);
+    }
+  }
+  j["properties-file"] = filename;
+  return true;
+}
 } // namespace resource
 } // namespace smtk
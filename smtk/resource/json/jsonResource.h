@@ -16,6 +16,8 @@
 
 #include "nlohmann/json.hpp"
 
+#include <string>
+
 // Define how resources are serialized.
 namespace smtk
 {
@@ -23,6 +25,19 @@ namespace resource
 {
 SMTKCORE_EXPORT void to_json(nlohmann::json&, const ResourcePtr&);
 SMTKCORE_EXPORT void from_json(const nlohmann::json&, ResourcePtr&);
+
+/**\brief Move the numeric property tables of \a resource out of \a j.
+  *
+  * Integer and floating-point properties (and vectors of them) held in
+  * \a j (as produced by to_json()) are written to the chunked file
+  * \a filename and removed from \a j, which records the file so that
+  * from_json() reads them back. A relative \a filename is taken to be
+  * relative to the directory holding the resource's location.
+  *
+  * Returns false (leaving \a j unmodified) if the file could not be written.
+  */
+SMTKCORE_EXPORT bool
+writePropertiesFile(nlohmann::json& j, const ResourcePtr& resource, const std::string& filename);
 } // namespace resource
 } // namespace smtk
 
@@ -0,0 +1,334 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#ifndef smtk_resource_properties_ValueIndex_h
+#define smtk_resource_properties_ValueIndex_h
+
+#include "smtk/common/UUID.h"
+#include "smtk/string/Token.h"
+
+#include <map>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace smtk
+{
+namespace resource
+{
+namespace properties
+{
+
+/// The kinds of secondary index that may be declared for a property.
+enum class IndexKind
+{
+  Hashed, //!< Accelerate exact-match queries.
+  Ordered //!< Accelerate exact-match, range, and (for strings) prefix queries.
+};
+
+/**\brief Describe how property values of a given \a Type are indexed.
+  *
+  * Each value of an indexed property is converted into zero or more keys.
+  * Scalar values (arithmetic types, strings, and string tokens) are their
+  * own key; each element of a vector of scalars is a key. Other types
+  * cannot be indexed.
+  */
+template<typename Type, typename Enable = void>
+struct IndexKeys
+{
+  static constexpr bool indexable = false;
+  using KeyType = Type;
+};
+
+template<typename Type>
+struct IndexKeys<
+  Type,
+  typename std::enable_if<
+    std::is_arithmetic<Type>::value || std::is_same<Type, std::string>::value ||
+    std::is_same<Type, smtk::string::Token>::value>::type>
+{
+  static constexpr bool indexable = true;
+  using KeyType = Type;
+
+  template<typename Functor>
+  static void visit(const Type& value, Functor functor)
+  {
+    functor(value);
+  }
+};
+
+template<typename Type>
+struct IndexKeys<
+  std::vector<Type>,
+  typename std::enable_if<IndexKeys<Type>::indexable && !std::is_same<Type, bool>::value>::type>
+{
+  static constexpr bool indexable = true;
+  using KeyType = Type;
+
+  template<typename Functor>
+  static void visit(const std::vector<Type>& value, Functor functor)
+  {
+    for (const auto& element : value)
+    {
+      functor(element);
+    }
+  }
+};
+
+/**\brief A secondary index from the keys of property values to the UUIDs
+  *        of the objects holding them.
+  *
+  * A ValueIndex mirrors a single property name's map from UUID to value but
+  * holds only keys; it does not copy values. Instead, the property storage
+  * that owns the index passes the affected value to each method:
+  * insert() is called after a value is added and erase() before a value is
+  * removed. Values about to be modified in place (e.g., through a mutable
+  * reference) are passed to touch() before they change; their keys are
+  * removed immediately and re-indexed from the stored value upon the next
+  * call to synchronize(). When the underlying map has been modified
+  * wholesale, invalidate() forces a complete rebuild.
+  *
+  * Query results are the UUIDs whose values contain a matching key. For
+  * scalar properties these are exact; for vector-valued properties they
+  * are candidates (every object with an element matching the query).
+  */
+template<typename Type, bool Indexable = IndexKeys<Type>::indexable>
+class ValueIndex
+{
+public:
+  using KeyType = typename IndexKeys<Type>::KeyType;
+
+  ValueIndex(IndexKind kind = IndexKind::Hashed)
+    : m_kind(kind)
+  {
+  }
+
+  IndexKind kind() const { return m_kind; }
+
+  /// Index \a value, which object \a uid did not hold until now.
+  void insert(const smtk::common::UUID& uid, const Type& value)
+  {
+    if (m_rebuild)
+    {
+      return;
+    }
+    m_touched.erase(uid);
+    this->insertKeys(uid, value);
+  }
+
+  /// Remove \a value, which object \a uid is about to discard, from the index.
+  void erase(const smtk::common::UUID& uid, const Type& value)
+  {
+    if (m_rebuild)
+    {
+      return;
+    }
+    // The keys of touched values have already been removed.
+    if (m_touched.erase(uid) == 0)
+    {
+      this->eraseKeys(uid, value);
+    }
+  }
+
+  /// Mark the value of \a uid (which is \a value, or null if \a uid has no
+  /// value yet) as about to be modified.
+  void touch(const smtk::common::UUID& uid, const Type* value)
+  {
+    if (!m_rebuild && m_touched.insert(uid).second && value)
+    {
+      this->eraseKeys(uid, *value);
+    }
+  }
+
+  /// Mark the entire index as out of date.
+  void invalidate()
+  {
+    m_rebuild = true;
+    m_touched.clear();
+  }
+
+  /// Bring the index up to date with \a values (the property's current map
+  /// from UUID to value, or nullptr if the property has no values).
+  void synchronize(const std::unordered_map<smtk::common::UUID, Type>* values)
+  {
+    if (m_rebuild)
+    {
+      m_rebuild = false;
+      m_hashed.clear();
+      m_ordered.clear();
+      m_touched.clear();
+      if (values)
+      {
+        for (const auto& entry : *values)
+        {
+          this->insertKeys(entry.first, entry.second);
+        }
+      }
+      return;
+    }
+    if (values)
+    {
+      for (const auto& uid : m_touched)
+      {
+        auto it = values->find(uid);
+        if (it != values->end())
+        {
+          this->insertKeys(uid, it->second);
+        }
+      }
+    }
+    m_touched.clear();
+  }
+
+  /// Return true if the index must be synchronized before it is queried.
+  bool outOfDate() const { return m_rebuild || !m_touched.empty(); }
+  /// Insert the UUIDs of objects with a key equal to \a key into \a ids.
+  void find(const KeyType& key, std::unordered_set<smtk::common::UUID>& ids) const
+  {
+    if (m_kind == IndexKind::Hashed)
+    {
+      auto range = m_hashed.equal_range(key);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        ids.insert(it->second);
+      }
+    }
+    else
+    {
+      auto range = m_ordered.equal_range(key);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        ids.insert(it->second);
+      }
+    }
+  }
+
+  /// Insert the UUIDs of objects with a key in [\a lower, \a upper] into \a ids.
+  /// Returns false (and leaves \a ids unmodified) unless the index is ordered.
+  bool findInRange(
+    const KeyType& lower,
+    const KeyType& upper,
+    std::unordered_set<smtk::common::UUID>& ids) const
+  {
+    if (m_kind != IndexKind::Ordered)
+    {
+      return false;
+    }
+    for (auto it = m_ordered.lower_bound(lower); it != m_ordered.end() && !(upper < it->first);
+         ++it)
+    {
+      ids.insert(it->second);
+    }
+    return true;
+  }
+
+  /// Insert the UUIDs of objects with a key starting with \a prefix into \a ids.
+  /// Returns false (and leaves \a ids unmodified) unless the index is an
+  /// ordered index of strings.
+  template<typename K = KeyType>
+  typename std::enable_if<std::is_same<K, std::string>::value, bool>::type findWithPrefix(
+    const std::string& prefix,
+    std::unordered_set<smtk::common::UUID>& ids) const
+  {
+    if (m_kind != IndexKind::Ordered)
+    {
+      return false;
+    }
+    for (auto it = m_ordered.lower_bound(prefix);
+         it != m_ordered.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+         ++it)
+    {
+      ids.insert(it->second);
+    }
+    return true;
+  }
+
+private:
+  void insertKeys(const smtk::common::UUID& uid, const Type& value)
+  {
+    IndexKeys<Type>::visit(value, [this, &uid](const KeyType& key) {
+      if (m_kind == IndexKind::Hashed)
+      {
+        m_hashed.emplace(key, uid);
+      }
+      else
+      {
+        m_ordered.emplace(key, uid);
+      }
+    });
+  }
+
+  void eraseKeys(const smtk::common::UUID& uid, const Type& value)
+  {
+    IndexKeys<Type>::visit(value, [this, &uid](const KeyType& key) {
+      if (m_kind == IndexKind::Hashed)
+      {
+        ValueIndex::eraseEntry(m_hashed, key, uid);
+      }
+      else
+      {
+        ValueIndex::eraseEntry(m_ordered, key, uid);
+      }
+    });
+  }
+
+  template<typename Container>
+  static void eraseEntry(Container& container, const KeyType& key, const smtk::common::UUID& uid)
+  {
+    auto range = container.equal_range(key);
+    for (auto it = range.first; it != range.second;)
+    {
+      if (it->second == uid)
+      {
+        it = container.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  IndexKind m_kind;
+  bool m_rebuild{ true };
+  std::unordered_multimap<KeyType, smtk::common::UUID> m_hashed;
+  std::multimap<KeyType, smtk::common::UUID> m_ordered;
+  std::unordered_set<smtk::common::UUID> m_touched;
+};
+
+/// Properties whose values cannot be indexed accept (and ignore) all
+/// updates so that property storage can notify indexes uniformly.
+template<typename Type>
+class ValueIndex<Type, false>
+{
+public:
+  ValueIndex(IndexKind kind = IndexKind::Hashed)
+    : m_kind(kind)
+  {
+  }
+
+  IndexKind kind() const { return m_kind; }
+  void insert(const smtk::common::UUID&, const Type&) {}
+  void erase(const smtk::common::UUID&, const Type&) {}
+  void touch(const smtk::common::UUID&, const Type*) {}
+  void invalidate() {}
+  void synchronize(const std::unordered_map<smtk::common::UUID, Type>*) {}
+  bool outOfDate() const { return false; }
+
+private:
+  IndexKind m_kind;
+};
+
+} // namespace properties
+} // namespace resource
+} // namespace smtk
+
+#endif // smtk_resource_properties_ValueIndex_h
@@ -0,0 +1,277 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+
+#include "smtk/resource/json/StreamReader.h"
+#include "smtk/resource/json/StreamWriter.h"
+
+#include "smtk/common/Executor.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include "nlohmann/json.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using json = nlohmann::json;
+using smtk::resource::json::StreamReader;
+using smtk::resource::json::StreamWriter;
+
+namespace
+{
+
+json element(std::size_t index)
+{
+  json result;
+  result["Name"] = "element " + std::to_string(index);
+  result["Index"] = index;
+  if (index % 3 == 0)
+  {
+    result["Notes"] = "line one\nline \"two\"\t\xc3\xa9";
+    result["Values"] = { 0.5 * static_cast<double>(index), json::object(), json::array() };
+  }
+  if (index % 5 == 0)
+  {
+    result["Children"] = { { "a", { 1, 2, 3 } }, { "b", { { "c", nullptr } } } };
+  }
+  return result;
+}
+
+json document(std::size_t count)
+{
+  json result = { { "Alpha", { 1, 2 } },
+                  { "Definitions", { { { "Type", "base" } }, { { "Type", "derived" } } } },
+                  { "Zulu", "last" },
+                  { "empty", json::object() },
+                  { "version", "7.0" } };
+  result["Attributes"] = json::array();
+  result["Nodes"] = json::array();
+  for (std::size_t ii = 0; ii < count; ++ii)
+  {
+    result["Attributes"].push_back(element(ii));
+    result["Nodes"].push_back(ii);
+  }
+  return result;
+}
+
+// Write document(count) with "Attributes" and "Nodes" streamed and return the text.
+std::string streamed(
+  std::size_t count,
+  int indent,
+  smtk::common::Executor* executor,
+  std::size_t chunkSize,
+  bool omitFromDocument)
+{
+  json skeleton = document(count);
+  if (omitFromDocument)
+  {
+    skeleton.erase("Attributes");
+    skeleton.erase("Nodes");
+  }
+  std::ostringstream stream;
+  StreamWriter writer(stream, indent, executor);
+  writer.setChunkSize(chunkSize);
+  writer.setMaxChunksInFlight(2);
+  writer.addArray("Attributes", count, [](std::size_t index, json& jj) { jj = element(index); });
+  writer.addArray("Nodes", count, [](std::size_t index, json& jj) { jj = index; });
+  bool ok = writer.write(skeleton);
+  smtkTest(ok, "Could not write document.");
+  return stream.str();
+}
+
+void testWriter()
+{
+  smtk::common::Executor executor(4);
+  for (std::size_t count : { 0, 1, 7, 100 })
+  {
+    json expected = document(count);
+    for (int indent : { -1, 0, 2, 4 })
+    {
+      std::ostringstream reference;
+      if (indent < 0)
+      {
+        reference << expected;
+      }
+      else
+      {
+        reference << expected.dump(indent);
+      }
+      for (std::size_t chunkSize : { 1, 3, 256 })
+      {
+        for (auto* exec : { static_cast<smtk::common::Executor*>(nullptr), &executor })
+        {
+          for (bool omit : { false, true })
+          {
+            std::string text = streamed(count, indent, exec, chunkSize, omit);
+            smtkTest(
+              text == reference.str(),
+              "Mismatch for " << count << " elements, indent " << indent << ", chunk size "
+                              << chunkSize << (exec ? ", parallel" : ", serial") << ":\n"
+                              << text << "\nexpected\n"
+                              << reference.str());
+          }
+        }
+      }
+    }
+  }
+
+  // Arrays may be written after all other members; members they replace are omitted.
+  for (auto* exec : { static_cast<smtk::common::Executor*>(nullptr), &executor })
+  {
+    std::size_t count = 20;
+    json expected = document(count);
+    std::ostringstream stream;
+    StreamWriter writer(stream, 2, exec);
+    writer.setChunkSize(3);
+    writer.setArraysLast(true);
+    writer.addArray("Attributes", count, [](std::size_t index, json& jj) { jj = element(index); });
+    writer.addArray("Nodes", count, [](std::size_t index, json& jj) { jj = index; });
+    smtkTest(writer.write(expected), "Could not write document.");
+    std::string text = stream.str();
+    smtkTest(json::parse(text) == expected, "Mismatch with arrays last:\n" << text);
+    auto attributes = text.find("\"Attributes\"");
+    smtkTest(
+      text.find("\"version\"") < attributes && text.find("\"Nodes\"") > attributes &&
+        text.find("\"Attributes\"", attributes + 1) == std::string::npos,
+      "Arrays were not written last:\n"
+        << text);
+  }
+
+  // Documents without added arrays are written as-is.
+  {
+    std::ostringstream stream;
+    StreamWriter writer(stream, 2);
+    json plain = { 1, "two", { { "three", 3 } } };
+    smtkTest(writer.write(plain), "Could not write array.");
+    smtkTest(stream.str() == plain.dump(2), "Mismatched plain document.");
+  }
+
+  // Added arrays require an object.
+  {
+    std::ostringstream stream;
+    StreamWriter writer(stream, 2);
+    writer.addArray("x", 1, [](std::size_t, json& jj) { jj = 1; });
+    smtkTest(!writer.write(json::array()), "Expected failure writing members of an array.");
+  }
+
+  // Exceptions thrown while serializing elements are reported as failures.
+  {
+    std::ostringstream stream;
+    StreamWriter writer(stream, 2, &executor);
+    writer.setChunkSize(2);
+    writer.addArray("x", 50, [](std::size_t index, json& jj) {
+      if (index == 17)
+      {
+        throw std::runtime_error("element 17");
+      }
+      jj = index;
+    });
+    smtkTest(!writer.write(json::object()), "Expected failure from a throwing element.");
+  }
+}
+
+void testReader()
+{
+  std::size_t count = 100;
+  json expected = document(count);
+  std::string text = expected.dump(2);
+
+  // Consume attributes one at a time while keeping everything else.
+  {
+    std::istringstream stream(text);
+    StreamReader reader(stream);
+    std::size_t consumed = 0;
+    reader.addArray("Attributes", [&consumed](json& jj) {
+      smtkTest(jj == element(consumed), "Unexpected element " << jj.dump());
+      ++consumed;
+    });
+    json result;
+    smtkTest(reader.read(result), "Could not read document.");
+    smtkTest(consumed == count, "Consumed " << consumed << " of " << count << " attributes.");
+    json remainder = expected;
+    remainder.erase("Attributes");
+    smtkTest(result == remainder, "Unexpected remainder " << result.dump(2));
+  }
+
+  // Consumers may inspect the members that precede their array.
+  {
+    std::size_t count = 10;
+    json expected = document(count);
+    std::ostringstream text;
+    StreamWriter writer(text, 2);
+    writer.setArraysLast(true);
+    writer.addArray("Attributes", count, [](std::size_t index, json& jj) { jj = element(index); });
+    smtkTest(writer.write(expected), "Could not write document.");
+
+    std::istringstream stream(text.str());
+    StreamReader reader(stream);
+    reader.skip("Zulu");
+    std::size_t consumed = 0;
+    reader.addArray("Attributes", [&](json& jj) {
+      const json& members = reader.document();
+      smtkTest(members.size() == 5, "Unexpected preceding members " << members.dump());
+      smtkTest(members["Definitions"] == expected["Definitions"], "Definitions are missing.");
+      smtkTest(members["version"] == "7.0", "Version is missing.");
+      smtkTest(members["Nodes"] == expected["Nodes"], "Nodes are missing.");
+      smtkTest(members.find("Zulu") == members.end(), "Skipped member was kept.");
+      smtkTest(jj == element(consumed), "Unexpected element " << jj.dump());
+      ++consumed;
+    });
+    json result;
+    smtkTest(reader.read(result), "Could not read document.");
+    smtkTest(consumed == count, "Consumed " << consumed << " of " << count << " attributes.");
+    smtkTest(result.size() == 5, "Unexpected document " << result.dump());
+  }
+
+  // Skip attributes, then read only nodes.
+  {
+    std::istringstream stream(text);
+    StreamReader reader(stream);
+    reader.skip("Attributes");
+    reader.skip("Nodes");
+    json result;
+    smtkTest(reader.read(result), "Could not read document.");
+    smtkTest(result.find("Attributes") == result.end(), "Attributes were not skipped.");
+    smtkTest(result.find("Nodes") == result.end(), "Nodes were not skipped.");
+    smtkTest(result["Definitions"] == expected["Definitions"], "Definitions were not read.");
+
+    std::istringstream again(text);
+    StreamReader second(again);
+    second.setSkipUnregistered(true);
+    std::size_t sum = 0;
+    second.addArray("Nodes", [&sum](json& jj) { sum += jj.get<std::size_t>(); });
+    smtkTest(second.read(result), "Could not read document.");
+    smtkTest(sum == count * (count - 1) / 2, "Unexpected sum of nodes " << sum);
+    smtkTest(result.empty(), "Expected all other members to be skipped, got " << result.dump());
+  }
+
+  // Malformed input and throwing consumers are reported as failures.
+  {
+    std::istringstream stream("{ \"Attributes\": [ 1, 2, ");
+    StreamReader reader(stream);
+    json result;
+    smtkTest(!reader.read(result), "Expected failure reading truncated data.");
+
+    std::istringstream another(text);
+    StreamReader throwing(another);
+    throwing.addArray("Nodes", [](json&) { throw std::runtime_error("consumer"); });
+    smtkTest(!throwing.read(result), "Expected failure from a throwing consumer.");
+  }
+}
+
+} // namespace
+
+int TestJSONStreams(int /*unused*/, char** const /*unused*/)
+{
+  testWriter();
+  testReader();
+  return 0;
+}
@@ -15,7 +15,10 @@
 
 #include "smtk/common/testing/cxx/helpers.h"
 
+#include <chrono>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace
 {
@@ -106,5 +109,53 @@ int TestLock(int /*unused*/, char** const /*unused*/)
     smtkTest(false, "Locking unlocked resources should succeed but did not.");
   }
 
+  // Test timed lock acquisition.
+  {
+    ScopedLockGuard writeGuard(a1->lock({}), LockType::Write);
+    smtkTest(
+      !a1->lock({}).tryLockFor(LockType::Read, std::chrono::milliseconds(10)),
+      "Timed read-lock of a write-locked resource should time out.");
+    smtkTest(
+      !a1->lock({}).tryLockFor(LockType::Write, std::chrono::milliseconds(10)),
+      "Timed write-lock of a write-locked resource should time out.");
+  }
+  smtkTest(
+    a1->locked() == LockType::Unlocked, "Timed-out lock attempts should not hold the lock.");
+  smtkTest(
+    a1->lock({}).tryLockFor(LockType::Write, std::chrono::milliseconds(10)),
+    "Timed write-lock of an unlocked resource should succeed.");
+  a1->lock({}).unlock(LockType::Write);
+
+  // Test that waiting writers are served in the order they arrived.
+  {
+    std::vector<int> order;
+    std::mutex orderMutex;
+    a2->lock({}).lock(LockType::Write);
+    std::vector<std::thread> writers;
+    for (int ii = 0; ii < 4; ++ii)
+    {
+      writers.emplace_back([&, ii]() {
+        a2->lock({}).lock(LockType::Write);
+        {
+          std::lock_guard<std::mutex> guard(orderMutex);
+          order.push_back(ii);
+        }
+        a2->lock({}).unlock(LockType::Write);
+      });
+      // Give each writer time to enter the queue before starting the next.
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    a2->lock({}).unlock(LockType::Write);
+    for (auto& writer : writers)
+    {
+      writer.join();
+    }
+    smtkTest(order.size() == 4, "Expected 4 writers, got " << order.size() << ".");
+    for (int ii = 0; ii < 4; ++ii)
+    {
+      smtkTest(order[ii] == ii, "Writer " << order[ii] << " was served out of order.");
+    }
+  }
+
   return 0;
 }
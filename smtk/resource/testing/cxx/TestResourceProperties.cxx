@@ -13,14 +13,21 @@
 #include "smtk/resource/DerivedFrom.h"
 #include "smtk/resource/Manager.h"
 #include "smtk/resource/PersistentObject.h"
+#include "smtk/resource/json/jsonResource.h"
 
 #include "smtk/common/UUID.h"
 #include "smtk/common/json/jsonUUID.h"
 #include "smtk/common/testing/cxx/helpers.h"
 
+#include <cstdio>
+
 namespace
 {
 const double double_epsilon = 1.e-10;
+std::string write_root = SMTK_SCRATCH_DIR;
+
+template<typename Type>
+using Indexed = std::unordered_map<smtk::common::UUID, Type>;
 
 class Resource;
 
@@ -146,5 +153,144 @@ int TestResourceProperties(int /*unused*/, char** const /*unused*/)
 
   std::cout << "destructor works" << std::endl;
 
+  {
+    // Test secondary value indexes.
+    using smtk::resource::properties::IndexKind;
+    Resource::Ptr resource = Resource::create();
+    std::vector<Component::Ptr> components;
+    for (int ii = 0; ii < 20; ++ii)
+    {
+      components.push_back(resource->newComponent());
+      components.back()->properties().emplace<long>("pedigree id", ii % 5);
+      components.back()->properties().emplace<std::string>("label", "c" + std::to_string(ii));
+    }
+
+    std::unordered_set<smtk::common::UUID> ids;
+    smtkTest(
+      !resource->properties().findIds<long>("pedigree id", 2, ids),
+      "Queries of unindexed properties should fail.");
+    smtkTest(
+      resource->properties().addIndex<long>("pedigree id", IndexKind::Ordered),
+      "Could not add an index.");
+    smtkTest(
+      !resource->properties().addIndex<long>("pedigree id", IndexKind::Hashed),
+      "Adding a duplicate index should fail.");
+    smtkTest(
+      !resource->properties().addIndex<smtk::resource::properties::CoordinateFrame>("frame"),
+      "Values that cannot be indexed should be rejected.");
+    smtkTest(
+      resource->properties().addIndex<std::string>("label", IndexKind::Ordered),
+      "Could not add a string index.");
+
+    // Indexes are populated from existing values.
+    smtkTest(resource->properties().findIds<long>("pedigree id", 2, ids), "Indexed query failed.");
+    smtkTest(
+      ids.size() == 4, "Expected 4 components with pedigree id 2, got " << ids.size() << ".");
+    ids.clear();
+    resource->properties().findIdsInRange<long>("pedigree id", 3, 4, ids);
+    smtkTest(ids.size() == 8, "Expected 8 components in range, got " << ids.size() << ".");
+    ids.clear();
+    resource->properties().findIdsWithPrefix<std::string>("label", "c1", ids);
+    smtkTest(ids.size() == 11, "Expected 11 labels with prefix, got " << ids.size() << ".");
+
+    // Indexes track insertion, erasure, and modification via references.
+    components[0]->properties().erase<long>("pedigree id");
+    components[1]->properties().get<long>()["pedigree id"] = 2;
+    auto extra = resource->newComponent();
+    extra->properties().insert<long>("pedigree id", 2);
+    ids.clear();
+    resource->properties().findIds<long>("pedigree id", 2, ids);
+    smtkTest(
+      ids.size() == 6, "Expected 6 components with pedigree id 2, got " << ids.size() << ".");
+    smtkTest(ids.find(components[1]->id()) != ids.end(), "Modified value was not re-indexed.");
+    ids.clear();
+    resource->properties().findIds<long>("pedigree id", 0, ids);
+    smtkTest(ids.size() == 3, "Erased value is still indexed.");
+
+    // Values modified repeatedly between queries are indexed by their final value.
+    components[3]->properties().get<long>()["pedigree id"] = 7;
+    components[3]->properties().get<long>()["pedigree id"] = 8;
+    ids.clear();
+    resource->properties().findIds<long>("pedigree id", 7, ids);
+    smtkTest(ids.empty(), "Intermediate value is still indexed.");
+    resource->properties().findIds<long>("pedigree id", 8, ids);
+    smtkTest(ids.size() == 1, "Expected 1 component with pedigree id 8, got " << ids.size() << ".");
+    ids.clear();
+    resource->properties().findIds<long>("pedigree id", 3, ids);
+    smtkTest(ids.size() == 3, "Expected 3 components with pedigree id 3, got " << ids.size() << ".");
+
+    // Removing all of a component's properties updates indexes.
+    components[2]->properties().clear();
+    ids.clear();
+    resource->properties().findIds<long>("pedigree id", 2, ids);
+    smtkTest(ids.size() == 5, "Cleared component is still indexed.");
+    smtkTest(
+      resource->properties().removeIndex<long>("pedigree id") &&
+        !resource->properties().hasIndex<long>("pedigree id"),
+      "Could not remove index.");
+  }
+
+  {
+    // Test storing numeric property tables in a chunked file.
+    Resource::Ptr resource = Resource::create();
+    resource->setLocation(write_root + "/TestResourceProperties.smtk");
+    std::vector<Component::Ptr> components;
+    for (int ii = 0; ii < 10; ++ii)
+    {
+      components.push_back(resource->newComponent());
+      components.back()->properties().insert<int>("int", ii);
+      components.back()->properties().emplace<long>("long", 1L << (ii + 20));
+      components.back()->properties().emplace<double>("double", ii + 0.25);
+      components.back()->properties().emplace<std::vector<double>>(
+        "vector", std::vector<double>(ii, 0.5 * ii));
+      components.back()->properties().emplace<std::string>("string", std::to_string(ii));
+    }
+    resource->properties().emplace<std::vector<long>>("empty", std::vector<long>());
+
+    smtk::resource::ResourcePtr base = resource;
+    nlohmann::json j;
+    smtk::resource::to_json(j, base);
+    smtkTest(
+      smtk::resource::writePropertiesFile(j, base, "TestResourceProperties.smtkc"),
+      "Could not write properties file.");
+    const auto& jProperties = j.at("properties");
+    smtkTest(
+      jProperties.find(smtk::common::typeName<Indexed<double>>()) == jProperties.end(),
+      "Numeric properties should not be serialized as JSON.");
+    smtkTest(
+      jProperties.find(smtk::common::typeName<Indexed<std::string>>()) != jProperties.end(),
+      "String properties should be serialized as JSON.");
+
+    Resource::Ptr copy = Resource::create();
+    copy->setLocation(resource->location());
+    copy->properties().addIndex<int>("int");
+    std::unordered_set<smtk::common::UUID> ids;
+    smtkTest(copy->properties().findIds<int>("int", 3, ids) && ids.empty(), "Expected no values.");
+    base = copy;
+    smtk::resource::from_json(j, base);
+    const auto& data = copy->properties().data();
+    for (int ii = 0; ii < 10; ++ii)
+    {
+      const auto& id = components[ii]->id();
+      smtkTest(
+        data.at<Indexed<int>>("int").at(id) == ii &&
+          data.at<Indexed<long>>("long").at(id) == (1L << (ii + 20)) &&
+          data.at<Indexed<double>>("double").at(id) == ii + 0.25 &&
+          data.at<Indexed<std::vector<double>>>("vector").at(id) ==
+            std::vector<double>(ii, 0.5 * ii) &&
+          data.at<Indexed<std::string>>("string").at(id) == std::to_string(ii),
+        "Wrong properties for component " << ii << ".");
+    }
+    smtkTest(
+      copy->properties().contains<std::vector<long>>("empty") &&
+        copy->properties().at<std::vector<long>>("empty").empty(),
+      "Wrong empty vector property.");
+    smtkTest(
+      copy->properties().findIds<int>("int", 3, ids) && ids.size() == 1 &&
+        *ids.begin() == components[3]->id(),
+      "Indexes should reflect values read from a properties file.");
+    std::remove((write_root + "/TestResourceProperties.smtkc").c_str());
+  }
+
   return 0;
 }
@@ -0,0 +1,285 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/resource/Snapshot.h"
+
+#include "smtk/resource/Component.h"
+#include "smtk/resource/DerivedFrom.h"
+#include "smtk/resource/Lock.h"
+#include "smtk/resource/Resource.h"
+
+#include "smtk/common/UUID.h"
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+
+class Resource;
+
+class Component : public smtk::resource::Component
+{
+  friend class Resource;
+
+public:
+  smtkTypeMacro(Component);
+  smtkSuperclassMacro(smtk::resource::PersistentObject);
+  smtkSharedFromThisMacro(smtk::resource::PersistentObject);
+
+  const smtk::resource::ResourcePtr resource() const override { return m_resource; }
+
+  const smtk::common::UUID& id() const override { return m_id; }
+  bool setId(const smtk::common::UUID& id) override
+  {
+    m_id = id;
+    return true;
+  }
+
+  std::string name() const override { return m_name; }
+  void setName(const std::string& name) { m_name = name; }
+
+private:
+  Component(smtk::resource::ResourcePtr resource)
+    : m_resource(resource)
+  {
+  }
+
+  const smtk::resource::ResourcePtr m_resource;
+  smtk::common::UUID m_id;
+  std::string m_name;
+};
+
+class Resource : public smtk::resource::DerivedFrom<Resource, smtk::resource::Resource>
+{
+public:
+  smtkTypeMacro(Resource);
+  smtkCreateMacro(Resource);
+  smtkSharedFromThisMacro(smtk::resource::PersistentObject);
+
+  Component::Ptr newComponent()
+  {
+    Component::Ptr shared(new Component(shared_from_this()));
+    shared->setId(smtk::common::UUID::random());
+    m_components[shared->id()] = shared;
+    return shared;
+  }
+
+  bool removeComponent(const smtk::common::UUID& id) { return m_components.erase(id) > 0; }
+
+  smtk::resource::ComponentPtr find(const smtk::common::UUID& id) const override
+  {
+    auto it = m_components.find(id);
+    return it == m_components.end() ? smtk::resource::ComponentPtr() : it->second;
+  }
+
+  std::function<bool(const smtk::resource::Component&)> queryOperation(
+    const std::string& /*unused*/) const override
+  {
+    return [](const smtk::resource::Component& /*unused*/) { return true; };
+  }
+
+  void visit(smtk::resource::Component::Visitor& visitor) const override
+  {
+    for (const auto& entry : m_components)
+    {
+      visitor(entry.second);
+    }
+  }
+
+protected:
+  Resource() = default;
+
+private:
+  std::unordered_map<smtk::common::UUID, Component::Ptr> m_components;
+};
+
+} // namespace
+
+int TestResourceSnapshot(int /*unused*/, char** const /*unused*/)
+{
+  using smtk::resource::LockType;
+  using smtk::resource::ScopedLockGuard;
+
+  auto resource = Resource::create();
+  resource->setName("snapshot test");
+
+  // Readers never wait, even for the first snapshot of a resource.
+  {
+    ScopedLockGuard writeLock(resource->lock({}), LockType::Write);
+    auto reader = std::async(std::launch::async, [&resource]() { return resource->snapshot(); });
+    smtkTest(
+      reader.get() == nullptr, "A first snapshot cannot be taken while a writer holds the lock.");
+  }
+
+  auto c1 = resource->newComponent();
+  auto c2 = resource->newComponent();
+  c1->properties().get<long>()["count"] = 1;
+  c2->properties().get<long>()["count"] = 2;
+  c1->properties().get<long>()["other"] = 3;
+  c1->properties().get<std::string>()["label"] = "first";
+  resource->properties().get<double>()["scale"] = 0.5;
+
+  auto s1 = resource->snapshot();
+  smtkTest(s1 != nullptr, "Expected a snapshot.");
+  smtkTest(s1->id() == resource->id(), "Snapshot has the wrong resource id.");
+  smtkTest(s1->name() == "snapshot test", "Snapshot has the wrong resource name.");
+  smtkTest(s1->version() == resource->version(), "Snapshot has the wrong version.");
+  smtkTest(
+    s1->numberOfComponents() == 2, "Expected 2 components, got " << s1->numberOfComponents());
+  smtkTest(s1->component(c1->id()) != nullptr, "Component c1 missing from snapshot.");
+  smtkTest(
+    s1->component(c1->id())->typeName == c1->typeToken(), "Snapshot has the wrong component type.");
+  smtkTest(*s1->property<long>(c2->id(), "count") == 2, "Snapshot has the wrong property value.");
+  smtkTest(
+    *s1->property<std::string>(c1->id(), "label") == "first", "Snapshot has the wrong string.");
+  smtkTest(
+    *s1->property<double>(resource->id(), "scale") == 0.5,
+    "Snapshot has the wrong resource value.");
+  smtkTest(!s1->contains<long>(c1->id(), "missing"), "Snapshot has an unexpected property.");
+  smtkTest(resource->snapshot() == s1, "Unmodified resources should reuse their snapshot.");
+
+  {
+    // Modify the resource as a writer that does not report its changes would.
+    ScopedLockGuard writeLock(resource->lock({}), LockType::Write);
+    c1->properties().get<long>()["count"] = 10;
+    resource->newComponent();
+
+    // Readers are not blocked by the writer; they see the last published state.
+    auto reader = std::async(std::launch::async, [&resource]() { return resource->snapshot(); });
+    smtkTest(reader.get() == s1, "A snapshot taken during a write should be the last version.");
+  }
+
+  auto s2 = resource->snapshot();
+  smtkTest(s2 != s1, "A new snapshot should be taken once the writer is done.");
+  smtkTest(s2->version() == s1->version() + 1, "Snapshot version was not incremented.");
+  smtkTest(
+    s2->numberOfComponents() == 3, "Expected 3 components, got " << s2->numberOfComponents());
+  smtkTest(*s2->property<long>(c1->id(), "count") == 10, "Snapshot missed a modification.");
+
+  // Older snapshots are immutable.
+  smtkTest(s1->numberOfComponents() == 2, "Older snapshots should not change.");
+  smtkTest(*s1->property<long>(c1->id(), "count") == 1, "Older snapshots should not change.");
+
+  // Unmodified property values are shared between snapshots, one name at a time.
+  smtkTest(
+    s2->properties<std::string>("label") == s1->properties<std::string>("label"),
+    "Unmodified property types should be shared.");
+  smtkTest(
+    s2->properties<double>("scale") == s1->properties<double>("scale"),
+    "Unmodified property types should be shared.");
+  smtkTest(
+    s2->properties<long>("other") == s1->properties<long>("other"),
+    "Unmodified property names should be shared.");
+  smtkTest(
+    s2->properties<long>("count") != s1->properties<long>("count"),
+    "Modified property names should be copied.");
+
+  // Writers that report their changes publish snapshots that only copy the
+  // buckets of components that changed.
+  std::vector<Component::Ptr> many;
+  {
+    ScopedLockGuard writeLock(resource->lock({}), LockType::Write);
+    for (int ii = 0; ii < 1000; ++ii)
+    {
+      many.push_back(resource->newComponent());
+    }
+  }
+  auto s3 = resource->snapshot();
+  smtkTest(s3->numberOfComponents() == 1003, "Expected 1003 components.");
+
+  {
+    ScopedLockGuard writeLock(resource->lock({}), LockType::Write);
+    many[0]->properties().get<long>()["count"] = 4;
+    many[1]->setName("renamed");
+    auto added = resource->newComponent();
+    resource->removeComponent(many[2]->id());
+    resource->recordSnapshotChanges({ many[1]->id(), added->id(), many[2]->id() }, {});
+    resource->publishSnapshot({});
+
+    // The published snapshot is available before the writer releases its lock.
+    auto reader = std::async(std::launch::async, [&resource]() { return resource->snapshot(); });
+    auto s4 = reader.get();
+    smtkTest(s4 != s3, "Expected the published snapshot.");
+    smtkTest(s4->version() == s3->version() + 1, "Published snapshot has the wrong version.");
+    smtkTest(s4->numberOfComponents() == 1003, "Expected 1003 components.");
+    smtkTest(s4->component(added->id()) != nullptr, "Published snapshot missed a new component.");
+    smtkTest(s4->component(many[2]->id()) == nullptr, "Published snapshot missed a removal.");
+    smtkTest(s4->component(many[1]->id())->name == "renamed", "Published snapshot missed a name.");
+    smtkTest(
+      *s4->property<long>(many[0]->id(), "count") == 4, "Published snapshot missed a property.");
+    smtkTest(s3->component(many[2]->id()) != nullptr, "Older snapshots should not change.");
+
+    std::size_t shared = 0;
+    for (const auto& component : many)
+    {
+      auto* record = s4->component(component->id());
+      shared += record && record == s3->component(component->id()) ? 1 : 0;
+    }
+    smtkTest(shared > 900, "Unchanged components should be shared; only " << shared << " were.");
+  }
+  smtkTest(
+    resource->snapshot()->version() == resource->version(),
+    "The published snapshot should be current once the writer is done.");
+
+  // A snapshot may be taken directly by a caller that holds a lock.
+  {
+    ScopedLockGuard writeLock(resource->lock({}), LockType::Write);
+    c2->properties().erase<long>("count");
+    auto direct = smtk::resource::Snapshot::create(*resource, s2);
+    smtkTest(!direct->contains<long>(c2->id(), "count"), "Direct snapshot missed an erasure.");
+    smtkTest(
+      direct->properties<std::string>("label") == s2->properties<std::string>("label"),
+      "Direct snapshots should share unmodified property types.");
+  }
+
+  // Several readers may copy properties that have never been copied at once.
+  auto fresh = Resource::create();
+  auto c3 = fresh->newComponent();
+  c3->properties().get<long>()["count"] = 1;
+  c3->properties().get<long>()["other"] = 2;
+  std::vector<std::shared_ptr<const smtk::resource::Snapshot>> concurrent(8);
+  {
+    std::vector<std::future<void>> readers;
+    for (auto& entry : concurrent)
+    {
+      readers.push_back(std::async(std::launch::async, [&fresh, &entry]() {
+        ScopedLockGuard readLock(fresh->lock({}), LockType::Read);
+        entry = smtk::resource::Snapshot::create(*fresh, nullptr);
+      }));
+    }
+    for (auto& reader : readers)
+    {
+      reader.get();
+    }
+  }
+  for (const auto& entry : concurrent)
+  {
+    smtkTest(*entry->property<long>(c3->id(), "count") == 1, "Concurrent snapshot is wrong.");
+  }
+  {
+    ScopedLockGuard writeLock(fresh->lock({}), LockType::Write);
+    c3->properties().get<long>()["count"] = 3;
+  }
+  for (const auto& entry : concurrent)
+  {
+    auto next = smtk::resource::Snapshot::create(*fresh, entry);
+    smtkTest(
+      *next->property<long>(c3->id(), "count") == 3, "Snapshot missed a concurrent-copy change.");
+    smtkTest(
+      next->properties<long>("other") == entry->properties<long>("other"),
+      "Unmodified property names should be shared after concurrent copies.");
+  }
+
+  return 0;
+}
@@ -157,7 +157,7 @@ int Geometry::dimension(const smtk::resource::PersistentObject::Ptr& obj) const
     }
     else if (found)
     { // Cache was marked dirty.
-      this->queryGeometry(obj, it->second);
+      this->refresh(obj, it->second);
       if (!it->second.isValid())
       {
         m_cache.erase(it);
@@ -170,7 +170,7 @@ int Geometry::dimension(const smtk::resource::PersistentObject::Ptr& obj) const
     else
     { // No cache entry yet; try to add one.
       CacheEntry entry;
-      this->queryGeometry(obj, entry);
+      this->refresh(obj, entry);
       if (entry.isValid())
       {
         m_cache[obj->id()] = entry;
@@ -12,13 +12,371 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include <deque>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 namespace smtk
 {
 namespace string
 {
 
+namespace
+{
+// A managed string. Entries are freed once they have been unmanaged, removed
+// from the dictionary, and no reader can still be probing them.
+struct Entry
+{
+  Entry(Hash hash, const std::string& value)
+    : m_hash(hash)
+    , m_value(value)
+  {
+  }
+
+  std::size_t memoryUsage() const { return sizeof(Entry) + m_value.capacity(); }
+
+  const Hash m_hash;
+  const std::string m_value;
+  mutable std::atomic<bool> m_live{ true };
+};
+
+// An open-addressed (linear-probing) table of entries indexed by hash.
+// Writers only fill empty slots or replace the entry for a hash that is no
+// longer live, so readers may probe the table without locking.
+struct Table
+{
+  Table(std::size_t bits)
+    : m_bits(bits)
+    , m_slots(new std::atomic<Entry*>[std::size_t(1) << bits])
+  {
+    for (std::size_t ii = 0; ii < this->capacity(); ++ii)
+    {
+      m_slots[ii].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  std::size_t capacity() const { return std::size_t(1) << m_bits; }
+
+  std::size_t memoryUsage() const
+  {
+    return sizeof(Table) + this->capacity() * sizeof(std::atomic<Entry*>);
+  }
+
+  // Hashes that collide are remapped to consecutive values, so scatter
+  // them across the table (Fibonacci hashing) to keep probe runs short.
+  std::size_t slot(Hash hash) const
+  {
+    return static_cast<std::size_t>(
+      (static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15ull) >> (64 - m_bits));
+  }
+
+  const std::size_t m_bits;
+  std::unique_ptr<std::atomic<Entry*>[]> m_slots;
+  std::size_t m_used{ 0 }; // Slots holding live or dead entries.
+};
+
+// Tables and entries that writers have unlinked but readers may still hold.
+struct Retired
+{
+  std::vector<std::unique_ptr<Table>> m_tables;
+  std::vector<std::unique_ptr<Entry>> m_entries;
+};
+
+// Readers announce themselves in one of several counters (chosen by thread)
+// so that concurrent readers do not contend for a single cache line.
+constexpr std::size_t NumberOfStripes = 16;
+
+struct alignas(64) Stripe
+{
+  std::atomic<std::size_t> m_readers{ 0 };
+};
+
+std::size_t readerStripe()
+{
+  static thread_local std::size_t stripe =
+    std::hash<std::thread::id>()(std::this_thread::get_id()) % NumberOfStripes;
+  return stripe;
+}
+} // anonymous namespace
+
+/**\brief The dictionary of managed strings.
+  *
+  * Readers never block. Writers (which must hold the manager's write lock)
+  * publish replacement tables rather than resizing in place and retire what
+  * they unlink instead of freeing it. Memory is reclaimed with epochs: each
+  * reader registers with the epoch current when it starts; each write that
+  * finds no readers registered with the previous epoch frees what was retired
+  * during that epoch and advances the epoch. Writers never wait for readers,
+  * so a reader may call back into the manager (e.g., from a visitor).
+  */
+class Manager::Internal
+{
+public:
+  static constexpr std::size_t MinimumBits = 6;
+
+  /// Registers the calling thread as a reader for the guard's lifetime.
+  class ReadGuard
+  {
+  public:
+    ReadGuard(const Internal& dictionary)
+    {
+      std::size_t stripe = readerStripe();
+      while (true)
+      {
+        std::size_t epoch = dictionary.m_epoch.load();
+        Stripe* candidate = &dictionary.m_stripes[epoch & 1][stripe];
+        candidate->m_readers.fetch_add(1);
+        // If a writer advanced the epoch meanwhile, it may not have seen this
+        // reader; register with the new epoch instead.
+        if (dictionary.m_epoch.load() == epoch)
+        {
+          m_stripe = candidate;
+          return;
+        }
+        candidate->m_readers.fetch_sub(1);
+      }
+    }
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+    ~ReadGuard() { m_stripe->m_readers.fetch_sub(1); }
+
+  private:
+    Stripe* m_stripe{ nullptr };
+  };
+
+  Internal() { this->publish(MinimumBits); }
+
+  ~Internal()
+  {
+    Table* table = m_table.load(std::memory_order_relaxed);
+    for (std::size_t ii = 0; ii < table->capacity(); ++ii)
+    {
+      delete table->m_slots[ii].load(std::memory_order_relaxed);
+    }
+    delete table;
+  }
+
+  /// Return the live entry for \a hash (or null). This never blocks.
+  ///
+  /// Unless the caller holds the manager's write lock, the entry may
+  /// only be used while a ReadGuard is held.
+  const Entry* find(Hash hash) const
+  {
+    const Table* table = m_table.load(std::memory_order_acquire);
+    std::size_t mask = table->capacity() - 1;
+    for (std::size_t ii = table->slot(hash);; ii = (ii + 1) & mask)
+    {
+      const Entry* entry = table->m_slots[ii].load(std::memory_order_acquire);
+      if (!entry)
+      {
+        return nullptr;
+      }
+      if (entry->m_hash == hash)
+      {
+        return entry->m_live.load(std::memory_order_acquire) ? entry : nullptr;
+      }
+    }
+  }
+
+  /// Visit every live entry. This never blocks.
+  template<typename Functor>
+  smtk::common::Visit visit(Functor functor) const
+  {
+    ReadGuard guard(*this);
+    const Table* table = m_table.load(std::memory_order_acquire);
+    for (std::size_t ii = 0; ii < table->capacity(); ++ii)
+    {
+      const Entry* entry = table->m_slots[ii].load(std::memory_order_acquire);
+      if (
+        entry && entry->m_live.load(std::memory_order_acquire) &&
+        functor(*entry) == smtk::common::Visit::Halt)
+      {
+        return smtk::common::Visit::Halt;
+      }
+    }
+    return smtk::common::Visit::Continue;
+  }
+
+  /// Insert \a value with the given (unused) \a hash.
+  /// The caller must hold the manager's write lock.
+  const Entry& insert(Hash hash, const std::string& value)
+  {
+    Table* table = m_table.load(std::memory_order_relaxed);
+    if ((table->m_used + 1) * 2 > table->capacity())
+    {
+      table = this->rehash();
+    }
+    std::unique_ptr<Entry> entry(new Entry(hash, value));
+    const Entry& result = *entry;
+    m_memoryUsage += entry->memoryUsage();
+    this->place(*table, std::move(entry));
+    ++m_size;
+    this->reclaim();
+    return result;
+  }
+
+  /// Mark the entry for \a hash as no longer live. Its storage is retired
+  /// when its slot is reused or the table is replaced.
+  /// The caller must hold the manager's write lock.
+  bool erase(Hash hash)
+  {
+    const Entry* entry = this->find(hash);
+    if (!entry)
+    {
+      return false;
+    }
+    entry->m_live.store(false, std::memory_order_release);
+    --m_size;
+    this->reclaim();
+    return true;
+  }
+
+  /// Mark every entry as no longer live and start over with an empty table.
+  /// The caller must hold the manager's write lock.
+  void clear()
+  {
+    Table* table = m_table.load(std::memory_order_relaxed);
+    for (std::size_t ii = 0; ii < table->capacity(); ++ii)
+    {
+      Entry* entry = table->m_slots[ii].load(std::memory_order_relaxed);
+      if (entry)
+      {
+        entry->m_live.store(false, std::memory_order_release);
+        this->retire(entry);
+      }
+    }
+    m_size = 0;
+    this->publish(MinimumBits);
+    this->reclaim();
+  }
+
+  std::size_t size() const { return m_size.load(std::memory_order_acquire); }
+
+  std::size_t memoryUsage() const { return m_memoryUsage.load(std::memory_order_acquire); }
+
+protected:
+  // Put \a entry into the first empty slot (or the slot of a dead entry
+  // with the same hash, which is retired) along its probe sequence.
+  void place(Table& table, std::unique_ptr<Entry> entry)
+  {
+    std::size_t mask = table.capacity() - 1;
+    for (std::size_t ii = table.slot(entry->m_hash);; ii = (ii + 1) & mask)
+    {
+      Entry* current = table.m_slots[ii].load(std::memory_order_relaxed);
+      if (!current || current->m_hash == entry->m_hash)
+      {
+        table.m_used += current ? 0 : 1;
+        table.m_slots[ii].store(entry.release(), std::memory_order_release);
+        if (current)
+        {
+          this->retire(current);
+        }
+        return;
+      }
+    }
+  }
+
+  // Copy the live entries into a new table sized for them and publish it.
+  // Dead entries are dropped and retired along with the previous table.
+  Table* rehash()
+  {
+    Table* previous = m_table.load(std::memory_order_relaxed);
+    std::size_t bits = MinimumBits;
+    while ((std::size_t(1) << bits) < 4 * (m_size + 1))
+    {
+      ++bits;
+    }
+    std::unique_ptr<Table> table(new Table(bits));
+    std::size_t mask = table->capacity() - 1;
+    for (std::size_t ii = 0; ii < previous->capacity(); ++ii)
+    {
+      Entry* entry = previous->m_slots[ii].load(std::memory_order_relaxed);
+      if (!entry)
+      {
+        continue;
+      }
+      if (!entry->m_live.load(std::memory_order_relaxed))
+      {
+        this->retire(entry);
+        continue;
+      }
+      // Live hashes are unique, so take the first empty slot.
+      std::size_t jj = table->slot(entry->m_hash);
+      while (table->m_slots[jj].load(std::memory_order_relaxed))
+      {
+        jj = (jj + 1) & mask;
+      }
+      table->m_slots[jj].store(entry, std::memory_order_relaxed);
+      ++table->m_used;
+    }
+    return this->publish(std::move(table));
+  }
+
+  Table* publish(std::size_t bits)
+  {
+    return this->publish(std::unique_ptr<Table>(new Table(bits)));
+  }
+
+  // Make \a table current, retiring the table it replaces.
+  Table* publish(std::unique_ptr<Table> table)
+  {
+    Table* result = table.get();
+    m_memoryUsage += table->memoryUsage();
+    Table* previous = m_table.exchange(table.release(), std::memory_order_acq_rel);
+    if (previous)
+    {
+      m_retired[m_epoch.load() & 1].m_tables.emplace_back(previous);
+    }
+    return result;
+  }
+
+  void retire(Entry* entry) { m_retired[m_epoch.load() & 1].m_entries.emplace_back(entry); }
+
+  // If no reader registered with the previous epoch remains, free what was
+  // retired during that epoch (no reader registered since can reach it)
+  // and advance the epoch.
+  void reclaim()
+  {
+    std::size_t epoch = m_epoch.load();
+    std::size_t previous = (epoch + 1) & 1;
+    for (const auto& stripe : m_stripes[previous])
+    {
+      if (stripe.m_readers.load() > 0)
+      {
+        return;
+      }
+    }
+    auto& retired = m_retired[previous];
+    for (const auto& table : retired.m_tables)
+    {
+      m_memoryUsage -= table->memoryUsage();
+    }
+    for (const auto& entry : retired.m_entries)
+    {
+      m_memoryUsage -= entry->memoryUsage();
+    }
+    retired.m_tables.clear();
+    retired.m_entries.clear();
+    m_epoch.store(epoch + 1);
+  }
+
+  std::atomic<Table*> m_table{ nullptr };
+  std::atomic<std::size_t> m_size{ 0 };
+  std::atomic<std::size_t> m_memoryUsage{ 0 };
+  std::atomic<std::size_t> m_epoch{ 0 };
+  mutable std::array<std::array<Stripe, NumberOfStripes>, 2> m_stripes;
+  std::array<Retired, 2> m_retired;
+};
+
+Manager::Manager()
+  : m_data(new Internal)
+{
+}
+
+Manager::~Manager() = default;
+
 std::shared_ptr<Manager> Manager::create()
 {
   auto manager = std::make_shared<Manager>();
@@ -27,12 +385,16 @@ std::shared_ptr<Manager> Manager::create()
 
 Hash Manager::manage(const std::string& s)
 {
-  std::pair<Hash, bool> hp;
+  // Strings are usually managed many times, so look for the string before
+  // acquiring the lock to insert it. Since tokens are constructed from many
+  // threads at once, only invoke observers when some exist.
+  std::pair<Hash, bool> hp = this->computeInternal(s);
+  if (!hp.second)
   {
     std::lock_guard<std::mutex> lock(m_writeLock);
     hp = this->computeInternalAndInsert(s);
   }
-  if (hp.second)
+  if (hp.second && m_observers.size() > 0)
   {
     m_observers(Event::Managed, hp.first, s, Invalid);
   }
@@ -42,61 +404,62 @@ Hash Manager::manage(const std::string& s)
 std::size_t Manager::unmanage(Hash h)
 {
   std::size_t num = 0;
-  m_writeLock.lock();
-  auto it = m_data.find(h);
-  if (it == m_data.end())
+  std::unique_lock<std::mutex> lock(m_writeLock);
+  const Entry* entry = m_data->find(h);
+  if (!entry)
   {
-    m_writeLock.unlock();
     return num;
   }
   auto members = m_sets.find(h);
   if (members != m_sets.end())
   {
     // Erase all sets contained in this set recursively.
-    for (auto member : members->second)
+    std::vector<Hash> children(members->second.begin(), members->second.end());
+    for (auto member : children)
     {
-      m_writeLock.unlock();
+      lock.unlock();
       m_observers(Event::Removed, member, this->value(member), h);
       num += this->unmanage(member);
-      m_writeLock.lock();
+      lock.lock();
     }
   }
-  m_observers(Event::Unmanaged, h, it->second, Invalid);
-  num += m_data.erase(h);
-  m_writeLock.unlock();
+  // Observers may have unmanaged the entry while the lock was released.
+  entry = m_data->find(h);
+  if (entry)
+  {
+    m_observers(Event::Unmanaged, h, entry->m_value, Invalid);
+    num += m_data->erase(h) ? 1 : 0;
+  }
   return num;
 }
 
 bool Manager::hasValue(Hash h) const
 {
-  auto it = m_data.find(h);
-  return (it != m_data.end());
+  Internal::ReadGuard guard(*m_data);
+  return m_data->find(h) != nullptr;
 }
 
 const std::string& Manager::value(Hash h) const
 {
   static const std::string empty;
-  auto it = m_data.find(h);
-  if (it == m_data.end())
-  {
-    return empty;
-  }
-  return it->second;
+  Internal::ReadGuard guard(*m_data);
+  const Entry* entry = m_data->find(h);
+  return entry ? entry->m_value : empty;
+}
+
+std::size_t Manager::memoryUsage() const
+{
+  return m_data->memoryUsage();
 }
 
 Hash Manager::find(const std::string& s) const
 {
-  std::pair<Hash, bool> h;
-  {
-    std::lock_guard<std::mutex> lock(m_writeLock);
-    h = this->computeInternal(s);
-  }
+  std::pair<Hash, bool> h = this->computeInternal(s);
   return h.second ? h.first : Invalid;
 }
 
 Hash Manager::compute(const std::string& s) const
 {
-  // std::lock_guard<std::mutex> lock(m_writeLock);
   return this->computeInternal(s).first;
 }
 
@@ -104,7 +467,7 @@ Hash Manager::insert(const std::string& set, Hash h)
 {
   bool didInsert = false;
   // Verify \a h is managed.
-  if (m_data.find(h) == m_data.end())
+  if (!this->hasValue(h))
   {
     return Invalid;
   }
@@ -126,7 +489,7 @@ bool Manager::insert(Hash set, Hash h)
 {
   bool didInsert = false;
   // Verify \a set and \a h are managed.
-  if (m_data.find(h) == m_data.end() || m_data.find(set) == m_data.end())
+  if (!this->hasValue(h) || !this->hasValue(set))
   {
     return didInsert;
   }
@@ -145,7 +508,7 @@ bool Manager::remove(const std::string& set, Hash h)
 {
   bool didRemove = false;
   // Verify \a h is managed.
-  if (m_data.find(h) == m_data.end())
+  if (!this->hasValue(h))
   {
     return Invalid;
   }
@@ -176,10 +539,10 @@ bool Manager::remove(Hash set, Hash h)
 {
   bool didRemove = false;
   std::lock_guard<std::mutex> lock(m_writeLock);
-  auto hit = m_data.find(h);
+  const Entry* entry = m_data->find(h);
   auto sit = m_sets.find(set);
   // Verify \a h is managed and \a set is a set.
-  if (hit == m_data.end() || sit == m_sets.end())
+  if (!entry || sit == m_sets.end())
   {
     return false;
   }
@@ -187,7 +550,7 @@ bool Manager::remove(Hash set, Hash h)
   didRemove = m_sets[set].erase(h) > 0;
   if (didRemove)
   {
-    m_observers(Event::Removed, h, hit->second, set);
+    m_observers(Event::Removed, h, entry->m_value, set);
     if (m_sets[set].empty())
     {
       m_sets.erase(set);
@@ -198,8 +561,8 @@ bool Manager::remove(Hash set, Hash h)
 
 bool Manager::contains(const std::string& set, Hash h) const
 {
-  std::lock_guard<std::mutex> lock(m_writeLock);
   auto setHash = this->computeInternal(set);
+  std::lock_guard<std::mutex> lock(m_writeLock);
   auto sit = m_sets.find(setHash.first);
   return (sit != m_sets.end() && sit->second.find(h) != sit->second.end());
 }
@@ -208,21 +571,21 @@ bool Manager::contains(Hash set, Hash h) const
 {
   if (set == Invalid)
   {
-    auto mit = m_data.find(h);
-    return mit != m_data.end();
+    return this->hasValue(h);
   }
+  std::lock_guard<std::mutex> lock(m_writeLock);
   auto sit = m_sets.find(set);
   return (sit != m_sets.end() && sit->second.find(h) != sit->second.end());
 }
 
 bool Manager::verify(Hash& verified, Hash input) const
 {
-  auto mit = m_data.find(input);
-  if (mit != m_data.end())
+  if (this->hasValue(input))
   {
     verified = input;
     return true;
   }
+  std::lock_guard<std::mutex> lock(m_writeLock);
   auto te = m_translation.find(input);
   if (te != m_translation.end())
   {
@@ -233,6 +596,11 @@ bool Manager::verify(Hash& verified, Hash input) const
   return false;
 }
 
+bool Manager::empty() const
+{
+  return m_data->size() == 0;
+}
+
 smtk::common::Visit Manager::visitMembers(Visitor visitor, Hash set)
 {
   if (!visitor)
@@ -240,41 +608,30 @@ smtk::common::Visit Manager::visitMembers(Visitor visitor, Hash set)
     return smtk::common::Visit::Halt;
   }
 
-  m_writeLock.lock();
   if (set == Invalid)
   {
-    // Iterate over m_data.
-    for (const auto& entry : m_data)
-    {
-      m_writeLock.unlock();
-      if (visitor(entry.first) == smtk::common::Visit::Halt)
-      {
-        return smtk::common::Visit::Halt;
-      }
-      m_writeLock.lock();
-    }
-    m_writeLock.unlock();
-    return smtk::common::Visit::Continue;
+    // Iterate over the dictionary (which does not require the lock).
+    return m_data->visit([&visitor](const Entry& entry) { return visitor(entry.m_hash); });
   }
 
-  // Iterate over m_sets[set].
-  auto sit = m_sets.find(set);
-  if (sit == m_sets.end())
+  // Iterate over a copy of m_sets[set] so the visitor may run without the lock.
+  std::vector<Hash> members;
   {
-    m_writeLock.unlock();
-    return smtk::common::Visit::Continue;
+    std::lock_guard<std::mutex> lock(m_writeLock);
+    auto sit = m_sets.find(set);
+    if (sit == m_sets.end())
+    {
+      return smtk::common::Visit::Continue;
+    }
+    members.assign(sit->second.begin(), sit->second.end());
   }
-  for (const auto& entry : sit->second)
+  for (const auto& entry : members)
   {
-    m_writeLock.unlock();
     if (visitor(entry) == smtk::common::Visit::Halt)
     {
       return smtk::common::Visit::Halt;
     }
-    m_writeLock.lock();
   }
-
-  m_writeLock.unlock();
   return smtk::common::Visit::Continue;
 }
 
@@ -285,19 +642,23 @@ smtk::common::Visit Manager::visitSets(Visitor visitor)
     return smtk::common::Visit::Halt;
   }
 
-  m_writeLock.lock();
-  // Iterate over m_sets.
-  for (const auto& entry : m_sets)
+  // Iterate over a copy of the set names so the visitor may run without the lock.
+  std::vector<Hash> sets;
   {
-    m_writeLock.unlock();
-    if (visitor(entry.first) == smtk::common::Visit::Halt)
+    std::lock_guard<std::mutex> lock(m_writeLock);
+    sets.reserve(m_sets.size());
+    for (const auto& entry : m_sets)
+    {
+      sets.push_back(entry.first);
+    }
+  }
+  for (const auto& entry : sets)
+  {
+    if (visitor(entry) == smtk::common::Visit::Halt)
     {
       return smtk::common::Visit::Halt;
     }
-    m_writeLock.lock();
   }
-
-  m_writeLock.unlock();
   return smtk::common::Visit::Continue;
 }
 
@@ -308,31 +669,34 @@ void Manager::setData(
   // Remove existing entries.
   // TODO: Notification could be more efficient by only removing entries
   // not identical both before and after.
-  std::unordered_map<Hash, std::string>::iterator next;
-  m_writeLock.lock();
-  auto it = m_data.begin();
-  m_writeLock.unlock();
-  for (; it != m_data.end(); it = next)
+  std::vector<Hash> existing;
+  existing.reserve(m_data->size());
+  m_data->visit([&existing](const Entry& entry) {
+    existing.push_back(entry.m_hash);
+    return smtk::common::Visit::Continue;
+  });
+  for (const auto& hash : existing)
   {
-    next = it;
-    m_writeLock.lock();
-    ++next;
-    m_writeLock.unlock();
-    this->unmanage(it->first);
+    this->unmanage(hash);
   }
 
-  m_writeLock.lock();
-  m_data = members;
-  m_sets = sets;
-  m_writeLock.unlock();
+  {
+    std::lock_guard<std::mutex> lock(m_writeLock);
+    m_data->clear();
+    for (const auto& member : members)
+    {
+      m_data->insert(member.first, member.second);
+    }
+    m_sets = sets;
+  }
 
   // Notify observers of new members
-  for (const auto& member : m_data)
+  for (const auto& member : members)
   {
     m_observers(Event::Managed, member.first, member.second, Invalid);
   }
   // Notify observers of new sets
-  for (const auto& set : m_sets)
+  for (const auto& set : sets)
   {
     for (const auto& child : set.second)
     {
@@ -343,23 +707,24 @@ void Manager::setData(
 
 void Manager::reset()
 {
-  m_writeLock.lock();
-  m_data.clear();
+  std::lock_guard<std::mutex> lock(m_writeLock);
+  m_data->clear();
   m_sets.clear();
-  m_writeLock.unlock();
 }
 
 std::pair<Hash, bool> Manager::computeInternal(const std::string& s) const
 {
+  // When a different string already holds a hash, try the next hash value.
   std::pair<Hash, bool> result{ smtk::string::Token::stringHash(s.data(), s.size()), false };
+  Internal::ReadGuard guard(*m_data);
   while (true)
   {
-    auto it = m_data.find(result.first);
-    if (it == m_data.end())
+    const Entry* entry = m_data->find(result.first);
+    if (!entry)
     {
       return result;
     }
-    else if (it->second == s)
+    else if (entry->m_value == s)
     {
       result.second = true;
       return result;
@@ -374,7 +739,10 @@ std::pair<Hash, bool> Manager::computeInternalAndInsert(const std::string& s)
   std::pair<Hash, bool> result = this->computeInternal(s);
   if (result.first != Invalid)
   {
-    m_data[result.first] = s;
+    if (!result.second)
+    {
+      m_data->insert(result.first, s);
+    }
     result.second = true;
   }
   return result;
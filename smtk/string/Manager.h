@@ -20,6 +20,7 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -37,11 +38,23 @@ using Hash = std::size_t;
 ///
 /// The manager also provides a way to store sets of strings (named with a string that is
 /// itself hashed by the manager).
+///
+/// Looking up strings and hashes never blocks: the dictionary is an open-addressed table
+/// that writers replace (rather than resize in place) as it grows. Replaced tables and
+/// unmanaged strings are freed once no lookup that might be using them is in progress,
+/// so references returned by value() remain valid until the string is unmanaged (or the
+/// manager is reset). Adding and removing strings and all operations on sets are
+/// serialized by a mutex.
 class SMTKCORE_EXPORT Manager : public std::enable_shared_from_this<Manager>
 {
 public:
   static std::shared_ptr<Manager> create();
 
+  Manager();
+  Manager(const Manager&) = delete;
+  Manager& operator=(const Manager&) = delete;
+  ~Manager();
+
   /// Events that can occur during the lifecycle of the manager.
   enum Event
   {
@@ -130,7 +143,11 @@ public:
   bool verify(Hash& verified, Hash input) const;
 
   /// Return true if the manager is empty (i.e., managing no hashes) and false otherwise.
-  bool empty() const { return m_data.empty(); }
+  bool empty() const;
+
+  /// Return the number of bytes held by the dictionary of strings, including storage
+  /// retired by writers that concurrent lookups may still be using.
+  std::size_t memoryUsage() const;
 
   /// Visit all members of the set (or the entire Manager if passed the Invalid hash).
   /// Your \a visitor may not modify the manager.
@@ -158,12 +175,15 @@ protected:
   /// This function is a friend so it can access m_translation.
   friend void SMTKCORE_EXPORT from_json(const nlohmann::json&, std::shared_ptr<Manager>&);
 
-  /// Same as compute() but does not lock (you must hold m_writeLock upon entry).
+  /// Same as compute(). Callers that intend to insert the result must hold m_writeLock.
   std::pair<Hash, bool> computeInternal(const std::string& s) const;
+  /// Compute a hash for \a s and insert it if needed (you must hold m_writeLock upon entry).
   std::pair<Hash, bool> computeInternalAndInsert(const std::string& s);
 
   Observers m_observers;
-  std::unordered_map<Hash, std::string> m_data;
+  /// The dictionary of managed strings (which may be read without holding m_writeLock).
+  class Internal;
+  std::unique_ptr<Internal> m_data;
   std::unordered_map<Hash, std::unordered_set<Hash>> m_sets;
   mutable std::mutex m_writeLock;
 
@@ -11,9 +11,10 @@
 
 #include <cstring>
 #include <exception>
+#include <mutex>
 #include <thread>
 
-static std::mutex s_managerLock;
+static std::once_flag s_managerCreated;
 
 namespace smtk
 {
@@ -90,22 +91,14 @@ bool Token::operator>=(const Token& other) const
 
 Manager& Token::manager()
 {
-  if (s_manager)
-  {
-    return *s_manager;
-  }
-  else
-  {
-    std::lock_guard<std::mutex> lock(s_managerLock);
-    s_manager = Manager::create();
-    return *s_manager;
-  }
+  std::call_once(s_managerCreated, []() { s_manager = Manager::create(); });
+  return *s_manager;
 }
 
 Token Token::fromHash(Hash h)
 {
   Token result;
-  if (!s_manager->verify(result.m_id, h))
+  if (!Token::manager().verify(result.m_id, h))
   {
     throw std::invalid_argument("Hash does not exist in database.");
   }
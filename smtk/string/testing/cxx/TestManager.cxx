@@ -14,6 +14,10 @@
 
 #include "smtk/common/testing/cxx/helpers.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 namespace
 {
 
@@ -285,5 +289,146 @@ int TestManager(int, char*[])
   std::cout << vcount << " sets\n";
   test(vcount == 2, "Expected to deserialize 2 sets.");
 
+  // Test that a string whose hash collides with another string's is
+  // remapped to the next unused hash.
+  {
+    auto collider = Manager::create();
+    Hash fooHash = collider->compute("foo");
+    collider->setData({ { fooHash, "not foo" } }, {});
+    Hash remapped = collider->manage("foo");
+    smtkTest(remapped == fooHash + 1, "Expected \"foo\" to be remapped to " << fooHash + 1);
+    test(collider->find("foo") == remapped, "Expected to find the remapped hash.");
+    test(collider->value(fooHash) == "not foo", "Expected the colliding string to be kept.");
+    test(collider->value(remapped) == "foo", "Expected the remapped string to be kept.");
+
+    test(collider->unmanage(fooHash) == 1, "Expected to unmanage the colliding string.");
+    test(!collider->hasValue(fooHash), "Expected the colliding string to be unmanaged.");
+    test(collider->value(remapped) == "foo", "Expected the remapped string to survive.");
+  }
+
+  // Test that threads managing the same strings concurrently (forcing the
+  // dictionary to grow while others read it) agree on their hashes.
+  {
+    auto shared = Manager::create();
+    const std::size_t numberOfThreads = 8;
+    const std::size_t numberOfStrings = 4096;
+    std::vector<std::vector<Hash>> hashes(numberOfThreads, std::vector<Hash>(numberOfStrings));
+    std::atomic<std::size_t> mismatches{ 0 };
+    std::vector<std::thread> threads;
+    for (std::size_t tt = 0; tt < numberOfThreads; ++tt)
+    {
+      threads.emplace_back([&, tt]() {
+        for (std::size_t ii = 0; ii < numberOfStrings; ++ii)
+        {
+          std::size_t index = (ii + tt * 509) % numberOfStrings;
+          std::string value = "string " + std::to_string(index);
+          hashes[tt][index] = shared->manage(value);
+          if (shared->value(hashes[tt][index]) != value)
+          {
+            ++mismatches;
+          }
+        }
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    smtkTest(mismatches == 0, "Found " << mismatches << " hashes with the wrong value.");
+    for (std::size_t tt = 1; tt < numberOfThreads; ++tt)
+    {
+      test(hashes[tt] == hashes[0], "Expected all threads to compute identical hashes.");
+    }
+    vcount = 0;
+    shared->visitMembers(
+      [&vcount](Hash) {
+        ++vcount;
+        return smtk::common::Visit::Continue;
+      },
+      Manager::Invalid);
+    smtkTest(
+      vcount == numberOfStrings, "Expected " << numberOfStrings << " members, not " << vcount);
+  }
+
+  // Test that storage for unmanaged strings and replaced tables is reclaimed
+  // while other threads look strings up, so churn does not grow the manager.
+  {
+    auto churned = Manager::create();
+    const std::size_t numberOfReaders = 4;
+    const std::size_t numberOfRounds = 200;
+    const std::size_t numberOfStrings = 1000;
+    std::vector<Hash> permanent;
+    for (std::size_t ii = 0; ii < 16; ++ii)
+    {
+      permanent.push_back(churned->manage("permanent " + std::to_string(ii)));
+    }
+    std::atomic<bool> done{ false };
+    std::atomic<std::size_t> mismatches{ 0 };
+    std::vector<std::thread> readers;
+    for (std::size_t tt = 0; tt < numberOfReaders; ++tt)
+    {
+      readers.emplace_back([&]() {
+        while (!done)
+        {
+          for (std::size_t ii = 0; ii < permanent.size(); ++ii)
+          {
+            if (churned->value(permanent[ii]) != "permanent " + std::to_string(ii))
+            {
+              ++mismatches;
+            }
+          }
+          churned->find("churn 17");
+          churned->visitMembers([](Hash) { return smtk::common::Visit::Continue; });
+        }
+      });
+    }
+    std::size_t peak = 0;
+    std::vector<Hash> churn(numberOfStrings);
+    for (std::size_t round = 0; round < numberOfRounds; ++round)
+    {
+      for (std::size_t ii = 0; ii < numberOfStrings; ++ii)
+      {
+        churn[ii] = churned->manage("churn " + std::to_string(round * numberOfStrings + ii));
+      }
+      for (const auto& hash : churn)
+      {
+        churned->unmanage(hash);
+      }
+      if (round == 0)
+      {
+        peak = churned->memoryUsage();
+      }
+    }
+    done = true;
+    for (auto& reader : readers)
+    {
+      reader.join();
+    }
+    smtkTest(mismatches == 0, "Found " << mismatches << " lookups with the wrong value.");
+
+    // Without readers, two writes free everything retired before them.
+    for (int ii = 0; ii < 2; ++ii)
+    {
+      churned->unmanage(churned->manage("churn"));
+    }
+    std::cout << "Churned manager holds " << churned->memoryUsage() << " bytes (" << peak
+              << " after the first round).\n";
+    smtkTest(
+      churned->memoryUsage() <= 2 * peak,
+      "Expected churn to be reclaimed, but " << churned->memoryUsage() << " bytes are held.");
+
+    for (std::size_t round = 0; round < numberOfRounds; ++round)
+    {
+      churned->reset();
+      for (std::size_t ii = 0; ii < numberOfStrings; ++ii)
+      {
+        churned->manage("reset " + std::to_string(round * numberOfStrings + ii));
+      }
+    }
+    smtkTest(
+      churned->memoryUsage() <= 2 * peak,
+      "Expected reset() to reclaim storage, but " << churned->memoryUsage() << " bytes are held.");
+  }
+
   return 0;
 }
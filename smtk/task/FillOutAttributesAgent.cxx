@@ -41,6 +41,25 @@ bool hasMatchingDefinitions(
     });
 }
 
+// Return true if \a attribute is selected by \a predicate's definitions or instances.
+bool matchesPredicate(
+  const smtk::attribute::Resource& resource,
+  const FillOutAttributesAgent::AttributeSet& predicate,
+  const smtk::attribute::Attribute& attribute)
+{
+  if (predicate.m_instances.find(attribute.name()) != predicate.m_instances.end())
+  {
+    return true;
+  }
+  return std::any_of(
+    predicate.m_definitions.begin(),
+    predicate.m_definitions.end(),
+    [&resource, &attribute](const std::string& defName) {
+      auto definition = resource.findDefinition(defName);
+      return definition && attribute.definition()->isA(definition);
+    });
+}
+
 } // anonymous namespace
 
 FillOutAttributesAgent::FillOutAttributesAgent(Task* owningTask)
@@ -432,7 +451,7 @@ bool FillOutAttributesAgent::updateResourceEntry(
     auto att = resource.findAttribute(invalidId);
     if (att)
     {
-      if (att->isValid()) // TODO: accept predicate override for categories?
+      if (att->isValidCached()) // TODO: accept predicate override for categories?
       {
         validated.insert(invalidId);
       }
@@ -448,7 +467,7 @@ bool FillOutAttributesAgent::updateResourceEntry(
     auto att = resource.findAttribute(validId);
     if (att)
     {
-      if (!att->isValid()) // TODO: accept predicate override for categories?
+      if (!att->isValidCached()) // TODO: accept predicate override for categories?
       {
         invalidated.insert(validId);
       }
@@ -501,6 +520,105 @@ bool FillOutAttributesAgent::updateResourceEntry(
   return changesMade;
 }
 
+bool FillOutAttributesAgent::updateResourceEntry(
+  smtk::attribute::Resource& resource,
+  const AttributeSet& predicate,
+  ResourceAttributes& entry,
+  const std::set<smtk::attribute::AttributePtr>& touched)
+{
+  bool changesMade = false;
+  for (const auto& attribute : touched)
+  {
+    auto uid = attribute->id();
+    bool wasValid = entry.m_valid.find(uid) != entry.m_valid.end();
+    bool wasInvalid = !wasValid && entry.m_invalid.find(uid) != entry.m_invalid.end();
+    if (!wasValid && !wasInvalid)
+    {
+      // Only start tracking attributes that the predicate selects.
+      if (matchesPredicate(resource, predicate, *attribute))
+      {
+        changesMade |= testValidity(attribute, entry);
+      }
+      continue;
+    }
+    bool isValid = attribute->isValidCached(); // TODO: accept predicate override for categories?
+    if (isValid && wasInvalid)
+    {
+      entry.m_invalid.erase(uid);
+      entry.m_valid.insert(uid);
+      changesMade = true;
+    }
+    else if (!isValid && wasValid)
+    {
+      entry.m_valid.erase(uid);
+      entry.m_invalid.insert(uid);
+      changesMade = true;
+    }
+  }
+  return changesMade;
+}
+
+bool FillOutAttributesAgent::expungeObjects(
+  const smtk::attribute::ReferenceItem& expunged,
+  std::map<smtk::common::UUID, std::set<smtk::attribute::AttributePtr>>& touched,
+  std::set<std::shared_ptr<smtk::attribute::Resource>>& affectedResources)
+{
+  auto mgrs = m_parent->managers();
+  auto resourceManager = mgrs ? mgrs->get<smtk::resource::Manager::Ptr>() : nullptr;
+  if (!resourceManager)
+  {
+    return false;
+  }
+  // Expunged objects may no longer be resolvable, so use the ids held by the links.
+  std::vector<smtk::common::UUID> expungedIds;
+  auto result = expunged.attribute();
+  for (std::size_t ii = 0; result && ii < expunged.numberOfValues(); ++ii)
+  {
+    if (expunged.isSet(ii))
+    {
+      auto id = result->guardedLinks()->linkedObjectId(expunged.objectKey(ii));
+      if (!id.isNull())
+      {
+        expungedIds.push_back(id);
+      }
+    }
+  }
+
+  bool changesMade = false;
+  for (auto& predicate : m_attributeSets)
+  {
+    for (auto& resourceEntry : predicate.m_resources)
+    {
+      auto resource = resourceManager->get<smtk::attribute::Resource>(resourceEntry.first);
+      if (!resource)
+      {
+        continue;
+      }
+      std::set<smtk::attribute::AttributePtr> dependents;
+      for (const auto& id : expungedIds)
+      {
+        // Stop tracking expunged attributes.
+        changesMade |= resourceEntry.second.m_valid.erase(id) > 0;
+        changesMade |= resourceEntry.second.m_invalid.erase(id) > 0;
+        resource->findDependentAttributes(id, dependents);
+      }
+      if (dependents.empty())
+      {
+        continue;
+      }
+      for (const auto& dependent : dependents)
+      {
+        // The expunged object is not an item of the dependent, so its
+        // cached validity must be discarded here.
+        dependent->markModified();
+      }
+      touched[resource->id()].insert(dependents.begin(), dependents.end());
+      affectedResources.insert(resource);
+    }
+  }
+  return changesMade;
+}
+
 int FillOutAttributesAgent::update(
   const smtk::operation::Operation& op,
   smtk::operation::EventType event,
@@ -513,10 +631,45 @@ int FillOutAttributesAgent::update(
   {
     case smtk::operation::EventType::DID_OPERATE:
     {
+      // Unless every tracked attribute must be revisited, only the attributes
+      // the operation reports as created or modified (and the attributes that
+      // depend upon them or upon expunged objects) are revalidated.
+      bool fullUpdate = false;
       auto categoriesModified = result->findResource("categoriesModified");
       if (categoriesModified && categoriesModified->numberOfValues())
       {
         predicatesUpdated = true; //categories have been changed
+        fullUpdate = true;
+      }
+      std::map<smtk::common::UUID, std::set<smtk::attribute::AttributePtr>> touched;
+      for (const auto& itemName : { "created", "modified" })
+      {
+        auto item = result->findComponent(itemName);
+        if (!item)
+        {
+          continue;
+        }
+        for (std::size_t ii = 0; ii < item->numberOfValues(); ++ii)
+        {
+          auto attribute = std::dynamic_pointer_cast<smtk::attribute::Attribute>(item->value(ii));
+          auto attResource = attribute ? attribute->attributeResource() : nullptr;
+          if (attResource)
+          {
+            auto& attributes = touched[attResource->id()];
+            attributes.insert(attribute);
+            attResource->findDependentAttributes(attribute->id(), attributes);
+          }
+        }
+      }
+
+      // Expunged objects may invalidate references held by attributes the
+      // operation did not report as modified, including attributes in
+      // resources the operation did not mention.
+      std::set<std::shared_ptr<smtk::attribute::Resource>> affectedResources;
+      auto expunged = result->findComponent("expunged");
+      if (!fullUpdate && expunged && expunged->numberOfValues())
+      {
+        predicatesUpdated |= this->expungeObjects(*expunged, touched, affectedResources);
       }
 
       auto mentionedResources = smtk::operation::extractResources(result);
@@ -525,28 +678,44 @@ int FillOutAttributesAgent::update(
         auto resource = std::dynamic_pointer_cast<smtk::attribute::Resource>(weakResource.lock());
         if (resource)
         {
-          std::string role = smtk::project::detail::role(resource);
-          // Do we care about this resource?
-          for (auto& predicate : m_attributeSets)
+          affectedResources.insert(resource);
+        }
+      }
+      for (const auto& resource : affectedResources)
+      {
+        std::string role = smtk::project::detail::role(resource);
+        // Do we care about this resource?
+        for (auto& predicate : m_attributeSets)
+        {
+          auto it = predicate.m_resources.find(resource->id());
+          bool doUpdate = false;
+          bool newEntry = false;
+          if (it != predicate.m_resources.end())
+          {
+            doUpdate = true;
+          }
+          else if (predicate.m_role == role || predicate.m_role == "*" || predicate.m_role.empty())
           {
-            auto it = predicate.m_resources.find(resource->id());
-            bool doUpdate = false;
-            if (it != predicate.m_resources.end())
+            if (predicate.m_autoconfigure)
             {
+              it = predicate.m_resources.insert({ resource->id(), { {}, {} } }).first;
               doUpdate = true;
+              newEntry = true;
             }
-            else if (
-              predicate.m_role == role || predicate.m_role == "*" || predicate.m_role.empty())
+          }
+          if (doUpdate)
+          {
+            // A resource mentioned without any created or modified attributes
+            // may have changed in ways the result does not describe.
+            auto tit = touched.find(resource->id());
+            if (fullUpdate || newEntry || tit == touched.end())
             {
-              if (predicate.m_autoconfigure)
-              {
-                it = predicate.m_resources.insert({ resource->id(), { {}, {} } }).first;
-                doUpdate = true;
-              }
+              predicatesUpdated |= this->updateResourceEntry(*resource, predicate, it->second);
             }
-            if (doUpdate)
+            else
             {
-              predicatesUpdated |= this->updateResourceEntry(*resource, predicate, it->second);
+              predicatesUpdated |=
+                this->updateResourceEntry(*resource, predicate, it->second, tit->second);
             }
           }
         }
@@ -648,7 +817,7 @@ bool FillOutAttributesAgent::testValidity(
     (entry.m_valid.find(uid) == entry.m_valid.end()))
   {
     // We've found a new attribute. Classify it.
-    if (attribute->isValid()) // TODO: accept predicate override for categories?
+    if (attribute->isValidCached()) // TODO: accept predicate override for categories?
     {
       entry.m_valid.insert(uid);
     }
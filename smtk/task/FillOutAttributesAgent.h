@@ -148,11 +148,37 @@ protected:
   bool initializeResources();
 
   /// Update a single resource in a predicate.
+  ///
+  /// Every tracked attribute is revalidated and the resource is searched
+  /// for new attributes that the predicate selects.
   bool updateResourceEntry(
     smtk::attribute::Resource& resource,
     const AttributeSet& predicate,
     ResourceAttributes& entry);
 
+  /// Update a single resource in a predicate given the attributes an
+  /// operation reported as created or modified.
+  ///
+  /// Only the \a touched attributes (which should include the attributes that
+  /// depend upon them) are revalidated (or, if untracked and selected by the
+  /// predicate, classified); all other tracked attributes keep their current
+  /// classification.
+  bool updateResourceEntry(
+    smtk::attribute::Resource& resource,
+    const AttributeSet& predicate,
+    ResourceAttributes& entry,
+    const std::set<smtk::attribute::AttributePtr>& touched);
+
+  /// Stop tracking the \a expunged attributes and insert into \a touched the
+  /// tracked attributes that depend upon any \a expunged object, along with
+  /// their resources into \a affectedResources.
+  ///
+  /// Returns true if an expunged attribute was being tracked.
+  bool expungeObjects(
+    const smtk::attribute::ReferenceItem& expunged,
+    std::map<smtk::common::UUID, std::set<smtk::attribute::AttributePtr>>& touched,
+    std::set<std::shared_ptr<smtk::attribute::Resource>>& affectedResources);
+
   /// Respond to operations that may change task state.
   int update(
     const smtk::operation::Operation& op,
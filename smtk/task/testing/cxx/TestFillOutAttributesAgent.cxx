@@ -0,0 +1,213 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/ComponentItem.h"
+#include "smtk/attribute/ComponentItemDefinition.h"
+#include "smtk/attribute/Definition.h"
+#include "smtk/attribute/IntItem.h"
+#include "smtk/attribute/Resource.h"
+#include "smtk/attribute/StringItem.h"
+#include "smtk/attribute/StringItemDefinition.h"
+#include "smtk/attribute/operators/DeleteAttribute.h"
+#include "smtk/attribute/operators/Signal.h"
+#include "smtk/common/Managers.h"
+#include "smtk/operation/Manager.h"
+#include "smtk/plugin/Registry.h"
+#include "smtk/resource/Manager.h"
+#include "smtk/task/FillOutAttributes.h"
+#include "smtk/task/Instances.h"
+#include "smtk/task/Manager.h"
+#include "smtk/task/Port.h"
+#include "smtk/task/Task.h"
+
+#include "smtk/resource/json/Helper.h"
+
+#include "smtk/task/json/Helper.h"
+#include "smtk/task/json/jsonManager.h"
+#include "smtk/task/json/jsonTask.h"
+
+#include "smtk/attribute/Registrar.h"
+#include "smtk/operation/Registrar.h"
+#include "smtk/resource/Registrar.h"
+#include "smtk/task/Registrar.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+namespace
+{
+
+std::string configString = R"({
+  "ports": [
+    {
+      "id": 1,
+      "type": "smtk::task::Port",
+      "direction": "in",
+      "name": "attribute resource in",
+      "data-types": [ "smtk::task::ObjectsInRoles" ]
+    }
+  ],
+  "tasks": [
+    {
+      "id": 1,
+      "type": "smtk::task::FillOutAttributes",
+      "name": "Assign materials",
+      "state": "incomplete",
+      "ports": {
+        "in": 1
+      },
+      "attribute-sets": [
+        {
+          "role": "simulation attribute",
+          "definitions": [
+            "Material",
+            "BoundaryCondition"
+          ]
+        }
+      ]
+    }
+  ]
+}
+)";
+
+void signal(
+  const smtk::operation::Manager::Ptr& operationManager,
+  const std::string& itemName,
+  const smtk::attribute::AttributePtr& attribute)
+{
+  auto op = operationManager->create<smtk::attribute::Signal>();
+  op->parameters()->findComponent(itemName)->appendValue(attribute);
+  auto result = op->operate();
+  test(
+    result->findInt("outcome")->value() ==
+      static_cast<int>(smtk::operation::Operation::Outcome::SUCCEEDED),
+    "Signal failed.");
+}
+
+} // anonymous namespace
+
+// Test that the FillOutAttributes agent revalidates the attributes an operation
+// reports along with the attributes that depend upon them or upon expunged objects.
+int TestFillOutAttributesAgent(int, char*[])
+{
+  using smtk::task::State;
+
+  auto managers = smtk::common::Managers::create();
+  auto attributeRegistry = smtk::plugin::addToManagers<smtk::attribute::Registrar>(managers);
+  auto resourceRegistry = smtk::plugin::addToManagers<smtk::resource::Registrar>(managers);
+  auto operationRegistry = smtk::plugin::addToManagers<smtk::operation::Registrar>(managers);
+  auto taskRegistry = smtk::plugin::addToManagers<smtk::task::Registrar>(managers);
+
+  auto resourceManager = managers->get<smtk::resource::Manager::Ptr>();
+  auto operationManager = managers->get<smtk::operation::Manager::Ptr>();
+  auto taskManager = smtk::task::Manager::create();
+
+  auto attributeResourceRegistry =
+    smtk::plugin::addToManagers<smtk::attribute::Registrar>(resourceManager);
+  auto attributeOperationRegistry =
+    smtk::plugin::addToManagers<smtk::attribute::Registrar>(operationManager);
+  auto taskTaskRegistry = smtk::plugin::addToManagers<smtk::task::Registrar>(taskManager);
+
+  auto attrib = resourceManager->create<smtk::attribute::Resource>();
+  resourceManager->add(attrib);
+  attrib->setName("simulation");
+  attrib->properties().get<std::string>()["project_role"] = "simulation attribute";
+
+  // A material is valid once its density is set; a boundary condition is valid
+  // when the material it refers to exists and is valid.
+  auto materialDef = attrib->createDefinition("Material");
+  materialDef->addItemDefinition<smtk::attribute::StringItemDefinition>("density");
+  auto conditionDef = attrib->createDefinition("BoundaryCondition");
+  auto materialItemDef =
+    conditionDef->addItemDefinition<smtk::attribute::ComponentItemDefinition>("material");
+  materialItemDef->setAcceptsEntries(
+    smtk::common::typeName<smtk::attribute::Resource>(), "attribute[type='Material']", true);
+
+  auto steel = attrib->createAttribute("steel", materialDef);
+  auto copper = attrib->createAttribute("copper", materialDef);
+  copper->findString("density")->setValue("8.96");
+  auto wall = attrib->createAttribute("wall", conditionDef);
+  auto wallMaterial = wall->findComponent("material");
+  wallMaterial->setCustomIsValid(
+    [](const smtk::attribute::Item* item, const std::set<std::string>&) {
+      auto material = std::dynamic_pointer_cast<smtk::attribute::Attribute>(
+        static_cast<const smtk::attribute::ComponentItem*>(item)->value());
+      return material && material->attributeResource()->findAttribute(material->id()) &&
+        material->isValidCached();
+    });
+  wallMaterial->setValue(steel);
+
+  auto config = nlohmann::json::parse(configString);
+  bool ok = true;
+  auto& resourceHelper = smtk::resource::json::Helper::instance();
+  resourceHelper.setManagers(managers);
+  try
+  {
+    auto& taskHelper =
+      smtk::task::json::Helper::pushInstance(*taskManager, resourceHelper.managers());
+    taskHelper.setManagers(resourceHelper.managers());
+    from_json(config, *taskManager);
+    smtk::task::json::Helper::popInstance();
+  }
+  catch (std::exception&)
+  {
+    ok = false;
+  }
+  test(ok, "Failed to parse configuration.");
+
+  smtk::task::FillOutAttributes::Ptr task;
+  taskManager->taskInstances().visit([&task](const smtk::task::Task::Ptr& tt) {
+    if (!task)
+    {
+      task = std::dynamic_pointer_cast<smtk::task::FillOutAttributes>(tt);
+    }
+    return smtk::common::Visit::Continue;
+  });
+  test(!!task, "Failed to find the FillOutAttributes task.");
+
+  auto portIt = task->ports().find("in");
+  test(portIt != task->ports().end(), "Failed to find input port.");
+  portIt->second->connections().insert(attrib.get());
+  task->portDataUpdated(portIt->second);
+  test(task->state() == State::Incomplete, "Expected steel (and thus wall) to be invalid.");
+
+  // Only steel is reported as modified; the wall depends upon it and must be revalidated.
+  steel->findString("density")->setValue("7.85");
+  signal(operationManager, "modified", steel);
+  test(task->state() == State::Completable, "Expected the wall to be revalidated with steel.");
+
+  steel->findString("density")->unset();
+  signal(operationManager, "modified", steel);
+  test(task->state() == State::Incomplete, "Expected the wall to be invalid with steel.");
+
+  // Point the wall at copper, then delete steel. Steel is no longer tracked.
+  wallMaterial->setValue(copper);
+  signal(operationManager, "modified", wall);
+  test(task->state() == State::Incomplete, "Expected steel to remain invalid.");
+  auto deleter = operationManager->create<smtk::attribute::DeleteAttribute>();
+  deleter->parameters()->associate(steel);
+  auto result = deleter->operate();
+  test(
+    result->findInt("outcome")->value() ==
+      static_cast<int>(smtk::operation::Operation::Outcome::SUCCEEDED),
+    "Could not delete steel.");
+  test(task->state() == State::Completable, "Expected the expunged steel to be untracked.");
+
+  // Deleting copper invalidates the wall even though the wall was not reported.
+  deleter = operationManager->create<smtk::attribute::DeleteAttribute>();
+  deleter->parameters()->associate(copper);
+  result = deleter->operate();
+  test(
+    result->findInt("outcome")->value() ==
+      static_cast<int>(smtk::operation::Operation::Outcome::SUCCEEDED),
+    "Could not delete copper.");
+  test(task->state() == State::Incomplete, "Expected the wall to lose its material.");
+
+  return 0;
+}
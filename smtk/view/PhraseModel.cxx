@@ -28,8 +28,12 @@
 
 #include "smtk/io/Logger.h"
 
+#include <algorithm>
 #include <chrono>
+#include <map>
+#include <numeric>
 #include <thread>
+#include <unordered_set>
 
 #undef SMTK_DBG_PHRASE
 
@@ -69,6 +73,86 @@ void notify(PhraseModel::Observer obs, DescriptivePhrasePtr parent)
   std::vector<int> parentIdx;
   notifyRecursive(obs, parent, parentIdx);
 }
+
+// Mark the entries of \a permutation that lie on one of its longest increasing
+// subsequences. The unmarked entries are the fewest that must be moved in order
+// to sort the permuted sequence.
+std::vector<bool> longestIncreasingRun(const std::vector<int>& permutation)
+{
+  // tails[k] is the index of the smallest value ending an increasing run of length k + 1.
+  std::vector<int> tails;
+  std::vector<int> predecessor(permutation.size(), -1);
+  for (int ii = 0; ii < static_cast<int>(permutation.size()); ++ii)
+  {
+    auto it = std::lower_bound(
+      tails.begin(), tails.end(), permutation[ii], [&permutation](int index, int value) {
+        return permutation[index] < value;
+      });
+    if (it != tails.begin())
+    {
+      predecessor[ii] = *(it - 1);
+    }
+    if (it == tails.end())
+    {
+      tails.push_back(ii);
+    }
+    else
+    {
+      *it = ii;
+    }
+  }
+  std::vector<bool> result(permutation.size(), false);
+  for (int ii = tails.empty() ? -1 : tails.back(); ii >= 0; ii = predecessor[ii])
+  {
+    result[ii] = true;
+  }
+  return result;
+}
+
+// Return the number of ancestors of \a phrase.
+int phraseDepth(DescriptivePhrasePtr phrase)
+{
+  int result = -1;
+  for (; phrase; phrase = phrase->parent())
+  {
+    ++result;
+  }
+  return result;
+}
+
+// Group the phrases in \a objectMap that refer to \a objects by their parent.
+// Parents are appended to \a parents in the order they are first encountered.
+void groupByParent(
+  const smtk::resource::PersistentObjectSet& objects,
+  const UUIDsToPhrasesMap& objectMap,
+  std::vector<DescriptivePhrasePtr>& parents,
+  std::unordered_map<const DescriptivePhrase*, std::unordered_set<const DescriptivePhrase*>>&
+    childrenOfParent)
+{
+  for (const auto& object : objects)
+  {
+    auto it = objectMap.find(object->id());
+    if (it == objectMap.end())
+    {
+      continue; // the object is not in the tree
+    }
+    for (const auto& wdp : it->second)
+    {
+      auto dp = wdp.lock();
+      auto parent = dp ? dp->parent() : nullptr;
+      if (!parent)
+      {
+        continue; // the phrase was released or is a root phrase
+      }
+      auto entry = childrenOfParent.insert({ parent.get(), {} });
+      if (entry.second)
+      {
+        parents.push_back(parent);
+      }
+      entry.first->second.insert(dp.get());
+    }
+  }
+}
 } // namespace
 
 PhraseModel::Source::Source(
@@ -502,6 +586,11 @@ void PhraseModel::handleExpunged(const smtk::resource::PersistentObjectSet& expu
   {
     return;
   }
+  if (m_batchedUpdates)
+  {
+    this->batchExpunged(expungedObjects);
+    return;
+  }
   // Remove phrases that correspond to the set of expunged objects
   // For each object get all of the phrased that corresponds to it, calculate their indices,
   //  and add them to the Phrase Delta
@@ -593,6 +682,11 @@ void PhraseModel::handleModified(const smtk::resource::PersistentObjectSet& modi
   {
     return;
   }
+  if (m_batchedUpdates)
+  {
+    this->batchModified(modifiedObjects);
+    return;
+  }
 
   for (const auto& object : modifiedObjects)
   {
@@ -630,6 +724,11 @@ void PhraseModel::handleCreated(const smtk::resource::PersistentObjectSet& creat
   {
     return;
   }
+  if (m_batchedUpdates)
+  {
+    this->batchCreated(createdObjects);
+    return;
+  }
 
   smtk::resource::PersistentObjectArray objects(createdObjects.begin(), createdObjects.end());
 
@@ -666,6 +765,243 @@ void PhraseModel::handleCreated(const smtk::resource::PersistentObjectSet& creat
   }
 }
 
+void PhraseModel::batchExpunged(const smtk::resource::PersistentObjectSet& expungedObjects)
+{
+  auto rootPhrase = this->root();
+  std::vector<DescriptivePhrasePtr> parents;
+  std::unordered_map<const DescriptivePhrase*, std::unordered_set<const DescriptivePhrase*>>
+    expungedChildren;
+  groupByParent(expungedObjects, m_objectMap, parents, expungedChildren);
+
+  // Visit the deepest parents first so that removing a phrase never strands
+  // a descendant that is also being removed.
+  std::vector<std::pair<int, DescriptivePhrasePtr>> byDepth;
+  byDepth.reserve(parents.size());
+  for (const auto& parent : parents)
+  {
+    byDepth.emplace_back(phraseDepth(parent), parent);
+  }
+  std::stable_sort(
+    byDepth.begin(), byDepth.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  std::vector<int> path;
+  for (const auto& entry : byDepth)
+  {
+    const auto& parent = entry.second;
+    if (parent->root() != rootPhrase || !parent->areSubphrasesBuilt())
+    {
+      continue; // an ancestor of the parent is no longer in the hierarchy
+    }
+    const auto& expunged = expungedChildren[parent.get()];
+    parent->index(path);
+    // Remove contiguous ranges of rows, starting at the back so rows do not shift.
+    int removeRange[2] = { -1, -1 };
+    for (int ii = static_cast<int>(parent->subphrases().size()) - 1; ii >= -1; --ii)
+    {
+      if (ii >= 0 && expunged.find(parent->subphrases()[ii].get()) != expunged.end())
+      {
+        if (removeRange[1] < 0)
+        {
+          removeRange[1] = ii;
+        }
+        removeRange[0] = ii;
+      }
+      else if (removeRange[1] >= 0)
+      {
+        this->removeChildren(path, removeRange);
+        removeRange[0] = removeRange[1] = -1;
+      }
+    }
+  }
+}
+
+void PhraseModel::batchModified(const smtk::resource::PersistentObjectSet& modifiedObjects)
+{
+  std::vector<DescriptivePhrasePtr> parents;
+  std::unordered_map<const DescriptivePhrase*, std::unordered_set<const DescriptivePhrase*>>
+    modifiedChildren;
+  groupByParent(modifiedObjects, m_objectMap, parents, modifiedChildren);
+
+  std::vector<int> path;
+  auto rootPhrase = this->root();
+  for (const auto& parent : parents)
+  {
+    if (parent->root() != rootPhrase || !parent->areSubphrasesBuilt())
+    {
+      continue;
+    }
+    // Signal each contiguous range of modified children, then sort the parent once.
+    const auto& modified = modifiedChildren[parent.get()];
+    parent->index(path);
+    path.push_back(-1);
+    std::vector<int> last(path);
+    const auto& children = parent->subphrases();
+    const int numberOfChildren = static_cast<int>(children.size());
+    for (int ii = 0; ii <= numberOfChildren; ++ii)
+    {
+      if (ii < numberOfChildren && modified.find(children[ii].get()) != modified.end())
+      {
+        if (path.back() < 0)
+        {
+          path.back() = ii;
+        }
+        last.back() = ii;
+      }
+      else if (path.back() >= 0)
+      {
+        this->trigger(parent, PhraseModelEvent::PHRASE_MODIFIED, path, last, std::vector<int>());
+        path.back() = -1;
+      }
+    }
+    this->sortChildren(parent);
+  }
+}
+
+void PhraseModel::batchCreated(const smtk::resource::PersistentObjectSet& createdObjects)
+{
+  auto rootPhrase = this->root();
+  auto delegate = rootPhrase->findDelegate();
+  smtk::resource::PersistentObjectArray objects(createdObjects.begin(), createdObjects.end());
+  SubphraseGenerator::PhrasesByPath phrasesToInsert;
+  delegate->subphrasesForCreatedObjects(objects, rootPhrase, phrasesToInsert);
+
+  // Group the new phrases by the path of the parent the delegate chose.
+  std::map<SubphraseGenerator::Path, std::vector<std::pair<int, DescriptivePhrasePtr>>>
+    createdChildren;
+  for (const auto& entry : phrasesToInsert)
+  {
+    if (entry.first.empty() || !entry.second || !entry.second->parent())
+    {
+      continue;
+    }
+    SubphraseGenerator::Path parentPath(entry.first.begin(), entry.first.end() - 1);
+    createdChildren[parentPath].emplace_back(entry.first.back(), entry.second);
+  }
+
+  // Visit parents in reverse order of their paths and insert each parent's
+  // children from the back: the paths of the parents and rows yet to be
+  // visited are then unaffected by the insertions already made.
+  std::vector<int> insertRange(2);
+  for (auto it = createdChildren.rbegin(); it != createdChildren.rend(); ++it)
+  {
+    const auto& parentPath = it->first;
+    const auto& created = it->second;
+    auto parent = created.front().second->parent();
+    if (parent->root() != rootPhrase || !parent->areSubphrasesBuilt())
+    {
+      continue; // the parent's subphrases will include the phrases once built
+    }
+    auto& children = parent->subphrases();
+    for (std::size_t aj = created.size(); aj > 0;)
+    {
+      // Collect the phrases the delegate placed at the same row.
+      std::size_t ai = aj - 1;
+      for (; ai > 0 && created[ai - 1].first == created[aj - 1].first; --ai)
+      {
+        // advancing to find the start of the range
+      }
+      int row = std::min(created[ai].first, static_cast<int>(children.size()));
+      insertRange[0] = row;
+      insertRange[1] = row + static_cast<int>(aj - ai) - 1;
+      DescriptivePhrases batch;
+      for (std::size_t ii = ai; ii < aj; ++ii)
+      {
+        batch.push_back(created[ii].second);
+      }
+      this->trigger(
+        parent, PhraseModelEvent::ABOUT_TO_INSERT, parentPath, parentPath, insertRange);
+      children.insert(children.begin() + row, batch.begin(), batch.end());
+      this->trigger(
+        parent, PhraseModelEvent::INSERT_FINISHED, parentPath, parentPath, insertRange);
+      for (const auto& childPhrase : batch)
+      {
+        childPhrase->subphrases(); // make sure the children subphrases are built
+      }
+      aj = ai;
+    }
+    // The delegate's rows are normally already sorted; otherwise sort once.
+    this->sortChildren(parent);
+  }
+}
+
+void PhraseModel::sortChildren(const DescriptivePhrasePtr& parent)
+{
+  if (!parent || !parent->areSubphrasesBuilt())
+  {
+    return;
+  }
+  auto& children = parent->subphrases();
+  int count = static_cast<int>(children.size());
+  std::vector<int> order(count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&children](int aa, int bb) {
+    return DescriptivePhrase::compareByTypeThenTitle(children[aa], children[bb]);
+  });
+  // permutation[ii] is the sorted row of the child currently at row ii.
+  std::vector<int> permutation(count);
+  bool isSorted = true;
+  for (int ii = 0; ii < count; ++ii)
+  {
+    permutation[order[ii]] = ii;
+    isSorted &= (order[ii] == ii);
+  }
+  if (isSorted)
+  {
+    return;
+  }
+
+  // Rows that are not on a longest increasing run of the permutation must move.
+  // If they form one block whose sorted rows are also contiguous, a single
+  // move suffices.
+  auto stay = longestIncreasingRun(permutation);
+  int first = -1;
+  int last = -1;
+  bool singleBlock = true;
+  for (int ii = 0; ii < count && singleBlock; ++ii)
+  {
+    if (stay[ii])
+    {
+      continue;
+    }
+    if (first < 0)
+    {
+      first = last = ii;
+    }
+    else if (ii == last + 1 && permutation[ii] == permutation[last] + 1)
+    {
+      last = ii;
+    }
+    else
+    {
+      singleBlock = false;
+    }
+  }
+
+  DescriptivePhrases sorted;
+  sorted.reserve(count);
+  for (int row : order)
+  {
+    sorted.push_back(children[row]);
+  }
+  std::vector<int> path;
+  parent->index(path);
+  if (singleBlock)
+  {
+    // Move the block just before the phrase that follows it once sorted.
+    int next = permutation[last] + 1;
+    std::vector<int> moveRange{ first, last, next < count ? order[next] : count };
+    this->trigger(parent, PhraseModelEvent::ABOUT_TO_MOVE, path, path, moveRange);
+    children.swap(sorted);
+    this->trigger(parent, PhraseModelEvent::MOVE_FINISHED, path, path, moveRange);
+  }
+  else
+  {
+    this->trigger(parent, PhraseModelEvent::ABOUT_TO_REORDER, path, path, permutation);
+    children.swap(sorted);
+    this->trigger(parent, PhraseModelEvent::REORDER_FINISHED, path, path, permutation);
+  }
+}
+
 void PhraseModel::redecorate() {}
 
 void PhraseModel::updateChildren(
@@ -184,6 +184,35 @@ public:
     DescriptivePhrases& next,
     const std::vector<int>& idx);
 
+  /**\brief Sort the children of \a parent by type and then title.
+    *
+    * Rather than signaling each phrase that changes position, this computes
+    * the fewest phrases that must move (those not on a longest run of phrases
+    * already in sorted order). If they form a single contiguous block, a
+    * single move is signaled; otherwise a single reorder is signaled whose
+    * range holds the permutation applied to the children.
+    */
+  virtual void sortChildren(const smtk::view::DescriptivePhrasePtr& parent);
+
+  ///@{
+  /**\brief Control whether operation results are applied in batches.
+    *
+    * When enabled, the created, modified, and expunged objects reported by an
+    * operation are grouped by their parent phrase. Each parent is then visited
+    * once: expunged rows are removed and created phrases inserted (at the rows
+    * chosen by the subphrase generator) as coalesced ranges, modified phrases
+    * are signaled with one PHRASE_MODIFIED event per contiguous range (whose
+    * phrase is the parent), and the children are sorted once with sortChildren().
+    *
+    * Because batched updates may signal ABOUT_TO_REORDER and REORDER_FINISHED
+    * events, only enable this when every observer handles them. Batching is
+    * disabled by default; qtDescriptivePhraseModel, which handles the reorder
+    * events, enables it for every phrase model it presents.
+    */
+  void setBatchedUpdates(bool batched) { m_batchedUpdates = batched; }
+  bool batchedUpdates() const { return m_batchedUpdates; }
+  ///@}
+
   /// Manually specify that all rows should be updated (but to keep the expanded/collapsed state).
   virtual void triggerDataChanged();
 
@@ -283,6 +312,14 @@ protected:
   /// Called to deal with resources/components being created as a result of an operation.
   virtual void handleCreated(const smtk::resource::PersistentObjectSet& createdObjects);
 
+  /// Implementations of handleExpunged(), handleModified(), and handleCreated()
+  /// used when batchedUpdates() is enabled.
+  ///@{
+  void batchExpunged(const smtk::resource::PersistentObjectSet& expungedObjects);
+  void batchModified(const smtk::resource::PersistentObjectSet& modifiedObjects);
+  void batchCreated(const smtk::resource::PersistentObjectSet& createdObjects);
+  ///@}
+
   /**\brief Un-decorate and re-decorate every phrase in the current hierarchy.
     *
     * This is called by setDecorator() to ensure that phrases which were
@@ -362,6 +399,9 @@ protected:
   // Indicates we are in the process of updating children phrases
   bool m_updatingChildren = false;
 
+  // Should operation results be applied to the phrase hierarchy in batches?
+  bool m_batchedUpdates = false;
+
   smtk::common::ThreadPool<DescriptivePhrases> m_pool;
 
   std::atomic<bool> m_pending{ false }; // Is there a pending m_contentObserver timer?
@@ -25,16 +25,29 @@ namespace view
 /// Events that can be observed on an smtk::view::PhraseModel.
 enum class PhraseModelEvent
 {
-  ABOUT_TO_INSERT, //!< A phrase or range of phrases is about to be inserted in the parent.
-  INSERT_FINISHED, //!< A phrase of range of phrases has been inserted in the parent.
-  ABOUT_TO_REMOVE, //!< A phrase or range of phrases is about to be removed from the parent.
-  REMOVE_FINISHED, //!< A phrase or range of phrases has been removed from the parent.
-  ABOUT_TO_MOVE,   //!< A phrase or range of phrases is being moved from one place to another.
-  MOVE_FINISHED,   //!< A phrase or range of phrases has been moved and the update is complete.
-  PHRASE_MODIFIED  //!< The given phrase has had its text, color, or some other property modified.
+  ABOUT_TO_INSERT,  //!< A phrase or range of phrases is about to be inserted in the parent.
+  INSERT_FINISHED,  //!< A phrase of range of phrases has been inserted in the parent.
+  ABOUT_TO_REMOVE,  //!< A phrase or range of phrases is about to be removed from the parent.
+  REMOVE_FINISHED,  //!< A phrase or range of phrases has been removed from the parent.
+  ABOUT_TO_MOVE,    //!< A phrase or range of phrases is being moved from one place to another.
+  MOVE_FINISHED,    //!< A phrase or range of phrases has been moved and the update is complete.
+  PHRASE_MODIFIED,  //!< A phrase or range of phrases has had its text, color, etc. modified.
+  ABOUT_TO_REORDER, //!< The children of the parent are about to be permuted.
+  REORDER_FINISHED  //!< The children of the parent have been permuted.
 };
 
-/// Events that alter the phrase model trigger callbacks of this type.
+/**\brief Events that alter the phrase model trigger callbacks of this type.
+  *
+  * The arguments are the parent phrase, the event, source and destination
+  * paths, and an event-specific range:
+  * + insertions and removals pass the first and last rows affected;
+  * + moves pass the first and last rows being moved plus the row (in the
+  *   source's numbering before the move) they are moved in front of;
+  * + PHRASE_MODIFIED passes an empty range; the source and destination
+  *   paths are the first and last phrases (which share a parent) modified;
+  * + reorders pass a permutation whose i-th entry is the new row of the
+  *   child at row i before the reorder. No children are added or removed.
+  */
 typedef std::function<void(
   DescriptivePhrasePtr,
   PhraseModelEvent,
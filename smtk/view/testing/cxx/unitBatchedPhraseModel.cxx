@@ -0,0 +1,171 @@
+//=========================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//=========================================================================
+#include "smtk/view/DescriptivePhrase.h"
+#include "smtk/view/PhraseModelObserver.h"
+#include "smtk/view/ResourcePhraseModel.h"
+#include "smtk/view/SubphraseGenerator.h"
+
+#include "smtk/attribute/Attribute.h"
+#include "smtk/attribute/ComponentItem.h"
+#include "smtk/attribute/Definition.h"
+#include "smtk/attribute/Registrar.h"
+#include "smtk/attribute/Resource.h"
+#include "smtk/attribute/operators/DeleteAttribute.h"
+#include "smtk/attribute/operators/Signal.h"
+
+#include "smtk/plugin/Registry.h"
+
+#include "smtk/operation/Manager.h"
+#include "smtk/resource/Manager.h"
+
+#include "smtk/common/testing/cxx/helpers.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace smtk::view;
+
+// This test verifies that a phrase model with batched updates enabled applies
+// the created, modified, and expunged components reported by an operation to
+// each parent phrase once, signaling contiguous ranges of rows.
+
+namespace
+{
+struct Event
+{
+  PhraseModelEvent type;
+  std::vector<int> source;
+  std::vector<int> destination;
+  std::vector<int> range;
+};
+
+std::string titles(const DescriptivePhrasePtr& parent)
+{
+  std::string result;
+  for (const auto& child : parent->subphrases())
+  {
+    result += child->title();
+  }
+  return result;
+}
+
+void signal(
+  const smtk::operation::Manager::Ptr& operationManager,
+  const std::string& itemName,
+  const std::vector<smtk::attribute::AttributePtr>& attributes)
+{
+  auto op = operationManager->create<smtk::attribute::Signal>();
+  for (const auto& attribute : attributes)
+  {
+    op->parameters()->findComponent(itemName)->appendValue(attribute);
+  }
+  auto result = op->operate();
+  smtkTest(
+    smtk::operation::outcome(result) == smtk::operation::Operation::Outcome::SUCCEEDED,
+    "Could not signal " << itemName << " attributes.");
+}
+} // namespace
+
+int unitBatchedPhraseModel(int /*unused*/, char** const /*unused*/)
+{
+  auto resourceManager = smtk::resource::Manager::create();
+  auto operationManager = smtk::operation::Manager::create();
+  operationManager->registerResourceManager(resourceManager);
+  auto registry =
+    smtk::plugin::addToManagers<smtk::attribute::Registrar>(resourceManager, operationManager);
+
+  auto phraseModel = PhraseModel::Ptr(new ResourcePhraseModel);
+  phraseModel->root()->findDelegate()->setModel(phraseModel);
+  smtkTest(!phraseModel->batchedUpdates(), "Batched updates should be disabled by default.");
+  // qtDescriptivePhraseModel enables batched updates on the models it presents.
+  phraseModel->setBatchedUpdates(true);
+  phraseModel->addSource({ resourceManager, operationManager });
+
+  auto resource = smtk::attribute::Resource::create();
+  resource->setName("attributes");
+  auto definition = resource->createDefinition("thing");
+  std::vector<smtk::attribute::AttributePtr> attributes;
+  for (const auto& name : { "a", "c", "e", "g" })
+  {
+    attributes.push_back(resource->createAttribute(name, definition));
+  }
+  resourceManager->add(resource);
+  smtkTest(phraseModel->root()->subphrases().size() == 1, "Expected one resource phrase.");
+  auto resourcePhrase = phraseModel->root()->subphrases()[0];
+  smtkTest(titles(resourcePhrase) == "aceg", "Unexpected initial phrases.");
+
+  // Record events affecting the children of the resource phrase.
+  std::vector<Event> events;
+  auto key = phraseModel->observers().insert(
+    [&events](
+      DescriptivePhrasePtr,
+      PhraseModelEvent type,
+      const std::vector<int>& source,
+      const std::vector<int>& destination,
+      const std::vector<int>& range) {
+      if (source.size() == 2 || type == PhraseModelEvent::INSERT_FINISHED ||
+          type == PhraseModelEvent::REMOVE_FINISHED)
+      {
+        events.push_back({ type, source, destination, range });
+      }
+    });
+  events.clear(); // Ignore the insertions replayed for the existing phrases.
+
+  // Created phrases are inserted at the rows the subphrase generator chooses.
+  auto b = resource->createAttribute("b", definition);
+  auto d = resource->createAttribute("d", definition);
+  signal(operationManager, "created", { b, d });
+  int inserted = 0;
+  for (const auto& event : events)
+  {
+    smtkTest(event.type == PhraseModelEvent::INSERT_FINISHED, "Expected only insertions.");
+    inserted += event.range[1] - event.range[0] + 1;
+  }
+  smtkTest(inserted == 2, "Expected 2 phrases to be inserted, not " << inserted << ".");
+  smtkTest(titles(resourcePhrase) == "abcdeg", "Unexpected phrases after creation.");
+
+  // Modified phrases are signaled once per contiguous range of rows.
+  events.clear();
+  signal(operationManager, "modified", { attributes[0], b, attributes[1], attributes[2] });
+  std::vector<Event> modified;
+  for (const auto& event : events)
+  {
+    smtkTest(event.type == PhraseModelEvent::PHRASE_MODIFIED, "Expected only modifications.");
+    modified.push_back(event);
+  }
+  smtkTest(modified.size() == 2, "Expected 2 ranges to be modified, not " << modified.size());
+  smtkTest(
+    modified[0].source == std::vector<int>({ 0, 0 }) &&
+      modified[0].destination == std::vector<int>({ 0, 2 }),
+    "Expected rows 0 through 2 to be modified.");
+  smtkTest(
+    modified[1].source == std::vector<int>({ 0, 4 }) &&
+      modified[1].destination == std::vector<int>({ 0, 4 }),
+    "Expected row 4 to be modified.");
+
+  // Expunged phrases are removed as a single range of rows.
+  events.clear();
+  auto deleteOp = operationManager->create<smtk::attribute::DeleteAttribute>();
+  deleteOp->parameters()->associate(b);
+  deleteOp->parameters()->associate(attributes[1]);
+  smtkTest(
+    smtk::operation::outcome(deleteOp->operate()) ==
+      smtk::operation::Operation::Outcome::SUCCEEDED,
+    "Could not delete attributes.");
+  smtkTest(
+    events.size() == 1 && events[0].type == PhraseModelEvent::REMOVE_FINISHED &&
+      events[0].range[0] == 1 && events[0].range[1] == 2,
+    "Expected rows 1 through 2 to be removed at once.");
+  smtkTest(titles(resourcePhrase) == "adeg", "Unexpected phrases after removal.");
+
+  phraseModel->observers().erase(key);
+  return 0;
+}
@@ -31,6 +31,7 @@
 
 #include "smtk/view/json/jsonView.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
@@ -49,6 +50,7 @@ namespace
 int numRemoved = 0;
 int numInserted = 0;
 int numMoved = 0;
+int numReordered = 0;
 
 void checkCounts(const std::array<int, 3>& counts, const std::string& event)
 {
@@ -183,6 +185,13 @@ void loadPhrases(PhraseModel* phraseModel, const std::vector<std::string>& title
       case PhraseModelEvent::PHRASE_MODIFIED:
         std::cout << "refresh";
         break;
+      case PhraseModelEvent::ABOUT_TO_REORDER:
+        std::cout << "will reorder";
+        break;
+      case PhraseModelEvent::REORDER_FINISHED:
+        ++numReordered;
+        std::cout << "did  reorder";
+        break;
     }
     std::cout << "   (";
     for (const auto& pp : path1)
@@ -222,6 +231,33 @@ void loadPhrases(PhraseModel* phraseModel, const std::vector<std::string>& title
   phraseModel->observers().erase(key);
 }
 
+// Sort the top-level phrases, counting the phrases moved and reorders signaled.
+void sortPhrases(PhraseModel* phraseModel)
+{
+  auto key = phraseModel->observers().insert([](
+                                               DescriptivePhrasePtr,
+                                               PhraseModelEvent event,
+                                               const std::vector<int>&,
+                                               const std::vector<int>&,
+                                               const std::vector<int>& range) {
+    if (event == PhraseModelEvent::MOVE_FINISHED)
+    {
+      numMoved += range[1] - range[0] + 1;
+    }
+    else if (event == PhraseModelEvent::REORDER_FINISHED)
+    {
+      ++numReordered;
+    }
+  });
+  phraseModel->sortChildren(phraseModel->root());
+  phraseModel->observers().erase(key);
+
+  const auto& phrases = phraseModel->root()->subphrases();
+  test(
+    std::is_sorted(phrases.begin(), phrases.end(), DescriptivePhrase::compareByTypeThenTitle),
+    "Phrases were not sorted.");
+}
+
 int unitPhraseModel(int argc, char* argv[])
 {
   (void)argc;
@@ -320,5 +356,21 @@ int unitPhraseModel(int argc, char* argv[])
   print(phraseModel.get());
   checkCounts({ 0, 4, 0 }, "cleanup");
 
+  // Test that sorting moves a single out-of-place phrase with one move.
+  loadPhrases(phraseModel.get(), { "d", "a", "b", "c" });
+  checkCounts({ 4, 0, 0 }, "insertion before sort");
+  sortPhrases(phraseModel.get());
+  print(phraseModel.get());
+  test(numReordered == 0, "Sorting a single misplaced phrase should not reorder.");
+  checkCounts({ 0, 0, 1 }, "sort with single move");
+
+  // Test that sorting phrases that would need several moves signals one reorder.
+  loadPhrases(phraseModel.get(), { "b", "a", "d", "c" });
+  numMoved = 0;
+  sortPhrases(phraseModel.get());
+  print(phraseModel.get());
+  test(numReordered == 1, "Sorting several misplaced phrases should reorder once.");
+  checkCounts({ 0, 0, 0 }, "sort with reorder");
+
   return 0;
 }